@@ -200,6 +200,7 @@ AC_DEFUN([OPAL_CHECK_ATTRIBUTES], [
     AC_MSG_RESULT([no])
     opal_cv___attribute__aligned=0
     opal_cv___attribute__always_inline=0
+    opal_cv___attribute__cleanup=0
     opal_cv___attribute__cold=0
     opal_cv___attribute__const=0
     opal_cv___attribute__deprecated=0
@@ -240,6 +241,16 @@ AC_DEFUN([OPAL_CHECK_ATTRIBUTES], [
         [],
         [])
 
+    _OPAL_CHECK_SPECIFIC_ATTRIBUTE([cleanup],
+        [
+         void foo_cleanup(int *arg);
+         void foo_cleanup(int *arg) { *arg = 0; }
+         int foo(int arg);
+         int foo(int arg) { int bar __attribute__ ((__cleanup__(foo_cleanup))) = arg; return bar + 1; }
+        ],
+        [],
+        [])
+
     _OPAL_CHECK_SPECIFIC_ATTRIBUTE([cold],
         [
          int foo(int arg1, int arg2) __attribute__ ((__cold__));
@@ -589,6 +600,8 @@ AC_DEFUN([OPAL_CHECK_ATTRIBUTES], [
                      [Whether your compiler has __attribute__ aligned or not])
   AC_DEFINE_UNQUOTED(OPAL_HAVE_ATTRIBUTE_ALWAYS_INLINE, [$opal_cv___attribute__always_inline],
                      [Whether your compiler has __attribute__ always_inline or not])
+  AC_DEFINE_UNQUOTED(OPAL_HAVE_ATTRIBUTE_CLEANUP, [$opal_cv___attribute__cleanup],
+                     [Whether your compiler has __attribute__ cleanup or not])
   AC_DEFINE_UNQUOTED(OPAL_HAVE_ATTRIBUTE_COLD, [$opal_cv___attribute__cold],
                      [Whether your compiler has __attribute__ cold or not])
   AC_DEFINE_UNQUOTED(OPAL_HAVE_ATTRIBUTE_CONST, [$opal_cv___attribute__const],
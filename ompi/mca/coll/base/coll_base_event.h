@@ -0,0 +1,63 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/**
+ * @file
+ *
+ * MPI_T events raised by the MPI bindings around the calls to the
+ * collective modules. Both events are bound to the communicator and
+ * carry a mca_coll_base_event_data_t. The end of a nonblocking
+ * collective is the return of the call that started it, not the
+ * completion of its request.
+ */
+
+#ifndef MCA_COLL_BASE_EVENT_H
+#define MCA_COLL_BASE_EVENT_H
+
+#include "ompi_config.h"
+
+#include "opal/mca/base/mca_base_event.h"
+#include "ompi/mca/coll/base/coll_base_functions.h"
+
+BEGIN_C_DECLS
+
+enum {
+    MCA_COLL_BASE_EVENT_BEGIN,
+    MCA_COLL_BASE_EVENT_END,
+    MCA_COLL_BASE_EVENT_MAX
+};
+
+typedef struct mca_coll_base_event_data_t {
+    /** Collective operation (COLLTYPE_T) */
+    int32_t collective;
+    /** Root of the rooted collectives, -1 otherwise */
+    int32_t root;
+    /** Whether this is the nonblocking variant of the collective */
+    int32_t nonblocking;
+} mca_coll_base_event_data_t;
+
+OMPI_DECLSPEC extern mca_base_event_t *mca_coll_base_events[MCA_COLL_BASE_EVENT_MAX];
+
+static inline void mca_coll_base_raise_event (int event, struct ompi_communicator_t *comm,
+                                              COLLTYPE_T collective, int root, bool nonblocking)
+{
+    if (mca_base_event_is_active (mca_coll_base_events[event])) {
+        mca_coll_base_event_data_t data = {.collective = collective, .root = root,
+                                           .nonblocking = nonblocking};
+        mca_base_event_raise_internal (mca_coll_base_events[event], MCA_BASE_CB_REQUIRE_NONE,
+                                       comm, &data);
+    }
+}
+
+END_C_DECLS
+
+#endif /* MCA_COLL_BASE_EVENT_H */
@@ -3,7 +3,7 @@
  * Copyright (c) 2004-2005 The Trustees of Indiana University and Indiana
  *                         University Research and Technology
  *                         Corporation.  All rights reserved.
- * Copyright (c) 2004-2016 The University of Tennessee and The University
+ * Copyright (c) 2004-2026 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  * Copyright (c) 2004-2005 High Performance Computing Center Stuttgart,
@@ -35,6 +35,7 @@
 #include "ompi/mca/coll/coll.h"
 #include "ompi/mca/coll/base/base.h"
 #include "ompi/mca/coll/base/coll_base_functions.h"
+#include "ompi/mca/coll/base/coll_base_event.h"
 
 /*
  * The following file was created by configure.  It contains extern
@@ -130,5 +131,50 @@ ompi_request_t** ompi_coll_base_comm_get_reqs(mca_coll_base_comm_t* data, int nr
     return data->mcct_reqs;
 }
 
-MCA_BASE_FRAMEWORK_DECLARE(ompi, coll, "Collectives", NULL, NULL, NULL,
+mca_base_event_t *mca_coll_base_events[MCA_COLL_BASE_EVENT_MAX] = {NULL};
+
+static int mca_coll_base_register (mca_base_register_flag_t flags)
+{
+    static const mca_base_var_enum_value_t collectives[] = {
+        {ALLGATHER, "allgather"}, {ALLGATHERV, "allgatherv"}, {ALLREDUCE, "allreduce"},
+        {ALLTOALL, "alltoall"}, {ALLTOALLV, "alltoallv"}, {ALLTOALLW, "alltoallw"},
+        {BARRIER, "barrier"}, {BCAST, "bcast"}, {EXSCAN, "exscan"}, {GATHER, "gather"},
+        {GATHERV, "gatherv"}, {REDUCE, "reduce"}, {REDUCESCATTER, "reduce_scatter"},
+        {REDUCESCATTERBLOCK, "reduce_scatter_block"}, {SCAN, "scan"}, {SCATTER, "scatter"},
+        {SCATTERV, "scatterv"}, {NEIGHBOR_ALLGATHER, "neighbor_allgather"},
+        {NEIGHBOR_ALLGATHERV, "neighbor_allgatherv"}, {NEIGHBOR_ALLTOALL, "neighbor_alltoall"},
+        {NEIGHBOR_ALLTOALLV, "neighbor_alltoallv"}, {NEIGHBOR_ALLTOALLW, "neighbor_alltoallw"},
+        {0, NULL}};
+    static const mca_base_var_type_t types[] = {MCA_BASE_VAR_TYPE_INT32_T, MCA_BASE_VAR_TYPE_INT32_T,
+                                                MCA_BASE_VAR_TYPE_INT32_T};
+    static const ptrdiff_t displacements[] = {offsetof (mca_coll_base_event_data_t, collective),
+                                              offsetof (mca_coll_base_event_data_t, root),
+                                              offsetof (mca_coll_base_event_data_t, nonblocking)};
+    mca_base_var_enum_t *new_enum;
+    int ret;
+
+    ret = mca_base_var_enum_create ("coll_collectives", collectives, &new_enum);
+    if (OPAL_SUCCESS != ret) {
+        return ret;
+    }
+
+    (void) mca_base_event_register ("ompi", "coll", "base", "collective_begin",
+                                    "A collective operation was called. Elements: collective, "
+                                    "root (-1 if the collective has none), nonblocking",
+                                    OPAL_INFO_LVL_5, new_enum, MPI_T_BIND_MPI_COMM, 3, types,
+                                    displacements, sizeof (mca_coll_base_event_data_t), 0,
+                                    mca_coll_base_events + MCA_COLL_BASE_EVENT_BEGIN);
+    (void) mca_base_event_register ("ompi", "coll", "base", "collective_end",
+                                    "A collective operation returned. Nonblocking collectives end when "
+                                    "they are started. Elements: collective, root (-1 if the collective "
+                                    "has none), nonblocking",
+                                    OPAL_INFO_LVL_5, new_enum, MPI_T_BIND_MPI_COMM, 3, types,
+                                    displacements, sizeof (mca_coll_base_event_data_t), 0,
+                                    mca_coll_base_events + MCA_COLL_BASE_EVENT_END);
+    OBJ_RELEASE(new_enum);
+
+    return OMPI_SUCCESS;
+}
+
+MCA_BASE_FRAMEWORK_DECLARE(ompi, coll, "Collectives", mca_coll_base_register, NULL, NULL,
                            mca_coll_base_static_components, 0);
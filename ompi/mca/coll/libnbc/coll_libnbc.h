@@ -30,6 +30,7 @@
 #include "ompi/mca/coll/coll.h"
 #include "ompi/mca/coll/base/coll_base_util.h"
 #include "opal/sys/atomic.h"
+#include "opal/class/opal_hash_table.h"
 
 BEGIN_C_DECLS
 
@@ -38,19 +39,11 @@ BEGIN_C_DECLS
 /* the debug level */
 #define NBC_DLEVEL 0
 
-/* enable schedule caching - undef NBC_CACHE_SCHEDULE to deactivate it */
-/* TODO: this whole schedule cache stuff does not work with the tmbuf
- * :-( - first, the tmpbuf must not be freed if a schedule using it is
- * still in the cache and second, the tmpbuf used by the schedule must
- * be attached to the handle that uses this schedule !!!!
- * I.E., THIS IS EXPERIMENTAL AND MIGHT NOT WORK */
-/* It also leaks memory because the schedule is never cleaned up when
-   the communicator is destroyed, so don't use it for now */
-#ifdef NBC_CACHE_SCHEDULE
-#undef NBC_CACHE_SCHEDULE
-#endif
-#define NBC_SCHED_DICT_UPPER 1024 /* max. number of dict entries */
-#define NBC_SCHED_DICT_LOWER 512  /* nuber of dict entries after wipe, if SCHED_DICT_UPPER is reached */
+/* with threads, a completion can race with the installation of the
+ * completion callback of a request. The active requests are checked for
+ * such lost completions every NBC_PROGRESS_SWEEP calls to the progress
+ * function */
+#define NBC_PROGRESS_SWEEP 128
 
 /********************* end of LibNBC tuning parameters ************************/
 
@@ -67,16 +60,21 @@ BEGIN_C_DECLS
 #define NBC_INVALID_TOPOLOGY_COMM 8 /* invalid topology attached to communicator */
 
 /* number of implemented collective functions */
-#define NBC_NUM_COLL 17
+#define NBC_NUM_COLL 22
 
 extern bool libnbc_ibcast_skip_dt_decision;
 extern int libnbc_iallgather_algorithm;
 extern int libnbc_iallreduce_algorithm;
+extern int libnbc_iallreduce_segsize;
 extern int libnbc_ibcast_algorithm;
 extern int libnbc_ibcast_knomial_radix;
+extern int libnbc_ibcast_segsize;
 extern int libnbc_iexscan_algorithm;
 extern int libnbc_ireduce_algorithm;
+extern int libnbc_ireduce_segsize;
 extern int libnbc_iscan_algorithm;
+extern bool libnbc_schedule_cache;
+extern size_t libnbc_schedule_cache_size;
 
 struct ompi_coll_libnbc_component_t {
     mca_coll_base_component_2_0_0_t super;
@@ -84,6 +82,13 @@ struct ompi_coll_libnbc_component_t {
     opal_list_t active_requests;
     opal_atomic_int32_t active_comms;
     opal_mutex_t lock;                /* protect access to the active_requests list */
+    /* stack of the active requests with newly completed operations, linked
+     * through pending_next and pushed by the completion callbacks */
+    struct ompi_coll_libnbc_request_t *volatile pending_requests;
+    /* schedule cache statistics, exported as MPI_T performance variables */
+    opal_atomic_int64_t cache_hits;
+    opal_atomic_int64_t cache_misses;
+    opal_atomic_int64_t cache_evictions;
 };
 typedef struct ompi_coll_libnbc_component_t ompi_coll_libnbc_component_t;
 
@@ -95,25 +100,38 @@ struct ompi_coll_libnbc_module_t {
     opal_mutex_t mutex;
     bool comm_registered;
     int tag;
-#ifdef NBC_CACHE_SCHEDULE
-  void *NBC_Dict[NBC_NUM_COLL]; /* this should point to a struct
-                                      hb_tree, but since this is a
-                                      public header-file, this would be
-                                      an include mess :-(. So let's void
-                                      it ...*/
-  int NBC_Dict_size[NBC_NUM_COLL];
-#endif
+    /* schedule cache, see nbc_cache.c */
+    opal_hash_table_t schedule_cache;       /* entries by key */
+    opal_list_t schedule_cache_lru;         /* entries, least recently used first */
+    size_t schedule_cache_used;             /* bytes held by the entries */
 };
 typedef struct ompi_coll_libnbc_module_t ompi_coll_libnbc_module_t;
 OBJ_CLASS_DECLARATION(ompi_coll_libnbc_module_t);
 
 typedef ompi_coll_libnbc_module_t NBC_Comminfo;
 
+struct NBC_Sched_node;
+struct NBC_Subreq;
+struct NBC_Cache_entry;
+
+/* a schedule is a dependency graph of operations. Rounds are kept as a
+ * join node that depends on every operation of the round and that every
+ * operation of the next round depends on. */
 struct NBC_Schedule {
     opal_object_t super;
-    volatile int size;
-    volatile int current_round_offset;
-    char *data;
+    struct NBC_Sched_node *ops;
+    int num_ops;          /* number of nodes, including joins */
+    int max_ops;
+    int num_requests;     /* number of sends and receives */
+    int num_actions;      /* number of nodes that are not joins */
+    int last_op;          /* last node that is not a join */
+    int round_start;      /* first node of the current round */
+    int round_join;       /* join closing the previous round, -1 if none */
+    int *deps;            /* (predecessor, successor) pairs */
+    int num_deps;
+    int max_deps;
+    int *succ;            /* successor lists, filled by NBC_Sched_commit */
+    size_t tmpbuf_size;   /* size of the temporary buffer the schedule works on */
 };
 
 typedef struct NBC_Schedule NBC_Schedule;
@@ -123,14 +141,25 @@ OBJ_CLASS_DECLARATION(NBC_Schedule);
 struct ompi_coll_libnbc_request_t {
     ompi_coll_base_nbc_request_t super;
     MPI_Comm comm;
-    long row_offset;
     bool nbc_complete; /* status in libnbc level */
     int tag;
     volatile int req_count;
     ompi_request_t **req_array;
+    struct NBC_Subreq *subreqs;  /* completion callback data of each entry of req_array */
+    int *req_completed;          /* entries of req_array in completion order */
+    opal_atomic_int32_t req_completed_tail;
+    int req_done;                /* number of completed entries processed */
+    opal_atomic_int32_t pending; /* queued in pending_requests or being progressed */
+    struct ompi_coll_libnbc_request_t *pending_next;
+    int *dep_count;    /* unfinished predecessors of each node */
+    int *ready;        /* queue of nodes whose predecessors are done */
+    int ready_head;
+    int ready_tail;
+    int ops_done;      /* number of finished nodes */
     NBC_Comminfo *comminfo;
     NBC_Schedule *schedule;
     void *tmpbuf; /* temporary buffer e.g. used for Reduce */
+    struct NBC_Cache_entry *cache_entry; /* owner of schedule and tmpbuf if they are cached */
     /* TODO: we should make a handle pointer to a state later (that the user
      * can move request handles) */
 };
@@ -160,6 +189,7 @@ int ompi_coll_libnbc_progress(void);
 
 int NBC_Init_comm(MPI_Comm comm, ompi_coll_libnbc_module_t *module);
 int NBC_Progress(NBC_Handle *handle);
+void NBC_Sweep(NBC_Handle *handle);
 
 
 int ompi_coll_libnbc_iallgather(const void* sendbuf, int sendcount, MPI_Datatype sendtype, void* recvbuf, int recvcount,
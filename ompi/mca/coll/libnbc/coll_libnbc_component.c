@@ -34,6 +34,7 @@
 #include "mpi.h"
 #include "ompi/mca/coll/coll.h"
 #include "ompi/communicator/communicator.h"
+#include "opal/mca/base/mca_base_pvar.h"
 
 /*
  * Public string showing the coll ompi_libnbc component version number
@@ -44,6 +45,7 @@ const char *mca_coll_libnbc_component_version_string =
 
 static int libnbc_priority = 10;
 static bool libnbc_in_progress = false;     /* protect from recursive calls */
+static int libnbc_progress_calls = 0;       /* calls since the last sweep */
 bool libnbc_ibcast_skip_dt_decision = true;
 
 int libnbc_iallgather_algorithm = 0;             /* iallgather user forced algorithm */
@@ -55,23 +57,27 @@ static mca_base_var_enum_value_t iallgather_algorithms[] = {
 };
 
 int libnbc_iallreduce_algorithm = 0;             /* iallreduce user forced algorithm */
+int libnbc_iallreduce_segsize = 0;
 static mca_base_var_enum_value_t iallreduce_algorithms[] = {
     {0, "ignore"},
     {1, "ring"},
     {2, "binomial"},
     {3, "rabenseifner"},
     {4, "recursive_doubling"},
+    {5, "pipeline"},
     {0, NULL}
 };
 
 int libnbc_ibcast_algorithm = 0;             /* ibcast user forced algorithm */
 int libnbc_ibcast_knomial_radix = 4;
+int libnbc_ibcast_segsize = 0;
 static mca_base_var_enum_value_t ibcast_algorithms[] = {
     {0, "ignore"},
     {1, "linear"},
     {2, "binomial"},
     {3, "chain"},
     {4, "knomial"},
+    {5, "binary"},
     {0, NULL}
 };
 
@@ -84,11 +90,13 @@ static mca_base_var_enum_value_t iexscan_algorithms[] = {
 };
 
 int libnbc_ireduce_algorithm = 0;            /* ireduce user forced algorithm */
+int libnbc_ireduce_segsize = 0;
 static mca_base_var_enum_value_t ireduce_algorithms[] = {
     {0, "ignore"},
     {1, "chain"},
     {2, "binomial"},
     {3, "rabenseifner"},
+    {4, "binary"},
     {0, NULL}
 };
 
@@ -100,6 +108,9 @@ static mca_base_var_enum_value_t iscan_algorithms[] = {
     {0, NULL}
 };
 
+bool libnbc_schedule_cache = false;          /* reuse the schedules of repeated calls */
+size_t libnbc_schedule_cache_size = 0;
+
 static int libnbc_open(void);
 static int libnbc_close(void);
 static int libnbc_register(void);
@@ -149,6 +160,10 @@ libnbc_open(void)
     OBJ_CONSTRUCT(&mca_coll_libnbc_component.requests, opal_free_list_t);
     OBJ_CONSTRUCT(&mca_coll_libnbc_component.active_requests, opal_list_t);
     OBJ_CONSTRUCT(&mca_coll_libnbc_component.lock, opal_mutex_t);
+    mca_coll_libnbc_component.pending_requests = NULL;
+    mca_coll_libnbc_component.cache_hits = 0;
+    mca_coll_libnbc_component.cache_misses = 0;
+    mca_coll_libnbc_component.cache_evictions = 0;
     ret = opal_free_list_init (&mca_coll_libnbc_component.requests,
                                sizeof(ompi_coll_libnbc_request_t), 8,
                                OBJ_CLASS(ompi_coll_libnbc_request_t),
@@ -226,17 +241,25 @@ libnbc_register(void)
     (void) mca_base_var_enum_create("coll_libnbc_iallreduce_algorithms", iallreduce_algorithms, &new_enum);
     mca_base_component_var_register(&mca_coll_libnbc_component.super.collm_version,
                                     "iallreduce_algorithm",
-                                    "Which iallreduce algorithm is used: 0 ignore, 1 ring, 2 binomial, 3 rabenseifner, 4 recursive_doubling",
+                                    "Which iallreduce algorithm is used: 0 ignore, 1 ring, 2 binomial, 3 rabenseifner, 4 recursive_doubling, 5 pipeline (segmented binary tree reduce and bcast, commutative ops only)",
                                     MCA_BASE_VAR_TYPE_INT, new_enum, 0, MCA_BASE_VAR_FLAG_SETTABLE,
                                     OPAL_INFO_LVL_5, MCA_BASE_VAR_SCOPE_ALL,
                                     &libnbc_iallreduce_algorithm);
     OBJ_RELEASE(new_enum);
 
+    libnbc_iallreduce_segsize = 0;
+    (void) mca_base_component_var_register(&mca_coll_libnbc_component.super.collm_version,
+                                           "iallreduce_segsize",
+                                           "Segment size in bytes of the pipelined iallreduce algorithm (0 selects it from the message size)",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, MCA_BASE_VAR_FLAG_SETTABLE,
+                                           OPAL_INFO_LVL_5, MCA_BASE_VAR_SCOPE_ALL,
+                                           &libnbc_iallreduce_segsize);
+
     libnbc_ibcast_algorithm = 0;
     (void) mca_base_var_enum_create("coll_libnbc_ibcast_algorithms", ibcast_algorithms, &new_enum);
     mca_base_component_var_register(&mca_coll_libnbc_component.super.collm_version,
                                     "ibcast_algorithm",
-                                    "Which ibcast algorithm is used: 0 ignore, 1 linear, 2 binomial, 3 chain, 4 knomial",
+                                    "Which ibcast algorithm is used: 0 ignore, 1 linear, 2 binomial, 3 chain, 4 knomial, 5 binary (segmented binary tree)",
                                     MCA_BASE_VAR_TYPE_INT, new_enum, 0, MCA_BASE_VAR_FLAG_SETTABLE,
                                     OPAL_INFO_LVL_5, MCA_BASE_VAR_SCOPE_ALL,
                                     &libnbc_ibcast_algorithm);
@@ -250,6 +273,14 @@ libnbc_register(void)
                                            MCA_BASE_VAR_SCOPE_READONLY,
                                            &libnbc_ibcast_knomial_radix);
 
+    libnbc_ibcast_segsize = 0;
+    (void) mca_base_component_var_register(&mca_coll_libnbc_component.super.collm_version,
+                                           "ibcast_segsize",
+                                           "Segment size in bytes of the chain and binary ibcast algorithms (0 selects it from the message size)",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, MCA_BASE_VAR_FLAG_SETTABLE,
+                                           OPAL_INFO_LVL_5, MCA_BASE_VAR_SCOPE_ALL,
+                                           &libnbc_ibcast_segsize);
+
     libnbc_iexscan_algorithm = 0;
     (void) mca_base_var_enum_create("coll_libnbc_iexscan_algorithms", iexscan_algorithms, &new_enum);
     mca_base_component_var_register(&mca_coll_libnbc_component.super.collm_version,
@@ -264,12 +295,20 @@ libnbc_register(void)
     (void) mca_base_var_enum_create("coll_libnbc_ireduce_algorithms", ireduce_algorithms, &new_enum);
     mca_base_component_var_register(&mca_coll_libnbc_component.super.collm_version,
                                     "ireduce_algorithm",
-                                    "Which ireduce algorithm is used: 0 ignore, 1 chain, 2 binomial, 3 rabenseifner",
+                                    "Which ireduce algorithm is used: 0 ignore, 1 chain, 2 binomial, 3 rabenseifner, 4 binary (segmented binary tree, commutative ops only)",
                                     MCA_BASE_VAR_TYPE_INT, new_enum, 0, MCA_BASE_VAR_FLAG_SETTABLE,
                                     OPAL_INFO_LVL_5, MCA_BASE_VAR_SCOPE_ALL,
                                     &libnbc_ireduce_algorithm);
     OBJ_RELEASE(new_enum);
 
+    libnbc_ireduce_segsize = 0;
+    (void) mca_base_component_var_register(&mca_coll_libnbc_component.super.collm_version,
+                                           "ireduce_segsize",
+                                           "Segment size in bytes of the chain and binary ireduce algorithms (0 selects it from the message size)",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, MCA_BASE_VAR_FLAG_SETTABLE,
+                                           OPAL_INFO_LVL_5, MCA_BASE_VAR_SCOPE_ALL,
+                                           &libnbc_ireduce_segsize);
+
     libnbc_iscan_algorithm = 0;
     (void) mca_base_var_enum_create("coll_libnbc_iscan_algorithms", iscan_algorithms, &new_enum);
     mca_base_component_var_register(&mca_coll_libnbc_component.super.collm_version,
@@ -280,6 +319,46 @@ libnbc_register(void)
                                     &libnbc_iscan_algorithm);
     OBJ_RELEASE(new_enum);
 
+    libnbc_schedule_cache = false;
+    (void) mca_base_component_var_register(&mca_coll_libnbc_component.super.collm_version,
+                                           "schedule_cache",
+                                           "Reuse the schedule of a nonblocking collective that is called again with the same arguments on the same communicator",
+                                           MCA_BASE_VAR_TYPE_BOOL, NULL, 0, 0,
+                                           OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &libnbc_schedule_cache);
+
+    libnbc_schedule_cache_size = 16 * 1024 * 1024;
+    (void) mca_base_component_var_register(&mca_coll_libnbc_component.super.collm_version,
+                                           "schedule_cache_size",
+                                           "Maximum number of bytes of schedules and temporary buffers cached per communicator, the least recently used schedules are evicted first",
+                                           MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, 0,
+                                           OPAL_INFO_LVL_5,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &libnbc_schedule_cache_size);
+
+    (void) mca_base_component_pvar_register(&mca_coll_libnbc_component.super.collm_version,
+                                            "schedule_cache_hits", "Number of nonblocking collectives that "
+                                            "reused a cached schedule", OPAL_INFO_LVL_4, MPI_T_PVAR_CLASS_COUNTER,
+                                            MCA_BASE_VAR_TYPE_UNSIGNED_LONG_LONG, NULL, MPI_T_BIND_NO_OBJECT,
+                                            MCA_BASE_PVAR_FLAG_READONLY | MCA_BASE_PVAR_FLAG_CONTINUOUS,
+                                            NULL, NULL, NULL, (void *) &mca_coll_libnbc_component.cache_hits);
+
+    (void) mca_base_component_pvar_register(&mca_coll_libnbc_component.super.collm_version,
+                                            "schedule_cache_misses", "Number of nonblocking collectives that "
+                                            "did not find a cached schedule", OPAL_INFO_LVL_4, MPI_T_PVAR_CLASS_COUNTER,
+                                            MCA_BASE_VAR_TYPE_UNSIGNED_LONG_LONG, NULL, MPI_T_BIND_NO_OBJECT,
+                                            MCA_BASE_PVAR_FLAG_READONLY | MCA_BASE_PVAR_FLAG_CONTINUOUS,
+                                            NULL, NULL, NULL, (void *) &mca_coll_libnbc_component.cache_misses);
+
+    (void) mca_base_component_pvar_register(&mca_coll_libnbc_component.super.collm_version,
+                                            "schedule_cache_evictions", "Number of schedules evicted from the "
+                                            "schedule cache to stay below coll_libnbc_schedule_cache_size",
+                                            OPAL_INFO_LVL_4, MPI_T_PVAR_CLASS_COUNTER,
+                                            MCA_BASE_VAR_TYPE_UNSIGNED_LONG_LONG, NULL, MPI_T_BIND_NO_OBJECT,
+                                            MCA_BASE_PVAR_FLAG_READONLY | MCA_BASE_PVAR_FLAG_CONTINUOUS,
+                                            NULL, NULL, NULL, (void *) &mca_coll_libnbc_component.cache_evictions);
+
     return OMPI_SUCCESS;
 }
 
@@ -429,21 +508,32 @@ ompi_coll_libnbc_progress(void)
     int res;
     int completed = 0;
 
-    if (0 == opal_list_get_size (&mca_coll_libnbc_component.active_requests)) {
-        /* no requests -- nothing to do. do not grab a lock */
+    if (NULL == mca_coll_libnbc_component.pending_requests &&
+        (!opal_using_threads() || 0 == opal_list_get_size (&mca_coll_libnbc_component.active_requests))) {
+        /* no completion since the last call -- nothing to do. do not grab a lock */
         return 0;
     }
 
-    /* process active requests, and use mca_coll_libnbc_component.lock to access the
+    /* only the requests that had operations complete are progressed, and
+     * use mca_coll_libnbc_component.lock to access the
      * mca_coll_libnbc_component.active_requests list */
     OPAL_THREAD_LOCK(&mca_coll_libnbc_component.lock);
     /* return if invoked recursively */
     if (!libnbc_in_progress) {
         libnbc_in_progress = true;
 
-        OPAL_LIST_FOREACH_SAFE(request, next, &mca_coll_libnbc_component.active_requests,
-                               ompi_coll_libnbc_request_t) {
-            OPAL_THREAD_UNLOCK(&mca_coll_libnbc_component.lock);
+        if (opal_using_threads() && ++libnbc_progress_calls >= NBC_PROGRESS_SWEEP) {
+            libnbc_progress_calls = 0;
+            OPAL_LIST_FOREACH(request, &mca_coll_libnbc_component.active_requests, ompi_coll_libnbc_request_t) {
+                NBC_Sweep(request);
+            }
+        }
+        OPAL_THREAD_UNLOCK(&mca_coll_libnbc_component.lock);
+
+        request = (ompi_coll_libnbc_request_t *)
+            OPAL_ATOMIC_SWAP_PTR(&mca_coll_libnbc_component.pending_requests, NULL);
+        for ( ; NULL != request ; request = next) {
+            next = request->pending_next;
             res = NBC_Progress(request);
             if( NBC_CONTINUE != res ) {
                 /* done, remove and complete */
@@ -458,17 +548,14 @@ ompi_coll_libnbc_progress(void)
                 else {
                     request->super.super.req_status.MPI_ERROR = res;
                 }
-                if(request->super.super.req_persistent) {
-                    /* reset for the next communication */
-                    request->row_offset = 0;
-                }
                 if(!request->super.super.req_persistent || !REQUEST_COMPLETE(&request->super.super)) {
             	    ompi_request_complete(&request->super.super, true);
                 }
                 completed++;
             }
-            OPAL_THREAD_LOCK(&mca_coll_libnbc_component.lock);
         }
+
+        OPAL_THREAD_LOCK(&mca_coll_libnbc_component.lock);
         libnbc_in_progress = false;
     }
     OPAL_THREAD_UNLOCK(&mca_coll_libnbc_component.lock);
@@ -482,12 +569,14 @@ libnbc_module_construct(ompi_coll_libnbc_module_t *module)
 {
     OBJ_CONSTRUCT(&module->mutex, opal_mutex_t);
     module->comm_registered = false;
+    NBC_Cache_init (module);
 }
 
 
 static void
 libnbc_module_destruct(ompi_coll_libnbc_module_t *module)
 {
+    NBC_Cache_fini (module);
     OBJ_DESTRUCT(&module->mutex);
 
     /* if we ever were used for a collective op, do the progress cleanup. */
@@ -522,10 +611,8 @@ request_start(size_t count, ompi_request_t ** requests)
         NBC_DEBUG(5, "--------------------------------\n");
         NBC_DEBUG(5, "schedule %p size %u\n", &schedule, sizeof(schedule));
         NBC_DEBUG(5, "handle %p size %u\n", &handle, sizeof(handle));
-        NBC_DEBUG(5, "data %p size %u\n", &schedule->data, sizeof(schedule->data));
+        NBC_DEBUG(5, "ops %p num_ops %i\n", schedule->ops, schedule->num_ops);
         NBC_DEBUG(5, "req_array %p size %u\n", &handle->req_array, sizeof(handle->req_array));
-        NBC_DEBUG(5, "row_offset=%u address=%p size=%u\n", handle->row_offset, &handle->row_offset, sizeof(handle->row_offset));
-        NBC_DEBUG(5, "req_count=%u address=%p size=%u\n", handle->req_count, &handle->req_count, sizeof(handle->req_count));
         NBC_DEBUG(5, "tmpbuf address=%p size=%u\n", handle->tmpbuf, sizeof(handle->tmpbuf));
         NBC_DEBUG(5, "--------------------------------\n");
 
@@ -563,7 +650,8 @@ request_free(struct ompi_request_t **ompi_req)
         return MPI_ERR_REQUEST;
     }
 
-    OMPI_COLL_LIBNBC_REQUEST_RETURN(request);
+    /* release what a persistent request kept for the next start */
+    NBC_Return_handle(request);
     *ompi_req = MPI_REQUEST_NULL;
 
     return OMPI_SUCCESS;
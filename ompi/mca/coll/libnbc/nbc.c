@@ -29,9 +29,6 @@
 #include "ompi/op/op.h"
 #include "ompi/mca/pml/pml.h"
 
-/* only used in this file */
-static inline int NBC_Start_round(NBC_Handle *handle);
-
 /* #define NBC_TIMING */
 
 #ifdef NBC_TIMING
@@ -45,72 +42,138 @@ void NBC_Print_times(double div) {
 #endif
 
 static void nbc_schedule_constructor (NBC_Schedule *schedule) {
-  /* initial total size of the schedule */
-  schedule->size = sizeof (int);
-  schedule->current_round_offset = 0;
-  schedule->data = calloc (1, schedule->size);
+  schedule->ops = NULL;
+  schedule->num_ops = 0;
+  schedule->max_ops = 0;
+  schedule->num_requests = 0;
+  schedule->num_actions = 0;
+  schedule->last_op = -1;
+  schedule->round_start = 0;
+  schedule->round_join = -1;
+  schedule->deps = NULL;
+  schedule->num_deps = 0;
+  schedule->max_deps = 0;
+  schedule->succ = NULL;
+  schedule->tmpbuf_size = 0;
 }
 
 static void nbc_schedule_destructor (NBC_Schedule *schedule) {
-  free (schedule->data);
-  schedule->data = NULL;
+  free (schedule->ops);
+  schedule->ops = NULL;
+  free (schedule->deps);
+  schedule->deps = NULL;
+  free (schedule->succ);
+  schedule->succ = NULL;
 }
 
 OBJ_CLASS_INSTANCE(NBC_Schedule, opal_object_t, nbc_schedule_constructor,
                    nbc_schedule_destructor);
 
-static int nbc_schedule_grow (NBC_Schedule *schedule, int additional) {
-  void *tmp;
-  int size;
+/* records that node succ can only start once node pred has finished */
+static int nbc_schedule_add_dep (NBC_Schedule *schedule, int pred, int succ) {
+  if (schedule->num_deps == schedule->max_deps) {
+    int max_deps = schedule->max_deps ? 2 * schedule->max_deps : 16;
+    int *tmp = realloc (schedule->deps, 2 * max_deps * sizeof (int));
+    if (NULL == tmp) {
+      NBC_Error ("Could not increase the size of NBC schedule");
+      return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+
+    schedule->deps = tmp;
+    schedule->max_deps = max_deps;
+  }
 
-  /* get current size of schedule */
-  size = nbc_schedule_get_size (schedule);
+  schedule->deps[2 * schedule->num_deps] = pred;
+  schedule->deps[2 * schedule->num_deps + 1] = succ;
+  schedule->num_deps++;
 
-  tmp = realloc (schedule->data, size + additional);
-  if (NULL == tmp) {
-    NBC_Error ("Could not increase the size of NBC schedule");
-    return OMPI_ERR_OUT_OF_RESOURCE;
+  return OMPI_SUCCESS;
+}
+
+static int nbc_schedule_add_node (NBC_Schedule *schedule, NBC_Sched_node **node) {
+  if (schedule->num_ops == schedule->max_ops) {
+    int max_ops = schedule->max_ops ? 2 * schedule->max_ops : 16;
+    NBC_Sched_node *tmp = realloc (schedule->ops, max_ops * sizeof (NBC_Sched_node));
+    if (NULL == tmp) {
+      NBC_Error ("Could not increase the size of NBC schedule");
+      return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+
+    schedule->ops = tmp;
+    schedule->max_ops = max_ops;
   }
 
-  schedule->data = tmp;
+  *node = schedule->ops + schedule->num_ops;
+  memset (*node, 0, sizeof (**node));
+  (*node)->req = -1;
+  schedule->num_ops++;
+
   return OMPI_SUCCESS;
 }
 
-static int nbc_schedule_round_append (NBC_Schedule *schedule, void *data, int data_size, bool barrier) {
-  int ret, size = nbc_schedule_get_size (schedule);
+/* closes the current round with a join node */
+static int nbc_schedule_join (NBC_Schedule *schedule) {
+  NBC_Sched_node *node;
+  int ret, join = schedule->num_ops;
 
-  if (barrier) {
-    ret = nbc_schedule_grow (schedule, data_size + 1 + sizeof (int));
+  ret = nbc_schedule_add_node (schedule, &node);
+  if (OMPI_SUCCESS != ret) {
+    return ret;
+  }
+
+  node->args.type = JOIN;
+
+  if (schedule->round_start == join) {
+    /* empty round, keep the order with the previous round */
+    if (schedule->round_join >= 0) {
+      ret = nbc_schedule_add_dep (schedule, schedule->round_join, join);
+    }
   } else {
-    ret = nbc_schedule_grow (schedule, data_size);
+    for (int i = schedule->round_start ; i < join && OMPI_SUCCESS == ret ; ++i) {
+      ret = nbc_schedule_add_dep (schedule, i, join);
+    }
   }
   if (OMPI_SUCCESS != ret) {
     return ret;
   }
 
-  /* append to the round-schedule */
-  if (data_size) {
-    memcpy (schedule->data + size, data, data_size);
+  NBC_DEBUG(10, "ended round with join %i\n", join);
 
-    /* increase number of elements in round-schedule */
-    nbc_schedule_inc_round (schedule);
+  schedule->round_start = join + 1;
+  schedule->round_join = join;
 
-    /* increase size of schedule */
-    nbc_schedule_inc_size (schedule, data_size);
+  return OMPI_SUCCESS;
+}
+
+/* puts an operation into the current round of the schedule */
+static int nbc_schedule_append (NBC_Schedule *schedule, void *args, size_t args_size, bool barrier) {
+  NBC_Sched_node *node;
+  NBC_Fn_type type;
+  int ret, id = schedule->num_ops;
+
+  ret = nbc_schedule_add_node (schedule, &node);
+  if (OMPI_SUCCESS != ret) {
+    return ret;
   }
 
-  if (barrier) {
-    /* add the barrier */
-    schedule->data[size + data_size] = 1;
-    /* set next round counter to 0 */
-    memset (schedule->data + size + data_size + 1, 0, sizeof (int));
+  memcpy (&node->args, args, args_size);
+  memcpy (&type, args, sizeof (type));
 
-    NBC_DEBUG(10, "ended round at byte %i\n", size + data_size + 1);
+  if (SEND == type || RECV == type) {
+    node->req = schedule->num_requests++;
+  }
+  schedule->num_actions++;
+  schedule->last_op = id;
 
-    schedule->current_round_offset = size + data_size + 1;
+  if (schedule->round_join >= 0) {
+    ret = nbc_schedule_add_dep (schedule, schedule->round_join, id);
+    if (OMPI_SUCCESS != ret) {
+      return ret;
+    }
+  }
 
-    /* increase size of schedule */
-    nbc_schedule_inc_size (schedule, sizeof (int) + 1);
+  if (barrier) {
+    return nbc_schedule_join (schedule);
   }
 
   return OMPI_SUCCESS;
@@ -131,12 +194,12 @@ static int NBC_Sched_send_internal (const void* buf, char tmpbuf, int count, MPI
   send_args.local = local;
 
   /* append to the round-schedule */
-  ret = nbc_schedule_round_append (schedule, &send_args, sizeof (send_args), barrier);
+  ret = nbc_schedule_append (schedule, &send_args, sizeof (send_args), barrier);
   if (OMPI_SUCCESS != ret) {
     return ret;
   }
 
-  NBC_DEBUG(10, "added send - ends at byte %i\n", nbc_schedule_get_size (schedule));
+  NBC_DEBUG(10, "added send - node %i\n", nbc_schedule_last_op (schedule));
 
   return OMPI_SUCCESS;
 }
@@ -164,12 +227,12 @@ static int NBC_Sched_recv_internal (void* buf, char tmpbuf, int count, MPI_Datat
   recv_args.local = local;
 
   /* append to the round-schedule */
-  ret = nbc_schedule_round_append (schedule, &recv_args, sizeof (recv_args), barrier);
+  ret = nbc_schedule_append (schedule, &recv_args, sizeof (recv_args), barrier);
   if (OMPI_SUCCESS != ret) {
     return ret;
   }
 
-  NBC_DEBUG(10, "added receive - ends at byte %d\n", nbc_schedule_get_size (schedule));
+  NBC_DEBUG(10, "added receive - node %i\n", nbc_schedule_last_op (schedule));
 
   return OMPI_SUCCESS;
 }
@@ -199,12 +262,12 @@ int NBC_Sched_op (const void* buf1, char tmpbuf1, void* buf2, char tmpbuf2, int
   op_args.datatype = datatype;
 
   /* append to the round-schedule */
-  ret = nbc_schedule_round_append (schedule, &op_args, sizeof (op_args), barrier);
+  ret = nbc_schedule_append (schedule, &op_args, sizeof (op_args), barrier);
   if (OMPI_SUCCESS != ret) {
     return ret;
   }
 
-  NBC_DEBUG(10, "added op2 - ends at byte %i\n", nbc_schedule_get_size (schedule));
+  NBC_DEBUG(10, "added op2 - node %i\n", nbc_schedule_last_op (schedule));
 
   return OMPI_SUCCESS;
 }
@@ -227,12 +290,12 @@ int NBC_Sched_copy (void *src, char tmpsrc, int srccount, MPI_Datatype srctype,
   copy_args.tgttype = tgttype;
 
   /* append to the round-schedule */
-  ret = nbc_schedule_round_append (schedule, &copy_args, sizeof (copy_args), barrier);
+  ret = nbc_schedule_append (schedule, &copy_args, sizeof (copy_args), barrier);
   if (OMPI_SUCCESS != ret) {
     return ret;
   }
 
-  NBC_DEBUG(10, "added copy - ends at byte %i\n", nbc_schedule_get_size (schedule));
+  NBC_DEBUG(10, "added copy - node %i\n", nbc_schedule_last_op (schedule));
 
   return OMPI_SUCCESS;
 }
@@ -253,40 +316,90 @@ int NBC_Sched_unpack (void *inbuf, char tmpinbuf, int count, MPI_Datatype dataty
   unpack_args.tmpoutbuf = tmpoutbuf;
 
   /* append to the round-schedule */
-  ret = nbc_schedule_round_append (schedule, &unpack_args, sizeof (unpack_args), barrier);
+  ret = nbc_schedule_append (schedule, &unpack_args, sizeof (unpack_args), barrier);
   if (OMPI_SUCCESS != ret) {
     return ret;
   }
 
-  NBC_DEBUG(10, "added unpack - ends at byte %i\n", nbc_schedule_get_size (schedule));
+  NBC_DEBUG(10, "added unpack - node %i\n", nbc_schedule_last_op (schedule));
 
   return OMPI_SUCCESS;
 }
 
 /* this function ends a round of a schedule */
 int NBC_Sched_barrier (NBC_Schedule *schedule) {
-  return nbc_schedule_round_append (schedule, NULL, 0, true);
+  return nbc_schedule_join (schedule);
+}
+
+/* this function makes operation succ wait for operation pred, both being
+ * ids returned by nbc_schedule_last_op() */
+int NBC_Sched_depend (NBC_Schedule *schedule, int pred, int succ) {
+  if (OPAL_UNLIKELY(pred < 0 || pred >= succ || succ >= schedule->num_ops)) {
+    NBC_Error ("NBC_Sched_depend: bad dependency %i -> %i", pred, succ);
+    return OMPI_ERR_BAD_PARAM;
+  }
+
+  return nbc_schedule_add_dep (schedule, pred, succ);
 }
 
 /* this function ends a schedule */
 int NBC_Sched_commit(NBC_Schedule *schedule) {
-  int size = nbc_schedule_get_size (schedule);
-  char *ptr;
-  int ret;
+  int *count, *sorted, offset = 0;
 
-  ret = nbc_schedule_grow (schedule, 1);
-  if (OMPI_SUCCESS != ret) {
-    return ret;
+  free (schedule->succ);
+  schedule->succ = NULL;
+
+  if (0 == schedule->num_ops) {
+    return OMPI_SUCCESS;
   }
 
-  /* add the barrier char (0) because this is the last round */
-  ptr = schedule->data + size;
-  *((char *) ptr) = 0;
+  schedule->succ = malloc (schedule->num_deps * sizeof (int) + 1);
+  sorted = malloc (schedule->num_deps * sizeof (int) + 1);
+  count = calloc (schedule->num_ops, sizeof (int));
+  if (NULL == schedule->succ || NULL == sorted || NULL == count) {
+    free (sorted);
+    free (count);
+    return OMPI_ERR_OUT_OF_RESOURCE;
+  }
 
-  /* increase size of schedule */
-  nbc_schedule_inc_size (schedule, 1);
+  for (int i = 0 ; i < schedule->num_ops ; ++i) {
+    schedule->ops[i].ndeps = 0;
+    schedule->ops[i].nsucc = 0;
+  }
 
-  NBC_DEBUG(10, "closed schedule %p at byte %i\n", schedule, (int)(size + 1));
+  for (int i = 0 ; i < schedule->num_deps ; ++i) {
+    schedule->ops[schedule->deps[2 * i]].nsucc++;
+    schedule->ops[schedule->deps[2 * i + 1]].ndeps++;
+  }
+
+  for (int i = 0 ; i < schedule->num_ops ; ++i) {
+    schedule->ops[i].succ_offset = offset;
+    offset += schedule->ops[i].nsucc;
+  }
+
+  /* fill the successor lists by increasing successor so that the nodes
+   * made ready by the same node start in schedule order */
+  for (int i = 0 ; i < schedule->num_deps ; ++i) {
+    count[schedule->deps[2 * i + 1]]++;
+  }
+  for (int i = 1 ; i < schedule->num_ops ; ++i) {
+    count[i] += count[i - 1];
+  }
+  for (int i = schedule->num_deps - 1 ; i >= 0 ; --i) {
+    sorted[--count[schedule->deps[2 * i + 1]]] = i;
+  }
+
+  memset (count, 0, schedule->num_ops * sizeof (int));
+  for (int i = 0 ; i < schedule->num_deps ; ++i) {
+    int pred = schedule->deps[2 * sorted[i]];
+    schedule->succ[schedule->ops[pred].succ_offset + count[pred]++] = schedule->deps[2 * sorted[i] + 1];
+  }
+
+  free (sorted);
+  free (count);
+
+  NBC_DEBUG(10, "closed schedule %p with %i nodes and %i dependencies\n", schedule,
+            schedule->num_ops, schedule->num_deps);
 
   return OMPI_SUCCESS;
 }
@@ -296,78 +409,445 @@ int NBC_Sched_commit(NBC_Schedule *schedule) {
  * to be called *only* from the progress thread !!! */
 static inline void NBC_Free (NBC_Handle* handle) {
 
+  /* the requests of a persistent schedule live as long as the handle */
+  if (NULL != handle->req_array) {
+    for (int i = 0 ; i < handle->schedule->num_requests ; ++i) {
+      if (MPI_REQUEST_NULL != handle->req_array[i]) {
+        ompi_request_free (handle->req_array + i);
+      }
+    }
+  }
+
   if (NULL != handle->schedule) {
     /* release schedule */
     OBJ_RELEASE (handle->schedule);
     handle->schedule = NULL;
   }
 
+  /* a cached schedule keeps its temporary buffer */
+  if (NULL != handle->cache_entry) {
+    NBC_Cache_release (handle);
+  }
+
   /* if the nbc_I<collective> attached some data */
-  /* problems with schedule cache here, see comment (TODO) in
-   * nbc_internal.h */
   if (NULL != handle->tmpbuf) {
     free((void*)handle->tmpbuf);
     handle->tmpbuf = NULL;
   }
+
+  free (handle->subreqs);
+  handle->subreqs = NULL;
+  handle->req_array = NULL;
+  handle->req_completed = NULL;
+  free (handle->dep_count);
+  handle->dep_count = NULL;
+  handle->ready = NULL;
+}
+
+/* address of a buffer of the schedule */
+static inline void *nbc_handle_buf (NBC_Handle *handle, const void *buf, char tmpbuf) {
+  if (tmpbuf) {
+    return (char *) handle->tmpbuf + (long) buf;
+  }
+
+  return (void *) buf;
+}
+
+/* allocates the execution state of a handle. The sends and receives of a
+ * persistent schedule are created here once as persistent requests, so
+ * that starting it only resets counters and starts the requests */
+static int nbc_handle_prepare (NBC_Handle *handle) {
+  NBC_Schedule *schedule = handle->schedule;
+  int res = OMPI_SUCCESS;
+
+  handle->dep_count = (int *) malloc (2 * schedule->num_ops * sizeof (int));
+  handle->subreqs = (NBC_Subreq *) malloc (schedule->num_requests * (sizeof (NBC_Subreq) + sizeof (ompi_request_t *) +
+                                                                     sizeof (int)) + 1);
+  if (NULL == handle->dep_count || NULL == handle->subreqs) {
+    free (handle->dep_count);
+    handle->dep_count = NULL;
+    free (handle->subreqs);
+    handle->subreqs = NULL;
+    return OMPI_ERR_OUT_OF_RESOURCE;
+  }
+  handle->ready = handle->dep_count + schedule->num_ops;
+  handle->req_array = (ompi_request_t **) (handle->subreqs + schedule->num_requests);
+  handle->req_completed = (int *) (handle->req_array + schedule->num_requests);
+
+  for (int i = 0 ; i < schedule->num_ops ; ++i) {
+    NBC_Sched_node *node = schedule->ops + i;
+    NBC_Subreq *subreq;
+
+    if (node->req < 0) {
+      continue;
+    }
+
+    subreq = handle->subreqs + node->req;
+    subreq->handle = handle;
+    subreq->node = i;
+    subreq->index = node->req;
+    handle->req_array[node->req] = MPI_REQUEST_NULL;
+    if (!handle->super.super.req_persistent || OMPI_SUCCESS != res) {
+      continue;
+    }
+
+    if (SEND == node->args.type) {
+      res = MCA_PML_CALL(isend_init(nbc_handle_buf (handle, node->args.send.buf, node->args.send.tmpbuf),
+                                    node->args.send.count, node->args.send.datatype, node->args.send.dest,
+                                    handle->tag, MCA_PML_BASE_SEND_STANDARD,
+                                    node->args.send.local ? handle->comm->c_local_comm : handle->comm,
+                                    handle->req_array + node->req));
+    } else {
+      res = MCA_PML_CALL(irecv_init(nbc_handle_buf (handle, node->args.recv.buf, node->args.recv.tmpbuf),
+                                    node->args.recv.count, node->args.recv.datatype, node->args.recv.source,
+                                    handle->tag, node->args.recv.local ? handle->comm->c_local_comm : handle->comm,
+                                    handle->req_array + node->req));
+    }
+    if (OMPI_SUCCESS != res) {
+      NBC_Error ("Error in MCA_PML_CALL(i%s_init) for node %i (%i)", SEND == node->args.type ? "send" : "recv", i, res);
+      handle->req_array[node->req] = MPI_REQUEST_NULL;
+    }
+  }
+
+  return res;
+}
+
+/* marks a node as finished and queues the successors it was the last
+ * predecessor of */
+static inline void nbc_node_done (NBC_Handle *handle, int id) {
+  NBC_Schedule *schedule = handle->schedule;
+  NBC_Sched_node *node = schedule->ops + id;
+
+  for (int i = 0 ; i < node->nsucc ; ++i) {
+    int succ = schedule->succ[node->succ_offset + i];
+    if (0 == --handle->dep_count[succ]) {
+      handle->ready[handle->ready_tail++] = succ;
+    }
+  }
+
+  handle->ops_done++;
+}
+
+/* queues a handle that is already marked pending for the progress function */
+static inline void nbc_handle_push (NBC_Handle *handle) {
+  NBC_Handle *head = mca_coll_libnbc_component.pending_requests;
+
+  do {
+    handle->pending_next = head;
+  } while (!OPAL_ATOMIC_COMPARE_EXCHANGE_STRONG_PTR(&mca_coll_libnbc_component.pending_requests, &head, handle));
+}
+
+/* records the completion of a posted request and queues its handle,
+ * unless the handle is already queued or being progressed */
+static inline void nbc_subreq_completed (NBC_Subreq *subreq) {
+  NBC_Handle *handle = subreq->handle;
+  int32_t idle = 0, slot;
+
+  if (!OPAL_ATOMIC_COMPARE_EXCHANGE_STRONG_32(&subreq->claimed, &idle, 1)) {
+    return;
+  }
+
+  slot = OPAL_THREAD_FETCH_ADD32(&handle->req_completed_tail, 1);
+  handle->req_completed[slot] = subreq->index;
+  opal_atomic_wmb ();
+
+  idle = 0;
+  if (OPAL_ATOMIC_COMPARE_EXCHANGE_STRONG_32(&handle->pending, &idle, 1)) {
+    nbc_handle_push (handle);
+  }
+}
+
+/* completion callback of the requests posted by a schedule. The request
+ * is only marked complete when this returns, so it is still valid when
+ * the handle gets to it */
+static int nbc_subreq_complete_cb (ompi_request_t *request) {
+  NBC_Subreq *subreq = (NBC_Subreq *) request->req_complete_cb_data;
+  ompi_request_complete_fn_t prev_cb = subreq->prev_cb;
+
+  request->req_complete_cb_data = subreq->prev_cb_data;
+  nbc_subreq_completed (subreq);
+  if (NULL != prev_cb) {
+    return prev_cb (request);
+  }
+
+  return 0;
+}
+
+/* installs the completion callback on the request just posted for a node.
+ * A callback set by the PML is chained, unless other threads could be
+ * running it right now: such requests are left to NBC_Sweep */
+static inline void nbc_subreq_arm (NBC_Handle *handle, int index) {
+  ompi_request_t *request = handle->req_array[index];
+  NBC_Subreq *subreq = handle->subreqs + index;
+  ompi_request_complete_fn_t prev_cb = request->req_complete_cb;
+  bool armed = false;
+
+  handle->req_count++;
+  subreq->claimed = 0;
+  subreq->prev_cb = prev_cb;
+  subreq->prev_cb_data = request->req_complete_cb_data;
+
+  if (!REQUEST_COMPLETE(request) && (NULL == prev_cb || !opal_using_threads ())) {
+    request->req_complete_cb_data = subreq;
+    opal_atomic_wmb ();
+    if (OPAL_ATOMIC_COMPARE_EXCHANGE_STRONG_PTR(&request->req_complete_cb, &prev_cb, nbc_subreq_complete_cb)) {
+      armed = true;
+    } else {
+      /* the request completed in between */
+      request->req_complete_cb_data = subreq->prev_cb_data;
+    }
+    opal_atomic_mb ();
+  }
+
+  /* the request may have completed before the callback was set */
+  if (REQUEST_COMPLETE(request)) {
+    if (armed) {
+      /* the completer may have looked for a callback before it was
+       * installed, it is then never called. Take it back, otherwise a
+       * restarted persistent request would chain it to itself */
+      ompi_request_complete_fn_t cb = nbc_subreq_complete_cb;
+      if (OPAL_ATOMIC_COMPARE_EXCHANGE_STRONG_PTR(&request->req_complete_cb, &cb, subreq->prev_cb)) {
+        request->req_complete_cb_data = subreq->prev_cb_data;
+      }
+    }
+    nbc_subreq_completed (subreq);
+  }
+}
+
+/* marks a handle that has nothing left to process as no longer pending.
+ * Returns true if completions arrived in the meantime and the caller
+ * took the handle back, so that it has to process them */
+static inline bool nbc_handle_idle (NBC_Handle *handle) {
+  int32_t idle = 0;
+
+  handle->pending = 0;
+  opal_atomic_mb ();
+
+  if (handle->req_done == handle->req_completed_tail) {
+    return false;
+  }
+
+  /* whoever sets the flag first owns the handle */
+  return OPAL_ATOMIC_COMPARE_EXCHANGE_STRONG_32(&handle->pending, &idle, 1);
+}
+
+/* starts a single operation, local operations are finished when it returns */
+static inline int nbc_start_op (NBC_Handle *handle, int id) {
+  NBC_Sched_node *node = handle->schedule->ops + id;
+  ompi_request_t **subreq;
+  void *buf1,  *buf2;
+  int res;
+
+  switch(node->args.type) {
+    case SEND:
+      NBC_DEBUG(5,"  SEND (node %i) ", id);
+      NBC_DEBUG(5,"*buf: %p, count: %i, type: %p, dest: %i, tag: %i)\n", node->args.send.buf,
+                node->args.send.count, node->args.send.datatype, node->args.send.dest, handle->tag);
+      /* get buffer */
+      buf1 = nbc_handle_buf (handle, node->args.send.buf, node->args.send.tmpbuf);
+#ifdef NBC_TIMING
+      Isend_time -= MPI_Wtime();
+#endif
+      subreq = handle->req_array + node->req;
+      if (handle->super.super.req_persistent) {
+        res = MCA_PML_CALL(start(1, subreq));
+      } else {
+        res = MCA_PML_CALL(isend(buf1, node->args.send.count, node->args.send.datatype, node->args.send.dest, handle->tag,
+                                 MCA_PML_BASE_SEND_STANDARD, node->args.send.local?handle->comm->c_local_comm:handle->comm,
+                                 subreq));
+      }
+      if (OMPI_SUCCESS != res) {
+        NBC_Error ("Error in MPI_Isend(%lu, %i, %p, %i, %i, %lu) (%i)", (unsigned long)buf1, node->args.send.count,
+                   node->args.send.datatype, node->args.send.dest, handle->tag, (unsigned long)handle->comm, res);
+        return res;
+      }
+      nbc_subreq_arm (handle, node->req);
+#ifdef NBC_TIMING
+      Isend_time += MPI_Wtime();
+#endif
+      return OMPI_SUCCESS;
+    case RECV:
+      NBC_DEBUG(5, "  RECV (node %i) ", id);
+      NBC_DEBUG(5, "*buf: %p, count: %i, type: %p, source: %i, tag: %i)\n", node->args.recv.buf, node->args.recv.count,
+                node->args.recv.datatype, node->args.recv.source, handle->tag);
+      /* get buffer */
+      buf1 = nbc_handle_buf (handle, node->args.recv.buf, node->args.recv.tmpbuf);
+#ifdef NBC_TIMING
+      Irecv_time -= MPI_Wtime();
+#endif
+      subreq = handle->req_array + node->req;
+      if (handle->super.super.req_persistent) {
+        res = MCA_PML_CALL(start(1, subreq));
+      } else {
+        res = MCA_PML_CALL(irecv(buf1, node->args.recv.count, node->args.recv.datatype, node->args.recv.source, handle->tag,
+                                 node->args.recv.local?handle->comm->c_local_comm:handle->comm, subreq));
+      }
+      if (OMPI_SUCCESS != res) {
+        NBC_Error("Error in MPI_Irecv(%lu, %i, %p, %i, %i, %lu) (%i)", (unsigned long)buf1, node->args.recv.count,
+                  node->args.recv.datatype, node->args.recv.source, handle->tag, (unsigned long)handle->comm, res);
+        return res;
+      }
+      nbc_subreq_arm (handle, node->req);
+#ifdef NBC_TIMING
+      Irecv_time += MPI_Wtime();
+#endif
+      return OMPI_SUCCESS;
+    case OP:
+      NBC_DEBUG(5, "  OP2  (node %i) ", id);
+      NBC_DEBUG(5, "*buf1: %p, buf2: %p, count: %i, type: %p)\n", node->args.op.buf1, node->args.op.buf2,
+                node->args.op.count, node->args.op.datatype);
+      /* get buffers */
+      if(node->args.op.tmpbuf1) {
+        buf1=(char*)handle->tmpbuf+(long)node->args.op.buf1;
+      } else {
+        buf1=(void *)node->args.op.buf1;
+      }
+      if(node->args.op.tmpbuf2) {
+        buf2=(char*)handle->tmpbuf+(long)node->args.op.buf2;
+      } else {
+        buf2=node->args.op.buf2;
+      }
+      ompi_op_reduce(node->args.op.op, buf1, buf2, node->args.op.count, node->args.op.datatype);
+      break;
+    case COPY:
+      NBC_DEBUG(5, "  COPY   (node %i) ", id);
+      NBC_DEBUG(5, "*src: %lu, srccount: %i, srctype: %p, *tgt: %lu, tgtcount: %i, tgttype: %p)\n",
+                (unsigned long) node->args.copy.src, node->args.copy.srccount, node->args.copy.srctype,
+                (unsigned long) node->args.copy.tgt, node->args.copy.tgtcount, node->args.copy.tgttype);
+      /* get buffers */
+      if(node->args.copy.tmpsrc) {
+        buf1=(char*)handle->tmpbuf+(long)node->args.copy.src;
+      } else {
+        buf1=node->args.copy.src;
+      }
+      if(node->args.copy.tmptgt) {
+        buf2=(char*)handle->tmpbuf+(long)node->args.copy.tgt;
+      } else {
+        buf2=node->args.copy.tgt;
+      }
+      res = NBC_Copy (buf1, node->args.copy.srccount, node->args.copy.srctype, buf2, node->args.copy.tgtcount,
+                      node->args.copy.tgttype, handle->comm);
+      if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
+        return res;
+      }
+      break;
+    case UNPACK:
+      NBC_DEBUG(5, "  UNPACK   (node %i) ", id);
+      NBC_DEBUG(5, "*src: %lu, srccount: %i, srctype: %p, *tgt: %lu\n", (unsigned long) node->args.unpack.inbuf,
+                node->args.unpack.count, node->args.unpack.datatype, (unsigned long) node->args.unpack.outbuf);
+      /* get buffers */
+      if(node->args.unpack.tmpinbuf) {
+        buf1=(char*)handle->tmpbuf+(long)node->args.unpack.inbuf;
+      } else {
+        buf1=node->args.unpack.inbuf;
+      }
+      if(node->args.unpack.tmpoutbuf) {
+        buf2=(char*)handle->tmpbuf+(long)node->args.unpack.outbuf;
+      } else {
+        buf2=node->args.unpack.outbuf;
+      }
+      res = NBC_Unpack (buf1, node->args.unpack.count, node->args.unpack.datatype, buf2, handle->comm);
+      if (OMPI_SUCCESS != res) {
+        NBC_Error ("NBC_Unpack() failed (code: %i)", res);
+        return res;
+      }
+      break;
+    case JOIN:
+      break;
+    default:
+      NBC_Error ("NBC_Start_op: bad type %li at node %i", (long)node->args.type, id);
+      return OMPI_ERROR;
+  }
+
+  /* local operation, done */
+  nbc_node_done (handle, id);
+
+  return OMPI_SUCCESS;
+}
+
+/* starts all the operations whose predecessors have finished */
+static inline int NBC_Start_ready(NBC_Handle *handle) {
+  int res;
+
+  NBC_DEBUG(10, "start_ready: %i nodes ready\n", handle->ready_tail - handle->ready_head);
+
+  while (handle->ready_head < handle->ready_tail) {
+    res = nbc_start_op (handle, handle->ready[handle->ready_head++]);
+    if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
+      return res;
+    }
+  }
+
+  return OMPI_SUCCESS;
+}
+
+/* processes the completed requests in the order they completed. Stops at
+ * an entry that is still being written or whose request is still inside
+ * ompi_request_complete (the callback runs first), and returns false then */
+static inline bool nbc_process_completed (NBC_Handle *handle) {
+  while (handle->req_done < handle->req_completed_tail) {
+    ompi_request_t *subreq;
+    int index;
+
+    opal_atomic_rmb ();
+    index = handle->req_completed[handle->req_done];
+    if (index < 0 || !REQUEST_COMPLETE(handle->req_array[index])) {
+      return false;
+    }
+
+    subreq = handle->req_array[index];
+    if (OPAL_UNLIKELY(OMPI_SUCCESS != subreq->req_status.MPI_ERROR)) {
+      NBC_Error ("MPI Error in NBC subrequest %p : %d", subreq, subreq->req_status.MPI_ERROR);
+      /* copy the error code from the underlying request and let the
+       * posted operations finish */
+      handle->super.super.req_status.MPI_ERROR = subreq->req_status.MPI_ERROR;
+    }
+    if (!handle->super.super.req_persistent) {
+      ompi_request_free (&subreq);
+      handle->req_array[index] = MPI_REQUEST_NULL;
+    }
+    handle->req_done++;
+
+    nbc_node_done (handle, handle->subreqs[index].node);
+  }
+
+  return true;
 }
 
-/* progresses a request
+/* progresses a request that was taken from the pending requests, i.e.
+ * that has completed operations or was just started
  *
  * to be called *only* from the progress thread !!! */
 int NBC_Progress(NBC_Handle *handle) {
-  int res, ret=NBC_CONTINUE;
-  bool flag;
-  unsigned long size = 0;
-  char *delim;
+  int res;
 
   if (handle->nbc_complete) {
     return NBC_OK;
   }
 
-  flag = true;
-
-  if ((handle->req_count > 0) && (handle->req_array != NULL)) {
-    NBC_DEBUG(50, "NBC_Progress: testing for %i requests\n", handle->req_count);
+  do {
+    NBC_DEBUG(50, "NBC_Progress: %i of %i requests completed\n", handle->req_completed_tail, handle->req_count);
 #ifdef NBC_TIMING
     Test_time -= MPI_Wtime();
 #endif
-    /* don't call ompi_request_test_all as it causes a recursive call into opal_progress */
-    while (handle->req_count) {
-        ompi_request_t *subreq = handle->req_array[handle->req_count - 1];
-        if (REQUEST_COMPLETE(subreq)) {
-            if(OPAL_UNLIKELY( OMPI_SUCCESS != subreq->req_status.MPI_ERROR )) {
-                NBC_Error ("MPI Error in NBC subrequest %p : %d", subreq, subreq->req_status.MPI_ERROR);
-                /* copy the error code from the underlying request and let the
-                 * round finish */
-                handle->super.super.req_status.MPI_ERROR = subreq->req_status.MPI_ERROR;
-            }
-            handle->req_count--;
-            ompi_request_free(&subreq);
-        } else {
-            flag = false;
-            break;
-        }
+    if (!nbc_process_completed (handle)) {
+      /* a completion is still in flight, look again on the next call */
+      nbc_handle_push (handle);
+      return NBC_CONTINUE;
     }
 #ifdef NBC_TIMING
     Test_time += MPI_Wtime();
 #endif
-  }
-
-  /* a round is finished */
-  if (flag) {
-    /* reset handle for next round */
-    if (NULL != handle->req_array) {
-      /* free request array */
-      free (handle->req_array);
-      handle->req_array = NULL;
-    }
-
-    handle->req_count = 0;
 
-    /* previous round had an error */
+    /* an operation had an error, do not start anything new */
     if (OPAL_UNLIKELY(OMPI_SUCCESS != handle->super.super.req_status.MPI_ERROR)) {
+      if (handle->req_done < handle->req_count) {
+        continue;
+      }
+
       res = handle->super.super.req_status.MPI_ERROR;
-      NBC_Error("NBC_Progress: an error %d was found during schedule %p at row-offset %li - aborting the schedule\n", res, handle->schedule, handle->row_offset);
+      NBC_Error("NBC_Progress: an error %d was found during schedule %p after %i of %i nodes - aborting the schedule\n",
+                res, handle->schedule, handle->ops_done, handle->schedule->num_ops);
       handle->nbc_complete = true;
       if (!handle->super.super.req_persistent) {
         NBC_Free(handle);
@@ -375,18 +855,16 @@ int NBC_Progress(NBC_Handle *handle) {
       return res;
     }
 
-    /* adjust delim to start of current round */
-    NBC_DEBUG(5, "NBC_Progress: going in schedule %p to row-offset: %li\n", handle->schedule, handle->row_offset);
-    delim = handle->schedule->data + handle->row_offset;
-    NBC_DEBUG(10, "delim: %p\n", delim);
-    nbc_get_round_size(delim, &size);
-    NBC_DEBUG(10, "size: %li\n", size);
-    /* adjust delim to end of current round -> delimiter */
-    delim = delim + size;
+    res = NBC_Start_ready(handle);
+    if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
+      NBC_Error ("Error in NBC_Start_ready() (%i)", res);
+      return res;
+    }
 
-    if (*delim == 0) {
-      /* this was the last round - we're done */
-      NBC_DEBUG(5, "NBC_Progress last round finished - we're done\n");
+    if (handle->ops_done == handle->schedule->num_ops) {
+      /* this was the last operation - we're done. The handle stays marked
+       * as pending so that nothing queues it anymore */
+      NBC_DEBUG(5, "NBC_Progress last operation finished - we're done\n");
 
       handle->nbc_complete = true;
       if (!handle->super.super.req_persistent) {
@@ -395,198 +873,23 @@ int NBC_Progress(NBC_Handle *handle) {
 
       return NBC_OK;
     }
+  } while (nbc_handle_idle (handle));
 
-    NBC_DEBUG(5, "NBC_Progress round finished - goto next round\n");
-    /* move delim to start of next round */
-    /* initializing handle for new virgin round */
-    handle->row_offset = (intptr_t) (delim + 1) - (intptr_t) handle->schedule->data;
-    /* kick it off */
-    res = NBC_Start_round(handle);
-    if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
-      NBC_Error ("Error in NBC_Start_round() (%i)", res);
-      return res;
-    }
-  }
-
-  return ret;
+  return NBC_CONTINUE;
 }
 
-static inline int NBC_Start_round(NBC_Handle *handle) {
-  int num; /* number of operations */
-  int res;
-  char* ptr;
-  MPI_Request *tmp;
-  NBC_Fn_type type;
-  NBC_Args_send     sendargs;
-  NBC_Args_recv     recvargs;
-  NBC_Args_op         opargs;
-  NBC_Args_copy     copyargs;
-  NBC_Args_unpack unpackargs;
-  void *buf1,  *buf2;
-
-  /* get round-schedule address */
-  ptr = handle->schedule->data + handle->row_offset;
-
-  NBC_GET_BYTES(ptr,num);
-  NBC_DEBUG(10, "start_round round at offset %d : posting %i operations\n", handle->row_offset, num);
-
-  for (int i = 0 ; i < num ; ++i) {
-    int offset = (intptr_t)(ptr - handle->schedule->data);
-
-    memcpy (&type, ptr, sizeof (type));
-    switch(type) {
-      case SEND:
-        NBC_DEBUG(5,"  SEND (offset %li) ", offset);
-        NBC_GET_BYTES(ptr,sendargs);
-        NBC_DEBUG(5,"*buf: %p, count: %i, type: %p, dest: %i, tag: %i)\n", sendargs.buf,
-                  sendargs.count, sendargs.datatype, sendargs.dest, handle->tag);
-        /* get an additional request */
-        handle->req_count++;
-        /* get buffer */
-        if(sendargs.tmpbuf) {
-          buf1=(char*)handle->tmpbuf+(long)sendargs.buf;
-        } else {
-          buf1=(void *)sendargs.buf;
-        }
-#ifdef NBC_TIMING
-        Isend_time -= MPI_Wtime();
-#endif
-        tmp = (MPI_Request *) realloc ((void *) handle->req_array, handle->req_count * sizeof (MPI_Request));
-        if (NULL == tmp) {
-          return OMPI_ERR_OUT_OF_RESOURCE;
-        }
-
-        handle->req_array = tmp;
-
-        res = MCA_PML_CALL(isend(buf1, sendargs.count, sendargs.datatype, sendargs.dest, handle->tag,
-                                 MCA_PML_BASE_SEND_STANDARD, sendargs.local?handle->comm->c_local_comm:handle->comm,
-                                 handle->req_array+handle->req_count - 1));
-        if (OMPI_SUCCESS != res) {
-          NBC_Error ("Error in MPI_Isend(%lu, %i, %p, %i, %i, %lu) (%i)", (unsigned long)buf1, sendargs.count,
-                     sendargs.datatype, sendargs.dest, handle->tag, (unsigned long)handle->comm, res);
-          return res;
-        }
-#ifdef NBC_TIMING
-        Isend_time += MPI_Wtime();
-#endif
-        break;
-      case RECV:
-        NBC_DEBUG(5, "  RECV (offset %li) ", offset);
-        NBC_GET_BYTES(ptr,recvargs);
-        NBC_DEBUG(5, "*buf: %p, count: %i, type: %p, source: %i, tag: %i)\n", recvargs.buf, recvargs.count,
-                  recvargs.datatype, recvargs.source, handle->tag);
-        /* get an additional request - TODO: req_count NOT thread safe */
-        handle->req_count++;
-        /* get buffer */
-        if(recvargs.tmpbuf) {
-          buf1=(char*)handle->tmpbuf+(long)recvargs.buf;
-        } else {
-          buf1=recvargs.buf;
-        }
-#ifdef NBC_TIMING
-        Irecv_time -= MPI_Wtime();
-#endif
-        tmp = (MPI_Request *) realloc ((void *) handle->req_array, handle->req_count * sizeof (MPI_Request));
-        if (NULL == tmp) {
-          return OMPI_ERR_OUT_OF_RESOURCE;
-        }
-
-        handle->req_array = tmp;
-
-        res = MCA_PML_CALL(irecv(buf1, recvargs.count, recvargs.datatype, recvargs.source, handle->tag, recvargs.local?handle->comm->c_local_comm:handle->comm,
-                                 handle->req_array+handle->req_count-1));
-        if (OMPI_SUCCESS != res) {
-          NBC_Error("Error in MPI_Irecv(%lu, %i, %p, %i, %i, %lu) (%i)", (unsigned long)buf1, recvargs.count,
-                    recvargs.datatype, recvargs.source, handle->tag, (unsigned long)handle->comm, res);
-          return res;
-        }
-#ifdef NBC_TIMING
-        Irecv_time += MPI_Wtime();
-#endif
-        break;
-      case OP:
-        NBC_DEBUG(5, "  OP2  (offset %li) ", offset);
-        NBC_GET_BYTES(ptr,opargs);
-        NBC_DEBUG(5, "*buf1: %p, buf2: %p, count: %i, type: %p)\n", opargs.buf1, opargs.buf2,
-                  opargs.count, opargs.datatype);
-        /* get buffers */
-        if(opargs.tmpbuf1) {
-          buf1=(char*)handle->tmpbuf+(long)opargs.buf1;
-        } else {
-          buf1=(void *)opargs.buf1;
-        }
-        if(opargs.tmpbuf2) {
-          buf2=(char*)handle->tmpbuf+(long)opargs.buf2;
-        } else {
-          buf2=opargs.buf2;
-        }
-        ompi_op_reduce(opargs.op, buf1, buf2, opargs.count, opargs.datatype);
-        break;
-      case COPY:
-        NBC_DEBUG(5, "  COPY   (offset %li) ", offset);
-        NBC_GET_BYTES(ptr,copyargs);
-        NBC_DEBUG(5, "*src: %lu, srccount: %i, srctype: %p, *tgt: %lu, tgtcount: %i, tgttype: %p)\n",
-                  (unsigned long) copyargs.src, copyargs.srccount, copyargs.srctype,
-                  (unsigned long) copyargs.tgt, copyargs.tgtcount, copyargs.tgttype);
-        /* get buffers */
-        if(copyargs.tmpsrc) {
-          buf1=(char*)handle->tmpbuf+(long)copyargs.src;
-        } else {
-          buf1=copyargs.src;
-        }
-        if(copyargs.tmptgt) {
-          buf2=(char*)handle->tmpbuf+(long)copyargs.tgt;
-        } else {
-          buf2=copyargs.tgt;
-        }
-        res = NBC_Copy (buf1, copyargs.srccount, copyargs.srctype, buf2, copyargs.tgtcount, copyargs.tgttype,
-                        handle->comm);
-        if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
-          return res;
-        }
-        break;
-      case UNPACK:
-        NBC_DEBUG(5, "  UNPACK   (offset %li) ", offset);
-        NBC_GET_BYTES(ptr,unpackargs);
-        NBC_DEBUG(5, "*src: %lu, srccount: %i, srctype: %p, *tgt: %lu\n", (unsigned long) unpackargs.inbuf,
-                  unpackargs.count, unpackargs.datatype, (unsigned long) unpackargs.outbuf);
-        /* get buffers */
-        if(unpackargs.tmpinbuf) {
-          buf1=(char*)handle->tmpbuf+(long)unpackargs.inbuf;
-        } else {
-          buf1=unpackargs.inbuf;
-        }
-        if(unpackargs.tmpoutbuf) {
-          buf2=(char*)handle->tmpbuf+(long)unpackargs.outbuf;
-        } else {
-          buf2=unpackargs.outbuf;
-        }
-        res = NBC_Unpack (buf1, unpackargs.count, unpackargs.datatype, buf2, handle->comm);
-        if (OMPI_SUCCESS != res) {
-          NBC_Error ("NBC_Unpack() failed (code: %i)", res);
-          return res;
-        }
-
-        break;
-      default:
-        NBC_Error ("NBC_Start_round: bad type %li at offset %li", (long)type, offset);
-        return OMPI_ERROR;
-    }
-  }
+/* looks for completions that raced with the installation of the callback
+ * or whose request kept the callback of the PML
+ *
+ * to be called *only* from the progress thread !!! */
+void NBC_Sweep(NBC_Handle *handle) {
+  for (int i = 0 ; i < handle->schedule->num_requests ; ++i) {
+    NBC_Subreq *subreq = handle->subreqs + i;
 
-  /* check if we can make progress - not in the first round, this allows us to leave the
-   * initialization faster and to reach more overlap
-   *
-   * threaded case: calling progress in the first round can lead to a
-   * deadlock if NBC_Free is called in this round :-( */
-  if (handle->row_offset) {
-    res = NBC_Progress(handle);
-    if ((NBC_OK != res) && (NBC_CONTINUE != res)) {
-      return OMPI_ERROR;
+    if (!subreq->claimed && REQUEST_COMPLETE(handle->req_array[i])) {
+      nbc_subreq_completed (subreq);
     }
   }
-
-  return OMPI_SUCCESS;
 }
 
 void NBC_Return_handle(ompi_coll_libnbc_request_t *request) {
@@ -597,56 +900,11 @@ void NBC_Return_handle(ompi_coll_libnbc_request_t *request) {
 int  NBC_Init_comm(MPI_Comm comm, NBC_Comminfo *comminfo) {
   comminfo->tag= MCA_COLL_BASE_TAG_NONBLOCKING_BASE;
 
-#ifdef NBC_CACHE_SCHEDULE
-  /* initialize the NBC_ALLTOALL SchedCache tree */
-  comminfo->NBC_Dict[NBC_ALLTOALL] = hb_tree_new((dict_cmp_func)NBC_Alltoall_args_compare, NBC_SchedCache_args_delete_key_dummy, NBC_SchedCache_args_delete);
-  if(comminfo->NBC_Dict[NBC_ALLTOALL] == NULL) { printf("Error in hb_tree_new()\n"); return OMPI_ERROR;; }
-  NBC_DEBUG(1, "added tree at address %lu\n", (unsigned long)comminfo->NBC_Dict[NBC_ALLTOALL]);
-  comminfo->NBC_Dict_size[NBC_ALLTOALL] = 0;
-  /* initialize the NBC_ALLGATHER SchedCache tree */
-  comminfo->NBC_Dict[NBC_ALLGATHER] = hb_tree_new((dict_cmp_func)NBC_Allgather_args_compare, NBC_SchedCache_args_delete_key_dummy, NBC_SchedCache_args_delete);
-  if(comminfo->NBC_Dict[NBC_ALLGATHER] == NULL) { printf("Error in hb_tree_new()\n"); return OMPI_ERROR;; }
-  NBC_DEBUG(1, "added tree at address %lu\n", (unsigned long)comminfo->NBC_Dict[NBC_ALLGATHER]);
-  comminfo->NBC_Dict_size[NBC_ALLGATHER] = 0;
-  /* initialize the NBC_ALLREDUCE SchedCache tree */
-  comminfo->NBC_Dict[NBC_ALLREDUCE] = hb_tree_new((dict_cmp_func)NBC_Allreduce_args_compare, NBC_SchedCache_args_delete_key_dummy, NBC_SchedCache_args_delete);
-  if(comminfo->NBC_Dict[NBC_ALLREDUCE] == NULL) { printf("Error in hb_tree_new()\n"); return OMPI_ERROR;; }
-  NBC_DEBUG(1, "added tree at address %lu\n", (unsigned long)comminfo->NBC_Dict[NBC_ALLREDUCE]);
-  comminfo->NBC_Dict_size[NBC_ALLREDUCE] = 0;
-  /* initialize the NBC_BARRIER SchedCache tree - is not needed -
-   * schedule is hung off directly */
-  comminfo->NBC_Dict_size[NBC_BARRIER] = 0;
-  /* initialize the NBC_BCAST SchedCache tree */
-  comminfo->NBC_Dict[NBC_BCAST] = hb_tree_new((dict_cmp_func)NBC_Bcast_args_compare, NBC_SchedCache_args_delete_key_dummy, NBC_SchedCache_args_delete);
-  if(comminfo->NBC_Dict[NBC_BCAST] == NULL) { printf("Error in hb_tree_new()\n"); return OMPI_ERROR;; }
-  NBC_DEBUG(1, "added tree at address %lu\n", (unsigned long)comminfo->NBC_Dict[NBC_BCAST]);
-  comminfo->NBC_Dict_size[NBC_BCAST] = 0;
-  /* initialize the NBC_GATHER SchedCache tree */
-  comminfo->NBC_Dict[NBC_GATHER] = hb_tree_new((dict_cmp_func)NBC_Gather_args_compare, NBC_SchedCache_args_delete_key_dummy, NBC_SchedCache_args_delete);
-  if(comminfo->NBC_Dict[NBC_GATHER] == NULL) { printf("Error in hb_tree_new()\n"); return OMPI_ERROR;; }
-  NBC_DEBUG(1, "added tree at address %lu\n", (unsigned long)comminfo->NBC_Dict[NBC_GATHER]);
-  comminfo->NBC_Dict_size[NBC_GATHER] = 0;
-  /* initialize the NBC_REDUCE SchedCache tree */
-  comminfo->NBC_Dict[NBC_REDUCE] = hb_tree_new((dict_cmp_func)NBC_Reduce_args_compare, NBC_SchedCache_args_delete_key_dummy, NBC_SchedCache_args_delete);
-  if(comminfo->NBC_Dict[NBC_REDUCE] == NULL) { printf("Error in hb_tree_new()\n"); return OMPI_ERROR;; }
-  NBC_DEBUG(1, "added tree at address %lu\n", (unsigned long)comminfo->NBC_Dict[NBC_REDUCE]);
-  comminfo->NBC_Dict_size[NBC_REDUCE] = 0;
-  /* initialize the NBC_SCAN SchedCache tree */
-  comminfo->NBC_Dict[NBC_SCAN] = hb_tree_new((dict_cmp_func)NBC_Scan_args_compare, NBC_SchedCache_args_delete_key_dummy, NBC_SchedCache_args_delete);
-  if(comminfo->NBC_Dict[NBC_SCAN] == NULL) { printf("Error in hb_tree_new()\n"); return OMPI_ERROR;; }
-  NBC_DEBUG(1, "added tree at address %lu\n", (unsigned long)comminfo->NBC_Dict[NBC_SCAN]);
-  comminfo->NBC_Dict_size[NBC_SCAN] = 0;
-  /* initialize the NBC_SCATTER SchedCache tree */
-  comminfo->NBC_Dict[NBC_SCATTER] = hb_tree_new((dict_cmp_func)NBC_Scatter_args_compare, NBC_SchedCache_args_delete_key_dummy, NBC_SchedCache_args_delete);
-  if(comminfo->NBC_Dict[NBC_SCATTER] == NULL) { printf("Error in hb_tree_new()\n"); return OMPI_ERROR;; }
-  NBC_DEBUG(1, "added tree at address %lu\n", (unsigned long)comminfo->NBC_Dict[NBC_SCATTER]);
-  comminfo->NBC_Dict_size[NBC_SCATTER] = 0;
-#endif
-
   return OMPI_SUCCESS;
 }
 
 int NBC_Start(NBC_Handle *handle) {
+  NBC_Schedule *schedule = handle->schedule;
   int res;
 
   /* bozo case */
@@ -654,10 +912,42 @@ int NBC_Start(NBC_Handle *handle) {
     return OMPI_SUCCESS;
   }
 
-  /* kick off first round */
+  /* the execution state lives in the handle so that persistent requests
+   * can run the same schedule again */
+  if (NULL == handle->dep_count) {
+    res = nbc_handle_prepare (handle);
+    if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
+      return res;
+    }
+  }
+
+  handle->req_count = 0;
+  handle->req_done = 0;
+  handle->req_completed_tail = 0;
+  for (int i = 0 ; i < schedule->num_requests ; ++i) {
+    handle->req_completed[i] = -1;
+    handle->subreqs[i].claimed = 1;
+  }
+  handle->ready_head = handle->ready_tail = 0;
+  handle->ops_done = 0;
+  for (int i = 0 ; i < schedule->num_ops ; ++i) {
+    handle->dep_count[i] = schedule->ops[i].ndeps;
+    if (0 == schedule->ops[i].ndeps) {
+      handle->ready[handle->ready_tail++] = i;
+    }
+  }
+
+  /* the handle is owned by this thread until it is queued below, the
+   * completion callbacks only record the completions meanwhile */
+  handle->pending = 1;
+  opal_atomic_wmb ();
+
+  /* kick off the operations without predecessors - don't test for
+   * completion here, this allows us to leave the initialization faster
+   * and to reach more overlap */
   handle->super.super.req_state = OMPI_REQUEST_ACTIVE;
   handle->super.super.req_status.MPI_ERROR = OMPI_SUCCESS;
-  res = NBC_Start_round(handle);
+  res = NBC_Start_ready(handle);
   if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
     return res;
   }
@@ -666,6 +956,10 @@ int NBC_Start(NBC_Handle *handle) {
   opal_list_append(&mca_coll_libnbc_component.active_requests, (opal_list_item_t *)handle);
   OPAL_THREAD_UNLOCK(&mca_coll_libnbc_component.lock);
 
+  /* let the progress function look at it once, e.g. to complete a
+   * schedule without sends and receives */
+  nbc_handle_push (handle);
+
   return OMPI_SUCCESS;
 }
 
@@ -677,7 +971,7 @@ int NBC_Schedule_request(NBC_Schedule *schedule, ompi_communicator_t *comm,
   ompi_coll_libnbc_request_t *handle;
 
   /* no operation (e.g. one process barrier)? */
-  if (((int *)schedule->data)[0] == 0 && schedule->data[sizeof(int)] == 0) {
+  if (0 == schedule->num_actions) {
     ret = nbc_get_noop_request(persistent, request);
     if (OMPI_SUCCESS != ret) {
       return OMPI_ERR_OUT_OF_RESOURCE;
@@ -703,11 +997,15 @@ int NBC_Schedule_request(NBC_Schedule *schedule, ompi_communicator_t *comm,
   if (NULL == handle) return OMPI_ERR_OUT_OF_RESOURCE;
 
   handle->tmpbuf = NULL;
+  handle->cache_entry = NULL;
   handle->req_count = 0;
   handle->req_array = NULL;
+  handle->subreqs = NULL;
+  handle->req_completed = NULL;
+  handle->dep_count = NULL;
+  handle->ready = NULL;
   handle->comm = comm;
   handle->schedule = NULL;
-  handle->row_offset = 0;
   handle->nbc_complete = persistent ? true : false;
 
   /******************** Do the tag and shadow comm administration ...  ***************/
@@ -746,20 +1044,25 @@ int NBC_Schedule_request(NBC_Schedule *schedule, ompi_communicator_t *comm,
 
   handle->tmpbuf = tmpbuf;
   handle->schedule = schedule;
-  *request = (ompi_request_t *) handle;
 
-  return OMPI_SUCCESS;
-}
+  if (persistent) {
+    /* everything MPI_Start needs is set up now */
+    ret = nbc_handle_prepare (handle);
+    if (OPAL_UNLIKELY(OMPI_SUCCESS != ret)) {
+      /* the caller still owns the schedule and the temporary buffer */
+      for (int i = 0 ; NULL != handle->req_array && i < schedule->num_requests ; ++i) {
+        if (MPI_REQUEST_NULL != handle->req_array[i]) {
+          ompi_request_free (handle->req_array + i);
+        }
+      }
+      free (handle->subreqs);
+      free (handle->dep_count);
+      OMPI_COLL_LIBNBC_REQUEST_RETURN(handle);
+      return ret;
+    }
+  }
 
-#ifdef NBC_CACHE_SCHEDULE
-void NBC_SchedCache_args_delete_key_dummy(void *k) {
-    /* do nothing because the key and the data element are identical :-)
-     * both (the single one :) is freed in NBC_<COLLOP>_args_delete() */
-}
+  *request = (ompi_request_t *) handle;
 
-void NBC_SchedCache_args_delete(void *entry) {
-  struct NBC_dummyarg *tmp = (struct NBC_dummyarg*)entry;
-  OBJ_RELEASE(tmp->schedule);
-  free(entry);
+  return OMPI_SUCCESS;
 }
-#endif
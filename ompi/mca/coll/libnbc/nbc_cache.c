@@ -0,0 +1,316 @@
+/* -*- Mode: C; c-basic-offset:2 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/*
+ * Schedule cache. The nonblocking collectives build a key from all the
+ * arguments their schedule depends on and look it up in the cache of the
+ * communicator before building a schedule. On a miss, the schedule and
+ * the temporary buffer of the new request are put into the cache once
+ * the request exists. A cache entry owns its schedule and temporary
+ * buffer; the temporary buffer can only be used by one request at a
+ * time, so a lookup that finds an entry still in use is a miss.
+ *
+ * The datatypes and operations of the key are retained by the entry, so
+ * that their addresses cannot be reused by other objects while the entry
+ * exists. The memory of the entries of a communicator is bounded by
+ * coll_libnbc_schedule_cache_size, the least recently used entries are
+ * evicted first. An evicted entry that is still in use is freed when the
+ * request running it completes.
+ */
+
+#include "nbc_internal.h"
+
+typedef struct NBC_Cache_entry {
+  opal_list_item_t super;
+  opal_atomic_int32_t in_use;   /* the schedule is run by a request */
+  void *key;
+  size_t key_size;
+  opal_object_t **objs;         /* retained datatypes and operations */
+  int num_objs;
+  NBC_Schedule *schedule;
+  void *tmpbuf;
+  size_t size;                  /* bytes charged to the cache */
+} NBC_Cache_entry;
+
+static void nbc_cache_entry_constructor (NBC_Cache_entry *entry) {
+  entry->in_use = 0;
+  entry->key = NULL;
+  entry->key_size = 0;
+  entry->objs = NULL;
+  entry->num_objs = 0;
+  entry->schedule = NULL;
+  entry->tmpbuf = NULL;
+  entry->size = 0;
+}
+
+static void nbc_cache_entry_destructor (NBC_Cache_entry *entry) {
+  for (int i = 0 ; i < entry->num_objs ; ++i) {
+    OBJ_RELEASE(entry->objs[i]);
+  }
+  free (entry->objs);
+  free (entry->key);
+
+  if (NULL != entry->schedule) {
+    OBJ_RELEASE(entry->schedule);
+  }
+  free (entry->tmpbuf);
+}
+
+static OBJ_CLASS_INSTANCE(NBC_Cache_entry, opal_list_item_t, nbc_cache_entry_constructor,
+                          nbc_cache_entry_destructor);
+
+int NBC_Cache_key_grow (NBC_Cache_key *key, size_t size) {
+  size_t max_size = 2 * key->max_size;
+  char *data;
+
+  while (max_size < key->size + size) {
+    max_size *= 2;
+  }
+
+  if (key->inline_data == key->data) {
+    data = malloc (max_size);
+    if (NULL != data) {
+      memcpy (data, key->data, key->size);
+    }
+  } else {
+    data = realloc (key->data, max_size);
+  }
+
+  if (NULL == data) {
+    /* give up on caching this call */
+    NBC_Cache_key_fini (key);
+    return OMPI_ERR_OUT_OF_RESOURCE;
+  }
+
+  key->data = data;
+  key->max_size = max_size;
+
+  return OMPI_SUCCESS;
+}
+
+int NBC_Cache_key_grow_objs (NBC_Cache_key *key) {
+  int max_objs = 2 * key->max_objs;
+  opal_object_t **objs;
+
+  if (key->inline_objs == key->objs) {
+    objs = malloc (max_objs * sizeof (objs[0]));
+    if (NULL != objs) {
+      memcpy (objs, key->objs, key->num_objs * sizeof (objs[0]));
+    }
+  } else {
+    objs = realloc (key->objs, max_objs * sizeof (objs[0]));
+  }
+
+  if (NULL == objs) {
+    NBC_Cache_key_fini (key);
+    return OMPI_ERR_OUT_OF_RESOURCE;
+  }
+
+  key->objs = objs;
+  key->max_objs = max_objs;
+
+  return OMPI_SUCCESS;
+}
+
+void NBC_Cache_key_fini (NBC_Cache_key *key) {
+  if (key->inline_data != key->data) {
+    free (key->data);
+  }
+  if (key->inline_objs != key->objs) {
+    free (key->objs);
+  }
+
+  key->data = key->inline_data;
+  key->objs = key->inline_objs;
+  key->module = NULL;
+}
+
+/* memory held by an entry: the entry itself, the key (a copy of which is
+ * kept by the hash table), the schedule and the temporary buffer */
+static size_t nbc_cache_entry_size (NBC_Cache_key *key, NBC_Schedule *schedule) {
+  return sizeof (NBC_Cache_entry) + 2 * key->size + key->num_objs * sizeof (opal_object_t *) +
+    sizeof (NBC_Schedule) + schedule->max_ops * sizeof (NBC_Sched_node) +
+    (2 * schedule->max_deps + schedule->num_deps) * sizeof (int) + schedule->tmpbuf_size;
+}
+
+static void nbc_cache_evict (ompi_coll_libnbc_module_t *module, NBC_Cache_entry *entry) {
+  opal_hash_table_remove_value_ptr (&module->schedule_cache, entry->key, entry->key_size);
+  opal_list_remove_item (&module->schedule_cache_lru, &entry->super);
+  module->schedule_cache_used -= entry->size;
+  OBJ_RELEASE(entry);
+
+  OPAL_THREAD_ADD_FETCH64(&mca_coll_libnbc_component.cache_evictions, 1);
+}
+
+int NBC_Cache_request (NBC_Cache_key *key, ompi_communicator_t *comm, ompi_request_t **request) {
+  ompi_coll_libnbc_module_t *module = key->module;
+  NBC_Cache_entry *entry = NULL;
+  int32_t idle = 0;
+  int res;
+
+  if (NULL == module) {
+    return OMPI_ERR_NOT_FOUND;
+  }
+
+  OPAL_THREAD_LOCK(&module->mutex);
+  (void) opal_hash_table_get_value_ptr (&module->schedule_cache, key->data, key->size, (void **) &entry);
+  if (NULL == entry || !OPAL_ATOMIC_COMPARE_EXCHANGE_STRONG_32(&entry->in_use, &idle, 1)) {
+    OPAL_THREAD_UNLOCK(&module->mutex);
+    OPAL_THREAD_ADD_FETCH64(&mca_coll_libnbc_component.cache_misses, 1);
+    return OMPI_ERR_NOT_FOUND;
+  }
+
+  /* move it to the most recently used end */
+  opal_list_remove_item (&module->schedule_cache_lru, &entry->super);
+  opal_list_append (&module->schedule_cache_lru, &entry->super);
+  OBJ_RETAIN(entry);
+  OPAL_THREAD_UNLOCK(&module->mutex);
+
+  OPAL_THREAD_ADD_FETCH64(&mca_coll_libnbc_component.cache_hits, 1);
+  NBC_Cache_key_fini (key);
+
+  OBJ_RETAIN(entry->schedule);
+  res = NBC_Schedule_request (entry->schedule, comm, module, false, request, entry->tmpbuf);
+  if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
+    OBJ_RELEASE(entry->schedule);
+    opal_atomic_wmb ();
+    entry->in_use = 0;
+    OBJ_RELEASE(entry);
+    return res;
+  }
+
+  ((NBC_Handle *) *request)->cache_entry = entry;
+
+  return OMPI_SUCCESS;
+}
+
+void NBC_Cache_insert (NBC_Cache_key *key, int res, ompi_request_t *request) {
+  ompi_coll_libnbc_module_t *module = key->module;
+  NBC_Handle *handle = (NBC_Handle *) request;
+  NBC_Cache_entry *entry = NULL;
+  int num_objs = key->num_objs;
+  size_t size;
+
+  /* nothing to cache for requests without operations */
+  if (NULL == module || OMPI_SUCCESS != res || &ompi_request_empty == request) {
+    NBC_Cache_key_fini (key);
+    return;
+  }
+
+  size = nbc_cache_entry_size (key, handle->schedule);
+  if (size > libnbc_schedule_cache_size) {
+    NBC_Cache_key_fini (key);
+    return;
+  }
+
+  OPAL_THREAD_LOCK(&module->mutex);
+  /* an entry that was in use when this call looked it up */
+  if (OPAL_SUCCESS == opal_hash_table_get_value_ptr (&module->schedule_cache, key->data, key->size,
+                                                     (void **) &entry)) {
+    OPAL_THREAD_UNLOCK(&module->mutex);
+    NBC_Cache_key_fini (key);
+    return;
+  }
+
+  entry = OBJ_NEW(NBC_Cache_entry);
+  if (OPAL_UNLIKELY(NULL == entry)) {
+    OPAL_THREAD_UNLOCK(&module->mutex);
+    NBC_Cache_key_fini (key);
+    return;
+  }
+
+  /* take over the key */
+  if (key->inline_data == key->data) {
+    entry->key = malloc (key->size);
+    if (NULL != entry->key) {
+      memcpy (entry->key, key->data, key->size);
+    }
+  } else {
+    entry->key = key->data;
+    key->data = key->inline_data;
+  }
+  entry->key_size = key->size;
+
+  if (key->inline_objs == key->objs) {
+    entry->objs = malloc (key->num_objs * sizeof (entry->objs[0]) + 1);
+    if (NULL != entry->objs) {
+      memcpy (entry->objs, key->objs, key->num_objs * sizeof (entry->objs[0]));
+    }
+  } else {
+    entry->objs = key->objs;
+    key->objs = key->inline_objs;
+  }
+  NBC_Cache_key_fini (key);
+
+  if (OPAL_UNLIKELY(NULL == entry->key || NULL == entry->objs ||
+                    OPAL_SUCCESS != opal_hash_table_set_value_ptr (&module->schedule_cache, entry->key,
+                                                                   entry->key_size, entry))) {
+    OPAL_THREAD_UNLOCK(&module->mutex);
+    OBJ_RELEASE(entry);
+    return;
+  }
+
+  entry->num_objs = num_objs;
+  for (int i = 0 ; i < entry->num_objs ; ++i) {
+    OBJ_RETAIN(entry->objs[i]);
+  }
+
+  while (module->schedule_cache_used + size > libnbc_schedule_cache_size) {
+    nbc_cache_evict (module, (NBC_Cache_entry *) opal_list_get_first (&module->schedule_cache_lru));
+  }
+
+  /* the entry owns the schedule and the temporary buffer from now on */
+  entry->schedule = handle->schedule;
+  OBJ_RETAIN(entry->schedule);
+  entry->tmpbuf = handle->tmpbuf;
+  entry->size = size;
+  entry->in_use = 1;
+  opal_list_append (&module->schedule_cache_lru, &entry->super);
+  module->schedule_cache_used += size;
+
+  OBJ_RETAIN(entry);
+  handle->cache_entry = entry;
+  OPAL_THREAD_UNLOCK(&module->mutex);
+}
+
+void NBC_Cache_release (NBC_Handle *handle) {
+  NBC_Cache_entry *entry = handle->cache_entry;
+
+  handle->cache_entry = NULL;
+  handle->tmpbuf = NULL;
+
+  /* the next request may use the temporary buffer */
+  opal_atomic_wmb ();
+  entry->in_use = 0;
+  OBJ_RELEASE(entry);
+}
+
+void NBC_Cache_init (ompi_coll_libnbc_module_t *module) {
+  OBJ_CONSTRUCT(&module->schedule_cache, opal_hash_table_t);
+  OBJ_CONSTRUCT(&module->schedule_cache_lru, opal_list_t);
+  module->schedule_cache_used = 0;
+
+  if (libnbc_schedule_cache) {
+    (void) opal_hash_table_init (&module->schedule_cache, 32);
+  }
+}
+
+void NBC_Cache_fini (ompi_coll_libnbc_module_t *module) {
+  opal_list_item_t *item;
+
+  while (NULL != (item = opal_list_remove_first (&module->schedule_cache_lru))) {
+    OBJ_RELEASE(item);
+  }
+
+  OBJ_DESTRUCT(&module->schedule_cache_lru);
+  OBJ_DESTRUCT(&module->schedule_cache);
+}
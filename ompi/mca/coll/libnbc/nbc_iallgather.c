@@ -29,26 +29,6 @@ static inline int allgather_sched_recursivedoubling(
     int scount, struct ompi_datatype_t *sdtype, void *rbuf, int rcount,
     struct ompi_datatype_t *rdtype);
 
-#ifdef NBC_CACHE_SCHEDULE
-/* tree comparison function for schedule cache */
-int NBC_Allgather_args_compare(NBC_Allgather_args *a, NBC_Allgather_args *b, void *param) {
-  if ((a->sendbuf == b->sendbuf) &&
-      (a->sendcount == b->sendcount) &&
-      (a->sendtype == b->sendtype) &&
-      (a->recvbuf == b->recvbuf) &&
-      (a->recvcount == b->recvcount) &&
-      (a->recvtype == b->recvtype) ) {
-    return 0;
-  }
-
-  if( a->sendbuf < b->sendbuf ) {
-    return -1;
-  }
-
-  return 1;
-}
-#endif
-
 static int nbc_allgather_init(const void* sendbuf, int sendcount, MPI_Datatype sendtype, void* recvbuf, int recvcount,
                               MPI_Datatype recvtype, struct ompi_communicator_t *comm, ompi_request_t ** request,
                               struct mca_coll_base_module_2_3_0_t *module, bool persistent)
@@ -57,9 +37,6 @@ static int nbc_allgather_init(const void* sendbuf, int sendcount, MPI_Datatype s
   MPI_Aint rcvext;
   NBC_Schedule *schedule;
   char *rbuf, inplace;
-#ifdef NBC_CACHE_SCHEDULE
-  NBC_Allgather_args *args, *found, search;
-#endif
   enum { NBC_ALLGATHER_LINEAR, NBC_ALLGATHER_RDBL} alg;
   ompi_coll_libnbc_module_t *libnbc_module = (ompi_coll_libnbc_module_t*) module;
 
@@ -90,7 +67,8 @@ static int nbc_allgather_init(const void* sendbuf, int sendcount, MPI_Datatype s
   if (inplace) {
     sendtype = recvtype;
     sendcount = recvcount;
-  } else if (!persistent) { /* for persistent, the copy must be scheduled */
+  } else if (!persistent && (1 == p || !NBC_Cache_enabled ())) {
+    /* for persistent and cached schedules, the copy must be scheduled */
     /* copy my data to receive buffer */
     rbuf = (char *) recvbuf + rank * recvcount * rcvext;
     res = NBC_Copy (sendbuf, sendcount, sendtype, rbuf, recvcount, recvtype, comm);
@@ -102,84 +80,44 @@ static int nbc_allgather_init(const void* sendbuf, int sendcount, MPI_Datatype s
     return nbc_get_noop_request(persistent, request);
   }
 
-#ifdef NBC_CACHE_SCHEDULE
-  /* search schedule in communicator specific tree */
-  search.sendbuf = sendbuf;
-  search.sendcount = sendcount;
-  search.sendtype = sendtype;
-  search.recvbuf = recvbuf;
-  search.recvcount = recvcount;
-  search.recvtype = recvtype;
-  found = (NBC_Allgather_args *) hb_tree_search ((hb_tree*)libnbc_module->NBC_Dict[NBC_ALLGATHER], &search);
-  if (NULL == found) {
-#endif
-    schedule = OBJ_NEW(NBC_Schedule);
-    if (OPAL_UNLIKELY(NULL == schedule)) {
-      return OMPI_ERR_OUT_OF_RESOURCE;
-    }
-
-    if (persistent && !inplace) {
-      /* for nonblocking, data has been copied already */
-      /* copy my data to receive buffer (= send buffer of NBC_Sched_send) */
-      rbuf = (char *)recvbuf + rank * recvcount * rcvext;
-      res = NBC_Sched_copy((void *)sendbuf, false, sendcount, sendtype,
-                            rbuf, false, recvcount, recvtype, schedule, true);
-      if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
-        OBJ_RELEASE(schedule);
-        return res;
-      }
-    }
-
-    switch (alg) {
-      case NBC_ALLGATHER_LINEAR:
-        res = allgather_sched_linear(rank, p, schedule, sendbuf, sendcount, sendtype,
-                                     recvbuf, recvcount, recvtype);
-        break;
-      case NBC_ALLGATHER_RDBL:
-        res = allgather_sched_recursivedoubling(rank, p, schedule, sendbuf, sendcount,
-                                                sendtype, recvbuf, recvcount, recvtype);
-        break;
-    }
+  schedule = OBJ_NEW(NBC_Schedule);
+  if (OPAL_UNLIKELY(NULL == schedule)) {
+    return OMPI_ERR_OUT_OF_RESOURCE;
+  }
 
+  if ((persistent || NBC_Cache_enabled ()) && !inplace) {
+    /* otherwise, data has been copied already */
+    /* copy my data to receive buffer (= send buffer of NBC_Sched_send) */
+    rbuf = (char *)recvbuf + rank * recvcount * rcvext;
+    res = NBC_Sched_copy((void *)sendbuf, false, sendcount, sendtype,
+                          rbuf, false, recvcount, recvtype, schedule, true);
     if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
       OBJ_RELEASE(schedule);
       return res;
     }
+  }
 
-    res = NBC_Sched_commit(schedule);
-    if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
-      OBJ_RELEASE(schedule);
-      return res;
-    }
+  switch (alg) {
+    case NBC_ALLGATHER_LINEAR:
+      res = allgather_sched_linear(rank, p, schedule, sendbuf, sendcount, sendtype,
+                                   recvbuf, recvcount, recvtype);
+      break;
+    case NBC_ALLGATHER_RDBL:
+      res = allgather_sched_recursivedoubling(rank, p, schedule, sendbuf, sendcount,
+                                              sendtype, recvbuf, recvcount, recvtype);
+      break;
+  }
 
-#ifdef NBC_CACHE_SCHEDULE
-    /* save schedule to tree */
-    args = (NBC_Allgather_args *) malloc (sizeof (args));
-    args->sendbuf = sendbuf;
-    args->sendcount = sendcount;
-    args->sendtype = sendtype;
-    args->recvbuf = recvbuf;
-    args->recvcount = recvcount;
-    args->recvtype = recvtype;
-    args->schedule = schedule;
-
-    res = hb_tree_insert ((hb_tree *) libnbc_module->NBC_Dict[NBC_ALLGATHER], args, args, 0);
-    if (res != 0) {
-      free (args);
-    } else {
-      OBJ_RETAIN(schedule);
-    }
+  if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
+    OBJ_RELEASE(schedule);
+    return res;
+  }
 
-    /* increase number of elements for A2A */
-    if (++libnbc_module->NBC_Dict_size[NBC_ALLGATHER] > NBC_SCHED_DICT_UPPER) {
-      NBC_SchedCache_dictwipe ((hb_tree *) libnbc_module->NBC_Dict[NBC_ALLGATHER], &libnbc_module->NBC_Dict_size[NBC_ALLGATHER]);
-    }
-  } else {
-    /* found schedule */
-    schedule = found->schedule;
-    OBJ_RETAIN(schedule);
+  res = NBC_Sched_commit(schedule);
+  if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
+    OBJ_RELEASE(schedule);
+    return res;
   }
-#endif
 
   res = NBC_Schedule_request(schedule, comm, libnbc_module, persistent, request, NULL);
   if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
@@ -194,8 +132,25 @@ int ompi_coll_libnbc_iallgather(const void* sendbuf, int sendcount, MPI_Datatype
                                 MPI_Datatype recvtype, struct ompi_communicator_t *comm, ompi_request_t ** request,
                                 struct mca_coll_base_module_2_3_0_t *module)
 {
-    int res = nbc_allgather_init(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype,
+    NBC_Cache_key key;
+    int res;
+
+    NBC_Cache_key_init (&key, module, NBC_ALLGATHER);
+    NBC_CACHE_KEY_ADD(&key, sendbuf);
+    if (MPI_IN_PLACE != sendbuf) {
+        NBC_CACHE_KEY_ADD(&key, sendcount);
+        NBC_Cache_key_add_obj (&key, sendtype);
+    }
+    NBC_CACHE_KEY_ADD(&key, recvbuf);
+    NBC_CACHE_KEY_ADD(&key, recvcount);
+    NBC_Cache_key_add_obj (&key, recvtype);
+    NBC_CACHE_KEY_ADD(&key, libnbc_iallgather_algorithm);
+    res = NBC_Cache_request (&key, comm, request);
+    if (OMPI_ERR_NOT_FOUND == res) {
+        res = nbc_allgather_init(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype,
                                  comm, request, module, false);
+        NBC_Cache_insert (&key, res, *request);
+    }
     if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
         return res;
     }
@@ -270,8 +225,22 @@ static int nbc_allgather_inter_init(const void* sendbuf, int sendcount, MPI_Data
 int ompi_coll_libnbc_iallgather_inter(const void* sendbuf, int sendcount, MPI_Datatype sendtype, void* recvbuf, int recvcount,
 				      MPI_Datatype recvtype, struct ompi_communicator_t *comm, ompi_request_t ** request,
 				      struct mca_coll_base_module_2_3_0_t *module) {
-    int res = nbc_allgather_inter_init(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype,
+    NBC_Cache_key key;
+    int res;
+
+    NBC_Cache_key_init (&key, module, NBC_ALLGATHER);
+    NBC_CACHE_KEY_ADD(&key, sendbuf);
+    NBC_CACHE_KEY_ADD(&key, sendcount);
+    NBC_Cache_key_add_obj (&key, sendtype);
+    NBC_CACHE_KEY_ADD(&key, recvbuf);
+    NBC_CACHE_KEY_ADD(&key, recvcount);
+    NBC_Cache_key_add_obj (&key, recvtype);
+    res = NBC_Cache_request (&key, comm, request);
+    if (OMPI_ERR_NOT_FOUND == res) {
+        res = nbc_allgather_inter_init(sendbuf, sendcount, sendtype, recvbuf, recvcount, recvtype,
                                        comm, request, module, false);
+        NBC_Cache_insert (&key, res, *request);
+    }
     if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
         return res;
     }
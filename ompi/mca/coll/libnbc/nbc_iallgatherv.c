@@ -22,10 +22,6 @@
  */
 #include "nbc_internal.h"
 
-/* an allgatherv schedule can not be cached easily because the contents
- * ot the recvcounts array may change, so a comparison of the address
- * would not be sufficient ... we simply do not cache it */
-
 /* simple linear MPI_Iallgatherv
  * the algorithm uses p-1 rounds
  * first round:
@@ -58,7 +54,8 @@ static int nbc_allgatherv_init(const void* sendbuf, int sendcount, MPI_Datatype
   if (inplace) {
       sendtype = recvtype;
       sendcount = recvcounts[rank];
-  } else if (!persistent) { /* for persistent, the copy must be scheduled */
+  } else if (!persistent && !NBC_Cache_enabled ()) {
+    /* for persistent and cached schedules, the copy must be scheduled */
     /* copy my data to receive buffer */
     rbuf = (char *) recvbuf + displs[rank] * rcvext;
     res = NBC_Copy (sendbuf, sendcount, sendtype, rbuf, recvcounts[rank], recvtype, comm);
@@ -74,7 +71,7 @@ static int nbc_allgatherv_init(const void* sendbuf, int sendcount, MPI_Datatype
 
   sbuf = (char *) recvbuf + displs[rank] * rcvext;
 
-  if (persistent && !inplace) { /* for nonblocking, data has been copied already */
+  if ((persistent || NBC_Cache_enabled ()) && !inplace) { /* otherwise, data has been copied already */
     /* copy my data to receive buffer (= send buffer of NBC_Sched_send) */
     res = NBC_Sched_copy ((void *)sendbuf, false, sendcount, sendtype,
                           sbuf, false, recvcounts[rank], recvtype, schedule, true);
@@ -122,8 +119,25 @@ static int nbc_allgatherv_init(const void* sendbuf, int sendcount, MPI_Datatype
 int ompi_coll_libnbc_iallgatherv(const void* sendbuf, int sendcount, MPI_Datatype sendtype, void* recvbuf, const int *recvcounts, const int *displs,
                                  MPI_Datatype recvtype, struct ompi_communicator_t *comm, ompi_request_t ** request,
                                  struct mca_coll_base_module_2_3_0_t *module) {
-    int res = nbc_allgatherv_init(sendbuf, sendcount, sendtype, recvbuf, recvcounts, displs, recvtype,
+    NBC_Cache_key key;
+    int res;
+
+    NBC_Cache_key_init (&key, module, NBC_ALLGATHERV);
+    NBC_CACHE_KEY_ADD(&key, sendbuf);
+    if (MPI_IN_PLACE != sendbuf) {
+        NBC_CACHE_KEY_ADD(&key, sendcount);
+        NBC_Cache_key_add_obj (&key, sendtype);
+    }
+    NBC_CACHE_KEY_ADD(&key, recvbuf);
+    NBC_CACHE_KEY_ADD_ARRAY(&key, recvcounts, ompi_comm_size (comm));
+    NBC_CACHE_KEY_ADD_ARRAY(&key, displs, ompi_comm_size (comm));
+    NBC_Cache_key_add_obj (&key, recvtype);
+    res = NBC_Cache_request (&key, comm, request);
+    if (OMPI_ERR_NOT_FOUND == res) {
+        res = nbc_allgatherv_init(sendbuf, sendcount, sendtype, recvbuf, recvcounts, displs, recvtype,
                                   comm, request, module, false);
+        NBC_Cache_insert (&key, res, *request);
+    }
     if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
         return res;
     }
@@ -201,8 +215,23 @@ static int nbc_allgatherv_inter_init(const void* sendbuf, int sendcount, MPI_Dat
 int ompi_coll_libnbc_iallgatherv_inter(const void* sendbuf, int sendcount, MPI_Datatype sendtype, void* recvbuf, const int *recvcounts, const int *displs,
                                        MPI_Datatype recvtype, struct ompi_communicator_t *comm, ompi_request_t ** request,
                                        struct mca_coll_base_module_2_3_0_t *module) {
-    int res = nbc_allgatherv_inter_init(sendbuf, sendcount, sendtype, recvbuf, recvcounts, displs, recvtype,
+    NBC_Cache_key key;
+    int res;
+
+    NBC_Cache_key_init (&key, module, NBC_ALLGATHERV);
+    NBC_CACHE_KEY_ADD(&key, sendbuf);
+    NBC_CACHE_KEY_ADD(&key, sendcount);
+    NBC_Cache_key_add_obj (&key, sendtype);
+    NBC_CACHE_KEY_ADD(&key, recvbuf);
+    NBC_CACHE_KEY_ADD_ARRAY(&key, recvcounts, ompi_comm_remote_size (comm));
+    NBC_CACHE_KEY_ADD_ARRAY(&key, displs, ompi_comm_remote_size (comm));
+    NBC_Cache_key_add_obj (&key, recvtype);
+    res = NBC_Cache_request (&key, comm, request);
+    if (OMPI_ERR_NOT_FOUND == res) {
+        res = nbc_allgatherv_inter_init(sendbuf, sendcount, sendtype, recvbuf, recvcounts, displs, recvtype,
                                         comm, request, module, false);
+        NBC_Cache_insert (&key, res, *request);
+    }
     if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
         return res;
     }
@@ -41,25 +41,9 @@ static inline int allred_sched_redscat_allgather(
     int rank, int comm_size, int count, MPI_Datatype datatype, ptrdiff_t gap,
     const void *sbuf, void *rbuf, MPI_Op op, char inplace,
     NBC_Schedule *schedule, void *tmpbuf, struct ompi_communicator_t *comm);
-
-#ifdef NBC_CACHE_SCHEDULE
-/* tree comparison function for schedule cache */
-int NBC_Allreduce_args_compare(NBC_Allreduce_args *a, NBC_Allreduce_args *b, void *param) {
-  if ((a->sendbuf == b->sendbuf) &&
-      (a->recvbuf == b->recvbuf) &&
-      (a->count == b->count) &&
-      (a->datatype == b->datatype) &&
-      (a->op == b->op)) {
-    return 0;
-  }
-
-  if( a->sendbuf < b->sendbuf ) {
-    return -1;
-  }
-
-  return 1;
-}
-#endif
+static inline int allred_sched_pipeline(int rank, int p, const void *sendbuf, void *recvbuf, int count,
+                                        MPI_Datatype datatype, MPI_Op op, char inplace, size_t size,
+                                        ptrdiff_t span, ptrdiff_t gap, int segsize, NBC_Schedule *schedule);
 
 static int nbc_allreduce_init(const void* sendbuf, void* recvbuf, int count, MPI_Datatype datatype, MPI_Op op,
                               struct ompi_communicator_t *comm, ompi_request_t ** request,
@@ -69,10 +53,7 @@ static int nbc_allreduce_init(const void* sendbuf, void* recvbuf, int count, MPI
   ptrdiff_t ext, lb;
   NBC_Schedule *schedule;
   size_t size;
-#ifdef NBC_CACHE_SCHEDULE
-  NBC_Allreduce_args *args, *found, search;
-#endif
-  enum { NBC_ARED_BINOMIAL, NBC_ARED_RING, NBC_ARED_REDSCAT_ALLGATHER, NBC_ARED_RDBL } alg;
+  enum { NBC_ARED_BINOMIAL, NBC_ARED_RING, NBC_ARED_REDSCAT_ALLGATHER, NBC_ARED_RDBL, NBC_ARED_PIPELINE } alg;
   char inplace;
   void *tmpbuf = NULL;
   ompi_coll_libnbc_module_t *libnbc_module = (ompi_coll_libnbc_module_t*) module;
@@ -106,19 +87,16 @@ static int nbc_allreduce_init(const void* sendbuf, void* recvbuf, int count, MPI
     return nbc_get_noop_request(persistent, request);
   }
 
-  span = opal_datatype_span(&datatype->super, count, &gap);
-  tmpbuf = malloc (span);
-  if (OPAL_UNLIKELY(NULL == tmpbuf)) {
-    return OMPI_ERR_OUT_OF_RESOURCE;
-  }
-
   /* algorithm selection */
   int nprocs_pof2 = opal_next_poweroftwo(p) >> 1;
   if (libnbc_iallreduce_algorithm == 0) {
-    if(p < 4 || size*count < 65536 || !ompi_op_is_commute(op) || inplace) {
+    if(p < 4 || size*count < 65536 || !ompi_op_is_commute(op)) {
       alg = NBC_ARED_BINOMIAL;
-    } else if (count >= nprocs_pof2 && ompi_op_is_commute(op)) {
+    } else if (count >= nprocs_pof2) {
+      /* works in place as well */
       alg = NBC_ARED_REDSCAT_ALLGATHER;
+    } else if (inplace) {
+      alg = NBC_ARED_PIPELINE;
     } else {
       alg = NBC_ARED_RING;
     }
@@ -131,88 +109,67 @@ static int nbc_allreduce_init(const void* sendbuf, void* recvbuf, int count, MPI
       alg = NBC_ARED_REDSCAT_ALLGATHER;
     else if (libnbc_iallreduce_algorithm == 4)
       alg = NBC_ARED_RDBL;
+    else if (libnbc_iallreduce_algorithm == 5 && ompi_op_is_commute(op))
+      alg = NBC_ARED_PIPELINE;
     else
       alg = NBC_ARED_RING;
-  }
-#ifdef NBC_CACHE_SCHEDULE
-  /* search schedule in communicator specific tree */
-  search.sendbuf = sendbuf;
-  search.recvbuf = recvbuf;
-  search.count = count;
-  search.datatype = datatype;
-  search.op = op;
-  found = (NBC_Allreduce_args *) hb_tree_search ((hb_tree *) libnbc_module->NBC_Dict[NBC_ALLREDUCE], &search);
-  if (NULL == found) {
-#endif
-    schedule = OBJ_NEW(NBC_Schedule);
-    if (NULL == schedule) {
-      free(tmpbuf);
-      return OMPI_ERR_OUT_OF_RESOURCE;
-    }
 
-    if (p == 1) {
-      res = NBC_Sched_copy((void *)sendbuf, false, count, datatype,
-                           recvbuf, false, count, datatype, schedule, false);
-    } else {
-      switch(alg) {
-        case NBC_ARED_BINOMIAL:
-          res = allred_sched_diss(rank, p, count, datatype, gap, sendbuf, recvbuf, op, inplace, schedule, tmpbuf);
-          break;
-        case NBC_ARED_REDSCAT_ALLGATHER:
-          res = allred_sched_redscat_allgather(rank, p, count, datatype, gap, sendbuf, recvbuf, op, inplace, schedule, tmpbuf, comm);
-          break;
-        case NBC_ARED_RING:
-          res = allred_sched_ring(rank, p, count, datatype, sendbuf, recvbuf, op, size, ext, schedule, tmpbuf);
-          break;
-        case NBC_ARED_RDBL:
-          res = allred_sched_recursivedoubling(rank, p, sendbuf, recvbuf, count, datatype, gap, op, inplace, schedule, tmpbuf);
-          break;
-      }
+    /* the ring reduces from sendbuf after recvbuf has been received into */
+    if (NBC_ARED_RING == alg && inplace) {
+      alg = NBC_ARED_BINOMIAL;
     }
+  }
 
-    if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
-      OBJ_RELEASE(schedule);
-      free(tmpbuf);
-      return res;
-    }
+  span = opal_datatype_span(&datatype->super, count, &gap);
+  /* the pipeline receives from two children at once */
+  tmpbuf = malloc ((NBC_ARED_PIPELINE == alg ? 2 : 1) * span);
+  if (OPAL_UNLIKELY(NULL == tmpbuf)) {
+    return OMPI_ERR_OUT_OF_RESOURCE;
+  }
 
-    res = NBC_Sched_commit(schedule);
-    if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
-      OBJ_RELEASE(schedule);
-      free(tmpbuf);
-      return res;
-    }
+  schedule = OBJ_NEW(NBC_Schedule);
+  if (NULL == schedule) {
+    free(tmpbuf);
+    return OMPI_ERR_OUT_OF_RESOURCE;
+  }
+  schedule->tmpbuf_size = (NBC_ARED_PIPELINE == alg ? 2 : 1) * span;
 
-#ifdef NBC_CACHE_SCHEDULE
-    /* save schedule to tree */
-    args = (NBC_Allreduce_args *) malloc (sizeof(args));
-    if (NULL != args) {
-      args->sendbuf = sendbuf;
-      args->recvbuf = recvbuf;
-      args->count = count;
-      args->datatype = datatype;
-      args->op = op;
-      args->schedule = schedule;
-      res = hb_tree_insert ((hb_tree *) libnbc_module->NBC_Dict[NBC_ALLREDUCE], args, args, 0);
-      if (0 == res) {
-        OBJ_RETAIN(schedule);
-
-        /* increase number of elements for A2A */
-        if (++libnbc_module->NBC_Dict_size[NBC_ALLREDUCE] > NBC_SCHED_DICT_UPPER) {
-          NBC_SchedCache_dictwipe ((hb_tree *) libnbc_module->NBC_Dict[NBC_ALLREDUCE],
-                                   &libnbc_module->NBC_Dict_size[NBC_ALLREDUCE]);
-        }
-      } else {
-        NBC_Error("error in dict_insert() (%i)", res);
-        free (args);
-      }
-    }
+  if (p == 1) {
+    res = NBC_Sched_copy((void *)sendbuf, false, count, datatype,
+                         recvbuf, false, count, datatype, schedule, false);
   } else {
-    /* found schedule */
-    schedule = found->schedule;
-    OBJ_RETAIN(schedule);
+    switch(alg) {
+      case NBC_ARED_BINOMIAL:
+        res = allred_sched_diss(rank, p, count, datatype, gap, sendbuf, recvbuf, op, inplace, schedule, tmpbuf);
+        break;
+      case NBC_ARED_REDSCAT_ALLGATHER:
+        res = allred_sched_redscat_allgather(rank, p, count, datatype, gap, sendbuf, recvbuf, op, inplace, schedule, tmpbuf, comm);
+        break;
+      case NBC_ARED_RING:
+        res = allred_sched_ring(rank, p, count, datatype, sendbuf, recvbuf, op, size, ext, schedule, tmpbuf);
+        break;
+      case NBC_ARED_RDBL:
+        res = allred_sched_recursivedoubling(rank, p, sendbuf, recvbuf, count, datatype, gap, op, inplace, schedule, tmpbuf);
+        break;
+      case NBC_ARED_PIPELINE:
+        res = allred_sched_pipeline(rank, p, sendbuf, recvbuf, count, datatype, op, inplace, size, span, gap,
+                                    0 < libnbc_iallreduce_segsize ? libnbc_iallreduce_segsize : 32768, schedule);
+        break;
+    }
+  }
+
+  if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
+    OBJ_RELEASE(schedule);
+    free(tmpbuf);
+    return res;
+  }
+
+  res = NBC_Sched_commit(schedule);
+  if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
+    OBJ_RELEASE(schedule);
+    free(tmpbuf);
+    return res;
   }
-#endif
 
   res = NBC_Schedule_request (schedule, comm, libnbc_module, persistent, request, tmpbuf);
   if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
@@ -227,8 +184,23 @@ static int nbc_allreduce_init(const void* sendbuf, void* recvbuf, int count, MPI
 int ompi_coll_libnbc_iallreduce(const void* sendbuf, void* recvbuf, int count, MPI_Datatype datatype, MPI_Op op,
                                 struct ompi_communicator_t *comm, ompi_request_t ** request,
                                 struct mca_coll_base_module_2_3_0_t *module) {
-    int res = nbc_allreduce_init(sendbuf, recvbuf, count, datatype, op,
+    NBC_Cache_key key;
+    int res;
+
+    NBC_Cache_key_init (&key, module, NBC_ALLREDUCE);
+    NBC_CACHE_KEY_ADD(&key, sendbuf);
+    NBC_CACHE_KEY_ADD(&key, recvbuf);
+    NBC_CACHE_KEY_ADD(&key, count);
+    NBC_Cache_key_add_obj (&key, datatype);
+    NBC_Cache_key_add_obj (&key, op);
+    NBC_CACHE_KEY_ADD(&key, libnbc_iallreduce_algorithm);
+    NBC_CACHE_KEY_ADD(&key, libnbc_iallreduce_segsize);
+    res = NBC_Cache_request (&key, comm, request);
+    if (OMPI_ERR_NOT_FOUND == res) {
+        res = nbc_allreduce_init(sendbuf, recvbuf, count, datatype, op,
                                  comm, request, module, false);
+        NBC_Cache_insert (&key, res, *request);
+    }
     if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
         return res;
     }
@@ -281,6 +253,7 @@ static int nbc_allreduce_inter_init(const void* sendbuf, void* recvbuf, int coun
     free(tmpbuf);
     return OMPI_ERR_OUT_OF_RESOURCE;
   }
+  schedule->tmpbuf_size = span;
 
   res = allred_sched_linear (rank, rsize, sendbuf, recvbuf, count, datatype, gap, op,
                              ext, size, schedule, tmpbuf);
@@ -310,8 +283,21 @@ static int nbc_allreduce_inter_init(const void* sendbuf, void* recvbuf, int coun
 int ompi_coll_libnbc_iallreduce_inter(const void* sendbuf, void* recvbuf, int count, MPI_Datatype datatype, MPI_Op op,
                                       struct ompi_communicator_t *comm, ompi_request_t ** request,
                                       struct mca_coll_base_module_2_3_0_t *module) {
-    int res = nbc_allreduce_inter_init(sendbuf, recvbuf, count, datatype, op,
+    NBC_Cache_key key;
+    int res;
+
+    NBC_Cache_key_init (&key, module, NBC_ALLREDUCE);
+    NBC_CACHE_KEY_ADD(&key, sendbuf);
+    NBC_CACHE_KEY_ADD(&key, recvbuf);
+    NBC_CACHE_KEY_ADD(&key, count);
+    NBC_Cache_key_add_obj (&key, datatype);
+    NBC_Cache_key_add_obj (&key, op);
+    res = NBC_Cache_request (&key, comm, request);
+    if (OMPI_ERR_NOT_FOUND == res) {
+        res = nbc_allreduce_inter_init(sendbuf, recvbuf, count, datatype, op,
                                        comm, request, module, false);
+        NBC_Cache_insert (&key, res, *request);
+    }
     if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
         return res;
     }
@@ -833,6 +819,41 @@ static inline int allred_sched_ring (int r, int p, int count, MPI_Datatype datat
   return res;
 }
 
+/* segmented pipelined allreduce: a binary tree reduce to rank 0 followed
+ * by a binary tree bcast from rank 0 (see nbc_pipeline_helpers.c). A
+ * segment is broadcast as soon as its reduction is done on rank 0, so
+ * both halves of the tree overlap over the segments */
+static inline int allred_sched_pipeline(int rank, int p, const void *sendbuf, void *recvbuf, int count,
+                                        MPI_Datatype datatype, MPI_Op op, char inplace, size_t size,
+                                        ptrdiff_t span, ptrdiff_t gap, int segsize, NBC_Schedule *schedule) {
+  int res, segcount, nseg, *seg_last;
+
+  if (0 == count) {
+    return OMPI_SUCCESS;
+  }
+
+  segcount = nbc_pipeline_segcount (count, size, segsize);
+  nseg = (count + segcount - 1) / segcount;
+  seg_last = (int *) malloc (nseg * sizeof (int));
+  if (NULL == seg_last) {
+    return OMPI_ERR_OUT_OF_RESOURCE;
+  }
+
+  res = NBC_Sched_pipeline_reduce (rank, p, 0, 2, sendbuf, recvbuf, inplace, count, datatype, op, segcount,
+                                   span, gap, seg_last, schedule);
+  if (OPAL_LIKELY(OMPI_SUCCESS == res)) {
+    /* rank 0 forwards a segment once it is reduced. The others receive the
+     * result into recvbuf, which has to wait for their own contribution
+     * to be sent when it lives there too */
+    res = NBC_Sched_pipeline_bcast (rank, p, 0, 2, recvbuf, count, datatype, segcount,
+                                    (0 == rank || inplace) ? seg_last : NULL, schedule);
+  }
+
+  free (seg_last);
+
+  return res;
+}
+
 static inline int allred_sched_linear(int rank, int rsize, const void *sendbuf, void *recvbuf, int count, MPI_Datatype datatype,
 				      ptrdiff_t gap, MPI_Op op, int ext, int size, NBC_Schedule *schedule, void *tmpbuf) {
   int res;
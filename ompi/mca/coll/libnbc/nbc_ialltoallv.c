@@ -36,10 +36,6 @@ static inline int a2av_sched_inplace(int rank, int p, NBC_Schedule *schedule,
                                     void *buf, const int *counts, const int *displs,
                                     MPI_Aint ext, MPI_Datatype type, ptrdiff_t gap);
 
-/* an alltoallv schedule can not be cached easily because the contents
- * ot the recvcounts array may change, so a comparison of the address
- * would not be sufficient ... we simply do not cache it */
-
 /* simple linear Alltoallv */
 static int nbc_alltoallv_init(const void* sendbuf, const int *sendcounts, const int *sdispls,
                               MPI_Datatype sendtype, void* recvbuf, const int *recvcounts, const int *rdispls,
@@ -96,6 +92,9 @@ static int nbc_alltoallv_init(const void* sendbuf, const int *sendcounts, const
     free(tmpbuf);
     return OMPI_ERR_OUT_OF_RESOURCE;
   }
+  if (inplace) {
+    schedule->tmpbuf_size = span;
+  }
 
 
   if (!inplace && sendcounts[rank] != 0) {
@@ -144,9 +143,27 @@ int ompi_coll_libnbc_ialltoallv(const void* sendbuf, const int *sendcounts, cons
                                 MPI_Datatype sendtype, void* recvbuf, const int *recvcounts, const int *rdispls,
                                 MPI_Datatype recvtype, struct ompi_communicator_t *comm, ompi_request_t ** request,
                                 struct mca_coll_base_module_2_3_0_t *module) {
-    int res = nbc_alltoallv_init(sendbuf, sendcounts, sdispls, sendtype,
+    NBC_Cache_key key;
+    int res, p = ompi_comm_size (comm);
+
+    NBC_Cache_key_init (&key, module, NBC_ALLTOALLV);
+    NBC_CACHE_KEY_ADD(&key, sendbuf);
+    if (MPI_IN_PLACE != sendbuf) {
+        NBC_CACHE_KEY_ADD_ARRAY(&key, sendcounts, p);
+        NBC_CACHE_KEY_ADD_ARRAY(&key, sdispls, p);
+        NBC_Cache_key_add_obj (&key, sendtype);
+    }
+    NBC_CACHE_KEY_ADD(&key, recvbuf);
+    NBC_CACHE_KEY_ADD_ARRAY(&key, recvcounts, p);
+    NBC_CACHE_KEY_ADD_ARRAY(&key, rdispls, p);
+    NBC_Cache_key_add_obj (&key, recvtype);
+    res = NBC_Cache_request (&key, comm, request);
+    if (OMPI_ERR_NOT_FOUND == res) {
+        res = nbc_alltoallv_init(sendbuf, sendcounts, sdispls, sendtype,
                                  recvbuf, recvcounts, rdispls, recvtype,
                                  comm, request, module, false);
+        NBC_Cache_insert (&key, res, *request);
+    }
     if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
         return res;
     }
@@ -232,9 +249,25 @@ int ompi_coll_libnbc_ialltoallv_inter (const void* sendbuf, const int *sendcount
 				       MPI_Datatype sendtype, void* recvbuf, const int *recvcounts, const int *rdispls,
 				       MPI_Datatype recvtype, struct ompi_communicator_t *comm, ompi_request_t ** request,
 				       struct mca_coll_base_module_2_3_0_t *module) {
-    int res = nbc_alltoallv_inter_init(sendbuf, sendcounts, sdispls, sendtype,
+    NBC_Cache_key key;
+    int res, rsize = ompi_comm_remote_size (comm);
+
+    NBC_Cache_key_init (&key, module, NBC_ALLTOALLV);
+    NBC_CACHE_KEY_ADD(&key, sendbuf);
+    NBC_CACHE_KEY_ADD_ARRAY(&key, sendcounts, rsize);
+    NBC_CACHE_KEY_ADD_ARRAY(&key, sdispls, rsize);
+    NBC_Cache_key_add_obj (&key, sendtype);
+    NBC_CACHE_KEY_ADD(&key, recvbuf);
+    NBC_CACHE_KEY_ADD_ARRAY(&key, recvcounts, rsize);
+    NBC_CACHE_KEY_ADD_ARRAY(&key, rdispls, rsize);
+    NBC_Cache_key_add_obj (&key, recvtype);
+    res = NBC_Cache_request (&key, comm, request);
+    if (OMPI_ERR_NOT_FOUND == res) {
+        res = nbc_alltoallv_inter_init(sendbuf, sendcounts, sdispls, sendtype,
                                        recvbuf, recvcounts, rdispls, recvtype,
                                        comm, request, module, false);
+        NBC_Cache_insert (&key, res, *request);
+    }
     if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
         return res;
     }
@@ -36,10 +36,6 @@ static inline int a2aw_sched_inplace(int rank, int p, NBC_Schedule *schedule,
                                     void *buf, const int *counts, const int *displs,
                                     struct ompi_datatype_t * const * types);
 
-/* an alltoallw schedule can not be cached easily because the contents
- * ot the recvcounts array may change, so a comparison of the address
- * would not be sufficient ... we simply do not cache it */
-
 /* simple linear Alltoallw */
 static int nbc_alltoallw_init(const void* sendbuf, const int *sendcounts, const int *sdispls,
                               struct ompi_datatype_t * const *sendtypes, void* recvbuf, const int *recvcounts, const int *rdispls,
@@ -84,6 +80,7 @@ static int nbc_alltoallw_init(const void* sendbuf, const int *sendcounts, const
     free(tmpbuf);
     return OMPI_ERR_OUT_OF_RESOURCE;
   }
+  schedule->tmpbuf_size = span;
 
   if (!inplace && sendcounts[rank] != 0) {
     rbuf = (char *) recvbuf + rdispls[rank];
@@ -130,9 +127,27 @@ int ompi_coll_libnbc_ialltoallw(const void* sendbuf, const int *sendcounts, cons
                                 struct ompi_datatype_t * const *sendtypes, void* recvbuf, const int *recvcounts, const int *rdispls,
                                 struct ompi_datatype_t * const *recvtypes, struct ompi_communicator_t *comm, ompi_request_t ** request,
 				struct mca_coll_base_module_2_3_0_t *module) {
-    int res = nbc_alltoallw_init(sendbuf, sendcounts, sdispls, sendtypes,
+    NBC_Cache_key key;
+    int res, p = ompi_comm_size (comm);
+
+    NBC_Cache_key_init (&key, module, NBC_ALLTOALLW);
+    NBC_CACHE_KEY_ADD(&key, sendbuf);
+    if (MPI_IN_PLACE != sendbuf) {
+        NBC_CACHE_KEY_ADD_ARRAY(&key, sendcounts, p);
+        NBC_CACHE_KEY_ADD_ARRAY(&key, sdispls, p);
+        NBC_Cache_key_add_objs (&key, (void * const *) sendtypes, p);
+    }
+    NBC_CACHE_KEY_ADD(&key, recvbuf);
+    NBC_CACHE_KEY_ADD_ARRAY(&key, recvcounts, p);
+    NBC_CACHE_KEY_ADD_ARRAY(&key, rdispls, p);
+    NBC_Cache_key_add_objs (&key, (void * const *) recvtypes, p);
+    res = NBC_Cache_request (&key, comm, request);
+    if (OMPI_ERR_NOT_FOUND == res) {
+        res = nbc_alltoallw_init(sendbuf, sendcounts, sdispls, sendtypes,
                                  recvbuf, recvcounts, rdispls, recvtypes,
                                  comm, request, module, false);
+        NBC_Cache_insert (&key, res, *request);
+    }
     if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
         return res;
     }
@@ -205,9 +220,25 @@ int ompi_coll_libnbc_ialltoallw_inter(const void* sendbuf, const int *sendcounts
                                       struct ompi_datatype_t * const *sendtypes, void* recvbuf, const int *recvcounts, const int *rdispls,
                                       struct ompi_datatype_t * const *recvtypes, struct ompi_communicator_t *comm, ompi_request_t ** request,
 				      struct mca_coll_base_module_2_3_0_t *module) {
-    int res = nbc_alltoallw_inter_init(sendbuf, sendcounts, sdispls, sendtypes,
+    NBC_Cache_key key;
+    int res, rsize = ompi_comm_remote_size (comm);
+
+    NBC_Cache_key_init (&key, module, NBC_ALLTOALLW);
+    NBC_CACHE_KEY_ADD(&key, sendbuf);
+    NBC_CACHE_KEY_ADD_ARRAY(&key, sendcounts, rsize);
+    NBC_CACHE_KEY_ADD_ARRAY(&key, sdispls, rsize);
+    NBC_Cache_key_add_objs (&key, (void * const *) sendtypes, rsize);
+    NBC_CACHE_KEY_ADD(&key, recvbuf);
+    NBC_CACHE_KEY_ADD_ARRAY(&key, recvcounts, rsize);
+    NBC_CACHE_KEY_ADD_ARRAY(&key, rdispls, rsize);
+    NBC_Cache_key_add_objs (&key, (void * const *) recvtypes, rsize);
+    res = NBC_Cache_request (&key, comm, request);
+    if (OMPI_ERR_NOT_FOUND == res) {
+        res = nbc_alltoallw_inter_init(sendbuf, sendcounts, sdispls, sendtypes,
                                        recvbuf, recvcounts, rdispls, recvtypes,
                                        comm, request, module, false);
+        NBC_Cache_insert (&key, res, *request);
+    }
     if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
         return res;
     }
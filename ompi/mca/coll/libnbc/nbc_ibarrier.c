@@ -32,63 +32,47 @@ static int nbc_barrier_init(struct ompi_communicator_t *comm, ompi_request_t **
   rank = ompi_comm_rank (comm);
   p = ompi_comm_size (comm);
 
-#ifdef NBC_CACHE_SCHEDULE
-  /* there only one argument set per communicator -> hang it directly at
-   * the tree-position, NBC_Dict_size[...] is 0 for not initialized and
-   * 1 for initialized. NBC_Dict[...] is a pointer to the schedule in
-   * this case */
-  if (libnbc_module->NBC_Dict_size[NBC_BARRIER] == 0) {
-    /* we did not init it yet */
-#endif
-    schedule = OBJ_NEW(NBC_Schedule);
-    if (OPAL_UNLIKELY(NULL == schedule)) {
-      return OMPI_ERR_OUT_OF_RESOURCE;
-    }
-
-    maxround = (int)ceil((log((double)p)/LOG2)-1);
-
-    for (int round = 0 ; round <= maxround ; ++round) {
-      sendpeer = (rank + (1 << round)) % p;
-      /* add p because modulo does not work with negative values */
-      recvpeer = ((rank - (1 << round)) + p) % p;
+  schedule = OBJ_NEW(NBC_Schedule);
+  if (OPAL_UNLIKELY(NULL == schedule)) {
+    return OMPI_ERR_OUT_OF_RESOURCE;
+  }
 
-      /* send msg to sendpeer */
-      res = NBC_Sched_send (NULL, false, 0, MPI_BYTE, sendpeer, schedule, false);
-      if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
-        OBJ_RELEASE(schedule);
-        return res;
-      }
+  maxround = (int)ceil((log((double)p)/LOG2)-1);
 
-      /* recv msg from recvpeer */
-      res = NBC_Sched_recv (NULL, false, 0, MPI_BYTE, recvpeer, schedule, false);
-      if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
-        OBJ_RELEASE(schedule);
-        return res;
-      }
+  for (int round = 0 ; round <= maxround ; ++round) {
+    sendpeer = (rank + (1 << round)) % p;
+    /* add p because modulo does not work with negative values */
+    recvpeer = ((rank - (1 << round)) + p) % p;
 
-      /* end communication round */
-      if (round < maxround) {
-        res = NBC_Sched_barrier (schedule);
-        if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
-          OBJ_RELEASE(schedule);
-          return res;
-        }
-      }
+    /* send msg to sendpeer */
+    res = NBC_Sched_send (NULL, false, 0, MPI_BYTE, sendpeer, schedule, false);
+    if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
+      OBJ_RELEASE(schedule);
+      return res;
     }
 
-    res = NBC_Sched_commit (schedule);
+    /* recv msg from recvpeer */
+    res = NBC_Sched_recv (NULL, false, 0, MPI_BYTE, recvpeer, schedule, false);
     if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
       OBJ_RELEASE(schedule);
       return res;
     }
 
-#ifdef NBC_CACHE_SCHEDULE
-    /* add it */
-    libnbc_module->NBC_Dict[NBC_BARRIER] = (hb_tree *) schedule;
-    libnbc_module->NBC_Dict_size[NBC_BARRIER] = 1;
+    /* end communication round */
+    if (round < maxround) {
+      res = NBC_Sched_barrier (schedule);
+      if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
+        OBJ_RELEASE(schedule);
+        return res;
+      }
+    }
+  }
+
+  res = NBC_Sched_commit (schedule);
+  if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
+    OBJ_RELEASE(schedule);
+    return res;
   }
-  OBJ_RETAIN(schedule);
-#endif
 
   res = NBC_Schedule_request(schedule, comm, libnbc_module, persistent, request, NULL);
   if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
@@ -101,7 +85,15 @@ static int nbc_barrier_init(struct ompi_communicator_t *comm, ompi_request_t **
 
 int ompi_coll_libnbc_ibarrier(struct ompi_communicator_t *comm, ompi_request_t ** request,
                               struct mca_coll_base_module_2_3_0_t *module) {
-    int res = nbc_barrier_init(comm, request, module, false);
+    NBC_Cache_key key;
+    int res;
+
+    NBC_Cache_key_init (&key, module, NBC_BARRIER);
+    res = NBC_Cache_request (&key, comm, request);
+    if (OMPI_ERR_NOT_FOUND == res) {
+        res = nbc_barrier_init(comm, request, module, false);
+        NBC_Cache_insert (&key, res, *request);
+    }
     if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
         return res;
     }
@@ -188,7 +180,15 @@ static int nbc_barrier_inter_init(struct ompi_communicator_t *comm, ompi_request
 
 int ompi_coll_libnbc_ibarrier_inter(struct ompi_communicator_t *comm, ompi_request_t ** request,
                                     struct mca_coll_base_module_2_3_0_t *module) {
-    int res = nbc_barrier_inter_init(comm, request, module, false);
+    NBC_Cache_key key;
+    int res;
+
+    NBC_Cache_key_init (&key, module, NBC_BARRIER);
+    res = NBC_Cache_request (&key, comm, request);
+    if (OMPI_ERR_NOT_FOUND == res) {
+        res = nbc_barrier_inter_init(comm, request, module, false);
+        NBC_Cache_insert (&key, res, *request);
+    }
     if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
         return res;
     }
@@ -24,29 +24,11 @@ static inline int bcast_sched_binomial(int rank, int p, int root, NBC_Schedule *
                                        MPI_Datatype datatype);
 static inline int bcast_sched_linear(int rank, int p, int root, NBC_Schedule *schedule, void *buffer, int count,
                                      MPI_Datatype datatype);
-static inline int bcast_sched_chain(int rank, int p, int root, NBC_Schedule *schedule, void *buffer, int count,
-                                    MPI_Datatype datatype, int fragsize, size_t size);
+static inline int bcast_sched_pipeline(int rank, int p, int root, NBC_Schedule *schedule, void *buffer, int count,
+                                       MPI_Datatype datatype, int fanout, int fragsize, size_t size);
 static inline int bcast_sched_knomial(int rank, int comm_size, int root, NBC_Schedule *schedule, void *buf,
                                       int count, MPI_Datatype datatype, int knomial_radix);
 
-#ifdef NBC_CACHE_SCHEDULE
-/* tree comparison function for schedule cache */
-int NBC_Bcast_args_compare(NBC_Bcast_args *a, NBC_Bcast_args *b, void *param) {
-  if ((a->buffer == b->buffer) &&
-      (a->count == b->count) &&
-      (a->datatype == b->datatype) &&
-      (a->root == b->root) ) {
-    return 0;
-  }
-
-  if( a->buffer < b->buffer ) {
-    return -1;
-  }
-
-  return 1;
-}
-#endif
-
 static int nbc_bcast_init(void *buffer, int count, MPI_Datatype datatype, int root,
                           struct ompi_communicator_t *comm, ompi_request_t ** request,
                           struct mca_coll_base_module_2_3_0_t *module, bool persistent)
@@ -54,10 +36,7 @@ static int nbc_bcast_init(void *buffer, int count, MPI_Datatype datatype, int ro
   int rank, p, res, segsize;
   size_t size;
   NBC_Schedule *schedule;
-#ifdef NBC_CACHE_SCHEDULE
-  NBC_Bcast_args *args, *found, search;
-#endif
-  enum { NBC_BCAST_LINEAR, NBC_BCAST_BINOMIAL, NBC_BCAST_CHAIN, NBC_BCAST_KNOMIAL } alg;
+  enum { NBC_BCAST_LINEAR, NBC_BCAST_BINOMIAL, NBC_BCAST_CHAIN, NBC_BCAST_KNOMIAL, NBC_BCAST_BINARY } alg;
   ompi_coll_libnbc_module_t *libnbc_module = (ompi_coll_libnbc_module_t*) module;
 
   rank = ompi_comm_rank (comm);
@@ -92,9 +71,12 @@ static int nbc_bcast_init(void *buffer, int count, MPI_Datatype datatype, int ro
       } else if (size * count < 524288) {
         alg = NBC_BCAST_CHAIN;
         segsize = 8192;
-      } else {
+      } else if (p <= 8) {
         alg = NBC_BCAST_CHAIN;
         segsize = 32768;
+      } else {
+        alg = NBC_BCAST_BINARY;
+        segsize = 32768;
       }
     }
   } else {
@@ -107,80 +89,50 @@ static int nbc_bcast_init(void *buffer, int count, MPI_Datatype datatype, int ro
       alg = NBC_BCAST_CHAIN;
     } else if (libnbc_ibcast_algorithm == 4 && libnbc_ibcast_knomial_radix > 1) {
       alg = NBC_BCAST_KNOMIAL;
+    } else if (libnbc_ibcast_algorithm == 5) {
+      alg = NBC_BCAST_BINARY;
     } else {
       alg = NBC_BCAST_LINEAR;
     }
   }
 
-#ifdef NBC_CACHE_SCHEDULE
-  /* search schedule in communicator specific tree */
-  search.buffer = buffer;
-  search.count = count;
-  search.datatype = datatype;
-  search.root = root;
-  found = (NBC_Bcast_args *) hb_tree_search ((hb_tree *) libnbc_module->NBC_Dict[NBC_BCAST], &search);
-  if (NULL == found) {
-#endif
-    schedule = OBJ_NEW(NBC_Schedule);
-    if (OPAL_UNLIKELY(NULL == schedule)) {
-      return OMPI_ERR_OUT_OF_RESOURCE;
-    }
+  if (0 < libnbc_ibcast_segsize) {
+    segsize = libnbc_ibcast_segsize;
+  }
 
-    switch(alg) {
-      case NBC_BCAST_LINEAR:
-        res = bcast_sched_linear(rank, p, root, schedule, buffer, count, datatype);
-        break;
-      case NBC_BCAST_BINOMIAL:
-        res = bcast_sched_binomial(rank, p, root, schedule, buffer, count, datatype);
-        break;
-      case NBC_BCAST_CHAIN:
-        res = bcast_sched_chain(rank, p, root, schedule, buffer, count, datatype, segsize, size);
-        break;
-      case NBC_BCAST_KNOMIAL:
-        res = bcast_sched_knomial(rank, p, root, schedule, buffer, count, datatype, libnbc_ibcast_knomial_radix);
-        break;
-    }
+  schedule = OBJ_NEW(NBC_Schedule);
+  if (OPAL_UNLIKELY(NULL == schedule)) {
+    return OMPI_ERR_OUT_OF_RESOURCE;
+  }
 
-    if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
-      OBJ_RELEASE(schedule);
-      return res;
-    }
+  switch(alg) {
+    case NBC_BCAST_LINEAR:
+      res = bcast_sched_linear(rank, p, root, schedule, buffer, count, datatype);
+      break;
+    case NBC_BCAST_BINOMIAL:
+      res = bcast_sched_binomial(rank, p, root, schedule, buffer, count, datatype);
+      break;
+    case NBC_BCAST_CHAIN:
+      res = bcast_sched_pipeline(rank, p, root, schedule, buffer, count, datatype, 1, segsize, size);
+      break;
+    case NBC_BCAST_BINARY:
+      res = bcast_sched_pipeline(rank, p, root, schedule, buffer, count, datatype, 2, segsize, size);
+      break;
+    case NBC_BCAST_KNOMIAL:
+      res = bcast_sched_knomial(rank, p, root, schedule, buffer, count, datatype, libnbc_ibcast_knomial_radix);
+      break;
+  }
 
-    res = NBC_Sched_commit (schedule);
-    if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
-      OBJ_RELEASE(schedule);
-      return res;
-    }
+  if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
+    OBJ_RELEASE(schedule);
+    return res;
+  }
 
-#ifdef NBC_CACHE_SCHEDULE
-    /* save schedule to tree */
-    args = (NBC_Bcast_args *) malloc (sizeof (args));
-    if (NULL != args) {
-      args->buffer = buffer;
-      args->count = count;
-      args->datatype = datatype;
-      args->root = root;
-      args->schedule = schedule;
-      res = hb_tree_insert ((hb_tree *) libnbc_module->NBC_Dict[NBC_BCAST], args, args, 0);
-      if (0 == res) {
-        OBJ_RETAIN (schedule);
-
-        /* increase number of elements for A2A */
-        if (++libnbc_module->NBC_Dict_size[NBC_BCAST] > NBC_SCHED_DICT_UPPER) {
-          NBC_SchedCache_dictwipe ((hb_tree *) libnbc_module->NBC_Dict[NBC_BCAST],
-                                   &libnbc_module->NBC_Dict_size[NBC_BCAST]);
-        }
-      } else {
-        NBC_Error("error in dict_insert() (%i)", res);
-        free (args);
-      }
-    }
-  } else {
-    /* found schedule */
-    schedule = found->schedule;
-    OBJ_RETAIN(schedule);
+  res = NBC_Sched_commit (schedule);
+  if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
+    OBJ_RELEASE(schedule);
+    return res;
   }
-#endif
 
   res = NBC_Schedule_request(schedule, comm, libnbc_module, persistent, request, NULL);
   if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
@@ -195,8 +147,24 @@ int ompi_coll_libnbc_ibcast(void *buffer, int count, MPI_Datatype datatype, int
                             struct ompi_communicator_t *comm, ompi_request_t ** request,
                             struct mca_coll_base_module_2_3_0_t *module)
 {
-    int res = nbc_bcast_init(buffer, count, datatype, root,
+    NBC_Cache_key key;
+    int res;
+
+    NBC_Cache_key_init (&key, module, NBC_BCAST);
+    NBC_CACHE_KEY_ADD(&key, buffer);
+    NBC_CACHE_KEY_ADD(&key, count);
+    NBC_Cache_key_add_obj (&key, datatype);
+    NBC_CACHE_KEY_ADD(&key, root);
+    NBC_CACHE_KEY_ADD(&key, libnbc_ibcast_algorithm);
+    NBC_CACHE_KEY_ADD(&key, libnbc_ibcast_knomial_radix);
+    NBC_CACHE_KEY_ADD(&key, libnbc_ibcast_segsize);
+    NBC_CACHE_KEY_ADD(&key, libnbc_ibcast_skip_dt_decision);
+    res = NBC_Cache_request (&key, comm, request);
+    if (OMPI_ERR_NOT_FOUND == res) {
+        res = nbc_bcast_init(buffer, count, datatype, root,
                              comm, request, module, false);
+        NBC_Cache_insert (&key, res, *request);
+    }
     if (OPAL_LIKELY(OMPI_SUCCESS != res)) {
         return res;
     }
@@ -300,66 +268,13 @@ static inline int bcast_sched_linear(int rank, int p, int root, NBC_Schedule *sc
   return OMPI_SUCCESS;
 }
 
-/* simple chained MPI_Ibcast */
-static inline int bcast_sched_chain(int rank, int p, int root, NBC_Schedule *schedule, void *buffer, int count, MPI_Datatype datatype, int fragsize, size_t size) {
-  int res, vrank, rpeer, speer, numfrag, fragcount, thiscount;
-  MPI_Aint ext;
-  char *buf;
-
-  RANK2VRANK(rank, vrank, root);
-  VRANK2RANK(rpeer, vrank-1, root);
-  VRANK2RANK(speer, vrank+1, root);
-  res = ompi_datatype_type_extent(datatype, &ext);
-  if (MPI_SUCCESS != res) {
-    NBC_Error("MPI Error in ompi_datatype_type_extent() (%i)", res);
-    return res;
-  }
-
-  if (count == 0) {
-    return OMPI_SUCCESS;
-  }
-
-  numfrag = count * size/fragsize;
-  if ((count * size) % fragsize != 0) {
-    numfrag++;
-  }
-
-  fragcount = count/numfrag;
-
-  for (int fragnum = 0 ; fragnum < numfrag ; ++fragnum) {
-    buf = (char *) buffer + fragnum * fragcount * ext;
-    thiscount = fragcount;
-    if (fragnum == numfrag-1) {
-      /* last fragment may not be full */
-      thiscount = count - fragcount * fragnum;
-    }
-
-    /* root does not receive */
-    if (vrank != 0) {
-      res = NBC_Sched_recv (buf, false, thiscount, datatype, rpeer, schedule, true);
-      if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
-        return res;
-      }
-    }
-
-    /* last rank does not send */
-    if (vrank != p-1) {
-      res = NBC_Sched_send (buf, false, thiscount, datatype, speer, schedule, false);
-      if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
-        return res;
-      }
-
-      /* this barrier here seems awaward but isn't!!!! */
-      if (vrank == 0)  {
-        res = NBC_Sched_barrier (schedule);
-        if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
-          return res;
-        }
-      }
-    }
-  }
-
-  return OMPI_SUCCESS;
+/* segmented pipelined MPI_Ibcast along a chain (fanout 1) or a tree
+ * (see nbc_pipeline_helpers.c), a segment is forwarded as soon as it
+ * arrived */
+static inline int bcast_sched_pipeline(int rank, int p, int root, NBC_Schedule *schedule, void *buffer, int count,
+                                       MPI_Datatype datatype, int fanout, int fragsize, size_t size) {
+  return NBC_Sched_pipeline_bcast (rank, p, root, fanout, buffer, count, datatype,
+                                   nbc_pipeline_segcount (count, size, fragsize), NULL, schedule);
 }
 
 /*
@@ -463,8 +378,22 @@ static int nbc_bcast_inter_init(void *buffer, int count, MPI_Datatype datatype,
 int ompi_coll_libnbc_ibcast_inter(void *buffer, int count, MPI_Datatype datatype, int root,
                                   struct ompi_communicator_t *comm, ompi_request_t ** request,
                                   struct mca_coll_base_module_2_3_0_t *module) {
-    int res = nbc_bcast_inter_init(buffer, count, datatype, root,
+    NBC_Cache_key key;
+    int res;
+
+    NBC_Cache_key_init (&key, module, NBC_BCAST);
+    NBC_CACHE_KEY_ADD(&key, root);
+    if (MPI_PROC_NULL != root) {
+        NBC_CACHE_KEY_ADD(&key, buffer);
+        NBC_CACHE_KEY_ADD(&key, count);
+        NBC_Cache_key_add_obj (&key, datatype);
+    }
+    res = NBC_Cache_request (&key, comm, request);
+    if (OMPI_ERR_NOT_FOUND == res) {
+        res = nbc_bcast_inter_init(buffer, count, datatype, root,
                                    comm, request, module, false);
+        NBC_Cache_insert (&key, res, *request);
+    }
     if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
         return res;
     }
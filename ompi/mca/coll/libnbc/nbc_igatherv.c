@@ -24,11 +24,6 @@
  */
 #include "nbc_internal.h"
 
-/* an gatherv schedule can not be cached easily because the contents
- * ot the recvcounts array may change, so a comparison of the address
- * would not be sufficient ... we simply do not cache it */
-
-
 static int nbc_gatherv_init(const void* sendbuf, int sendcount, MPI_Datatype sendtype,
                             void* recvbuf, const int *recvcounts, const int *displs, MPI_Datatype recvtype,
                             int root, struct ompi_communicator_t *comm, ompi_request_t ** request,
@@ -109,8 +104,28 @@ int ompi_coll_libnbc_igatherv(const void* sendbuf, int sendcount, MPI_Datatype s
                               void* recvbuf, const int *recvcounts, const int *displs, MPI_Datatype recvtype,
                               int root, struct ompi_communicator_t *comm, ompi_request_t ** request,
                               struct mca_coll_base_module_2_3_0_t *module) {
-    int res = nbc_gatherv_init(sendbuf, sendcount, sendtype, recvbuf, recvcounts, displs, recvtype, root,
+    NBC_Cache_key key;
+    int res;
+
+    NBC_Cache_key_init (&key, module, NBC_GATHERV);
+    NBC_CACHE_KEY_ADD(&key, root);
+    NBC_CACHE_KEY_ADD(&key, sendbuf);
+    if (root != ompi_comm_rank (comm) || MPI_IN_PLACE != sendbuf) {
+        NBC_CACHE_KEY_ADD(&key, sendcount);
+        NBC_Cache_key_add_obj (&key, sendtype);
+    }
+    if (root == ompi_comm_rank (comm)) {
+        NBC_CACHE_KEY_ADD(&key, recvbuf);
+        NBC_CACHE_KEY_ADD_ARRAY(&key, recvcounts, ompi_comm_size (comm));
+        NBC_CACHE_KEY_ADD_ARRAY(&key, displs, ompi_comm_size (comm));
+        NBC_Cache_key_add_obj (&key, recvtype);
+    }
+    res = NBC_Cache_request (&key, comm, request);
+    if (OMPI_ERR_NOT_FOUND == res) {
+        res = nbc_gatherv_init(sendbuf, sendcount, sendtype, recvbuf, recvcounts, displs, recvtype, root,
                                comm, request, module, false);
+        NBC_Cache_insert (&key, res, *request);
+    }
     if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
         return res;
     }
@@ -189,8 +204,27 @@ int ompi_coll_libnbc_igatherv_inter(const void* sendbuf, int sendcount, MPI_Data
                                     void* recvbuf, const int *recvcounts, const int *displs, MPI_Datatype recvtype,
                                     int root, struct ompi_communicator_t *comm, ompi_request_t ** request,
                                     struct mca_coll_base_module_2_3_0_t *module) {
-    int res = nbc_gatherv_inter_init(sendbuf, sendcount, sendtype, recvbuf, recvcounts, displs, recvtype, root,
+    NBC_Cache_key key;
+    int res;
+
+    NBC_Cache_key_init (&key, module, NBC_GATHERV);
+    NBC_CACHE_KEY_ADD(&key, root);
+    if (MPI_ROOT == root) {
+        NBC_CACHE_KEY_ADD(&key, recvbuf);
+        NBC_CACHE_KEY_ADD_ARRAY(&key, recvcounts, ompi_comm_remote_size (comm));
+        NBC_CACHE_KEY_ADD_ARRAY(&key, displs, ompi_comm_remote_size (comm));
+        NBC_Cache_key_add_obj (&key, recvtype);
+    } else if (MPI_PROC_NULL != root) {
+        NBC_CACHE_KEY_ADD(&key, sendbuf);
+        NBC_CACHE_KEY_ADD(&key, sendcount);
+        NBC_Cache_key_add_obj (&key, sendtype);
+    }
+    res = NBC_Cache_request (&key, comm, request);
+    if (OMPI_ERR_NOT_FOUND == res) {
+        res = nbc_gatherv_inter_init(sendbuf, sendcount, sendtype, recvbuf, recvcounts, displs, recvtype, root,
                                      comm, request, module, false);
+        NBC_Cache_insert (&key, res, *request);
+    }
     if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
         return res;
     }
@@ -44,7 +44,6 @@
 #include <assert.h>
 #include <math.h>
 #include <string.h>
-#include "libdict/dict.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -74,6 +73,12 @@ extern "C" {
 #define NBC_SCAN 13
 #define NBC_SCATTER 14
 #define NBC_SCATTERV 15
+#define NBC_REDUCESCAT_BLOCK 16
+#define NBC_NEIGHBOR_ALLGATHER 17
+#define NBC_NEIGHBOR_ALLGATHERV 18
+#define NBC_NEIGHBOR_ALLTOALL 19
+#define NBC_NEIGHBOR_ALLTOALLV 20
+#define NBC_NEIGHBOR_ALLTOALLW 21
 /* set the number of collectives in nbc.h !!!! */
 
 /* several typedefs for NBC */
@@ -84,7 +89,8 @@ typedef enum {
   RECV,
   OP,
   COPY,
-  UNPACK
+  UNPACK,
+  JOIN
 } NBC_Fn_type;
 
 /* the send argument struct */
@@ -145,6 +151,35 @@ typedef struct {
   char tmpoutbuf;
 } NBC_Args_unpack;
 
+/* a node of the schedule. The successor list of a node is
+ * succ[succ_offset] ... succ[succ_offset + nsucc - 1] in the schedule */
+typedef struct NBC_Sched_node {
+  union {
+    NBC_Fn_type type;
+    NBC_Args_send send;
+    NBC_Args_recv recv;
+    NBC_Args_op op;
+    NBC_Args_copy copy;
+    NBC_Args_unpack unpack;
+  } args;
+  int ndeps;
+  int nsucc;
+  int succ_offset;
+  int req;               /* request slot of a send or receive, -1 otherwise */
+} NBC_Sched_node;
+
+/* completion callback data of a send or receive posted by a running
+ * schedule. A completion is only queued once, by whoever claims it
+ * first: the callback, the check right after posting or the sweep */
+typedef struct NBC_Subreq {
+  NBC_Handle *handle;
+  int node;                      /* schedule node of the request */
+  int index;                     /* entry in handle->req_array */
+  opal_atomic_int32_t claimed;
+  ompi_request_complete_fn_t prev_cb;
+  void *prev_cb_data;
+} NBC_Subreq;
+
 /* internal function prototypes */
 int NBC_Sched_send (const void* buf, char tmpbuf, int count, MPI_Datatype datatype, int dest, NBC_Schedule *schedule, bool barrier);
 int NBC_Sched_local_send (const void* buf, char tmpbuf, int count, MPI_Datatype datatype, int dest,NBC_Schedule *schedule, bool barrier);
@@ -158,110 +193,9 @@ int NBC_Sched_unpack (void *inbuf, char tmpinbuf, int count, MPI_Datatype dataty
                       NBC_Schedule *schedule, bool barrier);
 
 int NBC_Sched_barrier (NBC_Schedule *schedule);
+int NBC_Sched_depend (NBC_Schedule *schedule, int pred, int succ);
 int NBC_Sched_commit (NBC_Schedule *schedule);
 
-#ifdef NBC_CACHE_SCHEDULE
-/* this is a dummy structure which is used to get the schedule out of
- * the collop specific structure. The schedule pointer HAS to be at the
- * first position and should NOT BE REORDERED by the compiler (C
- * guarantees that */
-struct NBC_dummyarg {
-  NBC_Schedule *schedule;
-};
-
-typedef struct {
-  NBC_Schedule *schedule;
-  void *sendbuf;
-  int sendcount;
-  MPI_Datatype sendtype;
-  void* recvbuf;
-  int recvcount;
-  MPI_Datatype recvtype;
-} NBC_Alltoall_args;
-int NBC_Alltoall_args_compare(NBC_Alltoall_args *a, NBC_Alltoall_args *b, void *param);
-
-typedef struct {
-  NBC_Schedule *schedule;
-  void *sendbuf;
-  int sendcount;
-  MPI_Datatype sendtype;
-  void* recvbuf;
-  int recvcount;
-  MPI_Datatype recvtype;
-} NBC_Allgather_args;
-int NBC_Allgather_args_compare(NBC_Allgather_args *a, NBC_Allgather_args *b, void *param);
-
-typedef struct {
-  NBC_Schedule *schedule;
-  void *sendbuf;
-  void* recvbuf;
-  int count;
-  MPI_Datatype datatype;
-  MPI_Op op;
-} NBC_Allreduce_args;
-int NBC_Allreduce_args_compare(NBC_Allreduce_args *a, NBC_Allreduce_args *b, void *param);
-
-typedef struct {
-  NBC_Schedule *schedule;
-  void *buffer;
-  int count;
-  MPI_Datatype datatype;
-  int root;
-} NBC_Bcast_args;
-int NBC_Bcast_args_compare(NBC_Bcast_args *a, NBC_Bcast_args *b, void *param);
-
-typedef struct {
-  NBC_Schedule *schedule;
-  void *sendbuf;
-  int sendcount;
-  MPI_Datatype sendtype;
-  void* recvbuf;
-  int recvcount;
-  MPI_Datatype recvtype;
-  int root;
-} NBC_Gather_args;
-int NBC_Gather_args_compare(NBC_Gather_args *a, NBC_Gather_args *b, void *param);
-
-typedef struct {
-  NBC_Schedule *schedule;
-  void *sendbuf;
-  void* recvbuf;
-  int count;
-  MPI_Datatype datatype;
-  MPI_Op op;
-  int root;
-} NBC_Reduce_args;
-int NBC_Reduce_args_compare(NBC_Reduce_args *a, NBC_Reduce_args *b, void *param);
-
-typedef struct {
-  NBC_Schedule *schedule;
-  void *sendbuf;
-  void* recvbuf;
-  int count;
-  MPI_Datatype datatype;
-  MPI_Op op;
-} NBC_Scan_args;
-int NBC_Scan_args_compare(NBC_Scan_args *a, NBC_Scan_args *b, void *param);
-
-typedef struct {
-  NBC_Schedule *schedule;
-  void *sendbuf;
-  int sendcount;
-  MPI_Datatype sendtype;
-  void* recvbuf;
-  int recvcount;
-  MPI_Datatype recvtype;
-  int root;
-} NBC_Scatter_args;
-int NBC_Scatter_args_compare(NBC_Scatter_args *a, NBC_Scatter_args *b, void *param);
-
-/* Schedule cache structures/functions */
-void NBC_SchedCache_args_delete(void *entry);
-void NBC_SchedCache_args_delete_key_dummy(void *k);
-
-#endif
-
-
 int NBC_Start(NBC_Handle *handle);
 int NBC_Schedule_request(NBC_Schedule *schedule, ompi_communicator_t *comm,
                          ompi_coll_libnbc_module_t *module, bool persistent,
@@ -270,103 +204,129 @@ void NBC_Return_handle(ompi_coll_libnbc_request_t *request);
 static inline int NBC_Type_intrinsic(MPI_Datatype type);
 int NBC_Create_fortran_handle(int *fhandle, NBC_Handle **handle);
 
-/* some macros */
+/* schedule cache (see nbc_cache.c). A nonblocking collective puts the
+ * collective id and every argument its schedule depends on into a key,
+ * except the communicator:
+ *
+ *   NBC_Cache_key_init (&key, module, NBC_BCAST);
+ *   NBC_CACHE_KEY_ADD(&key, buffer);
+ *   ...
+ *   res = NBC_Cache_request (&key, comm, request);
+ *   if (OMPI_ERR_NOT_FOUND == res) {
+ *     res = nbc_bcast_init (..., false);
+ *     NBC_Cache_insert (&key, res, *request);
+ *   }
+ *
+ * NBC_Cache_request releases the key unless it returns
+ * OMPI_ERR_NOT_FOUND, NBC_Cache_insert always releases it. The schedule
+ * of a cached request must not depend on anything but the key: the
+ * operations that a collective does while building the schedule, e.g.
+ * an early copy of the local data, have to be put into the schedule when
+ * the cache is enabled. Persistent requests are not cached. */
+#define NBC_CACHE_KEY_INLINE 128
+#define NBC_CACHE_KEY_INLINE_OBJS 4
+
+typedef struct NBC_Cache_key {
+  ompi_coll_libnbc_module_t *module; /* NULL if the call is not cached */
+  char *data;
+  size_t size;
+  size_t max_size;
+  opal_object_t **objs;              /* datatypes and operations to retain */
+  int num_objs;
+  int max_objs;
+  char inline_data[NBC_CACHE_KEY_INLINE];
+  opal_object_t *inline_objs[NBC_CACHE_KEY_INLINE_OBJS];
+} NBC_Cache_key;
+
+int NBC_Cache_key_grow (NBC_Cache_key *key, size_t size);
+int NBC_Cache_key_grow_objs (NBC_Cache_key *key);
+void NBC_Cache_key_fini (NBC_Cache_key *key);
+int NBC_Cache_request (NBC_Cache_key *key, ompi_communicator_t *comm, ompi_request_t **request);
+void NBC_Cache_insert (NBC_Cache_key *key, int res, ompi_request_t *request);
+void NBC_Cache_release (NBC_Handle *handle);
+void NBC_Cache_init (ompi_coll_libnbc_module_t *module);
+void NBC_Cache_fini (ompi_coll_libnbc_module_t *module);
+
+static inline bool NBC_Cache_enabled (void) {
+  return libnbc_schedule_cache;
+}
 
-static inline void NBC_Error (char *format, ...) {
-  va_list args;
+static inline void NBC_Cache_key_add (NBC_Cache_key *key, const void *data, size_t size) {
+  if (NULL == key->module || 0 == size) {
+    return;
+  }
 
-  va_start (args, format);
-  vfprintf (stderr, format, args);
-  fprintf (stderr, "\n");
-  va_end (args);
+  if (key->size + size > key->max_size && OMPI_SUCCESS != NBC_Cache_key_grow (key, size)) {
+    return;
+  }
+
+  memcpy (key->data + key->size, data, size);
+  key->size += size;
 }
 
-/* a schedule has the following format:
- * [schedule] ::= [size][round-schedule][delimiter][round-schedule][delimiter]...[end]
- * [size] ::= size of the schedule (int)
- * [round-schedule] ::= [num][type][type-args][type][type-args]...
- * [num] ::= number of elements in round (int)
- * [type] ::= function type (NBC_Fn_type)
- * [type-args] ::= type specific arguments (NBC_Args_send, NBC_Args_recv or, NBC_Args_op)
- * [delimiter] ::= 1 (char) - indicates that a round follows
- * [end] ::= 0 (char) - indicates that this is the last round
- */
+#define NBC_CACHE_KEY_ADD(key, value) NBC_Cache_key_add ((key), &(value), sizeof (value))
+#define NBC_CACHE_KEY_ADD_ARRAY(key, array, n) NBC_Cache_key_add ((key), (array), (n) * sizeof (*(array)))
 
-/*
- * The addresses of components of a round-schedule may be poorly aligned.
- * E.g., single-char delimiters can push addresses to odd-byte boundaries.
- * Or even ints can push 8-byte pointers to 4-byte boundaries.
- * So, for greater portability, we access components of a round-schedule with memcpy.
- */
-#define NBC_GET_BYTES(ptr,x) {memcpy(&x,ptr,sizeof(x)); ptr += sizeof(x);}
-#define NBC_PUT_BYTES(ptr,x) {memcpy(ptr,&x,sizeof(x)); ptr += sizeof(x);}
-
-/* NBC_GET_ROUND_SIZE returns the size in bytes of a round of a NBC_Schedule
- * schedule. A round has the format:
- * [num]{[type][type-args]}
- * e.g. [(int)2][(NBC_Fn_type)SEND][(NBC_Args_send)SEND-ARGS][(NBC_Fn_type)RECV][(NBC_Args_recv)RECV-ARGS] */
-static inline void nbc_get_round_size (char *p, unsigned long *size) {
-  NBC_Fn_type type;
-  unsigned long offset = 0;
-  int num;
-
-  NBC_GET_BYTES(p,num);
-  /*NBC_DEBUG(10, "GET_ROUND_SIZE got %i elements\n", num); */
-  for (int i = 0 ; i < num ; ++i) {
-    memcpy (&type, p + offset, sizeof (type));
-    switch(type) {
-    case SEND:
-      /*printf("found a SEND at offset %li\n", (long)p-(long)schedule); */
-      offset += sizeof(NBC_Args_send);
-      break;
-    case RECV:
-      /*printf("found a RECV at offset %li\n", (long)p-(long)schedule); */
-      offset += sizeof(NBC_Args_recv);
-      break;
-    case OP:
-      /*printf("found a OP at offset %li\n", (long)p-(long)schedule); */
-      offset += sizeof(NBC_Args_op);            \
-      break;
-    case COPY:
-      /*printf("found a COPY at offset %li\n", (long)p-(long)schedule); */
-      offset += sizeof(NBC_Args_copy);
-      break;
-    case UNPACK:
-      /*printf("found a UNPACK at offset %li\n", (long)p-(long)schedule); */
-      offset += sizeof(NBC_Args_unpack);
-      break;
-    default:
-      NBC_Error("NBC_GET_ROUND_SIZE: bad type %i at offset %li", type, offset);
-      return;
-    }
+/* adds a datatype or an operation, which the cache entry will retain */
+static inline void NBC_Cache_key_add_obj (NBC_Cache_key *key, void *obj) {
+  if (NULL == key->module) {
+    return;
   }
 
-  *size = offset + sizeof (int);
-}
+  if (key->num_objs == key->max_objs && OMPI_SUCCESS != NBC_Cache_key_grow_objs (key)) {
+    return;
+  }
 
+  key->objs[key->num_objs++] = (opal_object_t *) obj;
+  NBC_Cache_key_add (key, &obj, sizeof (obj));
+}
 
-/* returns the size of a schedule in bytes */
-static inline int nbc_schedule_get_size (NBC_Schedule *schedule) {
-  return schedule->size;
+static inline void NBC_Cache_key_add_objs (NBC_Cache_key *key, void * const *objs, int n) {
+  for (int i = 0 ; i < n ; ++i) {
+    NBC_Cache_key_add_obj (key, objs[i]);
+  }
 }
 
-/* increase the size of a schedule by size bytes */
-static inline void nbc_schedule_inc_size (NBC_Schedule *schedule, int size) {
-  schedule->size += size;
+static inline void NBC_Cache_key_init (NBC_Cache_key *key, struct mca_coll_base_module_2_3_0_t *module, int coll) {
+  key->module = libnbc_schedule_cache ? (ompi_coll_libnbc_module_t *) module : NULL;
+  key->data = key->inline_data;
+  key->size = 0;
+  key->max_size = NBC_CACHE_KEY_INLINE;
+  key->objs = key->inline_objs;
+  key->num_objs = 0;
+  key->max_objs = NBC_CACHE_KEY_INLINE_OBJS;
+  NBC_CACHE_KEY_ADD(key, coll);
 }
 
-/* increments the number of operations in the last round */
-static inline void nbc_schedule_inc_round (NBC_Schedule *schedule) {
-  int last_round_num;
-  char *lastround;
+/* some macros */
 
-  lastround = schedule->data + schedule->current_round_offset;
+static inline void NBC_Error (char *format, ...) {
+  va_list args;
 
-  /* increment the count in the last round of the schedule (memcpy is used
-   * to protect against unaligned access) */
-  memcpy (&last_round_num, lastround, sizeof (last_round_num));
-  ++last_round_num;
-  memcpy (lastround, &last_round_num, sizeof (last_round_num));
+  va_start (args, format);
+  vfprintf (stderr, format, args);
+  fprintf (stderr, "\n");
+  va_end (args);
+}
+
+/* a schedule is a graph of operations (SEND, RECV, OP, COPY, UNPACK)
+ * and of JOIN nodes that do nothing. An operation is started as soon as
+ * all of its predecessors have finished, operations that become ready
+ * together are started in the order they were put into the schedule.
+ *
+ * The barrier argument of the NBC_Sched_* functions and NBC_Sched_barrier
+ * close the current round with a JOIN: the JOIN depends on every operation
+ * of the round and every later operation depends on the JOIN, which gives
+ * the round-by-round behavior the collectives were written for.
+ * NBC_Sched_depend adds an edge between two operations, e.g. to let the
+ * send of a segment depend only on the receive of the same segment.
+ * Operations that are not ordered by the graph may be posted in any
+ * order, so messages to the same peer that must match in order need an
+ * edge between them. */
+
+/* returns the id of the last operation (not JOIN) put into the schedule */
+static inline int nbc_schedule_last_op (NBC_Schedule *schedule) {
+  return schedule->last_op;
 }
 
 /* returns a no-operation request (e.g. for one process barrier) */
@@ -379,77 +339,44 @@ static inline int nbc_get_noop_request(bool persistent, ompi_request_t **request
   }
 }
 
-/* NBC_PRINT_ROUND prints a round in a schedule. A round has the format:
- * [num]{[type][type-args]} types: [int]{[enum][args-type]}
- * e.g. [2][SEND][SEND-ARGS][RECV][RECV-ARGS] */
-#define NBC_PRINT_ROUND(schedule) \
- {  \
-   int myrank, i, num; \
-   char *p = (char*) schedule; \
-   NBC_Fn_type type; \
-   NBC_Args_send     sendargs; \
-   NBC_Args_recv     recvargs; \
-   NBC_Args_op         opargs; \
-   NBC_Args_copy     copyargs; \
-   NBC_Args_unpack unpackargs; \
-     \
-   NBC_GET_BYTES(p,num); \
-   MPI_Comm_rank(MPI_COMM_WORLD, &myrank); \
-   printf("[%i] has %i actions: \n", myrank, num); \
-   for (i=0; i<num; i++) { \
-     NBC_GET_BYTES(p,type); \
-     switch(type) { \
-       case SEND: \
-         printf("[%i]  SEND (offset %li) ", myrank, (long)p-(long)schedule); \
-         NBC_GET_BYTES(p,sendargs); \
-         printf("*buf: %lu, count: %i, type: %lu, dest: %i)\n", (unsigned long)sendargs.buf, sendargs.count, (unsigned long)sendargs.datatype, sendargs.dest); \
-         break; \
-       case RECV: \
-         printf("[%i]  RECV (offset %li) ", myrank, (long)p-(long)schedule); \
-         NBC_GET_BYTES(p,recvargs); \
-         printf("*buf: %lu, count: %i, type: %lu, source: %i)\n", (unsigned long)recvargs.buf, recvargs.count, (unsigned long)recvargs.datatype, recvargs.source); \
-         break; \
-       case OP: \
-         printf("[%i]  OP   (offset %li) ", myrank, (long)p-(long)schedule); \
-         NBC_GET_BYTES(p,opargs); \
-         printf("*buf1: %lu, buf2: %lu, count: %i, type: %lu)\n", (unsigned long)opargs.buf1, (unsigned long)opargs.buf2, opargs.count, (unsigned long)opargs.datatype); \
-         break; \
-       case COPY: \
-         printf("[%i]  COPY   (offset %li) ", myrank, (long)p-(long)schedule); \
-         NBC_GET_BYTES(p,copyargs); \
-         printf("*src: %lu, srccount: %i, srctype: %lu, *tgt: %lu, tgtcount: %i, tgttype: %lu)\n", (unsigned long)copyargs.src, copyargs.srccount, (unsigned long)copyargs.srctype, (unsigned long)copyargs.tgt, copyargs.tgtcount, (unsigned long)copyargs.tgttype); \
-         break; \
-       case UNPACK: \
-         printf("[%i]  UNPACK   (offset %li) ", myrank, (long)p-(long)schedule); \
-         NBC_GET_BYTES(p,unpackargs); \
-         printf("*src: %lu, srccount: %i, srctype: %lu, *tgt: %lu\n",(unsigned long)unpackargs.inbuf, unpackargs.count, (unsigned long)unpackargs.datatype, (unsigned long)unpackargs.outbuf); \
-         break; \
-       default: \
-         printf("[%i] NBC_PRINT_ROUND: bad type %i at offset %li\n", myrank, type, (long)p-sizeof(type)-(long)schedule); \
-         return NBC_BAD_SCHED; \
-     } \
-   } \
-   printf("\n"); \
- }
-
+/* NBC_PRINT_SCHED prints the nodes of a committed schedule and their
+ * successors */
 #define NBC_PRINT_SCHED(schedule) \
 { \
-  int size, myrank; \
-  long round_size; \
-  char *ptr; \
+  int myrank; \
+  NBC_Sched_node *node; \
  \
-  NBC_GET_SIZE(schedule, size); \
   MPI_Comm_rank(MPI_COMM_WORLD, &myrank); \
-  printf("[%i] printing schedule of size %i\n", myrank, size); \
- \
-  /* ptr begins at first round (first int is overall size) */ \
-  ptr = (char*)schedule+sizeof(int); \
-  while ((long)ptr-(long)schedule < size) { \
-    NBC_GET_ROUND_SIZE(ptr, round_size); \
-    printf("[%i] Round at byte %li (size %li) ", myrank, (long)ptr-(long)schedule, round_size); \
-    NBC_PRINT_ROUND(ptr); \
-    ptr += round_size; \
-    ptr += sizeof(char); /* barrier delimiter */ \
+  printf("[%i] printing schedule with %i nodes\n", myrank, (schedule)->num_ops); \
+  for (int i = 0 ; i < (schedule)->num_ops ; ++i) { \
+    node = (schedule)->ops + i; \
+    switch(node->args.type) { \
+      case SEND: \
+        printf("[%i] %i SEND *buf: %lu, count: %i, type: %lu, dest: %i", myrank, i, (unsigned long)node->args.send.buf, node->args.send.count, (unsigned long)node->args.send.datatype, node->args.send.dest); \
+        break; \
+      case RECV: \
+        printf("[%i] %i RECV *buf: %lu, count: %i, type: %lu, source: %i", myrank, i, (unsigned long)node->args.recv.buf, node->args.recv.count, (unsigned long)node->args.recv.datatype, node->args.recv.source); \
+        break; \
+      case OP: \
+        printf("[%i] %i OP *buf1: %lu, buf2: %lu, count: %i, type: %lu", myrank, i, (unsigned long)node->args.op.buf1, (unsigned long)node->args.op.buf2, node->args.op.count, (unsigned long)node->args.op.datatype); \
+        break; \
+      case COPY: \
+        printf("[%i] %i COPY *src: %lu, srccount: %i, srctype: %lu, *tgt: %lu, tgtcount: %i, tgttype: %lu", myrank, i, (unsigned long)node->args.copy.src, node->args.copy.srccount, (unsigned long)node->args.copy.srctype, (unsigned long)node->args.copy.tgt, node->args.copy.tgtcount, (unsigned long)node->args.copy.tgttype); \
+        break; \
+      case UNPACK: \
+        printf("[%i] %i UNPACK *src: %lu, srccount: %i, srctype: %lu, *tgt: %lu", myrank, i, (unsigned long)node->args.unpack.inbuf, node->args.unpack.count, (unsigned long)node->args.unpack.datatype, (unsigned long)node->args.unpack.outbuf); \
+        break; \
+      case JOIN: \
+        printf("[%i] %i JOIN", myrank, i); \
+        break; \
+      default: \
+        printf("[%i] %i bad type %i", myrank, i, node->args.type); \
+    } \
+    printf(" (%i deps) ->", node->ndeps); \
+    for (int j = 0 ; j < node->nsucc ; ++j) { \
+      printf(" %i", (schedule)->succ[node->succ_offset + j]); \
+    } \
+    printf("\n"); \
   } \
 }
 
@@ -549,18 +476,6 @@ static inline int NBC_Unpack(void *src, int srccount, MPI_Datatype srctype, void
   return OMPI_SUCCESS;
 }
 
-/* deletes elements from dict until low watermark is reached */
-static inline void NBC_SchedCache_dictwipe(hb_tree *dict, int *size) {
-  hb_itor *itor;
-
-  itor = hb_itor_new(dict);
-  for (; hb_itor_valid(itor) && (*size>NBC_SCHED_DICT_LOWER); hb_itor_next(itor)) {
-    hb_tree_remove(dict, hb_itor_key(itor), 0);
-    *size = *size-1;
-  }
-  hb_itor_destroy(itor);
-}
-
 #define NBC_IN_PLACE(sendbuf, recvbuf, inplace) \
 { \
   inplace = 0; \
@@ -577,6 +492,23 @@ static inline void NBC_SchedCache_dictwipe(hb_tree *dict, int *size) {
   } \
 }
 
+/* number of elements of size bytes in a segment of at most segsize
+ * bytes, at least one. A segsize of 0 disables segmentation */
+static inline int nbc_pipeline_segcount (int count, size_t size, int segsize) {
+  if (segsize <= 0 || 0 == size || (size_t) segsize >= size * count) {
+    return count > 0 ? count : 1;
+  }
+
+  return segsize >= (int) size ? (int) (segsize / size) : 1;
+}
+
+int NBC_Sched_pipeline_bcast (int rank, int p, int root, int fanout, void *buf, int count,
+                              MPI_Datatype datatype, int segcount, const int *seg_ready,
+                              NBC_Schedule *schedule);
+int NBC_Sched_pipeline_reduce (int rank, int p, int root, int fanout, const void *sendbuf, void *recvbuf,
+                               char inplace, int count, MPI_Datatype datatype, MPI_Op op, int segcount,
+                               ptrdiff_t span, ptrdiff_t gap, int *seg_last, NBC_Schedule *schedule);
+
 int NBC_Comm_neighbors_count (ompi_communicator_t *comm, int *indegree, int *outdegree);
 int NBC_Comm_neighbors (ompi_communicator_t *comm, int **sources, int *source_count, int **destinations, int *dest_count);
 
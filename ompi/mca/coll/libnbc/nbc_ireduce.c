@@ -28,8 +28,9 @@
 
 static inline int red_sched_binomial (int rank, int p, int root, const void *sendbuf, void *redbuf, char tmpredbuf, int count, MPI_Datatype datatype,
                                       MPI_Op op, char inplace, NBC_Schedule *schedule, void *tmpbuf);
-static inline int red_sched_chain (int rank, int p, int root, const void *sendbuf, void *recvbuf, int count, MPI_Datatype datatype,
-                                   MPI_Op op, int ext, size_t size, NBC_Schedule *schedule, void *tmpbuf, int fragsize);
+static inline int red_sched_pipeline (int rank, int p, int root, int fanout, const void *sendbuf, void *recvbuf, char inplace,
+                                      int count, MPI_Datatype datatype, MPI_Op op, size_t size, ptrdiff_t span, ptrdiff_t gap,
+                                      NBC_Schedule *schedule, int fragsize);
 
 static inline int red_sched_linear (int rank, int rsize, int root, const void *sendbuf, void *recvbuf, void *tmpbuf, int count, MPI_Datatype datatype,
                                     MPI_Op op, NBC_Schedule *schedule);
@@ -38,26 +39,6 @@ static inline int red_sched_redscat_gather(
     char tmpredbuf, int count, MPI_Datatype datatype, MPI_Op op, char inplace,
     NBC_Schedule *schedule, void *tmp_buf, struct ompi_communicator_t *comm);
 
-#ifdef NBC_CACHE_SCHEDULE
-/* tree comparison function for schedule cache */
-int NBC_Reduce_args_compare(NBC_Reduce_args *a, NBC_Reduce_args *b, void *param) {
-  if ((a->sendbuf == b->sendbuf) &&
-      (a->recvbuf == b->recvbuf) &&
-      (a->count == b->count) &&
-      (a->datatype == b->datatype) &&
-      (a->op == b->op) &&
-      (a->root == b->root)) {
-    return 0;
-  }
-
-  if (a->sendbuf < b->sendbuf) {
-    return -1;
-  }
-
-  return 1;
-}
-#endif
-
 /* the non-blocking reduce */
 static int nbc_reduce_init(const void* sendbuf, void* recvbuf, int count, MPI_Datatype datatype,
                            MPI_Op op, int root, struct ompi_communicator_t *comm, ompi_request_t ** request,
@@ -69,7 +50,7 @@ static int nbc_reduce_init(const void* sendbuf, void* recvbuf, int count, MPI_Da
   char *redbuf=NULL, inplace;
   void *tmpbuf;
   char tmpredbuf = 0;
-  enum { NBC_RED_BINOMIAL, NBC_RED_CHAIN, NBC_RED_REDSCAT_GATHER} alg;
+  enum { NBC_RED_BINOMIAL, NBC_RED_CHAIN, NBC_RED_REDSCAT_GATHER, NBC_RED_BINARY} alg;
   ompi_coll_libnbc_module_t *libnbc_module = (ompi_coll_libnbc_module_t*) module;
   ptrdiff_t span, gap;
 
@@ -120,6 +101,8 @@ static int nbc_reduce_init(const void* sendbuf, void* recvbuf, int count, MPI_Da
       alg = NBC_RED_BINOMIAL;
     } else if (libnbc_ireduce_algorithm == 3 && ompi_op_is_commute(op) && p > 2 && count >= nprocs_pof2) {
       alg = NBC_RED_REDSCAT_GATHER;
+    } else if (libnbc_ireduce_algorithm == 4 && ompi_op_is_commute(op)) {
+      alg = NBC_RED_BINARY;
     } else {
       alg = NBC_RED_CHAIN;
     }
@@ -139,93 +122,58 @@ static int nbc_reduce_init(const void* sendbuf, void* recvbuf, int count, MPI_Da
       tmpredbuf = 1;
     }
   } else {
-    tmpbuf = malloc (span);
-    segsize = 16384/2;
+    /* one receive buffer per child in the pipeline */
+    tmpbuf = malloc ((NBC_RED_BINARY == alg ? 2 : 1) * span);
+    segsize = NBC_RED_BINARY == alg ? 32768 : 16384/2;
+    if (0 < libnbc_ireduce_segsize) {
+      segsize = libnbc_ireduce_segsize;
+    }
   }
 
   if (OPAL_UNLIKELY(NULL == tmpbuf)) {
     return OMPI_ERR_OUT_OF_RESOURCE;
   }
 
-#ifdef NBC_CACHE_SCHEDULE
-  NBC_Reduce_args *args, *found, search;
-
-  /* search schedule in communicator specific tree */
-  search.sendbuf = sendbuf;
-  search.recvbuf = recvbuf;
-  search.count = count;
-  search.datatype = datatype;
-  search.op = op;
-  search.root = root;
-  found = (NBC_Reduce_args *) hb_tree_search ((hb_tree *) libnbc_module->NBC_Dict[NBC_REDUCE], &search);
-  if (NULL == found) {
-#endif
-    schedule = OBJ_NEW(NBC_Schedule);
-    if (OPAL_UNLIKELY(NULL == schedule)) {
-      free(tmpbuf);
-      return OMPI_ERR_OUT_OF_RESOURCE;
-    }
+  schedule = OBJ_NEW(NBC_Schedule);
+  if (OPAL_UNLIKELY(NULL == schedule)) {
+    free(tmpbuf);
+    return OMPI_ERR_OUT_OF_RESOURCE;
+  }
+  /* an upper bound of the size of the temporary buffer */
+  schedule->tmpbuf_size = 2 * span + datatype->super.align;
 
-    if (p == 1) {
-      res = NBC_Sched_copy ((void *)sendbuf, false, count, datatype,
-                            recvbuf, false, count, datatype, schedule, false);
-    } else {
-      switch(alg) {
-        case NBC_RED_BINOMIAL:
-          res = red_sched_binomial(rank, p, root, sendbuf, redbuf, tmpredbuf, count, datatype, op, inplace, schedule, tmpbuf);
-          break;
-        case NBC_RED_CHAIN:
-          res = red_sched_chain(rank, p, root, sendbuf, recvbuf, count, datatype, op, ext, size, schedule, tmpbuf, segsize);
-          break;
-        case NBC_RED_REDSCAT_GATHER:
-          res = red_sched_redscat_gather(rank, p, root, sendbuf, redbuf, tmpredbuf, count, datatype, op, inplace, schedule, tmpbuf, comm);
-          break;
-      }
+  if (p == 1) {
+    res = NBC_Sched_copy ((void *)sendbuf, false, count, datatype,
+                          recvbuf, false, count, datatype, schedule, false);
+  } else {
+    switch(alg) {
+      case NBC_RED_BINOMIAL:
+        res = red_sched_binomial(rank, p, root, sendbuf, redbuf, tmpredbuf, count, datatype, op, inplace, schedule, tmpbuf);
+        break;
+      case NBC_RED_CHAIN:
+        res = red_sched_pipeline(rank, p, root, 1, sendbuf, recvbuf, inplace, count, datatype, op, size, span, gap, schedule, segsize);
+        break;
+      case NBC_RED_BINARY:
+        res = red_sched_pipeline(rank, p, root, 2, sendbuf, recvbuf, inplace, count, datatype, op, size, span, gap, schedule, segsize);
+        break;
+      case NBC_RED_REDSCAT_GATHER:
+        res = red_sched_redscat_gather(rank, p, root, sendbuf, redbuf, tmpredbuf, count, datatype, op, inplace, schedule, tmpbuf, comm);
+        break;
     }
+  }
 
-    if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
-      OBJ_RELEASE(schedule);
-      free(tmpbuf);
-      return res;
-    }
+  if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
+    OBJ_RELEASE(schedule);
+    free(tmpbuf);
+    return res;
+  }
 
-    res = NBC_Sched_commit(schedule);
-    if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
-      OBJ_RELEASE(schedule);
-      free(tmpbuf);
-      return res;
-    }
-#ifdef NBC_CACHE_SCHEDULE
-    /* save schedule to tree */
-    args = (NBC_Reduce_args *) malloc (sizeof (args));
-    if (NULL != args) {
-      args->sendbuf = sendbuf;
-      args->recvbuf = recvbuf;
-      args->count = count;
-      args->datatype = datatype;
-      args->op = op;
-      args->root = root;
-      args->schedule = schedule;
-      res = hb_tree_insert ((hb_tree *) libnbc_module->NBC_Dict[NBC_REDUCE], args, args, 0);
-      if (0 == res) {
-        OBJ_RETAIN(schedule);
-
-        /* increase number of elements for Reduce */
-        if (++libnbc_module->NBC_Dict_size[NBC_REDUCE] > NBC_SCHED_DICT_UPPER) {
-          NBC_SchedCache_dictwipe ((hb_tree *) libnbc_module->NBC_Dict[NBC_REDUCE],
-                                   &libnbc_module->NBC_Dict_size[NBC_REDUCE]);
-        }
-      } else {
-        NBC_Error("error in dict_insert() (%i)", res);
-        free (args);
-      }
-    }
-  } else {
-    /* found schedule */
-    schedule = found->schedule;
-    OBJ_RETAIN(schedule);
+  res = NBC_Sched_commit(schedule);
+  if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
+    OBJ_RELEASE(schedule);
+    free(tmpbuf);
+    return res;
   }
-#endif
 
   res = NBC_Schedule_request(schedule, comm, libnbc_module, persistent, request, tmpbuf);
   if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
@@ -240,8 +188,24 @@ static int nbc_reduce_init(const void* sendbuf, void* recvbuf, int count, MPI_Da
 int ompi_coll_libnbc_ireduce(const void* sendbuf, void* recvbuf, int count, MPI_Datatype datatype,
                              MPI_Op op, int root, struct ompi_communicator_t *comm, ompi_request_t ** request,
                              struct mca_coll_base_module_2_3_0_t *module) {
-    int res = nbc_reduce_init(sendbuf, recvbuf, count, datatype, op, root,
+    NBC_Cache_key key;
+    int res;
+
+    NBC_Cache_key_init (&key, module, NBC_REDUCE);
+    NBC_CACHE_KEY_ADD(&key, sendbuf);
+    NBC_CACHE_KEY_ADD(&key, recvbuf);
+    NBC_CACHE_KEY_ADD(&key, count);
+    NBC_Cache_key_add_obj (&key, datatype);
+    NBC_Cache_key_add_obj (&key, op);
+    NBC_CACHE_KEY_ADD(&key, root);
+    NBC_CACHE_KEY_ADD(&key, libnbc_ireduce_algorithm);
+    NBC_CACHE_KEY_ADD(&key, libnbc_ireduce_segsize);
+    res = NBC_Cache_request (&key, comm, request);
+    if (OMPI_ERR_NOT_FOUND == res) {
+        res = nbc_reduce_init(sendbuf, recvbuf, count, datatype, op, root,
                               comm, request, module, false);
+        NBC_Cache_insert (&key, res, *request);
+    }
     if (OPAL_LIKELY(OMPI_SUCCESS != res)) {
         return res;
     }
@@ -278,6 +242,7 @@ static int nbc_reduce_inter_init(const void* sendbuf, void* recvbuf, int count,
     free(tmpbuf);
     return OMPI_ERR_OUT_OF_RESOURCE;
   }
+  schedule->tmpbuf_size = span;
 
   res = red_sched_linear (rank, rsize, root, sendbuf, recvbuf, (void *)(-gap), count, datatype, op, schedule);
   if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
@@ -306,8 +271,24 @@ static int nbc_reduce_inter_init(const void* sendbuf, void* recvbuf, int count,
 int ompi_coll_libnbc_ireduce_inter(const void* sendbuf, void* recvbuf, int count, MPI_Datatype datatype,
                                    MPI_Op op, int root, struct ompi_communicator_t *comm, ompi_request_t ** request,
                                    struct mca_coll_base_module_2_3_0_t *module) {
-    int res = nbc_reduce_inter_init(sendbuf, recvbuf, count, datatype, op, root,
+    NBC_Cache_key key;
+    int res;
+
+    NBC_Cache_key_init (&key, module, NBC_REDUCE);
+    NBC_CACHE_KEY_ADD(&key, root);
+    if (MPI_PROC_NULL != root) {
+        NBC_CACHE_KEY_ADD(&key, sendbuf);
+        NBC_CACHE_KEY_ADD(&key, recvbuf);
+        NBC_CACHE_KEY_ADD(&key, count);
+        NBC_Cache_key_add_obj (&key, datatype);
+        NBC_Cache_key_add_obj (&key, op);
+    }
+    res = NBC_Cache_request (&key, comm, request);
+    if (OMPI_ERR_NOT_FOUND == res) {
+        res = nbc_reduce_inter_init(sendbuf, recvbuf, count, datatype, op, root,
                                     comm, request, module, false);
+        NBC_Cache_insert (&key, res, *request);
+    }
     if (OPAL_LIKELY(OMPI_SUCCESS != res)) {
         return res;
     }
@@ -457,82 +438,14 @@ static inline int red_sched_binomial (int rank, int p, int root, const void *sen
   return OMPI_SUCCESS;
 }
 
-/* chain send ... */
-static inline int red_sched_chain (int rank, int p, int root, const void *sendbuf, void *recvbuf, int count, MPI_Datatype datatype,
-                                   MPI_Op op, int ext, size_t size, NBC_Schedule *schedule, void *tmpbuf, int fragsize) {
-  int res, vrank, rpeer, speer, numfrag, fragcount, thiscount;
-  long offset;
-
-  RANK2VRANK(rank, vrank, root);
-  VRANK2RANK(rpeer, vrank+1, root);
-  VRANK2RANK(speer, vrank-1, root);
-
-  if (0 == count) {
-    return OMPI_SUCCESS;
-  }
-
-  numfrag = count * size / fragsize;
-  if ((count * size) % fragsize != 0) {
-    numfrag++;
-  }
-
-  fragcount = count / numfrag;
-
-  for (int fragnum = 0 ; fragnum < numfrag ; ++fragnum) {
-    offset = fragnum * fragcount * ext;
-    thiscount = fragcount;
-    if(fragnum == numfrag - 1) {
-      /* last fragment may not be full */
-      thiscount = count - fragcount * fragnum;
-    }
-
-    /* last node does not recv */
-    if (vrank != p-1) {
-      if (vrank == 0 && sendbuf != recvbuf) {
-          res = NBC_Sched_recv ((char *)recvbuf+offset, false, thiscount, datatype, rpeer, schedule, true);
-        } else {
-          res = NBC_Sched_recv ((char *)offset, true, thiscount, datatype, rpeer, schedule, true);
-        }
-      if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
-        return res;
-      }
-
-      /* root reduces into receivebuf */
-      if(vrank == 0) {
-        if (sendbuf != recvbuf) {
-            res = NBC_Sched_op ((char *) sendbuf + offset, false, (char *) recvbuf + offset, false,
-                                 thiscount, datatype, op, schedule, true);
-        } else {
-            res = NBC_Sched_op ((char *)offset, true, (char *) recvbuf + offset, false,
-                                 thiscount, datatype, op, schedule, true);
-        }
-      } else {
-        res = NBC_Sched_op ((char *) sendbuf + offset, false, (char *) offset, true, thiscount,
-                             datatype, op, schedule, true);
-      }
-
-      if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
-        return res;
-      }
-    }
-
-    /* root does not send */
-    if (vrank != 0) {
-      /* rank p-1 has to send out of sendbuffer :) */
-      /* the barrier here seems awkward but isn't!!!! */
-      if (vrank == p-1) {
-        res = NBC_Sched_send ((char *) sendbuf + offset, false, thiscount, datatype, speer, schedule, true);
-      } else {
-        res = NBC_Sched_send ((char *) offset, true, thiscount, datatype, speer, schedule, true);
-      }
-
-      if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
-        return res;
-      }
-    }
-  }
-
-  return OMPI_SUCCESS;
+/* segmented pipelined reduce along a chain (fanout 1) or a tree (see
+ * nbc_pipeline_helpers.c), a segment is reduced and forwarded as soon as
+ * it arrived from all the children */
+static inline int red_sched_pipeline (int rank, int p, int root, int fanout, const void *sendbuf, void *recvbuf, char inplace,
+                                      int count, MPI_Datatype datatype, MPI_Op op, size_t size, ptrdiff_t span, ptrdiff_t gap,
+                                      NBC_Schedule *schedule, int fragsize) {
+  return NBC_Sched_pipeline_reduce (rank, p, root, fanout, sendbuf, recvbuf, inplace, count, datatype, op,
+                                    nbc_pipeline_segcount (count, size, fragsize), span, gap, NULL, schedule);
 }
 
 /* simple linear algorithm for intercommunicators */
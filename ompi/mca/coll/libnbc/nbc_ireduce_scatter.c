@@ -25,10 +25,6 @@
 
 #include "nbc_internal.h"
 
-/* an reduce_csttare schedule can not be cached easily because the contents
- * ot the recvcounts array may change, so a comparison of the address
- * would not be sufficient ... we simply do not cache it */
-
 /* binomial reduce to rank 0 followed by a linear scatter ...
  *
  * Algorithm:
@@ -99,6 +95,7 @@ static int nbc_reduce_scatter_init(const void* sendbuf, void* recvbuf, const int
     free(tmpbuf);
     return OMPI_ERR_OUT_OF_RESOURCE;
   }
+  schedule->tmpbuf_size = span_align + span;
 
   for (int r = 1, firstred = 1 ; r <= maxr ; ++r) {
     if ((rank % (1 << r)) == 0) {
@@ -212,8 +209,21 @@ static int nbc_reduce_scatter_init(const void* sendbuf, void* recvbuf, const int
 int ompi_coll_libnbc_ireduce_scatter (const void* sendbuf, void* recvbuf, const int *recvcounts, MPI_Datatype datatype,
                                       MPI_Op op, struct ompi_communicator_t *comm, ompi_request_t ** request,
                                       struct mca_coll_base_module_2_3_0_t *module) {
-    int res = nbc_reduce_scatter_init(sendbuf, recvbuf, recvcounts, datatype, op,
+    NBC_Cache_key key;
+    int res;
+
+    NBC_Cache_key_init (&key, module, NBC_REDUCESCAT);
+    NBC_CACHE_KEY_ADD(&key, sendbuf);
+    NBC_CACHE_KEY_ADD(&key, recvbuf);
+    NBC_CACHE_KEY_ADD_ARRAY(&key, recvcounts, ompi_comm_size (comm));
+    NBC_Cache_key_add_obj (&key, datatype);
+    NBC_Cache_key_add_obj (&key, op);
+    res = NBC_Cache_request (&key, comm, request);
+    if (OMPI_ERR_NOT_FOUND == res) {
+        res = nbc_reduce_scatter_init(sendbuf, recvbuf, recvcounts, datatype, op,
                                       comm, request, module, false);
+        NBC_Cache_insert (&key, res, *request);
+    }
     if (OPAL_LIKELY(OMPI_SUCCESS != res)) {
         return res;
     }
@@ -266,6 +276,7 @@ static int nbc_reduce_scatter_inter_init (const void* sendbuf, void* recvbuf, co
     free(tmpbuf);
     return OMPI_ERR_OUT_OF_RESOURCE;
   }
+  schedule->tmpbuf_size = NULL == tmpbuf ? 0 : span_align + span;
 
   /* send my data to the remote root */
   res = NBC_Sched_send(sendbuf, false, count, datatype, 0, schedule, false);
@@ -354,8 +365,21 @@ static int nbc_reduce_scatter_inter_init (const void* sendbuf, void* recvbuf, co
 int ompi_coll_libnbc_ireduce_scatter_inter (const void* sendbuf, void* recvbuf, const int *recvcounts, MPI_Datatype datatype,
                                             MPI_Op op, struct ompi_communicator_t *comm, ompi_request_t ** request,
                                             struct mca_coll_base_module_2_3_0_t *module) {
-    int res = nbc_reduce_scatter_inter_init(sendbuf, recvbuf, recvcounts, datatype, op,
+    NBC_Cache_key key;
+    int res;
+
+    NBC_Cache_key_init (&key, module, NBC_REDUCESCAT);
+    NBC_CACHE_KEY_ADD(&key, sendbuf);
+    NBC_CACHE_KEY_ADD(&key, recvbuf);
+    NBC_CACHE_KEY_ADD_ARRAY(&key, recvcounts, ompi_comm_size (comm));
+    NBC_Cache_key_add_obj (&key, datatype);
+    NBC_Cache_key_add_obj (&key, op);
+    res = NBC_Cache_request (&key, comm, request);
+    if (OMPI_ERR_NOT_FOUND == res) {
+        res = nbc_reduce_scatter_inter_init(sendbuf, recvbuf, recvcounts, datatype, op,
                                             comm, request, module, false);
+        NBC_Cache_insert (&key, res, *request);
+    }
     if (OPAL_LIKELY(OMPI_SUCCESS != res)) {
         return res;
     }
@@ -23,10 +23,6 @@
 
 #include "nbc_internal.h"
 
-/* an reduce_csttare schedule can not be cached easily because the contents
- * ot the recvcount value may change, so a comparison of the address
- * would not be sufficient ... we simply do not cache it */
-
 /* binomial reduce to rank 0 followed by a linear scatter ...
  *
  * Algorithm:
@@ -82,6 +78,7 @@ static int nbc_reduce_scatter_block_init(const void* sendbuf, void* recvbuf, int
       OBJ_RELEASE(schedule);
       return OMPI_ERR_OUT_OF_RESOURCE;
     }
+    schedule->tmpbuf_size = span_align + span;
 
     rbuf = (void *)(-gap);
     lbuf = (char *)(span_align - gap);
@@ -210,8 +207,21 @@ static int nbc_reduce_scatter_block_init(const void* sendbuf, void* recvbuf, int
 int ompi_coll_libnbc_ireduce_scatter_block(const void* sendbuf, void* recvbuf, int recvcount, MPI_Datatype datatype,
                                            MPI_Op op, struct ompi_communicator_t *comm, ompi_request_t ** request,
                                            struct mca_coll_base_module_2_3_0_t *module) {
-    int res = nbc_reduce_scatter_block_init(sendbuf, recvbuf, recvcount, datatype, op,
+    NBC_Cache_key key;
+    int res;
+
+    NBC_Cache_key_init (&key, module, NBC_REDUCESCAT_BLOCK);
+    NBC_CACHE_KEY_ADD(&key, sendbuf);
+    NBC_CACHE_KEY_ADD(&key, recvbuf);
+    NBC_CACHE_KEY_ADD(&key, recvcount);
+    NBC_Cache_key_add_obj (&key, datatype);
+    NBC_Cache_key_add_obj (&key, op);
+    res = NBC_Cache_request (&key, comm, request);
+    if (OMPI_ERR_NOT_FOUND == res) {
+        res = nbc_reduce_scatter_block_init(sendbuf, recvbuf, recvcount, datatype, op,
                                             comm, request, module, false);
+        NBC_Cache_insert (&key, res, *request);
+    }
     if (OPAL_LIKELY(OMPI_SUCCESS != res)) {
         return res;
     }
@@ -262,6 +272,7 @@ static int nbc_reduce_scatter_block_inter_init(const void *sendbuf, void *recvbu
     free(tmpbuf);
     return OMPI_ERR_OUT_OF_RESOURCE;
   }
+  schedule->tmpbuf_size = NULL == tmpbuf ? 0 : span_align + span;
 
   /* send my data to the remote root */
   res = NBC_Sched_send (sendbuf, false, count, dtype, 0, schedule, false);
@@ -349,8 +360,21 @@ static int nbc_reduce_scatter_block_inter_init(const void *sendbuf, void *recvbu
 int ompi_coll_libnbc_ireduce_scatter_block_inter(const void* sendbuf, void* recvbuf, int recvcount, MPI_Datatype datatype,
                                                  MPI_Op op, struct ompi_communicator_t *comm, ompi_request_t ** request,
                                                  struct mca_coll_base_module_2_3_0_t *module) {
-    int res = nbc_reduce_scatter_block_inter_init(sendbuf, recvbuf, recvcount, datatype, op,
+    NBC_Cache_key key;
+    int res;
+
+    NBC_Cache_key_init (&key, module, NBC_REDUCESCAT_BLOCK);
+    NBC_CACHE_KEY_ADD(&key, sendbuf);
+    NBC_CACHE_KEY_ADD(&key, recvbuf);
+    NBC_CACHE_KEY_ADD(&key, recvcount);
+    NBC_Cache_key_add_obj (&key, datatype);
+    NBC_Cache_key_add_obj (&key, op);
+    res = NBC_Cache_request (&key, comm, request);
+    if (OMPI_ERR_NOT_FOUND == res) {
+        res = nbc_reduce_scatter_block_inter_init(sendbuf, recvbuf, recvcount, datatype, op,
                                                   comm, request, module, false);
+        NBC_Cache_insert (&key, res, *request);
+    }
     if (OPAL_LIKELY(OMPI_SUCCESS != res)) {
         return res;
     }
@@ -23,10 +23,6 @@
  */
 #include "nbc_internal.h"
 
-/* a scatterv schedule can not be cached easily because the contents
- * ot the recvcounts array may change, so a comparison of the address
- * would not be sufficient ... we simply do not cache it */
-
 /* simple linear MPI_Iscatterv */
 static int nbc_scatterv_init(const void* sendbuf, const int *sendcounts, const int *displs, MPI_Datatype sendtype,
                              void* recvbuf, int recvcount, MPI_Datatype recvtype, int root,
@@ -107,8 +103,28 @@ int ompi_coll_libnbc_iscatterv(const void* sendbuf, const int *sendcounts, const
                                void* recvbuf, int recvcount, MPI_Datatype recvtype, int root,
                                struct ompi_communicator_t *comm, ompi_request_t ** request,
                                struct mca_coll_base_module_2_3_0_t *module) {
-    int res = nbc_scatterv_init(sendbuf, sendcounts, displs, sendtype, recvbuf, recvcount, recvtype, root,
+    NBC_Cache_key key;
+    int res;
+
+    NBC_Cache_key_init (&key, module, NBC_SCATTERV);
+    NBC_CACHE_KEY_ADD(&key, root);
+    if (root == ompi_comm_rank (comm)) {
+        NBC_CACHE_KEY_ADD(&key, sendbuf);
+        NBC_CACHE_KEY_ADD_ARRAY(&key, sendcounts, ompi_comm_size (comm));
+        NBC_CACHE_KEY_ADD_ARRAY(&key, displs, ompi_comm_size (comm));
+        NBC_Cache_key_add_obj (&key, sendtype);
+    }
+    NBC_CACHE_KEY_ADD(&key, recvbuf);
+    if (root != ompi_comm_rank (comm) || MPI_IN_PLACE != recvbuf) {
+        NBC_CACHE_KEY_ADD(&key, recvcount);
+        NBC_Cache_key_add_obj (&key, recvtype);
+    }
+    res = NBC_Cache_request (&key, comm, request);
+    if (OMPI_ERR_NOT_FOUND == res) {
+        res = nbc_scatterv_init(sendbuf, sendcounts, displs, sendtype, recvbuf, recvcount, recvtype, root,
                                 comm, request, module, false);
+        NBC_Cache_insert (&key, res, *request);
+    }
     if (OPAL_LIKELY(OMPI_SUCCESS != res)) {
         return res;
     }
@@ -185,8 +201,27 @@ int ompi_coll_libnbc_iscatterv_inter(const void* sendbuf, const int *sendcounts,
                                      void* recvbuf, int recvcount, MPI_Datatype recvtype, int root,
                                      struct ompi_communicator_t *comm, ompi_request_t ** request,
                                      struct mca_coll_base_module_2_3_0_t *module) {
-    int res = nbc_scatterv_inter_init(sendbuf, sendcounts, displs, sendtype, recvbuf, recvcount, recvtype, root,
+    NBC_Cache_key key;
+    int res;
+
+    NBC_Cache_key_init (&key, module, NBC_SCATTERV);
+    NBC_CACHE_KEY_ADD(&key, root);
+    if (MPI_ROOT == root) {
+        NBC_CACHE_KEY_ADD(&key, sendbuf);
+        NBC_CACHE_KEY_ADD_ARRAY(&key, sendcounts, ompi_comm_remote_size (comm));
+        NBC_CACHE_KEY_ADD_ARRAY(&key, displs, ompi_comm_remote_size (comm));
+        NBC_Cache_key_add_obj (&key, sendtype);
+    } else if (MPI_PROC_NULL != root) {
+        NBC_CACHE_KEY_ADD(&key, recvbuf);
+        NBC_CACHE_KEY_ADD(&key, recvcount);
+        NBC_Cache_key_add_obj (&key, recvtype);
+    }
+    res = NBC_Cache_request (&key, comm, request);
+    if (OMPI_ERR_NOT_FOUND == res) {
+        res = nbc_scatterv_inter_init(sendbuf, sendcounts, displs, sendtype, recvbuf, recvcount, recvtype, root,
                                       comm, request, module, false);
+        NBC_Cache_insert (&key, res, *request);
+    }
     if (OPAL_LIKELY(OMPI_SUCCESS != res)) {
         return res;
     }
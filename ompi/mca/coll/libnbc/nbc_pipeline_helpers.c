@@ -0,0 +1,220 @@
+/* -*- Mode: C; c-basic-offset:2 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/*
+ * Segmented pipelined trees. The buffer is cut in segments and every
+ * segment only depends on the same segment one level up (bcast) or down
+ * (reduce) the tree, so the segments flow through the tree without
+ * waiting for each other. The tree is a k-ary heap in the virtual rank
+ * space where the root has vrank 0: the parent of vrank v is (v-1)/k and
+ * its children are v*k+1 ... v*k+k. A fanout of 1 is a chain.
+ *
+ * Consecutive segments sent to the same peer are ordered by a dependency
+ * on the previous send so that they are posted, and matched, in order.
+ * Receives have no predecessors (unless the caller provides some) and
+ * are all posted in segment order when the schedule starts.
+ */
+
+#include "nbc_internal.h"
+
+/* makes the last operation put into the schedule depend on pred, if any */
+static inline int nbc_sched_after (NBC_Schedule *schedule, int pred) {
+  if (pred < 0) {
+    return OMPI_SUCCESS;
+  }
+
+  return NBC_Sched_depend (schedule, pred, nbc_schedule_last_op (schedule));
+}
+
+static inline void nbc_tree_peers (int rank, int p, int root, int fanout, int *vrank, int *parent,
+                                   int *first_child, int *nchildren) {
+  int v = (rank - root + p) % p;
+
+  *vrank = v;
+  *parent = v ? ((v - 1) / fanout + root) % p : -1;
+  *first_child = v * fanout + 1;
+  *nchildren = 0;
+  for (int c = 0 ; c < fanout && *first_child + c < p ; ++c) {
+    ++*nchildren;
+  }
+}
+
+/* broadcasts buf from root. If seg_ready is not NULL, segment i is only
+ * sent (root) or received (other ranks) once node seg_ready[i] is done */
+int NBC_Sched_pipeline_bcast (int rank, int p, int root, int fanout, void *buf, int count,
+                              MPI_Datatype datatype, int segcount, const int *seg_ready,
+                              NBC_Schedule *schedule) {
+  int res = OMPI_SUCCESS, vrank, parent, first_child, nchildren, nseg, recv_id = -1;
+  int *last_send;
+  ptrdiff_t lb, ext;
+
+  if (0 == count) {
+    return OMPI_SUCCESS;
+  }
+
+  res = ompi_datatype_get_extent (datatype, &lb, &ext);
+  if (OMPI_SUCCESS != res) {
+    NBC_Error ("MPI Error in ompi_datatype_get_extent() (%i)", res);
+    return res;
+  }
+
+  nbc_tree_peers (rank, p, root, fanout, &vrank, &parent, &first_child, &nchildren);
+  nseg = (count + segcount - 1) / segcount;
+
+  last_send = (int *) malloc ((nchildren + 1) * sizeof (int));
+  if (NULL == last_send) {
+    return OMPI_ERR_OUT_OF_RESOURCE;
+  }
+  for (int c = 0 ; c < nchildren ; ++c) {
+    last_send[c] = -1;
+  }
+
+  for (int seg = 0 ; seg < nseg && OMPI_SUCCESS == res ; ++seg) {
+    char *segbuf = (char *) buf + (ptrdiff_t) seg * segcount * ext;
+    int segsize = (seg == nseg - 1) ? count - seg * segcount : segcount;
+
+    if (0 != vrank) {
+      res = NBC_Sched_recv (segbuf, false, segsize, datatype, parent, schedule, false);
+      if (OPAL_LIKELY(OMPI_SUCCESS == res) && NULL != seg_ready) {
+        res = nbc_sched_after (schedule, seg_ready[seg]);
+      }
+      if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
+        break;
+      }
+      recv_id = nbc_schedule_last_op (schedule);
+    } else if (NULL != seg_ready) {
+      recv_id = seg_ready[seg];
+    }
+
+    for (int c = 0 ; c < nchildren ; ++c) {
+      int child = (first_child + c + root) % p;
+
+      res = NBC_Sched_send (segbuf, false, segsize, datatype, child, schedule, false);
+      if (OPAL_LIKELY(OMPI_SUCCESS == res)) {
+        res = nbc_sched_after (schedule, recv_id);
+      }
+      if (OPAL_LIKELY(OMPI_SUCCESS == res)) {
+        res = nbc_sched_after (schedule, last_send[c]);
+      }
+      if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
+        break;
+      }
+      last_send[c] = nbc_schedule_last_op (schedule);
+    }
+  }
+
+  free (last_send);
+
+  return res;
+}
+
+/* reduces sendbuf into recvbuf on root. tmpbuf must hold fanout buffers
+ * of span bytes. On return seg_last[i] (if not NULL) is the last node of
+ * segment i: the reduction into recvbuf on root and the send to the
+ * parent elsewhere. The reduction of a rank is its own data first, then
+ * the data of its children in order, so the op has to be commutative
+ * unless the fanout is 1. */
+int NBC_Sched_pipeline_reduce (int rank, int p, int root, int fanout, const void *sendbuf, void *recvbuf,
+                               char inplace, int count, MPI_Datatype datatype, MPI_Op op, int segcount,
+                               ptrdiff_t span, ptrdiff_t gap, int *seg_last, NBC_Schedule *schedule) {
+  int res = OMPI_SUCCESS, vrank, parent, first_child, nchildren, nseg, last_send = -1;
+  ptrdiff_t lb, ext;
+
+  if (0 == count) {
+    return OMPI_SUCCESS;
+  }
+
+  res = ompi_datatype_get_extent (datatype, &lb, &ext);
+  if (OMPI_SUCCESS != res) {
+    NBC_Error ("MPI Error in ompi_datatype_get_extent() (%i)", res);
+    return res;
+  }
+
+  nbc_tree_peers (rank, p, root, fanout, &vrank, &parent, &first_child, &nchildren);
+  nseg = (count + segcount - 1) / segcount;
+
+  for (int seg = 0 ; seg < nseg ; ++seg) {
+    ptrdiff_t offset = (ptrdiff_t) seg * segcount * ext;
+    int segsize = (seg == nseg - 1) ? count - seg * segcount : segcount;
+    int last = -1;
+
+    for (int c = 0 ; c < nchildren ; ++c) {
+      int child = (first_child + c + root) % p;
+      char *cbuf = (char *) (c * span - gap) + offset;
+      int recv_id;
+
+      if (0 == vrank && 0 == c && !inplace) {
+        /* the data of the first child goes straight into recvbuf */
+        res = NBC_Sched_recv ((char *) recvbuf + offset, false, segsize, datatype, child, schedule, false);
+        if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
+          return res;
+        }
+        recv_id = nbc_schedule_last_op (schedule);
+
+        res = NBC_Sched_op ((char *) sendbuf + offset, false, (char *) recvbuf + offset, false,
+                            segsize, datatype, op, schedule, false);
+      } else {
+        res = NBC_Sched_recv (cbuf, true, segsize, datatype, child, schedule, false);
+        if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
+          return res;
+        }
+        recv_id = nbc_schedule_last_op (schedule);
+
+        if (0 == vrank) {
+          res = NBC_Sched_op (cbuf, true, (char *) recvbuf + offset, false, segsize, datatype, op,
+                              schedule, false);
+        } else if (0 == c) {
+          /* the own data is reduced into the buffer of the first child */
+          res = NBC_Sched_op ((char *) sendbuf + offset, false, cbuf, true, segsize, datatype, op,
+                              schedule, false);
+        } else {
+          res = NBC_Sched_op (cbuf, true, (char *) (-gap) + offset, true, segsize, datatype, op,
+                              schedule, false);
+        }
+      }
+      if (OPAL_LIKELY(OMPI_SUCCESS == res)) {
+        res = nbc_sched_after (schedule, recv_id);
+      }
+      if (OPAL_LIKELY(OMPI_SUCCESS == res)) {
+        res = nbc_sched_after (schedule, last);
+      }
+      if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
+        return res;
+      }
+      last = nbc_schedule_last_op (schedule);
+    }
+
+    if (0 != vrank) {
+      if (0 == nchildren) {
+        res = NBC_Sched_send ((char *) sendbuf + offset, false, segsize, datatype, parent, schedule, false);
+      } else {
+        res = NBC_Sched_send ((char *) (-gap) + offset, true, segsize, datatype, parent, schedule, false);
+      }
+      if (OPAL_LIKELY(OMPI_SUCCESS == res)) {
+        res = nbc_sched_after (schedule, last);
+      }
+      if (OPAL_LIKELY(OMPI_SUCCESS == res)) {
+        res = nbc_sched_after (schedule, last_send);
+      }
+      if (OPAL_UNLIKELY(OMPI_SUCCESS != res)) {
+        return res;
+      }
+      last = last_send = nbc_schedule_last_op (schedule);
+    }
+
+    if (NULL != seg_last) {
+      seg_last[seg] = last;
+    }
+  }
+
+  return OMPI_SUCCESS;
+}
@@ -4,6 +4,9 @@
  *                         and Technology (RIST).  All rights reserved.
  * Copyright (c) 2017      Amazon.com, Inc. or its affiliates.  All Rights
  *                         reserved.
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
  * $COPYRIGHT$
  *
  * Additional copyrights may follow
@@ -23,6 +26,7 @@ BEGIN_C_DECLS
 #include "ompi/datatype/ompi_datatype.h"
 #include "ompi/communicator/communicator.h"
 #include "ompi/mca/common/monitoring/common_monitoring.h"
+#include "ompi/mca/common/monitoring/common_monitoring_trace.h"
 
 struct mca_coll_monitoring_component_t {
     mca_coll_base_component_t super;
@@ -41,6 +45,47 @@ struct mca_coll_monitoring_module_t {
 typedef struct mca_coll_monitoring_module_t mca_coll_monitoring_module_t;
 OMPI_DECLSPEC OBJ_CLASS_DECLARATION(mca_coll_monitoring_module_t);
 
+/* Records a collective in the trace. The root, if any, is translated in
+ * its MPI_COMM_WORLD rank. The payload is not recorded, the underlying
+ * point-to-point messages already account for it. */
+static inline void mca_coll_monitoring_trace(mca_monitoring_op_t op, struct ompi_communicator_t *comm,
+                                             int root, opal_timer_t start, ompi_request_t *request)
+{
+    int world_rank = -1;
+
+    if( root >= 0 &&
+        OPAL_SUCCESS != mca_common_monitoring_get_world_rank(root, comm->c_remote_group, &world_rank) ) {
+        world_rank = -1;
+    }
+    if( NULL == request ) {
+        mca_common_monitoring_time_stop(op, world_rank, 0, ompi_comm_get_cid(comm), 0, start);
+    } else {
+        mca_common_monitoring_time_track(op, world_rank, 0, ompi_comm_get_cid(comm), 0, start, request);
+    }
+}
+
+/* Calls the real blocking collective and returns its result */
+#define MCA_COLL_MONITORING_CALL(OP, COMM, ROOT, CALL)                  \
+    do {                                                                \
+        opal_timer_t _start = mca_common_monitoring_time_start(OP);     \
+        int _ret = (CALL);                                              \
+        if( OPAL_UNLIKELY(0 != _start) && OMPI_SUCCESS == _ret ) {      \
+            mca_coll_monitoring_trace((OP), (COMM), (ROOT), _start, NULL); \
+        }                                                               \
+        return _ret;                                                    \
+    } while (0)
+
+/* Calls the real nonblocking collective and returns its result */
+#define MCA_COLL_MONITORING_ICALL(OP, COMM, ROOT, REQUEST, CALL)        \
+    do {                                                                \
+        opal_timer_t _start = mca_common_monitoring_time_start(OP);     \
+        int _ret = (CALL);                                              \
+        if( OPAL_UNLIKELY(0 != _start) && OMPI_SUCCESS == _ret ) {      \
+            mca_coll_monitoring_trace((OP), (COMM), (ROOT), _start, *(REQUEST)); \
+        }                                                               \
+        return _ret;                                                    \
+    } while (0)
+
 /* 
  * Coll interface functions
  */
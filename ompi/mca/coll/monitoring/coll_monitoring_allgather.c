@@ -40,7 +40,8 @@ int mca_coll_monitoring_allgather(const void *sbuf, int scount,
             mca_common_monitoring_record_coll(rank, data_size);
         }
     }
-    return monitoring_module->real.coll_allgather(sbuf, scount, sdtype, rbuf, rcount, rdtype, comm, monitoring_module->real.coll_allgather_module);
+    MCA_COLL_MONITORING_CALL(MCA_MONITORING_OP_COLL_ALLGATHER, comm, -1,
+                             monitoring_module->real.coll_allgather(sbuf, scount, sdtype, rbuf, rcount, rdtype, comm, monitoring_module->real.coll_allgather_module));
 }
 
 int mca_coll_monitoring_iallgather(const void *sbuf, int scount,
@@ -69,5 +70,6 @@ int mca_coll_monitoring_iallgather(const void *sbuf, int scount,
             mca_common_monitoring_record_coll(rank, data_size);
         }
     }
-    return monitoring_module->real.coll_iallgather(sbuf, scount, sdtype, rbuf, rcount, rdtype, comm, request, monitoring_module->real.coll_iallgather_module);
+    MCA_COLL_MONITORING_ICALL(MCA_MONITORING_OP_COLL_IALLGATHER, comm, -1, request,
+                              monitoring_module->real.coll_iallgather(sbuf, scount, sdtype, rbuf, rcount, rdtype, comm, request, monitoring_module->real.coll_iallgather_module));
 }
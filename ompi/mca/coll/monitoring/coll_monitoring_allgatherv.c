@@ -40,7 +40,8 @@ int mca_coll_monitoring_allgatherv(const void *sbuf, int scount,
             mca_common_monitoring_record_coll(rank, data_size);
         }
     }
-    return monitoring_module->real.coll_allgatherv(sbuf, scount, sdtype, rbuf, rcounts, disps, rdtype, comm, monitoring_module->real.coll_allgatherv_module);
+    MCA_COLL_MONITORING_CALL(MCA_MONITORING_OP_COLL_ALLGATHERV, comm, -1,
+                             monitoring_module->real.coll_allgatherv(sbuf, scount, sdtype, rbuf, rcounts, disps, rdtype, comm, monitoring_module->real.coll_allgatherv_module));
 }
 
 int mca_coll_monitoring_iallgatherv(const void *sbuf, int scount,
@@ -69,5 +70,6 @@ int mca_coll_monitoring_iallgatherv(const void *sbuf, int scount,
             mca_common_monitoring_record_coll(rank, data_size);
         }
     }
-    return monitoring_module->real.coll_iallgatherv(sbuf, scount, sdtype, rbuf, rcounts, disps, rdtype, comm, request, monitoring_module->real.coll_iallgatherv_module);
+    MCA_COLL_MONITORING_ICALL(MCA_MONITORING_OP_COLL_IALLGATHERV, comm, -1, request,
+                              monitoring_module->real.coll_iallgatherv(sbuf, scount, sdtype, rbuf, rcounts, disps, rdtype, comm, request, monitoring_module->real.coll_iallgatherv_module));
 }
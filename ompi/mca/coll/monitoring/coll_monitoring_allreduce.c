@@ -40,7 +40,8 @@ int mca_coll_monitoring_allreduce(const void *sbuf, void *rbuf, int count,
             mca_common_monitoring_record_coll(rank, data_size);
         }
     }
-    return monitoring_module->real.coll_allreduce(sbuf, rbuf, count, dtype, op, comm, monitoring_module->real.coll_allreduce_module);
+    MCA_COLL_MONITORING_CALL(MCA_MONITORING_OP_COLL_ALLREDUCE, comm, -1,
+                             monitoring_module->real.coll_allreduce(sbuf, rbuf, count, dtype, op, comm, monitoring_module->real.coll_allreduce_module));
 }
 
 int mca_coll_monitoring_iallreduce(const void *sbuf, void *rbuf, int count,
@@ -68,5 +69,6 @@ int mca_coll_monitoring_iallreduce(const void *sbuf, void *rbuf, int count,
             mca_common_monitoring_record_coll(rank, data_size);
         }
     }
-    return monitoring_module->real.coll_iallreduce(sbuf, rbuf, count, dtype, op, comm, request, monitoring_module->real.coll_iallreduce_module);
+    MCA_COLL_MONITORING_ICALL(MCA_MONITORING_OP_COLL_IALLREDUCE, comm, -1, request,
+                              monitoring_module->real.coll_iallreduce(sbuf, rbuf, count, dtype, op, comm, request, monitoring_module->real.coll_iallreduce_module));
 }
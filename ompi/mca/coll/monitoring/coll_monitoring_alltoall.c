@@ -38,7 +38,8 @@ int mca_coll_monitoring_alltoall(const void *sbuf, int scount, struct ompi_datat
             mca_common_monitoring_record_coll(rank, data_size);
         }
     }
-    return monitoring_module->real.coll_alltoall(sbuf, scount, sdtype, rbuf, rcount, rdtype, comm, monitoring_module->real.coll_alltoall_module);
+    MCA_COLL_MONITORING_CALL(MCA_MONITORING_OP_COLL_ALLTOALL, comm, -1,
+                             monitoring_module->real.coll_alltoall(sbuf, scount, sdtype, rbuf, rcount, rdtype, comm, monitoring_module->real.coll_alltoall_module));
 }
 
 int mca_coll_monitoring_ialltoall(const void *sbuf, int scount,
@@ -67,5 +68,6 @@ int mca_coll_monitoring_ialltoall(const void *sbuf, int scount,
             mca_common_monitoring_record_coll(rank, data_size);
         }
     }
-    return monitoring_module->real.coll_ialltoall(sbuf, scount, sdtype, rbuf, rcount, rdtype, comm, request, monitoring_module->real.coll_ialltoall_module);
+    MCA_COLL_MONITORING_ICALL(MCA_MONITORING_OP_COLL_IALLTOALL, comm, -1, request,
+                              monitoring_module->real.coll_ialltoall(sbuf, scount, sdtype, rbuf, rcount, rdtype, comm, request, monitoring_module->real.coll_ialltoall_module));
 }
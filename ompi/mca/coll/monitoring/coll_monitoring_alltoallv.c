@@ -41,7 +41,8 @@ int mca_coll_monitoring_alltoallv(const void *sbuf, const int *scounts, const in
         }
     }
     mca_common_monitoring_coll_a2a(data_size_aggreg, monitoring_module->data);
-    return monitoring_module->real.coll_alltoallv(sbuf, scounts, sdisps, sdtype, rbuf, rcounts, rdisps, rdtype, comm, monitoring_module->real.coll_alltoallv_module);
+    MCA_COLL_MONITORING_CALL(MCA_MONITORING_OP_COLL_ALLTOALLV, comm, -1,
+                             monitoring_module->real.coll_alltoallv(sbuf, scounts, sdisps, sdtype, rbuf, rcounts, rdisps, rdtype, comm, monitoring_module->real.coll_alltoallv_module));
 }
 
 int mca_coll_monitoring_ialltoallv(const void *sbuf, const int *scounts,
@@ -73,5 +74,6 @@ int mca_coll_monitoring_ialltoallv(const void *sbuf, const int *scounts,
         }
     }
     mca_common_monitoring_coll_a2a(data_size_aggreg, monitoring_module->data);
-    return monitoring_module->real.coll_ialltoallv(sbuf, scounts, sdisps, sdtype, rbuf, rcounts, rdisps, rdtype, comm, request, monitoring_module->real.coll_ialltoallv_module);
+    MCA_COLL_MONITORING_ICALL(MCA_MONITORING_OP_COLL_IALLTOALLV, comm, -1, request,
+                              monitoring_module->real.coll_ialltoallv(sbuf, scounts, sdisps, sdtype, rbuf, rcounts, rdisps, rdtype, comm, request, monitoring_module->real.coll_ialltoallv_module));
 }
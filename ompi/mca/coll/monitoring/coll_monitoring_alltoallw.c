@@ -43,7 +43,8 @@ int mca_coll_monitoring_alltoallw(const void *sbuf, const int *scounts,
         }
     }
     mca_common_monitoring_coll_a2a(data_size_aggreg, monitoring_module->data);
-    return monitoring_module->real.coll_alltoallw(sbuf, scounts, sdisps, sdtypes, rbuf, rcounts, rdisps, rdtypes, comm, monitoring_module->real.coll_alltoallw_module);
+    MCA_COLL_MONITORING_CALL(MCA_MONITORING_OP_COLL_ALLTOALLW, comm, -1,
+                             monitoring_module->real.coll_alltoallw(sbuf, scounts, sdisps, sdtypes, rbuf, rcounts, rdisps, rdtypes, comm, monitoring_module->real.coll_alltoallw_module));
 }
 
 int mca_coll_monitoring_ialltoallw(const void *sbuf, const int *scounts,
@@ -75,5 +76,6 @@ int mca_coll_monitoring_ialltoallw(const void *sbuf, const int *scounts,
         }
     }
     mca_common_monitoring_coll_a2a(data_size_aggreg, monitoring_module->data);
-    return monitoring_module->real.coll_ialltoallw(sbuf, scounts, sdisps, sdtypes, rbuf, rcounts, rdisps, rdtypes, comm, request, monitoring_module->real.coll_ialltoallw_module);
+    MCA_COLL_MONITORING_ICALL(MCA_MONITORING_OP_COLL_IALLTOALLW, comm, -1, request,
+                              monitoring_module->real.coll_ialltoallw(sbuf, scounts, sdisps, sdtypes, rbuf, rcounts, rdisps, rdtypes, comm, request, monitoring_module->real.coll_ialltoallw_module));
 }
@@ -32,7 +32,8 @@ int mca_coll_monitoring_barrier(struct ompi_communicator_t *comm,
 	}
     }
     mca_common_monitoring_coll_a2a(0, monitoring_module->data);
-    return monitoring_module->real.coll_barrier(comm, monitoring_module->real.coll_barrier_module);
+    MCA_COLL_MONITORING_CALL(MCA_MONITORING_OP_COLL_BARRIER, comm, -1,
+                             monitoring_module->real.coll_barrier(comm, monitoring_module->real.coll_barrier_module));
 }
 
 int mca_coll_monitoring_ibarrier(struct ompi_communicator_t *comm,
@@ -54,5 +55,6 @@ int mca_coll_monitoring_ibarrier(struct ompi_communicator_t *comm,
 	}
     }
     mca_common_monitoring_coll_a2a(0, monitoring_module->data);
-    return monitoring_module->real.coll_ibarrier(comm, request, monitoring_module->real.coll_ibarrier_module);
+    MCA_COLL_MONITORING_ICALL(MCA_MONITORING_OP_COLL_IBARRIER, comm, -1, request,
+                              monitoring_module->real.coll_ibarrier(comm, request, monitoring_module->real.coll_ibarrier_module));
 }
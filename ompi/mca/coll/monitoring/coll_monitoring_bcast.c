@@ -40,7 +40,8 @@ int mca_coll_monitoring_bcast(void *buff, int count,
             }
         }
     }
-    return monitoring_module->real.coll_bcast(buff, count, datatype, root, comm, monitoring_module->real.coll_bcast_module);
+    MCA_COLL_MONITORING_CALL(MCA_MONITORING_OP_COLL_BCAST, comm, root,
+                             monitoring_module->real.coll_bcast(buff, count, datatype, root, comm, monitoring_module->real.coll_bcast_module));
 }
 
 int mca_coll_monitoring_ibcast(void *buff, int count,
@@ -69,5 +70,6 @@ int mca_coll_monitoring_ibcast(void *buff, int count,
             }
         }
     }
-    return monitoring_module->real.coll_ibcast(buff, count, datatype, root, comm, request, monitoring_module->real.coll_ibcast_module);
+    MCA_COLL_MONITORING_ICALL(MCA_MONITORING_OP_COLL_IBCAST, comm, root, request,
+                              monitoring_module->real.coll_ibcast(buff, count, datatype, root, comm, request, monitoring_module->real.coll_ibcast_module));
 }
@@ -39,7 +39,8 @@ int mca_coll_monitoring_exscan(const void *sbuf, void *rbuf, int count,
             mca_common_monitoring_record_coll(rank, data_size);
         }
     }
-    return monitoring_module->real.coll_exscan(sbuf, rbuf, count, dtype, op, comm, monitoring_module->real.coll_exscan_module);
+    MCA_COLL_MONITORING_CALL(MCA_MONITORING_OP_COLL_EXSCAN, comm, -1,
+                             monitoring_module->real.coll_exscan(sbuf, rbuf, count, dtype, op, comm, monitoring_module->real.coll_exscan_module));
 }
 
 int mca_coll_monitoring_iexscan(const void *sbuf, void *rbuf, int count,
@@ -66,5 +67,6 @@ int mca_coll_monitoring_iexscan(const void *sbuf, void *rbuf, int count,
             mca_common_monitoring_record_coll(rank, data_size);
         }
     }
-    return monitoring_module->real.coll_iexscan(sbuf, rbuf, count, dtype, op, comm, request, monitoring_module->real.coll_iexscan_module);
+    MCA_COLL_MONITORING_ICALL(MCA_MONITORING_OP_COLL_IEXSCAN, comm, -1, request,
+                              monitoring_module->real.coll_iexscan(sbuf, rbuf, count, dtype, op, comm, request, monitoring_module->real.coll_iexscan_module));
 }
@@ -40,7 +40,8 @@ int mca_coll_monitoring_gather(const void *sbuf, int scount,
         }
         mca_common_monitoring_coll_a2o(data_size * (comm_size - 1), monitoring_module->data);
     }
-    return monitoring_module->real.coll_gather(sbuf, scount, sdtype, rbuf, rcount, rdtype, root, comm, monitoring_module->real.coll_gather_module);
+    MCA_COLL_MONITORING_CALL(MCA_MONITORING_OP_COLL_GATHER, comm, root,
+                             monitoring_module->real.coll_gather(sbuf, scount, sdtype, rbuf, rcount, rdtype, root, comm, monitoring_module->real.coll_gather_module));
 }
 
 int mca_coll_monitoring_igather(const void *sbuf, int scount,
@@ -69,5 +70,6 @@ int mca_coll_monitoring_igather(const void *sbuf, int scount,
         }
         mca_common_monitoring_coll_a2o(data_size * (comm_size - 1), monitoring_module->data);
     }
-    return monitoring_module->real.coll_igather(sbuf, scount, sdtype, rbuf, rcount, rdtype, root, comm, request, monitoring_module->real.coll_igather_module);
+    MCA_COLL_MONITORING_ICALL(MCA_MONITORING_OP_COLL_IGATHER, comm, root, request,
+                              monitoring_module->real.coll_igather(sbuf, scount, sdtype, rbuf, rcount, rdtype, root, comm, request, monitoring_module->real.coll_igather_module));
 }
@@ -43,7 +43,8 @@ int mca_coll_monitoring_gatherv(const void *sbuf, int scount,
         }
         mca_common_monitoring_coll_a2o(data_size_aggreg, monitoring_module->data);
     }
-    return monitoring_module->real.coll_gatherv(sbuf, scount, sdtype, rbuf, rcounts, disps, rdtype, root, comm, monitoring_module->real.coll_gatherv_module);
+    MCA_COLL_MONITORING_CALL(MCA_MONITORING_OP_COLL_GATHERV, comm, root,
+                             monitoring_module->real.coll_gatherv(sbuf, scount, sdtype, rbuf, rcounts, disps, rdtype, root, comm, monitoring_module->real.coll_gatherv_module));
 }
 
 int mca_coll_monitoring_igatherv(const void *sbuf, int scount,
@@ -75,5 +76,6 @@ int mca_coll_monitoring_igatherv(const void *sbuf, int scount,
         }
         mca_common_monitoring_coll_a2o(data_size_aggreg, monitoring_module->data);
     }
-    return monitoring_module->real.coll_igatherv(sbuf, scount, sdtype, rbuf, rcounts, disps, rdtype, root, comm, request, monitoring_module->real.coll_igatherv_module);
+    MCA_COLL_MONITORING_ICALL(MCA_MONITORING_OP_COLL_IGATHERV, comm, root, request,
+                              monitoring_module->real.coll_igatherv(sbuf, scount, sdtype, rbuf, rcounts, disps, rdtype, root, comm, request, monitoring_module->real.coll_igatherv_module));
 }
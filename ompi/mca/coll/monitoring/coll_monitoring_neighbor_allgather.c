@@ -65,7 +65,8 @@ int mca_coll_monitoring_neighbor_allgather(const void *sbuf, int scount,
 
     mca_common_monitoring_coll_a2a(data_size_aggreg, monitoring_module->data);
 
-    return monitoring_module->real.coll_neighbor_allgather(sbuf, scount, sdtype, rbuf, rcount, rdtype, comm, monitoring_module->real.coll_neighbor_allgather_module);
+    MCA_COLL_MONITORING_CALL(MCA_MONITORING_OP_COLL_NEIGHBOR_ALLGATHER, comm, -1,
+                             monitoring_module->real.coll_neighbor_allgather(sbuf, scount, sdtype, rbuf, rcount, rdtype, comm, monitoring_module->real.coll_neighbor_allgather_module));
 }
 
 int mca_coll_monitoring_ineighbor_allgather(const void *sbuf, int scount,
@@ -118,5 +119,6 @@ int mca_coll_monitoring_ineighbor_allgather(const void *sbuf, int scount,
 
     mca_common_monitoring_coll_a2a(data_size_aggreg, monitoring_module->data);
 
-    return monitoring_module->real.coll_ineighbor_allgather(sbuf, scount, sdtype, rbuf, rcount, rdtype, comm, request, monitoring_module->real.coll_ineighbor_allgather_module);
+    MCA_COLL_MONITORING_ICALL(MCA_MONITORING_OP_COLL_INEIGHBOR_ALLGATHER, comm, -1, request,
+                              monitoring_module->real.coll_ineighbor_allgather(sbuf, scount, sdtype, rbuf, rcount, rdtype, comm, request, monitoring_module->real.coll_ineighbor_allgather_module));
 }
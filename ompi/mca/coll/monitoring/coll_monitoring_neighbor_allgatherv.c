@@ -66,7 +66,8 @@ int mca_coll_monitoring_neighbor_allgatherv(const void *sbuf, int scount,
 
     mca_common_monitoring_coll_a2a(data_size_aggreg, monitoring_module->data);
 
-    return monitoring_module->real.coll_neighbor_allgatherv(sbuf, scount, sdtype, rbuf, rcounts, disps, rdtype, comm, monitoring_module->real.coll_neighbor_allgatherv_module);
+    MCA_COLL_MONITORING_CALL(MCA_MONITORING_OP_COLL_NEIGHBOR_ALLGATHERV, comm, -1,
+                             monitoring_module->real.coll_neighbor_allgatherv(sbuf, scount, sdtype, rbuf, rcounts, disps, rdtype, comm, monitoring_module->real.coll_neighbor_allgatherv_module));
 }
 
 int mca_coll_monitoring_ineighbor_allgatherv(const void *sbuf, int scount,
@@ -120,5 +121,6 @@ int mca_coll_monitoring_ineighbor_allgatherv(const void *sbuf, int scount,
 
     mca_common_monitoring_coll_a2a(data_size_aggreg, monitoring_module->data);
 
-    return monitoring_module->real.coll_ineighbor_allgatherv(sbuf, scount, sdtype, rbuf, rcounts, disps, rdtype, comm, request, monitoring_module->real.coll_ineighbor_allgatherv_module);
+    MCA_COLL_MONITORING_ICALL(MCA_MONITORING_OP_COLL_INEIGHBOR_ALLGATHERV, comm, -1, request,
+                              monitoring_module->real.coll_ineighbor_allgatherv(sbuf, scount, sdtype, rbuf, rcounts, disps, rdtype, comm, request, monitoring_module->real.coll_ineighbor_allgatherv_module));
 }
@@ -66,7 +66,8 @@ int mca_coll_monitoring_neighbor_alltoall(const void *sbuf, int scount,
 
     mca_common_monitoring_coll_a2a(data_size_aggreg, monitoring_module->data);
 
-    return monitoring_module->real.coll_neighbor_alltoall(sbuf, scount, sdtype, rbuf, rcount, rdtype, comm, monitoring_module->real.coll_neighbor_alltoall_module);
+    MCA_COLL_MONITORING_CALL(MCA_MONITORING_OP_COLL_NEIGHBOR_ALLTOALL, comm, -1,
+                             monitoring_module->real.coll_neighbor_alltoall(sbuf, scount, sdtype, rbuf, rcount, rdtype, comm, monitoring_module->real.coll_neighbor_alltoall_module));
 }
 
 int mca_coll_monitoring_ineighbor_alltoall(const void *sbuf, int scount,
@@ -120,5 +121,6 @@ int mca_coll_monitoring_ineighbor_alltoall(const void *sbuf, int scount,
 
     mca_common_monitoring_coll_a2a(data_size_aggreg, monitoring_module->data);
 
-    return monitoring_module->real.coll_ineighbor_alltoall(sbuf, scount, sdtype, rbuf, rcount, rdtype, comm, request, monitoring_module->real.coll_ineighbor_alltoall_module);
+    MCA_COLL_MONITORING_ICALL(MCA_MONITORING_OP_COLL_INEIGHBOR_ALLTOALL, comm, -1, request,
+                              monitoring_module->real.coll_ineighbor_alltoall(sbuf, scount, sdtype, rbuf, rcount, rdtype, comm, request, monitoring_module->real.coll_ineighbor_alltoall_module));
 }
@@ -69,7 +69,8 @@ int mca_coll_monitoring_neighbor_alltoallv(const void *sbuf, const int *scounts,
 
     mca_common_monitoring_coll_a2a(data_size_aggreg, monitoring_module->data);
 
-    return monitoring_module->real.coll_neighbor_alltoallv(sbuf, scounts, sdisps, sdtype, rbuf, rcounts, rdisps, rdtype, comm, monitoring_module->real.coll_neighbor_alltoallv_module);
+    MCA_COLL_MONITORING_CALL(MCA_MONITORING_OP_COLL_NEIGHBOR_ALLTOALLV, comm, -1,
+                             monitoring_module->real.coll_neighbor_alltoallv(sbuf, scounts, sdisps, sdtype, rbuf, rcounts, rdisps, rdtype, comm, monitoring_module->real.coll_neighbor_alltoallv_module));
 }
 
 int mca_coll_monitoring_ineighbor_alltoallv(const void *sbuf, const int *scounts,
@@ -128,5 +129,6 @@ int mca_coll_monitoring_ineighbor_alltoallv(const void *sbuf, const int *scounts
 
     mca_common_monitoring_coll_a2a(data_size_aggreg, monitoring_module->data);
 
-    return monitoring_module->real.coll_ineighbor_alltoallv(sbuf, scounts, sdisps, sdtype, rbuf, rcounts, rdisps, rdtype, comm, request, monitoring_module->real.coll_ineighbor_alltoallv_module);
+    MCA_COLL_MONITORING_ICALL(MCA_MONITORING_OP_COLL_INEIGHBOR_ALLTOALLV, comm, -1, request,
+                              monitoring_module->real.coll_ineighbor_alltoallv(sbuf, scounts, sdisps, sdtype, rbuf, rcounts, rdisps, rdtype, comm, request, monitoring_module->real.coll_ineighbor_alltoallv_module));
 }
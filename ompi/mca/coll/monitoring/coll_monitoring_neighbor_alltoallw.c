@@ -71,7 +71,8 @@ int mca_coll_monitoring_neighbor_alltoallw(const void *sbuf, const int *scounts,
 
     mca_common_monitoring_coll_a2a(data_size_aggreg, monitoring_module->data);
 
-    return monitoring_module->real.coll_neighbor_alltoallw(sbuf, scounts, sdisps, sdtypes, rbuf, rcounts, rdisps, rdtypes, comm, monitoring_module->real.coll_neighbor_alltoallw_module);
+    MCA_COLL_MONITORING_CALL(MCA_MONITORING_OP_COLL_NEIGHBOR_ALLTOALLW, comm, -1,
+                             monitoring_module->real.coll_neighbor_alltoallw(sbuf, scounts, sdisps, sdtypes, rbuf, rcounts, rdisps, rdtypes, comm, monitoring_module->real.coll_neighbor_alltoallw_module));
 }
 
 int mca_coll_monitoring_ineighbor_alltoallw(const void *sbuf, const int *scounts,
@@ -130,5 +131,6 @@ int mca_coll_monitoring_ineighbor_alltoallw(const void *sbuf, const int *scounts
 
     mca_common_monitoring_coll_a2a(data_size_aggreg, monitoring_module->data);
 
-    return monitoring_module->real.coll_ineighbor_alltoallw(sbuf, scounts, sdisps, sdtypes, rbuf, rcounts, rdisps, rdtypes, comm, request, monitoring_module->real.coll_ineighbor_alltoallw_module);
+    MCA_COLL_MONITORING_ICALL(MCA_MONITORING_OP_COLL_INEIGHBOR_ALLTOALLW, comm, -1, request,
+                              monitoring_module->real.coll_ineighbor_alltoallw(sbuf, scounts, sdisps, sdtypes, rbuf, rcounts, rdisps, rdtypes, comm, request, monitoring_module->real.coll_ineighbor_alltoallw_module));
 }
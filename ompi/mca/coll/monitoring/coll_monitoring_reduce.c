@@ -42,7 +42,8 @@ int mca_coll_monitoring_reduce(const void *sbuf, void *rbuf, int count,
         }
         mca_common_monitoring_coll_a2o(data_size * (comm_size - 1), monitoring_module->data);
     }
-    return monitoring_module->real.coll_reduce(sbuf, rbuf, count, dtype, op, root, comm, monitoring_module->real.coll_reduce_module);
+    MCA_COLL_MONITORING_CALL(MCA_MONITORING_OP_COLL_REDUCE, comm, root,
+                             monitoring_module->real.coll_reduce(sbuf, rbuf, count, dtype, op, root, comm, monitoring_module->real.coll_reduce_module));
 }
 
 int mca_coll_monitoring_ireduce(const void *sbuf, void *rbuf, int count,
@@ -72,5 +73,6 @@ int mca_coll_monitoring_ireduce(const void *sbuf, void *rbuf, int count,
         }
         mca_common_monitoring_coll_a2o(data_size * (comm_size - 1), monitoring_module->data);
     }
-    return monitoring_module->real.coll_ireduce(sbuf, rbuf, count, dtype, op, root, comm, request, monitoring_module->real.coll_ireduce_module);
+    MCA_COLL_MONITORING_ICALL(MCA_MONITORING_OP_COLL_IREDUCE, comm, root, request,
+                              monitoring_module->real.coll_ireduce(sbuf, rbuf, count, dtype, op, root, comm, request, monitoring_module->real.coll_ireduce_module));
 }
@@ -42,7 +42,8 @@ int mca_coll_monitoring_reduce_scatter(const void *sbuf, void *rbuf,
         data_size_aggreg += data_size;
     }
     mca_common_monitoring_coll_a2a(data_size_aggreg, monitoring_module->data);
-    return monitoring_module->real.coll_reduce_scatter(sbuf, rbuf, rcounts, dtype, op, comm, monitoring_module->real.coll_reduce_scatter_module);
+    MCA_COLL_MONITORING_CALL(MCA_MONITORING_OP_COLL_REDUCE_SCATTER, comm, -1,
+                             monitoring_module->real.coll_reduce_scatter(sbuf, rbuf, rcounts, dtype, op, comm, monitoring_module->real.coll_reduce_scatter_module));
 }
 
 int mca_coll_monitoring_ireduce_scatter(const void *sbuf, void *rbuf,
@@ -72,5 +73,6 @@ int mca_coll_monitoring_ireduce_scatter(const void *sbuf, void *rbuf,
         data_size_aggreg += data_size;
     }
     mca_common_monitoring_coll_a2a(data_size_aggreg, monitoring_module->data);
-    return monitoring_module->real.coll_ireduce_scatter(sbuf, rbuf, rcounts, dtype, op, comm, request, monitoring_module->real.coll_ireduce_scatter_module);
+    MCA_COLL_MONITORING_ICALL(MCA_MONITORING_OP_COLL_IREDUCE_SCATTER, comm, -1, request,
+                              monitoring_module->real.coll_ireduce_scatter(sbuf, rbuf, rcounts, dtype, op, comm, request, monitoring_module->real.coll_ireduce_scatter_module));
 }
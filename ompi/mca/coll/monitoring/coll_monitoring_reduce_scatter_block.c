@@ -41,7 +41,8 @@ int mca_coll_monitoring_reduce_scatter_block(const void *sbuf, void *rbuf,
         }
     }
     mca_common_monitoring_coll_a2a(data_size * (comm_size - 1), monitoring_module->data);
-    return monitoring_module->real.coll_reduce_scatter_block(sbuf, rbuf, rcount, dtype, op, comm, monitoring_module->real.coll_reduce_scatter_block_module);
+    MCA_COLL_MONITORING_CALL(MCA_MONITORING_OP_COLL_REDUCE_SCATTER_BLOCK, comm, -1,
+                             monitoring_module->real.coll_reduce_scatter_block(sbuf, rbuf, rcount, dtype, op, comm, monitoring_module->real.coll_reduce_scatter_block_module));
 }
 
 int mca_coll_monitoring_ireduce_scatter_block(const void *sbuf, void *rbuf,
@@ -70,5 +71,6 @@ int mca_coll_monitoring_ireduce_scatter_block(const void *sbuf, void *rbuf,
         }
     }
     mca_common_monitoring_coll_a2a(data_size * (comm_size - 1), monitoring_module->data);
-    return monitoring_module->real.coll_ireduce_scatter_block(sbuf, rbuf, rcount, dtype, op, comm, request, monitoring_module->real.coll_ireduce_scatter_block_module);
+    MCA_COLL_MONITORING_ICALL(MCA_MONITORING_OP_COLL_IREDUCE_SCATTER_BLOCK, comm, -1, request,
+                              monitoring_module->real.coll_ireduce_scatter_block(sbuf, rbuf, rcount, dtype, op, comm, request, monitoring_module->real.coll_ireduce_scatter_block_module));
 }
@@ -39,7 +39,8 @@ int mca_coll_monitoring_scan(const void *sbuf, void *rbuf, int count,
             mca_common_monitoring_record_coll(rank, data_size);
         }
     }
-    return monitoring_module->real.coll_scan(sbuf, rbuf, count, dtype, op, comm, monitoring_module->real.coll_scan_module);
+    MCA_COLL_MONITORING_CALL(MCA_MONITORING_OP_COLL_SCAN, comm, -1,
+                             monitoring_module->real.coll_scan(sbuf, rbuf, count, dtype, op, comm, monitoring_module->real.coll_scan_module));
 }
 
 int mca_coll_monitoring_iscan(const void *sbuf, void *rbuf, int count,
@@ -66,5 +67,6 @@ int mca_coll_monitoring_iscan(const void *sbuf, void *rbuf, int count,
             mca_common_monitoring_record_coll(rank, data_size);
         }
     }
-    return monitoring_module->real.coll_iscan(sbuf, rbuf, count, dtype, op, comm, request, monitoring_module->real.coll_iscan_module);
+    MCA_COLL_MONITORING_ICALL(MCA_MONITORING_OP_COLL_ISCAN, comm, -1, request,
+                              monitoring_module->real.coll_iscan(sbuf, rbuf, count, dtype, op, comm, request, monitoring_module->real.coll_iscan_module));
 }
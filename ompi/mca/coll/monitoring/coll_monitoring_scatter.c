@@ -43,7 +43,8 @@ int mca_coll_monitoring_scatter(const void *sbuf, int scount,
         }
         mca_common_monitoring_coll_o2a(data_size * (comm_size - 1), monitoring_module->data);
     }
-    return monitoring_module->real.coll_scatter(sbuf, scount, sdtype, rbuf, rcount, rdtype, root, comm, monitoring_module->real.coll_scatter_module);
+    MCA_COLL_MONITORING_CALL(MCA_MONITORING_OP_COLL_SCATTER, comm, root,
+                             monitoring_module->real.coll_scatter(sbuf, scount, sdtype, rbuf, rcount, rdtype, root, comm, monitoring_module->real.coll_scatter_module));
 }
 
 
@@ -76,5 +77,6 @@ int mca_coll_monitoring_iscatter(const void *sbuf, int scount,
         }
         mca_common_monitoring_coll_o2a(data_size * (comm_size - 1), monitoring_module->data);
     }
-    return monitoring_module->real.coll_iscatter(sbuf, scount, sdtype, rbuf, rcount, rdtype, root, comm, request, monitoring_module->real.coll_iscatter_module);
+    MCA_COLL_MONITORING_ICALL(MCA_MONITORING_OP_COLL_ISCATTER, comm, root, request,
+                              monitoring_module->real.coll_iscatter(sbuf, scount, sdtype, rbuf, rcount, rdtype, root, comm, request, monitoring_module->real.coll_iscatter_module));
 }
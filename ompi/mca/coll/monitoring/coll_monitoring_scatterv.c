@@ -41,7 +41,8 @@ int mca_coll_monitoring_scatterv(const void *sbuf, const int *scounts, const int
         }
         mca_common_monitoring_coll_o2a(data_size_aggreg, monitoring_module->data);
     }
-    return monitoring_module->real.coll_scatterv(sbuf, scounts, disps, sdtype, rbuf, rcount, rdtype, root, comm, monitoring_module->real.coll_scatterv_module);
+    MCA_COLL_MONITORING_CALL(MCA_MONITORING_OP_COLL_SCATTERV, comm, root,
+                             monitoring_module->real.coll_scatterv(sbuf, scounts, disps, sdtype, rbuf, rcount, rdtype, root, comm, monitoring_module->real.coll_scatterv_module));
 }
 
 int mca_coll_monitoring_iscatterv(const void *sbuf, const int *scounts, const int *disps,
@@ -71,5 +72,6 @@ int mca_coll_monitoring_iscatterv(const void *sbuf, const int *scounts, const in
         }
         mca_common_monitoring_coll_o2a(data_size_aggreg, monitoring_module->data);
     }
-    return monitoring_module->real.coll_iscatterv(sbuf, scounts, disps, sdtype, rbuf, rcount, rdtype, root, comm, request, monitoring_module->real.coll_iscatterv_module);
+    MCA_COLL_MONITORING_ICALL(MCA_MONITORING_OP_COLL_ISCATTERV, comm, root, request,
+                              monitoring_module->real.coll_iscatterv(sbuf, scounts, disps, sdtype, rbuf, rcount, rdtype, root, comm, request, monitoring_module->real.coll_iscatterv_module));
 }
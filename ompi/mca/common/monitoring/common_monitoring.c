@@ -21,6 +21,8 @@
 #include "ompi_config.h"
 #include "common_monitoring.h"
 #include "common_monitoring_coll.h"
+#include "common_monitoring_histogram.h"
+#include "common_monitoring_trace.h"
 #include "ompi/constants.h"
 #include "ompi/communicator/communicator.h"
 #include "opal/mca/base/mca_base_component_repository.h"
@@ -99,6 +101,10 @@ static int mca_common_monitoring_get_pml_count (const struct mca_base_pvar_t *pv
 static int mca_common_monitoring_get_pml_size (const struct mca_base_pvar_t *pvar,
                                                void *value, void *obj_handle);
 
+/* Retreive the PML recorded distribution of the messages size */
+static int mca_common_monitoring_get_pml_size_histogram (const struct mca_base_pvar_t *pvar,
+                                                         void *value, void *obj_handle);
+
 /* Retreive the OSC recorded count of messages sent */
 static int mca_common_monitoring_get_osc_sent_count (const struct mca_base_pvar_t *pvar,
                                                      void *value, void *obj_handle);
@@ -139,6 +145,11 @@ static int mca_common_monitoring_comm_size_notify(mca_base_pvar_t *pvar,
                                                   mca_base_pvar_event_t event,
                                                   void *obj_handle, int *count);
 
+/* pml_monitoring_messages_size_histogram pvar notify function */
+static int mca_common_monitoring_size_histogram_notify(mca_base_pvar_t *pvar,
+                                                       mca_base_pvar_event_t event,
+                                                       void *obj_handle, int *count);
+
 /* pml_monitoring_flush pvar notify function */
 static int mca_common_monitoring_notify_flush(struct mca_base_pvar_t *pvar,
                                               mca_base_pvar_event_t event,
@@ -210,6 +221,19 @@ static int mca_common_monitoring_comm_size_notify(mca_base_pvar_t *pvar,
     return OMPI_ERROR;
 }
 
+static int mca_common_monitoring_size_histogram_notify(mca_base_pvar_t *pvar,
+                                                       mca_base_pvar_event_t event,
+                                                       void *obj_handle,
+                                                       int *count)
+{
+    if( MCA_BASE_PVAR_HANDLE_BIND == event ) {
+        /* One histogram per process in the communicator */
+        *count = ompi_comm_size ((ompi_communicator_t *) obj_handle) * max_size_histogram;
+        return OMPI_SUCCESS;
+    }
+    return mca_common_monitoring_comm_size_notify(pvar, event, obj_handle, count);
+}
+
 int mca_common_monitoring_init( void )
 {
     if( !mca_common_monitoring_enabled ) return OMPI_ERROR;
@@ -249,6 +273,8 @@ void mca_common_monitoring_finalize( void )
     opal_hash_table_remove_all( common_monitoring_translation_ht );
     OBJ_RELEASE(common_monitoring_translation_ht);
     mca_common_monitoring_coll_finalize();
+    mca_common_monitoring_trace_finalize();
+    mca_common_monitoring_histogram_finalize();
     if( NULL != mca_common_monitoring_current_filename ) {
         free(mca_common_monitoring_current_filename);
         mca_common_monitoring_current_filename = NULL;
@@ -330,6 +356,22 @@ int mca_common_monitoring_register(void)
                                  mca_common_monitoring_get_pml_size, NULL,
                                  mca_common_monitoring_comm_size_notify, NULL);
 
+    (void)mca_base_pvar_register("ompi", "pml", "monitoring", "messages_size_histogram", "Log2 "
+                                 "histogram of the size of the messages sent to each peer through "
+                                 "the PML framework. The histogram of peer i starts at index i*66, "
+                                 "and its first element counts the empty messages.",
+                                 OPAL_INFO_LVL_4, MPI_T_PVAR_CLASS_SIZE,
+                                 MCA_MONITORING_VAR_TYPE, NULL, MPI_T_BIND_MPI_COMM,
+                                 MCA_BASE_PVAR_FLAG_READONLY | MCA_BASE_PVAR_FLAG_IWG,
+                                 mca_common_monitoring_get_pml_size_histogram, NULL,
+                                 mca_common_monitoring_size_histogram_notify, NULL);
+
+    /* Time in flight histograms */
+    mca_common_monitoring_histogram_register();
+
+    /* Timeline of the operations */
+    mca_common_monitoring_trace_register();
+
     /* OSC PVARs */
     (void)mca_base_pvar_register("ompi", "osc", "monitoring", "messages_sent_count", "Number of "
                                  "messages sent through the OSC framework with each peer.",
@@ -462,6 +504,9 @@ int mca_common_monitoring_add_procs(struct ompi_proc_t **procs,
         coll_count         = coll_data + nprocs_world;
 
         size_histogram     = coll_count + nprocs_world;
+
+        (void)mca_common_monitoring_histogram_init(nprocs_world);
+        (void)mca_common_monitoring_trace_init(rank_world);
     }
 
     /* For all procs in the same MPI_COMM_WORLD we need to add them to the hash table */
@@ -499,6 +544,7 @@ static void mca_common_monitoring_reset( void )
     int array_size = (10 + max_size_histogram) * nprocs_world;
     memset((void *) pml_data, 0, array_size * sizeof(size_t));
     mca_common_monitoring_coll_reset();
+    mca_common_monitoring_histogram_reset();
 }
 
 void mca_common_monitoring_record_pml(int world_rank, size_t data_size, int tag)
@@ -562,6 +608,25 @@ static int mca_common_monitoring_get_pml_size(const struct mca_base_pvar_t *pvar
     return OMPI_SUCCESS;
 }
 
+static int mca_common_monitoring_get_pml_size_histogram(const struct mca_base_pvar_t *pvar,
+                                                        void *value,
+                                                        void *obj_handle)
+{
+    ompi_communicator_t *comm = (ompi_communicator_t *) obj_handle;
+    int comm_size = ompi_comm_size (comm);
+    size_t *values = (size_t*) value;
+    int i;
+
+    if(comm != &ompi_mpi_comm_world.comm || NULL == size_histogram)
+        return OMPI_ERROR;
+
+    for (i = 0 ; i < comm_size * max_size_histogram ; ++i) {
+        values[i] = size_histogram[i];
+    }
+
+    return OMPI_SUCCESS;
+}
+
 void mca_common_monitoring_record_osc(int world_rank, size_t data_size,
                                       enum mca_monitoring_osc_direction dir)
 {
@@ -753,6 +818,9 @@ static void mca_common_monitoring_output( FILE *pf, int my_rank, int nbprocs )
         }
     }
     mca_common_monitoring_coll_flush_all(pf);
+
+    /* Dump time in flight histograms */
+    mca_common_monitoring_histogram_flush(pf, my_rank);
 }
 
 /*
@@ -0,0 +1,400 @@
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+#include "common_monitoring.h"
+#include "common_monitoring_histogram.h"
+#include "ompi/constants.h"
+#include "ompi/communicator/communicator.h"
+#include "opal/class/opal_list.h"
+#include "opal/mca/threads/mutex.h"
+#include "opal/util/bit_ops.h"
+#include "opal/runtime/opal.h"
+
+#if SIZEOF_LONG_LONG == SIZEOF_SIZE_T
+#define MCA_MONITORING_VAR_TYPE MCA_BASE_VAR_TYPE_UNSIGNED_LONG_LONG
+#elif SIZEOF_LONG == SIZEOF_SIZE_T
+#define MCA_MONITORING_VAR_TYPE MCA_BASE_VAR_TYPE_UNSIGNED_LONG
+#endif
+
+/* The per-communicator histograms are indexed by the local CID, in chunks
+ * allocated the first time a thread sends on one of their communicators.
+ * Communicators with a CID above the directory range are not tracked. */
+#define MCA_MONITORING_HISTOGRAM_ROW (MCA_MONITORING_SIZE_BUCKETS + MCA_MONITORING_TIME_BUCKETS)
+#define MCA_MONITORING_HISTOGRAM_CHUNK 64
+#define MCA_MONITORING_HISTOGRAM_CHUNKS 1024
+
+int mca_common_monitoring_histograms_enabled = 0;
+
+/* Counters owned by a single thread */
+typedef struct mca_monitoring_histogram_local_t {
+    opal_list_item_t super;
+    size_t *peer_time;  /* nprocs_world rows of MCA_MONITORING_TIME_BUCKETS */
+    size_t *comm_hist[MCA_MONITORING_HISTOGRAM_CHUNKS];
+} mca_monitoring_histogram_local_t;
+
+static void mca_monitoring_histogram_local_construct(mca_monitoring_histogram_local_t *local)
+{
+    local->peer_time = NULL;
+    memset(local->comm_hist, 0, sizeof(local->comm_hist));
+}
+
+static void mca_monitoring_histogram_local_destruct(mca_monitoring_histogram_local_t *local)
+{
+    free(local->peer_time);
+    for( int i = 0; i < MCA_MONITORING_HISTOGRAM_CHUNKS; ++i ) {
+        free(local->comm_hist[i]);
+    }
+}
+
+static OBJ_CLASS_INSTANCE(mca_monitoring_histogram_local_t, opal_list_item_t,
+                          mca_monitoring_histogram_local_construct,
+                          mca_monitoring_histogram_local_destruct);
+
+static opal_thread_local mca_monitoring_histogram_local_t *histogram_local = NULL;
+/* Changes every time the histograms are initialized, so threads do not
+ * keep using counters released by a previous finalize */
+static opal_thread_local uint32_t histogram_local_generation = 0;
+static uint32_t histogram_generation = 0;
+
+static opal_list_t histogram_locals;
+static opal_mutex_t histogram_lock;
+static bool histogram_initialized = false;
+static int histogram_nprocs = 0;
+static double histogram_ns_per_tick = 0.;
+
+static int mca_common_monitoring_get_time_histogram(const struct mca_base_pvar_t *pvar,
+                                                    void *value, void *obj_handle);
+static int mca_common_monitoring_get_comm_size_histogram(const struct mca_base_pvar_t *pvar,
+                                                         void *value, void *obj_handle);
+static int mca_common_monitoring_get_comm_time_histogram(const struct mca_base_pvar_t *pvar,
+                                                         void *value, void *obj_handle);
+static int mca_common_monitoring_histogram_notify(mca_base_pvar_t *pvar, mca_base_pvar_event_t event,
+                                                  void *obj_handle, int *count);
+
+void mca_common_monitoring_histogram_register(void)
+{
+    (void)mca_base_var_register("ompi", "pml", "monitoring", "histograms",
+                                "Enable the per-peer and per-communicator histograms of the "
+                                "time in flight and the size of the messages sent through "
+                                "the PML (default disabled). Only meaningful when the "
+                                "monitoring is enabled.",
+                                MCA_BASE_VAR_TYPE_INT, NULL, MPI_T_BIND_NO_OBJECT,
+                                MCA_BASE_VAR_FLAG_DWG, OPAL_INFO_LVL_4,
+                                MCA_BASE_VAR_SCOPE_READONLY,
+                                &mca_common_monitoring_histograms_enabled);
+
+    (void)mca_base_pvar_register("ompi", "pml", "monitoring", "messages_time_histogram",
+                                 "Log2 histogram (in nanoseconds) of the time in flight of the "
+                                 "messages sent to each peer through the PML framework. The "
+                                 "histogram of peer i starts at index i*48.",
+                                 OPAL_INFO_LVL_4, MPI_T_PVAR_CLASS_SIZE,
+                                 MCA_MONITORING_VAR_TYPE, NULL, MPI_T_BIND_MPI_COMM,
+                                 MCA_BASE_PVAR_FLAG_READONLY | MCA_BASE_PVAR_FLAG_IWG,
+                                 mca_common_monitoring_get_time_histogram, NULL,
+                                 mca_common_monitoring_histogram_notify, NULL);
+
+    (void)mca_base_pvar_register("ompi", "pml", "monitoring", "comm_size_histogram",
+                                 "Log2 histogram of the size of the messages sent through the "
+                                 "PML framework in a communicator. Index 0 counts the empty "
+                                 "messages.",
+                                 OPAL_INFO_LVL_4, MPI_T_PVAR_CLASS_SIZE,
+                                 MCA_MONITORING_VAR_TYPE, NULL, MPI_T_BIND_MPI_COMM,
+                                 MCA_BASE_PVAR_FLAG_READONLY | MCA_BASE_PVAR_FLAG_IWG,
+                                 mca_common_monitoring_get_comm_size_histogram, NULL,
+                                 mca_common_monitoring_histogram_notify, NULL);
+
+    (void)mca_base_pvar_register("ompi", "pml", "monitoring", "comm_time_histogram",
+                                 "Log2 histogram (in nanoseconds) of the time in flight of the "
+                                 "messages sent through the PML framework in a communicator.",
+                                 OPAL_INFO_LVL_4, MPI_T_PVAR_CLASS_SIZE,
+                                 MCA_MONITORING_VAR_TYPE, NULL, MPI_T_BIND_MPI_COMM,
+                                 MCA_BASE_PVAR_FLAG_READONLY | MCA_BASE_PVAR_FLAG_IWG,
+                                 mca_common_monitoring_get_comm_time_histogram, NULL,
+                                 mca_common_monitoring_histogram_notify, NULL);
+}
+
+int mca_common_monitoring_histogram_init(int nprocs)
+{
+    if( !mca_common_monitoring_histograms_enabled || histogram_initialized ) return OMPI_SUCCESS;
+
+#if OPAL_TIMER_CYCLE_NATIVE
+    histogram_ns_per_tick = 1e9 / (double) opal_timer_base_get_freq();
+#else
+    histogram_ns_per_tick = 1e3;
+#endif
+    histogram_nprocs = nprocs;
+    OBJ_CONSTRUCT(&histogram_locals, opal_list_t);
+    OBJ_CONSTRUCT(&histogram_lock, opal_mutex_t);
+    histogram_generation++;
+    histogram_initialized = true;
+    return OMPI_SUCCESS;
+}
+
+void mca_common_monitoring_histogram_finalize(void)
+{
+    if( !histogram_initialized ) return;
+
+    mca_common_monitoring_histograms_enabled = 0;
+    histogram_initialized = false;
+    OPAL_LIST_DESTRUCT(&histogram_locals);
+    OBJ_DESTRUCT(&histogram_lock);
+}
+
+/* Index of the highest bit set, -1 for 0 */
+static inline int mca_common_monitoring_log2(uint64_t value)
+{
+    if( value >> 31 ) {
+        return 31 + opal_hibit((int)((value >> 31) & 0x7fffffff), 31);
+    }
+    return opal_hibit((int) value, 31);
+}
+
+/* Counters of the calling thread, allocated on its first record */
+static mca_monitoring_histogram_local_t *mca_common_monitoring_histogram_get_local(void)
+{
+    mca_monitoring_histogram_local_t *local = histogram_local;
+
+    if( OPAL_LIKELY(NULL != local && histogram_local_generation == histogram_generation) ) {
+        return local;
+    }
+    if( !histogram_initialized ) return NULL;
+
+    local = OBJ_NEW(mca_monitoring_histogram_local_t);
+    if( NULL == local ) return NULL;
+    local->peer_time = (size_t *) calloc((size_t) histogram_nprocs * MCA_MONITORING_TIME_BUCKETS,
+                                         sizeof(size_t));
+    if( NULL == local->peer_time ) {
+        OBJ_RELEASE(local);
+        return NULL;
+    }
+    OPAL_THREAD_LOCK(&histogram_lock);
+    opal_list_append(&histogram_locals, &local->super);
+    OPAL_THREAD_UNLOCK(&histogram_lock);
+
+    histogram_local = local;
+    histogram_local_generation = histogram_generation;
+    return local;
+}
+
+void mca_common_monitoring_histogram_record(int world_rank, uint32_t cid,
+                                            size_t data_size, opal_timer_t elapsed)
+{
+    mca_monitoring_histogram_local_t *local;
+    size_t *chunk;
+    int size_bucket, time_bucket;
+
+    if( 0 == mca_common_monitoring_current_state ) return;  /* right now the monitoring is not started */
+    if( NULL == (local = mca_common_monitoring_histogram_get_local()) ) return;
+
+    time_bucket = mca_common_monitoring_log2((uint64_t) ((double) elapsed * histogram_ns_per_tick));
+    if( time_bucket < 0 ) time_bucket = 0;
+    if( time_bucket > MCA_MONITORING_TIME_BUCKETS - 1 ) time_bucket = MCA_MONITORING_TIME_BUCKETS - 1;
+    size_bucket = mca_common_monitoring_log2(data_size) + 1;
+    if( size_bucket > MCA_MONITORING_SIZE_BUCKETS - 1 ) size_bucket = MCA_MONITORING_SIZE_BUCKETS - 1;
+
+    if( 0 <= world_rank && world_rank < histogram_nprocs ) {
+        local->peer_time[world_rank * MCA_MONITORING_TIME_BUCKETS + time_bucket]++;
+    }
+
+    if( cid >= MCA_MONITORING_HISTOGRAM_CHUNK * MCA_MONITORING_HISTOGRAM_CHUNKS ) return;
+    chunk = local->comm_hist[cid / MCA_MONITORING_HISTOGRAM_CHUNK];
+    if( OPAL_UNLIKELY(NULL == chunk) ) {
+        chunk = (size_t *) calloc(MCA_MONITORING_HISTOGRAM_CHUNK * MCA_MONITORING_HISTOGRAM_ROW,
+                                  sizeof(size_t));
+        if( NULL == chunk ) return;
+        /* readers from other threads must see the chunk zeroed */
+        opal_atomic_wmb();
+        local->comm_hist[cid / MCA_MONITORING_HISTOGRAM_CHUNK] = chunk;
+    }
+    chunk += (cid % MCA_MONITORING_HISTOGRAM_CHUNK) * MCA_MONITORING_HISTOGRAM_ROW;
+    chunk[size_bucket]++;
+    chunk[MCA_MONITORING_SIZE_BUCKETS + time_bucket]++;
+}
+
+void mca_common_monitoring_histogram_reset(void)
+{
+    mca_monitoring_histogram_local_t *local;
+
+    if( !histogram_initialized ) return;
+
+    OPAL_THREAD_LOCK(&histogram_lock);
+    OPAL_LIST_FOREACH(local, &histogram_locals, mca_monitoring_histogram_local_t) {
+        memset(local->peer_time, 0,
+               (size_t) histogram_nprocs * MCA_MONITORING_TIME_BUCKETS * sizeof(size_t));
+        for( int i = 0; i < MCA_MONITORING_HISTOGRAM_CHUNKS; ++i ) {
+            if( NULL != local->comm_hist[i] ) {
+                memset(local->comm_hist[i], 0, MCA_MONITORING_HISTOGRAM_CHUNK *
+                       MCA_MONITORING_HISTOGRAM_ROW * sizeof(size_t));
+            }
+        }
+    }
+    OPAL_THREAD_UNLOCK(&histogram_lock);
+}
+
+/* Sum the time histogram of a peer over all threads */
+static void mca_common_monitoring_histogram_sum_peer(int world_rank, size_t *values)
+{
+    mca_monitoring_histogram_local_t *local;
+
+    memset(values, 0, MCA_MONITORING_TIME_BUCKETS * sizeof(size_t));
+    OPAL_LIST_FOREACH(local, &histogram_locals, mca_monitoring_histogram_local_t) {
+        size_t *row = local->peer_time + world_rank * MCA_MONITORING_TIME_BUCKETS;
+        for( int j = 0; j < MCA_MONITORING_TIME_BUCKETS; ++j ) {
+            values[j] += row[j];
+        }
+    }
+}
+
+/* Sum the size and time histograms of a communicator over all threads.
+ * Returns the number of messages. */
+static size_t mca_common_monitoring_histogram_sum_comm(uint32_t cid, size_t *values)
+{
+    mca_monitoring_histogram_local_t *local;
+    size_t count = 0;
+
+    memset(values, 0, MCA_MONITORING_HISTOGRAM_ROW * sizeof(size_t));
+    if( cid >= MCA_MONITORING_HISTOGRAM_CHUNK * MCA_MONITORING_HISTOGRAM_CHUNKS ) return 0;
+    OPAL_LIST_FOREACH(local, &histogram_locals, mca_monitoring_histogram_local_t) {
+        size_t *row = local->comm_hist[cid / MCA_MONITORING_HISTOGRAM_CHUNK];
+        if( NULL == row ) continue;
+        row += (cid % MCA_MONITORING_HISTOGRAM_CHUNK) * MCA_MONITORING_HISTOGRAM_ROW;
+        for( int j = 0; j < MCA_MONITORING_HISTOGRAM_ROW; ++j ) {
+            values[j] += row[j];
+        }
+    }
+    for( int j = 0; j < MCA_MONITORING_SIZE_BUCKETS; ++j ) {
+        count += values[j];
+    }
+    return count;
+}
+
+static int mca_common_monitoring_histogram_notify(mca_base_pvar_t *pvar, mca_base_pvar_event_t event,
+                                                  void *obj_handle, int *count)
+{
+    switch (event) {
+    case MCA_BASE_PVAR_HANDLE_BIND:
+        if( mca_common_monitoring_get_time_histogram == pvar->get_value ) {
+            *count = ompi_comm_size ((ompi_communicator_t *) obj_handle) * MCA_MONITORING_TIME_BUCKETS;
+        } else if( mca_common_monitoring_get_comm_size_histogram == pvar->get_value ) {
+            *count = MCA_MONITORING_SIZE_BUCKETS;
+        } else {
+            *count = MCA_MONITORING_TIME_BUCKETS;
+        }
+    case MCA_BASE_PVAR_HANDLE_UNBIND:
+        return OMPI_SUCCESS;
+    case MCA_BASE_PVAR_HANDLE_START:
+        mca_common_monitoring_current_state = mca_common_monitoring_enabled;
+        return OMPI_SUCCESS;
+    case MCA_BASE_PVAR_HANDLE_STOP:
+        mca_common_monitoring_current_state = 0;
+        return OMPI_SUCCESS;
+    }
+
+    return OMPI_ERROR;
+}
+
+static int mca_common_monitoring_get_time_histogram(const struct mca_base_pvar_t *pvar,
+                                                    void *value, void *obj_handle)
+{
+    ompi_communicator_t *comm = (ompi_communicator_t *) obj_handle;
+    int i, comm_size = ompi_comm_size (comm);
+    size_t *values = (size_t*) value;
+
+    if(comm != &ompi_mpi_comm_world.comm || !histogram_initialized)
+        return OMPI_ERROR;
+
+    OPAL_THREAD_LOCK(&histogram_lock);
+    for (i = 0 ; i < comm_size ; ++i) {
+        mca_common_monitoring_histogram_sum_peer(i, values + i * MCA_MONITORING_TIME_BUCKETS);
+    }
+    OPAL_THREAD_UNLOCK(&histogram_lock);
+
+    return OMPI_SUCCESS;
+}
+
+static int mca_common_monitoring_get_comm_size_histogram(const struct mca_base_pvar_t *pvar,
+                                                         void *value, void *obj_handle)
+{
+    size_t row[MCA_MONITORING_HISTOGRAM_ROW];
+
+    if( !histogram_initialized ) return OMPI_ERROR;
+
+    OPAL_THREAD_LOCK(&histogram_lock);
+    (void) mca_common_monitoring_histogram_sum_comm(ompi_comm_get_cid((ompi_communicator_t *) obj_handle), row);
+    OPAL_THREAD_UNLOCK(&histogram_lock);
+    memcpy(value, row, MCA_MONITORING_SIZE_BUCKETS * sizeof(size_t));
+
+    return OMPI_SUCCESS;
+}
+
+static int mca_common_monitoring_get_comm_time_histogram(const struct mca_base_pvar_t *pvar,
+                                                         void *value, void *obj_handle)
+{
+    size_t row[MCA_MONITORING_HISTOGRAM_ROW];
+
+    if( !histogram_initialized ) return OMPI_ERROR;
+
+    OPAL_THREAD_LOCK(&histogram_lock);
+    (void) mca_common_monitoring_histogram_sum_comm(ompi_comm_get_cid((ompi_communicator_t *) obj_handle), row);
+    OPAL_THREAD_UNLOCK(&histogram_lock);
+    memcpy(value, row + MCA_MONITORING_SIZE_BUCKETS, MCA_MONITORING_TIME_BUCKETS * sizeof(size_t));
+
+    return OMPI_SUCCESS;
+}
+
+static void mca_common_monitoring_histogram_print(FILE *pf, const size_t *values, int count)
+{
+    for( int j = 0 ; j < count ; ++j )
+        fprintf(pf, "%zu%s", values[j], j < count - 1 ? "," : "");
+}
+
+void mca_common_monitoring_histogram_flush(FILE *pf, int my_rank)
+{
+    size_t values[MCA_MONITORING_HISTOGRAM_ROW];
+    size_t count;
+
+    if( !histogram_initialized ) return;
+
+    fprintf(pf, "# HISTOGRAMS\n");
+    OPAL_THREAD_LOCK(&histogram_lock);
+    /* Time in flight of the messages sent to each peer */
+    for( int i = 0 ; i < histogram_nprocs ; i++ ) {
+        mca_common_monitoring_histogram_sum_peer(i, values);
+        count = 0;
+        for( int j = 0 ; j < MCA_MONITORING_TIME_BUCKETS ; ++j )
+            count += values[j];
+        if( 0 == count ) continue;
+        fprintf(pf, "T\t%" PRId32 "\t%" PRId32 "\t%zu msgs sent\t", my_rank, i, count);
+        mca_common_monitoring_histogram_print(pf, values, MCA_MONITORING_TIME_BUCKETS);
+        fprintf(pf, "\n");
+    }
+    /* Size and time in flight of the messages sent on each communicator */
+    for( int c = 0 ; c < MCA_MONITORING_HISTOGRAM_CHUNKS ; c++ ) {
+        mca_monitoring_histogram_local_t *local;
+        bool used = false;
+        OPAL_LIST_FOREACH(local, &histogram_locals, mca_monitoring_histogram_local_t) {
+            used |= (NULL != local->comm_hist[c]);
+        }
+        if( !used ) continue;
+        for( uint32_t cid = c * MCA_MONITORING_HISTOGRAM_CHUNK ;
+             cid < (uint32_t) (c + 1) * MCA_MONITORING_HISTOGRAM_CHUNK ; cid++ ) {
+            if( 0 == (count = mca_common_monitoring_histogram_sum_comm(cid, values)) ) continue;
+            fprintf(pf, "H\t%" PRIu32 "\t%zu msgs sent\tsize: ", cid, count);
+            mca_common_monitoring_histogram_print(pf, values, MCA_MONITORING_SIZE_BUCKETS);
+            fprintf(pf, "\ttime: ");
+            mca_common_monitoring_histogram_print(pf, values + MCA_MONITORING_SIZE_BUCKETS,
+                                                  MCA_MONITORING_TIME_BUCKETS);
+            fprintf(pf, "\n");
+        }
+    }
+    OPAL_THREAD_UNLOCK(&histogram_lock);
+}
@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#ifndef MCA_COMMON_MONITORING_HISTOGRAM_H
+#define MCA_COMMON_MONITORING_HISTOGRAM_H
+
+BEGIN_C_DECLS
+
+#include "ompi_config.h"
+#include "ompi/communicator/communicator.h"
+#include "opal/mca/base/mca_base_pvar.h"
+#include "opal/mca/timer/timer.h"
+#include MCA_timer_IMPLEMENTATION_HEADER
+
+/*
+ * Optional log2-bucketed histograms of the messages sent through the PML.
+ * For each peer in MPI_COMM_WORLD we keep the distribution of the time
+ * in flight of the sends (from the call until the local completion of
+ * the request), and for each communicator the distribution of both the
+ * sizes and the times in flight. The size distribution per peer is the
+ * size_histogram always maintained by the monitoring.
+ *
+ * Each thread records in its own set of counters, without any atomic
+ * operation, and the counters of all threads are only summed up when
+ * the histograms are read through MPI_T or flushed.
+ */
+
+/* Bucket 0 counts the empty messages, bucket i+1 the messages of [2^i, 2^(i+1)) bytes */
+#define MCA_MONITORING_SIZE_BUCKETS 66
+/* Bucket i counts the messages that stayed in flight [2^i, 2^(i+1)) nanoseconds */
+#define MCA_MONITORING_TIME_BUCKETS 48
+
+extern int mca_common_monitoring_histograms_enabled;
+
+OMPI_DECLSPEC void mca_common_monitoring_histogram_register(void);
+OMPI_DECLSPEC int  mca_common_monitoring_histogram_init(int nprocs);
+OMPI_DECLSPEC void mca_common_monitoring_histogram_finalize(void);
+OMPI_DECLSPEC void mca_common_monitoring_histogram_reset(void);
+OMPI_DECLSPEC void mca_common_monitoring_histogram_flush(FILE *pf, int my_rank);
+
+/* Records a message of data_size bytes sent to world_rank (or -1 if the
+ * peer is not part of MPI_COMM_WORLD) on the communicator cid, that
+ * stayed in flight elapsed timer ticks. */
+OMPI_DECLSPEC void mca_common_monitoring_histogram_record(int world_rank, uint32_t cid,
+                                                          size_t data_size, opal_timer_t elapsed);
+
+END_C_DECLS
+
+#endif  /* MCA_COMMON_MONITORING_HISTOGRAM_H */
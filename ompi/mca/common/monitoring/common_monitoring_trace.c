@@ -0,0 +1,575 @@
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+#include "common_monitoring.h"
+#include "common_monitoring_trace.h"
+#include "ompi/constants.h"
+#include "opal/class/opal_free_list.h"
+#include "opal/class/opal_hash_table.h"
+#include "opal/class/opal_list.h"
+#include "opal/mca/threads/mutex.h"
+#include "opal/mca/threads/threads.h"
+#include "opal/util/bit_ops.h"
+#include "opal/util/printf.h"
+#include "opal/runtime/opal.h"
+#include "opal/runtime/opal_progress.h"
+
+#include <assert.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <sys/time.h>
+
+/* Upper bound on the number of nonblocking operations timed at once */
+#define MCA_MONITORING_TRACE_MAX_TRACKED 65536
+/* Period of the helper thread draining the rings, in nanoseconds */
+#define MCA_MONITORING_TRACE_FLUSH_PERIOD 10000000
+
+int mca_common_monitoring_trace_enabled = 0;
+
+static char *mca_common_monitoring_trace_initial_filename = "";
+static char *mca_common_monitoring_trace_filename = NULL;
+static int mca_common_monitoring_trace_buffer_size = 65536;
+
+static const char *mca_common_monitoring_op_names[MCA_MONITORING_OP_MAX] = {
+    "pml.send", "pml.isend", "pml.start", "pml.recv", "pml.irecv",
+    "coll.allgather", "coll.iallgather", "coll.allgatherv", "coll.iallgatherv",
+    "coll.allreduce", "coll.iallreduce", "coll.alltoall", "coll.ialltoall",
+    "coll.alltoallv", "coll.ialltoallv", "coll.alltoallw", "coll.ialltoallw",
+    "coll.barrier", "coll.ibarrier", "coll.bcast", "coll.ibcast",
+    "coll.exscan", "coll.iexscan", "coll.gather", "coll.igather",
+    "coll.gatherv", "coll.igatherv", "coll.reduce", "coll.ireduce",
+    "coll.reduce_scatter", "coll.ireduce_scatter",
+    "coll.reduce_scatter_block", "coll.ireduce_scatter_block",
+    "coll.scan", "coll.iscan", "coll.scatter", "coll.iscatter",
+    "coll.scatterv", "coll.iscatterv",
+    "coll.neighbor_allgather", "coll.ineighbor_allgather",
+    "coll.neighbor_allgatherv", "coll.ineighbor_allgatherv",
+    "coll.neighbor_alltoall", "coll.ineighbor_alltoall",
+    "coll.neighbor_alltoallv", "coll.ineighbor_alltoallv",
+    "coll.neighbor_alltoallw", "coll.ineighbor_alltoallw",
+    "osc.put", "osc.rput", "osc.get", "osc.rget",
+    "osc.accumulate", "osc.raccumulate", "osc.get_accumulate", "osc.rget_accumulate",
+    "osc.fetch_and_op", "osc.compare_and_swap",
+    "osc.fence", "osc.post", "osc.start", "osc.complete", "osc.wait",
+    "osc.lock", "osc.unlock", "osc.lock_all", "osc.unlock_all",
+    "osc.flush", "osc.flush_all", "osc.flush_local", "osc.flush_local_all", "osc.sync",
+    "dropped"
+};
+
+/* Single producer, single consumer ring of events. The owner thread is
+ * the only one to move head and the helper thread the only one to move
+ * tail, so neither needs an atomic operation. */
+typedef struct mca_monitoring_trace_ring_t {
+    opal_list_item_t super;
+    mca_monitoring_trace_event_t *events;
+    opal_atomic_size_t head;
+    opal_atomic_size_t tail;
+    size_t dropped;
+    uint16_t thread;
+} mca_monitoring_trace_ring_t;
+
+static void mca_monitoring_trace_ring_construct(mca_monitoring_trace_ring_t *ring)
+{
+    ring->events = NULL;
+    ring->head = ring->tail = 0;
+    ring->dropped = 0;
+    ring->thread = 0;
+}
+
+static void mca_monitoring_trace_ring_destruct(mca_monitoring_trace_ring_t *ring)
+{
+    free(ring->events);
+}
+
+static OBJ_CLASS_INSTANCE(mca_monitoring_trace_ring_t, opal_list_item_t,
+                          mca_monitoring_trace_ring_construct,
+                          mca_monitoring_trace_ring_destruct);
+
+/* A request timed by the monitoring. The request keeps it until it is
+ * freed, persistent requests through all their starts. */
+typedef struct mca_monitoring_trace_req_t {
+    opal_free_list_item_t super;
+    ompi_request_t *request;
+    ompi_request_free_fn_t req_free;  /**< free function of the request owner */
+    bool pending;                     /**< in trace_pending, waiting for completion */
+    opal_timer_t start;
+    size_t data_size;
+    uint32_t cid;
+    int world_rank;
+    int tag;
+    mca_monitoring_op_t op;
+} mca_monitoring_trace_req_t;
+
+static OBJ_CLASS_INSTANCE(mca_monitoring_trace_req_t, opal_free_list_item_t, NULL, NULL);
+
+static opal_thread_local mca_monitoring_trace_ring_t *trace_ring = NULL;
+/* Changes every time the trace is initialized, so threads do not keep
+ * using rings released by a previous finalize */
+static opal_thread_local uint32_t trace_ring_generation = 0;
+static uint32_t trace_generation = 0;
+
+static opal_list_t trace_rings;
+static opal_mutex_t trace_lock;
+static opal_free_list_t trace_reqs;
+static bool trace_reqs_initialized = false;
+/* Timed requests, by address, and the ones not seen completed yet. Both
+ * are protected by trace_reqs_lock. */
+static opal_hash_table_t trace_tracked;
+static opal_list_t trace_pending;
+static opal_mutex_t trace_reqs_lock;
+static opal_atomic_int32_t trace_num_pending = 0;
+static bool trace_reqs_exhausted = false;
+static bool trace_initialized = false;
+static int mca_common_monitoring_time_progress(void);
+static size_t trace_mask = 0;
+static uint16_t trace_nthreads = 0;
+static FILE *trace_file = NULL;
+static opal_thread_t trace_flusher;
+static volatile bool trace_flusher_running = false;
+
+void mca_common_monitoring_trace_register(void)
+{
+    (void)mca_base_var_register("ompi", "pml", "monitoring", "trace_filename",
+                                "Record a timeline of the PML, collective and one-sided "
+                                "operations in this file (the filename will be extended "
+                                "with the process rank and the \".trace\" extension). If "
+                                "this field is empty the trace is disabled (default). Only "
+                                "meaningful when the monitoring is enabled.",
+                                MCA_BASE_VAR_TYPE_STRING, NULL, MPI_T_BIND_NO_OBJECT,
+                                MCA_BASE_VAR_FLAG_DWG, OPAL_INFO_LVL_4,
+                                MCA_BASE_VAR_SCOPE_READONLY,
+                                &mca_common_monitoring_trace_initial_filename);
+
+    (void)mca_base_var_register("ompi", "pml", "monitoring", "trace_buffer_size",
+                                "Number of events buffered by each thread before they are "
+                                "written to the trace file (rounded up to a power of 2, "
+                                "default 65536). Events are dropped when the buffer is full.",
+                                MCA_BASE_VAR_TYPE_INT, NULL, MPI_T_BIND_NO_OBJECT,
+                                MCA_BASE_VAR_FLAG_DWG, OPAL_INFO_LVL_9,
+                                MCA_BASE_VAR_SCOPE_READONLY,
+                                &mca_common_monitoring_trace_buffer_size);
+
+    /* Same as the monitoring filename, keep a copy that outlives the variable */
+    free(mca_common_monitoring_trace_filename);
+    mca_common_monitoring_trace_filename = NULL;
+    if( NULL != mca_common_monitoring_trace_initial_filename &&
+        '\0' != mca_common_monitoring_trace_initial_filename[0] ) {
+        mca_common_monitoring_trace_filename = strdup(mca_common_monitoring_trace_initial_filename);
+    }
+    mca_common_monitoring_trace_enabled = (NULL != mca_common_monitoring_trace_filename);
+}
+
+/* Writes all the events buffered so far. Called with the trace lock held. */
+static void mca_common_monitoring_trace_drain(void)
+{
+    mca_monitoring_trace_ring_t *ring;
+    size_t head, tail, first, n;
+
+    OPAL_LIST_FOREACH(ring, &trace_rings, mca_monitoring_trace_ring_t) {
+        head = ring->head;
+        opal_atomic_rmb();
+        for( tail = ring->tail; tail != head; tail += n ) {
+            first = tail & trace_mask;
+            n = head - tail;
+            if( first + n > trace_mask + 1 ) n = trace_mask + 1 - first;
+            (void) fwrite(&ring->events[first], sizeof(mca_monitoring_trace_event_t), n, trace_file);
+        }
+        /* The slots are only given back once they have been copied */
+        opal_atomic_mb();
+        ring->tail = tail;
+    }
+}
+
+static void *mca_common_monitoring_trace_flusher_engine(opal_object_t *obj)
+{
+    struct timespec period = { .tv_sec = 0, .tv_nsec = MCA_MONITORING_TRACE_FLUSH_PERIOD };
+
+    while( trace_flusher_running ) {
+        OPAL_THREAD_LOCK(&trace_lock);
+        mca_common_monitoring_trace_drain();
+        OPAL_THREAD_UNLOCK(&trace_lock);
+        nanosleep(&period, NULL);
+    }
+    return NULL;
+}
+
+static int mca_common_monitoring_trace_open(int my_rank)
+{
+    mca_monitoring_trace_header_t header;
+    struct timeval now;
+    char *filename;
+    int i;
+
+    opal_asprintf(&filename, "%s.%d.trace", mca_common_monitoring_trace_filename, my_rank);
+    trace_file = fopen(filename, "w");
+    if( NULL == trace_file ) {
+        OPAL_MONITORING_PRINT_ERR("Cannot open the trace file %s, trace disabled.", filename);
+        free(filename);
+        return OMPI_ERROR;
+    }
+    free(filename);
+
+    memset(&header, 0, sizeof(header));
+    memcpy(header.magic, MCA_MONITORING_TRACE_MAGIC, sizeof(MCA_MONITORING_TRACE_MAGIC));
+    header.version = MCA_MONITORING_TRACE_VERSION;
+    header.rank = my_rank;
+#if OPAL_TIMER_CYCLE_NATIVE
+    header.ticks_per_second = (double) opal_timer_base_get_freq();
+#else
+    header.ticks_per_second = 1e6;
+#endif
+    gettimeofday(&now, NULL);
+    header.epoch_ticks = mca_common_monitoring_time_now();
+    header.epoch_usec = (uint64_t) now.tv_sec * 1000000 + now.tv_usec;
+    header.num_ops = MCA_MONITORING_OP_MAX;
+    header.event_size = sizeof(mca_monitoring_trace_event_t);
+    (void) fwrite(&header, sizeof(header), 1, trace_file);
+    for( i = 0; i < MCA_MONITORING_OP_MAX; ++i ) {
+        (void) fwrite(mca_common_monitoring_op_names[i], 1,
+                      strlen(mca_common_monitoring_op_names[i]) + 1, trace_file);
+    }
+    return OMPI_SUCCESS;
+}
+
+int mca_common_monitoring_trace_init(int my_rank)
+{
+    int ret;
+
+    if( trace_initialized ) return OMPI_SUCCESS;
+    if( !mca_common_monitoring_trace_enabled && !mca_common_monitoring_histograms_enabled ) {
+        return OMPI_SUCCESS;
+    }
+
+    /* Shared with the histograms to time the nonblocking sends */
+    OBJ_CONSTRUCT(&trace_reqs, opal_free_list_t);
+    ret = opal_free_list_init(&trace_reqs, sizeof(mca_monitoring_trace_req_t),
+                              opal_cache_line_size, OBJ_CLASS(mca_monitoring_trace_req_t),
+                              0, 0, 64, MCA_MONITORING_TRACE_MAX_TRACKED, 64,
+                              NULL, 0, NULL, NULL, NULL);
+    if( OPAL_SUCCESS == ret ) {
+        OBJ_CONSTRUCT(&trace_tracked, opal_hash_table_t);
+        ret = opal_hash_table_init(&trace_tracked, 1024);
+    }
+    if( OPAL_SUCCESS != ret ) {
+        OPAL_MONITORING_PRINT_ERR("Cannot allocate the monitoring request list, "
+                                  "nonblocking operations will not be timed.");
+        OBJ_DESTRUCT(&trace_tracked);
+        OBJ_DESTRUCT(&trace_reqs);
+    } else {
+        OBJ_CONSTRUCT(&trace_pending, opal_list_t);
+        OBJ_CONSTRUCT(&trace_reqs_lock, opal_mutex_t);
+        trace_num_pending = 0;
+        trace_reqs_exhausted = false;
+        trace_reqs_initialized = true;
+        opal_progress_register(mca_common_monitoring_time_progress);
+    }
+
+    OBJ_CONSTRUCT(&trace_rings, opal_list_t);
+    OBJ_CONSTRUCT(&trace_lock, opal_mutex_t);
+    trace_generation++;
+    trace_initialized = true;
+
+    if( !mca_common_monitoring_trace_enabled ) return OMPI_SUCCESS;
+
+    if( mca_common_monitoring_trace_buffer_size < 2 ) mca_common_monitoring_trace_buffer_size = 2;
+    trace_mask = (size_t) opal_next_poweroftwo_inclusive(mca_common_monitoring_trace_buffer_size) - 1;
+    if( OMPI_SUCCESS != mca_common_monitoring_trace_open(my_rank) ) {
+        mca_common_monitoring_trace_enabled = 0;
+        return OMPI_ERROR;
+    }
+
+    OBJ_CONSTRUCT(&trace_flusher, opal_thread_t);
+    trace_flusher.t_run = mca_common_monitoring_trace_flusher_engine;
+    trace_flusher.t_arg = NULL;
+    trace_flusher_running = true;
+    if( OPAL_SUCCESS != (ret = opal_thread_start(&trace_flusher)) ) {
+        /* Keep tracing, the rings will only be written at the end */
+        OPAL_MONITORING_PRINT_WARN("Cannot start the trace helper thread (%d), events will "
+                                   "be dropped once the buffers are full.", ret);
+        trace_flusher_running = false;
+        OBJ_DESTRUCT(&trace_flusher);
+    }
+    return OMPI_SUCCESS;
+}
+
+void mca_common_monitoring_trace_finalize(void)
+{
+    mca_monitoring_trace_ring_t *ring;
+    mca_monitoring_trace_event_t event;
+
+    if( !trace_initialized ) return;
+
+    if( NULL != trace_file ) {
+        mca_common_monitoring_trace_enabled = 0;
+        if( trace_flusher_running ) {
+            trace_flusher_running = false;
+            opal_thread_join(&trace_flusher, NULL);
+            OBJ_DESTRUCT(&trace_flusher);
+        }
+        mca_common_monitoring_trace_drain();
+        /* Account for the events that did not fit in the rings */
+        memset(&event, 0, sizeof(event));
+        event.start = event.end = mca_common_monitoring_time_now();
+        event.peer = -1;
+        event.op = MCA_MONITORING_OP_DROPPED;
+        OPAL_LIST_FOREACH(ring, &trace_rings, mca_monitoring_trace_ring_t) {
+            if( 0 == ring->dropped ) continue;
+            event.bytes = ring->dropped;
+            event.thread = ring->thread;
+            (void) fwrite(&event, sizeof(event), 1, trace_file);
+            OPAL_MONITORING_PRINT_WARN("%zu trace events dropped by thread %d, consider "
+                                       "increasing pml_monitoring_trace_buffer_size",
+                                       ring->dropped, (int) ring->thread);
+        }
+        fclose(trace_file);
+        trace_file = NULL;
+    }
+    free(mca_common_monitoring_trace_filename);
+    mca_common_monitoring_trace_filename = NULL;
+
+    trace_initialized = false;
+    OPAL_LIST_DESTRUCT(&trace_rings);
+    OBJ_DESTRUCT(&trace_lock);
+    if( trace_reqs_initialized ) {
+        mca_monitoring_trace_req_t *req;
+        uint64_t key;
+
+        opal_progress_unregister(mca_common_monitoring_time_progress);
+        OPAL_THREAD_LOCK(&trace_reqs_lock);
+        trace_reqs_initialized = false;
+        /* Requests still alive get their free function back */
+        OPAL_HASH_TABLE_FOREACH(key, uint64, req, &trace_tracked) {
+            req->request->req_free = req->req_free;
+        }
+        OPAL_THREAD_UNLOCK(&trace_reqs_lock);
+        OBJ_DESTRUCT(&trace_tracked);
+        OBJ_DESTRUCT(&trace_pending);
+        OBJ_DESTRUCT(&trace_reqs_lock);
+        OBJ_DESTRUCT(&trace_reqs);
+    }
+}
+
+/* Ring of the calling thread, allocated on its first event */
+static mca_monitoring_trace_ring_t *mca_common_monitoring_trace_get_ring(void)
+{
+    mca_monitoring_trace_ring_t *ring = trace_ring;
+
+    if( OPAL_LIKELY(NULL != ring && trace_ring_generation == trace_generation) ) {
+        return ring;
+    }
+    if( !trace_initialized ) return NULL;
+
+    ring = OBJ_NEW(mca_monitoring_trace_ring_t);
+    if( NULL == ring ) return NULL;
+    ring->events = (mca_monitoring_trace_event_t *) malloc((trace_mask + 1) *
+                                                           sizeof(mca_monitoring_trace_event_t));
+    if( NULL == ring->events ) {
+        OBJ_RELEASE(ring);
+        return NULL;
+    }
+    OPAL_THREAD_LOCK(&trace_lock);
+    ring->thread = trace_nthreads++;
+    opal_list_append(&trace_rings, &ring->super);
+    OPAL_THREAD_UNLOCK(&trace_lock);
+
+    trace_ring = ring;
+    trace_ring_generation = trace_generation;
+    return ring;
+}
+
+static void mca_common_monitoring_trace_record(mca_monitoring_op_t op, int world_rank, int tag,
+                                               uint32_t cid, size_t data_size,
+                                               opal_timer_t start, opal_timer_t end)
+{
+    mca_monitoring_trace_ring_t *ring;
+    mca_monitoring_trace_event_t *event;
+    size_t head;
+
+    if( NULL == (ring = mca_common_monitoring_trace_get_ring()) ) return;
+
+    head = ring->head;
+    if( head - ring->tail > trace_mask ) {
+        ring->dropped++;  /* the helper thread is late, do not wait for it */
+        return;
+    }
+    event = &ring->events[head & trace_mask];
+    event->start = start;
+    event->end = end;
+    event->bytes = data_size;
+    event->peer = world_rank;
+    event->tag = tag;
+    event->cid = cid;
+    event->op = (uint16_t) op;
+    event->thread = ring->thread;
+    /* Publish the event only once it is complete */
+    opal_atomic_wmb();
+    ring->head = head + 1;
+}
+
+void mca_common_monitoring_time_record(mca_monitoring_op_t op, int world_rank, int tag,
+                                       uint32_t cid, size_t data_size,
+                                       opal_timer_t start, opal_timer_t end)
+{
+    if( 0 == mca_common_monitoring_current_state ) return;  /* right now the monitoring is not started */
+
+    if( mca_common_monitoring_histograms_enabled && op <= MCA_MONITORING_OP_PML_START ) {
+        mca_common_monitoring_histogram_record(world_rank, cid, data_size, end - start);
+    }
+    if( mca_common_monitoring_trace_enabled ) {
+        mca_common_monitoring_trace_record(op, world_rank, tag, cid, data_size, start, end);
+    }
+}
+
+/* Records the operation of a pending timed request as ended at end.
+ * Called with trace_reqs_lock held. */
+static void mca_common_monitoring_time_end(mca_monitoring_trace_req_t *req, opal_timer_t end)
+{
+    opal_list_remove_item(&trace_pending, &req->super.super);
+    req->pending = false;
+    (void) opal_atomic_sub_fetch_32(&trace_num_pending, 1);
+    mca_common_monitoring_time_record(req->op, req->world_rank, req->tag, req->cid,
+                                      req->data_size, req->start, end);
+}
+
+/* Records the pending timed requests that completed. Called with
+ * trace_reqs_lock held. */
+static int mca_common_monitoring_time_poll(void)
+{
+    mca_monitoring_trace_req_t *req, *next;
+    opal_timer_t now = 0;
+    int count = 0;
+
+    OPAL_LIST_FOREACH_SAFE(req, next, &trace_pending, mca_monitoring_trace_req_t) {
+        if( !REQUEST_COMPLETE(req->request) ) continue;
+        if( 0 == now ) now = mca_common_monitoring_time_now();
+        mca_common_monitoring_time_end(req, now);
+        count++;
+    }
+    return count;
+}
+
+/* The completion callback of a request belongs to its owner and the
+ * upper layers chain theirs on it, so the timed requests are polled
+ * from the progress engine instead. */
+static int mca_common_monitoring_time_progress(void)
+{
+    int count;
+
+    if( 0 == trace_num_pending ) return 0;
+    if( 0 != OPAL_THREAD_TRYLOCK(&trace_reqs_lock) ) return 0;
+    count = mca_common_monitoring_time_poll();
+    OPAL_THREAD_UNLOCK(&trace_reqs_lock);
+    return count;
+}
+
+/* Installed as the free function of the timed requests. A request that
+ * completed since the last progress is recorded when the wait or test
+ * frees it. */
+static int mca_common_monitoring_time_free(ompi_request_t **request)
+{
+    mca_monitoring_trace_req_t *req = NULL;
+    ompi_request_t *ompi_req = *request;
+    ompi_request_free_fn_t req_free;
+
+    OPAL_THREAD_LOCK(&trace_reqs_lock);
+    (void) opal_hash_table_get_value_uint64(&trace_tracked, (uint64_t) (uintptr_t) ompi_req,
+                                            (void **) &req);
+    /* only called through the hook, which the table outlives */
+    assert(NULL != req);
+    if( req->pending ) {
+        if( REQUEST_COMPLETE(ompi_req) ) {
+            mca_common_monitoring_time_end(req, mca_common_monitoring_time_now());
+        } else {
+            /* freed while active, there is no end to record */
+            opal_list_remove_item(&trace_pending, &req->super.super);
+            req->pending = false;
+            (void) opal_atomic_sub_fetch_32(&trace_num_pending, 1);
+        }
+    }
+    (void) opal_hash_table_remove_value_uint64(&trace_tracked, (uint64_t) (uintptr_t) ompi_req);
+    OPAL_THREAD_UNLOCK(&trace_reqs_lock);
+
+    /* the request object may be reused without being constructed again */
+    req_free = req->req_free;
+    ompi_req->req_free = req_free;
+    opal_free_list_return(&trace_reqs, &req->super);
+    return req_free(request);
+}
+
+void mca_common_monitoring_time_track(mca_monitoring_op_t op, int world_rank, int tag,
+                                      uint32_t cid, size_t data_size,
+                                      opal_timer_t start, ompi_request_t *request)
+{
+    mca_monitoring_trace_req_t *req = NULL;
+    uint64_t key = (uint64_t) (uintptr_t) request;
+
+    if( 0 == start || NULL == request ) return;
+
+    if( request->req_persistent && trace_reqs_initialized ) {
+        /* A previous start not seen completing yet had completed before
+         * this one was started */
+        OPAL_THREAD_LOCK(&trace_reqs_lock);
+        (void) opal_hash_table_get_value_uint64(&trace_tracked, key, (void **) &req);
+        if( NULL != req && req->pending ) {
+            mca_common_monitoring_time_end(req, start);
+        }
+        OPAL_THREAD_UNLOCK(&trace_reqs_lock);
+        req = NULL;
+    }
+
+    /* Eager sends are often already complete */
+    if( REQUEST_COMPLETE(request) ) {
+        mca_common_monitoring_time_stop(op, world_rank, tag, cid, data_size, start);
+        return;
+    }
+    if( !trace_reqs_initialized ) return;
+
+    OPAL_THREAD_LOCK(&trace_reqs_lock);
+    /* a restarted persistent request keeps its entry */
+    (void) opal_hash_table_get_value_uint64(&trace_tracked, key, (void **) &req);
+    if( NULL == req ) {
+        req = (mca_monitoring_trace_req_t *) opal_free_list_get(&trace_reqs);
+        if( NULL == req ) {
+            /* too many operations in flight, skip this one */
+            if( !trace_reqs_exhausted ) {
+                trace_reqs_exhausted = true;
+                OPAL_MONITORING_PRINT_WARN("More than %d nonblocking operations in flight, "
+                                           "the others are not timed.",
+                                           MCA_MONITORING_TRACE_MAX_TRACKED);
+            }
+            OPAL_THREAD_UNLOCK(&trace_reqs_lock);
+            return;
+        }
+        if( OPAL_SUCCESS != opal_hash_table_set_value_uint64(&trace_tracked, key, req) ) {
+            opal_free_list_return(&trace_reqs, &req->super);
+            OPAL_THREAD_UNLOCK(&trace_reqs_lock);
+            return;
+        }
+        req->request = request;
+        req->req_free = request->req_free;
+        req->pending = false;
+        request->req_free = mca_common_monitoring_time_free;
+    }
+    req->start = start;
+    req->data_size = data_size;
+    req->cid = cid;
+    req->world_rank = world_rank;
+    req->tag = tag;
+    req->op = op;
+    if( !req->pending ) {
+        req->pending = true;
+        opal_list_append(&trace_pending, &req->super.super);
+        (void) opal_atomic_add_fetch_32(&trace_num_pending, 1);
+    }
+    OPAL_THREAD_UNLOCK(&trace_reqs_lock);
+}
@@ -0,0 +1,197 @@
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#ifndef MCA_COMMON_MONITORING_TRACE_H
+#define MCA_COMMON_MONITORING_TRACE_H
+
+BEGIN_C_DECLS
+
+#include "ompi_config.h"
+#include "ompi/request/request.h"
+#include "opal/mca/timer/timer.h"
+#include MCA_timer_IMPLEMENTATION_HEADER
+#include "common_monitoring_histogram.h"
+
+/*
+ * Optional timeline of the operations intercepted by the monitoring
+ * components. Each operation is recorded as a fixed size binary event in
+ * a ring buffer owned by the calling thread, and a helper thread drains
+ * the rings of all threads into <pml_monitoring_trace_filename>.<rank>.trace.
+ * When a ring is full the events are dropped and only counted, the
+ * application thread never waits for the file.
+ *
+ * The file starts with a mca_monitoring_trace_header_t, followed by the
+ * num_ops NUL-terminated names of the operations and by the events, all
+ * in the byte order of the host that wrote them. A MCA_MONITORING_OP_DROPPED
+ * event closes the trace of each thread that lost events, with the number
+ * of lost events in its bytes field. trace2chrome.pl converts these files
+ * into the JSON format understood by chrome://tracing and Perfetto.
+ */
+
+#define MCA_MONITORING_TRACE_MAGIC   "OMPITRC"
+#define MCA_MONITORING_TRACE_VERSION 1
+
+typedef enum mca_monitoring_op_t {
+    /* The first three are the sends accounted in the histograms */
+    MCA_MONITORING_OP_PML_SEND = 0,
+    MCA_MONITORING_OP_PML_ISEND,
+    MCA_MONITORING_OP_PML_START,
+    MCA_MONITORING_OP_PML_RECV,
+    MCA_MONITORING_OP_PML_IRECV,
+
+    MCA_MONITORING_OP_COLL_ALLGATHER,
+    MCA_MONITORING_OP_COLL_IALLGATHER,
+    MCA_MONITORING_OP_COLL_ALLGATHERV,
+    MCA_MONITORING_OP_COLL_IALLGATHERV,
+    MCA_MONITORING_OP_COLL_ALLREDUCE,
+    MCA_MONITORING_OP_COLL_IALLREDUCE,
+    MCA_MONITORING_OP_COLL_ALLTOALL,
+    MCA_MONITORING_OP_COLL_IALLTOALL,
+    MCA_MONITORING_OP_COLL_ALLTOALLV,
+    MCA_MONITORING_OP_COLL_IALLTOALLV,
+    MCA_MONITORING_OP_COLL_ALLTOALLW,
+    MCA_MONITORING_OP_COLL_IALLTOALLW,
+    MCA_MONITORING_OP_COLL_BARRIER,
+    MCA_MONITORING_OP_COLL_IBARRIER,
+    MCA_MONITORING_OP_COLL_BCAST,
+    MCA_MONITORING_OP_COLL_IBCAST,
+    MCA_MONITORING_OP_COLL_EXSCAN,
+    MCA_MONITORING_OP_COLL_IEXSCAN,
+    MCA_MONITORING_OP_COLL_GATHER,
+    MCA_MONITORING_OP_COLL_IGATHER,
+    MCA_MONITORING_OP_COLL_GATHERV,
+    MCA_MONITORING_OP_COLL_IGATHERV,
+    MCA_MONITORING_OP_COLL_REDUCE,
+    MCA_MONITORING_OP_COLL_IREDUCE,
+    MCA_MONITORING_OP_COLL_REDUCE_SCATTER,
+    MCA_MONITORING_OP_COLL_IREDUCE_SCATTER,
+    MCA_MONITORING_OP_COLL_REDUCE_SCATTER_BLOCK,
+    MCA_MONITORING_OP_COLL_IREDUCE_SCATTER_BLOCK,
+    MCA_MONITORING_OP_COLL_SCAN,
+    MCA_MONITORING_OP_COLL_ISCAN,
+    MCA_MONITORING_OP_COLL_SCATTER,
+    MCA_MONITORING_OP_COLL_ISCATTER,
+    MCA_MONITORING_OP_COLL_SCATTERV,
+    MCA_MONITORING_OP_COLL_ISCATTERV,
+    MCA_MONITORING_OP_COLL_NEIGHBOR_ALLGATHER,
+    MCA_MONITORING_OP_COLL_INEIGHBOR_ALLGATHER,
+    MCA_MONITORING_OP_COLL_NEIGHBOR_ALLGATHERV,
+    MCA_MONITORING_OP_COLL_INEIGHBOR_ALLGATHERV,
+    MCA_MONITORING_OP_COLL_NEIGHBOR_ALLTOALL,
+    MCA_MONITORING_OP_COLL_INEIGHBOR_ALLTOALL,
+    MCA_MONITORING_OP_COLL_NEIGHBOR_ALLTOALLV,
+    MCA_MONITORING_OP_COLL_INEIGHBOR_ALLTOALLV,
+    MCA_MONITORING_OP_COLL_NEIGHBOR_ALLTOALLW,
+    MCA_MONITORING_OP_COLL_INEIGHBOR_ALLTOALLW,
+
+    MCA_MONITORING_OP_OSC_PUT,
+    MCA_MONITORING_OP_OSC_RPUT,
+    MCA_MONITORING_OP_OSC_GET,
+    MCA_MONITORING_OP_OSC_RGET,
+    MCA_MONITORING_OP_OSC_ACCUMULATE,
+    MCA_MONITORING_OP_OSC_RACCUMULATE,
+    MCA_MONITORING_OP_OSC_GET_ACCUMULATE,
+    MCA_MONITORING_OP_OSC_RGET_ACCUMULATE,
+    MCA_MONITORING_OP_OSC_FETCH_AND_OP,
+    MCA_MONITORING_OP_OSC_COMPARE_AND_SWAP,
+    MCA_MONITORING_OP_OSC_FENCE,
+    MCA_MONITORING_OP_OSC_POST,
+    MCA_MONITORING_OP_OSC_START,
+    MCA_MONITORING_OP_OSC_COMPLETE,
+    MCA_MONITORING_OP_OSC_WAIT,
+    MCA_MONITORING_OP_OSC_LOCK,
+    MCA_MONITORING_OP_OSC_UNLOCK,
+    MCA_MONITORING_OP_OSC_LOCK_ALL,
+    MCA_MONITORING_OP_OSC_UNLOCK_ALL,
+    MCA_MONITORING_OP_OSC_FLUSH,
+    MCA_MONITORING_OP_OSC_FLUSH_ALL,
+    MCA_MONITORING_OP_OSC_FLUSH_LOCAL,
+    MCA_MONITORING_OP_OSC_FLUSH_LOCAL_ALL,
+    MCA_MONITORING_OP_OSC_SYNC,
+
+    MCA_MONITORING_OP_DROPPED,
+    MCA_MONITORING_OP_MAX
+} mca_monitoring_op_t;
+
+/* Layout of the trace files, do not change without bumping the version */
+typedef struct mca_monitoring_trace_header_t {
+    char     magic[8];          /* MCA_MONITORING_TRACE_MAGIC */
+    uint32_t version;           /* MCA_MONITORING_TRACE_VERSION */
+    int32_t  rank;              /* rank in MPI_COMM_WORLD */
+    double   ticks_per_second;  /* unit of the event timestamps */
+    uint64_t epoch_ticks;       /* timestamp taken ... */
+    uint64_t epoch_usec;        /* ... at this time of the day, to align the ranks */
+    uint32_t num_ops;           /* number of operation names following the header */
+    uint32_t event_size;        /* sizeof(mca_monitoring_trace_event_t) */
+} mca_monitoring_trace_header_t;
+
+typedef struct mca_monitoring_trace_event_t {
+    uint64_t start;   /* call of the operation */
+    uint64_t end;     /* return of a blocking call, completion of a nonblocking one */
+    uint64_t bytes;   /* local payload, 0 for the collectives and synchronizations */
+    int32_t  peer;    /* rank in MPI_COMM_WORLD of the peer or root, -1 if none */
+    int32_t  tag;     /* PML tag, 0 for the other operations */
+    uint32_t cid;     /* communicator ID, or Fortran index of the window */
+    uint16_t op;      /* mca_monitoring_op_t */
+    uint16_t thread;  /* index of the recording thread in this process */
+} mca_monitoring_trace_event_t;
+
+extern int mca_common_monitoring_trace_enabled;
+
+OMPI_DECLSPEC void mca_common_monitoring_trace_register(void);
+OMPI_DECLSPEC int  mca_common_monitoring_trace_init(int my_rank);
+OMPI_DECLSPEC void mca_common_monitoring_trace_finalize(void);
+
+static inline opal_timer_t mca_common_monitoring_time_now(void)
+{
+#if OPAL_TIMER_CYCLE_NATIVE
+    return opal_timer_base_get_cycles();
+#else
+    return opal_timer_base_get_usec();
+#endif
+}
+
+/* Starts timing an operation. Returns 0 when neither the trace nor the
+ * histograms need it. */
+static inline opal_timer_t mca_common_monitoring_time_start(mca_monitoring_op_t op)
+{
+    if( OPAL_LIKELY(!mca_common_monitoring_trace_enabled) &&
+        (OPAL_LIKELY(!mca_common_monitoring_histograms_enabled) ||
+         op > MCA_MONITORING_OP_PML_START) ) {
+        return 0;
+    }
+    return mca_common_monitoring_time_now();
+}
+
+/* Records an operation that started at start and just ended */
+OMPI_DECLSPEC void mca_common_monitoring_time_record(mca_monitoring_op_t op, int world_rank, int tag,
+                                                     uint32_t cid, size_t data_size,
+                                                     opal_timer_t start, opal_timer_t end);
+
+/* Records a blocking operation started at start. */
+static inline void mca_common_monitoring_time_stop(mca_monitoring_op_t op, int world_rank, int tag,
+                                                   uint32_t cid, size_t data_size, opal_timer_t start)
+{
+    if( 0 == start ) return;
+    mca_common_monitoring_time_record(op, world_rank, tag, cid, data_size, start,
+                                      mca_common_monitoring_time_now());
+}
+
+/* Tracks a nonblocking operation started at start. It is recorded when
+ * the progress engine or the release of the request finds it completed,
+ * or right away if it already is. */
+OMPI_DECLSPEC void mca_common_monitoring_time_track(mca_monitoring_op_t op, int world_rank, int tag,
+                                                    uint32_t cid, size_t data_size,
+                                                    opal_timer_t start, ompi_request_t *request);
+
+END_C_DECLS
+
+#endif  /* MCA_COMMON_MONITORING_TRACE_H */
@@ -0,0 +1,113 @@
+#!/usr/bin/perl -w
+
+#
+# Copyright (c) 2026      The University of Tennessee and The University
+#                         of Tennessee Research Foundation.  All rights
+#                         reserved.
+# $COPYRIGHT$
+#
+# Additional copyrights may follow
+#
+# $HEADER$
+#
+
+#
+# Convert the ".trace" files written with --mca pml_monitoring_trace_filename
+# into a single JSON file in the Chrome trace event format, to be loaded in
+# chrome://tracing or https://ui.perfetto.dev
+#
+# Each MPI rank becomes a process and each of its threads a track. The
+# timestamps of the ranks are aligned on the time of the day they recorded
+# when they opened their trace, so they are only as accurate as the clock
+# synchronization of the nodes.
+#
+# ensure that this script as the executable right: chmod +x ...
+#
+
+use strict;
+
+if($#ARGV < 1){
+    die("Usage: $0 <output.json> <trace files>\n");
+}
+
+my $output = shift @ARGV;
+my @traces;
+my $origin;
+
+# Load all the headers first to find the earliest one
+foreach my $filename (@ARGV) {
+    my $trace = read_header($filename);
+    push @traces, $trace;
+    $origin = $trace->{epoch_usec} if( !defined($origin) || $trace->{epoch_usec} < $origin );
+}
+
+open(OUT, ">", $output) or die("Cannot open $output: $!\n");
+print OUT "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+my $first = 1;
+foreach my $trace (@traces) {
+    my $nevents = convert($trace, $origin, \$first);
+    print STDERR "$trace->{filename}: rank $trace->{rank}, $nevents events\n";
+}
+print OUT "\n]}\n";
+close(OUT);
+
+sub read_header {
+    my ($filename) = @_;
+    my ($buf, %trace);
+
+    open(my $fh, "<", $filename) or die("Cannot open $filename: $!\n");
+    binmode($fh);
+    read($fh, $buf, 48) == 48 or die("$filename: truncated header\n");
+    my ($magic, $version, $rank, $freq, $epoch_ticks, $epoch_usec, $num_ops, $event_size) =
+        unpack("a8 L l d Q Q L L", $buf);
+    $magic =~ s/\0.*//s;
+    die("$filename: not a monitoring trace\n") if( $magic ne "OMPITRC" );
+    die("$filename: unsupported trace version $version\n") if( 1 != $version );
+
+    # The operation names, NUL terminated
+    my @ops;
+    local $/ = "\0";
+    for( my $i = 0; $i < $num_ops; $i++ ) {
+        my $name = <$fh>;
+        die("$filename: truncated operation names\n") if( !defined($name) );
+        chomp($name);
+        push @ops, $name;
+    }
+
+    %trace = (filename => $filename, fh => $fh, rank => $rank, freq => $freq,
+              epoch_ticks => $epoch_ticks, epoch_usec => $epoch_usec,
+              event_size => $event_size, ops => \@ops);
+    return \%trace;
+}
+
+sub convert {
+    my ($trace, $origin, $first) = @_;
+    my ($fh, $buf, $nevents) = ($trace->{fh}, undef, 0);
+    # Microseconds of the timeline at the epoch of this rank
+    my $offset = $trace->{epoch_usec} - $origin;
+    my $scale = 1e6 / $trace->{freq};
+
+    while( read($fh, $buf, $trace->{event_size}) == $trace->{event_size} ) {
+        my ($start, $end, $bytes, $peer, $tag, $cid, $op, $thread) =
+            unpack("Q Q Q l l L S S", $buf);
+        my $name = $trace->{ops}[$op] // "op$op";
+        my $cat = ($name =~ /^([^.]+)\./) ? $1 : $name;
+        my $ts = $offset + ($start - $trace->{epoch_ticks}) * $scale;
+        my $dur = ($end >= $start) ? ($end - $start) * $scale : 0;
+
+        print OUT ",\n" unless( $$first );
+        $$first = 0;
+        if( "dropped" eq $name ) {
+            printf OUT "{\"name\":\"dropped\",\"cat\":\"trace\",\"ph\":\"i\",\"s\":\"t\","
+                . "\"ts\":%.3f,\"pid\":%d,\"tid\":%d,\"args\":{\"events\":%d}}",
+                $ts, $trace->{rank}, $thread, $bytes;
+        } else {
+            printf OUT "{\"name\":\"%s\",\"cat\":\"%s\",\"ph\":\"X\",\"ts\":%.3f,\"dur\":%.3f,"
+                . "\"pid\":%d,\"tid\":%d,\"args\":{\"peer\":%d,\"tag\":%d,\"bytes\":%d,\"cid\":%d}}",
+                $name, $cat, $ts, $dur, $trace->{rank}, $thread, $peer, $tag, $bytes, $cid;
+        }
+        $nevents++;
+    }
+    close($fh);
+    return $nevents;
+}
@@ -86,6 +86,25 @@
 #define OMPIO_LOCK_ENTIRE_REGION  10
 #define OMPIO_LOCK_SELECTIVE      11
 
+/* values of the data_sieving parameter */
+#define OMPIO_SIEVE_READS          0x1
+#define OMPIO_SIEVE_WRITES         0x2
+
+/* values of the cache parameter */
+#define OMPIO_CACHE_READS          0x1
+#define OMPIO_CACHE_WRITES         0x2
+
+/* values of the stats parameter */
+#define OMPIO_STATS_COLLECT        1
+#define OMPIO_STATS_REPORT         2
+
+/* phases of the operations timed by the statistics */
+#define OMPIO_STATS_IO             0
+#define OMPIO_STATS_SHUFFLE        1
+#define OMPIO_STATS_WAIT           2
+#define OMPIO_STATS_TOTAL          3
+#define OMPIO_STATS_NUM_PHASES     4
+
 #define OMPIO_FCOLL_WANT_TIME_BREAKDOWN 0
 #define MCA_IO_DEFAULT_FILE_VIEW_SIZE 4*1024*1024
 
@@ -167,6 +186,7 @@ struct ompio_file_t {
     int                    f_atomicity;
     size_t                 f_stripe_size;
     int                    f_stripe_count;
+    int                    f_stripe_offset; /* OST holding the first stripe */
     size_t                 f_cc_size;
     size_t                 f_avg_view_size;
     int                    f_bytes_per_agg;
@@ -177,6 +197,16 @@ struct ompio_file_t {
        Note: Neither f_sharedfp nor f_sharedfp_component seemed appropriate for this.
     */
     void                  *f_sharedfp_data;
+    /* Place for the selected fbtl module to hang its per file data. */
+    void                  *f_fbtl_data;
+    /* Place for the selected fcoll module to hang its per file data. */
+    void                  *f_fcoll_data;
+    /* client side cache for the individual operations */
+    struct mca_common_ompio_cache_t *f_cache;
+    /* compression of the file data, NULL if the file is not compressed */
+    struct mca_common_ompio_compress_t *f_compress;
+    /* I/O statistics of the file, NULL if not collected */
+    struct mca_common_ompio_stats_t *f_stats;
 
 
     /* File View parameters */
@@ -276,6 +306,35 @@ OMPI_DECLSPEC int mca_common_ompio_build_io_array ( ompio_file_t *fh, int index,
                                                     size_t *spc, mca_common_ompio_io_array_t **io_array,
                                                     int *num_io_entries );
 
+OMPI_DECLSPEC ssize_t mca_common_ompio_sieve_preadv (ompio_file_t *fh);
+OMPI_DECLSPEC ssize_t mca_common_ompio_sieve_pwritev (ompio_file_t *fh);
+
+OMPI_DECLSPEC ssize_t mca_common_ompio_cache_preadv (ompio_file_t *fh);
+OMPI_DECLSPEC ssize_t mca_common_ompio_cache_pwritev (ompio_file_t *fh);
+OMPI_DECLSPEC int mca_common_ompio_cache_flush (ompio_file_t *fh, bool invalidate);
+OMPI_DECLSPEC void mca_common_ompio_cache_free (ompio_file_t *fh);
+
+OMPI_DECLSPEC bool mca_common_ompio_compress_requested (ompio_file_t *fh);
+OMPI_DECLSPEC int mca_common_ompio_compress_open (ompio_file_t *fh);
+OMPI_DECLSPEC ssize_t mca_common_ompio_compress_preadv (ompio_file_t *fh);
+OMPI_DECLSPEC ssize_t mca_common_ompio_compress_pwritev (ompio_file_t *fh);
+OMPI_DECLSPEC int mca_common_ompio_compress_get_size (ompio_file_t *fh, OMPI_MPI_OFFSET_TYPE *size);
+OMPI_DECLSPEC int mca_common_ompio_compress_set_size (ompio_file_t *fh, OMPI_MPI_OFFSET_TYPE size);
+OMPI_DECLSPEC size_t mca_common_ompio_compress_chunk_size (ompio_file_t *fh);
+OMPI_DECLSPEC void mca_common_ompio_compress_invalidate (ompio_file_t *fh);
+OMPI_DECLSPEC void mca_common_ompio_compress_free (ompio_file_t *fh);
+
+OMPI_DECLSPEC void mca_common_ompio_stats_init (ompio_file_t *fh);
+OMPI_DECLSPEC uint64_t mca_common_ompio_stats_time (ompio_file_t *fh);
+OMPI_DECLSPEC void mca_common_ompio_stats_phase (ompio_file_t *fh, int phase, uint64_t start);
+OMPI_DECLSPEC uint64_t mca_common_ompio_stats_begin (ompio_file_t *fh);
+OMPI_DECLSPEC void mca_common_ompio_stats_end (ompio_file_t *fh, bool is_write, size_t bytes,
+                                               uint64_t start);
+OMPI_DECLSPEC void mca_common_ompio_stats_aggr (ompio_file_t *fh, size_t bytes);
+OMPI_DECLSPEC int mca_common_ompio_stats_report (ompio_file_t *fh);
+OMPI_DECLSPEC void mca_common_ompio_stats_free (ompio_file_t *fh);
+OMPI_DECLSPEC int mca_common_ompio_stats_register_pvars (const mca_base_component_t *component);
+
 
 OMPI_DECLSPEC int mca_common_ompio_file_read (ompio_file_t *fh,  void *buf,  int count,
                                               struct ompi_datatype_t *datatype, ompi_status_public_t *status);
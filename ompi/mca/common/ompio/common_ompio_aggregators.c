@@ -542,6 +542,56 @@ int mca_common_ompio_set_aggregator_props (struct ompio_file_t *fh,
     return ret;
 }
 
+/*
+** Stripe aware file domains: the file is partitioned into its stripes,
+** and all stripes stored on the same OST are handled by the same, fixed
+** set of aggregators (group-cyclic distribution). An aggregator therefore
+** only ever writes whole stripes and never competes with another aggregator
+** for the extent lock of a stripe.
+**
+** This requires the number of aggregators to be either a multiple or a
+** divisor of the stripe count. This function returns the largest such
+** number not exceeding num_aggregators.
+*/
+int mca_common_ompio_stripe_aggregators (ompio_file_t *fh, int num_aggregators)
+{
+    int count = fh->f_stripe_count;
+
+    if ( 0 == fh->f_stripe_size || 1 >= count || 1 >= num_aggregators ) {
+        return num_aggregators;
+    }
+    if ( num_aggregators >= count ) {
+        return (num_aggregators / count) * count;
+    }
+    while ( count % num_aggregators ) {
+        num_aggregators--;
+    }
+    return num_aggregators;
+}
+
+/*
+** Index of the aggregator handling the given file offset with stripe aware
+** file domains. The objects of the file are assumed to be on consecutive
+** OSTs starting at f_stripe_offset, such that an OST is mapped to the same
+** aggregators for every file using it.
+*/
+int mca_common_ompio_stripe_owner (ompio_file_t *fh, OMPI_MPI_OFFSET_TYPE offset,
+                                   int num_aggregators)
+{
+    OMPI_MPI_OFFSET_TYPE stripe = offset / fh->f_stripe_size;
+    int count = fh->f_stripe_count;
+    int ost, per_ost;
+
+    ost = (int) ((fh->f_stripe_offset + stripe) % count);
+    if ( num_aggregators <= count ) {
+        return ost % num_aggregators;
+    }
+
+    /* the stripes of an OST are distributed cyclically over its aggregators */
+    per_ost = num_aggregators / count;
+    return ost * per_ost + (int) ((stripe / count) % per_ost);
+}
+
 
 
 /*****************************************************************************************************/
@@ -52,6 +52,12 @@ OMPI_DECLSPEC int mca_common_ompio_set_aggregator_props (struct ompio_file_t *fh
                                                          int num_aggregators,
                                                          size_t bytes_per_proc);
 
+/*Stripe aware file domains*/
+OMPI_DECLSPEC int mca_common_ompio_stripe_aggregators (ompio_file_t *fh, int num_aggregators);
+
+OMPI_DECLSPEC int mca_common_ompio_stripe_owner (ompio_file_t *fh, OMPI_MPI_OFFSET_TYPE offset,
+                                                 int num_aggregators);
+
 int  mca_common_ompio_forced_grouping ( ompio_file_t *fh,
                                         int num_groups,
                                         mca_common_ompio_contg *contg_groups);
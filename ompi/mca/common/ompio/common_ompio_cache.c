@@ -0,0 +1,553 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ *  Copyright (c) 2026      The University of Tennessee and The University
+ *                          of Tennessee Research Foundation.  All rights
+ *                          reserved.
+ *  $COPYRIGHT$
+ *
+ *  Additional copyrights may follow
+ *
+ *  $HEADER$
+ */
+
+#include "ompi_config.h"
+
+#include "ompi/mca/fbtl/fbtl.h"
+#include "common_ompio.h"
+
+#include <string.h>
+
+/*
+  Client side cache for the independent read and write operations.
+
+  The cache consists of cache_num_blocks blocks of cache_block_size
+  bytes, each caching one block aligned region of the file. A block
+  holds one contiguous range of valid data, and within that range one
+  contiguous range of modified data.
+
+  Write-behind: pieces of the io_array smaller than a block are copied
+  into the cache. Modified data is written back when a block is
+  evicted, when a write to the block is not contiguous with the
+  modified range, when the amount of modified data of the file exceeds
+  cache_flush_threshold, and on sync, close, set_size, collective and
+  nonblocking operations. Errors of the write-back are reported by the
+  operation triggering it.
+
+  Read-ahead: a read of a piece smaller than a block which continues
+  the previous read loads the entire block, subsequent reads of the
+  block are served from the cache. Non sequential reads which miss the
+  cache go to the file directly.
+
+  Larger pieces are handed to the fbtl (through data sieving) after
+  writing back modified data in the cache overlapping them. Data read
+  from the file is only guaranteed to be current until the next sync,
+  i.e. the cache provides the consistency of MPI with atomic mode
+  disabled, and is not used while atomic mode is enabled.
+*/
+
+typedef struct mca_common_ompio_cache_block_t {
+    OMPI_MPI_OFFSET_TYPE offset;  /* start of the block in the file, -1 if unused */
+    char    *buf;
+    size_t   valid_start, valid_end;
+    size_t   dirty_start, dirty_end;
+    uint64_t stamp;
+} mca_common_ompio_cache_block_t;
+
+struct mca_common_ompio_cache_t {
+    int                              mode;
+    size_t                           block_size;
+    int                              num_blocks;
+    mca_common_ompio_cache_block_t  *blocks;
+    size_t                           dirty_bytes;
+    size_t                           flush_threshold;
+    OMPI_MPI_OFFSET_TYPE             last_read_end;
+    uint64_t                         clock;
+};
+typedef struct mca_common_ompio_cache_t mca_common_ompio_cache_t;
+
+static mca_common_ompio_cache_t *cache_get (ompio_file_t *fh)
+{
+    mca_common_ompio_cache_t *c;
+    int i, mode;
+
+    if ( NULL != fh->f_cache ) {
+        return fh->f_cache;
+    }
+
+    mode = OMPIO_MCA_GET(fh, cache);
+    if ( fh->f_amode & MPI_MODE_WRONLY ) {
+        mode &= ~OMPIO_CACHE_READS;
+    }
+    if ( 0 == mode || 0 >= OMPIO_MCA_GET(fh, cache_block_size) ||
+         0 >= OMPIO_MCA_GET(fh, cache_num_blocks) ) {
+        return NULL;
+    }
+
+    c = (mca_common_ompio_cache_t *) calloc (1, sizeof(mca_common_ompio_cache_t));
+    if ( NULL == c ) {
+        return NULL;
+    }
+    c->mode       = mode;
+    c->block_size = (size_t) OMPIO_MCA_GET(fh, cache_block_size);
+    c->num_blocks = OMPIO_MCA_GET(fh, cache_num_blocks);
+    c->flush_threshold = (size_t) OMPIO_MCA_GET(fh, cache_flush_threshold);
+    c->blocks = (mca_common_ompio_cache_block_t *) calloc (c->num_blocks,
+                                                           sizeof(mca_common_ompio_cache_block_t));
+    if ( NULL == c->blocks ) {
+        free (c);
+        return NULL;
+    }
+    for ( i = 0; i < c->num_blocks; i++ ) {
+        c->blocks[i].offset = -1;
+    }
+
+    fh->f_cache = c;
+    return c;
+}
+
+/* Hand the entries of io_array to the fbtl, applying data sieving */
+static ssize_t cache_direct_op (ompio_file_t *fh, mca_common_ompio_io_array_t *io_array,
+                                int num_entries, bool is_write)
+{
+    mca_common_ompio_io_array_t *saved_array = fh->f_io_array;
+    int saved_entries = fh->f_num_of_io_entries;
+    ssize_t ret;
+
+    fh->f_io_array = io_array;
+    fh->f_num_of_io_entries = num_entries;
+    if ( is_write ) {
+        ret = mca_common_ompio_sieve_pwritev (fh);
+    }
+    else {
+        ret = mca_common_ompio_sieve_preadv (fh);
+    }
+    fh->f_io_array = saved_array;
+    fh->f_num_of_io_entries = saved_entries;
+
+    return ret;
+}
+
+/* Access the range [start, end) of the block in the file */
+static ssize_t cache_block_op (ompio_file_t *fh, mca_common_ompio_cache_block_t *block,
+                               size_t start, size_t end, bool is_write)
+{
+    mca_common_ompio_io_array_t *saved_array = fh->f_io_array;
+    int saved_entries = fh->f_num_of_io_entries;
+    mca_common_ompio_io_array_t entry;
+    ssize_t ret;
+
+    entry.memory_address = block->buf + start;
+    entry.offset = (IOVBASE_TYPE *)(intptr_t) (block->offset + start);
+    entry.length = end - start;
+
+    fh->f_io_array = &entry;
+    fh->f_num_of_io_entries = 1;
+    if ( is_write ) {
+        ret = fh->f_fbtl->fbtl_pwritev (fh);
+    }
+    else {
+        ret = fh->f_fbtl->fbtl_preadv (fh);
+    }
+    fh->f_io_array = saved_array;
+    fh->f_num_of_io_entries = saved_entries;
+
+    return ret;
+}
+
+static int cache_block_flush (ompio_file_t *fh, mca_common_ompio_cache_t *c,
+                              mca_common_ompio_cache_block_t *block)
+{
+    ssize_t ret;
+
+    if ( block->dirty_start == block->dirty_end ) {
+        return OMPI_SUCCESS;
+    }
+
+    ret = cache_block_op (fh, block, block->dirty_start, block->dirty_end, true);
+    c->dirty_bytes -= block->dirty_end - block->dirty_start;
+    block->dirty_start = block->dirty_end = 0;
+
+    return ( 0 > ret ) ? (int) ret : OMPI_SUCCESS;
+}
+
+static void cache_block_invalidate (mca_common_ompio_cache_block_t *block)
+{
+    block->offset = -1;
+    block->valid_start = block->valid_end = 0;
+    block->dirty_start = block->dirty_end = 0;
+}
+
+static mca_common_ompio_cache_block_t *cache_lookup (mca_common_ompio_cache_t *c,
+                                                     OMPI_MPI_OFFSET_TYPE offset)
+{
+    int i;
+
+    for ( i = 0; i < c->num_blocks; i++ ) {
+        if ( c->blocks[i].offset == offset ) {
+            c->blocks[i].stamp = ++c->clock;
+            return &c->blocks[i];
+        }
+    }
+    return NULL;
+}
+
+/* Assign a block to the file block starting at offset, evicting the
+   least recently used one */
+static int cache_assign (ompio_file_t *fh, mca_common_ompio_cache_t *c,
+                         OMPI_MPI_OFFSET_TYPE offset,
+                         mca_common_ompio_cache_block_t **ret_block)
+{
+    mca_common_ompio_cache_block_t *block = &c->blocks[0];
+    int i, ret;
+
+    for ( i = 1; i < c->num_blocks && -1 != block->offset; i++ ) {
+        if ( -1 == c->blocks[i].offset || c->blocks[i].stamp < block->stamp ) {
+            block = &c->blocks[i];
+        }
+    }
+
+    ret = cache_block_flush (fh, c, block);
+    if ( OMPI_SUCCESS != ret ) {
+        return ret;
+    }
+    cache_block_invalidate (block);
+
+    if ( NULL == block->buf ) {
+        block->buf = (char *) malloc (c->block_size);
+        if ( NULL == block->buf ) {
+            return OMPI_ERR_OUT_OF_RESOURCE;
+        }
+    }
+    block->offset = offset;
+    block->stamp  = ++c->clock;
+
+    *ret_block = block;
+    return OMPI_SUCCESS;
+}
+
+/* Write back modified data overlapping [offset, offset+len) and drop
+   the blocks, before the range is accessed without the cache */
+static int cache_evict_range (ompio_file_t *fh, mca_common_ompio_cache_t *c,
+                              OMPI_MPI_OFFSET_TYPE offset, size_t len, bool invalidate)
+{
+    mca_common_ompio_cache_block_t *block;
+    int i, ret;
+
+    for ( i = 0; i < c->num_blocks; i++ ) {
+        block = &c->blocks[i];
+        if ( -1 == block->offset || block->offset >= offset + (OMPI_MPI_OFFSET_TYPE) len ||
+             block->offset + (OMPI_MPI_OFFSET_TYPE) c->block_size <= offset ) {
+            continue;
+        }
+        ret = cache_block_flush (fh, c, block);
+        if ( OMPI_SUCCESS != ret ) {
+            return ret;
+        }
+        if ( invalidate ) {
+            cache_block_invalidate (block);
+        }
+    }
+    return OMPI_SUCCESS;
+}
+
+static ssize_t cache_write_piece (ompio_file_t *fh, mca_common_ompio_cache_t *c,
+                                  char *buf, OMPI_MPI_OFFSET_TYPE offset, size_t len)
+{
+    mca_common_ompio_cache_block_t *block;
+    OMPI_MPI_OFFSET_TYPE block_offset;
+    size_t start, end;
+    int ret;
+
+    block_offset = offset - (offset % c->block_size);
+    start = (size_t)(offset - block_offset);
+    end   = start + len;
+
+    block = cache_lookup (c, block_offset);
+    if ( NULL == block ) {
+        ret = cache_assign (fh, c, block_offset, &block);
+        if ( OMPI_SUCCESS != ret ) {
+            return ret;
+        }
+    }
+
+    if ( block->dirty_start != block->dirty_end &&
+         (end < block->dirty_start || start > block->dirty_end) ) {
+        ret = cache_block_flush (fh, c, block);
+        if ( OMPI_SUCCESS != ret ) {
+            return ret;
+        }
+    }
+
+    memcpy (block->buf + start, buf, len);
+
+    if ( block->dirty_start == block->dirty_end ) {
+        block->dirty_start = start;
+        block->dirty_end   = end;
+        c->dirty_bytes    += len;
+    }
+    else {
+        c->dirty_bytes -= block->dirty_end - block->dirty_start;
+        block->dirty_start = ( start < block->dirty_start ) ? start : block->dirty_start;
+        block->dirty_end   = ( end > block->dirty_end ) ? end : block->dirty_end;
+        c->dirty_bytes += block->dirty_end - block->dirty_start;
+    }
+
+    /* the modified range is always part of the valid range */
+    if ( block->valid_start == block->valid_end ||
+         end < block->valid_start || start > block->valid_end ) {
+        block->valid_start = block->dirty_start;
+        block->valid_end   = block->dirty_end;
+    }
+    else {
+        block->valid_start = ( start < block->valid_start ) ? start : block->valid_start;
+        block->valid_end   = ( end > block->valid_end ) ? end : block->valid_end;
+    }
+
+    return (ssize_t) len;
+}
+
+/*
+  Read a piece from the cache. Returns the number of bytes read, which
+  is smaller than len at the end of the file, or OMPI_ERR_NOT_FOUND if
+  the piece should be read from the file directly.
+*/
+static ssize_t cache_read_piece (ompio_file_t *fh, mca_common_ompio_cache_t *c,
+                                 char *buf, OMPI_MPI_OFFSET_TYPE offset, size_t len)
+{
+    mca_common_ompio_cache_block_t *block;
+    OMPI_MPI_OFFSET_TYPE block_offset;
+    size_t start, end;
+    ssize_t ret;
+
+    block_offset = offset - (offset % c->block_size);
+    start = (size_t)(offset - block_offset);
+    end   = start + len;
+
+    block = cache_lookup (c, block_offset);
+    if ( NULL == block || start < block->valid_start || end > block->valid_end ) {
+        if ( !(c->mode & OMPIO_CACHE_READS) || offset != c->last_read_end ) {
+            return OMPI_ERR_NOT_FOUND;
+        }
+
+        /* sequential access: load the entire block */
+        if ( NULL == block ) {
+            ret = cache_assign (fh, c, block_offset, &block);
+            if ( OMPI_SUCCESS != ret ) {
+                return ret;
+            }
+        }
+        else {
+            ret = cache_block_flush (fh, c, block);
+            if ( OMPI_SUCCESS != ret ) {
+                return ret;
+            }
+        }
+        ret = cache_block_op (fh, block, 0, c->block_size, false);
+        if ( 0 > ret ) {
+            cache_block_invalidate (block);
+            return ret;
+        }
+        block->valid_start = 0;
+        block->valid_end   = (size_t) ret;
+    }
+
+    if ( start >= block->valid_end ) {
+        /* end of file */
+        return 0;
+    }
+    if ( end > block->valid_end ) {
+        end = block->valid_end;
+    }
+    memcpy (buf, block->buf + start, end - start);
+
+    return (ssize_t)(end - start);
+}
+
+static ssize_t cache_op (ompio_file_t *fh, mca_common_ompio_cache_t *c, bool is_write)
+{
+    mca_common_ompio_io_array_t *io_array = fh->f_io_array;
+    OMPI_MPI_OFFSET_TYPE offset;
+    size_t len, piece;
+    ssize_t ret, total=0;
+    char *buf;
+    int i, direct_first=0;
+
+    for ( i = 0; i < fh->f_num_of_io_entries; i++ ) {
+        offset = (OMPI_MPI_OFFSET_TYPE)(intptr_t) io_array[i].offset;
+        len    = io_array[i].length;
+        buf    = (char *) io_array[i].memory_address;
+
+        if ( len < c->block_size ) {
+            /* the entries collected so far go first */
+            if ( direct_first < i ) {
+                ret = cache_direct_op (fh, &io_array[direct_first], i - direct_first, is_write);
+                if ( 0 > ret ) {
+                    return ret;
+                }
+                total += ret;
+            }
+            direct_first = i + 1;
+
+            /* a piece spans at most two blocks */
+            while ( 0 < len ) {
+                piece = c->block_size - (size_t)(offset % c->block_size);
+                if ( piece > len ) {
+                    piece = len;
+                }
+                if ( is_write ) {
+                    ret = cache_write_piece (fh, c, buf, offset, piece);
+                }
+                else {
+                    ret = cache_read_piece (fh, c, buf, offset, piece);
+                    if ( OMPI_ERR_NOT_FOUND == ret ) {
+                        ret = cache_evict_range (fh, c, offset, len, false);
+                        if ( OMPI_SUCCESS != ret ) {
+                            return ret;
+                        }
+                        /* read the remainder of the entry directly */
+                        mca_common_ompio_io_array_t entry;
+                        entry.memory_address = buf;
+                        entry.offset = (IOVBASE_TYPE *)(intptr_t) offset;
+                        entry.length = len;
+                        ret = cache_direct_op (fh, &entry, 1, false);
+                    }
+                }
+                if ( 0 > ret ) {
+                    return ret;
+                }
+                total += ret;
+                if ( !is_write ) {
+                    c->last_read_end = offset + ret;
+                }
+                if ( (size_t) ret < piece ) {
+                    /* end of file reached */
+                    break;
+                }
+                offset += ret;
+                buf    += ret;
+                len    -= ret;
+            }
+            continue;
+        }
+
+        /* bypass the cache, but data in the cache has to be written first */
+        ret = cache_evict_range (fh, c, offset, len, is_write);
+        if ( OMPI_SUCCESS != ret ) {
+            return ret;
+        }
+        if ( !is_write ) {
+            c->last_read_end = offset + len;
+        }
+    }
+
+    if ( direct_first < fh->f_num_of_io_entries ) {
+        ret = cache_direct_op (fh, &io_array[direct_first],
+                               fh->f_num_of_io_entries - direct_first, is_write);
+        if ( 0 > ret ) {
+            return ret;
+        }
+        total += ret;
+    }
+
+    if ( is_write && c->dirty_bytes > c->flush_threshold ) {
+        ret = mca_common_ompio_cache_flush (fh, false);
+        if ( OMPI_SUCCESS != ret ) {
+            return ret;
+        }
+    }
+
+    return total;
+}
+
+ssize_t mca_common_ompio_cache_preadv (ompio_file_t *fh)
+{
+    mca_common_ompio_cache_t *c = NULL;
+
+    if ( !fh->f_atomicity ) {
+        c = cache_get (fh);
+    }
+    if ( NULL == c ) {
+        return mca_common_ompio_sieve_preadv (fh);
+    }
+
+    return cache_op (fh, c, false);
+}
+
+ssize_t mca_common_ompio_cache_pwritev (ompio_file_t *fh)
+{
+    mca_common_ompio_cache_t *c = NULL;
+
+    if ( !fh->f_atomicity ) {
+        c = cache_get (fh);
+    }
+    if ( NULL == c || !(c->mode & OMPIO_CACHE_WRITES) ) {
+        if ( NULL != c ) {
+            /* keep cached read data consistent with our own writes */
+            int i, ret;
+
+            for ( i = 0; i < fh->f_num_of_io_entries; i++ ) {
+                ret = cache_evict_range (fh, c, (OMPI_MPI_OFFSET_TYPE)(intptr_t) fh->f_io_array[i].offset,
+                                         fh->f_io_array[i].length, true);
+                if ( OMPI_SUCCESS != ret ) {
+                    return ret;
+                }
+            }
+        }
+        return mca_common_ompio_sieve_pwritev (fh);
+    }
+
+    return cache_op (fh, c, true);
+}
+
+/*
+  Write back all modified data of the file. If invalidate is set, the
+  cache is emptied as well, e.g. before operations which do not go
+  through the cache or if data written by other processes has to become
+  visible.
+*/
+int mca_common_ompio_cache_flush (ompio_file_t *fh, bool invalidate)
+{
+    mca_common_ompio_cache_t *c = fh->f_cache;
+    int i, ret, err=OMPI_SUCCESS;
+
+    /* the decompressed chunk may be outdated after any sync point */
+    mca_common_ompio_compress_invalidate (fh);
+    if ( NULL == c ) {
+        return OMPI_SUCCESS;
+    }
+
+    for ( i = 0; i < c->num_blocks; i++ ) {
+        if ( -1 == c->blocks[i].offset ) {
+            continue;
+        }
+        ret = cache_block_flush (fh, c, &c->blocks[i]);
+        if ( OMPI_SUCCESS != ret ) {
+            err = ret;
+        }
+        if ( invalidate ) {
+            cache_block_invalidate (&c->blocks[i]);
+        }
+    }
+    if ( invalidate ) {
+        c->last_read_end = 0;
+    }
+
+    return err;
+}
+
+void mca_common_ompio_cache_free (ompio_file_t *fh)
+{
+    mca_common_ompio_cache_t *c = fh->f_cache;
+    int i;
+
+    if ( NULL == c ) {
+        return;
+    }
+
+    for ( i = 0; i < c->num_blocks; i++ ) {
+        free (c->blocks[i].buf);
+    }
+    free (c->blocks);
+    free (c);
+    fh->f_cache = NULL;
+}
@@ -0,0 +1,648 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ *  Copyright (c) 2026      The University of Tennessee and The University
+ *                          of Tennessee Research Foundation.  All rights
+ *                          reserved.
+ *  $COPYRIGHT$
+ *
+ *  Additional copyrights may follow
+ *
+ *  $HEADER$
+ */
+
+#include "ompi_config.h"
+
+#include "ompi/communicator/communicator.h"
+#include "ompi/mca/fbtl/fbtl.h"
+#include "ompi/mca/fs/fs.h"
+#include "common_ompio.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+
+/*
+  Transparent compression of the file data.
+
+  Requested by the ompio_compression hint when creating a file, and
+  detected from the file header when opening an existing file. The
+  logical file is cut into chunks of chunk_size bytes (the stripe size
+  if known, the compress_chunk_size parameter otherwise), and chunk k
+  is stored in a fixed slot of the physical file:
+
+    [file header | pad to OMPIO_COMPRESS_DATA_START]
+    [slot 0: chunk header, stored data | unused ] ...
+    [slot k at DATA_START + k * (chunk header + chunk_size)]
+
+  The chunk header records the codec, the logical length of the chunk
+  and the number of stored bytes. Chunks which do not compress are
+  stored raw, unused parts of the slots are holes of the physical file,
+  and slots which were never written read as zeros. Headers are in the
+  native byte order of the writer.
+
+  Chunks are always written as a whole. A write covering only part of
+  a chunk reads and decompresses the chunk, merges the new data and
+  writes it back while holding a write lock on the slot, where the file
+  system supports it. Collective writes are aligned to the chunks by
+  fcoll/vulcan, which then compresses on the aggregators only. The
+  decompressed copy of the last chunk accessed is kept for subsequent
+  reads of the same chunk, it is dropped at every sync point.
+
+  The bundled codec is a byte oriented LZ77 variant: a control byte c
+  is either followed by c+1 literals (c < 0x80), or by a two byte
+  little endian offset of a match of (c & 0x7f) + 4 bytes.
+*/
+
+#define OMPIO_COMPRESS_MAGIC       "OMPIOZ1"
+#define OMPIO_COMPRESS_CHUNK_MAGIC 0x4f4d5a43
+#define OMPIO_COMPRESS_VERSION     1
+#define OMPIO_COMPRESS_DATA_START  4096
+#define OMPIO_COMPRESS_MIN_CHUNK   4096
+
+#define OMPIO_CODEC_NONE           0
+#define OMPIO_CODEC_LZ             1
+
+typedef struct {
+    char     magic[8];
+    uint32_t version;
+    uint32_t codec;
+    uint64_t chunk_size;
+} mca_common_ompio_compress_file_hdr_t;
+
+typedef struct {
+    uint32_t magic;
+    uint32_t codec;
+    uint64_t length;    /* logical bytes of the chunk */
+    uint64_t stored;    /* bytes following the header */
+    uint64_t reserved;
+} mca_common_ompio_compress_chunk_hdr_t;
+
+#define LZ_MIN_MATCH     4
+#define LZ_MAX_MATCH     (LZ_MIN_MATCH + 0x7f)
+#define LZ_MAX_LITERALS  0x80
+#define LZ_MAX_OFFSET    0xffff
+#define LZ_HASH_BITS     14
+
+struct mca_common_ompio_compress_t {
+    int                   codec;
+    size_t                chunk_size;
+    size_t                slot_size;
+    /* decompressed copy of chunk_index, -1 if none */
+    OMPI_MPI_OFFSET_TYPE  chunk_index;
+    size_t                chunk_length;
+    char                 *chunk_buf;
+    /* chunk header followed by the stored data */
+    char                 *stored_buf;
+    uint32_t             *table;
+};
+typedef struct mca_common_ompio_compress_t mca_common_ompio_compress_t;
+
+/*
+ * Codec
+ */
+
+static bool lz_literals (const unsigned char *in, size_t len, unsigned char *out,
+                         size_t *op, size_t out_size)
+{
+    size_t run;
+
+    while ( len > 0 ) {
+        run = len < LZ_MAX_LITERALS ? len : LZ_MAX_LITERALS;
+        if ( *op + 1 + run > out_size ) {
+            return false;
+        }
+        out[(*op)++] = (unsigned char) (run - 1);
+        memcpy (out + *op, in, run);
+        *op += run;
+        in  += run;
+        len -= run;
+    }
+    return true;
+}
+
+/* Returns the compressed size, 0 if it would exceed out_size */
+static size_t lz_compress (const unsigned char *in, size_t n, unsigned char *out,
+                           size_t out_size, uint32_t *table)
+{
+    size_t ip = 0, op = 0, anchor = 0, ref, len, off;
+    uint32_t seq, h, misses = 0;
+
+    memset (table, 0, sizeof(uint32_t) << LZ_HASH_BITS);
+    while ( ip + LZ_MIN_MATCH <= n ) {
+        memcpy (&seq, in + ip, sizeof(seq));
+        h = (seq * 2654435761u) >> (32 - LZ_HASH_BITS);
+        ref = table[h];
+        table[h] = (uint32_t) ip + 1;
+        if ( 0 == ref || ip - (ref - 1) > LZ_MAX_OFFSET ||
+             0 != memcmp (in + ref - 1, in + ip, LZ_MIN_MATCH) ) {
+            /* skip faster through data which does not compress */
+            ip += 1 + (misses++ >> 6);
+            continue;
+        }
+        ref--;
+        misses = 0;
+        len = LZ_MIN_MATCH;
+        while ( ip + len < n && len < LZ_MAX_MATCH && in[ref + len] == in[ip + len] ) {
+            len++;
+        }
+        if ( !lz_literals (in + anchor, ip - anchor, out, &op, out_size) ||
+             op + 3 > out_size ) {
+            return 0;
+        }
+        off = ip - ref;
+        out[op++] = (unsigned char) (0x80 | (len - LZ_MIN_MATCH));
+        out[op++] = (unsigned char) (off & 0xff);
+        out[op++] = (unsigned char) (off >> 8);
+        ip += len;
+        anchor = ip;
+    }
+    if ( !lz_literals (in + anchor, n - anchor, out, &op, out_size) ) {
+        return 0;
+    }
+    return op;
+}
+
+static bool lz_decompress (const unsigned char *in, size_t n, unsigned char *out,
+                           size_t out_len)
+{
+    size_t ip = 0, op = 0, len, off, k;
+    unsigned char c;
+
+    while ( ip < n ) {
+        c = in[ip++];
+        if ( c & 0x80 ) {
+            if ( ip + 2 > n ) {
+                return false;
+            }
+            len = (c & 0x7f) + LZ_MIN_MATCH;
+            off = (size_t) in[ip] | ((size_t) in[ip+1] << 8);
+            ip += 2;
+            if ( 0 == off || off > op || op + len > out_len ) {
+                return false;
+            }
+            /* matches may overlap their own output */
+            for ( k = 0; k < len; k++ ) {
+                out[op + k] = out[op - off + k];
+            }
+            op += len;
+        }
+        else {
+            len = (size_t) c + 1;
+            if ( ip + len > n || op + len > out_len ) {
+                return false;
+            }
+            memcpy (out + op, in + ip, len);
+            ip += len;
+            op += len;
+        }
+    }
+    return op == out_len;
+}
+
+/*
+ * File access
+ */
+
+static ssize_t compress_fbtl_op (ompio_file_t *fh, void *buf, OMPI_MPI_OFFSET_TYPE offset,
+                                 size_t len, bool is_write)
+{
+    mca_common_ompio_io_array_t *saved_array = fh->f_io_array;
+    int saved_entries = fh->f_num_of_io_entries;
+    mca_common_ompio_io_array_t entry;
+    ssize_t ret;
+
+    entry.memory_address = buf;
+    entry.offset = (IOVBASE_TYPE *)(intptr_t) offset;
+    entry.length = len;
+
+    fh->f_io_array = &entry;
+    fh->f_num_of_io_entries = 1;
+    if ( is_write ) {
+        ret = fh->f_fbtl->fbtl_pwritev (fh);
+    }
+    else {
+        ret = fh->f_fbtl->fbtl_preadv (fh);
+    }
+    fh->f_io_array = saved_array;
+    fh->f_num_of_io_entries = saved_entries;
+
+    return ret;
+}
+
+static inline OMPI_MPI_OFFSET_TYPE compress_slot (mca_common_ompio_compress_t *c,
+                                                  OMPI_MPI_OFFSET_TYPE k)
+{
+    return OMPIO_COMPRESS_DATA_START + k * (OMPI_MPI_OFFSET_TYPE) c->slot_size;
+}
+
+static bool compress_lockable (ompio_file_t *fh)
+{
+    /* the fbtl releases any lock of the process when it locks the
+       entire file itself */
+    return !(fh->f_flags & OMPIO_LOCK_ENTIRE_FILE) &&
+        (UFS == fh->f_fstype || LUSTRE == fh->f_fstype || GPFS == fh->f_fstype);
+}
+
+static int compress_lock (ompio_file_t *fh, struct flock *lock, OMPI_MPI_OFFSET_TYPE start,
+                          size_t len)
+{
+    int ret;
+
+    lock->l_type   = F_WRLCK;
+    lock->l_whence = SEEK_SET;
+    lock->l_start  = (off_t) start;
+    lock->l_len    = (off_t) len;
+    do {
+        ret = fcntl (fh->fd, F_SETLKW, lock);
+    } while ( ret && EINTR == errno );
+
+    return ret;
+}
+
+static void compress_unlock (ompio_file_t *fh, struct flock *lock)
+{
+    lock->l_type = F_UNLCK;
+    fcntl (fh->fd, F_SETLK, lock);
+}
+
+/* Read and decompress chunk k into chunk_buf. A slot which was never
+   written holds zeros of length 0. */
+static int compress_load (ompio_file_t *fh, mca_common_ompio_compress_t *c,
+                          OMPI_MPI_OFFSET_TYPE k)
+{
+    mca_common_ompio_compress_chunk_hdr_t hdr;
+    ssize_t ret;
+
+    c->chunk_index = -1;
+    ret = compress_fbtl_op (fh, &hdr, compress_slot (c, k), sizeof(hdr), false);
+    if ( 0 > ret ) {
+        return (int) ret;
+    }
+    if ( (size_t) ret < sizeof(hdr) || OMPIO_COMPRESS_CHUNK_MAGIC != hdr.magic ) {
+        hdr.length = 0;
+    }
+    else {
+        if ( hdr.length > c->chunk_size || hdr.stored > c->chunk_size ||
+             (OMPIO_CODEC_NONE == hdr.codec && hdr.stored != hdr.length) ||
+             (OMPIO_CODEC_NONE != hdr.codec && OMPIO_CODEC_LZ != hdr.codec) ) {
+            goto corrupt;
+        }
+        ret = compress_fbtl_op (fh, c->stored_buf, compress_slot (c, k) + sizeof(hdr),
+                                hdr.stored, false);
+        if ( 0 > ret ) {
+            return (int) ret;
+        }
+        if ( (size_t) ret != hdr.stored ) {
+            goto corrupt;
+        }
+        if ( OMPIO_CODEC_NONE == hdr.codec ) {
+            memcpy (c->chunk_buf, c->stored_buf, hdr.length);
+        }
+        else if ( !lz_decompress ((unsigned char *) c->stored_buf, hdr.stored,
+                                  (unsigned char *) c->chunk_buf, hdr.length) ) {
+            goto corrupt;
+        }
+    }
+    memset (c->chunk_buf + hdr.length, 0, c->chunk_size - hdr.length);
+    c->chunk_index  = k;
+    c->chunk_length = hdr.length;
+    return OMPI_SUCCESS;
+
+ corrupt:
+    opal_output (1, "common_ompio: corrupted chunk %lld in compressed file %s\n",
+                 (long long) k, fh->f_filename);
+    return OMPI_ERROR;
+}
+
+/* Compress the first length bytes of chunk_buf and write them as chunk k */
+static int compress_store (ompio_file_t *fh, mca_common_ompio_compress_t *c,
+                           OMPI_MPI_OFFSET_TYPE k, size_t length)
+{
+    mca_common_ompio_compress_chunk_hdr_t hdr;
+    size_t stored = 0;
+    ssize_t ret;
+
+    if ( OMPIO_CODEC_LZ == c->codec && length > 0 ) {
+        stored = lz_compress ((unsigned char *) c->chunk_buf, length,
+                              (unsigned char *) c->stored_buf + sizeof(hdr),
+                              length - 1, c->table);
+    }
+    memset (&hdr, 0, sizeof(hdr));
+    hdr.magic  = OMPIO_COMPRESS_CHUNK_MAGIC;
+    hdr.length = length;
+    if ( 0 == stored ) {
+        hdr.codec = OMPIO_CODEC_NONE;
+        stored = length;
+        memcpy (c->stored_buf + sizeof(hdr), c->chunk_buf, length);
+    }
+    else {
+        hdr.codec = OMPIO_CODEC_LZ;
+    }
+    hdr.stored = stored;
+    memcpy (c->stored_buf, &hdr, sizeof(hdr));
+
+    ret = compress_fbtl_op (fh, c->stored_buf, compress_slot (c, k), sizeof(hdr) + stored, true);
+    if ( 0 > ret ) {
+        return (int) ret;
+    }
+    return (size_t) ret == sizeof(hdr) + stored ? OMPI_SUCCESS : OMPI_ERROR;
+}
+
+/*
+ * Interface
+ */
+
+bool mca_common_ompio_compress_requested (ompio_file_t *fh)
+{
+    char value[MPI_MAX_INFO_VAL];
+    int flag;
+
+    opal_info_get (fh->f_info, "ompio_compression", MPI_MAX_INFO_VAL, value, &flag);
+    return flag && 0 == strncmp (value, "lz", strlen("lz")+1);
+}
+
+int mca_common_ompio_compress_open (ompio_file_t *fh)
+{
+    mca_common_ompio_compress_file_hdr_t fhdr;
+    mca_common_ompio_compress_t *c;
+    char value[MPI_MAX_INFO_VAL];
+    OMPI_MPI_OFFSET_TYPE size;
+    long params[3] = {0, 0, 0};   /* codec + 1, chunk size, error */
+    bool requested = false;
+    int flag, ret;
+
+    if ( fh->f_amode & MPI_MODE_SEQUENTIAL ) {
+        return OMPI_SUCCESS;
+    }
+    opal_info_get (fh->f_info, "ompio_compression", MPI_MAX_INFO_VAL, value, &flag);
+    if ( flag ) {
+        requested = mca_common_ompio_compress_requested (fh);
+        OMPIO_MCA_PRINT_INFO(fh, "ompio_compression", value, "");
+    }
+    /* files created without the hint are assumed to be uncompressed */
+    if ( !requested && (fh->f_amode & MPI_MODE_CREATE) ) {
+        return OMPI_SUCCESS;
+    }
+
+    if ( 0 == fh->f_rank ) {
+        ret = compress_fbtl_op (fh, &fhdr, 0, sizeof(fhdr), false);
+        if ( (ssize_t) sizeof(fhdr) == ret &&
+             0 == memcmp (fhdr.magic, OMPIO_COMPRESS_MAGIC, sizeof(OMPIO_COMPRESS_MAGIC)) ) {
+            if ( OMPIO_COMPRESS_VERSION != fhdr.version || 0 == fhdr.chunk_size ||
+                 (OMPIO_CODEC_NONE != fhdr.codec && OMPIO_CODEC_LZ != fhdr.codec) ) {
+                opal_output (1, "common_ompio: unsupported compressed file %s\n", fh->f_filename);
+                params[2] = OMPI_ERR_NOT_SUPPORTED;
+            }
+            params[0] = fhdr.codec + 1;
+            params[1] = (long) fhdr.chunk_size;
+        }
+        else if ( requested && !(fh->f_amode & MPI_MODE_RDONLY) ) {
+            ret = fh->f_fs->fs_file_get_size (fh, &size);
+            if ( OMPI_SUCCESS == ret && 0 == size ) {
+                memset (&fhdr, 0, sizeof(fhdr));
+                memcpy (fhdr.magic, OMPIO_COMPRESS_MAGIC, sizeof(OMPIO_COMPRESS_MAGIC));
+                fhdr.version = OMPIO_COMPRESS_VERSION;
+                fhdr.codec = OMPIO_CODEC_LZ;
+                fhdr.chunk_size = fh->f_stripe_size > 0 ? (uint64_t) fh->f_stripe_size :
+                    (uint64_t) OMPIO_MCA_GET(fh, compress_chunk_size);
+                if ( fhdr.chunk_size < OMPIO_COMPRESS_MIN_CHUNK ) {
+                    fhdr.chunk_size = OMPIO_COMPRESS_MIN_CHUNK;
+                }
+                if ( (ssize_t) sizeof(fhdr) != compress_fbtl_op (fh, &fhdr, 0, sizeof(fhdr), true) ) {
+                    params[2] = OMPI_ERROR;
+                }
+                params[0] = fhdr.codec + 1;
+                params[1] = (long) fhdr.chunk_size;
+            }
+            else if ( OMPI_SUCCESS == ret ) {
+                OMPIO_MCA_PRINT_INFO(fh, "ompio_compression", value,
+                                     "ignored, file is not empty");
+            }
+        }
+    }
+    ret = fh->f_comm->c_coll->coll_bcast (params, 3, MPI_LONG, 0, fh->f_comm,
+                                          fh->f_comm->c_coll->coll_bcast_module);
+    if ( OMPI_SUCCESS != ret ) {
+        return ret;
+    }
+    if ( OMPI_SUCCESS != params[2] ) {
+        return (int) params[2];
+    }
+    if ( 0 == params[0] ) {
+        return OMPI_SUCCESS;
+    }
+
+    c = (mca_common_ompio_compress_t *) calloc (1, sizeof(mca_common_ompio_compress_t));
+    if ( NULL == c ) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+    c->codec        = (int) params[0] - 1;
+    c->chunk_size   = (size_t) params[1];
+    c->slot_size    = sizeof(mca_common_ompio_compress_chunk_hdr_t) + c->chunk_size;
+    c->chunk_index  = -1;
+    c->chunk_buf    = (char *) malloc (c->chunk_size);
+    c->stored_buf   = (char *) malloc (c->slot_size);
+    c->table        = (uint32_t *) malloc (sizeof(uint32_t) << LZ_HASH_BITS);
+    fh->f_compress  = c;
+    if ( NULL == c->chunk_buf || NULL == c->stored_buf || NULL == c->table ) {
+        mca_common_ompio_compress_free (fh);
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+
+    return OMPI_SUCCESS;
+}
+
+ssize_t mca_common_ompio_compress_pwritev (ompio_file_t *fh)
+{
+    mca_common_ompio_compress_t *c = fh->f_compress;
+    OMPI_MPI_OFFSET_TYPE off, k, cur = -1;
+    size_t len, pos, piece, cur_len = 0;
+    ssize_t total = 0;
+    struct flock lock;
+    bool locked = false;
+    char *mem;
+    int i, ret = OMPI_SUCCESS;
+
+    for ( i = 0; i < fh->f_num_of_io_entries; i++ ) {
+        off = (OMPI_MPI_OFFSET_TYPE)(intptr_t) fh->f_io_array[i].offset;
+        len = fh->f_io_array[i].length;
+        mem = (char *) fh->f_io_array[i].memory_address;
+        while ( len > 0 ) {
+            k     = off / (OMPI_MPI_OFFSET_TYPE) c->chunk_size;
+            pos   = (size_t) (off % (OMPI_MPI_OFFSET_TYPE) c->chunk_size);
+            piece = c->chunk_size - pos < len ? c->chunk_size - pos : len;
+            if ( k != cur ) {
+                if ( -1 != cur ) {
+                    ret = compress_store (fh, c, cur, cur_len);
+                    if ( locked ) {
+                        compress_unlock (fh, &lock);
+                        locked = false;
+                    }
+                    if ( OMPI_SUCCESS != ret ) {
+                        goto exit;
+                    }
+                }
+                cur = k;
+                if ( 0 == pos && piece == c->chunk_size ) {
+                    c->chunk_index = -1;
+                    cur_len = 0;
+                }
+                else {
+                    /* read-modify-write of the chunk. Other processes may
+                       have written disjoint parts of it since it was
+                       cached, the cache is therefore only used by reads. */
+                    if ( compress_lockable (fh) ) {
+                        if ( compress_lock (fh, &lock, compress_slot (c, k), c->slot_size) ) {
+                            opal_output (1, "common_ompio: could not lock chunk of %s, errno %d\n",
+                                         fh->f_filename, errno);
+                            ret = OMPI_ERROR;
+                            goto exit;
+                        }
+                        locked = true;
+                    }
+                    ret = compress_load (fh, c, k);
+                    if ( OMPI_SUCCESS != ret ) {
+                        goto exit;
+                    }
+                    cur_len = c->chunk_length;
+                    c->chunk_index = -1;
+                }
+            }
+            memcpy (c->chunk_buf + pos, mem, piece);
+            if ( pos + piece > cur_len ) {
+                cur_len = pos + piece;
+            }
+            off += piece;
+            mem += piece;
+            len -= piece;
+        }
+        total += fh->f_io_array[i].length;
+    }
+    if ( -1 != cur ) {
+        ret = compress_store (fh, c, cur, cur_len);
+        if ( OMPI_SUCCESS == ret ) {
+            c->chunk_index  = cur;
+            c->chunk_length = cur_len;
+        }
+    }
+
+ exit:
+    if ( locked ) {
+        compress_unlock (fh, &lock);
+    }
+    return OMPI_SUCCESS == ret ? total : ret;
+}
+
+ssize_t mca_common_ompio_compress_preadv (ompio_file_t *fh)
+{
+    mca_common_ompio_compress_t *c = fh->f_compress;
+    OMPI_MPI_OFFSET_TYPE off, k, eof = -1;
+    size_t len, pos, piece;
+    ssize_t total = 0;
+    char *mem;
+    int i, ret;
+
+    for ( i = 0; i < fh->f_num_of_io_entries; i++ ) {
+        off = (OMPI_MPI_OFFSET_TYPE)(intptr_t) fh->f_io_array[i].offset;
+        len = fh->f_io_array[i].length;
+        mem = (char *) fh->f_io_array[i].memory_address;
+        while ( len > 0 ) {
+            k     = off / (OMPI_MPI_OFFSET_TYPE) c->chunk_size;
+            pos   = (size_t) (off % (OMPI_MPI_OFFSET_TYPE) c->chunk_size);
+            piece = c->chunk_size - pos < len ? c->chunk_size - pos : len;
+            if ( k != c->chunk_index ) {
+                ret = compress_load (fh, c, k);
+                if ( OMPI_SUCCESS != ret ) {
+                    return ret;
+                }
+            }
+            memcpy (mem, c->chunk_buf + pos, piece);
+            if ( pos + piece <= c->chunk_length ) {
+                total += piece;
+            }
+            else {
+                /* zeros are data only up to the end of the file */
+                if ( -1 == eof ) {
+                    ret = mca_common_ompio_compress_get_size (fh, &eof);
+                    if ( OMPI_SUCCESS != ret ) {
+                        return ret;
+                    }
+                }
+                if ( eof > off ) {
+                    total += (eof - off < (OMPI_MPI_OFFSET_TYPE) piece) ? (ssize_t) (eof - off) :
+                        (ssize_t) piece;
+                }
+            }
+            off += piece;
+            mem += piece;
+            len -= piece;
+        }
+    }
+
+    return total;
+}
+
+int mca_common_ompio_compress_get_size (ompio_file_t *fh, OMPI_MPI_OFFSET_TYPE *size)
+{
+    mca_common_ompio_compress_t *c = fh->f_compress;
+    mca_common_ompio_compress_chunk_hdr_t hdr;
+    OMPI_MPI_OFFSET_TYPE phys, k;
+    ssize_t ret;
+
+    ret = fh->f_fs->fs_file_get_size (fh, &phys);
+    if ( OMPI_SUCCESS != ret ) {
+        return (int) ret;
+    }
+    if ( phys <= OMPIO_COMPRESS_DATA_START ) {
+        *size = 0;
+        return OMPI_SUCCESS;
+    }
+    /* the last slot holding data determines the logical size */
+    k = (phys - OMPIO_COMPRESS_DATA_START - 1) / (OMPI_MPI_OFFSET_TYPE) c->slot_size;
+    ret = compress_fbtl_op (fh, &hdr, compress_slot (c, k), sizeof(hdr), false);
+    if ( 0 > ret ) {
+        return (int) ret;
+    }
+    *size = k * (OMPI_MPI_OFFSET_TYPE) c->chunk_size;
+    if ( (size_t) ret == sizeof(hdr) && OMPIO_COMPRESS_CHUNK_MAGIC == hdr.magic ) {
+        *size += (OMPI_MPI_OFFSET_TYPE) hdr.length;
+    }
+
+    return OMPI_SUCCESS;
+}
+
+int mca_common_ompio_compress_set_size (ompio_file_t *fh, OMPI_MPI_OFFSET_TYPE size)
+{
+    /* only truncating the file is supported, its header stays */
+    if ( 0 != size ) {
+        return MPI_ERR_UNSUPPORTED_OPERATION;
+    }
+    mca_common_ompio_compress_invalidate (fh);
+    return fh->f_fs->fs_file_set_size (fh, OMPIO_COMPRESS_DATA_START);
+}
+
+size_t mca_common_ompio_compress_chunk_size (ompio_file_t *fh)
+{
+    return NULL == fh->f_compress ? 0 : fh->f_compress->chunk_size;
+}
+
+void mca_common_ompio_compress_invalidate (ompio_file_t *fh)
+{
+    if ( NULL != fh->f_compress ) {
+        fh->f_compress->chunk_index = -1;
+    }
+}
+
+void mca_common_ompio_compress_free (ompio_file_t *fh)
+{
+    mca_common_ompio_compress_t *c = fh->f_compress;
+
+    if ( NULL == c ) {
+        return;
+    }
+    free (c->chunk_buf);
+    free (c->stored_buf);
+    free (c->table);
+    free (c);
+    fh->f_compress = NULL;
+}
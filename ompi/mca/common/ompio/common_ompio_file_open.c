@@ -110,8 +110,11 @@ int mca_common_ompio_file_open (ompi_communicator_t *comm,
     mca_common_ompio_initialize_print_queue(&ompio_fh->f_coll_read_time);
 
     /* This fix is needed for data seiving to work with
-       two-phase collective I/O */
-    if ( OMPIO_MCA_GET(ompio_fh, overwrite_amode) && !(amode & MPI_MODE_SEQUENTIAL) ) {
+       two-phase collective I/O, and for the read-modify-write of
+       compressed chunks */
+    if ( ( OMPIO_MCA_GET(ompio_fh, overwrite_amode) ||
+           mca_common_ompio_compress_requested (ompio_fh) ) &&
+         !(amode & MPI_MODE_SEQUENTIAL) ) {
 
         if ((amode & MPI_MODE_WRONLY)){
             amode -= MPI_MODE_WRONLY;
@@ -126,6 +129,7 @@ int mca_common_ompio_file_open (ompi_communicator_t *comm,
         opal_output(1, "mca_fs_base_file_select() failed\n");
         goto fn_fail;
     }
+    ompio_fh->f_fbtl_data = NULL;
     if (OMPI_SUCCESS != (ret = mca_fbtl_base_file_select (ompio_fh,
                                                           NULL))) {
         opal_output(1, "mca_fbtl_base_file_select() failed\n");
@@ -136,6 +140,15 @@ int mca_common_ompio_file_open (ompi_communicator_t *comm,
     ompio_fh->f_sharedfp_component = NULL; /*component*/
     ompio_fh->f_sharedfp           = NULL; /*module*/
     ompio_fh->f_sharedfp_data      = NULL; /*data*/
+    ompio_fh->f_fcoll              = NULL;
+    ompio_fh->f_fcoll_data         = NULL;
+    ompio_fh->f_cache              = NULL;
+    ompio_fh->f_compress           = NULL;
+    ompio_fh->f_stats              = NULL;
+    if ( use_sharedfp ) {
+        /* only the files of the application, not the internal ones */
+        mca_common_ompio_stats_init (ompio_fh);
+    }
 
     if ( true == use_sharedfp ) {
 	if (OMPI_SUCCESS != (ret = mca_sharedfp_base_file_select (ompio_fh, NULL))) {
@@ -183,6 +196,11 @@ int mca_common_ompio_file_open (ompi_communicator_t *comm,
 	}
     }
 
+    ret = mca_common_ompio_compress_open (ompio_fh);
+    if ( OMPI_SUCCESS != ret ) {
+        goto fn_fail;
+    }
+
     /* Set default file view */
     mca_common_ompio_set_view(ompio_fh,
                               0,
@@ -199,8 +217,7 @@ int mca_common_ompio_file_open (ompi_communicator_t *comm,
         OMPI_MPI_OFFSET_TYPE current_size;
         mca_sharedfp_base_module_t * shared_fp_base_module;
 
-        ompio_fh->f_fs->fs_file_get_size( ompio_fh,
-                                          &current_size);
+        mca_common_ompio_file_get_size (ompio_fh, &current_size);
         mca_common_ompio_set_explicit_offset (ompio_fh, current_size);
         if ( true == use_sharedfp ) {
             if ( NULL != ompio_fh->f_sharedfp ) {
@@ -231,10 +248,14 @@ int mca_common_ompio_file_open (ompi_communicator_t *comm,
 
 int mca_common_ompio_file_close (ompio_file_t *ompio_fh)
 {
-    int ret = OMPI_SUCCESS;
+    int ret = OMPI_SUCCESS, flush_ret;
     int delete_flag = 0;
     char name[256];
 
+    /* write back the cached data before the other processes
+       can assume that the data is in the file */
+    flush_ret = mca_common_ompio_cache_flush (ompio_fh, true);
+
     ret = ompio_fh->f_comm->c_coll->coll_barrier ( ompio_fh->f_comm, ompio_fh->f_comm->c_coll->coll_barrier_module);
     if ( OMPI_SUCCESS != ret ) {
         /* Not sure what to do */
@@ -264,6 +285,10 @@ int mca_common_ompio_file_close (ompio_file_t *ompio_fh)
             }
         }
     }
+    ret = mca_common_ompio_stats_report (ompio_fh);
+    if ( OMPI_SUCCESS != ret ) {
+        opal_output (1, "mca_common_ompio_file_close: error in stats_report\n");
+    }
     if ( ompio_fh->f_amode & MPI_MODE_DELETE_ON_CLOSE ) {
         delete_flag = 1;
     }
@@ -296,6 +321,9 @@ int mca_common_ompio_file_close (ompio_file_t *ompio_fh)
     if ( NULL != ompio_fh->f_sharedfp)  {
 	mca_sharedfp_base_file_unselect (ompio_fh);
     }
+    mca_common_ompio_cache_free (ompio_fh);
+    mca_common_ompio_compress_free (ompio_fh);
+    mca_common_ompio_stats_free (ompio_fh);
 
     if (NULL != ompio_fh->f_io_array) {
         free (ompio_fh->f_io_array);
@@ -372,6 +400,9 @@ int mca_common_ompio_file_close (ompio_file_t *ompio_fh)
         ompi_comm_free (&ompio_fh->f_comm);
     }
 
+    if ( OMPI_SUCCESS != flush_ret ) {
+        return flush_ret;
+    }
     return ret;
 }
 
@@ -380,7 +411,17 @@ int mca_common_ompio_file_get_size (ompio_file_t *ompio_fh,
 {
     int ret = OMPI_SUCCESS;
 
-    ret = ompio_fh->f_fs->fs_file_get_size (ompio_fh, size);
+    /* data cached beyond the end of the file extends it */
+    ret = mca_common_ompio_cache_flush (ompio_fh, false);
+    if ( OMPI_SUCCESS != ret ) {
+        return ret;
+    }
+    if ( NULL != ompio_fh->f_compress ) {
+        ret = mca_common_ompio_compress_get_size (ompio_fh, size);
+    }
+    else {
+        ret = ompio_fh->f_fs->fs_file_get_size (ompio_fh, size);
+    }
 
     return ret;
 }
@@ -457,6 +498,8 @@ int mca_common_ompio_set_file_defaults (ompio_file_t *fh)
        /* Default file View */
        fh->f_iov_type = MPI_DATATYPE_NULL;
        fh->f_stripe_size = 0;
+       fh->f_stripe_count = 1;
+       fh->f_stripe_offset = 0;
        /*Decoded iovec of the file-view*/
        fh->f_decoded_iov = NULL;
        fh->f_etype = MPI_DATATYPE_NULL;
@@ -53,11 +53,11 @@
 ** ompio_file_t structure.
 */
 
-int mca_common_ompio_file_read (ompio_file_t *fh,
-			      void *buf,
-			      int count,
-			      struct ompi_datatype_t *datatype,
-			      ompi_status_public_t *status)
+static int file_read (ompio_file_t *fh,
+                      void *buf,
+                      int count,
+                      struct ompi_datatype_t *datatype,
+                      ompi_status_public_t *status)
 {
     int ret = OMPI_SUCCESS;
 
@@ -72,6 +72,7 @@ int mca_common_ompio_file_read (ompio_file_t *fh,
     size_t max_data=0, real_bytes_read=0;
     size_t spc=0;
     ssize_t ret_code=0;
+    uint64_t io_start;
     int i = 0; /* index into the decoded iovec of the buffer */
     int j = 0; /* index into the file vie iovec */
 
@@ -168,7 +169,14 @@ int mca_common_ompio_file_read (ompio_file_t *fh,
                                           &fh->f_num_of_io_entries);
 
         if (fh->f_num_of_io_entries) {
-            ret_code = fh->f_fbtl->fbtl_preadv (fh);
+            io_start = mca_common_ompio_stats_time (fh);
+            if ( NULL != fh->f_compress ) {
+                ret_code = mca_common_ompio_compress_preadv (fh);
+            }
+            else {
+                ret_code = mca_common_ompio_cache_preadv (fh);
+            }
+            mca_common_ompio_stats_phase (fh, OMPIO_STATS_IO, io_start);
             if ( 0<= ret_code ) {
                 real_bytes_read+=(size_t)ret_code;
             }
@@ -201,6 +209,26 @@ int mca_common_ompio_file_read (ompio_file_t *fh,
     return ret;
 }
 
+int mca_common_ompio_file_read (ompio_file_t *fh,
+                                void *buf,
+                                int count,
+                                struct ompi_datatype_t *datatype,
+                                ompi_status_public_t *status)
+{
+    ompi_status_public_t local_status;
+    uint64_t start;
+    int ret;
+
+    if ( MPI_STATUS_IGNORE == status ) {
+        status = &local_status;
+    }
+    start = mca_common_ompio_stats_begin (fh);
+    ret = file_read (fh, buf, count, datatype, status);
+    mca_common_ompio_stats_end (fh, false, OMPI_SUCCESS == ret ? status->_ucount : 0, start);
+
+    return ret;
+}
+
 int mca_common_ompio_file_read_at (ompio_file_t *fh,
 				 OMPI_MPI_OFFSET_TYPE offset,
 				 void *buf,
@@ -229,11 +257,11 @@ int mca_common_ompio_file_read_at (ompio_file_t *fh,
 }
 
 
-int mca_common_ompio_file_iread (ompio_file_t *fh,
-			       void *buf,
-			       int count,
-			       struct ompi_datatype_t *datatype,
-			       ompi_request_t **request)
+static int file_iread (ompio_file_t *fh,
+                       void *buf,
+                       int count,
+                       struct ompi_datatype_t *datatype,
+                       ompi_request_t **request)
 {
     int ret = OMPI_SUCCESS;
     mca_ompio_request_t *ompio_req=NULL;
@@ -245,6 +273,12 @@ int mca_common_ompio_file_iread (ompio_file_t *fh,
       return ret;
     }
 
+    /* nonblocking operations bypass the cache */
+    ret = mca_common_ompio_cache_flush (fh, false);
+    if ( OMPI_SUCCESS != ret ) {
+        return ret;
+    }
+
     mca_common_ompio_request_alloc ( &ompio_req, MCA_OMPIO_REQUEST_READ);
 
     if ( 0 == count ) {
@@ -256,7 +290,7 @@ int mca_common_ompio_file_iread (ompio_file_t *fh,
         return OMPI_SUCCESS;
     }
 
-    if ( NULL != fh->f_fbtl->fbtl_ipreadv ) {
+    if ( NULL != fh->f_fbtl->fbtl_ipreadv && NULL == fh->f_compress ) {
         // This fbtl has support for non-blocking operations
 
         size_t total_bytes_read = 0;       /* total bytes that have been read*/
@@ -370,6 +404,24 @@ int mca_common_ompio_file_iread (ompio_file_t *fh,
 }
 
 
+int mca_common_ompio_file_iread (ompio_file_t *fh,
+                                 void *buf,
+                                 int count,
+                                 struct ompi_datatype_t *datatype,
+                                 ompi_request_t **request)
+{
+    uint64_t start;
+    size_t size;
+    int ret;
+
+    start = mca_common_ompio_stats_begin (fh);
+    ret = file_iread (fh, buf, count, datatype, request);
+    ompi_datatype_type_size (datatype, &size);
+    mca_common_ompio_stats_end (fh, false, OMPI_SUCCESS == ret ? size * count : 0, start);
+
+    return ret;
+}
+
 int mca_common_ompio_file_iread_at (ompio_file_t *fh,
 				  OMPI_MPI_OFFSET_TYPE offset,
 				  void *buf,
@@ -409,8 +461,14 @@ int mca_common_ompio_file_read_all (ompio_file_t *fh,
                                     struct ompi_datatype_t *datatype,
                                     ompi_status_public_t * status)
 {
-    int ret = OMPI_SUCCESS;
+    int ret = OMPI_SUCCESS, flush_ret;
+    uint64_t start;
+    size_t size;
 
+    start = mca_common_ompio_stats_begin (fh);
+    /* collective operations do not use the cache. Do not leave
+       the collective on error, this would block the others. */
+    flush_ret = mca_common_ompio_cache_flush (fh, false);
 
     if ( !( fh->f_flags & OMPIO_DATAREP_NATIVE ) &&
          !(datatype == &ompi_mpi_byte.dt  ||
@@ -456,6 +514,11 @@ int mca_common_ompio_file_read_all (ompio_file_t *fh,
                                                 datatype,
                                                 status);
     }
+    if ( OMPI_SUCCESS == ret ) {
+        ret = flush_ret;
+    }
+    ompi_datatype_type_size (datatype, &size);
+    mca_common_ompio_stats_end (fh, false, OMPI_SUCCESS == ret ? size * count : 0, start);
     return ret;
 }
 
@@ -487,7 +550,12 @@ int mca_common_ompio_file_iread_all (ompio_file_t *fp,
                                      struct ompi_datatype_t *datatype,
                                      ompi_request_t **request)
 {
-    int ret = OMPI_SUCCESS;
+    int ret = OMPI_SUCCESS, flush_ret;
+    uint64_t start;
+    size_t size;
+
+    start = mca_common_ompio_stats_begin (fp);
+    flush_ret = mca_common_ompio_cache_flush (fp, false);
 
     if ( NULL != fp->f_fcoll->fcoll_file_iread_all ) {
 	ret = fp->f_fcoll->fcoll_file_iread_all (fp,
@@ -503,6 +571,11 @@ int mca_common_ompio_file_iread_all (ompio_file_t *fp,
 	ret = mca_common_ompio_file_iread ( fp, buf, count, datatype, request );
     }
 
+    if ( OMPI_SUCCESS == ret ) {
+        ret = flush_ret;
+    }
+    ompi_datatype_type_size (datatype, &size);
+    mca_common_ompio_stats_end (fp, false, OMPI_SUCCESS == ret ? size * count : 0, start);
     return ret;
 }
 
@@ -328,6 +328,19 @@ int mca_common_ompio_set_view (ompio_file_t *fh,
         /* user requested using an info object to disable collective buffering. */
         preferred = mca_fcoll_base_component_lookup ("individual");
     }
+    else if ( NULL != fh->f_compress ) {
+        /* vulcan aligns its file domains to the compressed chunks, all
+           other components would compete for the chunks */
+        preferred = mca_fcoll_base_component_lookup ("vulcan");
+        if ( NULL == preferred ) {
+            preferred = mca_fcoll_base_component_lookup ("individual");
+        }
+    }
+    if ( NULL != fh->f_fcoll ) {
+        /* give the previously selected module a chance to release
+           its per file data */
+        mca_fcoll_base_file_unselect (fh);
+    }
     ret = mca_fcoll_base_file_select (fh, (mca_base_component_t *)preferred);
     if ( OMPI_SUCCESS != ret ) {
         opal_output(1, "mca_common_ompio_set_view: mca_fcoll_base_file_select() failed\n");
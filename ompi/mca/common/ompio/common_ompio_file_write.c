@@ -35,11 +35,11 @@
 #include <unistd.h>
 #include <math.h>
 
-int mca_common_ompio_file_write (ompio_file_t *fh,
-			       const void *buf,
-			       int count,
-			       struct ompi_datatype_t *datatype,
-			       ompi_status_public_t *status)
+static int file_write (ompio_file_t *fh,
+                       const void *buf,
+                       int count,
+                       struct ompi_datatype_t *datatype,
+                       ompi_status_public_t *status)
 {
     int ret = OMPI_SUCCESS;
     int index = 0;
@@ -51,6 +51,7 @@ int mca_common_ompio_file_write (ompio_file_t *fh,
     size_t total_bytes_written = 0;
     size_t max_data=0, real_bytes_written=0;
     ssize_t ret_code=0;
+    uint64_t io_start;
     size_t spc=0;
     int i = 0; /* index into the decoded iovec of the buffer */
     int j = 0; /* index into the file view iovec */
@@ -151,7 +152,14 @@ int mca_common_ompio_file_write (ompio_file_t *fh,
                                           &fh->f_num_of_io_entries);
 
         if (fh->f_num_of_io_entries) {
-            ret_code =fh->f_fbtl->fbtl_pwritev (fh);
+            io_start = mca_common_ompio_stats_time (fh);
+            if ( NULL != fh->f_compress ) {
+                ret_code = mca_common_ompio_compress_pwritev (fh);
+            }
+            else {
+                ret_code = mca_common_ompio_cache_pwritev (fh);
+            }
+            mca_common_ompio_stats_phase (fh, OMPIO_STATS_IO, io_start);
             if ( 0<= ret_code ) {
                 real_bytes_written+= (size_t)ret_code;
             }
@@ -181,6 +189,26 @@ int mca_common_ompio_file_write (ompio_file_t *fh,
     return ret;
 }
 
+int mca_common_ompio_file_write (ompio_file_t *fh,
+                                 const void *buf,
+                                 int count,
+                                 struct ompi_datatype_t *datatype,
+                                 ompi_status_public_t *status)
+{
+    ompi_status_public_t local_status;
+    uint64_t start;
+    int ret;
+
+    if ( MPI_STATUS_IGNORE == status ) {
+        status = &local_status;
+    }
+    start = mca_common_ompio_stats_begin (fh);
+    ret = file_write (fh, buf, count, datatype, status);
+    mca_common_ompio_stats_end (fh, true, OMPI_SUCCESS == ret ? status->_ucount : 0, start);
+
+    return ret;
+}
+
 int mca_common_ompio_file_write_at (ompio_file_t *fh,
 				  OMPI_MPI_OFFSET_TYPE offset,
 				  const void *buf,
@@ -205,11 +233,11 @@ int mca_common_ompio_file_write_at (ompio_file_t *fh,
     return ret;
 }
 
-int mca_common_ompio_file_iwrite (ompio_file_t *fh,
-				const void *buf,
-				int count,
-				struct ompi_datatype_t *datatype,
-				ompi_request_t **request)
+static int file_iwrite (ompio_file_t *fh,
+                        const void *buf,
+                        int count,
+                        struct ompi_datatype_t *datatype,
+                        ompi_request_t **request)
 {
     int ret = OMPI_SUCCESS;
     mca_ompio_request_t *ompio_req=NULL;
@@ -220,7 +248,13 @@ int mca_common_ompio_file_iwrite (ompio_file_t *fh,
         ret = MPI_ERR_READ_ONLY;
       return ret;
     }
-    
+
+    /* nonblocking operations bypass the cache */
+    ret = mca_common_ompio_cache_flush (fh, true);
+    if ( OMPI_SUCCESS != ret ) {
+        return ret;
+    }
+
     mca_common_ompio_request_alloc ( &ompio_req, MCA_OMPIO_REQUEST_WRITE);
 
     if ( 0 == count ) {
@@ -232,7 +266,7 @@ int mca_common_ompio_file_iwrite (ompio_file_t *fh,
         return OMPI_SUCCESS;
     }
 
-    if ( NULL != fh->f_fbtl->fbtl_ipwritev ) {
+    if ( NULL != fh->f_fbtl->fbtl_ipwritev && NULL == fh->f_compress ) {
         /* This fbtl has support for non-blocking operations */
         
         uint32_t iov_count = 0;
@@ -347,6 +381,24 @@ int mca_common_ompio_file_iwrite (ompio_file_t *fh,
     return ret;
 }
 
+int mca_common_ompio_file_iwrite (ompio_file_t *fh,
+                                  const void *buf,
+                                  int count,
+                                  struct ompi_datatype_t *datatype,
+                                  ompi_request_t **request)
+{
+    uint64_t start;
+    size_t size;
+    int ret;
+
+    start = mca_common_ompio_stats_begin (fh);
+    ret = file_iwrite (fh, buf, count, datatype, request);
+    ompi_datatype_type_size (datatype, &size);
+    mca_common_ompio_stats_end (fh, true, OMPI_SUCCESS == ret ? size * count : 0, start);
+
+    return ret;
+}
+
 int mca_common_ompio_file_iwrite_at (ompio_file_t *fh,
 				   OMPI_MPI_OFFSET_TYPE offset,
 				   const void *buf,
@@ -386,8 +438,15 @@ int mca_common_ompio_file_write_all (ompio_file_t *fh,
                                      struct ompi_datatype_t *datatype,
                                      ompi_status_public_t *status)
 {
-    int ret = OMPI_SUCCESS;
-    
+    int ret = OMPI_SUCCESS, flush_ret;
+    uint64_t start;
+    size_t size;
+
+    start = mca_common_ompio_stats_begin (fh);
+    /* collective operations do not use the cache. Do not leave
+       the collective on error, this would block the others. */
+    flush_ret = mca_common_ompio_cache_flush (fh, true);
+
     if ( !( fh->f_flags & OMPIO_DATAREP_NATIVE ) &&
          !(datatype == &ompi_mpi_byte.dt  ||
            datatype == &ompi_mpi_char.dt   )) {
@@ -434,6 +493,11 @@ int mca_common_ompio_file_write_all (ompio_file_t *fh,
                                                  datatype,
                                                  status);
     }
+    if ( OMPI_SUCCESS == ret ) {
+        ret = flush_ret;
+    }
+    ompi_datatype_type_size (datatype, &size);
+    mca_common_ompio_stats_end (fh, true, OMPI_SUCCESS == ret ? size * count : 0, start);
     return ret;
 }
 
@@ -465,7 +529,12 @@ int mca_common_ompio_file_iwrite_all (ompio_file_t *fp,
                                       struct ompi_datatype_t *datatype,
                                       ompi_request_t **request)
 {
-    int ret = OMPI_SUCCESS;
+    int ret = OMPI_SUCCESS, flush_ret;
+    uint64_t start;
+    size_t size;
+
+    start = mca_common_ompio_stats_begin (fp);
+    flush_ret = mca_common_ompio_cache_flush (fp, true);
 
     if ( NULL != fp->f_fcoll->fcoll_file_iwrite_all ) {
 	ret = fp->f_fcoll->fcoll_file_iwrite_all (fp,
@@ -481,6 +550,11 @@ int mca_common_ompio_file_iwrite_all (ompio_file_t *fp,
 	ret = mca_common_ompio_file_iwrite ( fp, buf, count, datatype, request );
     }
 
+    if ( OMPI_SUCCESS == ret ) {
+        ret = flush_ret;
+    }
+    ompi_datatype_type_size (datatype, &size);
+    mca_common_ompio_stats_end (fp, true, OMPI_SUCCESS == ret ? size * count : 0, start);
     return ret;
 }
 
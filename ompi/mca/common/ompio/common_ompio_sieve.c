@@ -0,0 +1,385 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ *  Copyright (c) 2026      The University of Tennessee and The University
+ *                          of Tennessee Research Foundation.  All rights
+ *                          reserved.
+ *  $COPYRIGHT$
+ *
+ *  Additional copyrights may follow
+ *
+ *  $HEADER$
+ */
+
+#include "ompi_config.h"
+
+#include "ompi/mca/fbtl/fbtl.h"
+#include "common_ompio.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+
+/*
+  Data sieving for the independent read and write operations.
+
+  The io_array built for one cycle of an individual operation is split
+  into windows of entries which are in increasing file order and whose
+  covering extent fits into the sieve buffer. A window is sieved if it
+  contains more than one entry and the holes between the entries do not
+  exceed sieve_max_hole_ratio percent of the extent. Everything else is
+  handed to the fbtl unchanged.
+
+  Reads access the covering extent with a single operation and extract
+  the pieces. Writes do a read-modify-write of the extent while holding
+  a write lock on it. The entries of a sieving write which are not
+  sieved are written under a lock of their covering range as well,
+  since the fs may not lock them at all. The locks only protect against
+  other processes which lock the same range, i.e. all processes
+  modifying overlapping extents of the file have to sieve their writes
+  as well.
+*/
+
+#define MAX_ERRCOUNT 100
+
+static int sieve_lock (ompio_file_t *fh, struct flock *lock,
+                       OMPI_MPI_OFFSET_TYPE start, size_t extent)
+{
+    int ret, err_count=0;
+
+    lock->l_type   = F_WRLCK;
+    lock->l_whence = SEEK_SET;
+    lock->l_start  = (off_t) start;
+    lock->l_len    = (off_t) extent;
+
+    errno=0;
+    do {
+        ret = fcntl ( fh->fd, F_SETLKW, lock);
+        if ( ret ) {
+            err_count++;
+        }
+    } while (  ret && ((errno == EINTR) || ((errno == EINPROGRESS) && err_count < MAX_ERRCOUNT )));
+
+    return ret;
+}
+
+static void sieve_unlock (ompio_file_t *fh, struct flock *lock)
+{
+    lock->l_type = F_UNLCK;
+    fcntl ( fh->fd, F_SETLK, lock);
+}
+
+/* Hand entries [first, last) of the current io_array to the fbtl */
+static ssize_t sieve_fbtl_op (ompio_file_t *fh, mca_common_ompio_io_array_t *io_array,
+                              int num_entries, bool is_write)
+{
+    mca_common_ompio_io_array_t *saved_array = fh->f_io_array;
+    int saved_entries = fh->f_num_of_io_entries;
+    ssize_t ret;
+
+    fh->f_io_array = io_array;
+    fh->f_num_of_io_entries = num_entries;
+    if ( is_write ) {
+        ret = fh->f_fbtl->fbtl_pwritev (fh);
+    }
+    else {
+        ret = fh->f_fbtl->fbtl_preadv (fh);
+    }
+    fh->f_io_array = saved_array;
+    fh->f_num_of_io_entries = saved_entries;
+
+    return ret;
+}
+
+/*
+  Write the entries [first, last) without sieving, holding a lock on
+  the range they cover so that they are not overwritten by a concurrent
+  read-modify-write of another process.
+*/
+static ssize_t sieve_write_direct (ompio_file_t *fh, int first, int last)
+{
+    mca_common_ompio_io_array_t *io_array = fh->f_io_array;
+    OMPI_MPI_OFFSET_TYPE start, end, offset;
+    struct flock lock;
+    int saved_flags;
+    ssize_t ret;
+    int i;
+
+    start = (OMPI_MPI_OFFSET_TYPE)(intptr_t) io_array[first].offset;
+    end   = start + io_array[first].length;
+    for ( i = first + 1; i < last; i++ ) {
+        offset = (OMPI_MPI_OFFSET_TYPE)(intptr_t) io_array[i].offset;
+        if ( offset < start ) {
+            start = offset;
+        }
+        if ( offset + (OMPI_MPI_OFFSET_TYPE) io_array[i].length > end ) {
+            end = offset + io_array[i].length;
+        }
+    }
+
+    if ( 0 != sieve_lock (fh, &lock, start, (size_t)(end - start)) ) {
+        return sieve_fbtl_op (fh, &io_array[first], last - first, true);
+    }
+
+    saved_flags = fh->f_flags;
+    fh->f_flags |= OMPIO_LOCK_NOT_THIS_OP;
+    ret = sieve_fbtl_op (fh, &io_array[first], last - first, true);
+    fh->f_flags = saved_flags;
+
+    sieve_unlock (fh, &lock);
+    return ret;
+}
+
+/* Issue the entries [first, last) which are not sieved */
+static ssize_t sieve_direct_op (ompio_file_t *fh, int first, int last, bool is_write)
+{
+    if ( is_write ) {
+        return sieve_write_direct (fh, first, last);
+    }
+    return sieve_fbtl_op (fh, &fh->f_io_array[first], last - first, false);
+}
+
+/*
+  Determine the window starting at entry first. On return, *last is the
+  first entry not contained in the window. Returns true if the window
+  should be sieved.
+*/
+static bool sieve_window (ompio_file_t *fh, int first, int *last, size_t buf_size,
+                          int max_hole_ratio, OMPI_MPI_OFFSET_TYPE *start, size_t *extent)
+{
+    mca_common_ompio_io_array_t *io_array = fh->f_io_array;
+    OMPI_MPI_OFFSET_TYPE offset, end;
+    size_t data;
+    int i;
+
+    *start = (OMPI_MPI_OFFSET_TYPE)(intptr_t) io_array[first].offset;
+    end    = *start + io_array[first].length;
+    data   = io_array[first].length;
+
+    for ( i = first + 1; i < fh->f_num_of_io_entries; i++ ) {
+        offset = (OMPI_MPI_OFFSET_TYPE)(intptr_t) io_array[i].offset;
+        if ( offset < end ) {
+            /* overlapping or not in increasing order */
+            break;
+        }
+        if ( (size_t)(offset - *start) + io_array[i].length > buf_size ) {
+            break;
+        }
+        end   = offset + io_array[i].length;
+        data += io_array[i].length;
+    }
+
+    *last   = i;
+    *extent = (size_t)(end - *start);
+
+    if ( (i - first) < 2 ) {
+        return false;
+    }
+    return ( (*extent - data) * 100 <= (size_t) max_hole_ratio * (*extent) );
+}
+
+/*
+  Number of bytes of the entries [first, last) which are contained in
+  the first valid bytes of the extent starting at start, i.e. what was
+  actually transferred to or from the file.
+*/
+static size_t sieve_valid_bytes (ompio_file_t *fh, int first, int last,
+                                 OMPI_MPI_OFFSET_TYPE start, size_t valid)
+{
+    mca_common_ompio_io_array_t *io_array = fh->f_io_array;
+    size_t pos, total=0;
+    int i;
+
+    for ( i = first; i < last; i++ ) {
+        pos = (size_t)((OMPI_MPI_OFFSET_TYPE)(intptr_t) io_array[i].offset - start);
+        if ( pos >= valid ) {
+            break;
+        }
+        total += ( pos + io_array[i].length > valid ) ? valid - pos : io_array[i].length;
+    }
+
+    return total;
+}
+
+/* Copy the entries [first, last) between user memory and the sieve buffer */
+static void sieve_copy (ompio_file_t *fh, int first, int last, char *buf,
+                        OMPI_MPI_OFFSET_TYPE start, size_t valid, bool to_buf)
+{
+    mca_common_ompio_io_array_t *io_array = fh->f_io_array;
+    size_t pos, len;
+    int i;
+
+    for ( i = first; i < last; i++ ) {
+        pos = (size_t)((OMPI_MPI_OFFSET_TYPE)(intptr_t) io_array[i].offset - start);
+        if ( pos >= valid ) {
+            break;
+        }
+        len = ( pos + io_array[i].length > valid ) ? valid - pos : io_array[i].length;
+        if ( to_buf ) {
+            memcpy ( buf + pos, io_array[i].memory_address, len );
+        }
+        else {
+            memcpy ( io_array[i].memory_address, buf + pos, len );
+        }
+    }
+}
+
+static ssize_t sieve_read_window (ompio_file_t *fh, int first, int last, char *buf,
+                                  OMPI_MPI_OFFSET_TYPE start, size_t extent)
+{
+    mca_common_ompio_io_array_t entry;
+    ssize_t ret;
+
+    entry.memory_address = buf;
+    entry.offset = (IOVBASE_TYPE *)(intptr_t) start;
+    entry.length = extent;
+
+    ret = sieve_fbtl_op (fh, &entry, 1, false);
+    if ( 0 > ret ) {
+        return ret;
+    }
+
+    sieve_copy (fh, first, last, buf, start, (size_t) ret, false);
+    return (ssize_t) sieve_valid_bytes (fh, first, last, start, (size_t) ret);
+}
+
+static ssize_t sieve_write_window (ompio_file_t *fh, int first, int last, char *buf,
+                                   OMPI_MPI_OFFSET_TYPE start, size_t extent)
+{
+    mca_common_ompio_io_array_t entry;
+    struct flock lock;
+    int saved_flags;
+    ssize_t ret;
+
+    if ( 0 != sieve_lock (fh, &lock, start, extent) ) {
+        /* e.g. file system without lock support */
+        return sieve_fbtl_op (fh, &fh->f_io_array[first], last - first, true);
+    }
+
+    /* we hold the lock for the whole extent, the fbtl must not
+       acquire or release locks in this range on its own. */
+    saved_flags = fh->f_flags;
+    fh->f_flags |= OMPIO_LOCK_NOT_THIS_OP;
+
+    entry.memory_address = buf;
+    entry.offset = (IOVBASE_TYPE *)(intptr_t) start;
+    entry.length = extent;
+
+    ret = sieve_fbtl_op (fh, &entry, 1, false);
+    if ( 0 > ret ) {
+        goto exit;
+    }
+    if ( (size_t) ret < extent ) {
+        /* the extent reaches beyond the end of the file */
+        memset ( buf + ret, 0, extent - (size_t) ret );
+    }
+    sieve_copy (fh, first, last, buf, start, extent, true);
+
+    ret = sieve_fbtl_op (fh, &entry, 1, true);
+    if ( 0 > ret ) {
+        goto exit;
+    }
+    ret = (ssize_t) sieve_valid_bytes (fh, first, last, start, (size_t) ret);
+
+exit:
+    fh->f_flags = saved_flags;
+    sieve_unlock (fh, &lock);
+    return ret;
+}
+
+static ssize_t sieve_op (ompio_file_t *fh, bool is_write)
+{
+    size_t buf_size, extent;
+    OMPI_MPI_OFFSET_TYPE start;
+    int max_hole_ratio;
+    int first, last, direct_first;
+    ssize_t ret, total=0;
+    char *buf=NULL;
+
+    ret = OMPIO_MCA_GET(fh, sieve_buffer_size);
+    if ( 0 >= ret ) {
+        return sieve_direct_op (fh, 0, fh->f_num_of_io_entries, is_write);
+    }
+    buf_size = (size_t) ret;
+    max_hole_ratio = OMPIO_MCA_GET(fh, sieve_max_hole_ratio);
+
+    direct_first = 0;
+    for ( first = 0; first < fh->f_num_of_io_entries; first = last ) {
+        if ( !sieve_window (fh, first, &last, buf_size, max_hole_ratio, &start, &extent) ) {
+            continue;
+        }
+
+        /* issue the entries which were not sieved, in file order */
+        if ( direct_first < first ) {
+            ret = sieve_direct_op (fh, direct_first, first, is_write);
+            if ( 0 > ret ) {
+                goto exit;
+            }
+            total += ret;
+        }
+        direct_first = last;
+
+        if ( NULL == buf ) {
+            buf = (char *) malloc ( buf_size );
+            if ( NULL == buf ) {
+                ret = OMPI_ERR_OUT_OF_RESOURCE;
+                goto exit;
+            }
+        }
+
+        if ( is_write ) {
+            ret = sieve_write_window (fh, first, last, buf, start, extent);
+        }
+        else {
+            ret = sieve_read_window (fh, first, last, buf, start, extent);
+        }
+        if ( 0 > ret ) {
+            goto exit;
+        }
+        total += ret;
+    }
+
+    if ( direct_first < fh->f_num_of_io_entries ) {
+        ret = sieve_direct_op (fh, direct_first, fh->f_num_of_io_entries, is_write);
+        if ( 0 > ret ) {
+            goto exit;
+        }
+        total += ret;
+    }
+    ret = total;
+
+exit:
+    free (buf);
+    return ret;
+}
+
+ssize_t mca_common_ompio_sieve_preadv (ompio_file_t *fh)
+{
+    if ( !(OMPIO_MCA_GET(fh, data_sieving) & OMPIO_SIEVE_READS) ||
+         2 > fh->f_num_of_io_entries ) {
+        return fh->f_fbtl->fbtl_preadv (fh);
+    }
+
+    return sieve_op (fh, false);
+}
+
+ssize_t mca_common_ompio_sieve_pwritev (ompio_file_t *fh)
+{
+    /* read-modify-write needs read access and fcntl locks on fh->fd,
+       and must not be combined with locking the entire file for
+       every operation. */
+    if ( !(OMPIO_MCA_GET(fh, data_sieving) & OMPIO_SIEVE_WRITES) ||
+         0 == fh->f_num_of_io_entries ||
+         (fh->f_amode & MPI_MODE_WRONLY) ||
+         (fh->f_flags & OMPIO_LOCK_ENTIRE_FILE) ||
+         (UFS != fh->f_fstype && LUSTRE != fh->f_fstype && GPFS != fh->f_fstype) ) {
+        return fh->f_fbtl->fbtl_pwritev (fh);
+    }
+    if ( 2 > fh->f_num_of_io_entries ) {
+        /* still has to be protected against the read-modify-write of
+           other processes */
+        return sieve_write_direct (fh, 0, fh->f_num_of_io_entries);
+    }
+
+    return sieve_op (fh, true);
+}
@@ -0,0 +1,330 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ *  Copyright (c) 2026      The University of Tennessee and The University
+ *                          of Tennessee Research Foundation.  All rights
+ *                          reserved.
+ *  $COPYRIGHT$
+ *
+ *  Additional copyrights may follow
+ *
+ *  $HEADER$
+ */
+
+#include "ompi_config.h"
+
+#include "opal/mca/base/mca_base_pvar.h"
+#include "opal/mca/threads/thread_usage.h"
+#include "opal/mca/timer/base/base.h"
+#include "ompi/communicator/communicator.h"
+#include "ompi/op/op.h"
+#include "common_ompio.h"
+
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+/*
+  I/O statistics of the files opened by the application.
+
+  Enabled by the stats parameter. Every read and write operation counts
+  its bytes and the log2 of its size once, operations invoked from
+  within other operations (e.g. by fcoll/individual) are not counted
+  again. Timers accumulate the time spent in the phases of the
+  operations:
+
+    io       file access of individual operations and of the aggregators
+    shuffle  data exchange between the processes and the aggregators
+    wait     waiting for the completion of asynchronous file access
+    total    read and write operations from entry to exit
+
+  The sums over all files of the process are exported as MPI_T
+  performance variables of the io/ompio component. With stats set to
+  2 a summary of every file is printed by its first process at close,
+  the per process values are gathered for the minimum, average and
+  maximum, the imbalance of the aggregators and the bandwidth.
+*/
+
+#define OMPIO_STATS_HIST_BINS 32
+
+struct mca_common_ompio_stats_t {
+    uint64_t bytes_read;
+    uint64_t bytes_written;
+    uint64_t read_calls;
+    uint64_t write_calls;
+    uint64_t aggr_bytes;      /* file data accessed as aggregator */
+    uint64_t phase_usec[OMPIO_STATS_NUM_PHASES];
+    uint64_t hist[OMPIO_STATS_HIST_BINS];
+    /* per file only */
+    uint64_t open_usec;
+    int      depth;           /* nesting level of the operations */
+};
+typedef struct mca_common_ompio_stats_t mca_common_ompio_stats_t;
+
+static mca_common_ompio_stats_t stats_total;
+
+static const char *phase_names[OMPIO_STATS_NUM_PHASES] = {
+    "io", "shuffle", "wait", "total"
+};
+
+static inline void stats_add (uint64_t *file_value, uint64_t *total_value, uint64_t delta)
+{
+    *file_value += delta;
+    OPAL_THREAD_ADD_FETCH64 ((opal_atomic_int64_t *) total_value, (int64_t) delta);
+}
+
+void mca_common_ompio_stats_init (ompio_file_t *fh)
+{
+    fh->f_stats = NULL;
+    if ( 0 >= OMPIO_MCA_GET(fh, stats) ) {
+        return;
+    }
+    fh->f_stats = (mca_common_ompio_stats_t *) calloc (1, sizeof(mca_common_ompio_stats_t));
+    if ( NULL != fh->f_stats ) {
+        fh->f_stats->open_usec = opal_timer_base_get_usec ();
+    }
+}
+
+uint64_t mca_common_ompio_stats_time (ompio_file_t *fh)
+{
+    return NULL == fh->f_stats ? 0 : opal_timer_base_get_usec ();
+}
+
+void mca_common_ompio_stats_phase (ompio_file_t *fh, int phase, uint64_t start)
+{
+    if ( NULL != fh->f_stats ) {
+        stats_add (&fh->f_stats->phase_usec[phase], &stats_total.phase_usec[phase],
+                   opal_timer_base_get_usec () - start);
+    }
+}
+
+uint64_t mca_common_ompio_stats_begin (ompio_file_t *fh)
+{
+    if ( NULL == fh->f_stats ) {
+        return 0;
+    }
+    fh->f_stats->depth++;
+    return opal_timer_base_get_usec ();
+}
+
+void mca_common_ompio_stats_end (ompio_file_t *fh, bool is_write, size_t bytes, uint64_t start)
+{
+    mca_common_ompio_stats_t *s = fh->f_stats;
+    int bin = 0;
+
+    if ( NULL == s || 0 < --s->depth ) {
+        return;
+    }
+    if ( is_write ) {
+        stats_add (&s->bytes_written, &stats_total.bytes_written, bytes);
+        stats_add (&s->write_calls, &stats_total.write_calls, 1);
+    }
+    else {
+        stats_add (&s->bytes_read, &stats_total.bytes_read, bytes);
+        stats_add (&s->read_calls, &stats_total.read_calls, 1);
+    }
+    while ( bytes > 1 && bin < OMPIO_STATS_HIST_BINS - 1 ) {
+        bytes >>= 1;
+        bin++;
+    }
+    stats_add (&s->hist[bin], &stats_total.hist[bin], 1);
+    mca_common_ompio_stats_phase (fh, OMPIO_STATS_TOTAL, start);
+}
+
+void mca_common_ompio_stats_aggr (ompio_file_t *fh, size_t bytes)
+{
+    if ( NULL != fh->f_stats ) {
+        stats_add (&fh->f_stats->aggr_bytes, &stats_total.aggr_bytes, bytes);
+    }
+}
+
+/* Indices of the values gathered for the report */
+enum {
+    REPORT_BYTES_READ = 0,
+    REPORT_BYTES_WRITTEN,
+    REPORT_READ_CALLS,
+    REPORT_WRITE_CALLS,
+    REPORT_AGGR_BYTES,
+    REPORT_PHASES,
+    REPORT_NUM_VALUES = REPORT_PHASES + OMPIO_STATS_NUM_PHASES
+};
+
+int mca_common_ompio_stats_report (ompio_file_t *fh)
+{
+    mca_common_ompio_stats_t *s = fh->f_stats;
+    double values[REPORT_NUM_VALUES], *all = NULL;
+    double sum, min, max, total, max_time = 0.0, aggr_sum = 0.0, aggr_min = 0.0, aggr_max = 0.0;
+    uint64_t hist[OMPIO_STATS_HIST_BINS];
+    int i, k, num_aggrs = 0, ret;
+
+    if ( NULL == s || OMPIO_STATS_REPORT != OMPIO_MCA_GET(fh, stats) ) {
+        return OMPI_SUCCESS;
+    }
+
+    values[REPORT_BYTES_READ]    = (double) s->bytes_read;
+    values[REPORT_BYTES_WRITTEN] = (double) s->bytes_written;
+    values[REPORT_READ_CALLS]    = (double) s->read_calls;
+    values[REPORT_WRITE_CALLS]   = (double) s->write_calls;
+    values[REPORT_AGGR_BYTES]    = (double) s->aggr_bytes;
+    for ( k = 0; k < OMPIO_STATS_NUM_PHASES; k++ ) {
+        values[REPORT_PHASES + k] = (double) s->phase_usec[k] / 1000000.0;
+    }
+
+    if ( 0 == fh->f_rank ) {
+        all = (double *) malloc (fh->f_size * REPORT_NUM_VALUES * sizeof(double));
+        if ( NULL == all ) {
+            return OMPI_ERR_OUT_OF_RESOURCE;
+        }
+    }
+    ret = fh->f_comm->c_coll->coll_gather (values, REPORT_NUM_VALUES, MPI_DOUBLE,
+                                           all, REPORT_NUM_VALUES, MPI_DOUBLE, 0,
+                                           fh->f_comm, fh->f_comm->c_coll->coll_gather_module);
+    if ( OMPI_SUCCESS != ret ) {
+        goto exit;
+    }
+    ret = fh->f_comm->c_coll->coll_reduce (s->hist, hist, OMPIO_STATS_HIST_BINS, MPI_UINT64_T,
+                                           MPI_SUM, 0, fh->f_comm,
+                                           fh->f_comm->c_coll->coll_reduce_module);
+    if ( OMPI_SUCCESS != ret || 0 != fh->f_rank ) {
+        goto exit;
+    }
+
+    printf ("OMPIO statistics of file %s, %d processes, open for %.3f s\n", fh->f_filename,
+            fh->f_size, (double) (opal_timer_base_get_usec () - s->open_usec) / 1000000.0);
+    for ( k = REPORT_BYTES_READ; k <= REPORT_WRITE_CALLS; k++ ) {
+        for ( sum = 0.0, i = 0; i < fh->f_size; i++ ) {
+            sum += all[i*REPORT_NUM_VALUES + k];
+        }
+        values[k] = sum;
+    }
+    printf ("  read:    %.0f bytes in %.0f calls\n", values[REPORT_BYTES_READ],
+            values[REPORT_READ_CALLS]);
+    printf ("  written: %.0f bytes in %.0f calls\n", values[REPORT_BYTES_WRITTEN],
+            values[REPORT_WRITE_CALLS]);
+
+    printf ("  time [s]        min          avg          max\n");
+    for ( k = 0; k < OMPIO_STATS_NUM_PHASES; k++ ) {
+        sum = 0.0;
+        min = max = all[REPORT_PHASES + k];
+        for ( i = 0; i < fh->f_size; i++ ) {
+            total = all[i*REPORT_NUM_VALUES + REPORT_PHASES + k];
+            sum += total;
+            min = total < min ? total : min;
+            max = total > max ? total : max;
+        }
+        printf ("    %-8s %12.6f %12.6f %12.6f\n", phase_names[k], min, sum / fh->f_size, max);
+        if ( OMPIO_STATS_TOTAL == k ) {
+            max_time = max;
+        }
+    }
+    if ( max_time > 0.0 ) {
+        printf ("  bandwidth: %.2f MB/s\n", (values[REPORT_BYTES_READ] + values[REPORT_BYTES_WRITTEN]) /
+                max_time / 1048576.0);
+    }
+
+    for ( i = 0; i < fh->f_size; i++ ) {
+        total = all[i*REPORT_NUM_VALUES + REPORT_AGGR_BYTES];
+        if ( 0.0 == total ) {
+            continue;
+        }
+        aggr_min = (0 == num_aggrs || total < aggr_min) ? total : aggr_min;
+        aggr_max = total > aggr_max ? total : aggr_max;
+        aggr_sum += total;
+        num_aggrs++;
+    }
+    if ( num_aggrs > 0 ) {
+        printf ("  aggregators: %d, bytes min %.0f avg %.0f max %.0f, imbalance %.2f\n",
+                num_aggrs, aggr_min, aggr_sum / num_aggrs, aggr_max,
+                aggr_max / (aggr_sum / num_aggrs));
+    }
+
+    printf ("  request sizes:\n");
+    for ( k = 0; k < OMPIO_STATS_HIST_BINS; k++ ) {
+        if ( 0 != hist[k] ) {
+            printf ("    >= 2^%-2d bytes %12llu\n", k, (unsigned long long) hist[k]);
+        }
+    }
+
+ exit:
+    free (all);
+    return ret;
+}
+
+void mca_common_ompio_stats_free (ompio_file_t *fh)
+{
+    free (fh->f_stats);
+    fh->f_stats = NULL;
+}
+
+/*
+ * MPI_T performance variables
+ */
+
+static int stats_pvar_get (const struct mca_base_pvar_t *pvar, void *value, void *obj)
+{
+    size_t offset = (size_t)(intptr_t) pvar->ctx;
+
+    if ( offsetof(mca_common_ompio_stats_t, hist) == offset ) {
+        memcpy (value, stats_total.hist, sizeof(stats_total.hist));
+    }
+    else {
+        *(unsigned long long *) value = *(uint64_t *)((char *) &stats_total + offset);
+    }
+    return OMPI_SUCCESS;
+}
+
+static int stats_pvar_notify (struct mca_base_pvar_t *pvar, mca_base_pvar_event_t event,
+                              void *obj, int *count)
+{
+    if ( MCA_BASE_PVAR_HANDLE_BIND == event ) {
+        *count = offsetof(mca_common_ompio_stats_t, hist) == (size_t)(intptr_t) pvar->ctx ?
+            OMPIO_STATS_HIST_BINS : 1;
+    }
+    return OMPI_SUCCESS;
+}
+
+int mca_common_ompio_stats_register_pvars (const mca_base_component_t *component)
+{
+    static const struct {
+        const char *name;
+        const char *desc;
+        int         var_class;
+        size_t      offset;
+    } pvars[] = {
+        { "bytes_read", "Bytes read from files by this process", MCA_BASE_PVAR_CLASS_COUNTER,
+          offsetof(mca_common_ompio_stats_t, bytes_read) },
+        { "bytes_written", "Bytes written to files by this process", MCA_BASE_PVAR_CLASS_COUNTER,
+          offsetof(mca_common_ompio_stats_t, bytes_written) },
+        { "read_calls", "Number of read operations", MCA_BASE_PVAR_CLASS_COUNTER,
+          offsetof(mca_common_ompio_stats_t, read_calls) },
+        { "write_calls", "Number of write operations", MCA_BASE_PVAR_CLASS_COUNTER,
+          offsetof(mca_common_ompio_stats_t, write_calls) },
+        { "aggregator_bytes", "Bytes accessed in the file as aggregator of collective operations",
+          MCA_BASE_PVAR_CLASS_COUNTER, offsetof(mca_common_ompio_stats_t, aggr_bytes) },
+        { "io_time", "Time spent accessing the file system in microseconds",
+          MCA_BASE_PVAR_CLASS_TIMER,
+          offsetof(mca_common_ompio_stats_t, phase_usec[OMPIO_STATS_IO]) },
+        { "shuffle_time", "Time spent exchanging data in collective operations in microseconds",
+          MCA_BASE_PVAR_CLASS_TIMER,
+          offsetof(mca_common_ompio_stats_t, phase_usec[OMPIO_STATS_SHUFFLE]) },
+        { "wait_time", "Time spent waiting for asynchronous file access in microseconds",
+          MCA_BASE_PVAR_CLASS_TIMER,
+          offsetof(mca_common_ompio_stats_t, phase_usec[OMPIO_STATS_WAIT]) },
+        { "total_time", "Time spent in read and write operations in microseconds",
+          MCA_BASE_PVAR_CLASS_TIMER,
+          offsetof(mca_common_ompio_stats_t, phase_usec[OMPIO_STATS_TOTAL]) },
+        { "request_size_histogram", "Number of read and write operations by the log2 of their size",
+          MCA_BASE_PVAR_CLASS_COUNTER, offsetof(mca_common_ompio_stats_t, hist) },
+    };
+    size_t i;
+
+    for ( i = 0; i < sizeof(pvars) / sizeof(pvars[0]); i++ ) {
+        (void) mca_base_component_pvar_register (component, pvars[i].name, pvars[i].desc,
+                                                 OPAL_INFO_LVL_4, pvars[i].var_class,
+                                                 MCA_BASE_VAR_TYPE_UNSIGNED_LONG_LONG,
+                                                 NULL, MCA_BASE_VAR_BIND_NO_OBJECT,
+                                                 MCA_BASE_PVAR_FLAG_READONLY | MCA_BASE_PVAR_FLAG_CONTINUOUS,
+                                                 stats_pvar_get, NULL, stats_pvar_notify,
+                                                 (void *)(intptr_t) pvars[i].offset);
+    }
+    return OMPI_SUCCESS;
+}
@@ -135,6 +135,14 @@ typedef bool (*mca_fbtl_base_module_progress_fn_t)
 
 typedef void (*mca_fbtl_base_module_request_free_fn_t)
     ( struct mca_ompio_request_t *request);
+
+/* Optional: announce buffers that are going to be used for many
+   operations on this file (e.g. the buffers of a collective
+   aggregator), so that the module can pin/register them once. */
+typedef int (*mca_fbtl_base_module_register_buffers_fn_t)
+    ( struct ompio_file_t *file, const struct iovec *bufs, int count);
+typedef int (*mca_fbtl_base_module_unregister_buffers_fn_t)
+    ( struct ompio_file_t *file);
 /*
  * ***********************************************************************
  * ***************************  module structure *************************
@@ -156,6 +164,8 @@ struct mca_fbtl_base_module_1_0_0_t {
     mca_fbtl_base_module_ipwritev_fn_t      fbtl_ipwritev;
     mca_fbtl_base_module_progress_fn_t      fbtl_progress;
     mca_fbtl_base_module_request_free_fn_t  fbtl_request_free;
+    mca_fbtl_base_module_register_buffers_fn_t   fbtl_register_buffers;
+    mca_fbtl_base_module_unregister_buffers_fn_t fbtl_unregister_buffers;
 };
 typedef struct mca_fbtl_base_module_1_0_0_t mca_fbtl_base_module_1_0_0_t;
 typedef mca_fbtl_base_module_1_0_0_t mca_fbtl_base_module_t;
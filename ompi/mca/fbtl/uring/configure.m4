@@ -0,0 +1,33 @@
+# -*- shell-script -*-
+#
+# Copyright (c) 2026      The University of Tennessee and The University
+#                         of Tennessee Research Foundation.  All rights
+#                         reserved.
+# $COPYRIGHT$
+#
+# Additional copyrights may follow
+#
+# $HEADER$
+#
+
+# MCA_fbtl_uring_CONFIG(action-if-can-compile,
+#                       [action-if-cant-compile])
+# ------------------------------------------------
+# The component talks to the kernel through the raw io_uring system
+# calls, so it only needs the kernel headers (no liburing).
+AC_DEFUN([MCA_ompi_fbtl_uring_CONFIG],[
+    AC_CONFIG_FILES([ompi/mca/fbtl/uring/Makefile])
+
+    fbtl_uring_happy=no
+    AC_CHECK_HEADER([linux/io_uring.h],
+                    [fbtl_uring_happy=yes
+                     AC_CHECK_DECLS([__NR_io_uring_setup, __NR_io_uring_enter,
+                                     __NR_io_uring_register, IORING_OP_WRITE_FIXED],
+                                    [], [fbtl_uring_happy=no],
+                                    [#include <sys/syscall.h>
+#include <linux/io_uring.h>])])
+
+    AS_IF([test "$fbtl_uring_happy" = "yes"],
+          [$1],
+          [$2])
+])dnl
@@ -0,0 +1,201 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+#include "mpi.h"
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "ompi/constants.h"
+#include "ompi/mca/fbtl/fbtl.h"
+#include "ompi/mca/fbtl/uring/fbtl_uring.h"
+
+#define MAX_ERRCOUNT 100
+
+/*
+ * *******************************************************************
+ * ************************ actions structure ************************
+ * *******************************************************************
+ */
+static mca_fbtl_base_module_1_0_0_t uring =  {
+    mca_fbtl_uring_module_init,     /* initalise after being selected */
+    mca_fbtl_uring_module_finalize, /* close a module on a communicator */
+    mca_fbtl_uring_preadv,          /* blocking read */
+    mca_fbtl_uring_ipreadv,         /* non-blocking read*/
+    mca_fbtl_uring_pwritev,         /* blocking write */
+    mca_fbtl_uring_ipwritev,        /* non-blocking write */
+    mca_fbtl_uring_progress,        /* module specific progress */
+    mca_fbtl_uring_request_free,    /* free module specific data items on the request */
+    mca_fbtl_uring_register_bufs,   /* register buffers */
+    mca_fbtl_uring_unregister_bufs  /* unregister buffers */
+};
+/*
+ * *******************************************************************
+ * ************************* structure ends **************************
+ * *******************************************************************
+ */
+
+int mca_fbtl_uring_component_init_query(bool enable_progress_threads,
+                                        bool enable_mpi_threads) {
+    /* io_uring might be missing from the kernel, or forbidden
+       by a seccomp profile (e.g. in containers). */
+    return mca_fbtl_uring_ring_probe ();
+}
+
+struct mca_fbtl_base_module_1_0_0_t *
+mca_fbtl_uring_component_file_query (ompio_file_t *fh, int *priority) {
+   /* only for file systems which are accessed through regular
+      file descriptors */
+   if (UFS != fh->f_fstype && LUSTRE != fh->f_fstype &&
+       GPFS != fh->f_fstype) {
+       return NULL;
+   }
+
+   *priority = mca_fbtl_uring_priority;
+   return &uring;
+}
+
+int mca_fbtl_uring_component_file_unquery (ompio_file_t *file) {
+   /* This function might be needed for some purposes later. for now it
+    * does not have anything to do since there are no steps which need
+    * to be undone if this module is not selected */
+
+   return OMPI_SUCCESS;
+}
+
+int mca_fbtl_uring_module_init (ompio_file_t *file) {
+    mca_fbtl_uring_file_t *ufile;
+    int ret;
+
+    ufile = (mca_fbtl_uring_file_t *) malloc (sizeof (mca_fbtl_uring_file_t));
+    if (NULL == ufile) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+    ufile->direct_fd    = -1;
+    ufile->direct_tried = false;
+
+    ret = mca_fbtl_uring_ring_retain ();
+    if (OMPI_SUCCESS != ret) {
+        free (ufile);
+        return ret;
+    }
+
+    file->f_fbtl_data = ufile;
+    return OMPI_SUCCESS;
+}
+
+
+int mca_fbtl_uring_module_finalize (ompio_file_t *file) {
+    mca_fbtl_uring_file_t *ufile = (mca_fbtl_uring_file_t *) file->f_fbtl_data;
+
+    if (NULL == ufile) {
+        return OMPI_SUCCESS;
+    }
+
+    mca_fbtl_uring_ring_unregister_bufs (file);
+    mca_fbtl_uring_ring_release ();
+
+    if (-1 != ufile->direct_fd) {
+        close (ufile->direct_fd);
+    }
+    free (ufile);
+    file->f_fbtl_data = NULL;
+
+    return OMPI_SUCCESS;
+}
+
+int mca_fbtl_uring_register_bufs (ompio_file_t *file, const struct iovec *bufs, int count)
+{
+    if (0 == mca_fbtl_uring_register_buffers) {
+        return OMPI_ERR_NOT_SUPPORTED;
+    }
+
+    return mca_fbtl_uring_ring_register_bufs (file, bufs, count);
+}
+
+int mca_fbtl_uring_unregister_bufs (ompio_file_t *file)
+{
+    mca_fbtl_uring_ring_unregister_bufs (file);
+    return OMPI_SUCCESS;
+}
+
+/*
+  Same rules as the posix fbtl: the whole range of the request is
+  locked, unless the fs component or the fcoll component told us
+  that no locking is needed.
+*/
+int mca_fbtl_uring_lock (mca_fbtl_uring_request_data_t *data, int op)
+{
+    ompio_file_t *fh = data->fh;
+    struct flock *lock = &data->lock;
+    off_t start, end;
+    int i, ret, err_count;
+
+    lock->l_type   = op;
+    lock->l_whence = SEEK_SET;
+    lock->l_start  = -1;
+    lock->l_len    = -1;
+
+    if (0 == data->nops) {
+        return 0;
+    }
+
+    if ( fh->f_flags & OMPIO_LOCK_ENTIRE_FILE ) {
+        lock->l_start = (off_t) 0;
+        lock->l_len   = 0;
+    }
+    else {
+        if ( (fh->f_flags & OMPIO_LOCK_NEVER) ||
+             (fh->f_flags & OMPIO_LOCK_NOT_THIS_OP )){
+            return 0;
+        }
+        start = data->ops[0].offset;
+        end   = data->ops[0].offset + data->ops[0].length;
+        for (i = 1; i < data->nops; i++) {
+            if (data->ops[i].offset < start) {
+                start = data->ops[i].offset;
+            }
+            if ((off_t)(data->ops[i].offset + data->ops[i].length) > end) {
+                end = data->ops[i].offset + data->ops[i].length;
+            }
+        }
+        lock->l_start = start;
+        lock->l_len   = end - start;
+    }
+
+    errno=0;
+    err_count=0;
+    do {
+        ret = fcntl ( fh->fd, F_SETLKW, lock);
+        if ( ret ) {
+            err_count++;
+        }
+    } while (  ret && ((errno == EINTR) || ((errno == EINPROGRESS) && err_count < MAX_ERRCOUNT )));
+
+    return ret;
+}
+
+void mca_fbtl_uring_unlock (mca_fbtl_uring_request_data_t *data)
+{
+    struct flock *lock = &data->lock;
+
+    if ( -1 == lock->l_start && -1 == lock->l_len ) {
+        return;
+    }
+
+    lock->l_type = F_UNLCK;
+    fcntl ( data->fh->fd, F_SETLK, lock);
+    lock->l_start = -1;
+    lock->l_len   = -1;
+}
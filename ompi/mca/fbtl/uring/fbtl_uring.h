@@ -0,0 +1,135 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#ifndef MCA_FBTL_URING_H
+#define MCA_FBTL_URING_H
+
+#include "ompi_config.h"
+
+#include <fcntl.h>
+#include <limits.h>
+#include <sys/uio.h>
+#include <linux/io_uring.h>
+
+#include "opal/mca/threads/mutex.h"
+#include "ompi/mca/mca.h"
+#include "ompi/mca/fbtl/fbtl.h"
+#include "ompi/mca/common/ompio/common_ompio.h"
+#include "ompi/mca/common/ompio/common_ompio_request.h"
+
+BEGIN_C_DECLS
+
+extern int mca_fbtl_uring_priority;
+extern int mca_fbtl_uring_entries;
+extern int mca_fbtl_uring_iov_max;
+extern int mca_fbtl_uring_direct;
+extern int mca_fbtl_uring_direct_alignment;
+extern int mca_fbtl_uring_register_buffers;
+
+#define FBTL_URING_BASE_PRIORITY     5
+#define FBTL_URING_ENTRIES         256
+#define FBTL_URING_DIRECT_ALIGNMENT 4096
+
+int mca_fbtl_uring_component_init_query(bool enable_progress_threads,
+                                        bool enable_mpi_threads);
+struct mca_fbtl_base_module_1_0_0_t *
+mca_fbtl_uring_component_file_query (ompio_file_t *file, int *priority);
+int mca_fbtl_uring_component_file_unquery (ompio_file_t *file);
+
+int mca_fbtl_uring_module_init (ompio_file_t *file);
+int mca_fbtl_uring_module_finalize (ompio_file_t *file);
+
+OMPI_MODULE_DECLSPEC extern mca_fbtl_base_component_2_0_0_t mca_fbtl_uring_component;
+/*
+ * ******************************************************************
+ * ********* functions which are implemented in this module *********
+ * ******************************************************************
+ */
+
+ssize_t mca_fbtl_uring_preadv (ompio_file_t *file );
+ssize_t mca_fbtl_uring_pwritev (ompio_file_t *file );
+ssize_t mca_fbtl_uring_ipreadv (ompio_file_t *file,
+                                ompi_request_t *request);
+ssize_t mca_fbtl_uring_ipwritev (ompio_file_t *file,
+                                 ompi_request_t *request);
+
+bool mca_fbtl_uring_progress     ( mca_ompio_request_t *req);
+void mca_fbtl_uring_request_free ( mca_ompio_request_t *req);
+
+int mca_fbtl_uring_register_bufs ( ompio_file_t *file, const struct iovec *bufs, int count);
+int mca_fbtl_uring_unregister_bufs ( ompio_file_t *file );
+
+/* define constants for read/write operations */
+#define FBTL_URING_READ  1
+#define FBTL_URING_WRITE 2
+
+/* per file data, hangs off fh->f_fbtl_data */
+struct mca_fbtl_uring_file_t {
+    int            direct_fd;   /* descriptor opened with O_DIRECT, -1 if none */
+    bool           direct_tried; /* the O_DIRECT descriptor was opened (or failed) */
+};
+typedef struct mca_fbtl_uring_file_t mca_fbtl_uring_file_t;
+
+struct mca_fbtl_uring_request_data_t;
+
+/* One submission queue entry: a run of io_array entries that are
+   contiguous in the file, merged into a vectored read or write. */
+struct mca_fbtl_uring_op_t {
+    struct mca_fbtl_uring_request_data_t *data;
+    struct iovec  *iov;         /* what is left of the transfer */
+    int            iovcnt;
+    off_t          offset;      /* file offset of iov[0] */
+    size_t         length;      /* bytes left */
+    int            fd;          /* fh->fd or the O_DIRECT descriptor */
+};
+typedef struct mca_fbtl_uring_op_t mca_fbtl_uring_op_t;
+
+struct mca_fbtl_uring_request_data_t {
+    int            req_type;    /* read or write */
+    int            nops;        /* total number of ops */
+    int            next_op;     /* first op which was not submitted yet */
+    int            open_ops;    /* ops not completed */
+    int            inflight;    /* ops in the ring */
+    int            error;       /* errno of the first failed op */
+    ssize_t        total_len;   /* total amount of data transferred */
+    struct flock   lock;        /* lock used for certain file systems */
+    ompio_file_t  *fh;          /* pointer back to the file handle */
+    mca_fbtl_uring_op_t *ops;
+    struct iovec  *iovecs;      /* copied from fh->f_io_array */
+};
+typedef struct mca_fbtl_uring_request_data_t mca_fbtl_uring_request_data_t;
+
+/* ring management (fbtl_uring_ring.c) */
+int  mca_fbtl_uring_ring_probe (void);
+int  mca_fbtl_uring_ring_retain (void);
+void mca_fbtl_uring_ring_release (void);
+
+mca_fbtl_uring_request_data_t *mca_fbtl_uring_prepare (ompio_file_t *fh, int req_type);
+void mca_fbtl_uring_request_data_free (mca_fbtl_uring_request_data_t *data);
+int  mca_fbtl_uring_submit (mca_fbtl_uring_request_data_t *data);
+int  mca_fbtl_uring_reap (bool wait);
+
+int  mca_fbtl_uring_ring_register_bufs (ompio_file_t *fh, const struct iovec *bufs, int count);
+void mca_fbtl_uring_ring_unregister_bufs (ompio_file_t *fh);
+
+int  mca_fbtl_uring_lock (mca_fbtl_uring_request_data_t *data, int op);
+void mca_fbtl_uring_unlock (mca_fbtl_uring_request_data_t *data);
+
+/*
+ * ******************************************************************
+ * ************ functions implemented in this module end ************
+ * ******************************************************************
+ */
+
+END_C_DECLS
+
+#endif /* MCA_FBTL_URING_H */
@@ -0,0 +1,83 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+#include "fbtl_uring.h"
+
+#include <errno.h>
+#include <string.h>
+
+#include "mpi.h"
+#include "ompi/constants.h"
+#include "ompi/mca/fbtl/fbtl.h"
+
+static ssize_t mca_fbtl_uring_blocking_op (ompio_file_t *fh, int io_op);
+
+ssize_t mca_fbtl_uring_preadv (ompio_file_t *fh)
+{
+    return mca_fbtl_uring_blocking_op(fh, FBTL_URING_READ);
+}
+
+ssize_t mca_fbtl_uring_pwritev (ompio_file_t *fh)
+{
+    return mca_fbtl_uring_blocking_op(fh, FBTL_URING_WRITE);
+}
+
+static ssize_t mca_fbtl_uring_blocking_op (ompio_file_t *fh, int io_op)
+{
+    mca_fbtl_uring_request_data_t *data;
+    ssize_t ret_code;
+    int ret;
+
+    if (NULL == fh->f_io_array) {
+        return OMPI_ERROR;
+    }
+
+    data = mca_fbtl_uring_prepare (fh, io_op);
+    if (NULL == data) {
+        opal_output(1, "OUT OF MEMORY\n");
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+
+    ret = mca_fbtl_uring_lock (data, (FBTL_URING_READ == io_op) ? F_RDLCK : F_WRLCK);
+    if ( 0 != ret ) {
+        opal_output(1, "mca_fbtl_uring_blocking_op: error in mca_fbtl_uring_lock() error ret=%d %s",
+                    ret, strerror(errno));
+        /* just in case some part of the lock worked */
+        mca_fbtl_uring_unlock (data);
+        mca_fbtl_uring_request_data_free (data);
+        return OMPI_ERROR;
+    }
+
+    /* all the ops which fit in the ring are submitted at once, the
+       others as soon as room is made by the completions */
+    while (0 != data->open_ops) {
+        if (OMPI_SUCCESS != mca_fbtl_uring_submit (data) ||
+            0 > mca_fbtl_uring_reap (true)) {
+            data->error = EIO;
+            break;
+        }
+    }
+    mca_fbtl_uring_unlock (data);
+
+    if (0 != data->error) {
+        opal_output(1, "mca_fbtl_uring_blocking_op: error in %s: %s",
+                    (FBTL_URING_READ == io_op) ? "read" : "write", strerror(data->error));
+        ret_code = OMPI_ERROR;
+    }
+    else {
+        ret_code = data->total_len;
+    }
+    mca_fbtl_uring_request_data_free (data);
+
+    return ret_code;
+}
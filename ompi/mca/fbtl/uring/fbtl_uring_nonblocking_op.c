@@ -0,0 +1,109 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+#include "fbtl_uring.h"
+
+#include <errno.h>
+#include <string.h>
+
+#include "mpi.h"
+#include "ompi/constants.h"
+#include "ompi/mca/fbtl/fbtl.h"
+
+static ssize_t mca_fbtl_uring_nonblocking_op (ompio_file_t *fh,
+                                              ompi_request_t *request, int io_op);
+
+ssize_t mca_fbtl_uring_ipreadv (ompio_file_t *fh, ompi_request_t *request)
+{
+    return mca_fbtl_uring_nonblocking_op(fh, request, FBTL_URING_READ);
+}
+
+ssize_t mca_fbtl_uring_ipwritev (ompio_file_t *fh, ompi_request_t *request)
+{
+    return mca_fbtl_uring_nonblocking_op(fh, request, FBTL_URING_WRITE);
+}
+
+static ssize_t mca_fbtl_uring_nonblocking_op (ompio_file_t *fh,
+                                              ompi_request_t *request, int io_op)
+{
+    mca_fbtl_uring_request_data_t *data;
+    mca_ompio_request_t *req = (mca_ompio_request_t *) request;
+    int ret;
+
+    data = mca_fbtl_uring_prepare (fh, io_op);
+    if (NULL == data) {
+        opal_output (1,"could not allocate memory\n");
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+
+    ret = mca_fbtl_uring_lock (data, (FBTL_URING_READ == io_op) ? F_RDLCK : F_WRLCK);
+    if ( 0 != ret ) {
+        opal_output(1, "mca_fbtl_uring_nonblocking_op: error in mca_fbtl_uring_lock() error ret=%d %s",
+                    ret, strerror(errno));
+        mca_fbtl_uring_unlock (data);
+        mca_fbtl_uring_request_data_free (data);
+        return OMPI_ERROR;
+    }
+
+    /* Errors of the submission are reported through the
+       request, since some ops might already be in flight. */
+    if (OMPI_SUCCESS != mca_fbtl_uring_submit (data) && 0 == data->error) {
+        data->error = EIO;
+        data->open_ops -= data->nops - data->next_op;
+        data->next_op   = data->nops;
+    }
+
+    req->req_data = data;
+    req->req_progress_fn = mca_fbtl_uring_progress;
+    req->req_free_fn     = mca_fbtl_uring_request_free;
+
+    return OMPI_SUCCESS;
+}
+
+bool mca_fbtl_uring_progress ( mca_ompio_request_t *req)
+{
+    mca_fbtl_uring_request_data_t *data = (mca_fbtl_uring_request_data_t *) req->req_data;
+
+    /* harvest the completions of all the requests at once */
+    if (0 != data->open_ops) {
+        if (0 > mca_fbtl_uring_reap (false) && 0 == data->error) {
+            data->error = EIO;
+        }
+    }
+
+    if (0 != data->open_ops && data->next_op < data->nops) {
+        (void) mca_fbtl_uring_submit (data);
+    }
+
+    if ( 0 == data->open_ops ) {
+        /* all pending operations are finished for this request */
+        req->req_ompi.req_status.MPI_ERROR = (0 == data->error) ? OMPI_SUCCESS : OMPI_ERROR;
+        req->req_ompi.req_status._ucount = data->total_len;
+        mca_fbtl_uring_unlock (data);
+        return true;
+    }
+
+    return false;
+}
+
+void mca_fbtl_uring_request_free ( mca_ompio_request_t *req)
+{
+    /* Free the fbtl specific data structures */
+    mca_fbtl_uring_request_data_t *data = (mca_fbtl_uring_request_data_t *) req->req_data;
+
+    if (NULL != data) {
+        mca_fbtl_uring_unlock (data);
+        mca_fbtl_uring_request_data_free (data);
+        req->req_data = NULL;
+    }
+}
@@ -0,0 +1,639 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/*
+ * A single io_uring instance is shared by all files opened with this
+ * component.  It is created when the first file is opened and torn
+ * down with the last one.  The ring is used through the raw system
+ * calls, so no library besides the kernel headers is required.
+ *
+ * The io_array of a request is turned into ops, one per run of
+ * entries which are contiguous in the file (a vectored read/write).
+ * As many ops as the ring can hold are queued and handed to the
+ * kernel with a single io_uring_enter().  Completions are harvested
+ * from the completion queue by whoever drives the progress: the
+ * blocking operations while they wait, and the OMPIO progress
+ * function for the nonblocking ones.  Each completion carries a
+ * pointer to its op, so the completions of all the requests can be
+ * harvested at once.
+ */
+
+#include "ompi_config.h"
+#include "fbtl_uring.h"
+
+#include <errno.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+
+#include "opal/sys/atomic.h"
+#include "opal/util/output.h"
+#include "ompi/constants.h"
+#include "ompi/mca/fbtl/base/base.h"
+
+typedef struct mca_fbtl_uring_ring_t {
+    int               fd;
+    unsigned          entries;
+    int               users;        /* number of files using the ring */
+
+    /* submission queue */
+    volatile unsigned *sq_head;
+    volatile unsigned *sq_tail;
+    unsigned          sq_mask;
+    unsigned          *sq_array;
+    struct io_uring_sqe *sqes;
+
+    /* completion queue */
+    volatile unsigned *cq_head;
+    volatile unsigned *cq_tail;
+    unsigned          cq_mask;
+    struct io_uring_cqe *cqes;
+
+    void              *sq_map;
+    size_t            sq_map_len;
+    void              *cq_map;
+    size_t            cq_map_len;
+    size_t            sqes_len;
+
+    unsigned          inflight;     /* submitted, not harvested */
+    unsigned          queued;       /* in the submission queue, not submitted */
+
+    /* registered buffers */
+    struct iovec      *bufs;
+    int               nbufs;
+    ompio_file_t      *bufs_owner;
+} mca_fbtl_uring_ring_t;
+
+static mca_fbtl_uring_ring_t mca_fbtl_uring_ring = {.fd = -1};
+static opal_mutex_t mca_fbtl_uring_ring_lock = OPAL_MUTEX_STATIC_INIT;
+
+static inline int uring_setup (unsigned entries, struct io_uring_params *p)
+{
+    return (int) syscall (__NR_io_uring_setup, entries, p);
+}
+
+static inline int uring_enter (int fd, unsigned to_submit, unsigned min_complete,
+                               unsigned flags)
+{
+    return (int) syscall (__NR_io_uring_enter, fd, to_submit, min_complete,
+                          flags, NULL, 0);
+}
+
+static inline int uring_register (int fd, unsigned opcode, const void *arg,
+                                  unsigned nr_args)
+{
+    return (int) syscall (__NR_io_uring_register, fd, opcode, arg, nr_args);
+}
+
+int mca_fbtl_uring_ring_probe (void)
+{
+    struct io_uring_params p;
+    int fd;
+
+    memset (&p, 0, sizeof (p));
+    fd = uring_setup (1, &p);
+    if (0 > fd) {
+        opal_output_verbose (10, ompi_fbtl_base_framework.framework_output,
+                             "fbtl:uring: io_uring is not available: %s",
+                             strerror (errno));
+        return OMPI_ERR_NOT_SUPPORTED;
+    }
+    close (fd);
+
+    return OMPI_SUCCESS;
+}
+
+static int ring_create (mca_fbtl_uring_ring_t *ring)
+{
+    struct io_uring_params p;
+    char *sq_ptr, *cq_ptr;
+
+    memset (&p, 0, sizeof (p));
+    ring->fd = uring_setup (mca_fbtl_uring_entries, &p);
+    if (0 > ring->fd) {
+        opal_output (1, "fbtl:uring: io_uring_setup failed: %s", strerror (errno));
+        return OMPI_ERROR;
+    }
+    ring->entries = p.sq_entries;
+
+    ring->sq_map_len = p.sq_off.array + p.sq_entries * sizeof (unsigned);
+    ring->cq_map_len = p.cq_off.cqes + p.cq_entries * sizeof (struct io_uring_cqe);
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+        if (ring->cq_map_len > ring->sq_map_len) {
+            ring->sq_map_len = ring->cq_map_len;
+        }
+        ring->cq_map_len = ring->sq_map_len;
+    }
+
+    ring->sq_map = mmap (NULL, ring->sq_map_len, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_SQ_RING);
+    if (MAP_FAILED == ring->sq_map) {
+        goto err_close;
+    }
+
+    if (p.features & IORING_FEAT_SINGLE_MMAP) {
+        ring->cq_map = ring->sq_map;
+    }
+    else {
+        ring->cq_map = mmap (NULL, ring->cq_map_len, PROT_READ | PROT_WRITE,
+                             MAP_SHARED | MAP_POPULATE, ring->fd, IORING_OFF_CQ_RING);
+        if (MAP_FAILED == ring->cq_map) {
+            munmap (ring->sq_map, ring->sq_map_len);
+            goto err_close;
+        }
+    }
+
+    ring->sqes_len = p.sq_entries * sizeof (struct io_uring_sqe);
+    ring->sqes = (struct io_uring_sqe *) mmap (NULL, ring->sqes_len, PROT_READ | PROT_WRITE,
+                                               MAP_SHARED | MAP_POPULATE, ring->fd,
+                                               IORING_OFF_SQES);
+    if (MAP_FAILED == ring->sqes) {
+        if (ring->cq_map != ring->sq_map) {
+            munmap (ring->cq_map, ring->cq_map_len);
+        }
+        munmap (ring->sq_map, ring->sq_map_len);
+        goto err_close;
+    }
+
+    sq_ptr = (char *) ring->sq_map;
+    ring->sq_head  = (volatile unsigned *) (sq_ptr + p.sq_off.head);
+    ring->sq_tail  = (volatile unsigned *) (sq_ptr + p.sq_off.tail);
+    ring->sq_mask  = *(unsigned *) (sq_ptr + p.sq_off.ring_mask);
+    ring->sq_array = (unsigned *) (sq_ptr + p.sq_off.array);
+
+    cq_ptr = (char *) ring->cq_map;
+    ring->cq_head  = (volatile unsigned *) (cq_ptr + p.cq_off.head);
+    ring->cq_tail  = (volatile unsigned *) (cq_ptr + p.cq_off.tail);
+    ring->cq_mask  = *(unsigned *) (cq_ptr + p.cq_off.ring_mask);
+    ring->cqes     = (struct io_uring_cqe *) (cq_ptr + p.cq_off.cqes);
+
+    ring->inflight   = 0;
+    ring->queued     = 0;
+    ring->bufs       = NULL;
+    ring->nbufs      = 0;
+    ring->bufs_owner = NULL;
+
+    opal_output_verbose (10, ompi_fbtl_base_framework.framework_output,
+                         "fbtl:uring: ring created with %u entries", ring->entries);
+    return OMPI_SUCCESS;
+
+ err_close:
+    opal_output (1, "fbtl:uring: could not map the ring: %s", strerror (errno));
+    close (ring->fd);
+    ring->fd = -1;
+    return OMPI_ERROR;
+}
+
+static void ring_destroy (mca_fbtl_uring_ring_t *ring)
+{
+    munmap (ring->sqes, ring->sqes_len);
+    if (ring->cq_map != ring->sq_map) {
+        munmap (ring->cq_map, ring->cq_map_len);
+    }
+    munmap (ring->sq_map, ring->sq_map_len);
+    close (ring->fd);
+    ring->fd = -1;
+}
+
+int mca_fbtl_uring_ring_retain (void)
+{
+    mca_fbtl_uring_ring_t *ring = &mca_fbtl_uring_ring;
+    int ret = OMPI_SUCCESS;
+
+    OPAL_THREAD_LOCK(&mca_fbtl_uring_ring_lock);
+    if (0 == ring->users) {
+        ret = ring_create (ring);
+    }
+    if (OMPI_SUCCESS == ret) {
+        ring->users++;
+    }
+    OPAL_THREAD_UNLOCK(&mca_fbtl_uring_ring_lock);
+
+    return ret;
+}
+
+void mca_fbtl_uring_ring_release (void)
+{
+    mca_fbtl_uring_ring_t *ring = &mca_fbtl_uring_ring;
+
+    OPAL_THREAD_LOCK(&mca_fbtl_uring_ring_lock);
+    if (0 == --ring->users) {
+        ring_destroy (ring);
+    }
+    OPAL_THREAD_UNLOCK(&mca_fbtl_uring_ring_lock);
+}
+
+/*
+ * Registered buffers.  Only one set of buffers (the one of the
+ * collective operation in progress) is registered at a time.
+ */
+int mca_fbtl_uring_ring_register_bufs (ompio_file_t *fh, const struct iovec *bufs, int count)
+{
+    mca_fbtl_uring_ring_t *ring = &mca_fbtl_uring_ring;
+    int ret = OMPI_SUCCESS;
+
+    OPAL_THREAD_LOCK(&mca_fbtl_uring_ring_lock);
+    if (NULL != ring->bufs) {
+        ret = OMPI_ERR_RESOURCE_BUSY;
+        goto out;
+    }
+
+    ring->bufs = (struct iovec *) malloc (count * sizeof (struct iovec));
+    if (NULL == ring->bufs) {
+        ret = OMPI_ERR_OUT_OF_RESOURCE;
+        goto out;
+    }
+    memcpy (ring->bufs, bufs, count * sizeof (struct iovec));
+
+    /* typically fails when the buffers exceed RLIMIT_MEMLOCK, the
+       operations then simply do not use them */
+    if (0 > uring_register (ring->fd, IORING_REGISTER_BUFFERS, ring->bufs, count)) {
+        opal_output_verbose (10, ompi_fbtl_base_framework.framework_output,
+                             "fbtl:uring: could not register %d buffers: %s",
+                             count, strerror (errno));
+        free (ring->bufs);
+        ring->bufs = NULL;
+        ret = OMPI_ERR_OUT_OF_RESOURCE;
+        goto out;
+    }
+    ring->nbufs = count;
+    ring->bufs_owner = fh;
+
+ out:
+    OPAL_THREAD_UNLOCK(&mca_fbtl_uring_ring_lock);
+    return ret;
+}
+
+void mca_fbtl_uring_ring_unregister_bufs (ompio_file_t *fh)
+{
+    mca_fbtl_uring_ring_t *ring = &mca_fbtl_uring_ring;
+
+    OPAL_THREAD_LOCK(&mca_fbtl_uring_ring_lock);
+    if (NULL != ring->bufs && fh == ring->bufs_owner) {
+        /* the buffers may be released while nothing is using them */
+        while (0 != ring->inflight) {
+            OPAL_THREAD_UNLOCK(&mca_fbtl_uring_ring_lock);
+            mca_fbtl_uring_reap (true);
+            OPAL_THREAD_LOCK(&mca_fbtl_uring_ring_lock);
+        }
+        (void) uring_register (ring->fd, IORING_UNREGISTER_BUFFERS, NULL, 0);
+        free (ring->bufs);
+        ring->bufs = NULL;
+        ring->nbufs = 0;
+        ring->bufs_owner = NULL;
+    }
+    OPAL_THREAD_UNLOCK(&mca_fbtl_uring_ring_lock);
+}
+
+static int ring_find_buf (mca_fbtl_uring_ring_t *ring, const struct iovec *iov)
+{
+    char *base = (char *) iov->iov_base;
+    int i;
+
+    for (i = 0; i < ring->nbufs; i++) {
+        char *start = (char *) ring->bufs[i].iov_base;
+
+        if (base >= start &&
+            base + iov->iov_len <= start + ring->bufs[i].iov_len) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+/*
+ * Preparation of the ops of a request
+ */
+static bool op_is_aligned (mca_fbtl_uring_op_t *op, size_t align)
+{
+    int i;
+
+    if (0 != (op->offset % align)) {
+        return false;
+    }
+    for (i = 0; i < op->iovcnt; i++) {
+        if (0 != ((uintptr_t) op->iov[i].iov_base % align) ||
+            0 != (op->iov[i].iov_len % align)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static int file_direct_fd (ompio_file_t *fh)
+{
+    mca_fbtl_uring_file_t *ufile = (mca_fbtl_uring_file_t *) fh->f_fbtl_data;
+    int flags;
+
+    if (!ufile->direct_tried) {
+        ufile->direct_tried = true;
+
+        /* the file exists at this point, so only the access mode matters */
+        flags = fcntl (fh->fd, F_GETFL);
+        if (-1 != flags) {
+            ufile->direct_fd = open (fh->f_filename, (flags & O_ACCMODE) | O_DIRECT);
+        }
+        if (-1 == ufile->direct_fd) {
+            opal_output_verbose (10, ompi_fbtl_base_framework.framework_output,
+                                 "fbtl:uring: could not open %s with O_DIRECT: %s",
+                                 fh->f_filename, strerror (errno));
+        }
+    }
+
+    return ufile->direct_fd;
+}
+
+mca_fbtl_uring_request_data_t *mca_fbtl_uring_prepare (ompio_file_t *fh, int req_type)
+{
+    mca_fbtl_uring_request_data_t *data;
+    mca_fbtl_uring_op_t *op = NULL;
+    struct iovec *iov = NULL;
+    int i, direct_fd = -1;
+    size_t align;
+
+    data = (mca_fbtl_uring_request_data_t *) malloc (sizeof (mca_fbtl_uring_request_data_t));
+    if (NULL == data) {
+        return NULL;
+    }
+    data->ops = (mca_fbtl_uring_op_t *) malloc (fh->f_num_of_io_entries *
+                                                sizeof (mca_fbtl_uring_op_t));
+    data->iovecs = (struct iovec *) malloc (fh->f_num_of_io_entries *
+                                            sizeof (struct iovec));
+    if (NULL == data->ops || NULL == data->iovecs) {
+        free (data->ops);
+        free (data->iovecs);
+        free (data);
+        return NULL;
+    }
+
+    data->req_type  = req_type;
+    data->nops      = 0;
+    data->next_op   = 0;
+    data->inflight  = 0;
+    data->error     = 0;
+    data->total_len = 0;
+    data->fh        = fh;
+    data->lock.l_start = -1;
+    data->lock.l_len   = -1;
+
+    /* Merge the entries which are contiguous in the file into a single
+       op, and the ones which are also contiguous in memory into a
+       single iovec. */
+    for (i = 0; i < fh->f_num_of_io_entries; i++) {
+        off_t offset  = (off_t)(intptr_t) fh->f_io_array[i].offset;
+        char *address = (char *) fh->f_io_array[i].memory_address;
+        size_t length = fh->f_io_array[i].length;
+
+        if (0 == length) {
+            continue;
+        }
+
+        if (NULL != op && (off_t)(op->offset + op->length) == offset) {
+            if ((char *) iov->iov_base + iov->iov_len == address) {
+                iov->iov_len += length;
+                op->length   += length;
+                continue;
+            }
+            if (op->iovcnt < mca_fbtl_uring_iov_max) {
+                iov++;
+                iov->iov_base = address;
+                iov->iov_len  = length;
+                op->iovcnt++;
+                op->length += length;
+                continue;
+            }
+        }
+
+        iov = (NULL == iov) ? data->iovecs : iov + 1;
+        iov->iov_base = address;
+        iov->iov_len  = length;
+
+        op = &data->ops[data->nops++];
+        op->data   = data;
+        op->iov    = iov;
+        op->iovcnt = 1;
+        op->offset = offset;
+        op->length = length;
+        op->fd     = fh->fd;
+    }
+
+    if (mca_fbtl_uring_direct && 0 < mca_fbtl_uring_direct_alignment) {
+        align = (size_t) mca_fbtl_uring_direct_alignment;
+        for (i = 0; i < data->nops; i++) {
+            if (op_is_aligned (&data->ops[i], align)) {
+                if (-1 == direct_fd && -1 == (direct_fd = file_direct_fd (fh))) {
+                    break;
+                }
+                data->ops[i].fd = direct_fd;
+            }
+        }
+    }
+
+    data->open_ops = data->nops;
+    return data;
+}
+
+void mca_fbtl_uring_request_data_free (mca_fbtl_uring_request_data_t *data)
+{
+    /* the kernel might still write into the ops */
+    while (0 != data->inflight) {
+        mca_fbtl_uring_reap (true);
+    }
+
+    free (data->ops);
+    free (data->iovecs);
+    free (data);
+}
+
+/*
+ * Submission.  Has to be called with the ring lock held.
+ */
+static void ring_queue_op (mca_fbtl_uring_ring_t *ring, mca_fbtl_uring_op_t *op)
+{
+    unsigned tail = *ring->sq_tail;
+    unsigned index = tail & ring->sq_mask;
+    struct io_uring_sqe *sqe = &ring->sqes[index];
+    int buf_index = -1;
+    bool read = (FBTL_URING_READ == op->data->req_type);
+
+    memset (sqe, 0, sizeof (*sqe));
+    if (1 == op->iovcnt && 0 != ring->nbufs && op->length <= UINT32_MAX) {
+        buf_index = ring_find_buf (ring, op->iov);
+    }
+    if (-1 != buf_index) {
+        sqe->opcode    = read ? IORING_OP_READ_FIXED : IORING_OP_WRITE_FIXED;
+        sqe->addr      = (uint64_t)(uintptr_t) op->iov->iov_base;
+        sqe->len       = (uint32_t) op->iov->iov_len;
+        sqe->buf_index = (uint16_t) buf_index;
+    }
+    else {
+        sqe->opcode    = read ? IORING_OP_READV : IORING_OP_WRITEV;
+        sqe->addr      = (uint64_t)(uintptr_t) op->iov;
+        sqe->len       = (uint32_t) op->iovcnt;
+    }
+    sqe->fd        = op->fd;
+    sqe->off       = (uint64_t) op->offset;
+    sqe->user_data = (uint64_t)(uintptr_t) op;
+
+    ring->sq_array[index] = index;
+    opal_atomic_wmb ();
+    *ring->sq_tail = tail + 1;
+
+    ring->queued++;
+    ring->inflight++;
+    op->data->inflight++;
+}
+
+static int ring_flush (mca_fbtl_uring_ring_t *ring, unsigned min_complete)
+{
+    unsigned flags = (0 < min_complete) ? IORING_ENTER_GETEVENTS : 0;
+    int ret;
+
+    while (0 < ring->queued || 0 < min_complete) {
+        ret = uring_enter (ring->fd, ring->queued, min_complete, flags);
+        if (0 > ret) {
+            if (EINTR == errno) {
+                continue;
+            }
+            if (EAGAIN == errno || EBUSY == errno) {
+                /* the kernel is short of resources, or the completion
+                   queue has to be drained first */
+                if (0 == ring->inflight - ring->queued) {
+                    continue;
+                }
+                return OMPI_SUCCESS;
+            }
+            opal_output (1, "fbtl:uring: io_uring_enter failed: %s", strerror (errno));
+            return OMPI_ERROR;
+        }
+        ring->queued -= ret;
+        min_complete = 0;
+        flags = 0;
+    }
+
+    return OMPI_SUCCESS;
+}
+
+int mca_fbtl_uring_submit (mca_fbtl_uring_request_data_t *data)
+{
+    mca_fbtl_uring_ring_t *ring = &mca_fbtl_uring_ring;
+    int ret;
+
+    OPAL_THREAD_LOCK(&mca_fbtl_uring_ring_lock);
+    while (data->next_op < data->nops && ring->inflight < ring->entries) {
+        ring_queue_op (ring, &data->ops[data->next_op++]);
+    }
+    ret = ring_flush (ring, 0);
+    OPAL_THREAD_UNLOCK(&mca_fbtl_uring_ring_lock);
+
+    return ret;
+}
+
+static void op_complete (mca_fbtl_uring_op_t *op, int error)
+{
+    mca_fbtl_uring_request_data_t *data = op->data;
+
+    if (0 != error && 0 == data->error) {
+        data->error = error;
+        /* do not start what is left of the request */
+        data->open_ops -= data->nops - data->next_op;
+        data->next_op   = data->nops;
+    }
+    data->open_ops--;
+}
+
+/* Advance the op past the res bytes which were transferred. */
+static void op_advance (mca_fbtl_uring_op_t *op, size_t res)
+{
+    op->offset += res;
+    op->length -= res;
+    while (res >= op->iov->iov_len) {
+        res -= op->iov->iov_len;
+        op->iov++;
+        op->iovcnt--;
+    }
+    op->iov->iov_base = (char *) op->iov->iov_base + res;
+    op->iov->iov_len -= res;
+}
+
+/*
+ * Harvest the completion queue, optionally waiting for at least one
+ * completion if nothing is there yet.  Returns the number of ops
+ * completed.
+ */
+int mca_fbtl_uring_reap (bool wait)
+{
+    mca_fbtl_uring_ring_t *ring = &mca_fbtl_uring_ring;
+    unsigned head, tail;
+    int completed = 0;
+
+    OPAL_THREAD_LOCK(&mca_fbtl_uring_ring_lock);
+    head = *ring->cq_head;
+    tail = *ring->cq_tail;
+    opal_atomic_rmb ();
+
+    if (head == tail && wait && 0 != ring->inflight) {
+        if (OMPI_SUCCESS != ring_flush (ring, 1)) {
+            OPAL_THREAD_UNLOCK(&mca_fbtl_uring_ring_lock);
+            return OMPI_ERROR;
+        }
+        tail = *ring->cq_tail;
+        opal_atomic_rmb ();
+    }
+
+    while (head != tail) {
+        struct io_uring_cqe *cqe = &ring->cqes[head & ring->cq_mask];
+        mca_fbtl_uring_op_t *op = (mca_fbtl_uring_op_t *)(uintptr_t) cqe->user_data;
+        int res = cqe->res;
+
+        head++;
+        ring->inflight--;
+        op->data->inflight--;
+
+        if (0 > res) {
+            if (-EINTR == res || -EAGAIN == res) {
+                ring_queue_op (ring, op);
+                continue;
+            }
+            op_complete (op, -res);
+        }
+        else {
+            op->data->total_len += res;
+            if (0 < res && (size_t) res < op->length) {
+                /* short transfer, queue what is left. The rest of an
+                   O_DIRECT op is no longer aligned, e.g. at the end of
+                   the file, so it continues on the regular descriptor */
+                op_advance (op, (size_t) res);
+                op->fd = op->data->fh->fd;
+                ring_queue_op (ring, op);
+                continue;
+            }
+            /* a read returns 0 at the end of the file */
+            op_complete (op, (0 == res && FBTL_URING_WRITE == op->data->req_type) ? EIO : 0);
+        }
+        completed++;
+    }
+
+    opal_atomic_mb ();
+    *ring->cq_head = head;
+
+    /* resubmit what was requeued */
+    if (OMPI_SUCCESS != ring_flush (ring, 0)) {
+        completed = OMPI_ERROR;
+    }
+    OPAL_THREAD_UNLOCK(&mca_fbtl_uring_ring_lock);
+
+    return completed;
+}
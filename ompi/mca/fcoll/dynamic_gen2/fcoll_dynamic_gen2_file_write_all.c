@@ -94,7 +94,8 @@ static int shuffle_init ( int index, int cycles, int aggregator, int rank,
                           ompi_request_t **reqs );
 static int write_init (ompio_file_t *fh, int aggregator, mca_io_ompio_aggregator_data *aggr_data, int write_chunksize );
 
-int mca_fcoll_dynamic_gen2_break_file_view ( struct iovec *decoded_iov, int iov_count, 
+int mca_fcoll_dynamic_gen2_break_file_view ( ompio_file_t *fh,
+                                        struct iovec *decoded_iov, int iov_count, 
                                         struct iovec *local_iov_array, int local_count, 
                                         struct iovec ***broken_decoded_iovs, int **broken_iov_counts,
                                         struct iovec ***broken_iov_arrays, int **broken_counts, 
@@ -245,7 +246,7 @@ int mca_fcoll_dynamic_gen2_file_write_all (ompio_file_t *fh,
      *************************************************************************/
     // broken_iov_arrays[0] contains broken_counts[0] entries to aggregator 0,
     // broken_iov_arrays[1] contains broken_counts[1] entries to aggregator 1, etc.
-    ret = mca_fcoll_dynamic_gen2_break_file_view ( decoded_iov, iov_count, 
+    ret = mca_fcoll_dynamic_gen2_break_file_view ( fh, decoded_iov, iov_count, 
                                               local_iov_array, local_count, 
                                               &broken_decoded_iovs, &broken_iov_counts,
                                               &broken_iov_arrays, &broken_counts, 
@@ -1324,7 +1325,8 @@ exit:
     
     
 
-int mca_fcoll_dynamic_gen2_break_file_view ( struct iovec *mem_iov, int mem_count, 
+int mca_fcoll_dynamic_gen2_break_file_view ( ompio_file_t *fh,
+                                        struct iovec *mem_iov, int mem_count, 
                                         struct iovec *file_iov, int file_count, 
                                         struct iovec ***ret_broken_mem_iovs, int **ret_broken_mem_counts,
                                         struct iovec ***ret_broken_file_iovs, int **ret_broken_file_counts, 
@@ -1402,7 +1404,12 @@ int mca_fcoll_dynamic_gen2_break_file_view ( struct iovec *mem_iov, int mem_coun
                file_iov[i].iov_base, file_iov[i].iov_len);
 #endif
         do {
-            owner        = (offset / stripe_size ) % stripe_count;
+            if ( 1 < fh->f_stripe_count ) {
+                owner    = mca_common_ompio_stripe_owner (fh, offset, stripe_count);
+            }
+            else {
+                owner    = (offset / stripe_size ) % stripe_count;
+            }
             start_offset = (offset / stripe_size );
             rest         = (start_offset + 1) * stripe_size - offset;
 
@@ -1567,6 +1574,8 @@ int mca_fcoll_dynamic_gen2_get_configuration (ompio_file_t *fh, int *dynamic_gen
     if ( num_io_procs > fh->f_size ) {
         num_io_procs = fh->f_size;
     }
+    /* each OST has to map onto a fixed set of aggregators */
+    num_io_procs = mca_common_ompio_stripe_aggregators (fh, num_io_procs);
 
     fh->f_procs_per_group = fh->f_size;
     fh->f_procs_in_group = (int *) malloc ( sizeof(int) * fh->f_size );
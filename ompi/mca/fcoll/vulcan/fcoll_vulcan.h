@@ -29,6 +29,7 @@
 #include "ompi/mca/fcoll/fcoll.h"
 #include "ompi/mca/fcoll/base/base.h"
 #include "ompi/mca/common/ompio/common_ompio.h"
+#include "opal/mca/shmem/shmem.h"
 
 BEGIN_C_DECLS
 
@@ -38,9 +39,26 @@ extern int mca_fcoll_vulcan_priority;
 extern int mca_fcoll_vulcan_num_groups;
 extern int mca_fcoll_vulcan_write_chunksize;
 extern int mca_fcoll_vulcan_async_io;
+extern int mca_fcoll_vulcan_node_aggregation;
+extern int mca_fcoll_vulcan_node_buffer_size;
+extern int mca_fcoll_vulcan_stripe_aware;
 
 OMPI_MODULE_DECLSPEC extern mca_fcoll_base_component_2_0_0_t mca_fcoll_vulcan_component;
 
+/* Per file data for the node level aggregation, hung off fh->f_fcoll_data */
+typedef struct mca_fcoll_vulcan_node_data_t {
+    struct ompi_communicator_t *node_comm;
+    int                         node_rank;
+    int                         node_size;
+    /* ranks in fh->f_comm of the node leaders */
+    int                        *leaders;
+    int                         num_leaders;
+    opal_shmem_ds_t             seg_ds;
+    char                       *seg_base;
+    size_t                      seg_size;
+    int                         seg_id;
+} mca_fcoll_vulcan_node_data_t;
+
 /* API functions */
 
 int mca_fcoll_vulcan_component_init_query(bool enable_progress_threads,
@@ -66,6 +84,29 @@ int mca_fcoll_vulcan_file_write_all (ompio_file_t *fh,
                                      struct ompi_datatype_t *datatype,
                                      ompi_status_public_t * status);
 
+int mca_fcoll_vulcan_file_iread_all (ompio_file_t *fh,
+                                     void *buf,
+                                     int count,
+                                     struct ompi_datatype_t *datatype,
+                                     ompi_request_t **request);
+
+int mca_fcoll_vulcan_file_iwrite_all (ompio_file_t *fh,
+                                      const void *buf,
+                                      int count,
+                                      struct ompi_datatype_t *datatype,
+                                      ompi_request_t **request);
+
+/* nonblocking collective operations, advanced by the ompio progress function */
+bool mca_fcoll_vulcan_read_progress (struct mca_ompio_request_t *req);
+bool mca_fcoll_vulcan_write_progress (struct mca_ompio_request_t *req);
+void mca_fcoll_vulcan_wait_pending (ompio_file_t *fh);
+
+/* node level aggregation */
+int mca_fcoll_vulcan_node_aggregators (ompio_file_t *fh);
+int mca_fcoll_vulcan_node_gather (ompio_file_t *fh,
+                                  struct iovec **decoded_iov, uint32_t *iov_count,
+                                  struct iovec **local_iov_array, int *local_count);
+void mca_fcoll_vulcan_node_release (ompio_file_t *fh);
 
 END_C_DECLS
 
@@ -44,6 +44,9 @@ int mca_fcoll_vulcan_priority = 10;
 int mca_fcoll_vulcan_num_groups = 1;
 int mca_fcoll_vulcan_write_chunksize = -1;
 int mca_fcoll_vulcan_async_io = 0;
+int mca_fcoll_vulcan_node_aggregation = 0;
+int mca_fcoll_vulcan_node_buffer_size = 268435456;
+int mca_fcoll_vulcan_stripe_aware = 1;
 
 /*
  * Local function
@@ -111,5 +114,31 @@ vulcan_register(void)
                                            OPAL_INFO_LVL_9,
                                            MCA_BASE_VAR_SCOPE_READONLY, &mca_fcoll_vulcan_async_io);
 
+    mca_fcoll_vulcan_node_aggregation = 0;
+    (void) mca_base_component_var_register(&mca_fcoll_vulcan_component.fcollm_version,
+                                           "node_aggregation", "Node level aggregation for collective writes. 0: disabled (default) "
+                                           "1: processes on the same node hand their data to the node leader through shared memory, "
+                                           "only node leaders take part in the shuffle and act as aggregators.",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY, &mca_fcoll_vulcan_node_aggregation);
+
+    mca_fcoll_vulcan_node_buffer_size = 268435456;
+    (void) mca_base_component_var_register(&mca_fcoll_vulcan_component.fcollm_version,
+                                           "node_buffer_size", "Maximum size of the shared memory segment used per node "
+                                           "for node level aggregation. Larger operations bypass the node aggregation. Default: 256MB",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY, &mca_fcoll_vulcan_node_buffer_size);
+
+    mca_fcoll_vulcan_stripe_aware = 1;
+    (void) mca_base_component_var_register(&mca_fcoll_vulcan_component.fcollm_version,
+                                           "stripe_aware", "File domains of collective writes based on the layout reported "
+                                           "by the fs component. 0: disabled 1: file domains are aligned to the stripe size, "
+                                           "and for striped files all stripes of an OST are assigned to the same aggregators (default)",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY, &mca_fcoll_vulcan_stripe_aware);
+
     return OMPI_SUCCESS;
 }
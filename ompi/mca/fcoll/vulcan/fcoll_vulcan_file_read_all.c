@@ -28,11 +28,13 @@
 #include "ompi/mca/fcoll/base/fcoll_base_coll_array.h"
 #include "ompi/mca/common/ompio/common_ompio.h"
 #include "ompi/mca/io/io.h"
+#include "ompi/mca/common/ompio/common_ompio_request.h"
 #include "math.h"
 #include "ompi/mca/pml/pml.h"
 #include <unistd.h>
 
 #define DEBUG_ON 0
+#define FCOLL_VULCAN_SCATTER_TAG 123
 
 /*Used for loading file-offsets per aggregator*/
 typedef struct mca_io_ompio_local_io_array{
@@ -41,11 +43,75 @@ typedef struct mca_io_ompio_local_io_array{
     int                  process_id;
 }mca_io_ompio_local_io_array;
 
+/* State of the walk through the sorted global file view, shared
+   by all cycles */
+typedef struct mca_io_ompio_read_data {
+    struct iovec *global_iov_array;
+    int *sorted, *fview_count;
+    int current_index;
+    MPI_Aint bytes_remaining, total_bytes, bytes_per_cycle;
+} mca_io_ompio_read_data;
+
+/* Everything belonging to one cycle. Two of these are used
+   alternately, such that the file can be read for cycle n+1 while
+   the data of cycle n is being scattered. */
+typedef struct mca_io_ompio_read_cycle_data {
+    int *disp_index;
+    int **blocklen_per_process;
+    MPI_Aint **displs_per_process;
+    char *global_buf;
+    mca_io_ompio_local_io_array *file_offsets_for_agg;
+    int *sorted_file_offsets;
+    MPI_Aint *memory_displacements;
+    int entries_per_aggregator;
+    mca_common_ompio_io_array_t *io_array;
+    int num_io_entries;
+    int bytes_received;
+    ompi_request_t *req_iread;
+} mca_io_ompio_read_cycle_data;
+
+
+/* State of a nonblocking collective read, hung off the ompio request.
+   The file handle has to be the first element, see
+   mca_fcoll_vulcan_wait_pending. */
+typedef struct mca_io_ompio_read_state {
+    ompio_file_t *fh;
+    char *buf;
+    struct iovec *decoded_iov;
+    bool recvbuf_is_contiguous;
+    int iov_index;
+    size_t current_position;
+    MPI_Aint position;
+    mca_io_ompio_read_data rd;
+    mca_io_ompio_read_cycle_data cycle_data[2];
+    ompi_datatype_t **sendtype;
+    MPI_Request *send_req, recv_req;
+    char *receive_buf;
+    int my_aggregator, procs_per_group;
+    int index, cycles, read_synch_type;
+    /* true while the data of cycle index is being scattered */
+    bool scattering;
+    int error;
+} mca_io_ompio_read_state;
 
 static int read_heap_sort (mca_io_ompio_local_io_array *io_array,
                            int num_entries,
                            int *sorted);
 
+static int read_all (ompio_file_t *fh, void *buf, int count,
+                     struct ompi_datatype_t *datatype, ompi_status_public_t *status,
+                     mca_ompio_request_t *ompio_req);
+static int read_scatter_start (mca_io_ompio_read_state *rs);
+static void read_state_free (mca_ompio_request_t *ompio_req);
+static void unpack_cycle (struct iovec *decoded_iov, int *iov_index, size_t *current_position,
+                          char *receive_buf, size_t bytes);
+
+static int read_prepare_cycle (ompio_file_t *fh, int index, int cycles, int my_aggregator,
+                               mca_io_ompio_read_data *rd, mca_io_ompio_read_cycle_data *cd);
+static int read_init (ompio_file_t *fh, mca_io_ompio_read_cycle_data *cd, int read_synch_type);
+static int scatter_init (ompio_file_t *fh, mca_io_ompio_read_cycle_data *cd,
+                         ompi_datatype_t **sendtype, MPI_Request *send_req);
+
 
 
 int
@@ -54,20 +120,246 @@ mca_fcoll_vulcan_file_read_all (ompio_file_t *fh,
                                  int count,
                                  struct ompi_datatype_t *datatype,
                                  ompi_status_public_t *status)
+{
+    mca_fcoll_vulcan_wait_pending (fh);
+    return read_all (fh, buf, count, datatype, status, NULL);
+}
+
+int
+mca_fcoll_vulcan_file_iread_all (ompio_file_t *fh,
+                                  void *buf,
+                                  int count,
+                                  struct ompi_datatype_t *datatype,
+                                  ompi_request_t **request)
+{
+    mca_ompio_request_t *ompio_req = NULL;
+    int ret;
+
+    mca_fcoll_vulcan_wait_pending (fh);
+
+    mca_common_ompio_request_alloc ( &ompio_req, MCA_OMPIO_REQUEST_READ_ALL );
+    ompio_req->req_ompi.req_status.MPI_ERROR = OMPI_SUCCESS;
+    mca_common_ompio_register_progress ();
+
+    ret = read_all (fh, buf, count, datatype, &ompio_req->req_ompi.req_status, ompio_req);
+    if ( OMPI_SUCCESS != ret || NULL == ompio_req->req_progress_fn ) {
+        ompio_req->req_ompi.req_status.MPI_ERROR = ret;
+        ompi_request_complete (&ompio_req->req_ompi, false);
+    }
+
+    *request = (ompi_request_t *) ompio_req;
+    return ret;
+}
+
+/*
+  Advance a nonblocking collective read. Called from the ompio progress
+  function; returns true once the data of the last cycle has been
+  received. A cycle goes through two steps: waiting for the file read
+  on the aggregator, then scattering the data to the group while the
+  read of the next cycle is in flight.
+*/
+bool mca_fcoll_vulcan_read_progress (mca_ompio_request_t *ompio_req)
+{
+    mca_io_ompio_read_state *rs = (mca_io_ompio_read_state *) ompio_req->req_data;
+    ompio_file_t *fh = rs->fh;
+    mca_io_ompio_read_cycle_data *cd;
+    int i, ret;
+
+    while ( rs->index < rs->cycles ) {
+        cd = &rs->cycle_data[rs->index%2];
+
+        if ( !rs->scattering ) {
+            /* no ompi_request_wait here, we are called from within opal_progress */
+            if ( !REQUEST_COMPLETE(cd->req_iread) ) {
+                return false;
+            }
+            if ( MPI_REQUEST_NULL != cd->req_iread ) {
+                ret = cd->req_iread->req_status.MPI_ERROR;
+                ompi_request_free (&cd->req_iread);
+                if ( OMPI_SUCCESS != ret ) {
+                    opal_output (1, "READ FAILED\n");
+                    rs->error = ret;
+                    goto done;
+                }
+            }
+            ret = read_scatter_start (rs);
+            if ( OMPI_SUCCESS != ret ) {
+                rs->error = ret;
+                goto done;
+            }
+            rs->scattering = true;
+        }
+
+        if ( rs->my_aggregator == fh->f_rank ) {
+            for ( i=0; i<rs->procs_per_group; i++ ) {
+                if ( !REQUEST_COMPLETE(rs->send_req[i]) ) {
+                    return false;
+                }
+            }
+        }
+        if ( !REQUEST_COMPLETE(rs->recv_req) ) {
+            return false;
+        }
+
+        if ( rs->my_aggregator == fh->f_rank ) {
+            for ( i=0; i<rs->procs_per_group; i++ ) {
+                if ( MPI_REQUEST_NULL != rs->send_req[i] ) {
+                    if ( OMPI_SUCCESS == rs->error ) {
+                        rs->error = rs->send_req[i]->req_status.MPI_ERROR;
+                    }
+                    ompi_request_free (&rs->send_req[i]);
+                }
+            }
+        }
+        if ( OMPI_SUCCESS == rs->error ) {
+            rs->error = rs->recv_req->req_status.MPI_ERROR;
+        }
+        ompi_request_free (&rs->recv_req);
+        if ( OMPI_SUCCESS != rs->error ) {
+            goto done;
+        }
+
+        rs->position += cd->bytes_received;
+        if ( !rs->recvbuf_is_contiguous ) {
+            unpack_cycle (rs->decoded_iov, &rs->iov_index, &rs->current_position,
+                          rs->receive_buf, cd->bytes_received);
+            free (rs->receive_buf);
+            rs->receive_buf = NULL;
+        }
+        rs->scattering = false;
+        rs->index++;
+    }
+
+done:
+    ompio_req->req_ompi.req_status.MPI_ERROR = rs->error;
+    read_state_free (ompio_req);
+    return true;
+}
+
+/*
+  Nonblocking read, cycle rs->index has been read: start reading the
+  next cycle and post the scatter of this one.
+*/
+static int read_scatter_start (mca_io_ompio_read_state *rs)
+{
+    ompio_file_t *fh = rs->fh;
+    mca_io_ompio_read_cycle_data *cd = &rs->cycle_data[rs->index%2];
+    int ret;
+
+    if (rs->index+1 < rs->cycles) {
+        ret = read_prepare_cycle (fh, rs->index+1, rs->cycles, rs->my_aggregator, &rs->rd,
+                                  &rs->cycle_data[(rs->index+1)%2]);
+        if (OMPI_SUCCESS != ret){
+            return ret;
+        }
+        if (rs->my_aggregator == fh->f_rank) {
+            ret = read_init (fh, &rs->cycle_data[(rs->index+1)%2], rs->read_synch_type);
+            if (OMPI_SUCCESS != ret){
+                return ret;
+            }
+        }
+    }
+
+    if (rs->my_aggregator == fh->f_rank) {
+        ret = scatter_init (fh, cd, rs->sendtype, rs->send_req);
+        if (OMPI_SUCCESS != ret){
+            return ret;
+        }
+    }
+
+    if ( rs->recvbuf_is_contiguous ) {
+        rs->receive_buf = rs->buf + rs->position;
+    }
+    else if (cd->bytes_received) {
+        rs->receive_buf = malloc (cd->bytes_received);
+        if (NULL == rs->receive_buf) {
+            opal_output (1, "OUT OF MEMORY\n");
+            return OMPI_ERR_OUT_OF_RESOURCE;
+        }
+    }
+
+    return MCA_PML_CALL(irecv(rs->receive_buf,
+                              cd->bytes_received,
+                              MPI_BYTE,
+                              rs->my_aggregator,
+                              FCOLL_VULCAN_SCATTER_TAG,
+                              fh->f_comm,
+                              &rs->recv_req));
+}
+
+static void read_state_free (mca_ompio_request_t *ompio_req)
+{
+    mca_io_ompio_read_state *rs = (mca_io_ompio_read_state *) ompio_req->req_data;
+    mca_io_ompio_read_cycle_data *cd;
+    int i, k, l;
+
+    if ( NULL == rs || NULL == rs->fh ) {
+        return;
+    }
+
+    if ( MPI_REQUEST_NULL != rs->recv_req ) {
+        ompi_request_free (&rs->recv_req);
+    }
+    if ( !rs->recvbuf_is_contiguous ) {
+        free (rs->receive_buf);
+    }
+    free (rs->rd.sorted);
+    free (rs->rd.global_iov_array);
+    free (rs->rd.fview_count);
+    free (rs->decoded_iov);
+
+    if ( rs->my_aggregator == rs->fh->f_rank ) {
+        for (k=0; k<2; k++) {
+            cd = &rs->cycle_data[k];
+            if (MPI_REQUEST_NULL != cd->req_iread) {
+                ompi_request_free (&cd->req_iread);
+            }
+            free (cd->global_buf);
+            free (cd->sorted_file_offsets);
+            free (cd->file_offsets_for_agg);
+            free (cd->memory_displacements);
+            free (cd->io_array);
+            free (cd->disp_index);
+            if ( NULL != cd->blocklen_per_process){
+                for(l=0;l<rs->procs_per_group;l++){
+                    free(cd->blocklen_per_process[l]);
+                }
+                free(cd->blocklen_per_process);
+            }
+            if (NULL != cd->displs_per_process){
+                for (l=0; l<rs->procs_per_group; l++){
+                    free(cd->displs_per_process[l]);
+                }
+                free(cd->displs_per_process);
+            }
+        }
+        for (i = 0; i < rs->procs_per_group; i++) {
+            if ( MPI_REQUEST_NULL != rs->send_req[i] ) {
+                ompi_request_free (&rs->send_req[i]);
+            }
+            if ( MPI_DATATYPE_NULL != rs->sendtype[i] ) {
+                ompi_datatype_destroy(&rs->sendtype[i]);
+            }
+        }
+        free (rs->sendtype);
+        free (rs->send_req);
+    }
+    rs->fh = NULL;
+}
+
+static int read_all (ompio_file_t *fh,
+                     void *buf,
+                     int count,
+                     struct ompi_datatype_t *datatype,
+                     ompi_status_public_t *status,
+                     mca_ompio_request_t *ompio_req)
 {
     MPI_Aint position = 0;
     MPI_Aint total_bytes = 0;          /* total bytes to be read */
-    MPI_Aint bytes_to_read_in_cycle = 0; /* left to be read in a cycle*/
     MPI_Aint bytes_per_cycle = 0;      /* total read in each cycle by each process*/
     int index = 0, ret=OMPI_SUCCESS;
     int cycles = 0;
-    int i=0, j=0, l=0;
-    int n=0; /* current position in total_bytes_per_process array */
-    MPI_Aint bytes_remaining = 0; /* how many bytes have been read from the current
-                                     value from total_bytes_per_process */
-    int *sorted_file_offsets=NULL, entries_per_aggregator=0;
-    int bytes_received = 0;
-    int blocks = 0;
+    int i=0, l=0, k=0;
     /* iovec structure and count of the buffer passed in */
     uint32_t iov_count = 0;
     struct iovec *decoded_iov = NULL;
@@ -75,18 +367,16 @@ mca_fcoll_vulcan_file_read_all (ompio_file_t *fh,
     size_t current_position = 0;
     struct iovec *local_iov_array=NULL, *global_iov_array=NULL;
     char *receive_buf = NULL;
-    MPI_Aint *memory_displacements=NULL;
     /* global iovec at the readers that contain the iovecs created from
        file_set_view */
     uint32_t total_fview_count = 0;
     int local_count = 0;
-    int *fview_count = NULL, *disp_index=NULL, *temp_disp_index=NULL;
-    int current_index=0, temp_index=0;
-    int **blocklen_per_process=NULL;
-    MPI_Aint **displs_per_process=NULL;
-    char *global_buf = NULL;
-    MPI_Aint global_count = 0;
-    mca_io_ompio_local_io_array *file_offsets_for_agg=NULL;
+    int *fview_count = NULL;
+    mca_io_ompio_read_data rd;
+    mca_io_ompio_read_cycle_data cycle_data[2], *cd=NULL;
+    bool bufs_registered = false;
+    int read_synch_type = 0;
+    mca_io_ompio_read_state *rs = NULL;
 
     /* array that contains the sorted indices of the global_iov */
     int *sorted = NULL;
@@ -100,6 +390,7 @@ mca_fcoll_vulcan_file_read_all (ompio_file_t *fh,
     bool recvbuf_is_contiguous=false;
     size_t ftype_size;
     ptrdiff_t ftype_extent, lb;
+    uint64_t stats_start;
 
 
 #if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
@@ -109,6 +400,11 @@ mca_fcoll_vulcan_file_read_all (ompio_file_t *fh,
     mca_common_ompio_print_entry nentry;
 #endif
 
+    for (k=0; k<2; k++) {
+        memset (&cycle_data[k], 0, sizeof(mca_io_ompio_read_cycle_data));
+        cycle_data[k].req_iread = MPI_REQUEST_NULL;
+    }
+
     /**************************************************************************
      ** 1. In case the data is not contigous in memory, decode it into an iovec
      **************************************************************************/
@@ -150,6 +446,12 @@ mca_fcoll_vulcan_file_read_all (ompio_file_t *fh,
         goto exit;
     }
 
+    if( (1 == mca_fcoll_vulcan_async_io) && (NULL == fh->f_fbtl->fbtl_ipreadv) ) {
+        opal_output (1, "vulcan_read_all: fbtl Does NOT support ipreadv() (asynchrounous read) \n");
+        ret = MPI_ERR_UNSUPPORTED_OPERATION;
+        goto exit;
+    }
+
     ret = mca_common_ompio_set_aggregator_props ((struct ompio_file_t *) fh,
                                                  vulcan_num_io_procs,
                                                  max_data);
@@ -338,34 +640,49 @@ mca_fcoll_vulcan_file_read_all (ompio_file_t *fh,
      *** 6. Determine the number of cycles required to execute this
      ***    operation
      *************************************************************/
-    bytes_per_cycle = fh->f_bytes_per_agg;
+    /* since we want to overlap 2 iterations, define the bytes_per_cycle to be half of what
+       the user requested */
+    bytes_per_cycle = fh->f_bytes_per_agg/2;
     cycles = ceil((double)total_bytes/bytes_per_cycle);
 
+    rd.global_iov_array = global_iov_array;
+    rd.sorted           = sorted;
+    rd.fview_count      = fview_count;
+    rd.current_index    = 0;
+    rd.bytes_remaining  = 0;
+    rd.total_bytes      = total_bytes;
+    rd.bytes_per_cycle  = bytes_per_cycle;
+
     if ( my_aggregator == fh->f_rank) {
-      disp_index = (int *)malloc (fh->f_procs_per_group * sizeof (int));
-      if (NULL == disp_index) {
-            opal_output (1, "OUT OF MEMORY\n");
-            ret = OMPI_ERR_OUT_OF_RESOURCE;
-            goto exit;
-        }
+        for (k=0; k<2; k++) {
+            cd = &cycle_data[k];
+            cd->disp_index = (int *)malloc (fh->f_procs_per_group * sizeof (int));
+            if (NULL == cd->disp_index) {
+                opal_output (1, "OUT OF MEMORY\n");
+                ret = OMPI_ERR_OUT_OF_RESOURCE;
+                goto exit;
+            }
 
-        blocklen_per_process = (int **)malloc (fh->f_procs_per_group * sizeof (int*));
-        if (NULL == blocklen_per_process) {
-            opal_output (1, "OUT OF MEMORY\n");
-            ret = OMPI_ERR_OUT_OF_RESOURCE;
-            goto exit;
-        }
+            cd->blocklen_per_process = (int **)calloc (fh->f_procs_per_group, sizeof (int*));
+            if (NULL == cd->blocklen_per_process) {
+                opal_output (1, "OUT OF MEMORY\n");
+                ret = OMPI_ERR_OUT_OF_RESOURCE;
+                goto exit;
+            }
 
-        displs_per_process = (MPI_Aint **)malloc (fh->f_procs_per_group * sizeof (MPI_Aint*));
-        if (NULL == displs_per_process){
-            opal_output (1, "OUT OF MEMORY\n");
-            ret = OMPI_ERR_OUT_OF_RESOURCE;
-            goto exit;
-        }
+            cd->displs_per_process = (MPI_Aint **)calloc (fh->f_procs_per_group, sizeof (MPI_Aint*));
+            if (NULL == cd->displs_per_process){
+                opal_output (1, "OUT OF MEMORY\n");
+                ret = OMPI_ERR_OUT_OF_RESOURCE;
+                goto exit;
+            }
 
-        for (i=0;i<fh->f_procs_per_group;i++){
-            blocklen_per_process[i] = NULL;
-            displs_per_process[i] = NULL;
+            cd->global_buf = (char *) malloc (bytes_per_cycle);
+            if (NULL == cd->global_buf){
+                opal_output(1, "OUT OF MEMORY\n");
+                ret = OMPI_ERR_OUT_OF_RESOURCE;
+                goto exit;
+            }
         }
 
 	send_req = (MPI_Request *) malloc (fh->f_procs_per_group * sizeof(MPI_Request));
@@ -375,13 +692,6 @@ mca_fcoll_vulcan_file_read_all (ompio_file_t *fh,
 	    goto exit;
 	}
 
-	global_buf = (char *) malloc (bytes_per_cycle);
-	if (NULL == global_buf){
-	    opal_output(1, "OUT OF MEMORY\n");
-	    ret = OMPI_ERR_OUT_OF_RESOURCE;
-	    goto exit;
-	}
-
 	sendtype = (ompi_datatype_t **) malloc (fh->f_procs_per_group * sizeof(ompi_datatype_t *));
 	if (NULL == sendtype) {
             opal_output (1, "OUT OF MEMORY\n");
@@ -392,395 +702,185 @@ mca_fcoll_vulcan_file_read_all (ompio_file_t *fh,
 	for(l=0;l<fh->f_procs_per_group;l++){
             sendtype[l] = MPI_DATATYPE_NULL;
 	}
-    }
-
-
 
+        /* The two read buffers are used for every cycle,
+           give the fbtl a chance to register them once. */
+        if ( NULL == ompio_req && 0 < cycles && NULL != fh->f_fbtl->fbtl_register_buffers ) {
+            struct iovec bufs[2];
 
-#if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
-    start_rexch = MPI_Wtime();
-#endif
-    n = 0;
-    bytes_remaining = 0;
-    current_index = 0;
-
-    for (index = 0; index < cycles; index++) {
-        /**********************************************************************
-         ***  7a. Getting ready for next cycle: initializing and freeing buffers
-	 **********************************************************************/
-        if (my_aggregator == fh->f_rank) {
-             if (NULL != fh->f_io_array) {
-                free (fh->f_io_array);
-                fh->f_io_array = NULL;
-            }
-            fh->f_num_of_io_entries = 0;
-
-            if (NULL != sendtype){
-                for (i =0; i< fh->f_procs_per_group; i++) {
-		    if ( MPI_DATATYPE_NULL != sendtype[i] ) {
-                        ompi_datatype_destroy(&sendtype[i]);
-                        sendtype[i] = MPI_DATATYPE_NULL;
-                    }
-		}
-            }
-
-            for(l=0;l<fh->f_procs_per_group;l++){
-                disp_index[l] =  1;
-
-                if (NULL != blocklen_per_process[l]){
-                    free(blocklen_per_process[l]);
-                    blocklen_per_process[l] = NULL;
-                }
-                if (NULL != displs_per_process[l]){
-                    free(displs_per_process[l]);
-                    displs_per_process[l] = NULL;
-                }
-                blocklen_per_process[l] = (int *) calloc (1, sizeof(int));
-                if (NULL == blocklen_per_process[l]) {
-                    opal_output (1, "OUT OF MEMORY for blocklen\n");
-                    ret = OMPI_ERR_OUT_OF_RESOURCE;
-                    goto exit;
-                }
-                displs_per_process[l] = (MPI_Aint *) calloc (1, sizeof(MPI_Aint));
-                if (NULL == displs_per_process[l]){
-                    opal_output (1, "OUT OF MEMORY for displs\n");
-                    ret = OMPI_ERR_OUT_OF_RESOURCE;
-                    goto exit;
-                }
-            }
-
-            if (NULL != sorted_file_offsets){
-                free(sorted_file_offsets);
-                sorted_file_offsets = NULL;
-            }
+            bufs[0].iov_base = cycle_data[0].global_buf;
+            bufs[0].iov_len  = bytes_per_cycle;
+            bufs[1].iov_base = cycle_data[1].global_buf;
+            bufs[1].iov_len  = bytes_per_cycle;
+            bufs_registered = (OMPI_SUCCESS == fh->f_fbtl->fbtl_register_buffers (fh, bufs, 2));
+        }
+    }
 
-            if(NULL != file_offsets_for_agg){
-                free(file_offsets_for_agg);
-                file_offsets_for_agg = NULL;
-            }
-            if (NULL != memory_displacements){
-                free(memory_displacements);
-                memory_displacements = NULL;
-            }
-        }  /* (my_aggregator == fh->f_rank */
+    if( (1 == mca_fcoll_vulcan_async_io) ||
+        ( (0 == mca_fcoll_vulcan_async_io) && (NULL != fh->f_fbtl->fbtl_ipreadv) && (2 < cycles) ) ) {
+        read_synch_type = 1;
+    }
+    if ( NULL != fh->f_compress ) {
+        /* chunks are decompressed by the aggregator in read_init */
+        read_synch_type = 0;
+    }
 
-        /**************************************************************************
-         ***  7b. Determine the number of bytes to be actually read in this cycle
-	 **************************************************************************/
-        if (cycles-1 == index) {
-            bytes_to_read_in_cycle = total_bytes - bytes_per_cycle*index;
+    if ( NULL != ompio_req ) {
+        /* Nonblocking operation: start reading the first cycle, the
+           progress engine scatters the data and reads the remaining
+           cycles. The state takes over the buffers of the operation. */
+        if ( 0 == mca_fcoll_vulcan_async_io && NULL != fh->f_fbtl->fbtl_ipreadv &&
+             NULL == fh->f_compress ) {
+            read_synch_type = 1;
         }
-        else {
-            bytes_to_read_in_cycle = bytes_per_cycle;
+        if ( 0 == cycles ) {
+            goto exit;
         }
-
-#if DEBUG_ON
-        if (my_aggregator == fh->f_rank) {
-            printf ("****%d: CYCLE %d   Bytes %d**********\n",
-                    fh->f_rank,
-                    index,
-                    bytes_to_write_in_cycle);
+        rs = (mca_io_ompio_read_state *) calloc (1, sizeof(mca_io_ompio_read_state));
+        if ( NULL == rs ) {
+            opal_output (1, "OUT OF MEMORY\n");
+            ret = OMPI_ERR_OUT_OF_RESOURCE;
+            goto exit;
         }
-#endif
-
-        /*****************************************************************
-         *** 7c. Calculate how much data will be contributed in this cycle
-	 ***     by each process
-         *****************************************************************/
-        bytes_received = 0;
-
-        while (bytes_to_read_in_cycle) {
-            /* This next block identifies which process is the holder
-            ** of the sorted[current_index] element;
-            */
-            blocks = fview_count[0];
-            for (j=0 ; j<fh->f_procs_per_group ; j++) {
-                if (sorted[current_index] < blocks) {
-                    n = j;
-                    break;
-                }
-                else {
-                    blocks += fview_count[j+1];
-                }
+        rs->fh                    = fh;
+        rs->buf                   = (char *) buf;
+        rs->decoded_iov           = decoded_iov;
+        rs->recvbuf_is_contiguous = recvbuf_is_contiguous;
+        rs->rd                    = rd;
+        rs->cycle_data[0]         = cycle_data[0];
+        rs->cycle_data[1]         = cycle_data[1];
+        rs->sendtype              = sendtype;
+        rs->send_req              = send_req;
+        rs->recv_req              = MPI_REQUEST_NULL;
+        rs->my_aggregator         = my_aggregator;
+        rs->procs_per_group       = fh->f_procs_per_group;
+        rs->cycles                = cycles;
+        rs->read_synch_type       = read_synch_type;
+        rs->error                 = OMPI_SUCCESS;
+        if ( NULL != send_req ) {
+            for (l=0; l<fh->f_procs_per_group; l++) {
+                send_req[l] = MPI_REQUEST_NULL;
             }
+        }
+        decoded_iov      = NULL;
+        sorted           = NULL;
+        global_iov_array = NULL;
+        fview_count      = NULL;
+        sendtype         = NULL;
+        send_req         = NULL;
+        for (k=0; k<2; k++) {
+            memset (&cycle_data[k], 0, sizeof(mca_io_ompio_read_cycle_data));
+            cycle_data[k].req_iread = MPI_REQUEST_NULL;
+        }
 
-            if (bytes_remaining) {
-                /* Finish up a partially used buffer from the previous  cycle */
-                if (bytes_remaining <= bytes_to_read_in_cycle) {
-                    /* Data fits completely into the block */
-                    if (my_aggregator == fh->f_rank) {
-                        blocklen_per_process[n][disp_index[n] - 1] = bytes_remaining;
-                        displs_per_process[n][disp_index[n] - 1] =
-                            (ptrdiff_t)global_iov_array[sorted[current_index]].iov_base +
-                            (global_iov_array[sorted[current_index]].iov_len - bytes_remaining);
-
-                        blocklen_per_process[n] = (int *) realloc
-                            ((void *)blocklen_per_process[n], (disp_index[n]+1)*sizeof(int));
-                        displs_per_process[n] = (MPI_Aint *) realloc
-                            ((void *)displs_per_process[n], (disp_index[n]+1)*sizeof(MPI_Aint));
-                        blocklen_per_process[n][disp_index[n]] = 0;
-                        displs_per_process[n][disp_index[n]] = 0;
-                        disp_index[n] += 1;
-                    }
-                    if (fh->f_procs_in_group[n] == fh->f_rank) {
-                        bytes_received += bytes_remaining;
-                    }
-                    current_index ++;
-                    bytes_to_read_in_cycle -= bytes_remaining;
-                    bytes_remaining = 0;
-                    continue;
-                }
-                else {
-                     /* the remaining data from the previous cycle is larger than the
-                        bytes_to_write_in_cycle, so we have to segment again */
-                    if (my_aggregator == fh->f_rank) {
-                        blocklen_per_process[n][disp_index[n] - 1] = bytes_to_read_in_cycle;
-                        displs_per_process[n][disp_index[n] - 1] =
-                            (ptrdiff_t)global_iov_array[sorted[current_index]].iov_base +
-                            (global_iov_array[sorted[current_index]].iov_len
-                             - bytes_remaining);
-                    }
-                    if (fh->f_procs_in_group[n] == fh->f_rank) {
-                        bytes_received += bytes_to_read_in_cycle;
-                    }
-                    bytes_remaining -= bytes_to_read_in_cycle;
-                    bytes_to_read_in_cycle = 0;
-                    break;
-                }
-            }
-            else {
-                /* No partially used entry available, have to start a new one */
-                if (bytes_to_read_in_cycle <
-                    (MPI_Aint) global_iov_array[sorted[current_index]].iov_len) {
-                    /* This entry has more data than we can sendin one cycle */
-                    if (my_aggregator == fh->f_rank) {
-                        blocklen_per_process[n][disp_index[n] - 1] = bytes_to_read_in_cycle;
-                        displs_per_process[n][disp_index[n] - 1] =
-                            (ptrdiff_t)global_iov_array[sorted[current_index]].iov_base ;
-                    }
+        ompio_req->req_data        = rs;
+        ompio_req->req_progress_fn = mca_fcoll_vulcan_read_progress;
+        ompio_req->req_free_fn     = read_state_free;
 
-                    if (fh->f_procs_in_group[n] == fh->f_rank) {
-                        bytes_received += bytes_to_read_in_cycle;
-                    }
-                    bytes_remaining = global_iov_array[sorted[current_index]].iov_len -
-                        bytes_to_read_in_cycle;
-                    bytes_to_read_in_cycle = 0;
-                    break;
-                }
-                else {
-                    /* Next data entry is less than bytes_to_write_in_cycle */
-                    if (my_aggregator ==  fh->f_rank) {
-                        blocklen_per_process[n][disp_index[n] - 1] =
-                            global_iov_array[sorted[current_index]].iov_len;
-                        displs_per_process[n][disp_index[n] - 1] = (ptrdiff_t)
-                            global_iov_array[sorted[current_index]].iov_base;
-                        blocklen_per_process[n] =
-                            (int *) realloc ((void *)blocklen_per_process[n], (disp_index[n]+1)*sizeof(int));
-                        displs_per_process[n] = (MPI_Aint *)realloc
-                            ((void *)displs_per_process[n], (disp_index[n]+1)*sizeof(MPI_Aint));
-                        blocklen_per_process[n][disp_index[n]] = 0;
-                        displs_per_process[n][disp_index[n]] = 0;
-                        disp_index[n] += 1;
-                    }
-                    if (fh->f_procs_in_group[n] == fh->f_rank) {
-                        bytes_received +=
-                            global_iov_array[sorted[current_index]].iov_len;
-                    }
-                    bytes_to_read_in_cycle -=
-                        global_iov_array[sorted[current_index]].iov_len;
-                    current_index ++;
-                    continue;
-                }
-            }
-        } /* end while (bytes_to_read_in_cycle) */
-
-        /*************************************************************************
-	 *** 7d. Calculate the displacement on where to put the data and allocate
-         ***     the recieve buffer (global_buf)
-	 *************************************************************************/
-        if (my_aggregator == fh->f_rank) {
-            entries_per_aggregator=0;
-            for (i=0;i<fh->f_procs_per_group; i++){
-                for (j=0;j<disp_index[i];j++){
-                    if (blocklen_per_process[i][j] > 0)
-                        entries_per_aggregator++ ;
-                }
-            }
-            if (entries_per_aggregator > 0){
-                file_offsets_for_agg = (mca_io_ompio_local_io_array *)
-                    malloc(entries_per_aggregator*sizeof(mca_io_ompio_local_io_array));
-                if (NULL == file_offsets_for_agg) {
-                    opal_output (1, "OUT OF MEMORY\n");
-                    ret = OMPI_ERR_OUT_OF_RESOURCE;
-                    goto exit;
-                }
-                sorted_file_offsets = (int *)
-                    malloc (entries_per_aggregator*sizeof(int));
-                if (NULL == sorted_file_offsets){
-                    opal_output (1, "OUT OF MEMORY\n");
-                    ret =  OMPI_ERR_OUT_OF_RESOURCE;
-                    goto exit;
-                }
-                /*Moving file offsets to an IO array!*/
-                temp_index = 0;
-                global_count = 0;
-                for (i=0;i<fh->f_procs_per_group; i++){
-                    for(j=0;j<disp_index[i];j++){
-                        if (blocklen_per_process[i][j] > 0){
-                            file_offsets_for_agg[temp_index].length =
-                                blocklen_per_process[i][j];
-                            global_count += blocklen_per_process[i][j];
-                            file_offsets_for_agg[temp_index].process_id = i;
-                            file_offsets_for_agg[temp_index].offset =
-                                displs_per_process[i][j];
-                            temp_index++;
-                        }
-                    }
-                }
-            }
-            else{
-                continue;
-            }
+        ret = read_prepare_cycle (fh, 0, cycles, my_aggregator, &rs->rd, &rs->cycle_data[0]);
+        if (OMPI_SUCCESS == ret && my_aggregator == fh->f_rank) {
+            ret = read_init (fh, &rs->cycle_data[0], read_synch_type);
+        }
+        goto exit;
+    }
 
-             /* Sort the displacements for each aggregator */
-            read_heap_sort (file_offsets_for_agg,
-                            entries_per_aggregator,
-                            sorted_file_offsets);
-
-            memory_displacements = (MPI_Aint *) malloc
-                (entries_per_aggregator * sizeof(MPI_Aint));
-            memory_displacements[sorted_file_offsets[0]] = 0;
-            for (i=1; i<entries_per_aggregator; i++){
-                memory_displacements[sorted_file_offsets[i]] =
-                    memory_displacements[sorted_file_offsets[i-1]] +
-                    file_offsets_for_agg[sorted_file_offsets[i-1]].length;
-            }
+#if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
+    start_rexch = MPI_Wtime();
+#endif
 
-             /**********************************************************
-	     *** 7e. Create the io array, and pass it to fbtl
-	     *********************************************************/
-            fh->f_io_array = (mca_common_ompio_io_array_t *) malloc
-                (entries_per_aggregator * sizeof (mca_common_ompio_io_array_t));
-            if (NULL == fh->f_io_array) {
-                opal_output(1, "OUT OF MEMORY\n");
-                ret = OMPI_ERR_OUT_OF_RESOURCE;
+    /**************************************************************************
+     ***  7. Start reading the first cycle. In every cycle, the read for the
+     ***     next cycle is started before the data of the current cycle is
+     ***     scattered from the aggregator to the processes of the group.
+     **************************************************************************/
+    if ( cycles > 0 ) {
+        ret = read_prepare_cycle (fh, 0, cycles, my_aggregator, &rd, &cycle_data[0]);
+        if (OMPI_SUCCESS != ret){
+            goto exit;
+        }
+        if (my_aggregator == fh->f_rank) {
+            /* Register progress function that should be used by ompi_request_wait */
+            mca_common_ompio_register_progress ();
+#if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
+            start_read_time = MPI_Wtime();
+#endif
+            ret = read_init (fh, &cycle_data[0], read_synch_type);
+            if (OMPI_SUCCESS != ret){
                 goto exit;
             }
+#if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
+            end_read_time = MPI_Wtime();
+            read_time += end_read_time - start_read_time;
+#endif
+        }
+    }
 
-            fh->f_num_of_io_entries = 0;
-            fh->f_io_array[0].offset =
-                (IOVBASE_TYPE *)(intptr_t)file_offsets_for_agg[sorted_file_offsets[0]].offset;
-            fh->f_io_array[0].length =
-                file_offsets_for_agg[sorted_file_offsets[0]].length;
-            fh->f_io_array[0].memory_address =
-                global_buf+memory_displacements[sorted_file_offsets[0]];
-            fh->f_num_of_io_entries++;
-            for (i=1;i<entries_per_aggregator;i++){
-                if (file_offsets_for_agg[sorted_file_offsets[i-1]].offset +
-                    file_offsets_for_agg[sorted_file_offsets[i-1]].length ==
-                    file_offsets_for_agg[sorted_file_offsets[i]].offset){
-                    fh->f_io_array[fh->f_num_of_io_entries - 1].length +=
-                        file_offsets_for_agg[sorted_file_offsets[i]].length;
-                }
-                else{
-                    fh->f_io_array[fh->f_num_of_io_entries].offset =
-                        (IOVBASE_TYPE *)(intptr_t)file_offsets_for_agg[sorted_file_offsets[i]].offset;
-                    fh->f_io_array[fh->f_num_of_io_entries].length =
-                        file_offsets_for_agg[sorted_file_offsets[i]].length;
-                    fh->f_io_array[fh->f_num_of_io_entries].memory_address =
-                        global_buf+memory_displacements[sorted_file_offsets[i]];
-                    fh->f_num_of_io_entries++;
-                }
-            }
-
+    for (index = 0; index < cycles; index++) {
+        cd = &cycle_data[index%2];
 
+        /**********************************************************************
+         ***  7a. Wait for the data of this cycle and start reading the next one
+	 **********************************************************************/
+        if (my_aggregator == fh->f_rank) {
 #if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
             start_read_time = MPI_Wtime();
 #endif
-
-            if (fh->f_num_of_io_entries) {
-                if ( 0 >  fh->f_fbtl->fbtl_preadv (fh)) {
-                    opal_output (1, "READ FAILED\n");
-                    ret = OMPI_ERROR;
-                    goto exit;
-                }
+            stats_start = mca_common_ompio_stats_time (fh);
+            ret = ompi_request_wait (&cd->req_iread, MPI_STATUS_IGNORE);
+            mca_common_ompio_stats_phase (fh, OMPIO_STATS_WAIT, stats_start);
+            if (OMPI_SUCCESS != ret){
+                opal_output (1, "READ FAILED\n");
+                goto exit;
             }
-
 #if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
             end_read_time = MPI_Wtime();
             read_time += end_read_time - start_read_time;
 #endif
-            /**********************************************************
-             ******************** DONE READING ************************
-             *********************************************************/
+        }
 
-            temp_disp_index = (int *)calloc (1, fh->f_procs_per_group * sizeof (int));
-            if (NULL == temp_disp_index) {
-                opal_output (1, "OUT OF MEMORY\n");
-                ret = OMPI_ERR_OUT_OF_RESOURCE;
+        if (index+1 < cycles) {
+            ret = read_prepare_cycle (fh, index+1, cycles, my_aggregator, &rd,
+                                      &cycle_data[(index+1)%2]);
+            if (OMPI_SUCCESS != ret){
                 goto exit;
             }
-            for (i=0; i<entries_per_aggregator; i++){
-                temp_index =
-                    file_offsets_for_agg[sorted_file_offsets[i]].process_id;
-                displs_per_process[temp_index][temp_disp_index[temp_index]] =
-                    memory_displacements[sorted_file_offsets[i]];
-                if (temp_disp_index[temp_index] < disp_index[temp_index]){
-                    temp_disp_index[temp_index] += 1;
-                }
-                else{
-                    printf("temp_disp_index[%d]: %d is greater than disp_index[%d]: %d\n",
-                           temp_index, temp_disp_index[temp_index],
-                           temp_index, disp_index[temp_index]);
-                }
-            }
-            if (NULL != temp_disp_index){
-                free(temp_disp_index);
-                temp_disp_index = NULL;
-            }
-
+            if (my_aggregator == fh->f_rank) {
 #if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
-            start_rcomm_time = MPI_Wtime();
+                start_read_time = MPI_Wtime();
 #endif
-            for (i=0;i<fh->f_procs_per_group;i++){
-                send_req[i] = MPI_REQUEST_NULL;
-                if ( 0 < disp_index[i] ) {
-                    ompi_datatype_create_hindexed(disp_index[i],
-                                                  blocklen_per_process[i],
-                                                  displs_per_process[i],
-                                                  MPI_BYTE,
-                                                  &sendtype[i]);
-                    ompi_datatype_commit(&sendtype[i]);
-                    ret = MCA_PML_CALL (isend(global_buf,
-                                              1,
-                                              sendtype[i],
-                                              fh->f_procs_in_group[i],
-                                              123,
-                                              MCA_PML_BASE_SEND_STANDARD,
-                                              fh->f_comm,
-                                              &send_req[i]));
-                    if(OMPI_SUCCESS != ret){
-                        goto exit;
-                    }
+                ret = read_init (fh, &cycle_data[(index+1)%2], read_synch_type);
+                if (OMPI_SUCCESS != ret){
+                    goto exit;
                 }
-            }
 #if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
-            end_rcomm_time = MPI_Wtime();
-            rcomm_time += end_rcomm_time - start_rcomm_time;
+                end_read_time = MPI_Wtime();
+                read_time += end_read_time - start_read_time;
 #endif
+            }
         }
 
         /**********************************************************
-         *** 7f.  Scatter the Data from the readers
+         *** 7b.  Scatter the Data from the readers
          *********************************************************/
+#if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
+        start_rcomm_time = MPI_Wtime();
+#endif
+        stats_start = mca_common_ompio_stats_time (fh);
+        if (my_aggregator == fh->f_rank) {
+            ret = scatter_init (fh, cd, sendtype, send_req);
+            if (OMPI_SUCCESS != ret){
+                goto exit;
+            }
+        }
+
         if ( recvbuf_is_contiguous ) {
             receive_buf = &((char*)buf)[position];
         }
-        else if (bytes_received) {
+        else if (cd->bytes_received) {
             /* allocate a receive buffer and copy the data that needs
                to be received into it in case the data is non-contigous
                in memory */
-            receive_buf = malloc (bytes_received);
+            receive_buf = malloc (cd->bytes_received);
             if (NULL == receive_buf) {
                 opal_output (1, "OUT OF MEMORY\n");
                 ret = OMPI_ERR_OUT_OF_RESOURCE;
@@ -788,14 +888,11 @@ mca_fcoll_vulcan_file_read_all (ompio_file_t *fh,
             }
         }
 
-#if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
-        start_rcomm_time = MPI_Wtime();
-#endif
         ret = MCA_PML_CALL(irecv(receive_buf,
-                                 bytes_received,
+                                 cd->bytes_received,
                                  MPI_BYTE,
                                  my_aggregator,
-                                 123,
+                                 FCOLL_VULCAN_SCATTER_TAG,
                                  fh->f_comm,
                                  &recv_req));
         if (OMPI_SUCCESS != ret){
@@ -813,45 +910,17 @@ mca_fcoll_vulcan_file_read_all (ompio_file_t *fh,
         }
 
         ret = ompi_request_wait (&recv_req, MPI_STATUS_IGNORE);
+        mca_common_ompio_stats_phase (fh, OMPIO_STATS_SHUFFLE, stats_start);
         if (OMPI_SUCCESS != ret){
             goto exit;
         }
-        position += bytes_received;
+        position += cd->bytes_received;
 
         /* If data is not contigous in memory, copy the data from the
            receive buffer into the buffer passed in */
         if (!recvbuf_is_contiguous ) {
-            ptrdiff_t mem_address;
-            size_t remaining = 0;
-            size_t temp_position = 0;
-
-            remaining = bytes_received;
-
-            while (remaining) {
-                mem_address = (ptrdiff_t)
-                    (decoded_iov[iov_index].iov_base) + current_position;
-
-                if (remaining >=
-                    (decoded_iov[iov_index].iov_len - current_position)) {
-                    memcpy ((IOVBASE_TYPE *) mem_address,
-                            receive_buf+temp_position,
-                            decoded_iov[iov_index].iov_len - current_position);
-                    remaining = remaining -
-                        (decoded_iov[iov_index].iov_len - current_position);
-                    temp_position = temp_position +
-                        (decoded_iov[iov_index].iov_len - current_position);
-                    iov_index = iov_index + 1;
-                    current_position = 0;
-                }
-                else {
-                    memcpy ((IOVBASE_TYPE *) mem_address,
-                            receive_buf+temp_position,
-                            remaining);
-                    current_position = current_position + remaining;
-                    remaining = 0;
-                }
-            }
-
+            unpack_cycle (decoded_iov, &iov_index, &current_position,
+                          receive_buf, cd->bytes_received);
             if (NULL != receive_buf) {
                 free (receive_buf);
                 receive_buf = NULL;
@@ -887,10 +956,6 @@ exit:
             receive_buf = NULL;
         }
     }
-    if (NULL != global_buf) {
-        free (global_buf);
-        global_buf = NULL;
-    }
     if (NULL != sorted) {
         free (sorted);
         sorted = NULL;
@@ -917,19 +982,38 @@ exit:
         displs = NULL;
     }
     if (my_aggregator == fh->f_rank) {
-
-        if (NULL != sorted_file_offsets){
-            free(sorted_file_offsets);
-            sorted_file_offsets = NULL;
+        /* a read might still be in flight if we bailed out early */
+        for (k=0; k<2; k++) {
+            if (MPI_REQUEST_NULL != cycle_data[k].req_iread) {
+                ompi_request_wait (&cycle_data[k].req_iread, MPI_STATUS_IGNORE);
+            }
         }
-        if (NULL != file_offsets_for_agg){
-            free(file_offsets_for_agg);
-            file_offsets_for_agg = NULL;
+        if ( bufs_registered ) {
+            fh->f_fbtl->fbtl_unregister_buffers (fh);
         }
-        if (NULL != memory_displacements){
-            free(memory_displacements);
-            memory_displacements= NULL;
+
+        for (k=0; k<2; k++) {
+            cd = &cycle_data[k];
+            free (cd->global_buf);
+            free (cd->sorted_file_offsets);
+            free (cd->file_offsets_for_agg);
+            free (cd->memory_displacements);
+            free (cd->io_array);
+            free (cd->disp_index);
+            if ( NULL != cd->blocklen_per_process){
+                for(l=0;l<fh->f_procs_per_group;l++){
+                    free(cd->blocklen_per_process[l]);
+                }
+                free(cd->blocklen_per_process);
+            }
+            if (NULL != cd->displs_per_process){
+                for (l=0; l<fh->f_procs_per_group; l++){
+                    free(cd->displs_per_process[l]);
+                }
+                free(cd->displs_per_process);
+            }
         }
+
         if (NULL != sendtype){
             for (i = 0; i < fh->f_procs_per_group; i++) {
                 if ( MPI_DATATYPE_NULL != sendtype[i] ) {
@@ -940,41 +1024,504 @@ exit:
             sendtype=NULL;
         }
 
-        if (NULL != disp_index){
-            free(disp_index);
-            disp_index = NULL;
+        if ( NULL != send_req ) {
+            free ( send_req );
+            send_req = NULL;
         }
+    }
+    return ret;
+}
 
-        if ( NULL != blocklen_per_process){
-            for(l=0;l<fh->f_procs_per_group;l++){
-                if (NULL != blocklen_per_process[l]){
-                    free(blocklen_per_process[l]);
-                    blocklen_per_process[l] = NULL;
-                }
+/*
+  Determine which parts of the file are read in cycle index and which
+  process they belong to, and build the io array of the aggregator.
+  Has to be called for the cycles in order, since it advances the
+  position in the sorted global file view.
+*/
+static int read_prepare_cycle (ompio_file_t *fh, int index, int cycles, int my_aggregator,
+                               mca_io_ompio_read_data *rd, mca_io_ompio_read_cycle_data *cd)
+{
+    MPI_Aint bytes_to_read_in_cycle = 0; /* left to be read in a cycle*/
+    MPI_Aint bytes_remaining = rd->bytes_remaining; /* how many bytes have been read from the current
+                                                      value from total_bytes_per_process */
+    MPI_Aint global_count = 0;
+    int current_index = rd->current_index;
+    int n=0; /* current position in total_bytes_per_process array */
+    int i=0, j=0, l=0;
+    int blocks = 0, temp_index=0;
+    int entries_per_aggregator=0;
+    int *sorted = rd->sorted;
+    int *fview_count = rd->fview_count;
+    struct iovec *global_iov_array = rd->global_iov_array;
+    int *disp_index = cd->disp_index;
+    int **blocklen_per_process = cd->blocklen_per_process;
+    MPI_Aint **displs_per_process = cd->displs_per_process;
+    mca_io_ompio_local_io_array *file_offsets_for_agg=NULL;
+    int *sorted_file_offsets=NULL;
+    MPI_Aint *memory_displacements=NULL;
+
+    /**********************************************************************
+     ***  Getting ready for the cycle: initializing and freeing buffers
+     **********************************************************************/
+    cd->bytes_received = 0;
+    cd->entries_per_aggregator = 0;
+    cd->num_io_entries = 0;
+
+    if (my_aggregator == fh->f_rank) {
+        for(l=0;l<fh->f_procs_per_group;l++){
+            disp_index[l] =  1;
+
+            if (NULL != blocklen_per_process[l]){
+                free(blocklen_per_process[l]);
+                blocklen_per_process[l] = NULL;
+            }
+            if (NULL != displs_per_process[l]){
+                free(displs_per_process[l]);
+                displs_per_process[l] = NULL;
+            }
+            blocklen_per_process[l] = (int *) calloc (1, sizeof(int));
+            if (NULL == blocklen_per_process[l]) {
+                opal_output (1, "OUT OF MEMORY for blocklen\n");
+                return OMPI_ERR_OUT_OF_RESOURCE;
+            }
+            displs_per_process[l] = (MPI_Aint *) calloc (1, sizeof(MPI_Aint));
+            if (NULL == displs_per_process[l]){
+                opal_output (1, "OUT OF MEMORY for displs\n");
+                return OMPI_ERR_OUT_OF_RESOURCE;
+            }
+        }
+
+        if (NULL != cd->sorted_file_offsets){
+            free(cd->sorted_file_offsets);
+            cd->sorted_file_offsets = NULL;
+        }
+        if(NULL != cd->file_offsets_for_agg){
+            free(cd->file_offsets_for_agg);
+            cd->file_offsets_for_agg = NULL;
+        }
+        if (NULL != cd->memory_displacements){
+            free(cd->memory_displacements);
+            cd->memory_displacements = NULL;
+        }
+    }  /* (my_aggregator == fh->f_rank */
+
+    /**************************************************************************
+     ***  Determine the number of bytes to be actually read in this cycle
+     **************************************************************************/
+    if (cycles-1 == index) {
+        bytes_to_read_in_cycle = rd->total_bytes - rd->bytes_per_cycle*index;
+    }
+    else {
+        bytes_to_read_in_cycle = rd->bytes_per_cycle;
+    }
+
+#if DEBUG_ON
+    if (my_aggregator == fh->f_rank) {
+        printf ("****%d: CYCLE %d   Bytes %ld**********\n",
+                fh->f_rank,
+                index,
+                bytes_to_read_in_cycle);
+    }
+#endif
+
+    /*****************************************************************
+     *** Calculate how much data will be contributed in this cycle
+     ***     by each process
+     *****************************************************************/
+    while (bytes_to_read_in_cycle) {
+        /* This next block identifies which process is the holder
+        ** of the sorted[current_index] element;
+        */
+        blocks = fview_count[0];
+        for (j=0 ; j<fh->f_procs_per_group ; j++) {
+            if (sorted[current_index] < blocks) {
+                n = j;
+                break;
+            }
+            else {
+                blocks += fview_count[j+1];
             }
+        }
 
-            free(blocklen_per_process);
-            blocklen_per_process = NULL;
+        if (bytes_remaining) {
+            /* Finish up a partially used buffer from the previous  cycle */
+            if (bytes_remaining <= bytes_to_read_in_cycle) {
+                /* Data fits completely into the block */
+                if (my_aggregator == fh->f_rank) {
+                    blocklen_per_process[n][disp_index[n] - 1] = bytes_remaining;
+                    displs_per_process[n][disp_index[n] - 1] =
+                        (ptrdiff_t)global_iov_array[sorted[current_index]].iov_base +
+                        (global_iov_array[sorted[current_index]].iov_len - bytes_remaining);
+
+                    blocklen_per_process[n] = (int *) realloc
+                        ((void *)blocklen_per_process[n], (disp_index[n]+1)*sizeof(int));
+                    displs_per_process[n] = (MPI_Aint *) realloc
+                        ((void *)displs_per_process[n], (disp_index[n]+1)*sizeof(MPI_Aint));
+                    blocklen_per_process[n][disp_index[n]] = 0;
+                    displs_per_process[n][disp_index[n]] = 0;
+                    disp_index[n] += 1;
+                }
+                if (fh->f_procs_in_group[n] == fh->f_rank) {
+                    cd->bytes_received += bytes_remaining;
+                }
+                current_index ++;
+                bytes_to_read_in_cycle -= bytes_remaining;
+                bytes_remaining = 0;
+                continue;
+            }
+            else {
+                /* the remaining data from the previous cycle is larger than the
+                   bytes_to_read_in_cycle, so we have to segment again */
+                if (my_aggregator == fh->f_rank) {
+                    blocklen_per_process[n][disp_index[n] - 1] = bytes_to_read_in_cycle;
+                    displs_per_process[n][disp_index[n] - 1] =
+                        (ptrdiff_t)global_iov_array[sorted[current_index]].iov_base +
+                        (global_iov_array[sorted[current_index]].iov_len
+                         - bytes_remaining);
+                }
+                if (fh->f_procs_in_group[n] == fh->f_rank) {
+                    cd->bytes_received += bytes_to_read_in_cycle;
+                }
+                bytes_remaining -= bytes_to_read_in_cycle;
+                bytes_to_read_in_cycle = 0;
+                break;
+            }
         }
+        else {
+            /* No partially used entry available, have to start a new one */
+            if (bytes_to_read_in_cycle <
+                (MPI_Aint) global_iov_array[sorted[current_index]].iov_len) {
+                /* This entry has more data than we can sendin one cycle */
+                if (my_aggregator == fh->f_rank) {
+                    blocklen_per_process[n][disp_index[n] - 1] = bytes_to_read_in_cycle;
+                    displs_per_process[n][disp_index[n] - 1] =
+                        (ptrdiff_t)global_iov_array[sorted[current_index]].iov_base ;
+                }
 
-        if (NULL != displs_per_process){
-            for (l=0; i<fh->f_procs_per_group; l++){
-                if (NULL != displs_per_process[l]){
-                    free(displs_per_process[l]);
-                    displs_per_process[l] = NULL;
+                if (fh->f_procs_in_group[n] == fh->f_rank) {
+                    cd->bytes_received += bytes_to_read_in_cycle;
                 }
+                bytes_remaining = global_iov_array[sorted[current_index]].iov_len -
+                    bytes_to_read_in_cycle;
+                bytes_to_read_in_cycle = 0;
+                break;
+            }
+            else {
+                /* Next data entry is less than bytes_to_read_in_cycle */
+                if (my_aggregator ==  fh->f_rank) {
+                    blocklen_per_process[n][disp_index[n] - 1] =
+                        global_iov_array[sorted[current_index]].iov_len;
+                    displs_per_process[n][disp_index[n] - 1] = (ptrdiff_t)
+                        global_iov_array[sorted[current_index]].iov_base;
+                    blocklen_per_process[n] =
+                        (int *) realloc ((void *)blocklen_per_process[n], (disp_index[n]+1)*sizeof(int));
+                    displs_per_process[n] = (MPI_Aint *)realloc
+                        ((void *)displs_per_process[n], (disp_index[n]+1)*sizeof(MPI_Aint));
+                    blocklen_per_process[n][disp_index[n]] = 0;
+                    displs_per_process[n][disp_index[n]] = 0;
+                    disp_index[n] += 1;
+                }
+                if (fh->f_procs_in_group[n] == fh->f_rank) {
+                    cd->bytes_received +=
+                        global_iov_array[sorted[current_index]].iov_len;
+                }
+                bytes_to_read_in_cycle -=
+                    global_iov_array[sorted[current_index]].iov_len;
+                current_index ++;
+                continue;
             }
-            free(displs_per_process);
-            displs_per_process = NULL;
         }
-        if ( NULL != send_req ) {
-            free ( send_req );
-            send_req = NULL;
+    } /* end while (bytes_to_read_in_cycle) */
+
+    rd->current_index   = current_index;
+    rd->bytes_remaining = bytes_remaining;
+
+    if (my_aggregator != fh->f_rank) {
+        return OMPI_SUCCESS;
+    }
+
+    /*************************************************************************
+     *** Calculate the displacement on where to put the data in global_buf
+     *************************************************************************/
+    for (i=0;i<fh->f_procs_per_group; i++){
+        for (j=0;j<disp_index[i];j++){
+            if (blocklen_per_process[i][j] > 0)
+                entries_per_aggregator++ ;
+        }
+    }
+    if (0 == entries_per_aggregator) {
+        return OMPI_SUCCESS;
+    }
+
+    file_offsets_for_agg = (mca_io_ompio_local_io_array *)
+        malloc(entries_per_aggregator*sizeof(mca_io_ompio_local_io_array));
+    if (NULL == file_offsets_for_agg) {
+        opal_output (1, "OUT OF MEMORY\n");
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+    cd->file_offsets_for_agg = file_offsets_for_agg;
+
+    sorted_file_offsets = (int *)
+        malloc (entries_per_aggregator*sizeof(int));
+    if (NULL == sorted_file_offsets){
+        opal_output (1, "OUT OF MEMORY\n");
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+    cd->sorted_file_offsets = sorted_file_offsets;
+
+    /*Moving file offsets to an IO array!*/
+    temp_index = 0;
+    global_count = 0;
+    for (i=0;i<fh->f_procs_per_group; i++){
+        for(j=0;j<disp_index[i];j++){
+            if (blocklen_per_process[i][j] > 0){
+                file_offsets_for_agg[temp_index].length =
+                    blocklen_per_process[i][j];
+                global_count += blocklen_per_process[i][j];
+                file_offsets_for_agg[temp_index].process_id = i;
+                file_offsets_for_agg[temp_index].offset =
+                    displs_per_process[i][j];
+                temp_index++;
+            }
+        }
+    }
+
+    /* Sort the displacements for each aggregator */
+    read_heap_sort (file_offsets_for_agg,
+                    entries_per_aggregator,
+                    sorted_file_offsets);
+
+    memory_displacements = (MPI_Aint *) malloc
+        (entries_per_aggregator * sizeof(MPI_Aint));
+    if (NULL == memory_displacements) {
+        opal_output (1, "OUT OF MEMORY\n");
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+    cd->memory_displacements = memory_displacements;
+
+    memory_displacements[sorted_file_offsets[0]] = 0;
+    for (i=1; i<entries_per_aggregator; i++){
+        memory_displacements[sorted_file_offsets[i]] =
+            memory_displacements[sorted_file_offsets[i-1]] +
+            file_offsets_for_agg[sorted_file_offsets[i-1]].length;
+    }
+    cd->entries_per_aggregator = entries_per_aggregator;
+
+    /**********************************************************
+     *** Create the io array
+     *********************************************************/
+    cd->io_array = (mca_common_ompio_io_array_t *) malloc
+        (entries_per_aggregator * sizeof (mca_common_ompio_io_array_t));
+    if (NULL == cd->io_array) {
+        opal_output(1, "OUT OF MEMORY\n");
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+
+    cd->io_array[0].offset =
+        (IOVBASE_TYPE *)(intptr_t)file_offsets_for_agg[sorted_file_offsets[0]].offset;
+    cd->io_array[0].length =
+        file_offsets_for_agg[sorted_file_offsets[0]].length;
+    cd->io_array[0].memory_address =
+        cd->global_buf+memory_displacements[sorted_file_offsets[0]];
+    cd->num_io_entries++;
+    for (i=1;i<entries_per_aggregator;i++){
+        if (file_offsets_for_agg[sorted_file_offsets[i-1]].offset +
+            file_offsets_for_agg[sorted_file_offsets[i-1]].length ==
+            file_offsets_for_agg[sorted_file_offsets[i]].offset){
+            cd->io_array[cd->num_io_entries - 1].length +=
+                file_offsets_for_agg[sorted_file_offsets[i]].length;
+        }
+        else{
+            cd->io_array[cd->num_io_entries].offset =
+                (IOVBASE_TYPE *)(intptr_t)file_offsets_for_agg[sorted_file_offsets[i]].offset;
+            cd->io_array[cd->num_io_entries].length =
+                file_offsets_for_agg[sorted_file_offsets[i]].length;
+            cd->io_array[cd->num_io_entries].memory_address =
+                cd->global_buf+memory_displacements[sorted_file_offsets[i]];
+            cd->num_io_entries++;
         }
     }
+
+    return OMPI_SUCCESS;
+}
+
+/*
+  Pass the io array of a cycle to the fbtl. With read_synch_type 1 the
+  operation is started asynchronously, otherwise it is executed right
+  away and the request is returned in completed state.
+*/
+static int read_init (ompio_file_t *fh, mca_io_ompio_read_cycle_data *cd, int read_synch_type)
+{
+    int ret = OMPI_SUCCESS;
+    ssize_t ret_temp = 0;
+    mca_ompio_request_t *ompio_req = NULL;
+    uint64_t stats_start;
+    size_t bytes_to_read = 0;
+    int i;
+
+    mca_common_ompio_request_alloc ( &ompio_req, MCA_OMPIO_REQUEST_READ );
+
+    if (cd->num_io_entries) {
+        fh->f_io_array = cd->io_array;
+        fh->f_num_of_io_entries = cd->num_io_entries;
+        for ( i = 0; i < cd->num_io_entries; i++ ) {
+            bytes_to_read += cd->io_array[i].length;
+        }
+        mca_common_ompio_stats_aggr (fh, bytes_to_read);
+
+        stats_start = mca_common_ompio_stats_time (fh);
+
+        if (1 == read_synch_type) {
+            ret = fh->f_fbtl->fbtl_ipreadv(fh, (ompi_request_t *) ompio_req);
+            if(0 > ret) {
+                opal_output (1, "vulcan_read_all: fbtl_ipreadv failed\n");
+                ompio_req->req_ompi.req_status.MPI_ERROR = ret;
+                ompio_req->req_ompi.req_status._ucount = 0;
+                ompi_request_complete (&ompio_req->req_ompi, false);
+            }
+        }
+        else {
+            if ( NULL != fh->f_compress ) {
+                ret_temp = mca_common_ompio_compress_preadv (fh);
+            }
+            else {
+                ret_temp = fh->f_fbtl->fbtl_preadv(fh);
+            }
+            if(0 > ret_temp) {
+                opal_output (1, "vulcan_read_all: fbtl_preadv failed\n");
+                ret = ret_temp;
+                ret_temp = 0;
+            }
+
+            ompio_req->req_ompi.req_status.MPI_ERROR = ret;
+            ompio_req->req_ompi.req_status._ucount = ret_temp;
+            ompi_request_complete (&ompio_req->req_ompi, false);
+        }
+        mca_common_ompio_stats_phase (fh, OMPIO_STATS_IO, stats_start);
+
+        free(cd->io_array);
+        cd->io_array = NULL;
+        cd->num_io_entries = 0;
+    }
+    else {
+        ompio_req->req_ompi.req_status.MPI_ERROR = OMPI_SUCCESS;
+        ompio_req->req_ompi.req_status._ucount = 0;
+        ompi_request_complete (&ompio_req->req_ompi, false);
+    }
+
+    cd->req_iread = (ompi_request_t *) ompio_req;
+
+    fh->f_io_array=NULL;
+    fh->f_num_of_io_entries=0;
+
     return ret;
 }
 
+/*
+  Convert the file offsets of a cycle into offsets in global_buf and
+  post the sends of the data to the processes of the group.
+*/
+static int scatter_init (ompio_file_t *fh, mca_io_ompio_read_cycle_data *cd,
+                         ompi_datatype_t **sendtype, MPI_Request *send_req)
+{
+    int i, temp_index, ret = OMPI_SUCCESS;
+    int *temp_disp_index = NULL;
+
+    for (i=0; i<fh->f_procs_per_group; i++) {
+        send_req[i] = MPI_REQUEST_NULL;
+        if ( MPI_DATATYPE_NULL != sendtype[i] ) {
+            ompi_datatype_destroy(&sendtype[i]);
+            sendtype[i] = MPI_DATATYPE_NULL;
+        }
+    }
+
+    if (0 == cd->entries_per_aggregator) {
+        return OMPI_SUCCESS;
+    }
+
+    temp_disp_index = (int *)calloc (1, fh->f_procs_per_group * sizeof (int));
+    if (NULL == temp_disp_index) {
+        opal_output (1, "OUT OF MEMORY\n");
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+    for (i=0; i<cd->entries_per_aggregator; i++){
+        temp_index =
+            cd->file_offsets_for_agg[cd->sorted_file_offsets[i]].process_id;
+        cd->displs_per_process[temp_index][temp_disp_index[temp_index]] =
+            cd->memory_displacements[cd->sorted_file_offsets[i]];
+        if (temp_disp_index[temp_index] < cd->disp_index[temp_index]){
+            temp_disp_index[temp_index] += 1;
+        }
+        else{
+            printf("temp_disp_index[%d]: %d is greater than disp_index[%d]: %d\n",
+                   temp_index, temp_disp_index[temp_index],
+                   temp_index, cd->disp_index[temp_index]);
+        }
+    }
+    free(temp_disp_index);
+
+    for (i=0;i<fh->f_procs_per_group;i++){
+        if ( 0 < cd->disp_index[i] ) {
+            ompi_datatype_create_hindexed(cd->disp_index[i],
+                                          cd->blocklen_per_process[i],
+                                          cd->displs_per_process[i],
+                                          MPI_BYTE,
+                                          &sendtype[i]);
+            ompi_datatype_commit(&sendtype[i]);
+            ret = MCA_PML_CALL (isend(cd->global_buf,
+                                      1,
+                                      sendtype[i],
+                                      fh->f_procs_in_group[i],
+                                      FCOLL_VULCAN_SCATTER_TAG,
+                                      MCA_PML_BASE_SEND_STANDARD,
+                                      fh->f_comm,
+                                      &send_req[i]));
+            if(OMPI_SUCCESS != ret){
+                return ret;
+            }
+        }
+    }
+
+    return ret;
+}
+
+
+/*
+  Copy the data received in a cycle from the contiguous receive buffer
+  into the user buffer described by decoded_iov.
+*/
+static void unpack_cycle (struct iovec *decoded_iov, int *iov_index, size_t *current_position,
+                          char *receive_buf, size_t bytes)
+{
+    ptrdiff_t mem_address;
+    size_t remaining = bytes;
+    size_t temp_position = 0;
+
+    while (remaining) {
+        mem_address = (ptrdiff_t)
+            (decoded_iov[*iov_index].iov_base) + *current_position;
+
+        if (remaining >=
+            (decoded_iov[*iov_index].iov_len - *current_position)) {
+            memcpy ((IOVBASE_TYPE *) mem_address,
+                    receive_buf+temp_position,
+                    decoded_iov[*iov_index].iov_len - *current_position);
+            remaining = remaining -
+                (decoded_iov[*iov_index].iov_len - *current_position);
+            temp_position = temp_position +
+                (decoded_iov[*iov_index].iov_len - *current_position);
+            *iov_index = *iov_index + 1;
+            *current_position = 0;
+        }
+        else {
+            memcpy ((IOVBASE_TYPE *) mem_address,
+                    receive_buf+temp_position,
+                    remaining);
+            *current_position = *current_position + remaining;
+            remaining = 0;
+        }
+    }
+}
 
 static int read_heap_sort (mca_io_ompio_local_io_array *io_array,
                            int num_entries,
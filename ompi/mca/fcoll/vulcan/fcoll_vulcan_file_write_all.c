@@ -88,17 +88,45 @@ typedef struct mca_io_ompio_aggregator_data {
 
 
 
+/* State of a nonblocking collective write, hung off the ompio request.
+   The file handle has to be the first element, see
+   mca_fcoll_vulcan_wait_pending. */
+typedef struct mca_io_ompio_write_state {
+    ompio_file_t *fh;
+    mca_io_ompio_aggregator_data **aggr_data;
+    int num_aggrs;
+    int *procs_in_group;
+    int procs_per_group;
+    ompi_request_t **reqs;
+    int num_reqs;
+    ompi_request_t *req_iwrite;
+    int index, cycles, aggr_index;
+    int write_chunksize, write_synch_type;
+    int error;
+} mca_io_ompio_write_state;
+
+static int write_all (ompio_file_t *fh, const void *buf, int count,
+                      struct ompi_datatype_t *datatype, ompi_status_public_t *status,
+                      mca_ompio_request_t *ompio_req);
+static void write_state_free (mca_ompio_request_t *ompio_req);
+static void aggr_data_free (ompio_file_t *fh, mca_io_ompio_aggregator_data **aggr_data,
+                            int num_aggrs);
+
 static int shuffle_init ( int index, int cycles, int aggregator, int rank, 
                           mca_io_ompio_aggregator_data *data, 
                           ompi_request_t **reqs );
 static int write_init (ompio_file_t *fh, int aggregator, mca_io_ompio_aggregator_data *aggr_data,
                         int write_chunksize, int write_synchType, ompi_request_t **request);
-int mca_fcoll_vulcan_break_file_view ( struct iovec *decoded_iov, int iov_count, 
+int mca_fcoll_vulcan_break_file_view ( ompio_file_t *fh,
+                                        struct iovec *decoded_iov, int iov_count, 
                                         struct iovec *local_iov_array, int local_count, 
                                         struct iovec ***broken_decoded_iovs, int **broken_iov_counts,
                                         struct iovec ***broken_iov_arrays, int **broken_counts, 
                                         MPI_Aint **broken_total_lengths,
-                                        int stripe_count, size_t stripe_size); 
+                                        int stripe_count, size_t stripe_size,
+                                        bool stripe_domains); 
+
+static void stripe_aggregators (ompio_file_t *fh);
 
 
 int mca_fcoll_vulcan_get_configuration (ompio_file_t *fh, int num_io_procs, 
@@ -123,6 +151,114 @@ int mca_fcoll_vulcan_file_write_all (ompio_file_t *fh,
                                       int count,
                                       struct ompi_datatype_t *datatype,
                                       ompi_status_public_t *status)
+{
+    mca_fcoll_vulcan_wait_pending (fh);
+    return write_all (fh, buf, count, datatype, status, NULL);
+}
+
+int mca_fcoll_vulcan_file_iwrite_all (ompio_file_t *fh,
+                                      const void *buf,
+                                      int count,
+                                      struct ompi_datatype_t *datatype,
+                                      ompi_request_t **request)
+{
+    mca_ompio_request_t *ompio_req = NULL;
+    int ret;
+
+    mca_fcoll_vulcan_wait_pending (fh);
+
+    mca_common_ompio_request_alloc ( &ompio_req, MCA_OMPIO_REQUEST_WRITE_ALL );
+    ompio_req->req_ompi.req_status.MPI_ERROR = OMPI_SUCCESS;
+    mca_common_ompio_register_progress ();
+
+    ret = write_all (fh, buf, count, datatype, &ompio_req->req_ompi.req_status, ompio_req);
+    if ( OMPI_SUCCESS != ret || NULL == ompio_req->req_progress_fn ) {
+        /* failed, or nothing left to do for the progress engine */
+        ompio_req->req_ompi.req_status.MPI_ERROR = ret;
+        ompi_request_complete (&ompio_req->req_ompi, false);
+    }
+
+    *request = (ompi_request_t *) ompio_req;
+    return ret;
+}
+
+/*
+  Advance a nonblocking collective write. Called from the ompio progress
+  function; returns true once the last cycle has been written.
+*/
+bool mca_fcoll_vulcan_write_progress (mca_ompio_request_t *ompio_req)
+{
+    mca_io_ompio_write_state *ws = (mca_io_ompio_write_state *) ompio_req->req_data;
+    ompio_file_t *fh = ws->fh;
+    int i, ret;
+
+    /* the shuffle of cycle index and the write of cycle index-1 have
+       to be finished before the buffers can be swapped. Do not use
+       ompi_request_test_all here, it would recurse into opal_progress. */
+    for ( i=0; i<ws->num_reqs; i++ ) {
+        if ( !REQUEST_COMPLETE(ws->reqs[i]) ) {
+            return false;
+        }
+    }
+    if ( !REQUEST_COMPLETE(ws->req_iwrite) ) {
+        return false;
+    }
+
+    for ( i=0; i<ws->num_reqs; i++ ) {
+        if ( MPI_REQUEST_NULL != ws->reqs[i] ) {
+            if ( OMPI_SUCCESS == ws->error ) {
+                ws->error = ws->reqs[i]->req_status.MPI_ERROR;
+            }
+            ompi_request_free (&ws->reqs[i]);
+        }
+    }
+    if ( MPI_REQUEST_NULL != ws->req_iwrite ) {
+        if ( OMPI_SUCCESS == ws->error ) {
+            ws->error = ws->req_iwrite->req_status.MPI_ERROR;
+        }
+        ompi_request_free (&ws->req_iwrite);
+    }
+    if ( OMPI_SUCCESS != ws->error || ws->index == ws->cycles ) {
+        goto done;
+    }
+
+    SWAP_AGGR_POINTERS(ws->aggr_data, ws->num_aggrs);
+    if ( NOT_AGGR_INDEX != ws->aggr_index ) {
+        ret = write_init (fh, fh->f_aggr_list[ws->aggr_index], ws->aggr_data[ws->aggr_index],
+                          ws->write_chunksize, ws->write_synch_type, &ws->req_iwrite);
+        if ( OMPI_SUCCESS != ret ) {
+            ws->error = ret;
+            goto done;
+        }
+    }
+
+    ws->index++;
+    if ( ws->index < ws->cycles ) {
+        for ( i=0; i<ws->num_aggrs; i++ ) {
+            ret = shuffle_init ( ws->index, ws->cycles, fh->f_aggr_list[i], fh->f_rank,
+                                 ws->aggr_data[i], &ws->reqs[i*(ws->procs_per_group + 1)] );
+            if ( OMPI_SUCCESS != ret ) {
+                /* finish what has been started, then report the error */
+                ws->error = ret;
+                ws->index = ws->cycles;
+                break;
+            }
+        }
+    }
+    return false;
+
+done:
+    ompio_req->req_ompi.req_status.MPI_ERROR = ws->error;
+    write_state_free (ompio_req);
+    return true;
+}
+
+static int write_all (ompio_file_t *fh,
+                      const void *buf,
+                      int count,
+                      struct ompi_datatype_t *datatype,
+                      ompi_status_public_t *status,
+                      mca_ompio_request_t *ompio_req)
 {
     int index = 0;
     int cycles = 0;
@@ -150,6 +286,11 @@ int mca_fcoll_vulcan_file_write_all (ompio_file_t *fh,
     int aggr_index = NOT_AGGR_INDEX;
     int write_synch_type = 2;
     int write_chunksize, *result_counts=NULL;
+    bool bufs_registered = false;
+    bool stripe_domains = false;
+    long compress_chunk = 0;
+    mca_io_ompio_write_state *ws = NULL;
+    uint64_t stats_start;
     
 #if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
     double write_time = 0.0, start_write_time = 0.0, end_write_time = 0.0;
@@ -178,6 +319,12 @@ int mca_fcoll_vulcan_file_write_all (ompio_file_t *fh,
     /* since we want to overlap 2 iterations, define the bytes_per_cycle to be half of what
        the user requested */
     bytes_per_cycle =bytes_per_cycle/2;
+    compress_chunk = (long) mca_common_ompio_compress_chunk_size (fh);
+    if ( 0 < compress_chunk ) {
+        /* let the cycles of contiguous data end on chunk boundaries */
+        bytes_per_cycle = bytes_per_cycle < compress_chunk ? compress_chunk :
+            (bytes_per_cycle / compress_chunk) * compress_chunk;
+    }
     write_chunksize = bytes_per_cycle;
     
     ret =   mca_common_ompio_decode_datatype ((struct ompio_file_t *) fh,
@@ -202,6 +349,18 @@ int mca_fcoll_vulcan_file_write_all (ompio_file_t *fh,
 	goto exit;
     }
 
+    ret = mca_fcoll_vulcan_node_aggregators (fh);
+    if (OMPI_SUCCESS != ret){
+	goto exit;
+    }
+
+    stripe_domains = mca_fcoll_vulcan_stripe_aware && 0 < fh->f_stripe_size &&
+        1 < fh->f_stripe_count &&
+        (0 == compress_chunk || 0 == fh->f_stripe_size % compress_chunk);
+    if ( stripe_domains ) {
+        stripe_aggregators (fh);
+    }
+
     aggr_data = (mca_io_ompio_aggregator_data **) malloc ( fh->f_num_aggrs * 
                                                            sizeof(mca_io_ompio_aggregator_data*));
     
@@ -232,22 +391,46 @@ int mca_fcoll_vulcan_file_write_all (ompio_file_t *fh,
     if (ret != OMPI_SUCCESS){
 	goto exit;
     }
+
+    /* With node level aggregation, the node leader writes on behalf of
+       all processes of its node from here on. */
+    ret = mca_fcoll_vulcan_node_gather (fh, &decoded_iov, &iov_count,
+                                        &local_iov_array, &local_count);
+    if (ret != OMPI_SUCCESS){
+	goto exit;
+    }
     
     /*************************************************************************
      ** 2b. Separate the local_iov_array entries based on the number of aggregators
      *************************************************************************/
     // Modifications for the even distribution:
     long domain_size;
-    ret = mca_fcoll_vulcan_minmax ( fh, local_iov_array, local_count,  fh->f_num_aggrs, &domain_size);
+    if ( stripe_domains ) {
+        /* the stripes are the file domains, assigned group-cyclic */
+        domain_size = fh->f_stripe_size;
+    }
+    else {
+        ret = mca_fcoll_vulcan_minmax ( fh, local_iov_array, local_count,  fh->f_num_aggrs, &domain_size);
+        if ( (mca_fcoll_vulcan_stripe_aware || mca_fcoll_vulcan_node_aggregation) &&
+             0 < fh->f_stripe_size ) {
+            /* align the file domains to the stripes */
+            domain_size = ((domain_size + fh->f_stripe_size - 1) / fh->f_stripe_size) * fh->f_stripe_size;
+        }
+        if ( 0 < compress_chunk ) {
+            /* no two aggregators may write into the same chunk */
+            domain_size = ((domain_size + compress_chunk - 1) / compress_chunk) * compress_chunk;
+        }
+    }
     
     // broken_iov_arrays[0] contains broken_counts[0] entries to aggregator 0,
     // broken_iov_arrays[1] contains broken_counts[1] entries to aggregator 1, etc.
-    ret = mca_fcoll_vulcan_break_file_view ( decoded_iov, iov_count, 
+    ret = mca_fcoll_vulcan_break_file_view ( fh, decoded_iov, iov_count, 
                                               local_iov_array, local_count, 
                                               &broken_decoded_iovs, &broken_iov_counts,
                                               &broken_iov_arrays, &broken_counts, 
                                               &broken_total_lengths,
-                                              fh->f_num_aggrs, domain_size); 
+                                              fh->f_num_aggrs, domain_size,
+                                              stripe_domains); 
 
 
     /**************************************************************************
@@ -566,13 +749,85 @@ int mca_fcoll_vulcan_file_write_all (ompio_file_t *fh,
         }
     }
 
+    /* The two aggregation buffers are used for every cycle,
+       give the fbtl a chance to register them once. */
+    if ( NULL == ompio_req && NOT_AGGR_INDEX != aggr_index && 0 < cycles &&
+         NULL != fh->f_fbtl->fbtl_register_buffers ) {
+        struct iovec bufs[2];
+
+        bufs[0].iov_base = aggr_data[aggr_index]->global_buf;
+        bufs[0].iov_len  = bytes_per_cycle;
+        bufs[1].iov_base = aggr_data[aggr_index]->prev_global_buf;
+        bufs[1].iov_len  = bytes_per_cycle;
+        bufs_registered = (OMPI_SUCCESS == fh->f_fbtl->fbtl_register_buffers (fh, bufs, 2));
+    }
+
     // In fact it should be: if ((1 == mca_fcoll_vulcan_async_io) && (NULL != fh->f_fbtl->fbtl_ipwritev))
     // But we've already tested that.
     if( (1 == mca_fcoll_vulcan_async_io) ||
         ( (0 == mca_fcoll_vulcan_async_io) && (NULL != fh->f_fbtl->fbtl_ipwritev) && (2 < cycles) ) ) {
         write_synch_type = 1;
     }
+    if ( NULL != fh->f_compress ) {
+        /* chunks are compressed by the aggregator in write_init */
+        write_synch_type = 2;
+    }
 
+    if ( NULL != ompio_req ) {
+        /* Nonblocking operation: post the shuffle of the first cycle,
+           the remaining cycles are driven by the progress engine. The
+           state takes over the aggregator data and the group. */
+        if ( 0 == mca_fcoll_vulcan_async_io && NULL != fh->f_fbtl->fbtl_ipwritev &&
+             NULL == fh->f_compress ) {
+            write_synch_type = 1;
+        }
+        if ( 0 == cycles ) {
+            goto exit;
+        }
+        ws = (mca_io_ompio_write_state *) calloc (1, sizeof(mca_io_ompio_write_state));
+        if ( NULL == ws ) {
+            opal_output (1, "OUT OF MEMORY\n");
+            ret = OMPI_ERR_OUT_OF_RESOURCE;
+            goto exit;
+        }
+        ws->fh               = fh;
+        ws->aggr_data        = aggr_data;
+        ws->num_aggrs        = fh->f_num_aggrs;
+        ws->procs_in_group   = fh->f_procs_in_group;
+        ws->procs_per_group  = fh->f_procs_per_group;
+        ws->reqs             = reqs;
+        ws->num_reqs         = (fh->f_procs_per_group + 1) * fh->f_num_aggrs;
+        ws->req_iwrite       = MPI_REQUEST_NULL;
+        ws->cycles           = cycles;
+        ws->aggr_index       = aggr_index;
+        ws->write_chunksize  = write_chunksize;
+        ws->write_synch_type = write_synch_type;
+        ws->error            = OMPI_SUCCESS;
+        aggr_data            = NULL;
+        reqs                 = NULL;
+        fh->f_procs_in_group = NULL;
+
+        ompio_req->req_data        = ws;
+        ompio_req->req_progress_fn = mca_fcoll_vulcan_write_progress;
+        ompio_req->req_free_fn     = write_state_free;
+
+        for ( i=0; i<ws->num_aggrs; i++ ) {
+            ret = shuffle_init ( 0, cycles, fh->f_aggr_list[i], fh->f_rank, ws->aggr_data[i],
+                                 &ws->reqs[i*(ws->procs_per_group + 1)] );
+            if ( OMPI_SUCCESS != ret ) {
+                /* the shuffles already posted use the buffers of the
+                   state, let the progress function finish them and
+                   complete the request with the error */
+                ws->error = ret;
+                ws->index = ws->cycles;
+                ret = OMPI_SUCCESS;
+                break;
+            }
+        }
+        goto exit;
+    }
+
+    stats_start = mca_common_ompio_stats_time (fh);
     if ( cycles > 0 ) {
         for ( i=0; i<fh->f_num_aggrs; i++ ) {
             ret = shuffle_init ( 0, cycles, fh->f_aggr_list[i], fh->f_rank, aggr_data[i],
@@ -589,10 +844,23 @@ int mca_fcoll_vulcan_file_write_all (ompio_file_t *fh,
 
     ret = ompi_request_wait_all ( (fh->f_procs_per_group + 1 )*fh->f_num_aggrs,
                                   reqs, MPI_STATUS_IGNORE);
+    mca_common_ompio_stats_phase (fh, OMPIO_STATS_SHUFFLE, stats_start);
 
     for (index = 1; index < cycles; index++) {
         SWAP_AGGR_POINTERS(aggr_data, fh->f_num_aggrs);
 
+        /* post the shuffle of this cycle first, it only touches the
+           current buffers and overlaps a blocking write_init */
+        stats_start = mca_common_ompio_stats_time (fh);
+        for ( i=0; i<fh->f_num_aggrs; i++ ) {
+            ret = shuffle_init ( index, cycles, fh->f_aggr_list[i], fh->f_rank, aggr_data[i],
+                                 &reqs[i*(fh->f_procs_per_group + 1)] );
+            if ( OMPI_SUCCESS != ret ) {
+                goto exit;
+            }
+        }
+        mca_common_ompio_stats_phase (fh, OMPIO_STATS_SHUFFLE, stats_start);
+
         if(NOT_AGGR_INDEX != aggr_index) {
 #if OMPIO_FCOLL_WANT_TIME_BREAKDOWN
             start_write_time = MPI_Wtime();
@@ -608,22 +876,18 @@ int mca_fcoll_vulcan_file_write_all (ompio_file_t *fh,
 #endif
         }
 
-        for ( i=0; i<fh->f_num_aggrs; i++ ) {
-            ret = shuffle_init ( index, cycles, fh->f_aggr_list[i], fh->f_rank, aggr_data[i],
-                                 &reqs[i*(fh->f_procs_per_group + 1)] );
-            if ( OMPI_SUCCESS != ret ) {
-                goto exit;
-            }
-        }
-
+        stats_start = mca_common_ompio_stats_time (fh);
         ret = ompi_request_wait_all ( (fh->f_procs_per_group + 1 )*fh->f_num_aggrs,
                                       reqs, MPI_STATUS_IGNORE);
+        mca_common_ompio_stats_phase (fh, OMPIO_STATS_SHUFFLE, stats_start);
         if (OMPI_SUCCESS != ret){
             goto exit;
         }
 
         if(NOT_AGGR_INDEX != aggr_index) {
+            stats_start = mca_common_ompio_stats_time (fh);
             ret = ompi_request_wait(&req_iwrite, MPI_STATUS_IGNORE);
+            mca_common_ompio_stats_phase (fh, OMPIO_STATS_WAIT, stats_start);
             if (OMPI_SUCCESS != ret){
                 goto exit;
             }
@@ -649,7 +913,9 @@ int mca_fcoll_vulcan_file_write_all (ompio_file_t *fh,
         }
 
         if(NOT_AGGR_INDEX != aggr_index) {
+            stats_start = mca_common_ompio_stats_time (fh);
             ret = ompi_request_wait(&req_iwrite, MPI_STATUS_IGNORE);
+            mca_common_ompio_stats_phase (fh, OMPIO_STATS_WAIT, stats_start);
             if (OMPI_SUCCESS != ret){
                 goto exit;
             }
@@ -677,44 +943,21 @@ int mca_fcoll_vulcan_file_write_all (ompio_file_t *fh,
     
 exit :
     
+    if ( NULL != reqs ) {
+        /* after an error, shuffles or a write may still be in flight */
+        ompi_request_wait_all ( (fh->f_procs_per_group + 1 )*fh->f_num_aggrs,
+                                reqs, MPI_STATUS_IGNORE);
+    }
+    if ( MPI_REQUEST_NULL != req_iwrite ) {
+        ompi_request_wait (&req_iwrite, MPI_STATUS_IGNORE);
+    }
+
+    if ( bufs_registered ) {
+        fh->f_fbtl->fbtl_unregister_buffers (fh);
+    }
+
     if ( NULL != aggr_data ) {
-        
-        for ( i=0; i< fh->f_num_aggrs; i++ ) {            
-            if (fh->f_aggr_list[i] == fh->f_rank) {
-                if (NULL != aggr_data[i]->recvtype){
-                    for (j =0; j< aggr_data[i]->procs_per_group; j++) {
-                        if ( MPI_DATATYPE_NULL != aggr_data[i]->recvtype[j] ) {
-                            ompi_datatype_destroy(&aggr_data[i]->recvtype[j]);
-                        }
-                        if ( MPI_DATATYPE_NULL != aggr_data[i]->prev_recvtype[j] ) {
-                            ompi_datatype_destroy(&aggr_data[i]->prev_recvtype[j]);
-                        }
-			
-                    }
-                    free(aggr_data[i]->recvtype);
-                    free(aggr_data[i]->prev_recvtype);
-                }
-                
-                free (aggr_data[i]->disp_index);
-                free (aggr_data[i]->max_disp_index);
-                free (aggr_data[i]->global_buf);
-                free (aggr_data[i]->prev_global_buf);
-                for(l=0;l<aggr_data[i]->procs_per_group;l++){
-                    free (aggr_data[i]->blocklen_per_process[l]);
-                    free (aggr_data[i]->displs_per_process[l]);
-                }
-                
-                free (aggr_data[i]->blocklen_per_process);
-                free (aggr_data[i]->displs_per_process);
-            }
-            free (aggr_data[i]->sorted);
-            free (aggr_data[i]->global_iov_array);
-            free (aggr_data[i]->fview_count);
-            free (aggr_data[i]->decoded_iov);
-            
-            free (aggr_data[i]);
-        }
-        free (aggr_data);
+        aggr_data_free (fh, aggr_data, fh->f_num_aggrs);
     }
     free(displs);
     free(decoded_iov);
@@ -734,7 +977,74 @@ exit :
     free(result_counts);
     free(reqs);
      
-    return OMPI_SUCCESS;
+    return ret;
+}
+
+static void aggr_data_free (ompio_file_t *fh, mca_io_ompio_aggregator_data **aggr_data,
+                            int num_aggrs)
+{
+    int i, j, l;
+
+    for ( i=0; i< num_aggrs; i++ ) {            
+        if (fh->f_aggr_list[i] == fh->f_rank) {
+            if (NULL != aggr_data[i]->recvtype){
+                for (j =0; j< aggr_data[i]->procs_per_group; j++) {
+                    if ( MPI_DATATYPE_NULL != aggr_data[i]->recvtype[j] ) {
+                        ompi_datatype_destroy(&aggr_data[i]->recvtype[j]);
+                    }
+                    if ( MPI_DATATYPE_NULL != aggr_data[i]->prev_recvtype[j] ) {
+                        ompi_datatype_destroy(&aggr_data[i]->prev_recvtype[j]);
+                    }
+			
+                }
+                free(aggr_data[i]->recvtype);
+                free(aggr_data[i]->prev_recvtype);
+            }
+            
+            free (aggr_data[i]->disp_index);
+            free (aggr_data[i]->max_disp_index);
+            free (aggr_data[i]->global_buf);
+            free (aggr_data[i]->prev_global_buf);
+            for(l=0;l<aggr_data[i]->procs_per_group;l++){
+                free (aggr_data[i]->blocklen_per_process[l]);
+                free (aggr_data[i]->displs_per_process[l]);
+            }
+            
+            free (aggr_data[i]->blocklen_per_process);
+            free (aggr_data[i]->displs_per_process);
+        }
+        free (aggr_data[i]->sorted);
+        free (aggr_data[i]->global_iov_array);
+        free (aggr_data[i]->fview_count);
+        free (aggr_data[i]->decoded_iov);
+        
+        free (aggr_data[i]);
+    }
+    free (aggr_data);
+}
+
+static void write_state_free (mca_ompio_request_t *ompio_req)
+{
+    mca_io_ompio_write_state *ws = (mca_io_ompio_write_state *) ompio_req->req_data;
+    int i;
+
+    if ( NULL == ws || NULL == ws->aggr_data ) {
+        return;
+    }
+    for ( i=0; i<ws->num_reqs; i++ ) {
+        if ( MPI_REQUEST_NULL != ws->reqs[i] ) {
+            ompi_request_free (&ws->reqs[i]);
+        }
+    }
+    if ( MPI_REQUEST_NULL != ws->req_iwrite ) {
+        ompi_request_free (&ws->req_iwrite);
+    }
+    aggr_data_free (ws->fh, ws->aggr_data, ws->num_aggrs);
+    free (ws->procs_in_group);
+    free (ws->reqs);
+    ws->aggr_data      = NULL;
+    ws->procs_in_group = NULL;
+    ws->reqs           = NULL;
 }
 
 static int write_init (ompio_file_t *fh,
@@ -749,6 +1059,7 @@ static int write_init (ompio_file_t *fh,
     int last_array_pos = 0;
     int last_pos = 0;
     mca_ompio_request_t *ompio_req = NULL;
+    uint64_t stats_start;
 
     mca_common_ompio_request_alloc ( &ompio_req, MCA_OMPIO_REQUEST_WRITE );
 
@@ -762,6 +1073,8 @@ static int write_init (ompio_file_t *fh,
                                           &last_array_pos, &last_pos,
                                           write_chunksize);
 
+        mca_common_ompio_stats_aggr (fh, aggr_data->prev_bytes_to_write);
+        stats_start = mca_common_ompio_stats_time (fh);
         if (1 == write_synchType) {
             ret = fh->f_fbtl->fbtl_ipwritev(fh, (ompi_request_t *) ompio_req);
             if(0 > ret) {
@@ -771,7 +1084,12 @@ static int write_init (ompio_file_t *fh,
             }
         }
         else {
-            ret_temp = fh->f_fbtl->fbtl_pwritev(fh);
+            if ( NULL != fh->f_compress ) {
+                ret_temp = mca_common_ompio_compress_pwritev (fh);
+            }
+            else {
+                ret_temp = fh->f_fbtl->fbtl_pwritev(fh);
+            }
             if(0 > ret_temp) {
                 opal_output (1, "vulcan_write_all: fbtl_pwritev failed\n");
                 ret = ret_temp;
@@ -782,6 +1100,7 @@ static int write_init (ompio_file_t *fh,
             ompio_req->req_ompi.req_status._ucount = ret_temp;
             ompi_request_complete (&ompio_req->req_ompi, false);
         }
+        mca_common_ompio_stats_phase (fh, OMPIO_STATS_IO, stats_start);
 
         free(fh->f_io_array);
         free(aggr_data->prev_io_array);
@@ -1392,12 +1711,14 @@ static int mca_fcoll_vulcan_minmax ( ompio_file_t *fh, struct iovec *iov, int io
     
     
 
-int mca_fcoll_vulcan_break_file_view ( struct iovec *mem_iov, int mem_count, 
+int mca_fcoll_vulcan_break_file_view ( ompio_file_t *fh,
+                                        struct iovec *mem_iov, int mem_count, 
                                         struct iovec *file_iov, int file_count, 
                                         struct iovec ***ret_broken_mem_iovs, int **ret_broken_mem_counts,
                                         struct iovec ***ret_broken_file_iovs, int **ret_broken_file_counts, 
                                         MPI_Aint **ret_broken_total_lengths,
-                                        int stripe_count, size_t stripe_size)
+                                        int stripe_count, size_t stripe_size,
+                                        bool stripe_domains)
 {
     int i, j, ret=OMPI_SUCCESS;
     struct iovec **broken_mem_iovs=NULL; 
@@ -1470,7 +1791,12 @@ int mca_fcoll_vulcan_break_file_view ( struct iovec *mem_iov, int mem_count,
                file_iov[i].iov_base, file_iov[i].iov_len);
 #endif
         do {
-            owner        = (offset / stripe_size ) % stripe_count;
+            if ( stripe_domains ) {
+                owner    = mca_common_ompio_stripe_owner (fh, offset, stripe_count);
+            }
+            else {
+                owner    = (offset / stripe_size ) % stripe_count;
+            }
             start_offset = (offset / stripe_size );
             rest         = (start_offset + 1) * stripe_size - offset;
 
@@ -1651,6 +1977,22 @@ int mca_fcoll_vulcan_get_configuration (ompio_file_t *fh, int num_io_procs, int
 }    
     
 
+/*
+** Reduce the number of aggregators to a multiple or a divisor of the stripe
+** count, keeping a subset spread evenly over the current list.
+*/
+static void stripe_aggregators (ompio_file_t *fh)
+{
+    int i, num_aggrs;
+
+    num_aggrs = mca_common_ompio_stripe_aggregators (fh, fh->f_num_aggrs);
+    for ( i=0; i<num_aggrs; i++ ) {
+        fh->f_aggr_list[i] = fh->f_aggr_list[(long)i * fh->f_num_aggrs / num_aggrs];
+    }
+    fh->f_num_aggrs = num_aggrs;
+}
+
+
 int mca_fcoll_vulcan_split_iov_array ( ompio_file_t *fh, mca_common_ompio_io_array_t *io_array, int num_entries,
                                              int *ret_array_pos, int *ret_pos,  int chunk_size )
 {
@@ -27,6 +27,7 @@
 #include "mpi.h"
 #include "ompi/mca/fcoll/fcoll.h"
 #include "ompi/mca/fcoll/base/base.h"
+#include "ompi/mca/common/ompio/common_ompio_request.h"
 
 
 /*
@@ -38,9 +39,9 @@ static mca_fcoll_base_module_1_0_0_t vulcan =  {
     mca_fcoll_vulcan_module_init,
     mca_fcoll_vulcan_module_finalize,
     mca_fcoll_vulcan_file_read_all,
-    NULL, /* iread_all */
+    mca_fcoll_vulcan_file_iread_all,
     mca_fcoll_vulcan_file_write_all,
-    NULL, /*iwrite_all */
+    mca_fcoll_vulcan_file_iwrite_all,
     NULL, /* progress */
     NULL  /* request_free */
 };
@@ -88,5 +89,44 @@ int mca_fcoll_vulcan_module_init (ompio_file_t *file)
 
 int mca_fcoll_vulcan_module_finalize (ompio_file_t *file)
 {
+    /* not allowed by the standard, but do not leave the progress
+       engine with a dangling file handle */
+    mca_fcoll_vulcan_wait_pending (file);
+    mca_fcoll_vulcan_node_release (file);
     return OMPI_SUCCESS;
 }
+
+/*
+  Complete all nonblocking collective operations on the file. The
+  cycles of an operation match their messages by tag only, hence a new
+  collective operation can not start before the previous one finished.
+*/
+void mca_fcoll_vulcan_wait_pending (ompio_file_t *fh)
+{
+    opal_list_item_t *litem = NULL;
+    mca_ompio_request_t *req = NULL;
+    bool found;
+
+    do {
+        found = false;
+        OPAL_LIST_FOREACH(litem, &mca_common_ompio_pending_requests, opal_list_item_t) {
+            req = GET_OMPIO_REQ_FROM_ITEM(litem);
+            if ( REQUEST_COMPLETE(&req->req_ompi) ||
+                 ( mca_fcoll_vulcan_write_progress != req->req_progress_fn &&
+                   mca_fcoll_vulcan_read_progress != req->req_progress_fn ) ) {
+                continue;
+            }
+            /* the state of both operations starts with the file handle */
+            if ( fh == *(ompio_file_t **) req->req_data ) {
+                found = true;
+                break;
+            }
+        }
+        if ( found ) {
+            /* the list may change while progressing */
+            while ( !REQUEST_COMPLETE(&req->req_ompi) ) {
+                opal_progress ();
+            }
+        }
+    } while ( found );
+}
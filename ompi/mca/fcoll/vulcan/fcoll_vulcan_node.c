@@ -0,0 +1,372 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi_config.h"
+#include "fcoll_vulcan.h"
+
+#include "mpi.h"
+#include "ompi/constants.h"
+#include "ompi/communicator/communicator.h"
+#include "ompi/mca/fcoll/base/base.h"
+#include "ompi/mca/common/ompio/common_ompio.h"
+#include "ompi/runtime/ompi_rte.h"
+#include "opal/mca/shmem/base/base.h"
+#include "opal/util/printf.h"
+
+#include <string.h>
+
+/*
+  Node level aggregation for the collective write operations.
+
+  All processes of a node copy the file offsets/lengths and the data of
+  the current operation into a shared memory segment. The node leader
+  (rank 0 of the node communicator) merges the entries of its node into
+  a single list sorted by file offset, and takes part in the regular
+  vulcan algorithm with the data of the entire node, while the other
+  processes of the node contribute nothing. Only node leaders are used
+  as aggregators, hence the shuffle traffic is restricted to one process
+  per node.
+
+  The segment is kept across operations and grown on demand up to
+  node_buffer_size. Operations requiring a larger segment on a node are
+  executed without node aggregation on that node.
+*/
+
+#define NODE_SEG_ALIGN 1048576
+
+static int node_setup (ompio_file_t *fh, mca_fcoll_vulcan_node_data_t **ret_nd)
+{
+    mca_fcoll_vulcan_node_data_t *nd;
+    int i, is_leader, *leader_flags=NULL;
+    int ret;
+
+    if ( NULL != fh->f_fcoll_data ) {
+        *ret_nd = (mca_fcoll_vulcan_node_data_t *) fh->f_fcoll_data;
+        return OMPI_SUCCESS;
+    }
+
+    nd = (mca_fcoll_vulcan_node_data_t *) calloc (1, sizeof(mca_fcoll_vulcan_node_data_t));
+    leader_flags = (int *) malloc (fh->f_size * sizeof(int));
+    if ( NULL == nd || NULL == leader_flags ) {
+        ret = OMPI_ERR_OUT_OF_RESOURCE;
+        goto exit;
+    }
+    nd->node_comm = MPI_COMM_NULL;
+
+    ret = ompi_comm_split_type (fh->f_comm, MPI_COMM_TYPE_SHARED, 0, NULL, &nd->node_comm);
+    if ( OMPI_SUCCESS != ret ) {
+        goto exit;
+    }
+    nd->node_rank = ompi_comm_rank (nd->node_comm);
+    nd->node_size = ompi_comm_size (nd->node_comm);
+
+    is_leader = (0 == nd->node_rank);
+    ret = fh->f_comm->c_coll->coll_allgather (&is_leader, 1, MPI_INT,
+                                              leader_flags, 1, MPI_INT,
+                                              fh->f_comm,
+                                              fh->f_comm->c_coll->coll_allgather_module);
+    if ( OMPI_SUCCESS != ret ) {
+        goto exit;
+    }
+
+    for ( i=0; i<fh->f_size; i++ ) {
+        nd->num_leaders += leader_flags[i];
+    }
+    nd->leaders = (int *) malloc (nd->num_leaders * sizeof(int));
+    if ( NULL == nd->leaders ) {
+        ret = OMPI_ERR_OUT_OF_RESOURCE;
+        goto exit;
+    }
+    nd->num_leaders = 0;
+    for ( i=0; i<fh->f_size; i++ ) {
+        if ( leader_flags[i] ) {
+            nd->leaders[nd->num_leaders++] = i;
+        }
+    }
+
+    fh->f_fcoll_data = nd;
+    *ret_nd = nd;
+    nd = NULL;
+
+exit:
+    if ( NULL != nd ) {
+        if ( MPI_COMM_NULL != nd->node_comm ) {
+            ompi_comm_free (&nd->node_comm);
+        }
+        free (nd->leaders);
+        free (nd);
+    }
+    free (leader_flags);
+    return ret;
+}
+
+static int node_segment_resize (ompio_file_t *fh, mca_fcoll_vulcan_node_data_t *nd, size_t size)
+{
+    ompi_communicator_t *comm = nd->node_comm;
+    char *seg_file;
+    int ret = OMPI_SUCCESS;
+
+    if ( NULL != nd->seg_base ) {
+        opal_shmem_segment_detach (&nd->seg_ds);
+        nd->seg_base = NULL;
+        nd->seg_size = 0;
+    }
+
+    size = ((size + NODE_SEG_ALIGN - 1) / NODE_SEG_ALIGN) * NODE_SEG_ALIGN;
+
+    if ( 0 == nd->node_rank ) {
+        ret = opal_asprintf (&seg_file, "%s" OPAL_PATH_SEP "fcoll_vulcan.%s.%x.%d.%d.%d",
+                             ompi_process_info.job_session_dir, ompi_process_info.nodename,
+                             OMPI_PROC_MY_NAME->jobid, (int) OMPI_PROC_MY_NAME->vpid,
+                             ompi_comm_get_cid (fh->f_comm), nd->seg_id);
+        if ( 0 > ret ) {
+            ret = OMPI_ERR_OUT_OF_RESOURCE;
+        }
+        else {
+            ret = opal_shmem_segment_create (&nd->seg_ds, seg_file, size);
+            free (seg_file);
+        }
+    }
+    nd->seg_id++;
+
+    /* the other processes of the node have to know if the segment
+       could not be created */
+    comm->c_coll->coll_bcast (&ret, 1, MPI_INT, 0, comm, comm->c_coll->coll_bcast_module);
+    if ( OMPI_SUCCESS != ret ) {
+        return ret;
+    }
+
+    ret = comm->c_coll->coll_bcast (&nd->seg_ds, sizeof(nd->seg_ds), MPI_BYTE, 0,
+                                    comm, comm->c_coll->coll_bcast_module);
+    if ( OMPI_SUCCESS != ret ) {
+        goto exit;
+    }
+
+    nd->seg_base = (char *) opal_shmem_segment_attach (&nd->seg_ds);
+    if ( NULL == nd->seg_base ) {
+        ret = OMPI_ERROR;
+    }
+
+    /* wait for all processes to attach before removing the backing file */
+    comm->c_coll->coll_barrier (comm, comm->c_coll->coll_barrier_module);
+
+exit:
+    if ( 0 == nd->node_rank ) {
+        opal_shmem_unlink (&nd->seg_ds);
+    }
+    if ( OMPI_SUCCESS == ret ) {
+        nd->seg_size = size;
+    }
+    return ret;
+}
+
+/*
+  Restrict the aggregators to the node leaders, spread evenly over the
+  list of leaders if fewer aggregators than nodes were requested.
+*/
+int mca_fcoll_vulcan_node_aggregators (ompio_file_t *fh)
+{
+    mca_fcoll_vulcan_node_data_t *nd;
+    int i, num_aggrs, ret;
+
+    if ( 0 == mca_fcoll_vulcan_node_aggregation ) {
+        return OMPI_SUCCESS;
+    }
+
+    ret = node_setup (fh, &nd);
+    if ( OMPI_SUCCESS != ret ) {
+        return ret;
+    }
+    if ( nd->num_leaders == fh->f_size ) {
+        /* one process per node */
+        return OMPI_SUCCESS;
+    }
+
+    num_aggrs = fh->f_num_aggrs;
+    if ( num_aggrs > nd->num_leaders ) {
+        num_aggrs = nd->num_leaders;
+    }
+    for ( i=0; i<num_aggrs; i++ ) {
+        fh->f_aggr_list[i] = nd->leaders[(i * nd->num_leaders) / num_aggrs];
+    }
+    fh->f_num_aggrs = num_aggrs;
+
+    return OMPI_SUCCESS;
+}
+
+/*
+  Replace the memory and file iovecs of the calling process by the
+  merged entries of its node on the node leader, and by empty lists on
+  all other processes of the node.
+*/
+int mca_fcoll_vulcan_node_gather (ompio_file_t *fh,
+                                  struct iovec **decoded_iov, uint32_t *iov_count,
+                                  struct iovec **local_iov_array, int *local_count)
+{
+    mca_fcoll_vulcan_node_data_t *nd = (mca_fcoll_vulcan_node_data_t *) fh->f_fcoll_data;
+    ompi_communicator_t *comm;
+    long local[2], *all=NULL;
+    size_t iov_bytes, total, data_pos, pos, len;
+    long total_count=0, total_data=0, first_entry=0;
+    struct iovec *seg_iov, *file_iov=NULL, *mem_iov=NULL;
+    char **mem_addr=NULL;
+    int *sorted=NULL;
+    int i, k, n, ret;
+    uint32_t j;
+
+    if ( 0 == mca_fcoll_vulcan_node_aggregation || NULL == nd || 1 == nd->node_size ) {
+        return OMPI_SUCCESS;
+    }
+    comm = nd->node_comm;
+
+    local[0] = *local_count;
+    local[1] = 0;
+    for ( j=0; j<*iov_count; j++ ) {
+        local[1] += (*decoded_iov)[j].iov_len;
+    }
+
+    all = (long *) malloc (2 * nd->node_size * sizeof(long));
+    if ( NULL == all ) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
+    }
+    ret = comm->c_coll->coll_allgather (local, 2, MPI_LONG, all, 2, MPI_LONG,
+                                        comm, comm->c_coll->coll_allgather_module);
+    if ( OMPI_SUCCESS != ret ) {
+        goto exit;
+    }
+
+    data_pos = 0;
+    for ( i=0; i<nd->node_size; i++ ) {
+        if ( i < nd->node_rank ) {
+            first_entry += all[2*i];
+            data_pos    += all[2*i+1];
+        }
+        total_count += all[2*i];
+        total_data  += all[2*i+1];
+    }
+    iov_bytes = total_count * sizeof(struct iovec);
+    iov_bytes = ((iov_bytes + 63) / 64) * 64;
+    total     = iov_bytes + total_data;
+
+    if ( 0 == total_count || total > (size_t) mca_fcoll_vulcan_node_buffer_size ) {
+        /* the same decision is taken by all processes of the node */
+        goto exit;
+    }
+
+    if ( total > nd->seg_size ) {
+        ret = node_segment_resize (fh, nd, total);
+        if ( OMPI_SUCCESS != ret ) {
+            goto exit;
+        }
+    }
+
+    /* deposit the local entries and data */
+    seg_iov = (struct iovec *) nd->seg_base;
+    if ( 0 < *local_count ) {
+        memcpy ( &seg_iov[first_entry], *local_iov_array, *local_count * sizeof(struct iovec));
+    }
+    pos = iov_bytes + data_pos;
+    for ( j=0; j<*iov_count; j++ ) {
+        memcpy ( nd->seg_base + pos, (*decoded_iov)[j].iov_base, (*decoded_iov)[j].iov_len);
+        pos += (*decoded_iov)[j].iov_len;
+    }
+
+    ret = comm->c_coll->coll_barrier (comm, comm->c_coll->coll_barrier_module);
+    if ( OMPI_SUCCESS != ret ) {
+        goto exit;
+    }
+
+    if ( 0 != nd->node_rank ) {
+        /* the leader reads the data from the segment until the end of
+           the operation. It can not be overwritten before the leader
+           entered the allgather of the next operation. */
+        free (*decoded_iov);
+        free (*local_iov_array);
+        *decoded_iov     = NULL;
+        *iov_count       = 0;
+        *local_iov_array = NULL;
+        *local_count     = 0;
+        goto exit;
+    }
+
+    /* node leader: the entries are stored in rank order, the data of
+       every entry follows the data of the previous entry. */
+    mem_addr = (char **) malloc (total_count * sizeof(char *));
+    sorted   = (int *) malloc (total_count * sizeof(int));
+    file_iov = (struct iovec *) malloc (total_count * sizeof(struct iovec));
+    mem_iov  = (struct iovec *) malloc (total_count * sizeof(struct iovec));
+    if ( NULL == mem_addr || NULL == sorted || NULL == file_iov || NULL == mem_iov ) {
+        ret = OMPI_ERR_OUT_OF_RESOURCE;
+        goto exit;
+    }
+    pos = iov_bytes;
+    for ( k=0; k<total_count; k++ ) {
+        mem_addr[k] = nd->seg_base + pos;
+        pos += seg_iov[k].iov_len;
+    }
+
+    ompi_fcoll_base_sort_iovec (seg_iov, total_count, sorted);
+
+    /* merge entries which are contiguous both in the file and in the segment */
+    n = 0;
+    for ( k=0; k<total_count; k++ ) {
+        len = seg_iov[sorted[k]].iov_len;
+        if ( 0 < n &&
+             (char *) file_iov[n-1].iov_base + file_iov[n-1].iov_len == (char *) seg_iov[sorted[k]].iov_base &&
+             (char *) mem_iov[n-1].iov_base + mem_iov[n-1].iov_len == mem_addr[sorted[k]] ) {
+            file_iov[n-1].iov_len += len;
+            mem_iov[n-1].iov_len  += len;
+            continue;
+        }
+        file_iov[n].iov_base = seg_iov[sorted[k]].iov_base;
+        file_iov[n].iov_len  = len;
+        mem_iov[n].iov_base  = mem_addr[sorted[k]];
+        mem_iov[n].iov_len   = len;
+        n++;
+    }
+
+    free (*decoded_iov);
+    free (*local_iov_array);
+    *decoded_iov     = mem_iov;
+    *iov_count       = n;
+    *local_iov_array = file_iov;
+    *local_count     = n;
+    mem_iov  = NULL;
+    file_iov = NULL;
+
+exit:
+    free (all);
+    free (mem_addr);
+    free (sorted);
+    free (file_iov);
+    free (mem_iov);
+    return ret;
+}
+
+void mca_fcoll_vulcan_node_release (ompio_file_t *fh)
+{
+    mca_fcoll_vulcan_node_data_t *nd = (mca_fcoll_vulcan_node_data_t *) fh->f_fcoll_data;
+
+    if ( NULL == nd ) {
+        return;
+    }
+
+    if ( NULL != nd->seg_base ) {
+        opal_shmem_segment_detach (&nd->seg_ds);
+    }
+    if ( MPI_COMM_NULL != nd->node_comm ) {
+        ompi_comm_free (&nd->node_comm);
+    }
+    free (nd->leaders);
+    free (nd);
+    fh->f_fcoll_data = NULL;
+}
@@ -48,6 +48,7 @@ mca_fs_gpfs_file_open (struct ompi_communicator_t *comm,
 {
     int perm, amode;
     int ret = OMPI_SUCCESS;
+    struct stat statbuf;
 
     perm = mca_fs_base_get_file_perm(fh);
     amode = mca_fs_base_get_file_amode(fh->f_rank, access_mode);
@@ -72,6 +73,16 @@ mca_fs_gpfs_file_open (struct ompi_communicator_t *comm,
         }
     }
 
+    /* GPFS distributes the file blocks over all disks of the file system,
+       there is no fixed mapping to be exploited. Report the block size
+       such that file domains are at least aligned to the blocks. */
+    if ( 0 == fstat (fh->fd, &statbuf) && 0 < statbuf.st_blksize ) {
+        fh->f_stripe_size   = statbuf.st_blksize;
+        fh->f_fs_block_size = statbuf.st_blksize;
+    }
+    fh->f_stripe_count  = 1;
+    fh->f_stripe_offset = 0;
+
     fh->f_amode=access_mode;
     mca_fs_gpfs_file_set_info(fh, (struct ompi_info_t *) info);
 
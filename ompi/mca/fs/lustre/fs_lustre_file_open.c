@@ -139,11 +139,21 @@ mca_fs_lustre_file_open (struct ompi_communicator_t *comm,
     rc = llapi_file_get_stripe(filename, lump);
     if (rc != 0) {
         opal_output(1, "get_stripe failed: %d (%s)\n", errno, strerror(errno));
+        free(lump);
         return OMPI_ERROR;
     }
     fh->f_stripe_size   = lump->lmm_stripe_size;
     fh->f_stripe_count  = lump->lmm_stripe_count;
     fh->f_fs_block_size = lump->lmm_stripe_size;
+    /* OST index of the first stripe, used by the fcoll components to
+       assign the stripes of an OST to a fixed set of aggregators */
+    if ( LOV_USER_MAGIC_V3 == lump->lmm_magic ) {
+        fh->f_stripe_offset = ((struct lov_user_md_v3 *) lump)->lmm_objects[0].l_ost_idx;
+    }
+    else {
+        fh->f_stripe_offset = lump->lmm_objects[0].l_ost_idx;
+    }
+    free(lump);
     
     return OMPI_SUCCESS;
 }
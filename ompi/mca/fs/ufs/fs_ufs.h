@@ -30,6 +30,9 @@
 
 extern int mca_fs_ufs_priority;
 extern int mca_fs_ufs_lock_algorithm;
+extern int mca_fs_ufs_mock_stripe_size;
+extern int mca_fs_ufs_mock_stripe_count;
+extern int mca_fs_ufs_mock_stripe_offset;
 
 #define FS_UFS_LOCK_AUTO        0
 #define FS_UFS_LOCK_NEVER       1
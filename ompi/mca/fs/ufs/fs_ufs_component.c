@@ -32,6 +32,9 @@
 
 int mca_fs_ufs_priority = 10;
 int mca_fs_ufs_lock_algorithm=0; /* auto */
+int mca_fs_ufs_mock_stripe_size=0;
+int mca_fs_ufs_mock_stripe_count=1;
+int mca_fs_ufs_mock_stripe_offset=0;
 /*
  * Private functions
  */
@@ -91,5 +94,34 @@ static int register_component(void)
                                            MCA_BASE_VAR_SCOPE_READONLY,
                                            &mca_fs_ufs_lock_algorithm );
 
+    mca_fs_ufs_mock_stripe_size = 0;
+    (void) mca_base_component_var_register(&mca_fs_ufs_component.fsm_version,
+                                           "mock_stripe_size", "Stripe size reported for files opened "
+                                           "by the fs ufs component, to emulate the layout of a parallel "
+                                           "file system. 0: file is not striped (default)",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_fs_ufs_mock_stripe_size );
+
+    mca_fs_ufs_mock_stripe_count = 1;
+    (void) mca_base_component_var_register(&mca_fs_ufs_component.fsm_version,
+                                           "mock_stripe_count", "Number of OSTs reported for files opened "
+                                           "by the fs ufs component if mock_stripe_size is set",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_fs_ufs_mock_stripe_count );
+
+    mca_fs_ufs_mock_stripe_offset = 0;
+    (void) mca_base_component_var_register(&mca_fs_ufs_component.fsm_version,
+                                           "mock_stripe_offset", "Index of the OST holding the first stripe "
+                                           "reported for files opened by the fs ufs component if "
+                                           "mock_stripe_size is set",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_fs_ufs_mock_stripe_offset );
+
     return OMPI_SUCCESS;
 }
@@ -78,6 +78,18 @@ mca_fs_ufs_file_open (struct ompi_communicator_t *comm,
 
     fh->f_stripe_size=0;
     fh->f_stripe_count=1;
+    fh->f_stripe_offset=0;
+    if ( 0 < mca_fs_ufs_mock_stripe_size ) {
+        /* pretend the file is striped, e.g. for testing the stripe
+           aware collective I/O without a parallel file system */
+        fh->f_stripe_size = mca_fs_ufs_mock_stripe_size;
+        if ( 1 < mca_fs_ufs_mock_stripe_count ) {
+            fh->f_stripe_count = mca_fs_ufs_mock_stripe_count;
+        }
+        if ( 0 < mca_fs_ufs_mock_stripe_offset ) {
+            fh->f_stripe_offset = mca_fs_ufs_mock_stripe_offset;
+        }
+    }
 
     /* Need to check for NFS here. If the file system is not NFS but a regular UFS file system,
        we do not need to enforce locking. A regular XFS or EXT4 file system can only be used 
@@ -548,6 +548,33 @@ int mca_io_ompio_get_mca_parameter_value ( char *mca_parameter_name, int name_le
     else if ( !strncmp ( mca_parameter_name, "coll_timing_info", name_length )) {
         return mca_io_ompio_coll_timing_info;
     }
+    else if ( !strncmp ( mca_parameter_name, "data_sieving", name_length )) {
+        return mca_io_ompio_data_sieving;
+    }
+    else if ( !strncmp ( mca_parameter_name, "sieve_buffer_size", name_length )) {
+        return mca_io_ompio_sieve_buffer_size;
+    }
+    else if ( !strncmp ( mca_parameter_name, "sieve_max_hole_ratio", name_length )) {
+        return mca_io_ompio_sieve_max_hole_ratio;
+    }
+    else if ( !strncmp ( mca_parameter_name, "cache", name_length )) {
+        return mca_io_ompio_cache;
+    }
+    else if ( !strncmp ( mca_parameter_name, "cache_block_size", name_length )) {
+        return mca_io_ompio_cache_block_size;
+    }
+    else if ( !strncmp ( mca_parameter_name, "cache_num_blocks", name_length )) {
+        return mca_io_ompio_cache_num_blocks;
+    }
+    else if ( !strncmp ( mca_parameter_name, "cache_flush_threshold", name_length )) {
+        return mca_io_ompio_cache_flush_threshold;
+    }
+    else if ( !strncmp ( mca_parameter_name, "compress_chunk_size", name_length )) {
+        return mca_io_ompio_compress_chunk_size;
+    }
+    else if ( !strncmp ( mca_parameter_name, "stats", name_length )) {
+        return mca_io_ompio_stats;
+    }
     else {
         opal_output (1, "Error in mca_io_ompio_get_mca_parameter_value: unknown parameter name");
     }
@@ -53,6 +53,15 @@ extern int mca_io_ompio_max_aggregators_ratio;
 extern int mca_io_ompio_aggregators_cutoff_threshold;
 extern int mca_io_ompio_overwrite_amode;
 extern int mca_io_ompio_verbose_info_parsing;
+extern int mca_io_ompio_data_sieving;
+extern int mca_io_ompio_sieve_buffer_size;
+extern int mca_io_ompio_sieve_max_hole_ratio;
+extern int mca_io_ompio_cache;
+extern int mca_io_ompio_cache_block_size;
+extern int mca_io_ompio_cache_num_blocks;
+extern int mca_io_ompio_cache_flush_threshold;
+extern int mca_io_ompio_compress_chunk_size;
+extern int mca_io_ompio_stats;
 
 OMPI_DECLSPEC extern int mca_io_ompio_coll_timing_info;
 
@@ -63,6 +72,12 @@ OMPI_DECLSPEC extern int mca_io_ompio_coll_timing_info;
  */
 #define OMPIO_PREALLOC_MAX_BUF_SIZE   33554432
 #define OMPIO_DEFAULT_CYCLE_BUF_SIZE  536870912
+#define OMPIO_DEFAULT_SIEVE_BUF_SIZE  4194304
+#define OMPIO_DEFAULT_SIEVE_HOLE_RATIO 50
+#define OMPIO_DEFAULT_CACHE_BLOCK_SIZE 1048576
+#define OMPIO_DEFAULT_CACHE_NUM_BLOCKS 8
+#define OMPIO_DEFAULT_CACHE_FLUSH_THRESHOLD 4194304
+#define OMPIO_DEFAULT_COMPRESS_CHUNK_SIZE 1048576
 #define OMPIO_TAG_GATHER              -100
 #define OMPIO_TAG_GATHERV             -101
 #define OMPIO_TAG_BCAST               -102
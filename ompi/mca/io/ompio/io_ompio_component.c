@@ -50,6 +50,15 @@ int mca_io_ompio_max_aggregators_ratio=8;
 int mca_io_ompio_aggregators_cutoff_threshold=3;
 int mca_io_ompio_overwrite_amode = 1;
 int mca_io_ompio_verbose_info_parsing = 0;
+int mca_io_ompio_data_sieving = 0;
+int mca_io_ompio_sieve_buffer_size = OMPIO_DEFAULT_SIEVE_BUF_SIZE;
+int mca_io_ompio_sieve_max_hole_ratio = OMPIO_DEFAULT_SIEVE_HOLE_RATIO;
+int mca_io_ompio_cache = 0;
+int mca_io_ompio_cache_block_size = OMPIO_DEFAULT_CACHE_BLOCK_SIZE;
+int mca_io_ompio_cache_num_blocks = OMPIO_DEFAULT_CACHE_NUM_BLOCKS;
+int mca_io_ompio_cache_flush_threshold = OMPIO_DEFAULT_CACHE_FLUSH_THRESHOLD;
+int mca_io_ompio_compress_chunk_size = OMPIO_DEFAULT_COMPRESS_CHUNK_SIZE;
+int mca_io_ompio_stats = OMPIO_STATS_COLLECT;
 
 int mca_io_ompio_grouping_option=5;
 
@@ -260,6 +269,103 @@ static int register_component(void)
                                            MCA_BASE_VAR_SCOPE_READONLY,
                                            &mca_io_ompio_verbose_info_parsing);
 
+    mca_io_ompio_data_sieving = 0;
+    (void) mca_base_component_var_register(&mca_io_ompio_component.io_version,
+                                           "data_sieving",
+                                           "Use data sieving for noncontiguous individual operations "
+                                           "0: disabled (default) 1: reads 2: writes 3: reads and writes. "
+                                           "Sieved writes lock the accessed range, all processes writing "
+                                           "to overlapping regions of a file have to enable it",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_io_ompio_data_sieving);
+
+    mca_io_ompio_sieve_buffer_size = OMPIO_DEFAULT_SIEVE_BUF_SIZE;
+    (void) mca_base_component_var_register(&mca_io_ompio_component.io_version,
+                                           "sieve_buffer_size",
+                                           "Size of the temporary buffer used for data sieving, i.e. "
+                                           "maximum extent of the file accessed by a single sieved operation",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_io_ompio_sieve_buffer_size);
+
+    mca_io_ompio_sieve_max_hole_ratio = OMPIO_DEFAULT_SIEVE_HOLE_RATIO;
+    (void) mca_base_component_var_register(&mca_io_ompio_component.io_version,
+                                           "sieve_max_hole_ratio",
+                                           "Maximum percentage of the accessed extent that may consist of "
+                                           "holes between the requested pieces for data sieving to be used",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_io_ompio_sieve_max_hole_ratio);
+
+    mca_io_ompio_cache = 0;
+    (void) mca_base_component_var_register(&mca_io_ompio_component.io_version,
+                                           "cache",
+                                           "Cache small individual operations on the client side "
+                                           "0: disabled (default) 1: read-ahead for sequential reads "
+                                           "2: write-behind 3: read-ahead and write-behind. "
+                                           "Not used while atomic mode is enabled",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_io_ompio_cache);
+
+    mca_io_ompio_cache_block_size = OMPIO_DEFAULT_CACHE_BLOCK_SIZE;
+    (void) mca_base_component_var_register(&mca_io_ompio_component.io_version,
+                                           "cache_block_size",
+                                           "Size of a cache block. Pieces of this size or larger "
+                                           "bypass the cache",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_io_ompio_cache_block_size);
+
+    mca_io_ompio_cache_num_blocks = OMPIO_DEFAULT_CACHE_NUM_BLOCKS;
+    (void) mca_base_component_var_register(&mca_io_ompio_component.io_version,
+                                           "cache_num_blocks",
+                                           "Number of cache blocks per file",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_io_ompio_cache_num_blocks);
+
+    mca_io_ompio_cache_flush_threshold = OMPIO_DEFAULT_CACHE_FLUSH_THRESHOLD;
+    (void) mca_base_component_var_register(&mca_io_ompio_component.io_version,
+                                           "cache_flush_threshold",
+                                           "Amount of modified data in the cache of a file which "
+                                           "triggers writing back all modified blocks",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_io_ompio_cache_flush_threshold);
+
+    mca_io_ompio_compress_chunk_size = OMPIO_DEFAULT_COMPRESS_CHUNK_SIZE;
+    (void) mca_base_component_var_register(&mca_io_ompio_component.io_version,
+                                           "compress_chunk_size",
+                                           "Size of the independently compressed chunks of a file "
+                                           "created with the ompio_compression hint, if the stripe "
+                                           "size of the file system is not known",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_io_ompio_compress_chunk_size);
+
+    mca_io_ompio_stats = OMPIO_STATS_COLLECT;
+    (void) mca_base_component_var_register(&mca_io_ompio_component.io_version,
+                                           "stats",
+                                           "I/O statistics of the files: 0 - disabled, 1 - collected "
+                                           "and exported as performance variables, 2 - in addition a "
+                                           "summary of every file is printed at close",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_io_ompio_stats);
+
+    (void) mca_common_ompio_stats_register_pvars (&mca_io_ompio_component.io_version);
+
     return OMPI_SUCCESS;
 }
 
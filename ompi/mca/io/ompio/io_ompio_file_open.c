@@ -115,6 +115,11 @@ int mca_io_ompio_file_preallocate (ompi_file_t *fh,
     data = (mca_common_ompio_data_t *) fh->f_io_selected_data;
 
     OPAL_THREAD_LOCK(&fh->f_lock);
+    if ( NULL != data->ompio_fh.f_compress ) {
+        /* the space needed by a compressed file is not known upfront */
+        OPAL_THREAD_UNLOCK(&fh->f_lock);
+        return OMPI_SUCCESS;
+    }
     tmp = diskspace;
 
     ret = data->ompio_fh.f_comm->c_coll->coll_bcast (&tmp,
@@ -132,6 +137,11 @@ int mca_io_ompio_file_preallocate (ompi_file_t *fh,
         OPAL_THREAD_UNLOCK(&fh->f_lock);
         return OMPI_ERROR;
     }
+    ret = mca_common_ompio_cache_flush (&data->ompio_fh, true);
+    if ( OMPI_SUCCESS != ret ) {
+        OPAL_THREAD_UNLOCK(&fh->f_lock);
+        return ret;
+    }
     ret = data->ompio_fh.f_fs->fs_file_get_size (&data->ompio_fh,
                                                  &current_size);
     if ( OMPI_SUCCESS != ret ) {
@@ -215,6 +225,7 @@ exit:
                                    fh->f_comm->c_coll->coll_bcast_module);
     
     if ( diskspace > current_size ) {
+        mca_common_ompio_cache_flush (&data->ompio_fh, true);
         data->ompio_fh.f_fs->fs_file_set_size (&data->ompio_fh, diskspace);
     }
     OPAL_THREAD_UNLOCK(&fh->f_lock);
@@ -225,7 +236,7 @@ exit:
 int mca_io_ompio_file_set_size (ompi_file_t *fh,
                                 OMPI_MPI_OFFSET_TYPE size)
 {
-    int ret = OMPI_SUCCESS;
+    int ret = OMPI_SUCCESS, flush_ret;
     OMPI_MPI_OFFSET_TYPE tmp;
     mca_common_ompio_data_t *data;
 
@@ -251,7 +262,14 @@ int mca_io_ompio_file_set_size (ompi_file_t *fh,
         return OMPI_ERROR;
     }
 
-    ret = data->ompio_fh.f_fs->fs_file_set_size (&data->ompio_fh, size);
+    /* cached data beyond the new size must not extend the file later on */
+    flush_ret = mca_common_ompio_cache_flush (&data->ompio_fh, true);
+    if ( NULL != data->ompio_fh.f_compress ) {
+        ret = mca_common_ompio_compress_set_size (&data->ompio_fh, size);
+    }
+    else {
+        ret = data->ompio_fh.f_fs->fs_file_set_size (&data->ompio_fh, size);
+    }
     if ( OMPI_SUCCESS != ret ) {
         opal_output(1, ",mca_io_ompio_file_set_size: error in fs->set_size\n");
         OPAL_THREAD_UNLOCK(&fh->f_lock);
@@ -267,6 +285,9 @@ int mca_io_ompio_file_set_size (ompi_file_t *fh,
     }
     OPAL_THREAD_UNLOCK(&fh->f_lock);
 
+    if ( OMPI_SUCCESS != flush_ret ) {
+        return flush_ret;
+    }
     return ret;
 }
 
@@ -335,6 +356,14 @@ int mca_io_ompio_file_set_atomicity (ompi_file_t *fh,
         return OMPI_ERROR;
     }
 
+    /* the cache is not used in atomic mode */
+    if ( flag ) {
+        int ret = mca_common_ompio_cache_flush (&data->ompio_fh, true);
+        if ( OMPI_SUCCESS != ret ) {
+            OPAL_THREAD_UNLOCK(&fh->f_lock);
+            return ret;
+        }
+    }
     data->ompio_fh.f_atomicity = flag;
     OPAL_THREAD_UNLOCK(&fh->f_lock);
 
@@ -357,7 +386,7 @@ int mca_io_ompio_file_get_atomicity (ompi_file_t *fh,
 
 int mca_io_ompio_file_sync (ompi_file_t *fh)
 {
-    int ret = OMPI_SUCCESS;
+    int ret = OMPI_SUCCESS, flush_ret;
     mca_common_ompio_data_t *data;
 
     data = (mca_common_ompio_data_t *) fh->f_io_selected_data;
@@ -372,6 +401,10 @@ int mca_io_ompio_file_sync (ompi_file_t *fh)
         OPAL_THREAD_UNLOCK(&fh->f_lock);
         return MPI_ERR_ACCESS;
     }        
+    /* write back cached data, and make data written by other
+       processes visible after the sync */
+    flush_ret = mca_common_ompio_cache_flush (&data->ompio_fh, true);
+
     // Make sure all processes reach this point before syncing the file.
     ret = data->ompio_fh.f_comm->c_coll->coll_barrier (data->ompio_fh.f_comm,
                                                        data->ompio_fh.f_comm->c_coll->coll_barrier_module);
@@ -382,6 +415,10 @@ int mca_io_ompio_file_sync (ompi_file_t *fh)
     ret = data->ompio_fh.f_fs->fs_file_sync (&data->ompio_fh);
     OPAL_THREAD_UNLOCK(&fh->f_lock);
 
+    if ( OMPI_SUCCESS != flush_ret ) {
+        return flush_ret;
+    }
+
     return ret;
 }
 
@@ -455,8 +492,8 @@ int mca_io_ompio_file_seek (ompi_file_t *fh,
         }
         break;
     case MPI_SEEK_END:
-        ret = data->ompio_fh.f_fs->fs_file_get_size (&data->ompio_fh,
-                                                     &temp_offset2);
+        ret = mca_common_ompio_file_get_size (&data->ompio_fh,
+                                              &temp_offset2);
         mca_io_ompio_file_get_eof_offset (&data->ompio_fh,
                                           temp_offset2, &temp_offset);
         offset += temp_offset;
@@ -2,6 +2,9 @@
  * Copyright (c) 2016-2017 Inria.  All rights reserved.
  * Copyright (c) 2019      Research Organization for Information Science
  *                         and Technology (RIST).  All rights reserved.
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
  * $COPYRIGHT$
  *
  * Additional copyrights may follow
@@ -17,6 +20,9 @@ BEGIN_C_DECLS
 #include "ompi_config.h"
 #include "ompi/mca/osc/osc.h"
 #include "ompi/mca/common/monitoring/common_monitoring.h"
+#include "ompi/mca/common/monitoring/common_monitoring_trace.h"
+#include "ompi/datatype/ompi_datatype.h"
+#include "ompi/win/win.h"
 
 struct ompi_osc_monitoring_component_t {
     ompi_osc_base_component_t super;
@@ -26,6 +32,55 @@ typedef struct ompi_osc_monitoring_component_t ompi_osc_monitoring_component_t;
 
 OMPI_DECLSPEC extern ompi_osc_monitoring_component_t mca_osc_monitoring_component;
 
+/* Records a one-sided operation in the trace. The target, if any, is
+ * translated in its MPI_COMM_WORLD rank, and the window identified by
+ * its Fortran index. */
+static inline void ompi_osc_monitoring_trace(mca_monitoring_op_t op, int target,
+                                             ompi_datatype_t *datatype, int count,
+                                             ompi_win_t *win, opal_timer_t start,
+                                             ompi_request_t *request)
+{
+    int world_rank = -1;
+    size_t type_size = 0;
+
+    if( target >= 0 &&
+        OPAL_SUCCESS != mca_common_monitoring_get_world_rank(target, win->w_group, &world_rank) ) {
+        world_rank = -1;
+    }
+    if( NULL != datatype ) {
+        ompi_datatype_type_size(datatype, &type_size);
+    }
+    if( NULL == request ) {
+        mca_common_monitoring_time_stop(op, world_rank, 0, (uint32_t) win->w_f_to_c_index,
+                                        count * type_size, start);
+    } else {
+        mca_common_monitoring_time_track(op, world_rank, 0, (uint32_t) win->w_f_to_c_index,
+                                         count * type_size, start, request);
+    }
+}
+
+/* Calls the original blocking function of the module and returns its result */
+#define OSC_MONITORING_CALL(OP, TARGET, DATATYPE, COUNT, WIN, CALL)    \
+    do {                                                                \
+        opal_timer_t _start = mca_common_monitoring_time_start(OP);     \
+        int _ret = (CALL);                                              \
+        if( OPAL_UNLIKELY(0 != _start) && OMPI_SUCCESS == _ret ) {      \
+            ompi_osc_monitoring_trace((OP), (TARGET), (DATATYPE), (COUNT), (WIN), _start, NULL); \
+        }                                                               \
+        return _ret;                                                    \
+    } while (0)
+
+/* Calls the original request based function of the module and returns its result */
+#define OSC_MONITORING_RCALL(OP, TARGET, DATATYPE, COUNT, WIN, REQUEST, CALL) \
+    do {                                                                \
+        opal_timer_t _start = mca_common_monitoring_time_start(OP);     \
+        int _ret = (CALL);                                              \
+        if( OPAL_UNLIKELY(0 != _start) && OMPI_SUCCESS == _ret ) {      \
+            ompi_osc_monitoring_trace((OP), (TARGET), (DATATYPE), (COUNT), (WIN), _start, *(REQUEST)); \
+        }                                                               \
+        return _ret;                                                    \
+    } while (0)
+
 END_C_DECLS
 
 #endif  /* MCA_OSC_MONITORING_H */
@@ -2,6 +2,9 @@
  * Copyright (c) 2016-2018 Inria.  All rights reserved.
  * Copyright (c) 2019      Research Organization for Information Science
  *                         and Technology (RIST).  All rights reserved.
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
  * $COPYRIGHT$
  *
  * Additional copyrights may follow
@@ -38,7 +41,8 @@
             mca_common_monitoring_record_osc(world_rank, type_size, RECV); \
             OPAL_MONITORING_PRINT_INFO("MPI_Compare_and_swap to %d intercepted", world_rank); \
         }                                                               \
-        return OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_compare_and_swap(origin_addr, compare_addr, result_addr, dt, target_rank, target_disp, win); \
+        OSC_MONITORING_CALL(MCA_MONITORING_OP_OSC_COMPARE_AND_SWAP, target_rank, dt, 1, win, \
+                            OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_compare_and_swap(origin_addr, compare_addr, result_addr, dt, target_rank, target_disp, win)); \
     }                                                                   \
                                                                         \
     static int ompi_osc_monitoring_## template ##_get_accumulate (const void *origin_addr, \
@@ -68,7 +72,8 @@
             mca_common_monitoring_record_osc(world_rank, data_size, RECV); \
             OPAL_MONITORING_PRINT_INFO("MPI_Get_accumulate to %d intercepted", world_rank); \
         }                                                               \
-        return OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_get_accumulate(origin_addr, origin_count, origin_datatype, result_addr, result_count, result_datatype, target_rank, target_disp, target_count, target_datatype, op, win); \
+        OSC_MONITORING_CALL(MCA_MONITORING_OP_OSC_GET_ACCUMULATE, target_rank, origin_datatype, origin_count, win, \
+                            OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_get_accumulate(origin_addr, origin_count, origin_datatype, result_addr, result_count, result_datatype, target_rank, target_disp, target_count, target_datatype, op, win)); \
     }                                                                   \
                                                                         \
     static int ompi_osc_monitoring_## template ##_rget_accumulate (const void *origin_addr, \
@@ -100,7 +105,8 @@
             mca_common_monitoring_record_osc(world_rank, data_size, RECV); \
             OPAL_MONITORING_PRINT_INFO("MPI_Rget_accumulate to %d intercepted", world_rank); \
         }                                                               \
-        return OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_rget_accumulate(origin_addr, origin_count, origin_datatype, result_addr, result_count, result_datatype, target_rank, target_disp, target_count, target_datatype, op, win, request); \
+        OSC_MONITORING_RCALL(MCA_MONITORING_OP_OSC_RGET_ACCUMULATE, target_rank, origin_datatype, origin_count, win, request, \
+                             OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_rget_accumulate(origin_addr, origin_count, origin_datatype, result_addr, result_count, result_datatype, target_rank, target_disp, target_count, target_datatype, op, win, request)); \
     }                                                                   \
                                                                         \
     static int ompi_osc_monitoring_## template ##_raccumulate (const void *origin_addr, \
@@ -125,7 +131,8 @@
             mca_common_monitoring_record_osc(world_rank, data_size, SEND); \
             OPAL_MONITORING_PRINT_INFO("MPI_Raccumulate to %d intercepted", world_rank); \
         }                                                               \
-        return OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_raccumulate(origin_addr, origin_count, origin_datatype, target_rank, target_disp, target_count, target_datatype, op, win, request); \
+        OSC_MONITORING_RCALL(MCA_MONITORING_OP_OSC_RACCUMULATE, target_rank, origin_datatype, origin_count, win, request, \
+                             OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_raccumulate(origin_addr, origin_count, origin_datatype, target_rank, target_disp, target_count, target_datatype, op, win, request)); \
     }                                                                   \
                                                                         \
     static int ompi_osc_monitoring_## template ##_accumulate (const void *origin_addr, \
@@ -149,7 +156,8 @@
             mca_common_monitoring_record_osc(world_rank, data_size, SEND); \
             OPAL_MONITORING_PRINT_INFO("MPI_Accumulate to %d intercepted", world_rank); \
         }                                                               \
-        return OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_accumulate(origin_addr, origin_count, origin_datatype, target_rank, target_disp, target_count, target_datatype, op, win); \
+        OSC_MONITORING_CALL(MCA_MONITORING_OP_OSC_ACCUMULATE, target_rank, origin_datatype, origin_count, win, \
+                            OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_accumulate(origin_addr, origin_count, origin_datatype, target_rank, target_disp, target_count, target_datatype, op, win)); \
     }                                                                   \
                                                                         \
     static int ompi_osc_monitoring_## template ##_fetch_and_op (const void *origin_addr, \
@@ -171,7 +179,8 @@
             mca_common_monitoring_record_osc(world_rank, type_size, RECV); \
             OPAL_MONITORING_PRINT_INFO("MPI_Fetch_and_op to %d intercepted", world_rank); \
         }                                                               \
-        return OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_fetch_and_op(origin_addr, result_addr, dt, target_rank, target_disp, op, win); \
+        OSC_MONITORING_CALL(MCA_MONITORING_OP_OSC_FETCH_AND_OP, target_rank, dt, 1, win, \
+                            OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_fetch_and_op(origin_addr, result_addr, dt, target_rank, target_disp, op, win)); \
     }
 
 #endif /* MCA_OSC_MONITORING_ACCUMULATE_H */
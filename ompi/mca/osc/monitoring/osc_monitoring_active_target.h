@@ -2,6 +2,9 @@
  * Copyright (c) 2016 Inria.  All rights reserved.
  * Copyright (c) 2019      Research Organization for Information Science
  *                         and Technology (RIST).  All rights reserved.
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
  * $COPYRIGHT$
  *
  * Additional copyrights may follow
@@ -19,22 +22,26 @@
                                                                         \
     static int ompi_osc_monitoring_## template ##_post (ompi_group_t *group, int assert, ompi_win_t *win) \
     {                                                                   \
-        return OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_post(group, assert, win); \
+        OSC_MONITORING_CALL(MCA_MONITORING_OP_OSC_POST, -1, NULL, 0, win, \
+                            OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_post(group, assert, win)); \
     }                                                                   \
                                                                         \
     static int ompi_osc_monitoring_## template ##_start (ompi_group_t *group, int assert, ompi_win_t *win) \
     {                                                                   \
-        return OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_start(group, assert, win); \
+        OSC_MONITORING_CALL(MCA_MONITORING_OP_OSC_START, -1, NULL, 0, win, \
+                            OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_start(group, assert, win)); \
     }                                                                   \
                                                                         \
     static int ompi_osc_monitoring_## template ##_complete (ompi_win_t *win) \
     {                                                                   \
-        return OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_complete(win); \
+        OSC_MONITORING_CALL(MCA_MONITORING_OP_OSC_COMPLETE, -1, NULL, 0, win, \
+                            OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_complete(win)); \
     }                                                                   \
                                                                         \
     static int ompi_osc_monitoring_## template ##_wait (ompi_win_t *win) \
     {                                                                   \
-        return OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_wait(win); \
+        OSC_MONITORING_CALL(MCA_MONITORING_OP_OSC_WAIT, -1, NULL, 0, win, \
+                            OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_wait(win)); \
     }                                                                   \
                                                                         \
     static int ompi_osc_monitoring_## template ##_test (ompi_win_t *win, int *flag) \
@@ -44,7 +51,8 @@
                                                                         \
     static int ompi_osc_monitoring_## template ##_fence (int assert, ompi_win_t *win) \
     {                                                                   \
-        return OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_fence(assert, win); \
+        OSC_MONITORING_CALL(MCA_MONITORING_OP_OSC_FENCE, -1, NULL, 0, win, \
+                            OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_fence(assert, win)); \
     }
 
 #endif /* MCA_OSC_MONITORING_ACTIVE_TARGET_H */
@@ -2,6 +2,9 @@
  * Copyright (c) 2016-2018 Inria.  All rights reserved.
  * Copyright (c) 2019      Research Organization for Information Science
  *                         and Technology (RIST).  All rights reserved.
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
  * $COPYRIGHT$
  *
  * Additional copyrights may follow
@@ -39,7 +42,8 @@
             mca_common_monitoring_record_osc(world_rank, data_size, SEND); \
             OPAL_MONITORING_PRINT_INFO("MPI_Put to %d intercepted", world_rank); \
         }                                                               \
-        return OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_put(origin_addr, origin_count, origin_datatype, target_rank, target_disp, target_count, target_datatype, win); \
+        OSC_MONITORING_CALL(MCA_MONITORING_OP_OSC_PUT, target_rank, origin_datatype, origin_count, win, \
+                            OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_put(origin_addr, origin_count, origin_datatype, target_rank, target_disp, target_count, target_datatype, win)); \
     }                                                                   \
                                                                         \
     static int ompi_osc_monitoring_## template ##_rput (const void *origin_addr, \
@@ -64,7 +68,8 @@
             mca_common_monitoring_record_osc(world_rank, data_size, SEND); \
             OPAL_MONITORING_PRINT_INFO("MPI_Rput to %d intercepted", world_rank); \
         }                                                               \
-        return OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_rput(origin_addr, origin_count, origin_datatype, target_rank, target_disp, target_count, target_datatype, win, request); \
+        OSC_MONITORING_RCALL(MCA_MONITORING_OP_OSC_RPUT, target_rank, origin_datatype, origin_count, win, request, \
+                             OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_rput(origin_addr, origin_count, origin_datatype, target_rank, target_disp, target_count, target_datatype, win, request)); \
     }                                                                   \
                                                                         \
     static int ompi_osc_monitoring_## template ##_get (void *origin_addr, int origin_count, \
@@ -88,7 +93,8 @@
             mca_common_monitoring_record_osc(world_rank, data_size, RECV); \
             OPAL_MONITORING_PRINT_INFO("MPI_Get to %d intercepted", world_rank); \
         }                                                               \
-        return OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_get(origin_addr, origin_count, origin_datatype, source_rank, source_disp, source_count, source_datatype, win); \
+        OSC_MONITORING_CALL(MCA_MONITORING_OP_OSC_GET, source_rank, origin_datatype, origin_count, win, \
+                            OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_get(origin_addr, origin_count, origin_datatype, source_rank, source_disp, source_count, source_datatype, win)); \
     }                                                                   \
                                                                         \
     static int ompi_osc_monitoring_## template ##_rget (void *origin_addr, int origin_count, \
@@ -113,7 +119,8 @@
             mca_common_monitoring_record_osc(world_rank, data_size, RECV); \
             OPAL_MONITORING_PRINT_INFO("MPI_Rget to %d intercepted", world_rank); \
         }                                                               \
-        return OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_rget(origin_addr, origin_count, origin_datatype, source_rank, source_disp, source_count, source_datatype, win, request); \
+        OSC_MONITORING_RCALL(MCA_MONITORING_OP_OSC_RGET, source_rank, origin_datatype, origin_count, win, request, \
+                             OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_rget(origin_addr, origin_count, origin_datatype, source_rank, source_disp, source_count, source_datatype, win, request)); \
     }
 
 #endif /* MCA_OSC_MONITORING_COMM_H */
@@ -2,6 +2,9 @@
  * Copyright (c) 2016 Inria.  All rights reserved.
  * Copyright (c) 2019      Research Organization for Information Science
  *                         and Technology (RIST).  All rights reserved.
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
  * $COPYRIGHT$
  *
  * Additional copyrights may follow
@@ -18,47 +21,56 @@
                                                                         \
     static int ompi_osc_monitoring_## template ##_sync (struct ompi_win_t *win) \
     {                                                                   \
-        return OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_sync(win); \
+        OSC_MONITORING_CALL(MCA_MONITORING_OP_OSC_SYNC, -1, NULL, 0, win, \
+                            OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_sync(win)); \
     }                                                                   \
                                                                         \
     static int ompi_osc_monitoring_## template ##_flush (int target, struct ompi_win_t *win) \
     {                                                                   \
-        return OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_flush(target, win); \
+        OSC_MONITORING_CALL(MCA_MONITORING_OP_OSC_FLUSH, target, NULL, 0, win, \
+                            OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_flush(target, win)); \
     }                                                                   \
                                                                         \
     static int ompi_osc_monitoring_## template ##_flush_all (struct ompi_win_t *win) \
     {                                                                   \
-        return OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_flush_all(win); \
+        OSC_MONITORING_CALL(MCA_MONITORING_OP_OSC_FLUSH_ALL, -1, NULL, 0, win, \
+                            OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_flush_all(win)); \
     }                                                                   \
                                                                         \
     static int ompi_osc_monitoring_## template ##_flush_local (int target, struct ompi_win_t *win) \
     {                                                                   \
-        return OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_flush_local(target, win); \
+        OSC_MONITORING_CALL(MCA_MONITORING_OP_OSC_FLUSH_LOCAL, target, NULL, 0, win, \
+                            OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_flush_local(target, win)); \
     }                                                                   \
                                                                         \
     static int ompi_osc_monitoring_## template ##_flush_local_all (struct ompi_win_t *win) \
     {                                                                   \
-        return OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_flush_local_all(win); \
+        OSC_MONITORING_CALL(MCA_MONITORING_OP_OSC_FLUSH_LOCAL_ALL, -1, NULL, 0, win, \
+                            OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_flush_local_all(win)); \
     }                                                                   \
                                                                         \
     static int ompi_osc_monitoring_## template ##_lock (int lock_type, int target, int assert, ompi_win_t *win) \
     {                                                                   \
-        return OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_lock(lock_type, target, assert, win); \
+        OSC_MONITORING_CALL(MCA_MONITORING_OP_OSC_LOCK, target, NULL, 0, win, \
+                            OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_lock(lock_type, target, assert, win)); \
     }                                                                   \
                                                                         \
     static int ompi_osc_monitoring_## template ##_unlock (int target, ompi_win_t *win) \
     {                                                                   \
-        return OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_unlock(target, win); \
+        OSC_MONITORING_CALL(MCA_MONITORING_OP_OSC_UNLOCK, target, NULL, 0, win, \
+                            OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_unlock(target, win)); \
     }                                                                   \
                                                                         \
     static int ompi_osc_monitoring_## template ##_lock_all (int assert, struct ompi_win_t *win) \
     {                                                                   \
-        return OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_lock_all(assert, win); \
+        OSC_MONITORING_CALL(MCA_MONITORING_OP_OSC_LOCK_ALL, -1, NULL, 0, win, \
+                            OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_lock_all(assert, win)); \
     }                                                                   \
                                                                         \
     static int ompi_osc_monitoring_## template ##_unlock_all (struct ompi_win_t *win) \
     {                                                                   \
-        return OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_unlock_all(win); \
+        OSC_MONITORING_CALL(MCA_MONITORING_OP_OSC_UNLOCK_ALL, -1, NULL, 0, win, \
+                            OMPI_OSC_MONITORING_MODULE_VARIABLE(template).osc_unlock_all(win)); \
     }
 
 #endif /* MCA_OSC_MONITORING_PASSIVE_TARGET_H */
@@ -2,6 +2,9 @@
  * Copyright (c) 2013-2015 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
  * Copyright (c) 2013-2017 Inria.  All rights reserved.
  * Copyright (c) 2019      Research Organization for Information Science
  *                         and Technology (RIST).  All rights reserved.
@@ -17,6 +20,20 @@
 
 
 /* EJ: loging is done on the sender. Nothing to do here */
+/* Except for the trace, which also shows the time spent in the receives */
+
+/* World rank of the source of a receive, -1 for MPI_ANY_SOURCE or for a
+ * process out of my MPI_COMM_WORLD */
+static int mca_pml_monitoring_recv_source(int src, struct ompi_communicator_t* comm)
+{
+    int world_rank;
+
+    if( src < 0 ||
+        OPAL_SUCCESS != mca_common_monitoring_get_world_rank(src, comm->c_remote_group, &world_rank) ) {
+        return -1;
+    }
+    return world_rank;
+}
 
 int mca_pml_monitoring_irecv_init(void *buf,
                                   size_t count,
@@ -39,8 +56,20 @@ int mca_pml_monitoring_irecv(void *buf,
                              struct ompi_communicator_t* comm,
                              struct ompi_request_t **request)
 {
-    return pml_selected_module.pml_irecv(buf, count, datatype,
-                                         src, tag, comm, request);
+    opal_timer_t start = mca_common_monitoring_time_start(MCA_MONITORING_OP_PML_IRECV);
+    size_t type_size;
+    int ret;
+
+    ret = pml_selected_module.pml_irecv(buf, count, datatype,
+                                        src, tag, comm, request);
+    if( OPAL_UNLIKELY(0 != start) && OMPI_SUCCESS == ret ) {
+        ompi_datatype_type_size(datatype, &type_size);
+        mca_common_monitoring_time_track(MCA_MONITORING_OP_PML_IRECV,
+                                         mca_pml_monitoring_recv_source(src, comm), tag,
+                                         ompi_comm_get_cid(comm), count * type_size, start,
+                                         *request);
+    }
+    return ret;
 }
 
 
@@ -52,8 +81,19 @@ int mca_pml_monitoring_recv(void *buf,
                             struct ompi_communicator_t* comm,
                             ompi_status_public_t* status)
 {
-    return pml_selected_module.pml_recv(buf, count, datatype,
-                                        src, tag, comm, status);
+    opal_timer_t start = mca_common_monitoring_time_start(MCA_MONITORING_OP_PML_RECV);
+    size_t type_size;
+    int ret;
+
+    ret = pml_selected_module.pml_recv(buf, count, datatype,
+                                       src, tag, comm, status);
+    if( OPAL_UNLIKELY(0 != start) && OMPI_SUCCESS == ret ) {
+        ompi_datatype_type_size(datatype, &type_size);
+        mca_common_monitoring_time_stop(MCA_MONITORING_OP_PML_RECV,
+                                        mca_pml_monitoring_recv_source(src, comm), tag,
+                                        ompi_comm_get_cid(comm), count * type_size, start);
+    }
+    return ret;
 }
 
 
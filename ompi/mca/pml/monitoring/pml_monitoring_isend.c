@@ -5,6 +5,9 @@
  * Copyright (c) 2013-2018 Inria.  All rights reserved.
  * Copyright (c) 2019      Research Organization for Information Science
  *                         and Technology (RIST).  All rights reserved.
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
  * $COPYRIGHT$
  *
  * Additional copyrights may follow
@@ -37,20 +40,30 @@ int mca_pml_monitoring_isend(const void *buf,
                              struct ompi_communicator_t* comm,
                              struct ompi_request_t **request)
 {
-    int world_rank;
+    int world_rank = -1, ret;
+    size_t type_size, data_size;
+    opal_timer_t start;
+
+    ompi_datatype_type_size(datatype, &type_size);
+    data_size = count*type_size;
     /**
      * If this fails the destination is not part of my MPI_COM_WORLD
      * Lookup its name in the rank hastable to get its MPI_COMM_WORLD rank
      */
     if(OPAL_SUCCESS == mca_common_monitoring_get_world_rank(dst, comm->c_remote_group, &world_rank)) {
-        size_t type_size, data_size;
-        ompi_datatype_type_size(datatype, &type_size);
-        data_size = count*type_size;
         mca_common_monitoring_record_pml(world_rank, data_size, tag);
+    } else {
+        world_rank = -1;
     }
 
-    return pml_selected_module.pml_isend(buf, count, datatype,
-                                         dst, tag, mode, comm, request);
+    start = mca_common_monitoring_time_start(MCA_MONITORING_OP_PML_ISEND);
+    ret = pml_selected_module.pml_isend(buf, count, datatype,
+                                        dst, tag, mode, comm, request);
+    if( OPAL_UNLIKELY(0 != start) && OMPI_SUCCESS == ret ) {
+        mca_common_monitoring_time_track(MCA_MONITORING_OP_PML_ISEND, world_rank, tag,
+                                         ompi_comm_get_cid(comm), data_size, start, *request);
+    }
+    return ret;
 }
 
 int mca_pml_monitoring_send(const void *buf,
@@ -61,15 +74,25 @@ int mca_pml_monitoring_send(const void *buf,
                             mca_pml_base_send_mode_t mode,
                             struct ompi_communicator_t* comm)
 {
-    int world_rank;
+    int world_rank = -1, ret;
+    size_t type_size, data_size;
+    opal_timer_t start;
+
+    ompi_datatype_type_size(datatype, &type_size);
+    data_size = count*type_size;
     /* Are we sending to a peer from my own MPI_COMM_WORLD? */
     if(OPAL_SUCCESS == mca_common_monitoring_get_world_rank(dst, comm->c_remote_group, &world_rank)) {
-        size_t type_size, data_size;
-        ompi_datatype_type_size(datatype, &type_size);
-        data_size = count*type_size;
         mca_common_monitoring_record_pml(world_rank, data_size, tag);
+    } else {
+        world_rank = -1;
     }
 
-    return pml_selected_module.pml_send(buf, count, datatype,
-                                        dst, tag, mode, comm);
+    start = mca_common_monitoring_time_start(MCA_MONITORING_OP_PML_SEND);
+    ret = pml_selected_module.pml_send(buf, count, datatype,
+                                       dst, tag, mode, comm);
+    if( OPAL_UNLIKELY(0 != start) && OMPI_SUCCESS == ret ) {
+        mca_common_monitoring_time_stop(MCA_MONITORING_OP_PML_SEND, world_rank, tag,
+                                        ompi_comm_get_cid(comm), data_size, start);
+    }
+    return ret;
 }
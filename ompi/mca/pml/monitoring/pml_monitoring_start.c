@@ -5,6 +5,9 @@
  * Copyright (c) 2013-2018 Inria.  All rights reserved.
  * Copyright (c) 2019      Research Organization for Information Science
  *                         and Technology (RIST).  All rights reserved.
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
  * $COPYRIGHT$
  *
  * Additional copyrights may follow
@@ -21,6 +24,8 @@ int mca_pml_monitoring_start(size_t count,
                              ompi_request_t** requests)
 {
     size_t i;
+    opal_timer_t start;
+    int ret;
 
     for( i = 0; i < count; i++ ) {
         mca_pml_base_request_t *pml_request = (mca_pml_base_request_t*)requests[i];
@@ -48,6 +53,35 @@ int mca_pml_monitoring_start(size_t count,
             mca_common_monitoring_record_pml(world_rank, data_size, 1);
         }
     }
-    return pml_selected_module.pml_start(count, requests);
+
+    start = mca_common_monitoring_time_start(MCA_MONITORING_OP_PML_START);
+    ret = pml_selected_module.pml_start(count, requests);
+    if( OPAL_LIKELY(0 == start) || OMPI_SUCCESS != ret ) {
+        return ret;
+    }
+
+    /* Track the time in flight of the send requests just started */
+    for( i = 0; i < count; i++ ) {
+        mca_pml_base_request_t *pml_request = (mca_pml_base_request_t*)requests[i];
+        size_t type_size;
+        int world_rank;
+
+        if(NULL == pml_request || OMPI_REQUEST_PML != requests[i]->req_type ||
+           MCA_PML_REQUEST_SEND != pml_request->req_type) {
+            continue;
+        }
+        if(OPAL_SUCCESS != mca_common_monitoring_get_world_rank(pml_request->req_peer,
+                                                                pml_request->req_comm->c_remote_group,
+                                                                &world_rank)) {
+            world_rank = -1;
+        }
+        ompi_datatype_type_size(pml_request->req_datatype, &type_size);
+        mca_common_monitoring_time_track(MCA_MONITORING_OP_PML_START, world_rank,
+                                         pml_request->req_tag,
+                                         ompi_comm_get_cid(pml_request->req_comm),
+                                         pml_request->req_count * type_size, start,
+                                         requests[i]);
+    }
+    return ret;
 }
 
@@ -3,7 +3,7 @@
  * Copyright (c) 2004-2005 The Trustees of Indiana University and Indiana
  *                         University Research and Technology
  *                         Corporation.  All rights reserved.
- * Copyright (c) 2004-2018 The University of Tennessee and The University
+ * Copyright (c) 2004-2026 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  * Copyright (c) 2004-2005 High Performance Computing Center Stuttgart,
@@ -41,6 +41,7 @@
 #include "ompi/mca/bml/base/base.h"
 #include "ompi/proc/proc.h"
 #include "opal/mca/allocator/base/base.h"
+#include "opal/mca/base/mca_base_event.h"
 
 BEGIN_C_DECLS
 
@@ -89,6 +90,40 @@ typedef struct mca_pml_ob1_t mca_pml_ob1_t;
 extern mca_pml_ob1_t mca_pml_ob1;
 extern int mca_pml_ob1_output;
 extern bool mca_pml_ob1_matching_protection;
+
+/**
+ * MPI_T events, bound to the communicator of the message. They all carry
+ * a mca_pml_ob1_event_data_t with the peer rank in the communicator, the
+ * tag and the number of bytes of the message.
+ */
+enum {
+    MCA_PML_OB1_EVENT_SEND_POSTED,
+    MCA_PML_OB1_EVENT_MESSAGE_MATCHED,
+    MCA_PML_OB1_EVENT_MESSAGE_UNEXPECTED,
+    MCA_PML_OB1_EVENT_SEND_COMPLETE,
+    MCA_PML_OB1_EVENT_RECV_COMPLETE,
+    MCA_PML_OB1_EVENT_MAX
+};
+
+typedef struct mca_pml_ob1_event_data_t {
+    int32_t peer;
+    int32_t tag;
+    uint64_t bytes;
+} mca_pml_ob1_event_data_t;
+
+extern mca_base_event_t *mca_pml_ob1_events[MCA_PML_OB1_EVENT_MAX];
+
+/* The events are raised with the matching lock or the request lock held, so
+ * their callbacks must not call back into MPI. */
+static inline void mca_pml_ob1_raise_event (int event, struct ompi_communicator_t *comm,
+                                            int peer, int tag, size_t bytes)
+{
+    if (mca_base_event_is_active (mca_pml_ob1_events[event])) {
+        mca_pml_ob1_event_data_t data = {.peer = peer, .tag = tag, .bytes = bytes};
+        mca_base_event_raise_internal (mca_pml_ob1_events[event], MCA_BASE_CB_REQUIRE_MPI_RESTRICTED,
+                                       comm, &data);
+    }
+}
 /*
  * PML interface functions.
  */
@@ -3,7 +3,7 @@
  * Copyright (c) 2004-2007 The Trustees of Indiana University and Indiana
  *                         University Research and Technology
  *                         Corporation.  All rights reserved.
- * Copyright (c) 2004-2016 The University of Tennessee and The University
+ * Copyright (c) 2004-2026 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  * Copyright (c) 2004-2005 High Performance Computing Center Stuttgart,
@@ -41,6 +41,7 @@
 #include "pml_ob1_component.h"
 #include "opal/mca/allocator/base/base.h"
 #include "opal/mca/base/mca_base_pvar.h"
+#include "opal/mca/base/mca_base_event.h"
 #include "opal/runtime/opal_params.h"
 #include "opal/mca/btl/base/base.h"
 
@@ -192,6 +193,22 @@ static int mca_pml_ob1_get_posted_recvq_size (const struct mca_base_pvar_t *pvar
     return OMPI_SUCCESS;
 }
 
+mca_base_event_t *mca_pml_ob1_events[MCA_PML_OB1_EVENT_MAX] = {NULL};
+
+static void mca_pml_ob1_event_register (int event, const char *name, const char *description)
+{
+    static const mca_base_var_type_t types[] = {MCA_BASE_VAR_TYPE_INT32_T, MCA_BASE_VAR_TYPE_INT32_T,
+                                                MCA_BASE_VAR_TYPE_UINT64_T};
+    static const ptrdiff_t displacements[] = {offsetof (mca_pml_ob1_event_data_t, peer),
+                                              offsetof (mca_pml_ob1_event_data_t, tag),
+                                              offsetof (mca_pml_ob1_event_data_t, bytes)};
+
+    (void) mca_base_component_event_register (&mca_pml_ob1_component.pmlm_version, name, description,
+                                              OPAL_INFO_LVL_5, NULL, MPI_T_BIND_MPI_COMM, 3, types,
+                                              displacements, sizeof (mca_pml_ob1_event_data_t), 0,
+                                              mca_pml_ob1_events + event);
+}
+
 static int mca_pml_ob1_component_register(void)
 {
     mca_pml_ob1_param_register_int("verbose", 0, &mca_pml_ob1_verbose);
@@ -239,6 +256,19 @@ static int mca_pml_ob1_component_register(void)
                                            MCA_BASE_PVAR_FLAG_READONLY | MCA_BASE_PVAR_FLAG_CONTINUOUS,
                                            mca_pml_ob1_get_posted_recvq_size, NULL, mca_pml_ob1_comm_size_notify, NULL);
 
+    mca_pml_ob1_event_register (MCA_PML_OB1_EVENT_SEND_POSTED, "send_posted",
+                                "A send was posted. Elements: destination rank, tag, message size");
+    mca_pml_ob1_event_register (MCA_PML_OB1_EVENT_MESSAGE_MATCHED, "message_matched",
+                                "A message was matched with a receive, either when it arrived or "
+                                "when the receive was posted. Elements: source rank, tag, message size");
+    mca_pml_ob1_event_register (MCA_PML_OB1_EVENT_MESSAGE_UNEXPECTED, "message_unexpected",
+                                "A message arrived before the matching receive was posted. "
+                                "Elements: source rank, tag, message size");
+    mca_pml_ob1_event_register (MCA_PML_OB1_EVENT_SEND_COMPLETE, "send_complete",
+                                "A send request completed. Elements: destination rank, tag, message size");
+    mca_pml_ob1_event_register (MCA_PML_OB1_EVENT_RECV_COMPLETE, "recv_complete",
+                                "A receive request completed. Elements: source rank, tag, bytes received");
+
     return OMPI_SUCCESS;
 }
 
@@ -141,6 +141,9 @@ static inline int mca_pml_ob1_send_inline (const void *buf, size_t count,
 	return rc;
     }
 
+    /* there will be no request to complete */
+    mca_pml_ob1_raise_event (MCA_PML_OB1_EVENT_SEND_COMPLETE, comm, dst, tag, size);
+
     return (int) size;
 }
 
@@ -164,6 +167,8 @@ int mca_pml_ob1_isend(const void *buf,
         return OMPI_ERR_UNREACH;
     }
 
+    mca_pml_ob1_raise_event (MCA_PML_OB1_EVENT_SEND_POSTED, comm, dst, tag, count * datatype->super.size);
+
     if (!OMPI_COMM_CHECK_ASSERT_ALLOW_OVERTAKE(comm)) {
         seqn = (uint16_t) OPAL_THREAD_ADD_FETCH32(&ob1_proc->send_sequence, 1);
     }
@@ -233,6 +238,8 @@ int mca_pml_ob1_send(const void *buf,
         return OMPI_SUCCESS;
     }
 
+    mca_pml_ob1_raise_event (MCA_PML_OB1_EVENT_SEND_POSTED, comm, dst, tag, count * datatype->super.size);
+
     if (!OMPI_COMM_CHECK_ASSERT_ALLOW_OVERTAKE(comm)) {
         seqn = (uint16_t) OPAL_THREAD_ADD_FETCH32(&ob1_proc->send_sequence, 1);
     }
@@ -827,6 +827,10 @@ static mca_pml_ob1_recv_request_t *match_one (mca_btl_base_module_t *btl,
 
             PERUSE_TRACE_COMM_EVENT(PERUSE_COMM_MSG_MATCH_POSTED_REQ,
                                     &(match->req_recv.req_base), PERUSE_RECV);
+            if (mca_base_event_is_active (mca_pml_ob1_events[MCA_PML_OB1_EVENT_MESSAGE_MATCHED])) {
+                mca_pml_ob1_raise_event (MCA_PML_OB1_EVENT_MESSAGE_MATCHED, comm_ptr, hdr->hdr_src, hdr->hdr_tag,
+                                         mca_pml_ob1_match_hdr_msg_length (hdr, segments, num_segments));
+            }
             SPC_TIMER_STOP(OMPI_SPC_MATCH_TIME, &timer);
             return match;
         }
@@ -844,6 +848,10 @@ static mca_pml_ob1_recv_request_t *match_one (mca_btl_base_module_t *btl,
         SPC_UPDATE_WATERMARK(OMPI_SPC_MAX_UNEXPECTED_IN_QUEUE, OMPI_SPC_UNEXPECTED_IN_QUEUE);
         PERUSE_TRACE_MSG_EVENT(PERUSE_COMM_MSG_INSERT_IN_UNEX_Q, comm_ptr,
                                hdr->hdr_src, hdr->hdr_tag, PERUSE_RECV);
+        if (mca_base_event_is_active (mca_pml_ob1_events[MCA_PML_OB1_EVENT_MESSAGE_UNEXPECTED])) {
+            mca_pml_ob1_raise_event (MCA_PML_OB1_EVENT_MESSAGE_UNEXPECTED, comm_ptr, hdr->hdr_src, hdr->hdr_tag,
+                                     mca_pml_ob1_match_hdr_msg_length (hdr, segments, num_segments));
+        }
         SPC_TIMER_STOP(OMPI_SPC_MATCH_TIME, &timer);
         return NULL;
     } while(true);
@@ -170,6 +170,29 @@ void append_frag_to_ordered_list(mca_pml_ob1_recv_frag_t** queue,
                                  uint16_t seq);
 
 extern void mca_pml_ob1_dump_cant_match(mca_pml_ob1_recv_frag_t* queue);
+
+/**
+ * Size of the message announced by a matching header, as reported in the
+ * MPI_T events.
+ */
+static inline size_t mca_pml_ob1_match_hdr_msg_length (const mca_pml_ob1_match_hdr_t *hdr,
+                                                       const mca_btl_base_segment_t *segments,
+                                                       size_t num_segments)
+{
+    size_t length = 0;
+
+    if (MCA_PML_OB1_HDR_TYPE_MATCH != hdr->hdr_common.hdr_type) {
+        /* rendezvous and rget headers both start with the rendezvous header */
+        return (size_t) ((const mca_pml_ob1_rendezvous_hdr_t *) hdr)->hdr_msg_length;
+    }
+
+    for (size_t i = 0 ; i < num_segments ; ++i) {
+        length += segments[i].seg_len;
+    }
+
+    return length - OMPI_PML_OB1_MATCH_HDR_LEN;
+}
+
 END_C_DECLS
 
 #endif
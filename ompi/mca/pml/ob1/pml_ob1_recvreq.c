@@ -1324,6 +1324,13 @@ void mca_pml_ob1_recv_req_start(mca_pml_ob1_recv_request_t *req)
                                    hdr->hdr_match.hdr_tag,
                                    PERUSE_RECV);
 
+            if (mca_base_event_is_active (mca_pml_ob1_events[MCA_PML_OB1_EVENT_MESSAGE_MATCHED])) {
+                mca_pml_ob1_raise_event (MCA_PML_OB1_EVENT_MESSAGE_MATCHED, req->req_recv.req_base.req_comm,
+                                         hdr->hdr_match.hdr_src, hdr->hdr_match.hdr_tag,
+                                         mca_pml_ob1_match_hdr_msg_length (&hdr->hdr_match, frag->segments,
+                                                                           frag->num_segments));
+            }
+
             PERUSE_TRACE_COMM_EVENT(PERUSE_COMM_SEARCH_UNEX_Q_END,
                                     &(req->req_recv.req_base), PERUSE_RECV);
 
@@ -197,6 +197,12 @@ recv_request_pml_complete(mca_pml_ob1_recv_request_t *recvreq)
                 mca_bml_base_deregister_mem (recvreq->rdma_bml, recvreq->local_handle);
                 recvreq->local_handle = NULL;
             }
+            if (MCA_PML_REQUEST_RECV == recvreq->req_recv.req_base.req_type) {
+                mca_pml_ob1_raise_event (MCA_PML_OB1_EVENT_RECV_COMPLETE, recvreq->req_recv.req_base.req_comm,
+                                         recvreq->req_recv.req_base.req_ompi.req_status.MPI_SOURCE,
+                                         recvreq->req_recv.req_base.req_ompi.req_status.MPI_TAG,
+                                         recvreq->req_bytes_received);
+            }
             MCA_PML_OB1_RECV_REQUEST_MPI_COMPLETE(recvreq);
         }
 
@@ -209,6 +209,11 @@ do {
         (sendreq)->req_send.req_bytes_packed;                                        \
    PERUSE_TRACE_COMM_EVENT( PERUSE_COMM_REQ_COMPLETE,                                \
                             &(sendreq->req_send.req_base), PERUSE_SEND);             \
+   mca_pml_ob1_raise_event (MCA_PML_OB1_EVENT_SEND_COMPLETE,                         \
+                            (sendreq)->req_send.req_base.req_comm,                   \
+                            (sendreq)->req_send.req_base.req_peer,                   \
+                            (sendreq)->req_send.req_base.req_tag,                    \
+                            (sendreq)->req_send.req_bytes_packed);                   \
                                                                                      \
    ompi_request_complete( &((sendreq)->req_send.req_base.req_ompi), (with_signal) ); \
 } while(0)
@@ -96,6 +96,10 @@ int mca_pml_ob1_start(size_t count, ompi_request_t** requests)
                 /* reset the completion flag */
                 pml_request->req_pml_complete = false;
 
+                mca_pml_ob1_raise_event (MCA_PML_OB1_EVENT_SEND_POSTED, pml_request->req_comm,
+                                         pml_request->req_peer, pml_request->req_tag,
+                                         sendreq->req_send.req_bytes_packed);
+
                 MCA_PML_OB1_SEND_REQUEST_START(sendreq, rc);
                 if(rc != OMPI_SUCCESS)
                     return rc;
@@ -26,11 +26,8 @@ AC_DEFUN([MCA_ompi_sharedfp_sm_CONFIG],[
     AC_CONFIG_FILES([ompi/mca/sharedfp/sm/Makefile])
 
     sharedfp_sm_happy=no
-    AC_CHECK_HEADER([semaphore.h],
-                    [AC_CHECK_FUNCS([sem_open],[sharedfp_sm_happy=yes],[])])
-
-    AC_CHECK_HEADER([semaphore.h],
-        [AC_CHECK_FUNCS([sem_init],[sharedfp_sm_happy=yes],[])])
+    AC_CHECK_HEADER([sys/mman.h],
+                    [AC_CHECK_FUNCS([mmap],[sharedfp_sm_happy=yes],[])])
 
     AS_IF([test "$sharedfp_sm_happy" = "yes"],
           [$1],
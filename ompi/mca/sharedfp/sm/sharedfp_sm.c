@@ -30,6 +30,11 @@
 #include "ompi/mca/sharedfp/sharedfp.h"
 #include "ompi/mca/sharedfp/base/base.h"
 #include "ompi/mca/sharedfp/sm/sharedfp_sm.h"
+#include "ompi/mca/osc/osc.h"
+#include "ompi/mca/osc/base/base.h"
+#include "opal/mca/base/base.h"
+
+#include <string.h>
 
 /*
  * *******************************************************************
@@ -61,6 +66,30 @@ static mca_sharedfp_base_module_1_0_0_t sm =  {
  * *******************************************************************
  */
 
+/* Processes on multiple nodes share the file pointer through a window,
+** check whether an osc component can create one on the communicator.
+** The monitoring component only interposes the component selected
+** otherwise.
+*/
+static bool sm_osc_available (ompi_communicator_t *comm)
+{
+    mca_base_component_list_item_t *cli;
+    ompi_osc_base_component_t *component;
+
+    OPAL_LIST_FOREACH(cli, &ompi_osc_base_framework.framework_components, mca_base_component_list_item_t) {
+        component = (ompi_osc_base_component_t *) cli->cli_component;
+        if ( 0 == strcmp (component->osc_version.mca_component_name, "monitoring") ) {
+            continue;
+        }
+        if ( 0 <= component->osc_query (NULL, NULL, sizeof(OMPI_MPI_OFFSET_TYPE),
+                                         sizeof(OMPI_MPI_OFFSET_TYPE), comm, NULL,
+                                         MPI_WIN_FLAVOR_ALLOCATE) ) {
+            return true;
+        }
+    }
+    return false;
+}
+
 int mca_sharedfp_sm_component_init_query(bool enable_progress_threads,
                                             bool enable_mpi_threads)
 {
@@ -75,24 +104,37 @@ struct mca_sharedfp_base_module_1_0_0_t * mca_sharedfp_sm_component_file_query(o
     ompi_proc_t *proc;
     ompi_communicator_t * comm = fh->f_comm;
     int size = ompi_comm_size(comm);
+    bool internode = false;
 
     *priority = 0;
 
-    /* test, and update priority. All processes have to be
-    ** on a single node.
+    /* test, and update priority. Without the internode support,
+    ** all processes have to be on a single node.
     ** original test copied from mca/coll/sm/coll_sm_module.c:
     */
     ompi_group_t *group = comm->c_local_group;
 
     for (i = 0; i < size; ++i) {
         proc = ompi_group_peer_lookup(group,i);
-        if (!OPAL_PROC_ON_LOCAL_NODE(proc->super.proc_flags)){
+        if (!OPAL_PROC_ON_LOCAL_NODE(proc->super.proc_flags) &&
+            SHAREDFP_SM_INTERNODE_NEVER == mca_sharedfp_sm_internode ){
             opal_output(ompi_sharedfp_base_framework.framework_output,
                         "mca_sharedfp_sm_component_file_query: Disqualifying myself: (%d/%s) "
                         "not all processes are on the same node.",
                         comm->c_contextid, comm->c_name);
             return NULL;
         }
+        if (!OPAL_PROC_ON_LOCAL_NODE(proc->super.proc_flags)) {
+            internode = true;
+        }
+    }
+    if ( internode && SHAREDFP_SM_INTERNODE_AUTO == mca_sharedfp_sm_internode &&
+         !sm_osc_available (comm) ) {
+        opal_output(ompi_sharedfp_base_framework.framework_output,
+                    "mca_sharedfp_sm_component_file_query: Disqualifying myself: (%d/%s) "
+                    "processes on multiple nodes and no osc component available.",
+                    comm->c_contextid, comm->c_name);
+        return NULL;
     }
     /* This module can run */
     *priority = mca_sharedfp_sm_priority;
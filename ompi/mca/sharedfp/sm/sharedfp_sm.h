@@ -28,7 +28,7 @@
 #include "ompi/mca/mca.h"
 #include "ompi/mca/sharedfp/sharedfp.h"
 #include "ompi/mca/common/ompio/common_ompio.h"
-#include <semaphore.h>
+#include "opal/sys/atomic.h"
 
 BEGIN_C_DECLS
 
@@ -43,6 +43,11 @@ int mca_sharedfp_sm_module_finalize (ompio_file_t *file);
 
 extern int mca_sharedfp_sm_priority;
 extern int mca_sharedfp_sm_verbose;
+extern int mca_sharedfp_sm_internode;
+
+#define SHAREDFP_SM_INTERNODE_NEVER  0
+#define SHAREDFP_SM_INTERNODE_AUTO   1
+#define SHAREDFP_SM_INTERNODE_ALWAYS 2
 
 OMPI_MODULE_DECLSPEC extern mca_sharedfp_base_component_2_0_0_t mca_sharedfp_sm_component;
 /*
@@ -104,9 +109,29 @@ int mca_sharedfp_sm_iwrite (ompio_file_t *fh,
 /*--------------------------------------------------------------*
  *Structures and definitions only for this component
  *--------------------------------------------------------------*/
+/* Slot of a process in the segment of its node. If the processes are
+ * spread over multiple nodes, a process posts its request here, and one
+ * process of the node combines all posted requests into a single update
+ * of the shared file pointer.
+ */
+struct mca_sharedfp_sm_request{
+    opal_atomic_int64_t bytes;     /* number of bytes requested */
+    opal_atomic_int64_t offset;    /* offset assigned to the request */
+    opal_atomic_int32_t state;
+    char padding[44];              /* one slot per cache line */
+};
+
+#define SHAREDFP_SM_REQUEST_IDLE   0
+#define SHAREDFP_SM_REQUEST_POSTED 1
+#define SHAREDFP_SM_REQUEST_DONE   2
+#define SHAREDFP_SM_REQUEST_FAILED 3
+
+/* Layout of the shared memory segment of a node */
 struct mca_sharedfp_sm_offset{
-    sem_t mutex;      /* the mutex: a POSIX memory-based unnamed semaphore */
-    long long offset;  /* and the shared file pointer offset */
+    opal_atomic_int64_t offset;    /* the shared file pointer, if all processes are on this node */
+    opal_atomic_int32_t combiner;  /* set while a process combines the requests of the node */
+    char padding[52];
+    struct mca_sharedfp_sm_request requests[];  /* one per process of the node */
 };
 
 /*This structure will hang off of the mca_sharedfp_base_data_t's
@@ -115,15 +140,18 @@ struct mca_sharedfp_sm_offset{
 struct mca_sharedfp_sm_data
 {
     struct mca_sharedfp_sm_offset * sm_offset_ptr;
+    size_t sm_size;
     /*save filename so that we can remove the file on close*/
     char * sm_filename;
-    /* The mutex: it will either point to a POSIX memory-based named
-       semaphore, or it will point to the a POSIX memory-based unnamed
-       semaphore located in sm_offset_ptr->mutex. */
-    sem_t *mutex;
-    char *sem_name;    /* Name of the semaphore */
+    int node_rank;
+    int node_size;
+    /* Only used if the processes are spread over multiple nodes: the
+       shared file pointer is kept in a window on rank 0 and updated
+       with fetch_and_op. */
+    struct ompi_win_t *win;
+    OMPI_MPI_OFFSET_TYPE *win_base;
+    int *combined;                 /* scratch list of the combined requests */
 };
-
 typedef struct mca_sharedfp_sm_data sm_data;
 
 
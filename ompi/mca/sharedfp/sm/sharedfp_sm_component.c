@@ -40,6 +40,7 @@ const char *mca_sharedfp_sm_component_version_string =
  */
 int mca_sharedfp_sm_priority=30;
 int mca_sharedfp_sm_verbose=0;
+int mca_sharedfp_sm_internode=SHAREDFP_SM_INTERNODE_AUTO;
 
 static int sm_register(void);
 
@@ -84,6 +85,16 @@ static int sm_register(void)
                                            MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
                                            OPAL_INFO_LVL_9,
                                            MCA_BASE_VAR_SCOPE_READONLY, &mca_sharedfp_sm_verbose);
+    mca_sharedfp_sm_internode = SHAREDFP_SM_INTERNODE_AUTO;
+    (void) mca_base_component_var_register(&mca_sharedfp_sm_component.sharedfpm_version,
+                                           "internode", "Support for processes on multiple nodes. "
+                                           "0: disqualify if not all processes are on the same node "
+                                           "1: combine the requests of a node in shared memory and keep the shared "
+                                           "file pointer in a window on rank 0, if the processes are on multiple nodes (default) "
+                                           "2: always use the window, even on a single node",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY, &mca_sharedfp_sm_internode);
 
     return OMPI_SUCCESS;
 }
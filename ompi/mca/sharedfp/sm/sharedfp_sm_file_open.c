@@ -38,14 +38,19 @@
 #include "ompi/constants.h"
 #include "ompi/group/group.h"
 #include "ompi/proc/proc.h"
+#include "ompi/communicator/communicator.h"
+#include "ompi/win/win.h"
+#include "ompi/mca/osc/osc.h"
 #include "ompi/mca/sharedfp/sharedfp.h"
 #include "ompi/mca/sharedfp/base/base.h"
 
-#include <semaphore.h>
 #include <sys/mman.h>
 #include <libgen.h>
 #include <unistd.h>
 
+static int sm_win_open (struct ompi_communicator_t *comm, struct mca_sharedfp_sm_data *sm_data);
+static void sm_release (struct mca_sharedfp_sm_data *sm_data);
+
 int mca_sharedfp_sm_file_open (struct ompi_communicator_t *comm,
                                const char* filename,
                                int amode,
@@ -55,14 +60,15 @@ int mca_sharedfp_sm_file_open (struct ompi_communicator_t *comm,
     int err = OMPI_SUCCESS;
     struct mca_sharedfp_base_data_t* sh;
     struct mca_sharedfp_sm_data * sm_data = NULL;
+    struct ompi_communicator_t *node_comm = MPI_COMM_NULL;
     char * filename_basename;
     char * sm_filename;
     int sm_filename_length;
     struct mca_sharedfp_sm_offset * sm_offset_ptr;
-    struct mca_sharedfp_sm_offset sm_offset;
     int sm_fd;
     uint32_t comm_cid;
     int int_pid;
+    int sized;
     pid_t my_pid;
 
     /*Memory is allocated here for the sh structure*/
@@ -88,14 +94,25 @@ int mca_sharedfp_sm_file_open (struct ompi_communicator_t *comm,
     }
 
 
-    sm_data = (struct mca_sharedfp_sm_data*) malloc ( sizeof(struct mca_sharedfp_sm_data));
+    sm_data = (struct mca_sharedfp_sm_data*) calloc ( 1, sizeof(struct mca_sharedfp_sm_data));
     if ( NULL == sm_data ){
         opal_output(0, "mca_sharedfp_sm_file_open: Error, unable to malloc sm_data struct\n");
         free(sh);
         return OMPI_ERR_OUT_OF_RESOURCE;
     }
-    sm_data->sm_filename=NULL;
 
+    /* one segment per node, holding the shared file pointer and the
+    ** request slots of the processes of the node.
+    */
+    err = ompi_comm_split_type (comm, MPI_COMM_TYPE_SHARED, 0, NULL, &node_comm);
+    if ( OMPI_SUCCESS != err ) {
+        opal_output(0,"mca_sharedfp_sm_file_open: Error in comm_split_type operation \n");
+        goto error;
+    }
+    sm_data->node_rank = ompi_comm_rank (node_comm);
+    sm_data->node_size = ompi_comm_size (node_comm);
+    sm_data->sm_size   = sizeof(struct mca_sharedfp_sm_offset) +
+        sm_data->node_size * sizeof(struct mca_sharedfp_sm_request);
 
     /* the shared memory segment is identified opening a file
     ** and then mapping it to memory
@@ -107,23 +124,20 @@ int mca_sharedfp_sm_file_open (struct ompi_communicator_t *comm,
     sm_filename = (char*) malloc( sizeof(char) * sm_filename_length);
     if (NULL == sm_filename) {
         opal_output(0, "mca_sharedfp_sm_file_open: Error, unable to malloc sm_filename\n");
-        free(sm_data);
-        free(sh);
-        return OMPI_ERR_OUT_OF_RESOURCE;
+        err = OMPI_ERR_OUT_OF_RESOURCE;
+        goto error;
     }
+    sm_data->sm_filename = sm_filename;
 
     comm_cid = ompi_comm_get_cid(comm);
-    if ( 0 == fh->f_rank ) {
+    if ( 0 == sm_data->node_rank ) {
         my_pid = getpid();
         int_pid = (int) my_pid;
     }
-    err = comm->c_coll->coll_bcast (&int_pid, 1, MPI_INT, 0, comm, comm->c_coll->coll_bcast_module );
+    err = node_comm->c_coll->coll_bcast (&int_pid, 1, MPI_INT, 0, node_comm, node_comm->c_coll->coll_bcast_module );
     if ( OMPI_SUCCESS != err ) {
         opal_output(0,"mca_sharedfp_sm_file_open: Error in bcast operation \n");
-        free(sm_filename);
-        free(sm_data);
-        free(sh);
-        return err;
+        goto error;
     }
 
     snprintf(sm_filename, sm_filename_length, "%s/%s_cid-%d-%d.sm", ompi_process_info.job_session_dir,
@@ -134,104 +148,125 @@ int mca_sharedfp_sm_file_open (struct ompi_communicator_t *comm,
     if ( sm_fd == -1){
         /*error opening file*/
         opal_output(0,"mca_sharedfp_sm_file_open: Error, unable to open file for mmap: %s\n",sm_filename);
-        free(sm_filename);
-        free(sm_data);
-        free(sh);
-        return OMPI_ERROR;
+        err = OMPI_ERROR;
+        goto error;
     }
 
-    sm_data->sm_filename = sm_filename;
-
-    /* TODO: is it necessary to write to the file first? */
-    if( 0 == fh->f_rank ){
-        memset ( &sm_offset, 0, sizeof (struct mca_sharedfp_sm_offset ));
-        write ( sm_fd, &sm_offset, sizeof(struct mca_sharedfp_sm_offset));
+    /* accessing the mapping beyond the end of the file raises SIGBUS,
+    ** all processes of the node have to know whether it was sized.
+    */
+    sized = 1;
+    if ( 0 == sm_data->node_rank ) {
+        if ( 0 != ftruncate ( sm_fd, sm_data->sm_size ) ) {
+            opal_output(0,"mca_sharedfp_sm_file_open: Error, unable to size file for mmap: %s\n",sm_filename);
+            sized = 0;
+        }
     }
-    err = comm->c_coll->coll_barrier (comm, comm->c_coll->coll_barrier_module );
+    err = node_comm->c_coll->coll_bcast (&sized, 1, MPI_INT, 0, node_comm, node_comm->c_coll->coll_bcast_module );
     if ( OMPI_SUCCESS != err ) {
-        opal_output(0,"mca_sharedfp_sm_file_open: Error in barrier operation \n");
-        free(sm_filename);
-        free(sm_data);
-        free(sh);
+        opal_output(0,"mca_sharedfp_sm_file_open: Error in bcast operation \n");
         close (sm_fd);
-        return err;
+        goto error;
+    }
+    if ( !sized ) {
+        close (sm_fd);
+        err = OMPI_ERROR;
+        goto error;
     }
 
-    /*the file has been written to, now we can map*/
-    sm_offset_ptr = mmap(NULL, sizeof(struct mca_sharedfp_sm_offset), PROT_READ | PROT_WRITE,
+    /*the file has been sized and zeroed, now we can map*/
+    sm_offset_ptr = mmap(NULL, sm_data->sm_size, PROT_READ | PROT_WRITE,
                          MAP_SHARED, sm_fd, 0);
 
     close(sm_fd);
 
     if ( sm_offset_ptr==MAP_FAILED){
-        err = OMPI_ERROR;
         opal_output(0, "mca_sharedfp_sm_file_open: Error, unable to mmap file: %s\n",sm_filename);
         opal_output(0, "%s\n", strerror(errno));
-        free(sm_filename);
-        free(sm_data);
-        free(sh);
-        return OMPI_ERROR;
+        err = OMPI_ERROR;
+        goto error;
     }
+    sm_data->sm_offset_ptr = sm_offset_ptr;
 
-    /* Initialize semaphore so that is shared between processes.           */
-    /* the semaphore is shared by keeping it in the shared memory segment  */
+    /* The shared file pointer itself does not require a lock: it is
+    ** updated with an atomic fetch-and-add in the segment if all
+    ** processes are on the same node, and in a window on rank 0
+    ** otherwise.
+    */
+    if ( sm_data->node_size < fh->f_size ||
+         SHAREDFP_SM_INTERNODE_ALWAYS == mca_sharedfp_sm_internode ) {
+        err = sm_win_open (comm, sm_data);
+        if ( OMPI_SUCCESS != err ) {
+            opal_output(0,"mca_sharedfp_sm_file_open: Error, unable to create window for the shared file pointer\n");
+            goto error;
+        }
+    }
 
-#if defined(HAVE_SEM_OPEN)
+    err = comm->c_coll->coll_barrier (comm, comm->c_coll->coll_barrier_module );
+    if ( OMPI_SUCCESS != err ) {
+        opal_output(0,"mca_sharedfp_sm_file_open: Error in barrier operation \n");
+        goto error;
+    }
+    ompi_comm_free (&node_comm);
 
-#if defined (__APPLE__)
-    sm_data->sem_name = (char*) malloc( sizeof(char) * 32);
-    snprintf(sm_data->sem_name,31,"OMPIO_%s",filename_basename);
-#else
-    sm_data->sem_name = (char*) malloc( sizeof(char) * 253);
-    snprintf(sm_data->sem_name,252,"OMPIO_%s",filename_basename);
-#endif
+    /* Assign the sm_data to sh->selected_module_data*/
+    sh->selected_module_data   = sm_data;
+    /*remember the shared file handle*/
+    fh->f_sharedfp_data = sh;
 
-    if( (sm_data->mutex = sem_open(sm_data->sem_name, O_CREAT, 0644, 1)) != SEM_FAILED ) {
-#elif defined(HAVE_SEM_INIT)
-    sm_data->mutex = &sm_offset_ptr->mutex;
-    if(sem_init(&sm_offset_ptr->mutex, 1, 1) != -1){
-#endif
-        /*If opening was successful*/
-        /*Store the new file handle*/
-        sm_data->sm_offset_ptr = sm_offset_ptr;
-        /* Assign the sm_data to sh->selected_module_data*/
-        sh->selected_module_data   = sm_data;
-        /*remember the shared file handle*/
-        fh->f_sharedfp_data = sh;
-
-        /*write initial zero*/
-        if(fh->f_rank==0){
-            MPI_Offset position=0;
-
-            sem_wait(sm_data->mutex);
-            sm_offset_ptr->offset=position;
-            sem_post(sm_data->mutex);
-        }
-    }else{
-        free(sm_filename);
-        free(sm_data);
-        free(sh);
-        munmap(sm_offset_ptr, sizeof(struct mca_sharedfp_sm_offset));
-        return OMPI_ERROR;
+    return OMPI_SUCCESS;
+
+error:
+    if ( MPI_COMM_NULL != node_comm ) {
+        ompi_comm_free (&node_comm);
+    }
+    sm_release (sm_data);
+    free(sh);
+    return err;
+}
+
+static int sm_win_open (struct ompi_communicator_t *comm, struct mca_sharedfp_sm_data *sm_data)
+{
+    size_t size = ( 0 == ompi_comm_rank (comm) ) ? sizeof(OMPI_MPI_OFFSET_TYPE) : 0;
+    int err;
+
+    sm_data->combined = (int *) malloc ( sm_data->node_size * sizeof(int));
+    if ( NULL == sm_data->combined ) {
+        return OMPI_ERR_OUT_OF_RESOURCE;
     }
 
+    err = ompi_win_allocate (size, sizeof(OMPI_MPI_OFFSET_TYPE), &(MPI_INFO_NULL->super), comm,
+                             &sm_data->win_base, &sm_data->win);
+    if ( OMPI_SUCCESS != err ) {
+        sm_data->win = NULL;
+        return err;
+    }
+    if ( 0 < size ) {
+        *sm_data->win_base = 0;
+    }
     err = comm->c_coll->coll_barrier (comm, comm->c_coll->coll_barrier_module );
     if ( OMPI_SUCCESS != err ) {
-        opal_output(0,"mca_sharedfp_sm_file_open: Error in barrier operation \n");
-        free(sm_filename);
-        free(sm_data);
-        free(sh);
-        munmap(sm_offset_ptr, sizeof(struct mca_sharedfp_sm_offset));
         return err;
     }
 
-#if defined(HAVE_SEM_OPEN)
-    if ( 0 == fh->f_rank ) {
-        sem_unlink ( sm_data->sem_name);
-    }
-#endif
+    return sm_data->win->w_osc_module->osc_lock_all (MPI_MODE_NOCHECK, sm_data->win);
+}
 
-    return OMPI_SUCCESS;
+static void sm_release (struct mca_sharedfp_sm_data *sm_data)
+{
+    if ( NULL != sm_data->win ) {
+        sm_data->win->w_osc_module->osc_unlock_all (sm_data->win);
+        ompi_win_free (sm_data->win);
+    }
+    if ( NULL != sm_data->sm_offset_ptr ) {
+        /*Release the shared memory segment.*/
+        munmap(sm_data->sm_offset_ptr, sm_data->sm_size);
+        /*Q: Do we need to delete the file? */
+        remove(sm_data->sm_filename);
+    }
+    free(sm_data->sm_filename);
+    free(sm_data->combined);
+    free(sm_data);
 }
 
 int mca_sharedfp_sm_file_close (ompio_file_t *fh)
@@ -239,8 +274,6 @@ int mca_sharedfp_sm_file_close (ompio_file_t *fh)
     int err = OMPI_SUCCESS;
     /*sharedfp data structure*/
     struct mca_sharedfp_base_data_t *sh=NULL;
-    /*sharedfp sm module data structure*/
-    struct mca_sharedfp_sm_data * file_data=NULL;
 
     if( NULL == fh->f_sharedfp_data ){
         return OMPI_SUCCESS;
@@ -253,27 +286,8 @@ int mca_sharedfp_sm_file_close (ompio_file_t *fh)
      */
     fh->f_comm->c_coll->coll_barrier (fh->f_comm, fh->f_comm->c_coll->coll_barrier_module );
 
-    file_data = (sm_data*)(sh->selected_module_data);
-    if (file_data)  {
-        /*Close sm handle*/
-        if (file_data->sm_offset_ptr) {
-            /* destroy semaphore */
-#if defined(HAVE_SEM_OPEN)
-             sem_close ( file_data->mutex);
-             free (file_data->sem_name);
-#elif defined(HAVE_SEM_INIT)
-            sem_destroy(&file_data->sm_offset_ptr->mutex);
-#endif
-            /*Release the shared memory segment.*/
-            munmap(file_data->sm_offset_ptr,sizeof(struct mca_sharedfp_sm_offset));
-            /*Q: Do we need to delete the file? */
-            remove(file_data->sm_filename);
-        }
-        /*free our sm data structure*/
-        if(file_data->sm_filename){
-            free(file_data->sm_filename);
-        }
-        free(file_data);
+    if (sh->selected_module_data)  {
+        sm_release ((sm_data*)(sh->selected_module_data));
     }
 
     /*free shared file pointer data struct*/
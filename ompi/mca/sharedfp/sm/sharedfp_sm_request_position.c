@@ -24,69 +24,124 @@
 
 #include "mpi.h"
 #include "ompi/constants.h"
+#include "ompi/win/win.h"
+#include "ompi/mca/osc/osc.h"
 #include "ompi/mca/sharedfp/sharedfp.h"
 #include "ompi/mca/sharedfp/base/base.h"
+#include "opal/runtime/opal_progress.h"
 
-/*use a semaphore to lock the shared memory*/
-#include <semaphore.h>
+/*
+ * Combine all requests posted on this node into a single fetch_and_op
+ * on the window holding the shared file pointer. Has to be called by
+ * the process holding the combiner flag of the node.
+ */
+static int sm_combine_requests (struct mca_sharedfp_sm_data *sm_data)
+{
+    struct mca_sharedfp_sm_offset *sm_offset_ptr = sm_data->sm_offset_ptr;
+    struct mca_sharedfp_sm_request *req;
+    OMPI_MPI_OFFSET_TYPE total = 0, base = 0;
+    int i, num_combined = 0, state;
+    int ret;
+
+    for ( i = 0; i < sm_data->node_size; i++ ) {
+        req = &sm_offset_ptr->requests[i];
+        if ( SHAREDFP_SM_REQUEST_POSTED == req->state ) {
+            opal_atomic_rmb ();
+            sm_data->combined[num_combined++] = i;
+            total += req->bytes;
+        }
+    }
+    if ( 0 == num_combined ) {
+        return OMPI_SUCCESS;
+    }
+
+    ret = sm_data->win->w_osc_module->osc_fetch_and_op (&total, &base, MPI_OFFSET, 0, 0,
+                                                         MPI_SUM, sm_data->win);
+    if ( OMPI_SUCCESS == ret ) {
+        ret = sm_data->win->w_osc_module->osc_flush (0, sm_data->win);
+    }
+    state = ( OMPI_SUCCESS == ret ) ? SHAREDFP_SM_REQUEST_DONE : SHAREDFP_SM_REQUEST_FAILED;
+
+    /* hand out consecutive ranges of the reserved block in slot order */
+    for ( i = 0; i < num_combined; i++ ) {
+        req = &sm_offset_ptr->requests[sm_data->combined[i]];
+        req->offset = base;
+        base += req->bytes;
+        opal_atomic_wmb ();
+        req->state = state;
+    }
+
+    return ret;
+}
 
 int mca_sharedfp_sm_request_position(ompio_file_t *fh, 
                                      int bytes_requested,
                                      OMPI_MPI_OFFSET_TYPE *offset)
 {
     int ret = OMPI_SUCCESS;
-    OMPI_MPI_OFFSET_TYPE position = 0;
-    OMPI_MPI_OFFSET_TYPE old_offset;
     struct mca_sharedfp_sm_data * sm_data = NULL;
     struct mca_sharedfp_sm_offset * sm_offset_ptr = NULL;
+    struct mca_sharedfp_sm_request * req = NULL;
     struct mca_sharedfp_base_data_t *sh = NULL;
+    int32_t unlocked;
 
     sh = fh->f_sharedfp_data;
     sm_data = sh->selected_module_data;
-
-    *offset = 0;
-    if ( mca_sharedfp_sm_verbose ) {
-        opal_output(ompi_sharedfp_base_framework.framework_output,
-                    "Aquiring lock, rank=%d...",fh->f_rank);
-    }
-
     sm_offset_ptr = sm_data->sm_offset_ptr;
 
-    /* Aquire an exclusive lock */
-
-    sem_wait(sm_data->mutex);
+    *offset = 0;
 
-    if ( mca_sharedfp_sm_verbose ) {
-        opal_output(ompi_sharedfp_base_framework.framework_output,
-                    "Succeeded! Acquired sm lock.for rank=%d\n",fh->f_rank);
+    if ( NULL == sm_data->win ) {
+        /* all processes are on this node */
+        *offset = opal_atomic_fetch_add_64 (&sm_offset_ptr->offset, bytes_requested);
+        if ( mca_sharedfp_sm_verbose ) {
+            opal_output(ompi_sharedfp_base_framework.framework_output,
+                        "old_offset=%lld, bytes_requested=%d, rank=%d\n",*offset,bytes_requested,fh->f_rank);
+        }
+        return ret;
     }
 
-    old_offset=sm_offset_ptr->offset;
-    if ( mca_sharedfp_sm_verbose ) {
-        opal_output(ompi_sharedfp_base_framework.framework_output,
-                    "Read last_offset=%lld!\n",old_offset);
+    /* Post the request in the slot of this process. Whichever process of
+    ** the node gets the combiner flag first serves all requests posted
+    ** at that time, such that concurrent requests of a node cost a single
+    ** update of the shared file pointer.
+    */
+    req = &sm_offset_ptr->requests[sm_data->node_rank];
+    req->bytes = bytes_requested;
+    opal_atomic_wmb ();
+    req->state = SHAREDFP_SM_REQUEST_POSTED;
+
+    while ( SHAREDFP_SM_REQUEST_POSTED == req->state ) {
+        unlocked = 0;
+        if ( 0 == sm_offset_ptr->combiner &&
+             opal_atomic_compare_exchange_strong_32 (&sm_offset_ptr->combiner, &unlocked, 1) ) {
+            ret = sm_combine_requests (sm_data);
+            opal_atomic_wmb ();
+            sm_offset_ptr->combiner = 0;
+            if ( OMPI_SUCCESS != ret ) {
+                opal_output(0, "mca_sharedfp_sm_request_position: error %d updating the shared file pointer\n", ret);
+            }
+        }
+        else {
+            /* the combiner might wait for rank 0 to progress the window */
+            opal_progress ();
+        }
     }
 
-    position = old_offset + bytes_requested;
-    if ( mca_sharedfp_sm_verbose ) {
-        opal_output(ompi_sharedfp_base_framework.framework_output,
-                    "old_offset=%lld, bytes_requested=%d, new offset=%lld!\n",old_offset,bytes_requested,position);
+    opal_atomic_rmb ();
+    if ( SHAREDFP_SM_REQUEST_DONE == req->state ) {
+        *offset = req->offset;
+        ret = OMPI_SUCCESS;
     }
-    sm_offset_ptr->offset=position;
-
-
-    if ( mca_sharedfp_sm_verbose ) {
-        opal_output(ompi_sharedfp_base_framework.framework_output,
-                    "Releasing sm lock...rank=%d",fh->f_rank);
+    else {
+        ret = OMPI_ERROR;
     }
+    req->state = SHAREDFP_SM_REQUEST_IDLE;
 
-    sem_post(sm_data->mutex);
     if ( mca_sharedfp_sm_verbose ) {
         opal_output(ompi_sharedfp_base_framework.framework_output,
-                    "Released lock! released lock.for rank=%d\n",fh->f_rank);
+                    "old_offset=%lld, bytes_requested=%d, rank=%d\n",*offset,bytes_requested,fh->f_rank);
     }
 
-    *offset = old_offset;
-
     return ret;
 }
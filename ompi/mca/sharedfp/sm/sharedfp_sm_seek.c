@@ -29,8 +29,8 @@
 #include "ompi/mca/sharedfp/sharedfp.h"
 #include "ompi/mca/sharedfp/base/base.h"
 
-/*use a semaphore to lock the shared memory location*/
-#include <semaphore.h>
+#include "ompi/win/win.h"
+#include "ompi/mca/osc/osc.h"
 
 int
 mca_sharedfp_sm_seek (ompio_file_t *fh,
@@ -107,29 +107,22 @@ mca_sharedfp_sm_seek (ompio_file_t *fh,
         sm_data = sh->selected_module_data;
         sm_offset_ptr = sm_data->sm_offset_ptr;
 
-        /*-------------------*/
-        /*lock the file  */
-        /*--------------------*/
-        if ( mca_sharedfp_sm_verbose ) {
-            opal_output(ompi_sharedfp_base_framework.framework_output,
-                        "sharedfp_sm_seek: Aquiring lock, rank=%d...",fh->f_rank); fflush(stdout);
+        if ( OMPI_SUCCESS == ret && NULL == sm_data->win ) {
+            opal_atomic_swap_64 (&sm_offset_ptr->offset, offset);
         }
+        else if ( OMPI_SUCCESS == ret ) {
+            OMPI_MPI_OFFSET_TYPE old_offset;
 
-        /* Aquire an exclusive lock */
-        sm_offset_ptr = sm_data->sm_offset_ptr;
-
-        sem_wait(sm_data->mutex);
-
-        if ( mca_sharedfp_sm_verbose ) {
-            opal_output(ompi_sharedfp_base_framework.framework_output,
-                        "sharedfp_sm_seek: Success! Acquired sm lock.for rank=%d\n",fh->f_rank);
+            ret = sm_data->win->w_osc_module->osc_fetch_and_op (&offset, &old_offset, MPI_OFFSET, 0, 0,
+                                                                 MPI_REPLACE, sm_data->win);
+            if ( OMPI_SUCCESS == ret ) {
+                ret = sm_data->win->w_osc_module->osc_flush (0, sm_data->win);
+            }
         }
-        sm_offset_ptr->offset=offset;
         if ( mca_sharedfp_sm_verbose ) {
             opal_output(ompi_sharedfp_base_framework.framework_output,
-                        "sharedfp_sm_seek: Releasing sm lock...rank=%d",fh->f_rank); fflush(stdout);
+                        "sharedfp_sm_seek: new_offset=%lld, rank=%d\n",offset,fh->f_rank);
         }
-        sem_post(sm_data->mutex);
     }
 
     /* since we are only letting process 0, update the current pointer
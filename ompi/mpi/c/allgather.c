@@ -32,6 +32,7 @@
 #include "ompi/errhandler/errhandler.h"
 #include "ompi/datatype/ompi_datatype.h"
 #include "ompi/memchecker.h"
+#include "ompi/mca/coll/base/coll_base_event.h"
 #include "ompi/runtime/ompi_spc.h"
 
 #if OMPI_BUILD_MPI_PROFILING
@@ -50,7 +51,7 @@ int MPI_Allgather(const void *sendbuf, int sendcount, MPI_Datatype sendtype,
 {
     int err;
 
-    SPC_RECORD(OMPI_SPC_ALLGATHER, 1);
+    SPC_CALL_TIMER(OMPI_SPC_ALLGATHER);
 
     MEMCHECKER(
         int rank;
@@ -122,9 +123,11 @@ int MPI_Allgather(const void *sendbuf, int sendcount, MPI_Datatype sendtype,
 
     /* Invoke the coll component to perform the back-end operation */
 
+    mca_coll_base_raise_event (MCA_COLL_BASE_EVENT_BEGIN, comm, ALLGATHER, -1, false);
     err = comm->c_coll->coll_allgather(sendbuf, sendcount, sendtype,
                                       recvbuf, recvcount, recvtype, comm,
                                       comm->c_coll->coll_allgather_module);
+    mca_coll_base_raise_event (MCA_COLL_BASE_EVENT_END, comm, ALLGATHER, -1, false);
     OMPI_ERRHANDLER_RETURN(err, comm, err, FUNC_NAME);
 }
 
@@ -32,6 +32,7 @@
 #include "ompi/errhandler/errhandler.h"
 #include "ompi/datatype/ompi_datatype.h"
 #include "ompi/memchecker.h"
+#include "ompi/mca/coll/base/coll_base_event.h"
 #include "ompi/runtime/ompi_spc.h"
 
 #if OMPI_BUILD_MPI_PROFILING
@@ -50,7 +51,7 @@ int MPI_Allgatherv(const void *sendbuf, int sendcount, MPI_Datatype sendtype,
 {
     int i, size, err;
 
-    SPC_RECORD(OMPI_SPC_ALLGATHERV, 1);
+    SPC_CALL_TIMER(OMPI_SPC_ALLGATHERV);
 
     MEMCHECKER(
         int rank;
@@ -143,10 +144,12 @@ int MPI_Allgatherv(const void *sendbuf, int sendcount, MPI_Datatype sendtype,
     OPAL_CR_ENTER_LIBRARY();
 
     /* Invoke the coll component to perform the back-end operation */
+    mca_coll_base_raise_event (MCA_COLL_BASE_EVENT_BEGIN, comm, ALLGATHERV, -1, false);
     err = comm->c_coll->coll_allgatherv(sendbuf, sendcount, sendtype,
                                        recvbuf, (int *) recvcounts,
                                        (int *) displs, recvtype, comm,
                                        comm->c_coll->coll_allgatherv_module);
+    mca_coll_base_raise_event (MCA_COLL_BASE_EVENT_END, comm, ALLGATHERV, -1, false);
     OMPI_ERRHANDLER_RETURN(err, comm, err, FUNC_NAME);
 }
 
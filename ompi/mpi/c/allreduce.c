@@ -31,6 +31,7 @@
 #include "ompi/datatype/ompi_datatype.h"
 #include "ompi/op/op.h"
 #include "ompi/memchecker.h"
+#include "ompi/mca/coll/base/coll_base_event.h"
 #include "ompi/runtime/ompi_spc.h"
 
 #if OMPI_BUILD_MPI_PROFILING
@@ -48,7 +49,7 @@ int MPI_Allreduce(const void *sendbuf, void *recvbuf, int count,
 {
     int err;
 
-    SPC_RECORD(OMPI_SPC_ALLREDUCE, 1);
+    SPC_CALL_TIMER(OMPI_SPC_ALLREDUCE);
 
     MEMCHECKER(
         memchecker_datatype(datatype);
@@ -110,9 +111,11 @@ int MPI_Allreduce(const void *sendbuf, void *recvbuf, int count,
     /* Invoke the coll component to perform the back-end operation */
 
     OBJ_RETAIN(op);
+    mca_coll_base_raise_event (MCA_COLL_BASE_EVENT_BEGIN, comm, ALLREDUCE, -1, false);
     err = comm->c_coll->coll_allreduce(sendbuf, recvbuf, count,
                                       datatype, op, comm,
                                       comm->c_coll->coll_allreduce_module);
+    mca_coll_base_raise_event (MCA_COLL_BASE_EVENT_END, comm, ALLREDUCE, -1, false);
     OBJ_RELEASE(op);
     OMPI_ERRHANDLER_RETURN(err, comm, err, FUNC_NAME);
 }
@@ -33,6 +33,7 @@
 #include "ompi/errhandler/errhandler.h"
 #include "ompi/datatype/ompi_datatype.h"
 #include "ompi/memchecker.h"
+#include "ompi/mca/coll/base/coll_base_event.h"
 #include "ompi/runtime/ompi_spc.h"
 
 #if OMPI_BUILD_MPI_PROFILING
@@ -52,7 +53,7 @@ int MPI_Alltoall(const void *sendbuf, int sendcount, MPI_Datatype sendtype,
     int err;
     size_t recvtype_size;
 
-    SPC_RECORD(OMPI_SPC_ALLTOALL, 1);
+    SPC_CALL_TIMER(OMPI_SPC_ALLTOALL);
 
     MEMCHECKER(
         memchecker_comm(comm);
@@ -107,9 +108,11 @@ int MPI_Alltoall(const void *sendbuf, int sendcount, MPI_Datatype sendtype,
     OPAL_CR_ENTER_LIBRARY();
 
     /* Invoke the coll component to perform the back-end operation */
+    mca_coll_base_raise_event (MCA_COLL_BASE_EVENT_BEGIN, comm, ALLTOALL, -1, false);
     err = comm->c_coll->coll_alltoall(sendbuf, sendcount, sendtype,
                                      recvbuf, recvcount, recvtype,
                                      comm, comm->c_coll->coll_alltoall_module);
+    mca_coll_base_raise_event (MCA_COLL_BASE_EVENT_END, comm, ALLTOALL, -1, false);
     OMPI_ERRHANDLER_RETURN(err, comm, err, FUNC_NAME);
 }
 
@@ -31,6 +31,7 @@
 #include "ompi/errhandler/errhandler.h"
 #include "ompi/datatype/ompi_datatype.h"
 #include "ompi/memchecker.h"
+#include "ompi/mca/coll/base/coll_base_event.h"
 #include "ompi/runtime/ompi_spc.h"
 
 #if OMPI_BUILD_MPI_PROFILING
@@ -50,7 +51,7 @@ int MPI_Alltoallw(const void *sendbuf, const int sendcounts[],
 {
     int i, size, err;
 
-    SPC_RECORD(OMPI_SPC_ALLTOALLW, 1);
+    SPC_CALL_TIMER(OMPI_SPC_ALLTOALLW);
 
     MEMCHECKER(
         memchecker_comm(comm);
@@ -116,9 +117,11 @@ int MPI_Alltoallw(const void *sendbuf, const int sendcounts[],
     OPAL_CR_ENTER_LIBRARY();
 
     /* Invoke the coll component to perform the back-end operation */
+    mca_coll_base_raise_event (MCA_COLL_BASE_EVENT_BEGIN, comm, ALLTOALLW, -1, false);
     err = comm->c_coll->coll_alltoallw(sendbuf, sendcounts, sdispls, (ompi_datatype_t **) sendtypes,
                                       recvbuf, recvcounts, rdispls, (ompi_datatype_t **) recvtypes,
                                       comm, comm->c_coll->coll_alltoallw_module);
+    mca_coll_base_raise_event (MCA_COLL_BASE_EVENT_END, comm, ALLTOALLW, -1, false);
     OMPI_ERRHANDLER_RETURN(err, comm, err, FUNC_NAME);
 }
 
@@ -25,6 +25,7 @@
 #include "ompi/communicator/communicator.h"
 #include "ompi/errhandler/errhandler.h"
 #include "ompi/memchecker.h"
+#include "ompi/mca/coll/base/coll_base_event.h"
 #include "ompi/runtime/ompi_spc.h"
 
 #if OMPI_BUILD_MPI_PROFILING
@@ -41,7 +42,7 @@ int MPI_Barrier(MPI_Comm comm)
 {
   int err = MPI_SUCCESS;
 
-  SPC_RECORD(OMPI_SPC_BARRIER, 1);
+  SPC_CALL_TIMER(OMPI_SPC_BARRIER);
 
   MEMCHECKER(
     memchecker_comm(comm);
@@ -63,7 +64,9 @@ int MPI_Barrier(MPI_Comm comm)
 
   if (OMPI_COMM_IS_INTRA(comm)) {
     if (ompi_comm_size(comm) > 1) {
+      mca_coll_base_raise_event (MCA_COLL_BASE_EVENT_BEGIN, comm, BARRIER, -1, false);
       err = comm->c_coll->coll_barrier(comm, comm->c_coll->coll_barrier_module);
+      mca_coll_base_raise_event (MCA_COLL_BASE_EVENT_END, comm, BARRIER, -1, false);
     }
   }
 
@@ -71,7 +74,9 @@ int MPI_Barrier(MPI_Comm comm)
      there's always at least 2 processes in an intercommunicator. */
 
   else {
+      mca_coll_base_raise_event (MCA_COLL_BASE_EVENT_BEGIN, comm, BARRIER, -1, false);
       err = comm->c_coll->coll_barrier(comm, comm->c_coll->coll_barrier_module);
+      mca_coll_base_raise_event (MCA_COLL_BASE_EVENT_END, comm, BARRIER, -1, false);
   }
 
   /* All done */
@@ -26,6 +26,7 @@
 #include "ompi/errhandler/errhandler.h"
 #include "ompi/datatype/ompi_datatype.h"
 #include "ompi/memchecker.h"
+#include "ompi/mca/coll/base/coll_base_event.h"
 #include "ompi/runtime/ompi_spc.h"
 
 #if OMPI_BUILD_MPI_PROFILING
@@ -43,7 +44,7 @@ int MPI_Bcast(void *buffer, int count, MPI_Datatype datatype,
 {
     int err;
 
-    SPC_RECORD(OMPI_SPC_BCAST, 1);
+    SPC_CALL_TIMER(OMPI_SPC_BCAST);
 
     MEMCHECKER(
         memchecker_datatype(datatype);
@@ -112,7 +113,9 @@ int MPI_Bcast(void *buffer, int count, MPI_Datatype datatype,
 
     /* Invoke the coll component to perform the back-end operation */
 
+    mca_coll_base_raise_event (MCA_COLL_BASE_EVENT_BEGIN, comm, BCAST, root, false);
     err = comm->c_coll->coll_bcast(buffer, count, datatype, root, comm,
                                   comm->c_coll->coll_bcast_module);
+    mca_coll_base_raise_event (MCA_COLL_BASE_EVENT_END, comm, BCAST, root, false);
     OMPI_ERRHANDLER_RETURN(err, comm, err, FUNC_NAME);
 }
@@ -44,7 +44,7 @@ int MPI_Cancel(MPI_Request *request)
 {
     int rc;
 
-    SPC_RECORD(OMPI_SPC_CANCEL, 1);
+    SPC_CALL_TIMER(OMPI_SPC_CANCEL);
 
     MEMCHECKER(
         memchecker_request(request);
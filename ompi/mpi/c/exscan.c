@@ -30,6 +30,7 @@
 #include "ompi/datatype/ompi_datatype.h"
 #include "ompi/op/op.h"
 #include "ompi/memchecker.h"
+#include "ompi/mca/coll/base/coll_base_event.h"
 #include "ompi/runtime/ompi_spc.h"
 
 #if OMPI_BUILD_MPI_PROFILING
@@ -47,7 +48,7 @@ int MPI_Exscan(const void *sendbuf, void *recvbuf, int count,
 {
     int err;
 
-    SPC_RECORD(OMPI_SPC_EXSCAN, 1);
+    SPC_CALL_TIMER(OMPI_SPC_EXSCAN);
 
     MEMCHECKER(
         memchecker_datatype(datatype);
@@ -96,9 +97,11 @@ int MPI_Exscan(const void *sendbuf, void *recvbuf, int count,
     /* Invoke the coll component to perform the back-end operation */
 
     OBJ_RETAIN(op);
+    mca_coll_base_raise_event (MCA_COLL_BASE_EVENT_BEGIN, comm, EXSCAN, -1, false);
     err = comm->c_coll->coll_exscan(sendbuf, recvbuf, count,
                                    datatype, op, comm,
                                    comm->c_coll->coll_exscan_module);
+    mca_coll_base_raise_event (MCA_COLL_BASE_EVENT_END, comm, EXSCAN, -1, false);
     OBJ_RELEASE(op);
     OMPI_ERRHANDLER_RETURN(err, comm, err, FUNC_NAME);
 }
@@ -30,6 +30,7 @@
 #include "ompi/errhandler/errhandler.h"
 #include "ompi/datatype/ompi_datatype.h"
 #include "ompi/memchecker.h"
+#include "ompi/mca/coll/base/coll_base_event.h"
 #include "ompi/runtime/ompi_spc.h"
 
 #if OMPI_BUILD_MPI_PROFILING
@@ -48,7 +49,7 @@ int MPI_Gatherv(const void *sendbuf, int sendcount, MPI_Datatype sendtype,
 {
     int i, size, err;
 
-    SPC_RECORD(OMPI_SPC_GATHERV, 1);
+    SPC_CALL_TIMER(OMPI_SPC_GATHERV);
 
     MEMCHECKER(
         ptrdiff_t ext;
@@ -193,9 +194,11 @@ int MPI_Gatherv(const void *sendbuf, int sendcount, MPI_Datatype sendtype,
     OPAL_CR_ENTER_LIBRARY();
 
     /* Invoke the coll component to perform the back-end operation */
+    mca_coll_base_raise_event (MCA_COLL_BASE_EVENT_BEGIN, comm, GATHERV, root, false);
     err = comm->c_coll->coll_gatherv(sendbuf, sendcount, sendtype, recvbuf,
                                     recvcounts, displs,
                                     recvtype, root, comm,
                                     comm->c_coll->coll_gatherv_module);
+    mca_coll_base_raise_event (MCA_COLL_BASE_EVENT_END, comm, GATHERV, root, false);
     OMPI_ERRHANDLER_RETURN(err, comm, err, FUNC_NAME);
 }
@@ -32,6 +32,7 @@
 #include "ompi/datatype/ompi_datatype.h"
 #include "ompi/mca/coll/base/coll_base_util.h"
 #include "ompi/memchecker.h"
+#include "ompi/mca/coll/base/coll_base_event.h"
 #include "ompi/runtime/ompi_spc.h"
 
 #if OMPI_BUILD_MPI_PROFILING
@@ -51,7 +52,7 @@ int MPI_Ialltoallv(const void *sendbuf, const int sendcounts[], const int sdispl
 {
     int i, size, err;
 
-    SPC_RECORD(OMPI_SPC_IALLTOALLV, 1);
+    SPC_CALL_TIMER(OMPI_SPC_IALLTOALLV);
 
     MEMCHECKER(
         ptrdiff_t recv_ext;
@@ -128,9 +129,11 @@ int MPI_Ialltoallv(const void *sendbuf, const int sendcounts[], const int sdispl
     OPAL_CR_ENTER_LIBRARY();
 
     /* Invoke the coll component to perform the back-end operation */
+    mca_coll_base_raise_event (MCA_COLL_BASE_EVENT_BEGIN, comm, ALLTOALLV, -1, true);
     err = comm->c_coll->coll_ialltoallv(sendbuf, sendcounts, sdispls,
                                        sendtype, recvbuf, recvcounts, rdispls,
                                        recvtype, comm, request, comm->c_coll->coll_ialltoallv_module);
+    mca_coll_base_raise_event (MCA_COLL_BASE_EVENT_END, comm, ALLTOALLV, -1, true);
     if (OPAL_LIKELY(OMPI_SUCCESS == err)) {
         ompi_coll_base_retain_datatypes(*request, (MPI_IN_PLACE==sendbuf)?NULL:sendtype, recvtype);
     }
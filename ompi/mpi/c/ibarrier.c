@@ -27,6 +27,7 @@
 #include "ompi/errhandler/errhandler.h"
 #include "ompi/datatype/ompi_datatype.h"
 #include "ompi/memchecker.h"
+#include "ompi/mca/coll/base/coll_base_event.h"
 #include "ompi/runtime/ompi_spc.h"
 
 #if OMPI_BUILD_MPI_PROFILING
@@ -43,7 +44,7 @@ int MPI_Ibarrier(MPI_Comm comm, MPI_Request *request)
 {
     int err = MPI_SUCCESS;
 
-    SPC_RECORD(OMPI_SPC_IBARRIER, 1);
+    SPC_CALL_TIMER(OMPI_SPC_IBARRIER);
 
     MEMCHECKER(
             memchecker_comm(comm);
@@ -60,7 +61,9 @@ int MPI_Ibarrier(MPI_Comm comm, MPI_Request *request)
 
     OPAL_CR_ENTER_LIBRARY();
 
+    mca_coll_base_raise_event (MCA_COLL_BASE_EVENT_BEGIN, comm, BARRIER, -1, true);
     err = comm->c_coll->coll_ibarrier(comm, request, comm->c_coll->coll_ibarrier_module);
+    mca_coll_base_raise_event (MCA_COLL_BASE_EVENT_END, comm, BARRIER, -1, true);
 
     /* All done */
 
@@ -21,6 +21,7 @@
 #include "ompi/datatype/ompi_datatype.h"
 #include "ompi/mca/coll/base/coll_base_util.h"
 #include "ompi/memchecker.h"
+#include "ompi/mca/coll/base/coll_base_event.h"
 #include "ompi/runtime/ompi_spc.h"
 
 #if OMPI_BUILD_MPI_PROFILING
@@ -38,7 +39,7 @@ int MPI_Ibcast(void *buffer, int count, MPI_Datatype datatype,
 {
     int err;
 
-    SPC_RECORD(OMPI_SPC_IBCAST, 1);
+    SPC_CALL_TIMER(OMPI_SPC_IBCAST);
 
     MEMCHECKER(
         memchecker_datatype(datatype);
@@ -100,9 +101,11 @@ int MPI_Ibcast(void *buffer, int count, MPI_Datatype datatype,
 
     /* Invoke the coll component to perform the back-end operation */
 
+    mca_coll_base_raise_event (MCA_COLL_BASE_EVENT_BEGIN, comm, BCAST, root, true);
     err = comm->c_coll->coll_ibcast(buffer, count, datatype, root, comm,
                                   request,
                                   comm->c_coll->coll_ibcast_module);
+    mca_coll_base_raise_event (MCA_COLL_BASE_EVENT_END, comm, BCAST, root, true);
     if (OPAL_LIKELY(OMPI_SUCCESS == err)) {
         if (!OMPI_COMM_IS_INTRA(comm)) {
             if (MPI_PROC_NULL == root) {
@@ -31,6 +31,7 @@
 #include "ompi/op/op.h"
 #include "ompi/mca/coll/base/coll_base_util.h"
 #include "ompi/memchecker.h"
+#include "ompi/mca/coll/base/coll_base_event.h"
 #include "ompi/runtime/ompi_spc.h"
 
 #if OMPI_BUILD_MPI_PROFILING
@@ -48,7 +49,7 @@ int MPI_Iexscan(const void *sendbuf, void *recvbuf, int count,
 {
     int err;
 
-    SPC_RECORD(OMPI_SPC_IEXSCAN, 1);
+    SPC_CALL_TIMER(OMPI_SPC_IEXSCAN);
 
     MEMCHECKER(
         memchecker_datatype(datatype);
@@ -88,9 +89,11 @@ int MPI_Iexscan(const void *sendbuf, void *recvbuf, int count,
 
     /* Invoke the coll component to perform the back-end operation */
 
+    mca_coll_base_raise_event (MCA_COLL_BASE_EVENT_BEGIN, comm, EXSCAN, -1, true);
     err = comm->c_coll->coll_iexscan(sendbuf, recvbuf, count,
                                     datatype, op, comm, request,
                                     comm->c_coll->coll_iexscan_module);
+    mca_coll_base_raise_event (MCA_COLL_BASE_EVENT_END, comm, EXSCAN, -1, true);
     if (OPAL_LIKELY(OMPI_SUCCESS == err)) {
         ompi_coll_base_retain_op(*request, op, datatype);
     }
@@ -36,6 +36,7 @@
 #include "ompi/memchecker.h"
 #include "ompi/mca/topo/topo.h"
 #include "ompi/mca/topo/base/base.h"
+#include "ompi/mca/coll/base/coll_base_event.h"
 #include "ompi/runtime/ompi_spc.h"
 
 #if OMPI_BUILD_MPI_PROFILING
@@ -54,7 +55,7 @@ int MPI_Ineighbor_allgather(const void *sendbuf, int sendcount, MPI_Datatype sen
 {
     int err;
 
-    SPC_RECORD(OMPI_SPC_INEIGHBOR_ALLGATHER, 1);
+    SPC_CALL_TIMER(OMPI_SPC_INEIGHBOR_ALLGATHER);
 
     MEMCHECKER(
         ptrdiff_t ext;
@@ -120,9 +121,11 @@ int MPI_Ineighbor_allgather(const void *sendbuf, int sendcount, MPI_Datatype sen
     OPAL_CR_ENTER_LIBRARY();
 
     /* Invoke the coll component to perform the back-end operation */
+    mca_coll_base_raise_event (MCA_COLL_BASE_EVENT_BEGIN, comm, NEIGHBOR_ALLGATHER, -1, true);
     err = comm->c_coll->coll_ineighbor_allgather(sendbuf, sendcount, sendtype, recvbuf,
                                                 recvcount, recvtype, comm, request,
                                                 comm->c_coll->coll_ineighbor_allgather_module);
+    mca_coll_base_raise_event (MCA_COLL_BASE_EVENT_END, comm, NEIGHBOR_ALLGATHER, -1, true);
     if (OPAL_LIKELY(OMPI_SUCCESS == err)) {
         ompi_coll_base_retain_datatypes(*request, sendtype, recvtype);
     }
@@ -35,6 +35,7 @@
 #include "ompi/memchecker.h"
 #include "ompi/mca/topo/topo.h"
 #include "ompi/mca/topo/base/base.h"
+#include "ompi/mca/coll/base/coll_base_event.h"
 #include "ompi/runtime/ompi_spc.h"
 
 #if OMPI_BUILD_MPI_PROFILING
@@ -55,7 +56,7 @@ int MPI_Ineighbor_alltoallw(const void *sendbuf, const int sendcounts[], const M
     int i, err;
     int indegree, outdegree;
 
-    SPC_RECORD(OMPI_SPC_INEIGHBOR_ALLTOALLW, 1);
+    SPC_CALL_TIMER(OMPI_SPC_INEIGHBOR_ALLTOALLW);
 
     MEMCHECKER(
         ptrdiff_t recv_ext;
@@ -144,9 +145,11 @@ int MPI_Ineighbor_alltoallw(const void *sendbuf, const int sendcounts[], const M
     OPAL_CR_ENTER_LIBRARY();
 
     /* Invoke the coll component to perform the back-end operation */
+    mca_coll_base_raise_event (MCA_COLL_BASE_EVENT_BEGIN, comm, NEIGHBOR_ALLTOALLW, -1, true);
     err = comm->c_coll->coll_ineighbor_alltoallw(sendbuf, sendcounts, sdispls, sendtypes,
                                                 recvbuf, recvcounts, rdispls, recvtypes, comm, request,
                                                 comm->c_coll->coll_ineighbor_alltoallw_module);
+    mca_coll_base_raise_event (MCA_COLL_BASE_EVENT_END, comm, NEIGHBOR_ALLTOALLW, -1, true);
     if (OPAL_LIKELY(OMPI_SUCCESS == err)) {
         ompi_coll_base_retain_datatypes_w(*request, sendtypes, recvtypes);
     }
@@ -43,7 +43,7 @@ int MPI_Iprobe(int source, int tag, MPI_Comm comm, int *flag, MPI_Status *status
 {
     int rc;
 
-    SPC_RECORD(OMPI_SPC_IPROBE, 1);
+    SPC_CALL_TIMER(OMPI_SPC_IPROBE);
 
     MEMCHECKER(
         memchecker_comm(comm);
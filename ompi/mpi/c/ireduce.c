@@ -33,6 +33,7 @@
 #include "ompi/op/op.h"
 #include "ompi/mca/coll/base/coll_base_util.h"
 #include "ompi/memchecker.h"
+#include "ompi/mca/coll/base/coll_base_event.h"
 #include "ompi/runtime/ompi_spc.h"
 
 #if OMPI_BUILD_MPI_PROFILING
@@ -50,7 +51,7 @@ int MPI_Ireduce(const void *sendbuf, void *recvbuf, int count,
 {
     int err;
 
-    SPC_RECORD(OMPI_SPC_IREDUCE, 1);
+    SPC_CALL_TIMER(OMPI_SPC_IREDUCE);
 
     MEMCHECKER(
         memchecker_datatype(datatype);
@@ -137,9 +138,11 @@ int MPI_Ireduce(const void *sendbuf, void *recvbuf, int count,
     OPAL_CR_ENTER_LIBRARY();
 
     /* Invoke the coll component to perform the back-end operation */
+    mca_coll_base_raise_event (MCA_COLL_BASE_EVENT_BEGIN, comm, REDUCE, root, true);
     err = comm->c_coll->coll_ireduce(sendbuf, recvbuf, count,
                                     datatype, op, root, comm, request,
                                     comm->c_coll->coll_ireduce_module);
+    mca_coll_base_raise_event (MCA_COLL_BASE_EVENT_END, comm, REDUCE, root, true);
     if (OPAL_LIKELY(OMPI_SUCCESS == err)) {
         ompi_coll_base_retain_op(*request, op, datatype);
     }
@@ -33,6 +33,7 @@
 #include "ompi/op/op.h"
 #include "ompi/mca/coll/base/coll_base_util.h"
 #include "ompi/memchecker.h"
+#include "ompi/mca/coll/base/coll_base_event.h"
 #include "ompi/runtime/ompi_spc.h"
 
 #if OMPI_BUILD_MPI_PROFILING
@@ -50,7 +51,7 @@ int MPI_Ireduce_scatter(const void *sendbuf, void *recvbuf, const int recvcounts
 {
     int i, err, size, count;
 
-    SPC_RECORD(OMPI_SPC_IREDUCE_SCATTER, 1);
+    SPC_CALL_TIMER(OMPI_SPC_IREDUCE_SCATTER);
 
     MEMCHECKER(
         int rank;
@@ -134,9 +135,11 @@ int MPI_Ireduce_scatter(const void *sendbuf, void *recvbuf, const int recvcounts
 
     /* Invoke the coll component to perform the back-end operation */
 
+    mca_coll_base_raise_event (MCA_COLL_BASE_EVENT_BEGIN, comm, REDUCESCATTER, -1, true);
     err = comm->c_coll->coll_ireduce_scatter(sendbuf, recvbuf, recvcounts,
                                             datatype, op, comm, request,
                                             comm->c_coll->coll_ireduce_scatter_module);
+    mca_coll_base_raise_event (MCA_COLL_BASE_EVENT_END, comm, REDUCESCATTER, -1, true);
     if (OPAL_LIKELY(OMPI_SUCCESS == err)) {
         ompi_coll_base_retain_op(*request, op, datatype);
     }
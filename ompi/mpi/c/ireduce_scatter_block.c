@@ -33,6 +33,7 @@
 #include "ompi/op/op.h"
 #include "ompi/mca/coll/base/coll_base_util.h"
 #include "ompi/memchecker.h"
+#include "ompi/mca/coll/base/coll_base_event.h"
 #include "ompi/runtime/ompi_spc.h"
 
 #if OMPI_BUILD_MPI_PROFILING
@@ -51,7 +52,7 @@ int MPI_Ireduce_scatter_block(const void *sendbuf, void *recvbuf, int recvcount,
 {
     int err;
 
-    SPC_RECORD(OMPI_SPC_IREDUCE_SCATTER_BLOCK, 1);
+    SPC_CALL_TIMER(OMPI_SPC_IREDUCE_SCATTER_BLOCK);
 
     MEMCHECKER(
         memchecker_comm(comm);
@@ -101,9 +102,11 @@ int MPI_Ireduce_scatter_block(const void *sendbuf, void *recvbuf, int recvcount,
 
     /* Invoke the coll component to perform the back-end operation */
 
+    mca_coll_base_raise_event (MCA_COLL_BASE_EVENT_BEGIN, comm, REDUCESCATTERBLOCK, -1, true);
     err = comm->c_coll->coll_ireduce_scatter_block(sendbuf, recvbuf, recvcount,
                                                   datatype, op, comm, request,
                                                   comm->c_coll->coll_ireduce_scatter_block_module);
+    mca_coll_base_raise_event (MCA_COLL_BASE_EVENT_END, comm, REDUCESCATTERBLOCK, -1, true);
     if (OPAL_LIKELY(OMPI_SUCCESS == err)) {
         ompi_coll_base_retain_op(*request, op, datatype);
     }
@@ -32,6 +32,7 @@
 #include "ompi/op/op.h"
 #include "ompi/mca/coll/base/coll_base_util.h"
 #include "ompi/memchecker.h"
+#include "ompi/mca/coll/base/coll_base_event.h"
 #include "ompi/runtime/ompi_spc.h"
 
 #if OMPI_BUILD_MPI_PROFILING
@@ -49,7 +50,7 @@ int MPI_Iscan(const void *sendbuf, void *recvbuf, int count,
 {
     int err;
 
-    SPC_RECORD(OMPI_SPC_ISCAN, 1);
+    SPC_CALL_TIMER(OMPI_SPC_ISCAN);
 
     MEMCHECKER(
         memchecker_datatype(datatype);
@@ -97,10 +98,12 @@ int MPI_Iscan(const void *sendbuf, void *recvbuf, int count,
 
     /* Call the coll component to actually perform the allgather */
 
+    mca_coll_base_raise_event (MCA_COLL_BASE_EVENT_BEGIN, comm, SCAN, -1, true);
     err = comm->c_coll->coll_iscan(sendbuf, recvbuf, count,
                                   datatype, op, comm,
                                   request,
                                   comm->c_coll->coll_iscan_module);
+    mca_coll_base_raise_event (MCA_COLL_BASE_EVENT_END, comm, SCAN, -1, true);
     if (OPAL_LIKELY(OMPI_SUCCESS == err)) {
         ompi_coll_base_retain_op(*request, op, datatype);
     }
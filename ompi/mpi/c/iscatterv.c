@@ -31,6 +31,7 @@
 #include "ompi/datatype/ompi_datatype.h"
 #include "ompi/mca/coll/base/coll_base_util.h"
 #include "ompi/memchecker.h"
+#include "ompi/mca/coll/base/coll_base_event.h"
 #include "ompi/runtime/ompi_spc.h"
 
 #if OMPI_BUILD_MPI_PROFILING
@@ -49,7 +50,7 @@ int MPI_Iscatterv(const void *sendbuf, const int sendcounts[], const int displs[
 {
     int i, size, err;
 
-    SPC_RECORD(OMPI_SPC_ISCATTERV, 1);
+    SPC_CALL_TIMER(OMPI_SPC_ISCATTERV);
 
     MEMCHECKER(
         ptrdiff_t ext;
@@ -194,9 +195,11 @@ int MPI_Iscatterv(const void *sendbuf, const int sendcounts[], const int displs[
     OPAL_CR_ENTER_LIBRARY();
 
     /* Invoke the coll component to perform the back-end operation */
+    mca_coll_base_raise_event (MCA_COLL_BASE_EVENT_BEGIN, comm, SCATTERV, root, true);
     err = comm->c_coll->coll_iscatterv(sendbuf, sendcounts, displs,
                                       sendtype, recvbuf, recvcount, recvtype, root, comm,
                                       request, comm->c_coll->coll_iscatterv_module);
+    mca_coll_base_raise_event (MCA_COLL_BASE_EVENT_END, comm, SCATTERV, root, true);
     if (OPAL_LIKELY(OMPI_SUCCESS == err)) {
         if (OMPI_COMM_IS_INTRA(comm)) {
             if (MPI_IN_PLACE == recvbuf) {
@@ -47,7 +47,7 @@ int MPI_Issend(const void *buf, int count, MPI_Datatype type, int dest,
 {
     int rc = MPI_SUCCESS;
 
-    SPC_RECORD(OMPI_SPC_ISSEND, 1);
+    SPC_CALL_TIMER(OMPI_SPC_ISSEND);
 
     MEMCHECKER(
         memchecker_datatype(type);
@@ -34,6 +34,7 @@
 #include "ompi/memchecker.h"
 #include "ompi/mca/topo/topo.h"
 #include "ompi/mca/topo/base/base.h"
+#include "ompi/mca/coll/base/coll_base_event.h"
 #include "ompi/runtime/ompi_spc.h"
 
 #if OMPI_BUILD_MPI_PROFILING
@@ -54,7 +55,7 @@ int MPI_Neighbor_alltoallv(const void *sendbuf, const int sendcounts[], const in
     int i, err;
     int indegree, outdegree;
 
-    SPC_RECORD(OMPI_SPC_NEIGHBOR_ALLTOALLV, 1);
+    SPC_CALL_TIMER(OMPI_SPC_NEIGHBOR_ALLTOALLV);
 
     MEMCHECKER(
         ptrdiff_t recv_ext;
@@ -145,9 +146,11 @@ int MPI_Neighbor_alltoallv(const void *sendbuf, const int sendcounts[], const in
     OPAL_CR_ENTER_LIBRARY();
 
     /* Invoke the coll component to perform the back-end operation */
+    mca_coll_base_raise_event (MCA_COLL_BASE_EVENT_BEGIN, comm, NEIGHBOR_ALLTOALLV, -1, false);
     err = comm->c_coll->coll_neighbor_alltoallv(sendbuf, sendcounts, sdispls, sendtype,
                                                recvbuf, recvcounts, rdispls, recvtype,
                                                comm, comm->c_coll->coll_neighbor_alltoallv_module);
+    mca_coll_base_raise_event (MCA_COLL_BASE_EVENT_END, comm, NEIGHBOR_ALLTOALLV, -1, false);
     OMPI_ERRHANDLER_RETURN(err, comm, err, FUNC_NAME);
 }
 
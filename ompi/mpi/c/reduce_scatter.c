@@ -31,6 +31,7 @@
 #include "ompi/datatype/ompi_datatype.h"
 #include "ompi/op/op.h"
 #include "ompi/memchecker.h"
+#include "ompi/mca/coll/base/coll_base_event.h"
 #include "ompi/runtime/ompi_spc.h"
 
 #if OMPI_BUILD_MPI_PROFILING
@@ -48,7 +49,7 @@ int MPI_Reduce_scatter(const void *sendbuf, void *recvbuf, const int recvcounts[
 {
     int i, err, size, count;
 
-    SPC_RECORD(OMPI_SPC_REDUCE_SCATTER, 1);
+    SPC_CALL_TIMER(OMPI_SPC_REDUCE_SCATTER);
 
     MEMCHECKER(
         int rank;
@@ -131,9 +132,11 @@ int MPI_Reduce_scatter(const void *sendbuf, void *recvbuf, const int recvcounts[
     /* Invoke the coll component to perform the back-end operation */
 
     OBJ_RETAIN(op);
+    mca_coll_base_raise_event (MCA_COLL_BASE_EVENT_BEGIN, comm, REDUCESCATTER, -1, false);
     err = comm->c_coll->coll_reduce_scatter(sendbuf, recvbuf, recvcounts,
                                            datatype, op, comm,
                                            comm->c_coll->coll_reduce_scatter_module);
+    mca_coll_base_raise_event (MCA_COLL_BASE_EVENT_END, comm, REDUCESCATTER, -1, false);
     OBJ_RELEASE(op);
     OMPI_ERRHANDLER_RETURN(err, comm, err, FUNC_NAME);
 }
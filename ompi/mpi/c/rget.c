@@ -49,7 +49,7 @@ int MPI_Rget(void *origin_addr, int origin_count,
 {
     int rc;
 
-    SPC_RECORD(OMPI_SPC_RGET, 1);
+    SPC_CALL_TIMER(OMPI_SPC_RGET);
 
     if (MPI_PARAM_CHECK) {
         rc = OMPI_SUCCESS;
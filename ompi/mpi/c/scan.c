@@ -31,6 +31,7 @@
 #include "ompi/datatype/ompi_datatype.h"
 #include "ompi/op/op.h"
 #include "ompi/memchecker.h"
+#include "ompi/mca/coll/base/coll_base_event.h"
 #include "ompi/runtime/ompi_spc.h"
 
 #if OMPI_BUILD_MPI_PROFILING
@@ -48,7 +49,7 @@ int MPI_Scan(const void *sendbuf, void *recvbuf, int count,
 {
     int err;
 
-    SPC_RECORD(OMPI_SPC_SCAN, 1);
+    SPC_CALL_TIMER(OMPI_SPC_SCAN);
 
     MEMCHECKER(
         memchecker_datatype(datatype);
@@ -105,9 +106,11 @@ int MPI_Scan(const void *sendbuf, void *recvbuf, int count,
     /* Call the coll component to actually perform the allgather */
 
     OBJ_RETAIN(op);
+    mca_coll_base_raise_event (MCA_COLL_BASE_EVENT_BEGIN, comm, SCAN, -1, false);
     err = comm->c_coll->coll_scan(sendbuf, recvbuf, count,
                                  datatype, op, comm,
                                  comm->c_coll->coll_scan_module);
+    mca_coll_base_raise_event (MCA_COLL_BASE_EVENT_END, comm, SCAN, -1, false);
     OBJ_RELEASE(op);
     OMPI_ERRHANDLER_RETURN(err, comm, err, FUNC_NAME);
 }
@@ -32,6 +32,7 @@
 #include "ompi/errhandler/errhandler.h"
 #include "ompi/datatype/ompi_datatype.h"
 #include "ompi/memchecker.h"
+#include "ompi/mca/coll/base/coll_base_event.h"
 #include "ompi/runtime/ompi_spc.h"
 
 #if OMPI_BUILD_MPI_PROFILING
@@ -50,7 +51,7 @@ int MPI_Scatter(const void *sendbuf, int sendcount, MPI_Datatype sendtype,
 {
     int err;
 
-    SPC_RECORD(OMPI_SPC_SCATTER, 1);
+    SPC_CALL_TIMER(OMPI_SPC_SCATTER);
 
     MEMCHECKER(
         memchecker_comm(comm);
@@ -164,8 +165,10 @@ int MPI_Scatter(const void *sendbuf, int sendcount, MPI_Datatype sendtype,
     OPAL_CR_ENTER_LIBRARY();
 
     /* Invoke the coll component to perform the back-end operation */
+    mca_coll_base_raise_event (MCA_COLL_BASE_EVENT_BEGIN, comm, SCATTER, root, false);
     err = comm->c_coll->coll_scatter(sendbuf, sendcount, sendtype, recvbuf,
                                     recvcount, recvtype, root, comm,
                                     comm->c_coll->coll_scatter_module);
+    mca_coll_base_raise_event (MCA_COLL_BASE_EVENT_END, comm, SCATTER, root, false);
     OMPI_ERRHANDLER_RETURN(err, comm, err, FUNC_NAME);
 }
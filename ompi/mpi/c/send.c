@@ -47,7 +47,7 @@ int MPI_Send(const void *buf, int count, MPI_Datatype type, int dest,
 {
     int rc = MPI_SUCCESS;
 
-    SPC_RECORD(OMPI_SPC_SEND, 1);
+    SPC_CALL_TIMER(OMPI_SPC_SEND);
 
     MEMCHECKER(
         memchecker_datatype(type);
@@ -46,7 +46,7 @@ int MPI_Ssend(const void *buf, int count, MPI_Datatype type, int dest, int tag,
 {
     int rc = MPI_SUCCESS;
 
-    SPC_RECORD(OMPI_SPC_SSEND, 1);
+    SPC_CALL_TIMER(OMPI_SPC_SSEND);
 
     MEMCHECKER(
         memchecker_datatype(type);
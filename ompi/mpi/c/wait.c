@@ -41,7 +41,7 @@ static const char FUNC_NAME[] = "MPI_Wait";
 
 int MPI_Wait(MPI_Request *request, MPI_Status *status)
 {
-    SPC_RECORD(OMPI_SPC_WAIT, 1);
+    SPC_CALL_TIMER(OMPI_SPC_WAIT);
 
     MEMCHECKER(
         memchecker_request(request);
@@ -63,7 +63,7 @@ double MPI_Wtime(void)
 {
     double wtime;
 
-    SPC_RECORD(OMPI_SPC_WTIME, 1);
+    SPC_CALL_TIMER(OMPI_SPC_WTIME);
 
     /*
      * See https://github.com/open-mpi/ompi/issues/3003 to find out
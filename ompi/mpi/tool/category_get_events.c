@@ -0,0 +1,55 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi/mpi/tool/mpit-internal.h"
+
+#if OPAL_HAVE_WEAK_SYMBOLS && OMPI_PROFILING_DEFINES
+#pragma weak MPI_T_category_get_events = PMPI_T_category_get_events
+#endif
+
+#if OMPI_PROFILING_DEFINES
+#include "ompi/mpi/tool/profile/defines.h"
+#endif
+
+
+int MPI_T_category_get_events(int cat_index, int len, int indices[])
+{
+    const mca_base_var_group_t *group;
+    int rc = MPI_SUCCESS;
+    const int *events;
+    int i, size;
+
+    if (!mpit_is_initialized ()) {
+        return MPI_T_ERR_NOT_INITIALIZED;
+    }
+
+    ompi_mpit_lock ();
+
+    do {
+        rc = mca_base_var_group_get (cat_index, &group);
+        if (0 > rc) {
+            rc = (OPAL_ERR_NOT_FOUND == rc) ? MPI_T_ERR_INVALID_INDEX : MPI_T_ERR_INVALID;
+            break;
+        }
+
+        size = opal_value_array_get_size((opal_value_array_t *) &group->group_events);
+        events = OPAL_VALUE_ARRAY_GET_BASE(&group->group_events, int);
+
+        for (i = 0 ; i < len && i < size ; ++i) {
+            indices[i] = events[i];
+        }
+    } while (0);
+
+    ompi_mpit_unlock ();
+
+    return rc;
+}
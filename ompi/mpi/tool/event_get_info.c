@@ -0,0 +1,86 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi/mpi/tool/mpit-internal.h"
+
+#if OPAL_HAVE_WEAK_SYMBOLS && OMPI_PROFILING_DEFINES
+#pragma weak MPI_T_event_get_info = PMPI_T_event_get_info
+#endif
+
+#if OMPI_PROFILING_DEFINES
+#include "ompi/mpi/tool/profile/defines.h"
+#endif
+
+
+int MPI_T_event_get_info(int event_index, char *name, int *name_len,
+                         int *verbosity, MPI_Datatype array_of_datatypes[],
+                         MPI_Aint array_of_displacements[], int *num_elements,
+                         MPI_T_enum *enumtype, MPI_Info *info, char *desc,
+                         int *desc_len, int *bind)
+{
+    const mca_base_event_t *event;
+    int ret, max_elements;
+
+    if (!mpit_is_initialized ()) {
+        return MPI_T_ERR_NOT_INITIALIZED;
+    }
+
+    ompi_mpit_lock ();
+
+    do {
+        /* Find the event. mca_base_event_get() handles the bounds checking. */
+        ret = mca_base_event_get (event_index, &event);
+        if (OMPI_SUCCESS != ret) {
+            ret = MPI_T_ERR_INVALID_INDEX;
+            break;
+        }
+
+        /* Copy name an description */
+        mpit_copy_string (name, name_len, event->name);
+        mpit_copy_string (desc, desc_len, event->description);
+
+        if (verbosity) {
+            *verbosity = event->verbosity;
+        }
+
+        /* on input num_elements is the length of the arrays, on output the
+           number of elements of the event */
+        if (NULL != num_elements) {
+            max_elements = (NULL == array_of_datatypes && NULL == array_of_displacements) ? 0 : *num_elements;
+
+            for (int i = 0 ; i < max_elements && i < event->num_elements ; ++i) {
+                if (NULL != array_of_datatypes) {
+                    (void) ompit_var_type_to_datatype (event->types[i], array_of_datatypes + i);
+                }
+                if (NULL != array_of_displacements) {
+                    array_of_displacements[i] = (MPI_Aint) event->displacements[i];
+                }
+            }
+
+            *num_elements = event->num_elements;
+        }
+
+        if (NULL != enumtype) {
+            *enumtype = event->enumerator ? (MPI_T_enum) event->enumerator : MPI_T_ENUM_NULL;
+        }
+
+        if (NULL != bind) {
+            *bind = event->bind;
+        }
+
+        ret = ompit_info_get_empty (info);
+    } while (0);
+
+    ompi_mpit_unlock ();
+
+    return ret;
+}
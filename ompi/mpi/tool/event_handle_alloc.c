@@ -0,0 +1,65 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi/mpi/tool/mpit-internal.h"
+
+#if OPAL_HAVE_WEAK_SYMBOLS && OMPI_PROFILING_DEFINES
+#pragma weak MPI_T_event_handle_alloc = PMPI_T_event_handle_alloc
+#endif
+
+#if OMPI_PROFILING_DEFINES
+#include "ompi/mpi/tool/profile/defines.h"
+#endif
+
+
+int MPI_T_event_handle_alloc(int event_index, void *obj_handle, MPI_Info info,
+                             MPI_T_event_registration *event_registration)
+{
+    const mca_base_event_t *event;
+    int ret;
+
+    if (!mpit_is_initialized ()) {
+        return MPI_T_ERR_NOT_INITIALIZED;
+    }
+
+    if (MPI_PARAM_CHECK && NULL == event_registration) {
+        return MPI_T_ERR_INVALID;
+    }
+
+    /* no info key is supported by the events at this time */
+    (void) info;
+
+    ompi_mpit_lock ();
+
+    do {
+        ret = mca_base_event_get (event_index, &event);
+        if (OMPI_SUCCESS != ret) {
+            ret = MPI_T_ERR_INVALID_INDEX;
+            break;
+        }
+
+        /* Check the event binding is something sane */
+        if (event->bind > MPI_T_BIND_MPI_INFO || event->bind < MPI_T_BIND_NO_OBJECT) {
+            ret = MPI_T_ERR_INVALID_INDEX;
+            break;
+        }
+
+        ret = mca_base_event_handle_alloc (event_index, obj_handle, event_registration);
+        if (OPAL_ERR_BAD_PARAM == ret) {
+            ret = MPI_T_ERR_INVALID_HANDLE;
+        }
+    } while (0);
+
+    ompi_mpit_unlock ();
+
+    return ompit_opal_to_mpit_error(ret);
+}
@@ -0,0 +1,44 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi/mpi/tool/mpit-internal.h"
+
+#if OPAL_HAVE_WEAK_SYMBOLS && OMPI_PROFILING_DEFINES
+#pragma weak MPI_T_event_read = PMPI_T_event_read
+#endif
+
+#if OMPI_PROFILING_DEFINES
+#include "ompi/mpi/tool/profile/defines.h"
+#endif
+
+
+int MPI_T_event_read(MPI_T_event_instance event_instance, int element_index, void *buffer)
+{
+    /* called from the event callbacks, do not take the mpit lock */
+    if (!mpit_is_initialized ()) {
+        return MPI_T_ERR_NOT_INITIALIZED;
+    }
+
+    if (MPI_PARAM_CHECK && NULL == event_instance) {
+        return MPI_T_ERR_INVALID;
+    }
+
+    if (MPI_PARAM_CHECK && NULL == buffer) {
+        return MPI_T_ERR_INVALID;
+    }
+
+    if (OPAL_SUCCESS != mca_base_event_read (event_instance, element_index, buffer)) {
+        return MPI_T_ERR_INVALID_INDEX;
+    }
+
+    return MPI_SUCCESS;
+}
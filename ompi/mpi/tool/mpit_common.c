@@ -5,7 +5,7 @@
  * Copyright (c) 2015      Research Organization for Information Science
  *                         and Technology (RIST). All rights reserved.
  * Copyright (c) 2017      IBM Corporation. All rights reserved.
- * Copyright (c) 2020      The University of Tennessee and The University
+ * Copyright (c) 2020-2026 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  * $COPYRIGHT$
@@ -16,6 +16,8 @@
  */
 
 #include "ompi/mpi/tool/mpit-internal.h"
+#include "ompi/info/info.h"
+#include "ompi/runtime/mpiruntime.h"
 
 opal_mutex_t ompi_mpit_big_lock = OPAL_MUTEX_STATIC_INIT;
 
@@ -87,3 +89,23 @@ int ompit_opal_to_mpit_error (int rc)
         return MPI_T_ERR_INVALID;
     }
 }
+
+int ompit_info_get_empty (MPI_Info *info)
+{
+    if (NULL == info) {
+        return MPI_SUCCESS;
+    }
+
+    /* the tools interface does not support any hint yet. info objects can
+     * only be created while MPI is initialized, the tools interface can be
+     * used outside of it. */
+    if (ompi_mpi_state < OMPI_MPI_STATE_INIT_COMPLETED ||
+        ompi_mpi_state >= OMPI_MPI_STATE_FINALIZE_STARTED) {
+        *info = MPI_INFO_NULL;
+        return MPI_SUCCESS;
+    }
+
+    *info = OBJ_NEW(ompi_info_t);
+
+    return (NULL == *info) ? MPI_T_ERR_MEMORY : MPI_SUCCESS;
+}
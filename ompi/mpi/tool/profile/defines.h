@@ -32,9 +32,11 @@
 #define MPI_T_category_changed PMPI_T_category_changed
 #define MPI_T_category_get_categories PMPI_T_category_get_categories
 #define MPI_T_category_get_cvars PMPI_T_category_get_cvars
+#define MPI_T_category_get_events PMPI_T_category_get_events
 #define MPI_T_category_get_info PMPI_T_category_get_info
 #define MPI_T_category_get_index PMPI_T_category_get_index
 #define MPI_T_category_get_num PMPI_T_category_get_num
+#define MPI_T_category_get_num_events PMPI_T_category_get_num_events
 #define MPI_T_category_get_pvars PMPI_T_category_get_pvars
 #define MPI_T_cvar_get_info PMPI_T_cvar_get_info
 #define MPI_T_cvar_get_index PMPI_T_cvar_get_index
@@ -45,6 +47,21 @@
 #define MPI_T_cvar_write PMPI_T_cvar_write
 #define MPI_T_enum_get_info PMPI_T_enum_get_info
 #define MPI_T_enum_get_item PMPI_T_enum_get_item
+#define MPI_T_event_callback_get_info PMPI_T_event_callback_get_info
+#define MPI_T_event_callback_set_info PMPI_T_event_callback_set_info
+#define MPI_T_event_copy PMPI_T_event_copy
+#define MPI_T_event_get_index PMPI_T_event_get_index
+#define MPI_T_event_get_info PMPI_T_event_get_info
+#define MPI_T_event_get_num PMPI_T_event_get_num
+#define MPI_T_event_get_source PMPI_T_event_get_source
+#define MPI_T_event_get_timestamp PMPI_T_event_get_timestamp
+#define MPI_T_event_handle_alloc PMPI_T_event_handle_alloc
+#define MPI_T_event_handle_free PMPI_T_event_handle_free
+#define MPI_T_event_handle_get_info PMPI_T_event_handle_get_info
+#define MPI_T_event_handle_set_info PMPI_T_event_handle_set_info
+#define MPI_T_event_read PMPI_T_event_read
+#define MPI_T_event_register_callback PMPI_T_event_register_callback
+#define MPI_T_event_set_dropped_handler PMPI_T_event_set_dropped_handler
 #define MPI_T_finalize PMPI_T_finalize
 #define MPI_T_init_thread PMPI_T_init_thread
 #define MPI_T_pvar_get_info PMPI_T_pvar_get_info
@@ -60,4 +77,7 @@
 #define MPI_T_pvar_start PMPI_T_pvar_start
 #define MPI_T_pvar_stop PMPI_T_pvar_stop
 #define MPI_T_pvar_write PMPI_T_pvar_write
+#define MPI_T_source_get_info PMPI_T_source_get_info
+#define MPI_T_source_get_num PMPI_T_source_get_num
+#define MPI_T_source_get_timestamp PMPI_T_source_get_timestamp
 #endif /* OMPIT_C_PROFILE_DEFINES_H */
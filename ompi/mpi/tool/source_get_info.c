@@ -0,0 +1,67 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi/mpi/tool/mpit-internal.h"
+
+#if OPAL_HAVE_WEAK_SYMBOLS && OMPI_PROFILING_DEFINES
+#pragma weak MPI_T_source_get_info = PMPI_T_source_get_info
+#endif
+
+#if OMPI_PROFILING_DEFINES
+#include "ompi/mpi/tool/profile/defines.h"
+#endif
+
+
+int MPI_T_source_get_info(int source_index, char *name, int *name_len,
+                          char *desc, int *desc_len, MPI_T_source_order *ordering,
+                          MPI_Count *ticks_per_second, MPI_Count *max_ticks,
+                          MPI_Info *info)
+{
+    const mca_base_event_source_t *source;
+    int ret;
+
+    if (!mpit_is_initialized ()) {
+        return MPI_T_ERR_NOT_INITIALIZED;
+    }
+
+    ompi_mpit_lock ();
+
+    do {
+        ret = mca_base_event_source_get (source_index, &source);
+        if (OMPI_SUCCESS != ret) {
+            ret = MPI_T_ERR_INVALID_INDEX;
+            break;
+        }
+
+        mpit_copy_string (name, name_len, source->name);
+        mpit_copy_string (desc, desc_len, source->description);
+
+        if (NULL != ordering) {
+            *ordering = (MPI_T_source_order) source->ordering;
+        }
+
+        if (NULL != ticks_per_second) {
+            *ticks_per_second = (MPI_Count) source->get_ticks_per_second ();
+        }
+
+        if (NULL != max_ticks) {
+            /* MPI_Count is signed */
+            *max_ticks = (MPI_Count) (source->max_ticks >> 1);
+        }
+
+        ret = ompit_info_get_empty (info);
+    } while (0);
+
+    ompi_mpit_unlock ();
+
+    return ret;
+}
@@ -0,0 +1,45 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "ompi/mpi/tool/mpit-internal.h"
+
+#if OPAL_HAVE_WEAK_SYMBOLS && OMPI_PROFILING_DEFINES
+#pragma weak MPI_T_source_get_timestamp = PMPI_T_source_get_timestamp
+#endif
+
+#if OMPI_PROFILING_DEFINES
+#include "ompi/mpi/tool/profile/defines.h"
+#endif
+
+
+int MPI_T_source_get_timestamp(int source_index, MPI_Count *timestamp)
+{
+    const mca_base_event_source_t *source;
+    int ret;
+
+    if (!mpit_is_initialized ()) {
+        return MPI_T_ERR_NOT_INITIALIZED;
+    }
+
+    if (MPI_PARAM_CHECK && NULL == timestamp) {
+        return MPI_T_ERR_INVALID;
+    }
+
+    ret = mca_base_event_source_get (source_index, &source);
+    if (OMPI_SUCCESS != ret) {
+        return MPI_T_ERR_INVALID_INDEX;
+    }
+
+    *timestamp = (MPI_Count) source->get_time ();
+
+    return MPI_SUCCESS;
+}
@@ -52,7 +52,7 @@ int MPIX_Allgather_init(const void *sendbuf, int sendcount, MPI_Datatype sendtyp
 {
     int err;
 
-    SPC_RECORD(OMPI_SPC_ALLGATHER_INIT, 1);
+    SPC_CALL_TIMER(OMPI_SPC_ALLGATHER_INIT);
 
     MEMCHECKER(
         int rank;
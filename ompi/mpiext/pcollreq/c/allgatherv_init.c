@@ -53,7 +53,7 @@ int MPIX_Allgatherv_init(const void *sendbuf, int sendcount, MPI_Datatype sendty
 {
     int i, size, err;
 
-    SPC_RECORD(OMPI_SPC_ALLGATHERV_INIT, 1);
+    SPC_CALL_TIMER(OMPI_SPC_ALLGATHERV_INIT);
 
     MEMCHECKER(
         int rank;
@@ -53,7 +53,7 @@ int MPIX_Allreduce_init(const void *sendbuf, void *recvbuf, int count,
 {
     int err;
 
-    SPC_RECORD(OMPI_SPC_ALLREDUCE_INIT, 1);
+    SPC_CALL_TIMER(OMPI_SPC_ALLREDUCE_INIT);
 
     MEMCHECKER(
         memchecker_datatype(datatype);
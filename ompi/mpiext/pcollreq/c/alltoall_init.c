@@ -53,7 +53,7 @@ int MPIX_Alltoall_init(const void *sendbuf, int sendcount, MPI_Datatype sendtype
     size_t sendtype_size, recvtype_size;
     int err;
 
-    SPC_RECORD(OMPI_SPC_ALLTOALL_INIT, 1);
+    SPC_CALL_TIMER(OMPI_SPC_ALLTOALL_INIT);
 
     MEMCHECKER(
         memchecker_comm(comm);
@@ -52,7 +52,7 @@ int MPIX_Alltoallw_init(const void *sendbuf, const int sendcounts[], const int s
 {
     int i, size, err;
 
-    SPC_RECORD(OMPI_SPC_ALLTOALLW_INIT, 1);
+    SPC_CALL_TIMER(OMPI_SPC_ALLTOALLW_INIT);
 
     MEMCHECKER(
         ptrdiff_t recv_ext;
@@ -44,7 +44,7 @@ int MPIX_Barrier_init(MPI_Comm comm, MPI_Info info, MPI_Request *request)
 {
     int err = MPI_SUCCESS;
 
-    SPC_RECORD(OMPI_SPC_BARRIER_INIT, 1);
+    SPC_CALL_TIMER(OMPI_SPC_BARRIER_INIT);
 
     MEMCHECKER(
             memchecker_comm(comm);
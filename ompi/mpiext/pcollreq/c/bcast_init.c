@@ -39,7 +39,7 @@ int MPIX_Bcast_init(void *buffer, int count, MPI_Datatype datatype,
 {
     int err;
 
-    SPC_RECORD(OMPI_SPC_BCAST_INIT, 1);
+    SPC_CALL_TIMER(OMPI_SPC_BCAST_INIT);
 
     MEMCHECKER(
         memchecker_datatype(datatype);
@@ -50,7 +50,7 @@ int MPIX_Exscan_init(const void *sendbuf, void *recvbuf, int count,
 {
     int err;
 
-    SPC_RECORD(OMPI_SPC_EXSCAN_INIT, 1);
+    SPC_CALL_TIMER(OMPI_SPC_EXSCAN_INIT);
 
     MEMCHECKER(
         memchecker_datatype(datatype);
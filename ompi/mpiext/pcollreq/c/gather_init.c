@@ -52,7 +52,7 @@ int MPIX_Gather_init(const void *sendbuf, int sendcount, MPI_Datatype sendtype,
 {
     int err;
 
-    SPC_RECORD(OMPI_SPC_GATHER_INIT, 1);
+    SPC_CALL_TIMER(OMPI_SPC_GATHER_INIT);
 
     MEMCHECKER(
         int rank;
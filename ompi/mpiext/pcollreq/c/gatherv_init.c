@@ -51,7 +51,7 @@ int MPIX_Gatherv_init(const void *sendbuf, int sendcount, MPI_Datatype sendtype,
 {
     int i, size, err;
 
-    SPC_RECORD(OMPI_SPC_GATHERV_INIT, 1);
+    SPC_CALL_TIMER(OMPI_SPC_GATHERV_INIT);
 
     MEMCHECKER(
         ptrdiff_t ext;
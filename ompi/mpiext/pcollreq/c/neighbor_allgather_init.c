@@ -55,7 +55,7 @@ int MPIX_Neighbor_allgather_init(const void *sendbuf, int sendcount, MPI_Datatyp
 {
     int err;
 
-    SPC_RECORD(OMPI_SPC_NEIGHBOR_ALLGATHER_INIT, 1);
+    SPC_CALL_TIMER(OMPI_SPC_NEIGHBOR_ALLGATHER_INIT);
 
     MEMCHECKER(
         ptrdiff_t ext;
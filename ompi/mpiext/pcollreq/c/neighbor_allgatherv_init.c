@@ -56,7 +56,7 @@ int MPIX_Neighbor_allgatherv_init(const void *sendbuf, int sendcount, MPI_Dataty
 {
     int i, size, err;
 
-    SPC_RECORD(OMPI_SPC_NEIGHBOR_ALLGATHERV_INIT, 1);
+    SPC_CALL_TIMER(OMPI_SPC_NEIGHBOR_ALLGATHERV_INIT);
 
     MEMCHECKER(
         ptrdiff_t ext;
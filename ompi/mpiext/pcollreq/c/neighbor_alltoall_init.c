@@ -56,7 +56,7 @@ int MPIX_Neighbor_alltoall_init(const void *sendbuf, int sendcount, MPI_Datatype
     size_t sendtype_size, recvtype_size;
     int err;
 
-    SPC_RECORD(OMPI_SPC_NEIGHBOR_ALLTOALL_INIT, 1);
+    SPC_CALL_TIMER(OMPI_SPC_NEIGHBOR_ALLTOALL_INIT);
 
     MEMCHECKER(
         memchecker_comm(comm);
@@ -56,7 +56,7 @@ int MPIX_Neighbor_alltoallv_init(const void *sendbuf, const int sendcounts[], co
     int i, err;
     int indegree, outdegree;
 
-    SPC_RECORD(OMPI_SPC_NEIGHBOR_ALLTOALLV_INIT, 1);
+    SPC_CALL_TIMER(OMPI_SPC_NEIGHBOR_ALLTOALLV_INIT);
 
     MEMCHECKER(
         ptrdiff_t recv_ext;
@@ -53,7 +53,7 @@ int MPIX_Reduce_init(const void *sendbuf, void *recvbuf, int count,
 {
     int err;
 
-    SPC_RECORD(OMPI_SPC_REDUCE_INIT, 1);
+    SPC_CALL_TIMER(OMPI_SPC_REDUCE_INIT);
 
     MEMCHECKER(
         memchecker_datatype(datatype);
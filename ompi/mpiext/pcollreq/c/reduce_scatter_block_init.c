@@ -52,7 +52,7 @@ int MPIX_Reduce_scatter_block_init(const void *sendbuf, void *recvbuf, int recvc
 {
     int err;
 
-    SPC_RECORD(OMPI_SPC_REDUCE_SCATTER_BLOCK_INIT, 1);
+    SPC_CALL_TIMER(OMPI_SPC_REDUCE_SCATTER_BLOCK_INIT);
 
     MEMCHECKER(
         memchecker_comm(comm);
@@ -52,7 +52,7 @@ int MPIX_Reduce_scatter_init(const void *sendbuf, void *recvbuf, const int recvc
 {
     int i, err, size, count;
 
-    SPC_RECORD(OMPI_SPC_REDUCE_SCATTER_INIT, 1);
+    SPC_CALL_TIMER(OMPI_SPC_REDUCE_SCATTER_INIT);
 
     MEMCHECKER(
         int rank;
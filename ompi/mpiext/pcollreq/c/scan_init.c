@@ -51,7 +51,7 @@ int MPIX_Scan_init(const void *sendbuf, void *recvbuf, int count,
 {
     int err;
 
-    SPC_RECORD(OMPI_SPC_SCAN_INIT, 1);
+    SPC_CALL_TIMER(OMPI_SPC_SCAN_INIT);
 
     MEMCHECKER(
         memchecker_datatype(datatype);
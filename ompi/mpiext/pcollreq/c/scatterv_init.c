@@ -50,7 +50,7 @@ int MPIX_Scatterv_init(const void *sendbuf, const int sendcounts[], const int di
 {
     int i, size, err;
 
-    SPC_RECORD(OMPI_SPC_SCATTERV_INIT, 1);
+    SPC_CALL_TIMER(OMPI_SPC_SCATTERV_INIT);
 
     MEMCHECKER(
         ptrdiff_t ext;
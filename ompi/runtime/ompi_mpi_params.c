@@ -326,7 +326,9 @@ int ompi_mpi_register_params(void)
 
     ompi_mpi_spc_attach_string = NULL;
     (void) mca_base_var_register("ompi", "mpi", NULL, "spc_attach",
-                                 "A comma delimeted string listing the software-based performance counters (SPCs) to enable.",
+                                 "A comma delimeted string listing the software-based performance counters (SPCs) to enable. "
+                                 "The time spent in an MPI function is enabled by appending _TIME to the name of its counter "
+                                 "(e.g. OMPI_SPC_SEND_TIME).",
                                  MCA_BASE_VAR_TYPE_STRING, NULL, 0, 0,
                                  OPAL_INFO_LVL_4,
                                  MCA_BASE_VAR_SCOPE_READONLY,
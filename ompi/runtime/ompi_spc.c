@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018-2019 The University of Tennessee and The University
+ * Copyright (c) 2018-2026 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  *
@@ -152,6 +152,11 @@ static uint32_t ompi_spc_timer_event[OMPI_SPC_NUM_COUNTERS / sizeof(uint32_t)] =
 /* An array of event structures to store the event data (name and value) */
 static ompi_spc_t *ompi_spc_events = NULL;
 
+/* The time spent in the calls to the MPI functions, in cycles. The MPI_T
+ * index of these timers is stored as OMPI_SPC_NUM_COUNTERS + counter. */
+static uint32_t ompi_spc_attached_call_timer[OMPI_SPC_NUM_CALL_COUNTERS / sizeof(uint32_t) + 1] = { 0 };
+static ompi_spc_t *ompi_spc_call_times = NULL;
+
 static inline void SET_SPC_BIT(uint32_t* array, int32_t pos)
 {
     assert(pos < OMPI_SPC_NUM_COUNTERS);
@@ -186,6 +191,17 @@ static int ompi_spc_notify(mca_base_pvar_t *pvar, mca_base_pvar_event_t event, v
     }
 
     index = (int)(uintptr_t)pvar->ctx;  /* Convert from MPI_T pvar index to SPC index */
+    if(index >= OMPI_SPC_NUM_COUNTERS) {
+        /* A call timer */
+        if(MCA_BASE_PVAR_HANDLE_BIND == event) {
+            *count = 1;
+        } else if(MCA_BASE_PVAR_HANDLE_START == event) {
+            SET_SPC_BIT(ompi_spc_attached_call_timer, index - OMPI_SPC_NUM_COUNTERS);
+        } else if(MCA_BASE_PVAR_HANDLE_STOP == event) {
+            CLEAR_SPC_BIT(ompi_spc_attached_call_timer, index - OMPI_SPC_NUM_COUNTERS);
+        }
+        return MPI_SUCCESS;
+    }
 
     /* For this event, we need to set count to the number of long long type
      * values for this counter.  All SPC counters are one long long, so we
@@ -230,6 +246,11 @@ static int ompi_spc_get_count(const struct mca_base_pvar_t *pvar, void *value, v
 
     /* Convert from MPI_T pvar index to SPC index */
     int index = (int)(uintptr_t)pvar->ctx;
+    /* The call timers are reported in nanoseconds */
+    if(index >= OMPI_SPC_NUM_COUNTERS) {
+        *counter_value = (long long)(ompi_spc_call_times[index - OMPI_SPC_NUM_COUNTERS].value * 1000 / sys_clock_freq_mhz);
+        return MPI_SUCCESS;
+    }
     /* Set the counter value to the current SPC value */
     *counter_value = (long long)ompi_spc_events[index].value;
     /* If this is a timer-based counter, convert from cycles to microseconds */
@@ -258,6 +279,14 @@ void ompi_spc_events_init(void)
             return;
         }
     }
+    if(NULL == ompi_spc_call_times) {
+        ompi_spc_call_times = (ompi_spc_t*)calloc(OMPI_SPC_NUM_CALL_COUNTERS, sizeof(ompi_spc_t));
+        if(ompi_spc_call_times == NULL) {
+            opal_show_help("help-mpi-runtime.txt", "lib-call-fail", true,
+                           "malloc", __FILE__, __LINE__);
+            return;
+        }
+    }
     /* The data structure has been allocated, so we simply initialize all of the counters
      * with their names and an initial count of 0.
      */
@@ -265,6 +294,12 @@ void ompi_spc_events_init(void)
         ompi_spc_events[i].name = (char*)ompi_spc_events_names[i].counter_name;
         ompi_spc_events[i].value = 0;
     }
+    for(i = 0; i < OMPI_SPC_NUM_CALL_COUNTERS; i++) {
+        if(NULL == ompi_spc_call_times[i].name) {
+            opal_asprintf(&ompi_spc_call_times[i].name, "%s_TIME", ompi_spc_events_names[i].counter_name);
+        }
+        ompi_spc_call_times[i].value = 0;
+    }
 
     ompi_comm_dup(&ompi_mpi_comm_world.comm, &ompi_spc_comm);
 }
@@ -328,6 +363,37 @@ void ompi_spc_init(void)
         }
     }
 
+    /* Registers the time spent in each MPI function as a timer */
+    for(i = 0; i < OMPI_SPC_NUM_CALL_COUNTERS && NULL != ompi_spc_call_times; i++) {
+        char *description;
+
+        matched = all_on;
+        for(j = 0; j < num_args && !matched; j++) {
+            matched = (0 == strcmp(ompi_spc_call_times[i].name, arg_strings[j]));
+        }
+        if (matched) {
+            SET_SPC_BIT(ompi_spc_attached_call_timer, i);
+            mpi_t_enabled = true;
+            found++;
+        }
+
+        opal_asprintf(&description, "The number of nanoseconds spent in the calls counted by %s.  Note: "
+                      "The timer used on the back end is in cycles, converted assuming a fixed clock rate.",
+                      ompi_spc_events_names[i].counter_name);
+        ret = mca_base_pvar_register("ompi", "runtime", "spc", ompi_spc_call_times[i].name, description,
+                                     OPAL_INFO_LVL_4, MPI_T_PVAR_CLASS_TIMER,
+                                     MCA_BASE_VAR_TYPE_UNSIGNED_LONG_LONG, NULL, MPI_T_BIND_NO_OBJECT,
+                                     MCA_BASE_PVAR_FLAG_READONLY | MCA_BASE_PVAR_FLAG_CONTINUOUS,
+                                     ompi_spc_get_count, NULL, ompi_spc_notify,
+                                     (void*)(uintptr_t)(OMPI_SPC_NUM_COUNTERS + i));
+        free(description);
+        if( ret < 0 ) {
+            mpi_t_enabled = false;
+            opal_show_help("help-mpi-runtime.txt", "spc: MPI_T disabled", true);
+            break;
+        }
+    }
+
     /* If this is a timer event, set the corresponding timer_event entry */
     SET_SPC_BIT(ompi_spc_timer_event, OMPI_SPC_MATCH_TIME);
 
@@ -341,6 +407,7 @@ static void ompi_spc_dump(void)
 {
     int i, j, world_size, offset;
     long long *recv_buffer = NULL, *send_buffer;
+    const int num_values = OMPI_SPC_NUM_COUNTERS + OMPI_SPC_NUM_CALL_COUNTERS;
 
     int rank = ompi_comm_rank(ompi_spc_comm);
     world_size = ompi_comm_size(ompi_spc_comm);
@@ -353,7 +420,7 @@ static void ompi_spc_dump(void)
     }
 
     /* Aggregate all of the information on rank 0 using MPI_Gather on MPI_COMM_WORLD */
-    send_buffer = (long long*)malloc(OMPI_SPC_NUM_COUNTERS * sizeof(long long));
+    send_buffer = (long long*)malloc(num_values * sizeof(long long));
     if (NULL == send_buffer) {
         opal_show_help("help-mpi-runtime.txt", "lib-call-fail", true,
                        "malloc", __FILE__, __LINE__);
@@ -362,16 +429,20 @@ static void ompi_spc_dump(void)
     for(i = 0; i < OMPI_SPC_NUM_COUNTERS; i++) {
         send_buffer[i] = (long long)ompi_spc_events[i].value;
     }
+    /* The time spent in the MPI calls is also reported in usecs */
+    for(i = 0; i < OMPI_SPC_NUM_CALL_COUNTERS; i++) {
+        send_buffer[OMPI_SPC_NUM_COUNTERS + i] = (long long)(ompi_spc_call_times[i].value / sys_clock_freq_mhz);
+    }
     if( 0 == rank ) {
-        recv_buffer = (long long*)malloc(world_size * OMPI_SPC_NUM_COUNTERS * sizeof(long long));
+        recv_buffer = (long long*)malloc(world_size * num_values * sizeof(long long));
         if (NULL == recv_buffer) {
             opal_show_help("help-mpi-runtime.txt", "lib-call-fail", true,
                            "malloc", __FILE__, __LINE__);
             return;
         }
     }
-    (void)ompi_spc_comm->c_coll->coll_gather(send_buffer, OMPI_SPC_NUM_COUNTERS, MPI_LONG_LONG,
-                                             recv_buffer, OMPI_SPC_NUM_COUNTERS, MPI_LONG_LONG,
+    (void)ompi_spc_comm->c_coll->coll_gather(send_buffer, num_values, MPI_LONG_LONG,
+                                             recv_buffer, num_values, MPI_LONG_LONG,
                                              0, ompi_spc_comm,
                                              ompi_spc_comm->c_coll->coll_gather_module);
 
@@ -388,8 +459,15 @@ static void ompi_spc_dump(void)
                 }
                 opal_output(0, "%s -> %lld\n", ompi_spc_events[i].name, recv_buffer[offset+i]);
             }
+            for(i = 0; i < OMPI_SPC_NUM_CALL_COUNTERS; i++) {
+                if( 0 == recv_buffer[offset+OMPI_SPC_NUM_COUNTERS+i] ) {
+                    continue;
+                }
+                opal_output(0, "%s -> %lld usecs\n", ompi_spc_call_times[i].name,
+                            recv_buffer[offset+OMPI_SPC_NUM_COUNTERS+i]);
+            }
             opal_output(0, "\n");
-            offset += OMPI_SPC_NUM_COUNTERS;
+            offset += num_values;
         }
         printf("###########################################################################\n");
         printf("NOTE: Any counters not shown here were either disabled or had a value of 0.\n");
@@ -410,6 +488,13 @@ void ompi_spc_fini(void)
     }
 
     free(ompi_spc_events); ompi_spc_events = NULL;
+    memset(ompi_spc_attached_call_timer, 0, sizeof(ompi_spc_attached_call_timer));
+    if (NULL != ompi_spc_call_times) {
+        for(int i = 0; i < OMPI_SPC_NUM_CALL_COUNTERS; i++) {
+            free(ompi_spc_call_times[i].name);
+        }
+        free(ompi_spc_call_times); ompi_spc_call_times = NULL;
+    }
     ompi_comm_free(&ompi_spc_comm);
 }
 
@@ -449,6 +534,26 @@ void ompi_spc_timer_stop(unsigned int event_id, opal_timer_t *cycles)
     }
 }
 
+/* Counts a call to an MPI function and, if its time is being monitored,
+ * returns the cycle at which the call started (0 otherwise).
+ */
+opal_timer_t ompi_spc_call_start(unsigned int event_id)
+{
+    ompi_spc_record(event_id, 1);
+    /* This is denoted unlikely because the call timers will often be turned off. */
+    if( OPAL_UNLIKELY(IS_SPC_BIT_SET(ompi_spc_attached_call_timer, event_id)) ) {
+        return opal_timer_base_get_cycles();
+    }
+    return 0;
+}
+
+/* Adds the cycles elapsed since 'start' to the time spent in an MPI function. */
+void ompi_spc_call_stop(unsigned int event_id, opal_timer_t start)
+{
+    OPAL_THREAD_ADD_FETCH_SIZE_T(&ompi_spc_call_times[event_id].value,
+                                 (size_t)(opal_timer_base_get_cycles() - start));
+}
+
 /* Checks a tag, and records the user version of the counter if it's greater
  * than or equal to 0 and records the mpi version of the counter otherwise.
  */
@@ -1,5 +1,5 @@
 /*
- * Copyright (c) 2018      The University of Tennessee and The University
+ * Copyright (c) 2018-2026 The University of Tennessee and The University
  *                         of Tennessee Research Foundation.  All rights
  *                         reserved.
  * Copyright (c) 2018      Research Organization for Information Science
@@ -28,6 +28,7 @@
 #include "opal/util/argv.h"
 #include "opal/util/show_help.h"
 #include "opal/util/output.h"
+#include "opal/util/printf.h"
 
 #include MCA_timer_IMPLEMENTATION_HEADER
 
@@ -48,6 +49,11 @@
  *     SPC_TIMER_START and SPC_TIMER_STOP macros to record
  *     the time in cycles to then be converted to microseconds later
  *     in the ompi_spc_get_count function when requested by MPI_T
+ * 5.) If your counter counts the calls to an MPI function, add it
+ *     before OMPI_SPC_CANCEL and use SPC_CALL_TIMER at the beginning
+ *     of the function instead of SPC_RECORD: the calls are counted and
+ *     the time spent in the function is accumulated in the companion
+ *     <counter>_TIME timer.
  */
 
 /* This enumeration serves as event ids for the various events */
@@ -163,6 +169,11 @@ typedef enum ompi_spc_counters {
     OMPI_SPC_NUM_COUNTERS /* This serves as the number of counters.  It must be last. */
 } ompi_spc_counters_t;
 
+/* The counters of the calls to the MPI functions, from OMPI_SPC_SEND to
+ * OMPI_SPC_CANCEL, each have a companion timer for the time spent in the calls.
+ */
+#define OMPI_SPC_NUM_CALL_COUNTERS (OMPI_SPC_CANCEL + 1)
+
 /* There is currently no support for atomics on long long values so we will default to
  * size_t for now until support for such atomics is implemented.
  */
@@ -186,6 +197,22 @@ void ompi_spc_timer_stop(unsigned int event_id, opal_timer_t *cycles);
 void ompi_spc_user_or_mpi(int tag, ompi_spc_value_t value, unsigned int user_enum, unsigned int mpi_enum);
 void ompi_spc_cycles_to_usecs(ompi_spc_value_t *cycles);
 void ompi_spc_update_watermark(unsigned int watermark_enum, unsigned int value_enum);
+opal_timer_t ompi_spc_call_start(unsigned int event_id);
+void ompi_spc_call_stop(unsigned int event_id, opal_timer_t start);
+
+/* Times an MPI call from its declaration until the enclosing function returns */
+typedef struct ompi_spc_call_timer_t {
+    unsigned int event_id;
+    opal_timer_t start;
+} ompi_spc_call_timer_t;
+
+static inline void ompi_spc_call_timer_stop(ompi_spc_call_timer_t *timer)
+{
+    /* Denoted unlikely because the timers will often be turned off. */
+    if( OPAL_UNLIKELY(0 != timer->start) ) {
+        ompi_spc_call_stop(timer->event_id, timer->start);
+    }
+}
 
 /* Macros for using the SPC utility functions throughout the codebase.
  * If SPC_ENABLE is not 1, the macros become no-ops.
@@ -216,6 +243,18 @@ void ompi_spc_update_watermark(unsigned int watermark_enum, unsigned int value_e
 #define SPC_UPDATE_WATERMARK(watermark_enum, value_enum) \
     ompi_spc_update_watermark(watermark_enum, value_enum)
 
+/* Counts a call to an MPI function and, when the compiler lets us run code
+ * on every return path, times it until the function returns. Must be used
+ * where a declaration is allowed, at the beginning of the function. */
+#if OPAL_HAVE_ATTRIBUTE_CLEANUP
+#define SPC_CALL_TIMER(id) \
+    ompi_spc_call_timer_t ompi_spc_call_timer __opal_attribute_cleanup__(ompi_spc_call_timer_stop) = \
+        { .event_id = (id), .start = ompi_spc_call_start(id) }
+#else
+#define SPC_CALL_TIMER(event_id) \
+    ompi_spc_record(event_id, 1)
+#endif
+
 #else /* SPCs are not enabled */
 
 #define SPC_INIT()  \
@@ -242,6 +281,9 @@ void ompi_spc_update_watermark(unsigned int watermark_enum, unsigned int value_e
 #define SPC_UPDATE_WATERMARK(watermark_enum, value_enum) \
     ((void)0)
 
+#define SPC_CALL_TIMER(event_id) \
+    ((void)0)
+
 #endif
 
 #endif
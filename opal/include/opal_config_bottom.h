@@ -104,6 +104,12 @@
 #    define __opal_attribute_always_inline__
 #endif
 
+#if OPAL_HAVE_ATTRIBUTE_CLEANUP
+#    define __opal_attribute_cleanup__(a)    __attribute__((__cleanup__(a)))
+#else
+#    define __opal_attribute_cleanup__(a)
+#endif
+
 #if OPAL_HAVE_ATTRIBUTE_COLD
 #    define __opal_attribute_cold__          __attribute__((__cold__))
 #else
@@ -0,0 +1,627 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "opal/mca/base/mca_base_event.h"
+#include "opal/mca/base/mca_base_vari.h"
+
+#include <stddef.h>
+
+#include "opal/class/opal_pointer_array.h"
+#include "opal/class/opal_hash_table.h"
+#include "opal/mca/timer/timer.h"
+#include MCA_timer_IMPLEMENTATION_HEADER
+
+static opal_hash_table_t mca_base_event_index_hash;
+static opal_pointer_array_t registered_events;
+static opal_pointer_array_t registered_sources;
+static bool mca_base_event_initialized = false;
+static int event_count = 0;
+static int source_count = 0;
+
+static int mca_base_event_get_internal (int index, mca_base_event_t **event, bool invalidok);
+
+/* default source: the OPAL timer */
+static uint64_t mca_base_event_timer_get_time (void)
+{
+#if OPAL_TIMER_CYCLE_NATIVE
+    return (uint64_t) opal_timer_base_get_cycles ();
+#else
+    return (uint64_t) opal_timer_base_get_usec ();
+#endif
+}
+
+static uint64_t mca_base_event_timer_get_ticks_per_second (void)
+{
+#if OPAL_TIMER_CYCLE_NATIVE
+    return (uint64_t) opal_timer_base_get_freq ();
+#else
+    return 1000000;
+#endif
+}
+
+int mca_base_event_init (void)
+{
+    int ret = OPAL_SUCCESS;
+
+    if (!mca_base_event_initialized) {
+        mca_base_event_initialized = true;
+
+        OBJ_CONSTRUCT(&registered_events, opal_pointer_array_t);
+        opal_pointer_array_init(&registered_events, 64, 2048, 64);
+
+        OBJ_CONSTRUCT(&registered_sources, opal_pointer_array_t);
+        opal_pointer_array_init(&registered_sources, 4, 256, 4);
+
+        OBJ_CONSTRUCT(&mca_base_event_index_hash, opal_hash_table_t);
+        ret = opal_hash_table_init (&mca_base_event_index_hash, 256);
+        if (OPAL_SUCCESS != ret) {
+            mca_base_event_initialized = false;
+            OBJ_DESTRUCT(&registered_events);
+            OBJ_DESTRUCT(&registered_sources);
+            OBJ_DESTRUCT(&mca_base_event_index_hash);
+            return ret;
+        }
+
+        ret = mca_base_event_source_register ("opal_timer", "Open MPI internal timer (cycle "
+                                              "counter when available, microseconds otherwise)",
+                                              MCA_BASE_SOURCE_UNORDERED, mca_base_event_timer_get_time,
+                                              mca_base_event_timer_get_ticks_per_second, UINT64_MAX);
+        if (0 <= ret) {
+            ret = OPAL_SUCCESS;
+        }
+    }
+
+    return ret;
+}
+
+int mca_base_event_finalize (void)
+{
+    if (mca_base_event_initialized)  {
+        mca_base_event_initialized = false;
+
+        for (int i = 0 ; i < event_count ; ++i) {
+            mca_base_event_t *event = opal_pointer_array_get_item (&registered_events, i);
+            if (event) {
+                OBJ_RELEASE(event);
+            }
+        }
+
+        for (int i = 0 ; i < source_count ; ++i) {
+            mca_base_event_source_t *source = opal_pointer_array_get_item (&registered_sources, i);
+            if (source) {
+                OBJ_RELEASE(source);
+            }
+        }
+
+        event_count = 0;
+        source_count = 0;
+
+        OBJ_DESTRUCT(&registered_events);
+        OBJ_DESTRUCT(&registered_sources);
+        OBJ_DESTRUCT(&mca_base_event_index_hash);
+    }
+
+    return OPAL_SUCCESS;
+}
+
+int mca_base_event_source_register (const char *name, const char *description,
+                                    mca_base_source_order_t ordering,
+                                    uint64_t (*get_time) (void),
+                                    uint64_t (*get_ticks_per_second) (void),
+                                    uint64_t max_ticks)
+{
+    mca_base_event_source_t *source;
+    int index;
+
+    if (NULL == get_time || NULL == get_ticks_per_second) {
+        return OPAL_ERR_BAD_PARAM;
+    }
+
+    source = OBJ_NEW(mca_base_event_source_t);
+    if (NULL == source) {
+        return OPAL_ERR_OUT_OF_RESOURCE;
+    }
+
+    source->name = strdup (name);
+    source->description = description ? strdup (description) : NULL;
+    source->ordering = ordering;
+    source->get_time = get_time;
+    source->get_ticks_per_second = get_ticks_per_second;
+    source->max_ticks = max_ticks;
+
+    index = opal_pointer_array_add (&registered_sources, source);
+    if (0 > index) {
+        OBJ_RELEASE(source);
+        return OPAL_ERR_OUT_OF_RESOURCE;
+    }
+
+    source->source_index = index;
+    source_count++;
+
+    return index;
+}
+
+int mca_base_event_source_get_count (int *count)
+{
+    *count = source_count;
+    return OPAL_SUCCESS;
+}
+
+int mca_base_event_source_get (int index, const mca_base_event_source_t **source)
+{
+    if (index < 0 || index >= source_count) {
+        return OPAL_ERR_VALUE_OUT_OF_BOUNDS;
+    }
+
+    *source = opal_pointer_array_get_item (&registered_sources, index);
+
+    return OPAL_SUCCESS;
+}
+
+int mca_base_event_find (const char *project, const char *framework, const char *component, const char *name)
+{
+    char *full_name;
+    int ret, index;
+
+    ret = mca_base_var_generate_full_name4 (NULL, framework, component, name, &full_name);
+    if (OPAL_SUCCESS != ret) {
+        return OPAL_ERROR;
+    }
+
+    ret = mca_base_event_find_by_name (full_name, &index);
+    free (full_name);
+
+    return (OPAL_SUCCESS != ret) ? ret : index;
+}
+
+int mca_base_event_find_by_name (const char *full_name, int *index)
+{
+    mca_base_event_t *event;
+    void *tmp;
+    int rc;
+
+    rc = opal_hash_table_get_value_ptr (&mca_base_event_index_hash, full_name, strlen (full_name),
+                                        &tmp);
+    if (OPAL_SUCCESS != rc) {
+        return rc;
+    }
+
+    rc = mca_base_event_get_internal ((int)(uintptr_t) tmp, &event, false);
+    if (OPAL_SUCCESS != rc) {
+        return rc;
+    }
+
+    *index = (int)(uintptr_t) tmp;
+
+    return OPAL_SUCCESS;
+}
+
+int mca_base_event_get_count (int *count)
+{
+    *count = event_count;
+    return OPAL_SUCCESS;
+}
+
+int mca_base_event_register (const char *project, const char *framework, const char *component,
+                             const char *name, const char *description,
+                             mca_base_var_info_lvl_t verbosity, mca_base_var_enum_t *enumerator,
+                             int bind, int num_elements, const mca_base_var_type_t *types,
+                             const ptrdiff_t *displacements, size_t extent,
+                             mca_base_event_flag_t flags, mca_base_event_t **event_out)
+{
+    int ret, group_index, event_index;
+    mca_base_event_t *event;
+
+    if (0 > num_elements || (0 < num_elements && (NULL == types || NULL == displacements))) {
+        return OPAL_ERR_BAD_PARAM;
+    }
+
+    for (int i = 0 ; i < num_elements ; ++i) {
+        if (types[i] >= MCA_BASE_VAR_TYPE_MAX || MCA_BASE_VAR_TYPE_STRING == types[i] ||
+            MCA_BASE_VAR_TYPE_VERSION_STRING == types[i] ||
+            displacements[i] + ompi_var_type_sizes[types[i]] > extent) {
+            return OPAL_ERR_BAD_PARAM;
+        }
+    }
+
+    /* ensure the caller did not set an invalid flag */
+    assert (!(flags & 0x3f));
+
+    flags &= ~MCA_BASE_EVENT_FLAG_INVALID;
+
+    /* update this assert if more MPIT verbosity levels are added */
+    assert (verbosity >= OPAL_INFO_LVL_1 && verbosity <= OPAL_INFO_LVL_9);
+
+    /* check if this event is already registered */
+    ret = mca_base_event_find (project, framework, component, name);
+    if (OPAL_SUCCESS <= ret) {
+        ret = mca_base_event_get_internal (ret, &event, true);
+        if (OPAL_SUCCESS != ret) {
+            /* inconsistent internal state */
+            return OPAL_ERROR;
+        }
+
+        if (event->enumerator) {
+            OBJ_RELEASE(event->enumerator);
+        }
+        free (event->types);
+        free (event->displacements);
+        event->types = NULL;
+        event->displacements = NULL;
+    } else {
+        /* find/register an MCA parameter group for this event */
+        group_index = mca_base_var_group_register (project, framework, component, NULL);
+        if (-1 > group_index) {
+            return group_index;
+        }
+
+        event = OBJ_NEW(mca_base_event_t);
+        if (NULL == event) {
+            return OPAL_ERR_OUT_OF_RESOURCE;
+        }
+
+        do {
+            /* generate the event's full name */
+            ret = mca_base_var_generate_full_name4 (NULL, framework, component, name, &event->name);
+            if (OPAL_SUCCESS != ret) {
+                ret = OPAL_ERR_OUT_OF_RESOURCE;
+                break;
+            }
+
+            if (NULL != description) {
+                event->description = strdup(description);
+                if (NULL == event->description) {
+                    ret = OPAL_ERR_OUT_OF_RESOURCE;
+                    break;
+                }
+            }
+
+            event_index = opal_pointer_array_add (&registered_events, event);
+            if (0 > event_index) {
+                ret = OPAL_ERR_OUT_OF_RESOURCE;
+                break;
+            }
+            event->event_index = event_index;
+
+            /* add this event to the MCA variable group */
+            if (0 <= group_index) {
+                ret = mca_base_var_group_add_event (group_index, event_index);
+                if (0 > ret) {
+                    break;
+                }
+            }
+
+            opal_hash_table_set_value_ptr (&mca_base_event_index_hash, event->name, strlen (event->name),
+                                           (void *)(uintptr_t) event->event_index);
+
+            event_count++;
+            ret = OPAL_SUCCESS;
+        } while (0);
+
+        if (OPAL_SUCCESS != ret) {
+            OBJ_RELEASE(event);
+            return ret;
+        }
+
+        event->group_index = group_index;
+    }
+
+    if (0 < num_elements) {
+        event->types = malloc (num_elements * sizeof (event->types[0]));
+        event->displacements = malloc (num_elements * sizeof (event->displacements[0]));
+        if (NULL == event->types || NULL == event->displacements) {
+            free (event->types);
+            free (event->displacements);
+            event->types = NULL;
+            event->displacements = NULL;
+            event->num_elements = 0;
+            event->flags |= MCA_BASE_EVENT_FLAG_INVALID;
+            return OPAL_ERR_OUT_OF_RESOURCE;
+        }
+        memcpy (event->types, types, num_elements * sizeof (event->types[0]));
+        memcpy (event->displacements, displacements, num_elements * sizeof (event->displacements[0]));
+    }
+
+    event->verbosity    = verbosity;
+    event->enumerator   = enumerator;
+    if (enumerator) {
+        OBJ_RETAIN(enumerator);
+    }
+
+    event->bind         = bind;
+    event->source_index = 0;
+    event->num_elements = num_elements;
+    event->extent       = extent;
+    event->flags        = flags;
+
+    if (NULL != event_out) {
+        *event_out = event;
+    }
+
+    return event->event_index;
+}
+
+int mca_base_component_event_register (const mca_base_component_t *component, const char *name,
+                                       const char *description, mca_base_var_info_lvl_t verbosity,
+                                       mca_base_var_enum_t *enumerator, int bind, int num_elements,
+                                       const mca_base_var_type_t *types,
+                                       const ptrdiff_t *displacements, size_t extent,
+                                       mca_base_event_flag_t flags, mca_base_event_t **event)
+{
+    /* invalidate this event if the component's group is deregistered */
+    return mca_base_event_register (component->mca_project_name, component->mca_type_name,
+                                    component->mca_component_name, name, description, verbosity,
+                                    enumerator, bind, num_elements, types, displacements, extent,
+                                    flags | MCA_BASE_EVENT_FLAG_IWG, event);
+}
+
+static int mca_base_event_get_internal (int index, mca_base_event_t **event, bool invalidok)
+{
+    if (index < 0 || index >= event_count) {
+        return OPAL_ERR_VALUE_OUT_OF_BOUNDS;
+    }
+
+    *event = opal_pointer_array_get_item (&registered_events, index);
+
+    /* like the variables, events are never removed */
+    assert (*event);
+
+    if (((*event)->flags & MCA_BASE_EVENT_FLAG_INVALID) && !invalidok) {
+        *event = NULL;
+        return OPAL_ERR_VALUE_OUT_OF_BOUNDS;
+    }
+
+    return OPAL_SUCCESS;
+}
+
+int mca_base_event_get (int index, const mca_base_event_t **event)
+{
+    return mca_base_event_get_internal (index, (mca_base_event_t **) event, false);
+}
+
+int mca_base_event_mark_invalid (int index)
+{
+    mca_base_event_t *event;
+    int ret;
+
+    ret = mca_base_event_get_internal (index, &event, false);
+    if (OPAL_SUCCESS != ret) {
+        return ret;
+    }
+
+    event->flags |= MCA_BASE_EVENT_FLAG_INVALID;
+
+    return OPAL_SUCCESS;
+}
+
+void mca_base_event_raise_internal (mca_base_event_t *event, mca_base_cb_safety_t cb_safety,
+                                    void *obj, const void *data)
+{
+    const mca_base_event_source_t *source;
+    mca_base_event_instance_t instance;
+    mca_base_event_handle_t *handle;
+    int level;
+
+    if (OPAL_UNLIKELY(event->flags & MCA_BASE_EVENT_FLAG_INVALID)) {
+        return;
+    }
+
+    source = opal_pointer_array_get_item (&registered_sources, event->source_index);
+
+    instance.event = event;
+    instance.data = data;
+    instance.timestamp = source->get_time ();
+
+    OPAL_THREAD_LOCK(&event->lock);
+    OPAL_LIST_FOREACH(handle, &event->bound_handles, mca_base_event_handle_t) {
+        if (MCA_BASE_VAR_BIND_NO_OBJECT != event->bind && handle->obj_handle != obj) {
+            continue;
+        }
+
+        /* use the least restrictive callback that is safe in this context */
+        for (level = cb_safety ; level < MCA_BASE_CB_SAFETY_MAX ; ++level) {
+            if (NULL != handle->callbacks[level]) {
+                break;
+            }
+        }
+
+        if (MCA_BASE_CB_SAFETY_MAX == level) {
+            handle->dropped++;
+            continue;
+        }
+
+        if (OPAL_UNLIKELY(0 != handle->dropped) && NULL != handle->dropped_cb) {
+            handle->dropped_cb (handle->dropped, handle, event->source_index, cb_safety,
+                                handle->user_data[level]);
+            handle->dropped = 0;
+        }
+
+        handle->callbacks[level] (&instance, handle, cb_safety, handle->user_data[level]);
+    }
+    OPAL_THREAD_UNLOCK(&event->lock);
+}
+
+int mca_base_event_handle_alloc (int index, void *obj_handle, mca_base_event_handle_t **handle)
+{
+    mca_base_event_handle_t *event_handle;
+    mca_base_event_t *event;
+    int ret;
+
+    ret = mca_base_event_get_internal (index, &event, false);
+    if (OPAL_SUCCESS != ret) {
+        return ret;
+    }
+
+    if (MCA_BASE_VAR_BIND_NO_OBJECT == event->bind) {
+        obj_handle = NULL;
+    } else if (NULL == obj_handle) {
+        /* this is an application error. just return an error */
+        return OPAL_ERR_BAD_PARAM;
+    }
+
+    event_handle = OBJ_NEW(mca_base_event_handle_t);
+    if (NULL == event_handle) {
+        return OPAL_ERR_OUT_OF_RESOURCE;
+    }
+
+    event_handle->event = event;
+    event_handle->obj_handle = (NULL == obj_handle ? NULL : *(void**)obj_handle);
+
+    OPAL_THREAD_LOCK(&event->lock);
+    opal_list_append (&event->bound_handles, &event_handle->super);
+    OPAL_THREAD_UNLOCK(&event->lock);
+
+    *handle = event_handle;
+
+    return OPAL_SUCCESS;
+}
+
+static bool mca_base_event_handle_has_callback (const mca_base_event_handle_t *handle)
+{
+    for (int i = 0 ; i < MCA_BASE_CB_SAFETY_MAX ; ++i) {
+        if (NULL != handle->callbacks[i]) {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+int mca_base_event_register_callback (mca_base_event_handle_t *handle, mca_base_cb_safety_t cb_safety,
+                                      mca_base_event_cb_fn_t cb, void *user_data)
+{
+    mca_base_event_t *event = handle->event;
+    bool was_active;
+
+    if (cb_safety < MCA_BASE_CB_REQUIRE_NONE || cb_safety >= MCA_BASE_CB_SAFETY_MAX) {
+        return OPAL_ERR_BAD_PARAM;
+    }
+
+    OPAL_THREAD_LOCK(&event->lock);
+    was_active = mca_base_event_handle_has_callback (handle);
+    handle->callbacks[cb_safety] = cb;
+    handle->user_data[cb_safety] = user_data;
+
+    if (was_active != mca_base_event_handle_has_callback (handle)) {
+        (void) OPAL_THREAD_ADD_FETCH32(&event->active, was_active ? -1 : 1);
+    }
+    OPAL_THREAD_UNLOCK(&event->lock);
+
+    return OPAL_SUCCESS;
+}
+
+int mca_base_event_set_dropped_handler (mca_base_event_handle_t *handle,
+                                        mca_base_event_dropped_cb_fn_t dropped_cb)
+{
+    OPAL_THREAD_LOCK(&handle->event->lock);
+    handle->dropped_cb = dropped_cb;
+    OPAL_THREAD_UNLOCK(&handle->event->lock);
+
+    return OPAL_SUCCESS;
+}
+
+int mca_base_event_handle_free (mca_base_event_handle_t *handle, void *user_data,
+                                mca_base_event_free_cb_fn_t free_cb)
+{
+    mca_base_event_t *event = handle->event;
+
+    OPAL_THREAD_LOCK(&event->lock);
+    opal_list_remove_item (&event->bound_handles, &handle->super);
+    if (mca_base_event_handle_has_callback (handle)) {
+        (void) OPAL_THREAD_ADD_FETCH32(&event->active, -1);
+    }
+    OPAL_THREAD_UNLOCK(&event->lock);
+
+    /* the handle can not be reached by mca_base_event_raise() anymore */
+    if (0 != handle->dropped && NULL != handle->dropped_cb) {
+        handle->dropped_cb (handle->dropped, handle, event->source_index, MCA_BASE_CB_REQUIRE_NONE,
+                            handle->user_data[MCA_BASE_CB_REQUIRE_NONE]);
+    }
+
+    if (NULL != free_cb) {
+        free_cb (handle, MCA_BASE_CB_REQUIRE_NONE, user_data);
+    }
+
+    OBJ_RELEASE(handle);
+
+    return OPAL_SUCCESS;
+}
+
+int mca_base_event_read (const mca_base_event_instance_t *instance, int element, void *buffer)
+{
+    const mca_base_event_t *event = instance->event;
+
+    if (element < 0 || element >= event->num_elements) {
+        return OPAL_ERR_VALUE_OUT_OF_BOUNDS;
+    }
+
+    memcpy (buffer, (const char *) instance->data + event->displacements[element],
+            ompi_var_type_sizes[event->types[element]]);
+
+    return OPAL_SUCCESS;
+}
+
+int mca_base_event_copy (const mca_base_event_instance_t *instance, void *buffer)
+{
+    memcpy (buffer, instance->data, instance->event->extent);
+
+    return OPAL_SUCCESS;
+}
+
+/* mca_base_event_t class */
+static void mca_base_event_constructor (mca_base_event_t *event)
+{
+    memset ((char *) event + sizeof (event->super), 0, sizeof (*event) - sizeof (event->super));
+    OBJ_CONSTRUCT(&event->lock, opal_mutex_t);
+    OBJ_CONSTRUCT(&event->bound_handles, opal_list_t);
+}
+
+static void mca_base_event_destructor (mca_base_event_t *event)
+{
+    free (event->name);
+    free (event->description);
+    free (event->types);
+    free (event->displacements);
+
+    if (NULL != event->enumerator) {
+        OBJ_RELEASE(event->enumerator);
+    }
+
+    /* handles not freed by the tools are released with their event */
+    OPAL_LIST_DESTRUCT(&event->bound_handles);
+    OBJ_DESTRUCT(&event->lock);
+}
+
+OBJ_CLASS_INSTANCE(mca_base_event_t, opal_object_t, mca_base_event_constructor, mca_base_event_destructor);
+
+/* mca_base_event_handle_t class */
+static void mca_base_event_handle_constructor (mca_base_event_handle_t *handle)
+{
+    memset ((char *) handle + sizeof (handle->super), 0, sizeof (*handle) - sizeof (handle->super));
+}
+
+OBJ_CLASS_INSTANCE(mca_base_event_handle_t, opal_list_item_t, mca_base_event_handle_constructor, NULL);
+
+/* mca_base_event_source_t class */
+static void mca_base_event_source_constructor (mca_base_event_source_t *source)
+{
+    memset ((char *) source + sizeof (source->super), 0, sizeof (*source) - sizeof (source->super));
+}
+
+static void mca_base_event_source_destructor (mca_base_event_source_t *source)
+{
+    free (source->name);
+    free (source->description);
+}
+
+OBJ_CLASS_INSTANCE(mca_base_event_source_t, opal_object_t, mca_base_event_source_constructor,
+                   mca_base_event_source_destructor);
@@ -0,0 +1,372 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#if !defined(OPAL_MPIT_EVENT_H)
+#define OPAL_MPIT_EVENT_H
+
+#include "opal/mca/base/mca_base_var.h"
+#include "opal/mca/base/mca_base_pvar.h"
+#include "opal/mca/threads/mutex.h"
+#include "opal/sys/atomic.h"
+
+#include <stddef.h>
+
+/*
+ * Backend of the MPI_T event interface. Events are registered by the
+ * frameworks and components in the same way as performance variables,
+ * and raised from the code paths they describe. Tools allocate handles
+ * on the events and register callbacks on these handles, which are
+ * invoked synchronously every time the event is raised.
+ *
+ * Raising an event nobody listens to only costs a load and a branch
+ * (see mca_base_event_raise()), so events can be left in the critical
+ * path. Callers that need to build the event data should check
+ * mca_base_event_is_active() first.
+ */
+
+/*
+ * These flags are used when registering a new event.
+ */
+typedef enum {
+    /** This event should be marked as invalid when the containing
+        group is deregistered (IWG = "invalidate with group"). Set
+        automatically by mca_base_component_event_register(). Analogous
+        to MCA_BASE_PVAR_FLAG_IWG. */
+    MCA_BASE_EVENT_FLAG_IWG     = 0x040,
+    /** This event has been marked as invalid. This flag is ignored
+        by mca_base_event_register(). */
+    MCA_BASE_EVENT_FLAG_INVALID = 0x400,
+} mca_base_event_flag_t;
+
+/**
+ * Callback safety requirements. Must be kept in the same order as
+ * MPI_T_CB_REQUIRE_* in mpi.h.in.
+ */
+typedef enum {
+    MCA_BASE_CB_REQUIRE_NONE,
+    MCA_BASE_CB_REQUIRE_MPI_RESTRICTED,
+    MCA_BASE_CB_REQUIRE_THREAD_SAFE,
+    MCA_BASE_CB_REQUIRE_ASYNC_SIGNAL_SAFE,
+    MCA_BASE_CB_SAFETY_MAX
+} mca_base_cb_safety_t;
+
+/**
+ * Ordering of the timestamps of a source. Must be kept in the same
+ * order as MPI_T_SOURCE_* in mpi.h.in.
+ */
+typedef enum {
+    MCA_BASE_SOURCE_ORDERED,
+    MCA_BASE_SOURCE_UNORDERED
+} mca_base_source_order_t;
+
+struct mca_base_event_handle_t;
+struct mca_base_event_instance_t;
+
+/**
+ * Event callback. The instance is only valid during the callback.
+ *
+ * The signature matches MPI_T_event_cb_function.
+ */
+typedef void (*mca_base_event_cb_fn_t) (struct mca_base_event_instance_t *instance,
+                                        struct mca_base_event_handle_t *handle,
+                                        mca_base_cb_safety_t cb_safety, void *user_data);
+
+/**
+ * Called before the next delivered event (or when the handle is freed)
+ * with the number of events this handle missed because no callback
+ * with a suitable safety level was registered.
+ *
+ * The signature matches MPI_T_event_dropped_cb_function.
+ */
+typedef void (*mca_base_event_dropped_cb_fn_t) (int64_t count, struct mca_base_event_handle_t *handle,
+                                                int source_index, mca_base_cb_safety_t cb_safety,
+                                                void *user_data);
+
+/**
+ * Called once a handle has been freed and none of its callbacks can
+ * be invoked anymore.
+ *
+ * The signature matches MPI_T_event_free_cb_function.
+ */
+typedef void (*mca_base_event_free_cb_fn_t) (struct mca_base_event_handle_t *handle,
+                                             mca_base_cb_safety_t cb_safety, void *user_data);
+
+/**
+ * Source of the timestamps of the events.
+ */
+typedef struct mca_base_event_source_t {
+    /** Make this an opal object */
+    opal_object_t super;
+
+    /** Source index */
+    int source_index;
+
+    /** Name and description of this source */
+    char *name;
+    char *description;
+
+    /** Whether the events of this source are raised in timestamp order */
+    mca_base_source_order_t ordering;
+
+    /** Current timestamp of this source */
+    uint64_t (*get_time) (void);
+
+    /** Number of timestamp ticks per second */
+    uint64_t (*get_ticks_per_second) (void);
+
+    /** Number of ticks before the timestamps wrap around */
+    uint64_t max_ticks;
+} mca_base_event_source_t;
+OBJ_CLASS_DECLARATION(mca_base_event_source_t);
+
+/**
+ * Structure representing an OPAL event.
+ */
+typedef struct mca_base_event_t {
+    /** Make this an opal object */
+    opal_object_t super;
+
+    /** Event index */
+    int event_index;
+
+    /** Full name of the event: form is framework_component_name */
+    char *name;
+
+    /** Description of this event */
+    char *description;
+
+    /** MCA variable group this event is associated with */
+    int group_index;
+
+    /** Verbosity level of this event */
+    mca_base_var_info_lvl_t verbosity;
+
+    /** Enumerator for the integer elements of this event */
+    mca_base_var_enum_t *enumerator;
+
+    /** Type of object to which this event must be bound or MCA_BASE_VAR_BIND_NO_OBJECT */
+    int bind;
+
+    /** Source of the timestamps of this event */
+    int source_index;
+
+    /** Layout of the data raised with the event */
+    int num_elements;
+    mca_base_var_type_t *types;
+    ptrdiff_t *displacements;
+    size_t extent;
+
+    /** Flags for this event */
+    mca_base_event_flag_t flags;
+
+    /** Number of handles with at least one callback registered */
+    opal_atomic_int32_t active;
+
+    /** Protects the bound handles */
+    opal_mutex_t lock;
+
+    /** List of the handles allocated on this event */
+    opal_list_t bound_handles;
+} mca_base_event_t;
+OBJ_CLASS_DECLARATION(mca_base_event_t);
+
+/**
+ * Event handle (MPI_T_event_registration)
+ */
+typedef struct mca_base_event_handle_t {
+    /** List item in the event bound handles */
+    opal_list_item_t super;
+
+    /** Event this handle is associated with */
+    mca_base_event_t *event;
+
+    /** MPI object handle */
+    void *obj_handle;
+
+    /** Callbacks and their user data, per safety level */
+    mca_base_event_cb_fn_t callbacks[MCA_BASE_CB_SAFETY_MAX];
+    void *user_data[MCA_BASE_CB_SAFETY_MAX];
+
+    /** Dropped events handler */
+    mca_base_event_dropped_cb_fn_t dropped_cb;
+
+    /** Number of events dropped since the last call to the dropped handler */
+    int64_t dropped;
+} mca_base_event_handle_t;
+OBJ_CLASS_DECLARATION(mca_base_event_handle_t);
+
+/**
+ * Occurrence of an event (MPI_T_event_instance)
+ */
+typedef struct mca_base_event_instance_t {
+    /** Event that was raised */
+    mca_base_event_t *event;
+
+    /** Data of this occurrence, laid out as described by the event */
+    const void *data;
+
+    /** Timestamp taken from the event source when it was raised */
+    uint64_t timestamp;
+} mca_base_event_instance_t;
+
+/****************************************************************************
+ * The following functions are public functions, and are intended to
+ * be used by components and frameworks to expose their events.
+ ****************************************************************************/
+
+/**
+ * Register an event
+ *
+ * @param[in] project       Name of registering project
+ * @param[in] framework     Name of registering framework
+ * @param[in] component     Name of registering component
+ * @param[in] name          Name of the event
+ * @param[in] description   Description of the event. Verbose is good!
+ * @param[in] verbosity     Opal info verbosity of this event. Equivalent to
+ *                          MPI_T verbosity.
+ * @param[in] enumerator    Enumerator for the integer elements of this event.
+ *                          Will be OBJ_RETAIN'd.
+ * @param[in] bind          Object type this event is bound to. See mpi.h.in
+ *                          MPI_T_BIND_*
+ * @param[in] num_elements  Number of elements of the event data
+ * @param[in] types         Type of each element
+ * @param[in] displacements Offset of each element in the event data
+ * @param[in] extent        Size of the event data
+ * @param[in] flags         Flags for this event. See mca_base_event_flag_t.
+ * @param[out] event        Event to raise (may be NULL)
+ *
+ * @returns index         On success returns the index of this event.
+ * @returns OPAL_ERROR    On error.
+ *
+ * Registering an existing event again updates its description and
+ * returns the same object, so pointers to events are valid until
+ * the MCA variable system is finalized.
+ */
+OPAL_DECLSPEC int mca_base_event_register (const char *project, const char *framework, const char *component,
+                                           const char *name, const char *description,
+                                           mca_base_var_info_lvl_t verbosity, mca_base_var_enum_t *enumerator,
+                                           int bind, int num_elements, const mca_base_var_type_t *types,
+                                           const ptrdiff_t *displacements, size_t extent,
+                                           mca_base_event_flag_t flags, mca_base_event_t **event);
+
+/**
+ * Convinience function for registering an event associated with a
+ * component. The event is invalidated when the component is closed
+ * by its framework.
+ */
+OPAL_DECLSPEC int mca_base_component_event_register (const mca_base_component_t *component, const char *name,
+                                                     const char *description, mca_base_var_info_lvl_t verbosity,
+                                                     mca_base_var_enum_t *enumerator, int bind, int num_elements,
+                                                     const mca_base_var_type_t *types,
+                                                     const ptrdiff_t *displacements, size_t extent,
+                                                     mca_base_event_flag_t flags, mca_base_event_t **event);
+
+/**
+ * Check if any callback is registered on an event
+ */
+static inline bool mca_base_event_is_active (const mca_base_event_t *event)
+{
+    return NULL != event && OPAL_UNLIKELY(0 < event->active);
+}
+
+OPAL_DECLSPEC void mca_base_event_raise_internal (mca_base_event_t *event, mca_base_cb_safety_t cb_safety,
+                                                  void *obj, const void *data);
+
+/**
+ * Raise an event
+ *
+ * @param[in] event     Event returned by mca_base_event_register()
+ * @param[in] cb_safety Restrictions of the calling context. Only the callbacks
+ *                      registered for this level or a more restrictive one are
+ *                      invoked, the other handles count the event as dropped.
+ * @param[in] obj       MPI object the event relates to (the MPI handle itself,
+ *                      not a pointer to it), or NULL
+ * @param[in] data      Event data, laid out as described at registration
+ *
+ * Callbacks must not free handles of the event they are called for.
+ */
+static inline void mca_base_event_raise (mca_base_event_t *event, mca_base_cb_safety_t cb_safety,
+                                         void *obj, const void *data)
+{
+    if (mca_base_event_is_active (event)) {
+        mca_base_event_raise_internal (event, cb_safety, obj, data);
+    }
+}
+
+/**
+ * Register a source of timestamps
+ *
+ * @returns index of the source on success
+ *
+ * The first source (index 0) is registered by mca_base_event_init() and
+ * uses the OPAL timer. It is the source of all events.
+ */
+OPAL_DECLSPEC int mca_base_event_source_register (const char *name, const char *description,
+                                                  mca_base_source_order_t ordering,
+                                                  uint64_t (*get_time) (void),
+                                                  uint64_t (*get_ticks_per_second) (void),
+                                                  uint64_t max_ticks);
+
+/****************************************************************************
+ * The following functions are the back-end to the MPI_T API functions
+ * and/or the internals of the event system itself.
+ ****************************************************************************/
+
+OPAL_DECLSPEC int mca_base_event_get_count (int *count);
+OPAL_DECLSPEC int mca_base_event_get (int index, const mca_base_event_t **event);
+OPAL_DECLSPEC int mca_base_event_find (const char *project, const char *framework,
+                                       const char *component, const char *name);
+OPAL_DECLSPEC int mca_base_event_find_by_name (const char *full_name, int *index);
+
+/**
+ * Mark an event as invalid. Handles on an invalid event stay allocated
+ * but are not called until the event is registered again.
+ */
+OPAL_DECLSPEC int mca_base_event_mark_invalid (int index);
+
+OPAL_DECLSPEC int mca_base_event_source_get_count (int *count);
+OPAL_DECLSPEC int mca_base_event_source_get (int index, const mca_base_event_source_t **source);
+
+/**
+ * Allocate a handle on an event
+ *
+ * @param[in]  index      Event index
+ * @param[in]  obj_handle Pointer to the MPI object to bind to, ignored if
+ *                        the event is not bound to an object
+ * @param[out] handle     New handle
+ */
+OPAL_DECLSPEC int mca_base_event_handle_alloc (int index, void *obj_handle, mca_base_event_handle_t **handle);
+
+/**
+ * Register (or with a NULL cb remove) the callback of a handle for a
+ * safety level
+ */
+OPAL_DECLSPEC int mca_base_event_register_callback (mca_base_event_handle_t *handle, mca_base_cb_safety_t cb_safety,
+                                                    mca_base_event_cb_fn_t cb, void *user_data);
+
+OPAL_DECLSPEC int mca_base_event_set_dropped_handler (mca_base_event_handle_t *handle,
+                                                      mca_base_event_dropped_cb_fn_t dropped_cb);
+
+/**
+ * Free a handle. The pending dropped events are reported first, then
+ * free_cb (if any) is invoked before the handle is released.
+ */
+OPAL_DECLSPEC int mca_base_event_handle_free (mca_base_event_handle_t *handle, void *user_data,
+                                              mca_base_event_free_cb_fn_t free_cb);
+
+/**
+ * Copy one element, or all of them, of an event instance
+ */
+OPAL_DECLSPEC int mca_base_event_read (const mca_base_event_instance_t *instance, int element, void *buffer);
+OPAL_DECLSPEC int mca_base_event_copy (const mca_base_event_instance_t *instance, void *buffer);
+
+#endif
@@ -292,6 +292,11 @@ int mca_base_var_init(void)
             return ret;
         }
 
+        ret = mca_base_event_init ();
+        if (OPAL_SUCCESS != ret) {
+            return ret;
+        }
+
         /* We may need this later */
         home = (char*)opal_home_directory();
         if (NULL == home) {
@@ -1171,6 +1176,7 @@ static void mca_base_var_finalize (void)
 
         (void) mca_base_var_group_finalize ();
         (void) mca_base_pvar_finalize ();
+        (void) mca_base_event_finalize ();
 
         OBJ_DESTRUCT(&mca_base_var_index_hash);
 
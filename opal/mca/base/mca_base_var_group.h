@@ -55,6 +55,9 @@ struct mca_base_var_group_t {
     /** Integer array of group performance variables */
     opal_value_array_t group_pvars;
 
+    /** Integer array of group events */
+    opal_value_array_t group_events;
+
     /** Pointer array of group enums */
     opal_value_array_t group_enums;
 };
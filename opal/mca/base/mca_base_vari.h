@@ -139,6 +139,13 @@ OPAL_DECLSPEC int mca_base_var_group_add_var (const int group_index, const int p
  */
 OPAL_DECLSPEC int mca_base_var_group_add_pvar (const int group_index, const int param_index);
 
+/**
+ * \internal
+ *
+ * Add an event to a group
+ */
+OPAL_DECLSPEC int mca_base_var_group_add_event (const int group_index, const int event_index);
+
 /**
  * \internal
  *
@@ -178,6 +185,14 @@ OPAL_DECLSPEC int mca_base_var_group_finalize (void);
 OPAL_DECLSPEC int mca_base_pvar_init (void);
 OPAL_DECLSPEC int mca_base_pvar_finalize (void);
 
+/**
+ * \internal
+ *
+ * Initialize/finalize MPI_T events
+ */
+OPAL_DECLSPEC int mca_base_event_init (void);
+OPAL_DECLSPEC int mca_base_event_finalize (void);
+
 END_C_DECLS
 
 #endif /* OPAL_MCA_BASE_VAR_INTERNAL_H */
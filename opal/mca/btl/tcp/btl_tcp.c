@@ -39,6 +39,7 @@
 #include "btl_tcp_frag.h"
 #include "btl_tcp_proc.h"
 #include "btl_tcp_endpoint.h"
+#include "btl_tcp_epoll.h"
 
 static int mca_btl_tcp_register_error_cb(struct mca_btl_base_module_t* btl,
                                          mca_btl_base_module_error_cb_fn_t cbfunc);
@@ -497,6 +498,10 @@ int mca_btl_tcp_finalize(struct mca_btl_base_module_t* btl)
         mca_btl_tcp_endpoint_t *endpoint = (mca_btl_tcp_endpoint_t*)item;
         OBJ_RELEASE(endpoint);
     }
+#if OPAL_BTL_TCP_HAVE_EPOLL
+    /* endpoints whose close is still pending use the module */
+    mca_btl_tcp_epoll_flush_closed();
+#endif  /* OPAL_BTL_TCP_HAVE_EPOLL */
     free(tcp_btl);
     return OPAL_SUCCESS;
 }
@@ -148,6 +148,27 @@ struct mca_btl_tcp_component_t {
      * that are not found?
      */
     bool report_all_unfound_interfaces;
+
+    /* connection cache */
+    int tcp_max_connections;                /**< soft cap on the number of open connections (0: unlimited) */
+    int tcp_idle_timeout;                   /**< seconds before an unused connection is closed (0: never) */
+    opal_event_t tcp_idle_event;            /**< periodic sweep of the idle connections */
+    opal_event_t tcp_evict_event;           /**< immediate eviction when going over tcp_max_connections */
+    bool tcp_idle_event_added;              /**< are the idle events registered with the event base? */
+    opal_atomic_size_t tcp_num_connections; /**< number of currently open connections */
+    /* connection churn, exported as performance variables */
+    opal_atomic_size_t tcp_connections_highwater; /**< maximum number of simultaneously open connections */
+    opal_atomic_size_t tcp_connections_opened;   /**< connections established */
+    opal_atomic_size_t tcp_connections_reopened; /**< connections reestablished after an idle close */
+    opal_atomic_size_t tcp_connections_idle_closed; /**< connections closed after tcp_idle_timeout */
+    opal_atomic_size_t tcp_connections_evicted;  /**< connections closed to stay under tcp_max_connections */
+
+#if OPAL_BTL_TCP_HAVE_EPOLL
+    int tcp_epoll_threads;                  /**< number of epoll I/O threads (0 to use libevent) */
+    int tcp_epoll_max_events;               /**< maximum number of events harvested per epoll_wait */
+    struct mca_btl_tcp_io_thread_t *tcp_io_threads; /**< array of I/O threads */
+    opal_atomic_int32_t tcp_io_thread_next; /**< round-robin assignment of endpoints to I/O threads */
+#endif  /* OPAL_BTL_TCP_HAVE_EPOLL */
 };
 typedef struct mca_btl_tcp_component_t mca_btl_tcp_component_t;
 
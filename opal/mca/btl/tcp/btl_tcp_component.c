@@ -90,6 +90,8 @@
 #include "btl_tcp_proc.h"
 #include "btl_tcp_frag.h"
 #include "btl_tcp_endpoint.h"
+#include "btl_tcp_epoll.h"
+#include "btl_tcp_conn_cache.h"
 #if OPAL_CUDA_SUPPORT
 #include "opal/mca/common/cuda/common_cuda.h"
 #endif /* OPAL_CUDA_SUPPORT */
@@ -310,6 +312,29 @@ static int mca_btl_tcp_component_register(void)
     /* Check if we should support async progress */
     mca_btl_tcp_param_register_int ("progress_thread", NULL, 0, OPAL_INFO_LVL_1,
                                      &mca_btl_tcp_component.tcp_enable_progress_thread);
+#if OPAL_BTL_TCP_HAVE_EPOLL
+    mca_btl_tcp_param_register_int ("epoll_threads",
+                                    "Number of dedicated I/O threads progressing the connected sockets "
+                                    "with edge-triggered epoll instead of libevent. Sockets are spread "
+                                    "over the threads, and the completed fragments are delivered to the "
+                                    "upper layer from the progress engine. 0 disables the epoll engine.",
+                                    0, OPAL_INFO_LVL_4, &mca_btl_tcp_component.tcp_epoll_threads);
+    mca_btl_tcp_param_register_int ("epoll_max_events",
+                                    "Maximum number of socket events handled by an epoll I/O thread per wakeup",
+                                    64, OPAL_INFO_LVL_9, &mca_btl_tcp_component.tcp_epoll_max_events);
+#endif  /* OPAL_BTL_TCP_HAVE_EPOLL */
+    mca_btl_tcp_param_register_int ("max_connections",
+                                    "Soft limit on the number of TCP connections open in this process. "
+                                    "When it is exceeded the least recently used idle connections are "
+                                    "closed, and reestablished on demand. Connections with traffic in "
+                                    "flight are never closed. 0 means no limit.",
+                                    0, OPAL_INFO_LVL_4, &mca_btl_tcp_component.tcp_max_connections);
+    mca_btl_tcp_param_register_int ("idle_timeout",
+                                    "Close the TCP connections that have not been used for this number of "
+                                    "seconds. They are transparently reestablished by the next send. "
+                                    "0 keeps the connections open until finalize.",
+                                    0, OPAL_INFO_LVL_4, &mca_btl_tcp_component.tcp_idle_timeout);
+    mca_btl_tcp_conn_cache_register();
     mca_btl_tcp_component.report_all_unfound_interfaces = false;
     (void) mca_base_component_var_register(&mca_btl_tcp_component.super.btl_version,
                                            "warn_all_unfound_interfaces",
@@ -412,6 +437,12 @@ static int mca_btl_tcp_component_close(void)
 {
     mca_btl_tcp_event_t *event, *next;
 
+#if OPAL_BTL_TCP_HAVE_EPOLL
+    /* stop the I/O threads before releasing the fragments they may hold */
+    mca_btl_tcp_epoll_fini();
+#endif  /* OPAL_BTL_TCP_HAVE_EPOLL */
+    mca_btl_tcp_conn_cache_fini();
+
     /**
      * If we have a progress thread we should shut it down before
      * moving forward with the TCP tearing down process.
@@ -1329,6 +1360,17 @@ mca_btl_base_module_t** mca_btl_tcp_component_init(int *num_btl_modules,
         return NULL;
     }
 
+#if OPAL_BTL_TCP_HAVE_EPOLL
+    /* start the epoll I/O threads, or fall back on libevent for the data path */
+    if (0 < mca_btl_tcp_component.tcp_epoll_threads) {
+        if (OPAL_SUCCESS == mca_btl_tcp_epoll_init()) {
+            mca_btl_tcp_component.super.btl_progress = mca_btl_tcp_epoll_progress;
+        } else {
+            mca_btl_tcp_component.tcp_epoll_threads = 0;
+        }
+    }
+#endif  /* OPAL_BTL_TCP_HAVE_EPOLL */
+
     /* Register the btl to support the progress_thread */
     if (0 < mca_btl_tcp_progress_thread_trigger) {
         for( i = 0; i < mca_btl_tcp_component.tcp_num_btls; i++) {
@@ -1348,12 +1390,19 @@ mca_btl_base_module_t** mca_btl_tcp_component_init(int *num_btl_modules,
        problem until we can come up with a more complete fix to how we
        initialize procs, endpoints, and modules in the TCP BTL. */
     if (mca_btl_tcp_component.tcp_num_btls > 1 &&
-        (enable_mpi_threads || 0 < mca_btl_tcp_progress_thread_trigger)) {
+        (enable_mpi_threads || 0 < mca_btl_tcp_progress_thread_trigger
+#if OPAL_BTL_TCP_HAVE_EPOLL
+         || 0 < mca_btl_tcp_component.tcp_epoll_threads
+#endif  /* OPAL_BTL_TCP_HAVE_EPOLL */
+         )) {
         for( i = 0; i < mca_btl_tcp_component.tcp_num_btls; i++) {
             mca_btl_tcp_component.tcp_btls[i]->super.btl_flags |= MCA_BTL_FLAGS_SINGLE_ADD_PROCS;
         }
     }
 
+    /* start closing the idle connections if requested */
+    (void) mca_btl_tcp_conn_cache_init();
+
 #if OPAL_CUDA_SUPPORT
     mca_common_cuda_stage_one_init();
 #endif /* OPAL_CUDA_SUPPORT */
@@ -0,0 +1,270 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ */
+
+#include "opal_config.h"
+
+#include <stdlib.h>
+
+#include "opal/mca/base/mca_base_pvar.h"
+#include "opal/mca/event/event.h"
+#include "opal/mca/threads/mutex.h"
+
+#include "btl_tcp.h"
+#include "btl_tcp_endpoint.h"
+#include "btl_tcp_conn_cache.h"
+
+/* period of the idle sweep, in seconds. This is also the resolution of
+ * btl_tcp_idle_timeout. */
+#define MCA_BTL_TCP_IDLE_SWEEP_PERIOD 1
+
+void mca_btl_tcp_conn_cache_register(void)
+{
+    mca_base_var_type_t pvar_type;
+
+    /* the counters are size_t, which is not a valid type for these
+     * classes of pvars. Use the unsigned type of the same size. */
+    if (sizeof(size_t) == sizeof(unsigned int)) {
+        pvar_type = MCA_BASE_VAR_TYPE_UNSIGNED_INT;
+    } else if (sizeof(size_t) == sizeof(unsigned long)) {
+        pvar_type = MCA_BASE_VAR_TYPE_UNSIGNED_LONG;
+    } else {
+        pvar_type = MCA_BASE_VAR_TYPE_UNSIGNED_LONG_LONG;
+    }
+
+    mca_btl_tcp_component.tcp_num_connections = 0;
+    (void) mca_base_component_pvar_register(&mca_btl_tcp_component.super.btl_version,
+                                            "connections", "Number of TCP connections currently open",
+                                            OPAL_INFO_LVL_4, MCA_BASE_PVAR_CLASS_LEVEL,
+                                            pvar_type, NULL, MCA_BASE_VAR_BIND_NO_OBJECT,
+                                            MCA_BASE_PVAR_FLAG_READONLY | MCA_BASE_PVAR_FLAG_CONTINUOUS,
+                                            NULL, NULL, NULL,
+                                            (void *) &mca_btl_tcp_component.tcp_num_connections);
+    mca_btl_tcp_component.tcp_connections_highwater = 0;
+    (void) mca_base_component_pvar_register(&mca_btl_tcp_component.super.btl_version,
+                                            "connections_highwater", "Maximum number of TCP connections "
+                                            "simultaneously open", OPAL_INFO_LVL_4,
+                                            MCA_BASE_PVAR_CLASS_HIGHWATERMARK,
+                                            pvar_type, NULL, MCA_BASE_VAR_BIND_NO_OBJECT,
+                                            MCA_BASE_PVAR_FLAG_READONLY | MCA_BASE_PVAR_FLAG_CONTINUOUS,
+                                            NULL, NULL, NULL,
+                                            (void *) &mca_btl_tcp_component.tcp_connections_highwater);
+    mca_btl_tcp_component.tcp_connections_opened = 0;
+    (void) mca_base_component_pvar_register(&mca_btl_tcp_component.super.btl_version,
+                                            "connections_opened", "Number of TCP connections established",
+                                            OPAL_INFO_LVL_4, MCA_BASE_PVAR_CLASS_COUNTER,
+                                            pvar_type, NULL, MCA_BASE_VAR_BIND_NO_OBJECT,
+                                            MCA_BASE_PVAR_FLAG_READONLY | MCA_BASE_PVAR_FLAG_CONTINUOUS,
+                                            NULL, NULL, NULL,
+                                            (void *) &mca_btl_tcp_component.tcp_connections_opened);
+    mca_btl_tcp_component.tcp_connections_reopened = 0;
+    (void) mca_base_component_pvar_register(&mca_btl_tcp_component.super.btl_version,
+                                            "connections_reopened", "Number of TCP connections reestablished "
+                                            "after having been closed for being idle",
+                                            OPAL_INFO_LVL_4, MCA_BASE_PVAR_CLASS_COUNTER,
+                                            pvar_type, NULL, MCA_BASE_VAR_BIND_NO_OBJECT,
+                                            MCA_BASE_PVAR_FLAG_READONLY | MCA_BASE_PVAR_FLAG_CONTINUOUS,
+                                            NULL, NULL, NULL,
+                                            (void *) &mca_btl_tcp_component.tcp_connections_reopened);
+    mca_btl_tcp_component.tcp_connections_idle_closed = 0;
+    (void) mca_base_component_pvar_register(&mca_btl_tcp_component.super.btl_version,
+                                            "connections_idle_closed", "Number of TCP connections closed "
+                                            "after btl_tcp_idle_timeout seconds without traffic",
+                                            OPAL_INFO_LVL_4, MCA_BASE_PVAR_CLASS_COUNTER,
+                                            pvar_type, NULL, MCA_BASE_VAR_BIND_NO_OBJECT,
+                                            MCA_BASE_PVAR_FLAG_READONLY | MCA_BASE_PVAR_FLAG_CONTINUOUS,
+                                            NULL, NULL, NULL,
+                                            (void *) &mca_btl_tcp_component.tcp_connections_idle_closed);
+    mca_btl_tcp_component.tcp_connections_evicted = 0;
+    (void) mca_base_component_pvar_register(&mca_btl_tcp_component.super.btl_version,
+                                            "connections_evicted", "Number of TCP connections closed to "
+                                            "stay under btl_tcp_max_connections",
+                                            OPAL_INFO_LVL_4, MCA_BASE_PVAR_CLASS_COUNTER,
+                                            pvar_type, NULL, MCA_BASE_VAR_BIND_NO_OBJECT,
+                                            MCA_BASE_PVAR_FLAG_READONLY | MCA_BASE_PVAR_FLAG_CONTINUOUS,
+                                            NULL, NULL, NULL,
+                                            (void *) &mca_btl_tcp_component.tcp_connections_evicted);
+}
+
+/* least recently used first */
+static int mca_btl_tcp_conn_cache_lru_cmp(const void *a, const void *b)
+{
+    const mca_btl_base_endpoint_t *ea = *(mca_btl_base_endpoint_t * const *) a;
+    const mca_btl_base_endpoint_t *eb = *(mca_btl_base_endpoint_t * const *) b;
+
+    return (ea->endpoint_idle_ticks < eb->endpoint_idle_ticks) -
+           (ea->endpoint_idle_ticks > eb->endpoint_idle_ticks);
+}
+
+/*
+ * Walk all the connected endpoints. Triggered periodically from the
+ * tcp_idle_event, where it ages the connections and closes the ones
+ * over the idle timeout, and from the tcp_evict_event when a new
+ * connection goes over the cap.
+ */
+static void mca_btl_tcp_conn_cache_sweep(int fd, short flags, void *context)
+{
+    bool periodic = (context == (void *) &mca_btl_tcp_component.tcp_idle_event);
+    size_t max_connections = (size_t) mca_btl_tcp_component.tcp_max_connections;
+    uint32_t idle_ticks = (uint32_t) ((mca_btl_tcp_component.tcp_idle_timeout +
+                                       MCA_BTL_TCP_IDLE_SWEEP_PERIOD - 1) /
+                                      MCA_BTL_TCP_IDLE_SWEEP_PERIOD);
+    mca_btl_base_endpoint_t **lru = NULL, *btl_endpoint;
+    size_t nlru = 0, count = 0, num_connections;
+    uint32_t i;
+
+    /* the cap is per process, look at all the modules at once */
+    for (i = 0; i < mca_btl_tcp_component.tcp_num_btls; i++) {
+        OPAL_THREAD_LOCK(&mca_btl_tcp_component.tcp_btls[i]->tcp_endpoints_mutex);
+        count += opal_list_get_size(&mca_btl_tcp_component.tcp_btls[i]->tcp_endpoints);
+    }
+    if (0 < max_connections && 0 < count) {
+        lru = (mca_btl_base_endpoint_t **) malloc(count * sizeof(mca_btl_base_endpoint_t *));
+    }
+
+    for (i = 0; i < mca_btl_tcp_component.tcp_num_btls; i++) {
+        OPAL_LIST_FOREACH(btl_endpoint, &mca_btl_tcp_component.tcp_btls[i]->tcp_endpoints,
+                          mca_btl_base_endpoint_t) {
+            if (MCA_BTL_TCP_CONNECTED != btl_endpoint->endpoint_state) {
+                continue;
+            }
+            if (btl_endpoint->endpoint_used) {
+                if (periodic) {
+                    btl_endpoint->endpoint_used = false;
+                    btl_endpoint->endpoint_idle_ticks = 0;
+                }
+                continue;
+            }
+            if (periodic) {
+                btl_endpoint->endpoint_idle_ticks++;
+            }
+            if (0 < idle_ticks && btl_endpoint->endpoint_idle_ticks >= idle_ticks) {
+                if (OPAL_SUCCESS == mca_btl_tcp_endpoint_idle_close(btl_endpoint)) {
+                    (void) OPAL_THREAD_ADD_FETCH_SIZE_T(&mca_btl_tcp_component.tcp_connections_idle_closed, 1);
+                }
+                continue;
+            }
+            if (NULL != lru) {
+                lru[nlru++] = btl_endpoint;
+            }
+        }
+    }
+
+    /* evict the least recently used connections until we are back under
+     * the cap. Connections used since the last sweep are not candidates. */
+    num_connections = mca_btl_tcp_component.tcp_num_connections;
+    if (0 < nlru && num_connections > max_connections) {
+        qsort(lru, nlru, sizeof(mca_btl_base_endpoint_t *), mca_btl_tcp_conn_cache_lru_cmp);
+        for (size_t k = 0; k < nlru && num_connections > max_connections; k++) {
+            if (OPAL_SUCCESS == mca_btl_tcp_endpoint_idle_close(lru[k])) {
+                (void) OPAL_THREAD_ADD_FETCH_SIZE_T(&mca_btl_tcp_component.tcp_connections_evicted, 1);
+                num_connections--;
+            }
+        }
+    }
+
+    for (i = mca_btl_tcp_component.tcp_num_btls; i > 0; i--) {
+        OPAL_THREAD_UNLOCK(&mca_btl_tcp_component.tcp_btls[i - 1]->tcp_endpoints_mutex);
+    }
+    free(lru);
+
+    if (periodic) {
+        struct timeval period = {MCA_BTL_TCP_IDLE_SWEEP_PERIOD, 0};
+        opal_event_add(&mca_btl_tcp_component.tcp_idle_event, &period);
+    }
+}
+
+int mca_btl_tcp_conn_cache_init(void)
+{
+    struct timeval period = {MCA_BTL_TCP_IDLE_SWEEP_PERIOD, 0};
+
+    if (0 >= mca_btl_tcp_component.tcp_idle_timeout &&
+        0 >= mca_btl_tcp_component.tcp_max_connections) {
+        return OPAL_SUCCESS;
+    }
+
+    opal_event_evtimer_set(mca_btl_tcp_event_base, &mca_btl_tcp_component.tcp_idle_event,
+                           mca_btl_tcp_conn_cache_sweep, &mca_btl_tcp_component.tcp_idle_event);
+    opal_event_evtimer_set(mca_btl_tcp_event_base, &mca_btl_tcp_component.tcp_evict_event,
+                           mca_btl_tcp_conn_cache_sweep, &mca_btl_tcp_component.tcp_evict_event);
+    opal_event_add(&mca_btl_tcp_component.tcp_idle_event, &period);
+    mca_btl_tcp_component.tcp_idle_event_added = true;
+    return OPAL_SUCCESS;
+}
+
+void mca_btl_tcp_conn_cache_fini(void)
+{
+    if (!mca_btl_tcp_component.tcp_idle_event_added) {
+        return;
+    }
+    opal_event_del(&mca_btl_tcp_component.tcp_idle_event);
+    opal_event_del(&mca_btl_tcp_component.tcp_evict_event);
+    mca_btl_tcp_component.tcp_idle_event_added = false;
+}
+
+void mca_btl_tcp_conn_cache_opened(mca_btl_base_endpoint_t *btl_endpoint)
+{
+    (void) OPAL_THREAD_ADD_FETCH_SIZE_T(&mca_btl_tcp_component.tcp_connections_opened, 1);
+    if (btl_endpoint->endpoint_idle_closed) {
+        btl_endpoint->endpoint_idle_closed = false;
+        (void) OPAL_THREAD_ADD_FETCH_SIZE_T(&mca_btl_tcp_component.tcp_connections_reopened, 1);
+    }
+    /* a new connection is about to be used, do not pick it for eviction */
+    btl_endpoint->endpoint_used = true;
+    btl_endpoint->endpoint_idle_ticks = 0;
+    mca_btl_tcp_conn_cache_add(btl_endpoint);
+}
+
+void mca_btl_tcp_conn_cache_add(mca_btl_base_endpoint_t *btl_endpoint)
+{
+    size_t num_connections, highwater;
+
+    if (btl_endpoint->endpoint_counted) {
+        return;
+    }
+    btl_endpoint->endpoint_counted = true;
+    num_connections = OPAL_THREAD_ADD_FETCH_SIZE_T(&mca_btl_tcp_component.tcp_num_connections, 1);
+    /* connections may be added concurrently, do not let a smaller count win */
+    highwater = mca_btl_tcp_component.tcp_connections_highwater;
+    while (num_connections > highwater) {
+#if SIZEOF_SIZE_T == 8
+        int64_t expected = (int64_t) highwater;
+        if (opal_atomic_compare_exchange_strong_64((opal_atomic_int64_t *) &mca_btl_tcp_component.tcp_connections_highwater,
+                                                   &expected, (int64_t) num_connections)) {
+            break;
+        }
+#else
+        int32_t expected = (int32_t) highwater;
+        if (opal_atomic_compare_exchange_strong_32((opal_atomic_int32_t *) &mca_btl_tcp_component.tcp_connections_highwater,
+                                                   &expected, (int32_t) num_connections)) {
+            break;
+        }
+#endif
+        highwater = (size_t) expected;
+    }
+
+    if (mca_btl_tcp_component.tcp_idle_event_added &&
+        0 < mca_btl_tcp_component.tcp_max_connections &&
+        num_connections > (size_t) mca_btl_tcp_component.tcp_max_connections) {
+        struct timeval now = {0, 0};
+        opal_event_add(&mca_btl_tcp_component.tcp_evict_event, &now);
+    }
+}
+
+void mca_btl_tcp_conn_cache_remove(mca_btl_base_endpoint_t *btl_endpoint)
+{
+    if (!btl_endpoint->endpoint_counted) {
+        return;
+    }
+    btl_endpoint->endpoint_counted = false;
+    (void) OPAL_THREAD_SUB_FETCH_SIZE_T(&mca_btl_tcp_component.tcp_num_connections, 1);
+}
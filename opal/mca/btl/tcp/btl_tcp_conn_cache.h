@@ -0,0 +1,66 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+/**
+ * @file
+ *
+ * Bounded connection cache for the TCP BTL. Connections are opened on
+ * demand by the first send, and closed again, using the IDLE handshake
+ * described in btl_tcp_hdr.h, when they have not been used for
+ * btl_tcp_idle_timeout seconds or when the process holds more than
+ * btl_tcp_max_connections of them. In the latter case the least recently
+ * used connections are evicted first. Connections with traffic in flight
+ * are never evicted, so the cap is a soft limit.
+ */
+#ifndef MCA_BTL_TCP_CONN_CACHE_H
+#define MCA_BTL_TCP_CONN_CACHE_H
+
+#include "opal_config.h"
+
+BEGIN_C_DECLS
+
+struct mca_btl_base_endpoint_t;
+
+/**
+ * Register the performance variables exposing the connection churn.
+ */
+void mca_btl_tcp_conn_cache_register(void);
+
+/**
+ * Start the idle sweep if a timeout or a connection cap is set.
+ * Must be called once the TCP event base is known.
+ */
+int mca_btl_tcp_conn_cache_init(void);
+
+/**
+ * Remove the idle sweep events from the event base.
+ */
+void mca_btl_tcp_conn_cache_fini(void);
+
+/**
+ * A connection to the endpoint has just been established.
+ */
+void mca_btl_tcp_conn_cache_opened(struct mca_btl_base_endpoint_t *btl_endpoint);
+
+/**
+ * Account the endpoint connection toward the cap, and schedule an
+ * eviction if it goes over.
+ */
+void mca_btl_tcp_conn_cache_add(struct mca_btl_base_endpoint_t *btl_endpoint);
+
+/**
+ * Stop accounting the endpoint connection toward the cap.
+ */
+void mca_btl_tcp_conn_cache_remove(struct mca_btl_base_endpoint_t *btl_endpoint);
+
+END_C_DECLS
+
+#endif  /* MCA_BTL_TCP_CONN_CACHE_H */
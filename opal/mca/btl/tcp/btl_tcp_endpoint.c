@@ -66,6 +66,8 @@
 #include "btl_tcp_proc.h"
 #include "btl_tcp_frag.h"
 #include "btl_tcp_addr.h"
+#include "btl_tcp_epoll.h"
+#include "btl_tcp_conn_cache.h"
 
 /*
  * Magic ID string send during connect/accept handshake
@@ -89,11 +91,20 @@ static void mca_btl_tcp_endpoint_construct(mca_btl_tcp_endpoint_t* endpoint)
     endpoint->endpoint_state = MCA_BTL_TCP_CLOSED;
     endpoint->endpoint_retries = 0;
     endpoint->endpoint_nbo = false;
+    endpoint->endpoint_used = false;
+    endpoint->endpoint_idle_ticks = 0;
+    endpoint->endpoint_counted = false;
+    endpoint->endpoint_idle_closed = false;
 #if MCA_BTL_TCP_ENDPOINT_CACHE
     endpoint->endpoint_cache        = NULL;
     endpoint->endpoint_cache_pos    = NULL;
     endpoint->endpoint_cache_length = 0;
 #endif  /* MCA_BTL_TCP_ENDPOINT_CACHE */
+#if OPAL_BTL_TCP_HAVE_EPOLL
+    endpoint->endpoint_io_thread = NULL;
+    endpoint->endpoint_epoll_registered = false;
+    endpoint->endpoint_close_posted = false;
+#endif  /* OPAL_BTL_TCP_HAVE_EPOLL */
     OBJ_CONSTRUCT(&endpoint->endpoint_frags, opal_list_t);
     OBJ_CONSTRUCT(&endpoint->endpoint_send_lock, opal_mutex_t);
     OBJ_CONSTRUCT(&endpoint->endpoint_recv_lock, opal_mutex_t);
@@ -106,6 +117,9 @@ static void mca_btl_tcp_endpoint_construct(mca_btl_tcp_endpoint_t* endpoint)
 static void mca_btl_tcp_endpoint_destruct(mca_btl_tcp_endpoint_t* endpoint)
 {
     mca_btl_tcp_endpoint_close(endpoint);
+#if OPAL_BTL_TCP_HAVE_EPOLL
+    mca_btl_tcp_epoll_quiesce(endpoint);
+#endif  /* OPAL_BTL_TCP_HAVE_EPOLL */
     mca_btl_tcp_proc_remove(endpoint->endpoint_proc, endpoint);
     OBJ_DESTRUCT(&endpoint->endpoint_frags);
     OBJ_DESTRUCT(&endpoint->endpoint_send_lock);
@@ -216,6 +230,10 @@ mca_btl_tcp_endpoint_dump(int level,
         used += snprintf(&outmsg[used], DEBUG_LENGTH - used, ":%s]", "connected");
         if (used >= DEBUG_LENGTH) goto out;
         break;
+    case MCA_BTL_TCP_CLOSING:
+        used += snprintf(&outmsg[used], DEBUG_LENGTH - used, ":%s]", "closing");
+        if (used >= DEBUG_LENGTH) goto out;
+        break;
     default:
         used += snprintf(&outmsg[used], DEBUG_LENGTH - used, ":%s]", "unknown");
         if (used >= DEBUG_LENGTH) goto out;
@@ -334,14 +352,21 @@ int mca_btl_tcp_endpoint_send(mca_btl_base_endpoint_t* btl_endpoint, mca_btl_tcp
 {
     int rc = OPAL_SUCCESS;
 
+    btl_endpoint->endpoint_used = true;
     OPAL_THREAD_LOCK(&btl_endpoint->endpoint_send_lock);
     switch(btl_endpoint->endpoint_state) {
     case MCA_BTL_TCP_CONNECTING:
     case MCA_BTL_TCP_CONNECT_ACK:
     case MCA_BTL_TCP_CLOSED:
+    case MCA_BTL_TCP_CLOSING:
         opal_list_append(&btl_endpoint->endpoint_frags, (opal_list_item_t*)frag);
         frag->base.des_flags |= MCA_BTL_DES_SEND_ALWAYS_CALLBACK;
-        if(btl_endpoint->endpoint_state == MCA_BTL_TCP_CLOSED)
+        if(btl_endpoint->endpoint_state == MCA_BTL_TCP_CLOSED
+#if OPAL_BTL_TCP_HAVE_EPOLL
+           /* the old socket is still open, the close reconnects */
+           && !btl_endpoint->endpoint_close_posted
+#endif  /* OPAL_BTL_TCP_HAVE_EPOLL */
+           )
             rc = mca_btl_tcp_endpoint_start_connect(btl_endpoint);
         break;
     case MCA_BTL_TCP_FAILED:
@@ -366,6 +391,12 @@ int mca_btl_tcp_endpoint_send(mca_btl_base_endpoint_t* btl_endpoint, mca_btl_tcp
                 btl_endpoint->endpoint_send_frag = frag;
                 MCA_BTL_TCP_ENDPOINT_DUMP(10, btl_endpoint, true, "event_add(send) [endpoint_send]");
                 frag->base.des_flags |= MCA_BTL_DES_SEND_ALWAYS_CALLBACK;
+#if OPAL_BTL_TCP_HAVE_EPOLL
+                if( btl_endpoint->endpoint_epoll_registered ) {
+                    mca_btl_tcp_epoll_rearm(btl_endpoint);
+                    break;
+                }
+#endif  /* OPAL_BTL_TCP_HAVE_EPOLL */
                 MCA_BTL_TCP_ACTIVATE_EVENT(&btl_endpoint->endpoint_send_event, 0);
             }
         } else {
@@ -440,6 +471,14 @@ static void *mca_btl_tcp_endpoint_complete_accept(int fd, int flags, void *conte
         opal_event_add(&btl_endpoint->endpoint_accept_event, &now);
         return NULL;
     }
+    if( MCA_BTL_TCP_CLOSING == btl_endpoint->endpoint_state ) {
+        /* The peer is reconnecting while we are still draining the idle
+         * connection. Wait for its IDLE_ACK before switching sockets. */
+        OPAL_THREAD_UNLOCK(&btl_endpoint->endpoint_send_lock);
+        OPAL_THREAD_UNLOCK(&btl_endpoint->endpoint_recv_lock);
+        opal_event_add(&btl_endpoint->endpoint_accept_event, &now);
+        return NULL;
+    }
 
     if(NULL == btl_endpoint->endpoint_addr) {
         CLOSE_THE_SOCKET(btl_endpoint->endpoint_sd_next); /* No further use of this socket. Close it */
@@ -522,12 +561,29 @@ void mca_btl_tcp_endpoint_close(mca_btl_base_endpoint_t* btl_endpoint)
     MCA_BTL_TCP_ENDPOINT_DUMP(1, btl_endpoint, false, "[close]");
     if(btl_endpoint->endpoint_sd < 0)
         return;
+#if OPAL_BTL_TCP_HAVE_EPOLL
+    if( mca_btl_tcp_epoll_post_close(btl_endpoint) ) {
+        /* called from the I/O thread, which must not report to the upper
+         * layer: mca_btl_tcp_endpoint_complete_close does the rest */
+        return;
+    }
+#endif  /* OPAL_BTL_TCP_HAVE_EPOLL */
     btl_endpoint->endpoint_retries++;
-    MCA_BTL_TCP_ENDPOINT_DUMP(1, btl_endpoint, false, "event_del(recv) [close]");
-    opal_event_del(&btl_endpoint->endpoint_recv_event);
-    if( mca_btl_tcp_event_base == opal_sync_event_base ) {
-        /* If no progress thread then lower the awarness of the default progress engine */
-        opal_progress_event_users_decrement();
+    mca_btl_tcp_conn_cache_remove(btl_endpoint);
+#if OPAL_BTL_TCP_HAVE_EPOLL
+    if( btl_endpoint->endpoint_epoll_registered ) {
+        /* the socket was handed to an I/O thread, the default progress
+         * engine awareness has been lowered at that time */
+        mca_btl_tcp_epoll_del(btl_endpoint);
+    } else
+#endif  /* OPAL_BTL_TCP_HAVE_EPOLL */
+    {
+        MCA_BTL_TCP_ENDPOINT_DUMP(1, btl_endpoint, false, "event_del(recv) [close]");
+        opal_event_del(&btl_endpoint->endpoint_recv_event);
+        if( mca_btl_tcp_event_base == opal_sync_event_base ) {
+            /* If no progress thread then lower the awarness of the default progress engine */
+            opal_progress_event_users_decrement();
+        }
     }
     MCA_BTL_TCP_ENDPOINT_DUMP(1, btl_endpoint, false, "event_del(send) [close]");
     opal_event_del(&btl_endpoint->endpoint_send_event);
@@ -582,6 +638,35 @@ void mca_btl_tcp_endpoint_close(mca_btl_base_endpoint_t* btl_endpoint)
     }
 }
 
+#if OPAL_BTL_TCP_HAVE_EPOLL
+/*
+ * Close a connection on behalf of the I/O thread which saw it fail or
+ * end, see mca_btl_tcp_epoll_post_close. Called from the progress
+ * function. If reconnect is set, fragments queued while the close was
+ * pending restart the connection, unless it failed.
+ */
+void mca_btl_tcp_endpoint_complete_close(mca_btl_base_endpoint_t* btl_endpoint, bool reconnect)
+{
+    bool idle;
+
+    OPAL_THREAD_LOCK(&btl_endpoint->endpoint_recv_lock);
+    OPAL_THREAD_LOCK(&btl_endpoint->endpoint_send_lock);
+    btl_endpoint->endpoint_close_posted = false;
+    idle = (MCA_BTL_TCP_CLOSING == btl_endpoint->endpoint_state);
+    mca_btl_tcp_endpoint_close(btl_endpoint);
+    if( idle ) {
+        btl_endpoint->endpoint_retries = 0;
+        MCA_BTL_TCP_ENDPOINT_DUMP(10, btl_endpoint, false, "idle connection closed [complete_close]");
+    }
+    if( reconnect && (MCA_BTL_TCP_CLOSED == btl_endpoint->endpoint_state) &&
+        (opal_list_get_size(&btl_endpoint->endpoint_frags) > 0) ) {
+        (void)mca_btl_tcp_endpoint_start_connect(btl_endpoint);
+    }
+    OPAL_THREAD_UNLOCK(&btl_endpoint->endpoint_send_lock);
+    OPAL_THREAD_UNLOCK(&btl_endpoint->endpoint_recv_lock);
+}
+#endif  /* OPAL_BTL_TCP_HAVE_EPOLL */
+
 /*
  *  Setup endpoint state to reflect that connection has been established,
  *  and start any pending sends. This function should be called with the
@@ -595,11 +680,24 @@ static void mca_btl_tcp_endpoint_connected(mca_btl_base_endpoint_t* btl_endpoint
     btl_endpoint->endpoint_state = MCA_BTL_TCP_CONNECTED;
     btl_endpoint->endpoint_retries = 0;
     MCA_BTL_TCP_ENDPOINT_DUMP(1, btl_endpoint, true, "READY [endpoint_connected]");
+    mca_btl_tcp_conn_cache_opened(btl_endpoint);
 
     if(opal_list_get_size(&btl_endpoint->endpoint_frags) > 0) {
         if(NULL == btl_endpoint->endpoint_send_frag)
             btl_endpoint->endpoint_send_frag = (mca_btl_tcp_frag_t*)
                 opal_list_remove_first(&btl_endpoint->endpoint_frags);
+    }
+
+#if OPAL_BTL_TCP_HAVE_EPOLL
+    /* From now on the data path is handled by an I/O thread. The initial
+     * EPOLLOUT notification takes care of the pending fragments. */
+    if( 0 < mca_btl_tcp_component.tcp_epoll_threads &&
+        OPAL_SUCCESS == mca_btl_tcp_epoll_add(btl_endpoint) ) {
+        return;
+    }
+#endif  /* OPAL_BTL_TCP_HAVE_EPOLL */
+
+    if(NULL != btl_endpoint->endpoint_send_frag) {
         MCA_BTL_TCP_ENDPOINT_DUMP(10, btl_endpoint, true, "event_add(send) [endpoint_connected]");
         opal_event_add(&btl_endpoint->endpoint_send_event, 0);
     }
@@ -989,9 +1087,11 @@ static void mca_btl_tcp_endpoint_recv_handler(int sd, short flags, void* user)
             return;
         }
     case MCA_BTL_TCP_CONNECTED:
+    case MCA_BTL_TCP_CLOSING:
         {
             mca_btl_tcp_frag_t* frag;
 
+            btl_endpoint->endpoint_used = true;
             frag = btl_endpoint->endpoint_recv_frag;
             if(NULL == frag) {
                 if(mca_btl_tcp_module.super.btl_max_send_size >
@@ -1116,6 +1216,11 @@ static void mca_btl_tcp_endpoint_send_handler(int sd, short flags, void* user)
             opal_event_del(&btl_endpoint->endpoint_send_event);
         }
         break;
+    case MCA_BTL_TCP_CLOSING:
+        /* nothing is sent until the peer answered the idle request */
+        MCA_BTL_TCP_ENDPOINT_DUMP(10, btl_endpoint, false, "event_del(send) [endpoint_send_handler:closing]");
+        opal_event_del(&btl_endpoint->endpoint_send_event);
+        break;
     case MCA_BTL_TCP_FAILED:
         MCA_BTL_TCP_ENDPOINT_DUMP(1, btl_endpoint, true, "event_del(send) [endpoint_send_handler:error]");
         opal_event_del(&btl_endpoint->endpoint_send_event);
@@ -1128,3 +1233,184 @@ static void mca_btl_tcp_endpoint_send_handler(int sd, short flags, void* user)
     }
     OPAL_THREAD_UNLOCK(&btl_endpoint->endpoint_send_lock);
 }
+
+
+/*
+ * Completion callback of the IDLE_NACK control fragments. There is no
+ * upper layer to notify, the fragment is released by the BTL.
+ */
+static void mca_btl_tcp_endpoint_ctl_complete(struct mca_btl_base_module_t* btl,
+                                              struct mca_btl_base_endpoint_t* endpoint,
+                                              struct mca_btl_base_descriptor_t* descriptor,
+                                              int status)
+{
+}
+
+/*
+ * Close the socket of an idle connection once both sides agreed on it,
+ * and restart the connection if fragments were queued in the meantime.
+ * Called with both locks held.
+ */
+static void mca_btl_tcp_endpoint_idle_release(mca_btl_base_endpoint_t* btl_endpoint)
+{
+    /* not in the CONNECTED state anymore: no FIN is sent */
+    btl_endpoint->endpoint_state = MCA_BTL_TCP_CLOSING;
+    mca_btl_tcp_endpoint_close(btl_endpoint);
+    btl_endpoint->endpoint_idle_closed = true;
+#if OPAL_BTL_TCP_HAVE_EPOLL
+    if( btl_endpoint->endpoint_close_posted ) {
+        /* the socket is closed later, and the connection restarted then */
+        return;
+    }
+#endif  /* OPAL_BTL_TCP_HAVE_EPOLL */
+    btl_endpoint->endpoint_retries = 0;
+    MCA_BTL_TCP_ENDPOINT_DUMP(10, btl_endpoint, false, "idle connection closed [idle_release]");
+
+    if(opal_list_get_size(&btl_endpoint->endpoint_frags) > 0) {
+        (void)mca_btl_tcp_endpoint_start_connect(btl_endpoint);
+    }
+}
+
+/*
+ * The receive handlers keep a fragment ready for the next incoming
+ * message. Only consider it busy if some data already landed in it.
+ */
+static inline bool mca_btl_tcp_endpoint_recv_in_progress(mca_btl_base_endpoint_t* btl_endpoint)
+{
+    mca_btl_tcp_frag_t* frag = btl_endpoint->endpoint_recv_frag;
+
+    return (NULL != frag) &&
+           ((0 != frag->iov_idx) || (sizeof(frag->hdr) != frag->iov[0].iov_len));
+}
+
+/*
+ * Ask the peer to close a connection that is currently unused. The
+ * endpoint moves to the CLOSING state, where new fragments are queued
+ * until the peer answers. Returns OPAL_ERR_RESOURCE_BUSY if there is
+ * any pending traffic on the connection.
+ */
+int mca_btl_tcp_endpoint_idle_close(mca_btl_base_endpoint_t* btl_endpoint)
+{
+    mca_btl_tcp_hdr_t idle_msg = {
+        .base.tag = 0,
+        .type = MCA_BTL_TCP_HDR_TYPE_IDLE_REQ,
+        .count = 0,
+        .size = 0,
+    };
+    int rc = OPAL_ERR_RESOURCE_BUSY;
+
+    /* never wait on an endpoint in use, it will be reconsidered later */
+    if( OPAL_THREAD_TRYLOCK(&btl_endpoint->endpoint_recv_lock) )
+        return OPAL_ERR_RESOURCE_BUSY;
+    if( OPAL_THREAD_TRYLOCK(&btl_endpoint->endpoint_send_lock) ) {
+        OPAL_THREAD_UNLOCK(&btl_endpoint->endpoint_recv_lock);
+        return OPAL_ERR_RESOURCE_BUSY;
+    }
+
+    if( (MCA_BTL_TCP_CONNECTED != btl_endpoint->endpoint_state) ||
+        (NULL != btl_endpoint->endpoint_send_frag) ||
+        mca_btl_tcp_endpoint_recv_in_progress(btl_endpoint) ||
+        (opal_list_get_size(&btl_endpoint->endpoint_frags) > 0)
+#if MCA_BTL_TCP_ENDPOINT_CACHE
+        || (0 != btl_endpoint->endpoint_cache_length)
+#endif  /* MCA_BTL_TCP_ENDPOINT_CACHE */
+        ) {
+        goto unlock_and_return;
+    }
+
+    if( sizeof(idle_msg) != mca_btl_tcp_endpoint_send_blocking(btl_endpoint, &idle_msg,
+                                                               sizeof(idle_msg)) ) {
+        rc = OPAL_ERR_UNREACH;
+        goto unlock_and_return;
+    }
+    btl_endpoint->endpoint_state = MCA_BTL_TCP_CLOSING;
+    /* the connection does not count toward the cap anymore */
+    mca_btl_tcp_conn_cache_remove(btl_endpoint);
+    MCA_BTL_TCP_ENDPOINT_DUMP(10, btl_endpoint, false, "idle request sent [idle_close]");
+    rc = OPAL_SUCCESS;
+
+  unlock_and_return:
+    OPAL_THREAD_UNLOCK(&btl_endpoint->endpoint_send_lock);
+    OPAL_THREAD_UNLOCK(&btl_endpoint->endpoint_recv_lock);
+    return rc;
+}
+
+/*
+ * Handle the IDLE_* control messages. Called from the receive path, with
+ * the recv lock held, once the header has been entirely received.
+ */
+void mca_btl_tcp_endpoint_idle_ctl(mca_btl_base_endpoint_t* btl_endpoint, uint8_t type)
+{
+    OPAL_THREAD_LOCK(&btl_endpoint->endpoint_send_lock);
+    switch(type) {
+    case MCA_BTL_TCP_HDR_TYPE_IDLE_REQ:
+        if( MCA_BTL_TCP_CLOSING == btl_endpoint->endpoint_state ) {
+            /* Both sides decided to close at the same time. Neither of them
+             * sent anything after its request, so nothing can be lost. */
+            mca_btl_tcp_endpoint_idle_release(btl_endpoint);
+            break;
+        }
+        if( MCA_BTL_TCP_CONNECTED != btl_endpoint->endpoint_state )
+            break;
+        if( (NULL == btl_endpoint->endpoint_send_frag) &&
+            (0 == opal_list_get_size(&btl_endpoint->endpoint_frags)) ) {
+            mca_btl_tcp_hdr_t ack_msg = {
+                .base.tag = 0,
+                .type = MCA_BTL_TCP_HDR_TYPE_IDLE_ACK,
+                .count = 0,
+                .size = 0,
+            };
+            if( sizeof(ack_msg) == mca_btl_tcp_endpoint_send_blocking(btl_endpoint, &ack_msg,
+                                                                      sizeof(ack_msg)) ) {
+                mca_btl_tcp_endpoint_idle_release(btl_endpoint);
+            }
+        } else {
+            /* Data is on its way: refuse, behind the pending fragments as we
+             * cannot interleave with a partially sent fragment. */
+            mca_btl_tcp_frag_t* frag;
+
+            MCA_BTL_TCP_FRAG_ALLOC_USER(frag);
+            if( NULL == frag ) {
+                BTL_ERROR(("cannot allocate the fragment to refuse an idle close request"));
+                break;
+            }
+            MCA_BTL_TCP_FRAG_INIT_DST(frag, btl_endpoint);
+            frag->base.des_segment_count = 0;
+            frag->base.des_flags = MCA_BTL_DES_FLAGS_BTL_OWNERSHIP | MCA_BTL_DES_SEND_ALWAYS_CALLBACK;
+            frag->base.des_cbfunc = mca_btl_tcp_endpoint_ctl_complete;
+            frag->hdr.base.tag = 0;
+            frag->hdr.type = MCA_BTL_TCP_HDR_TYPE_IDLE_NACK;
+            frag->hdr.count = 0;
+            frag->hdr.size = 0;
+            frag->size = 0;
+            opal_list_append(&btl_endpoint->endpoint_frags, (opal_list_item_t*)frag);
+        }
+        break;
+    case MCA_BTL_TCP_HDR_TYPE_IDLE_ACK:
+        if( MCA_BTL_TCP_CLOSING == btl_endpoint->endpoint_state ) {
+            mca_btl_tcp_endpoint_idle_release(btl_endpoint);
+        }
+        break;
+    case MCA_BTL_TCP_HDR_TYPE_IDLE_NACK:
+        if( MCA_BTL_TCP_CLOSING != btl_endpoint->endpoint_state )
+            break;
+        /* the peer is still using the connection, resume sending */
+        btl_endpoint->endpoint_state = MCA_BTL_TCP_CONNECTED;
+        btl_endpoint->endpoint_idle_ticks = 0;
+        mca_btl_tcp_conn_cache_add(btl_endpoint);
+        if( NULL == btl_endpoint->endpoint_send_frag )
+            btl_endpoint->endpoint_send_frag = (mca_btl_tcp_frag_t*)
+                opal_list_remove_first(&btl_endpoint->endpoint_frags);
+        if( NULL != btl_endpoint->endpoint_send_frag ) {
+#if OPAL_BTL_TCP_HAVE_EPOLL
+            if( btl_endpoint->endpoint_epoll_registered ) {
+                mca_btl_tcp_epoll_rearm(btl_endpoint);
+                break;
+            }
+#endif  /* OPAL_BTL_TCP_HAVE_EPOLL */
+            MCA_BTL_TCP_ACTIVATE_EVENT(&btl_endpoint->endpoint_send_event, 0);
+        }
+        break;
+    }
+    OPAL_THREAD_UNLOCK(&btl_endpoint->endpoint_send_lock);
+}
@@ -36,7 +36,8 @@ typedef enum {
     MCA_BTL_TCP_CONNECT_ACK,
     MCA_BTL_TCP_CLOSED,
     MCA_BTL_TCP_FAILED,
-    MCA_BTL_TCP_CONNECTED
+    MCA_BTL_TCP_CONNECTED,
+    MCA_BTL_TCP_CLOSING      /**< idle close requested, waiting for the peer to acknowledge */
 } mca_btl_tcp_state_t;
 
 /**
@@ -69,6 +70,15 @@ struct mca_btl_base_endpoint_t {
     opal_event_t                    endpoint_send_event;   /**< event for async processing of send frags */
     opal_event_t                    endpoint_recv_event;   /**< event for async processing of recv frags */
     bool                            endpoint_nbo;          /**< convert headers to network byte order? */
+    volatile bool                   endpoint_used;         /**< has the connection been used since the last idle sweep? */
+    uint32_t                        endpoint_idle_ticks;   /**< number of idle sweeps without any traffic */
+    bool                            endpoint_counted;      /**< is this connection accounted in tcp_num_connections? */
+    bool                            endpoint_idle_closed;  /**< was the last connection closed for being idle? */
+#if OPAL_BTL_TCP_HAVE_EPOLL
+    struct mca_btl_tcp_io_thread_t* endpoint_io_thread;    /**< I/O thread progressing this endpoint once connected */
+    bool                            endpoint_epoll_registered; /**< is the socket currently in the I/O thread epoll set? */
+    bool                            endpoint_close_posted; /**< has the I/O thread left the close to the progress function? */
+#endif  /* OPAL_BTL_TCP_HAVE_EPOLL */
 };
 
 typedef struct mca_btl_base_endpoint_t mca_btl_base_endpoint_t;
@@ -85,9 +95,14 @@ typedef struct {
 
 void mca_btl_tcp_set_socket_options(int sd);
 void mca_btl_tcp_endpoint_close(mca_btl_base_endpoint_t*);
+#if OPAL_BTL_TCP_HAVE_EPOLL
+void mca_btl_tcp_endpoint_complete_close(mca_btl_base_endpoint_t*, bool reconnect);
+#endif  /* OPAL_BTL_TCP_HAVE_EPOLL */
 int  mca_btl_tcp_endpoint_send(mca_btl_base_endpoint_t*, struct mca_btl_tcp_frag_t*);
 void mca_btl_tcp_endpoint_accept(mca_btl_base_endpoint_t*, struct sockaddr*, int);
 void mca_btl_tcp_endpoint_shutdown(mca_btl_base_endpoint_t*);
+int  mca_btl_tcp_endpoint_idle_close(mca_btl_base_endpoint_t*);
+void mca_btl_tcp_endpoint_idle_ctl(mca_btl_base_endpoint_t*, uint8_t type);
 
 /*
  * Diagnostics: change this to "1" to enable the function
@@ -0,0 +1,590 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ *
+ */
+
+#include "opal_config.h"
+
+#if OPAL_BTL_TCP_HAVE_EPOLL
+
+#include <stdlib.h>
+#include <string.h>
+#ifdef HAVE_UNISTD_H
+#include <unistd.h>
+#endif
+#include <fcntl.h>
+#include <sys/epoll.h>
+
+#include "opal/opal_socket_errno.h"
+#include "opal/runtime/opal_progress.h"
+#include "opal/mca/btl/base/btl_base_error.h"
+
+#include "btl_tcp.h"
+#include "btl_tcp_epoll.h"
+#include "btl_tcp_endpoint.h"
+#include "btl_tcp_frag.h"
+
+#define MCA_BTL_TCP_EPOLL_EVENTS (EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET)
+
+static int mca_btl_tcp_epoll_close_posted(mca_btl_tcp_io_thread_t *io, bool reconnect);
+
+/*
+ * A file descriptor owned by an I/O thread is ready for recv. As the
+ * socket is registered edge-triggered we have to keep reading until the
+ * kernel buffer is drained, otherwise we will not be notified again.
+ * A readv returning less than what was asked for (the fragment plus the
+ * endpoint cache) means the socket has been emptied.
+ *
+ * mca_btl_tcp_frag_recv may however return an incomplete fragment
+ * without having drained the socket, e.g. when the end of its last readv
+ * went into the endpoint cache and the cache was then copied into the
+ * fragment payload. The level-triggered libevent handler gets away with
+ * it by being called back, here we keep reading as long as the fragment
+ * makes progress.
+ */
+static void mca_btl_tcp_epoll_recv_handler(mca_btl_tcp_io_thread_t *io,
+                                           mca_btl_base_endpoint_t *btl_endpoint)
+{
+    mca_btl_tcp_frag_t *frag;
+    struct iovec *iov_ptr;
+    size_t iov_len;
+
+    OPAL_THREAD_LOCK(&btl_endpoint->endpoint_recv_lock);
+    btl_endpoint->endpoint_used = true;
+    /* keep draining while an idle close is pending, the answer is in the stream */
+    while (MCA_BTL_TCP_CONNECTED == btl_endpoint->endpoint_state ||
+           MCA_BTL_TCP_CLOSING == btl_endpoint->endpoint_state) {
+        frag = btl_endpoint->endpoint_recv_frag;
+        if (NULL == frag) {
+            if (mca_btl_tcp_module.super.btl_max_send_size >
+                mca_btl_tcp_module.super.btl_eager_limit) {
+                MCA_BTL_TCP_FRAG_ALLOC_MAX(frag);
+            } else {
+                MCA_BTL_TCP_FRAG_ALLOC_EAGER(frag);
+            }
+            if (NULL == frag) {
+                /* out of fragments: re-arm the socket so that we get the
+                 * notification again once the upper layer released some */
+                mca_btl_tcp_epoll_rearm(btl_endpoint);
+                break;
+            }
+            MCA_BTL_TCP_FRAG_INIT_DST(frag, btl_endpoint);
+        }
+
+        iov_ptr = frag->iov_ptr;
+        iov_len = frag->iov_ptr->iov_len;
+        if (false == mca_btl_tcp_frag_recv(frag, btl_endpoint->endpoint_sd)) {
+            btl_endpoint->endpoint_recv_frag = frag;
+            if (iov_ptr != frag->iov_ptr || iov_len != frag->iov_ptr->iov_len) {
+                /* some data was received, the socket might not be empty */
+                continue;
+            }
+            break;
+        }
+        btl_endpoint->endpoint_recv_frag = NULL;
+
+        if (MCA_BTL_TCP_HDR_TYPE_SEND == frag->hdr.type) {
+            /* the fragment owns its data (frag + 1), hand it over as is */
+            opal_fifo_push_atomic(&io->io_recv_frags, (opal_list_item_t *) frag);
+        } else {
+            MCA_BTL_TCP_FRAG_RETURN(frag);
+        }
+    }
+    OPAL_THREAD_UNLOCK(&btl_endpoint->endpoint_recv_lock);
+}
+
+/*
+ * A file descriptor owned by an I/O thread is ready for send. Push as
+ * many pending fragments as the socket accepts.
+ */
+static void mca_btl_tcp_epoll_send_handler(mca_btl_tcp_io_thread_t *io,
+                                           mca_btl_base_endpoint_t *btl_endpoint)
+{
+    mca_btl_tcp_frag_t *frag;
+
+    OPAL_THREAD_LOCK(&btl_endpoint->endpoint_send_lock);
+    while (MCA_BTL_TCP_CONNECTED == btl_endpoint->endpoint_state &&
+           NULL != (frag = btl_endpoint->endpoint_send_frag)) {
+        if (false == mca_btl_tcp_frag_send(frag, btl_endpoint->endpoint_sd)) {
+            break;
+        }
+        btl_endpoint->endpoint_send_frag = (mca_btl_tcp_frag_t *)
+            opal_list_remove_first(&btl_endpoint->endpoint_frags);
+        opal_fifo_push_atomic(&io->io_send_frags, (opal_list_item_t *) frag);
+    }
+    OPAL_THREAD_UNLOCK(&btl_endpoint->endpoint_send_lock);
+}
+
+static void *mca_btl_tcp_epoll_engine(opal_object_t *obj)
+{
+    opal_thread_t *thread = (opal_thread_t *) obj;
+    mca_btl_tcp_io_thread_t *io = (mca_btl_tcp_io_thread_t *) thread->t_arg;
+    int max_events = mca_btl_tcp_component.tcp_epoll_max_events;
+    struct epoll_event *events;
+    int i, nevents;
+
+    events = (struct epoll_event *) malloc(max_events * sizeof(struct epoll_event));
+    if (NULL == events) {
+        BTL_ERROR(("BTL TCP I/O thread cannot allocate its event array"));
+        return NULL;
+    }
+
+    while (io->io_running) {
+        nevents = epoll_wait(io->io_epfd, events, max_events, -1);
+        if (nevents < 0) {
+            if (EINTR == errno) {
+                continue;
+            }
+            BTL_ERROR(("epoll_wait failed: %s (%d)", strerror(errno), errno));
+            break;
+        }
+
+        OPAL_THREAD_LOCK(&io->io_batch_lock);
+        for (i = 0; i < nevents; i++) {
+            mca_btl_base_endpoint_t *btl_endpoint =
+                (mca_btl_base_endpoint_t *) events[i].data.ptr;
+
+            if (NULL == btl_endpoint) {
+                /* the wakeup pipe has been closed */
+                io->io_running = false;
+                continue;
+            }
+            if (events[i].events & (EPOLLIN | EPOLLRDHUP | EPOLLHUP | EPOLLERR)) {
+                mca_btl_tcp_epoll_recv_handler(io, btl_endpoint);
+            }
+            if (events[i].events & EPOLLOUT) {
+                mca_btl_tcp_epoll_send_handler(io, btl_endpoint);
+            }
+        }
+        OPAL_THREAD_UNLOCK(&io->io_batch_lock);
+    }
+
+    free(events);
+    return NULL;
+}
+
+static void mca_btl_tcp_io_thread_release(mca_btl_tcp_io_thread_t *io)
+{
+    mca_btl_tcp_frag_t *frag;
+    opal_list_item_t *item;
+
+    /* while the endpoints are still in the epoll set */
+    (void) mca_btl_tcp_epoll_close_posted(io, false);
+
+    while (NULL != (item = opal_list_remove_first(&io->io_held_recv)) ||
+           NULL != (item = opal_fifo_pop_atomic(&io->io_recv_frags))) {
+        frag = (mca_btl_tcp_frag_t *) item;
+        MCA_BTL_TCP_FRAG_RETURN(frag);
+    }
+    while (NULL != (item = opal_list_remove_first(&io->io_held_send)) ||
+           NULL != (item = opal_fifo_pop_atomic(&io->io_send_frags))) {
+        frag = (mca_btl_tcp_frag_t *) item;
+        if (frag->base.des_flags & MCA_BTL_DES_FLAGS_BTL_OWNERSHIP) {
+            MCA_BTL_TCP_FRAG_RETURN(frag);
+        }
+    }
+    if (-1 != io->io_pipe[0]) {
+        close(io->io_pipe[0]);
+    }
+    if (-1 != io->io_pipe[1]) {
+        close(io->io_pipe[1]);
+    }
+    if (-1 != io->io_epfd) {
+        close(io->io_epfd);
+    }
+    OBJ_DESTRUCT(&io->io_recv_frags);
+    OBJ_DESTRUCT(&io->io_send_frags);
+    OBJ_DESTRUCT(&io->io_held_recv);
+    OBJ_DESTRUCT(&io->io_held_send);
+    OBJ_DESTRUCT(&io->io_closed);
+    OBJ_DESTRUCT(&io->io_lock);
+    OBJ_DESTRUCT(&io->io_batch_lock);
+    OBJ_DESTRUCT(&io->io_thread);
+}
+
+static int mca_btl_tcp_io_thread_start(mca_btl_tcp_io_thread_t *io)
+{
+    struct epoll_event ev;
+    int rc;
+
+    OBJ_CONSTRUCT(&io->io_thread, opal_thread_t);
+    OBJ_CONSTRUCT(&io->io_batch_lock, opal_mutex_t);
+    OBJ_CONSTRUCT(&io->io_recv_frags, opal_fifo_t);
+    OBJ_CONSTRUCT(&io->io_send_frags, opal_fifo_t);
+    OBJ_CONSTRUCT(&io->io_lock, opal_mutex_t);
+    OBJ_CONSTRUCT(&io->io_held_recv, opal_list_t);
+    OBJ_CONSTRUCT(&io->io_held_send, opal_list_t);
+    OBJ_CONSTRUCT(&io->io_closed, opal_value_array_t);
+    opal_value_array_init(&io->io_closed, sizeof(mca_btl_base_endpoint_t *));
+    io->io_num_deferred = 0;
+    io->io_pipe[0] = io->io_pipe[1] = -1;
+    io->io_running = false;
+
+    if (0 > (io->io_epfd = epoll_create1(EPOLL_CLOEXEC))) {
+        BTL_ERROR(("epoll_create1 failed: %s (%d)", strerror(errno), errno));
+        return OPAL_ERROR;
+    }
+    if (0 != pipe(io->io_pipe)) {
+        BTL_ERROR(("BTL TCP I/O thread cannot create its wakeup pipe: %s (%d)",
+                   strerror(errno), errno));
+        return OPAL_ERROR;
+    }
+    memset(&ev, 0, sizeof(ev));
+    ev.events = EPOLLIN;
+    ev.data.ptr = NULL;
+    if (0 != epoll_ctl(io->io_epfd, EPOLL_CTL_ADD, io->io_pipe[0], &ev)) {
+        BTL_ERROR(("epoll_ctl(ADD) failed: %s (%d)", strerror(errno), errno));
+        return OPAL_ERROR;
+    }
+
+    io->io_running = true;
+    io->io_thread.t_run = mca_btl_tcp_epoll_engine;
+    io->io_thread.t_arg = io;
+    if (OPAL_SUCCESS != (rc = opal_thread_start(&io->io_thread))) {
+        BTL_ERROR(("BTL TCP I/O thread initialization failed (%d)", rc));
+        io->io_running = false;
+        return rc;
+    }
+    return OPAL_SUCCESS;
+}
+
+static void mca_btl_tcp_io_thread_stop(mca_btl_tcp_io_thread_t *io)
+{
+    void *ret = NULL;  /* not currently used */
+
+    if (!io->io_running) {
+        return;
+    }
+    io->io_running = false;
+    /* the read end of the pipe will report EPOLLHUP */
+    close(io->io_pipe[1]);
+    io->io_pipe[1] = -1;
+    opal_thread_join(&io->io_thread, &ret);
+}
+
+int mca_btl_tcp_epoll_init(void)
+{
+    int i, num_threads = mca_btl_tcp_component.tcp_epoll_threads;
+    int rc = OPAL_SUCCESS;
+
+    if (0 >= mca_btl_tcp_component.tcp_epoll_max_events) {
+        mca_btl_tcp_component.tcp_epoll_max_events = 64;
+    }
+
+    mca_btl_tcp_component.tcp_io_threads = (mca_btl_tcp_io_thread_t *)
+        calloc(num_threads, sizeof(mca_btl_tcp_io_thread_t));
+    if (NULL == mca_btl_tcp_component.tcp_io_threads) {
+        return OPAL_ERR_OUT_OF_RESOURCE;
+    }
+    mca_btl_tcp_component.tcp_io_thread_next = 0;
+
+    /* The I/O threads share fragments and endpoints with the application
+     * threads, the rest of the library should now protect itself. */
+    opal_set_using_threads(true);
+
+    for (i = 0; i < num_threads; i++) {
+        if (OPAL_SUCCESS != (rc = mca_btl_tcp_io_thread_start(&mca_btl_tcp_component.tcp_io_threads[i]))) {
+            /* release the threads started so far, including this one */
+            for (; i >= 0; i--) {
+                mca_btl_tcp_io_thread_stop(&mca_btl_tcp_component.tcp_io_threads[i]);
+                mca_btl_tcp_io_thread_release(&mca_btl_tcp_component.tcp_io_threads[i]);
+            }
+            free(mca_btl_tcp_component.tcp_io_threads);
+            mca_btl_tcp_component.tcp_io_threads = NULL;
+            return rc;
+        }
+    }
+
+    opal_output_verbose(10, opal_btl_base_framework.framework_output,
+                        "btl:tcp: started %d epoll I/O thread(s)", num_threads);
+    return OPAL_SUCCESS;
+}
+
+void mca_btl_tcp_epoll_fini(void)
+{
+    int i;
+
+    if (NULL == mca_btl_tcp_component.tcp_io_threads) {
+        return;
+    }
+    for (i = 0; i < mca_btl_tcp_component.tcp_epoll_threads; i++) {
+        mca_btl_tcp_io_thread_stop(&mca_btl_tcp_component.tcp_io_threads[i]);
+        mca_btl_tcp_io_thread_release(&mca_btl_tcp_component.tcp_io_threads[i]);
+    }
+    free(mca_btl_tcp_component.tcp_io_threads);
+    mca_btl_tcp_component.tcp_io_threads = NULL;
+}
+
+int mca_btl_tcp_epoll_add(mca_btl_base_endpoint_t *btl_endpoint)
+{
+    struct epoll_event ev;
+    int idx;
+
+    /* Endpoints keep the same I/O thread across reconnections, so
+     * that the sharding remains stable. */
+    if (NULL == btl_endpoint->endpoint_io_thread) {
+        idx = opal_atomic_fetch_add_32(&mca_btl_tcp_component.tcp_io_thread_next, 1);
+        btl_endpoint->endpoint_io_thread =
+            &mca_btl_tcp_component.tcp_io_threads[(unsigned int) idx % mca_btl_tcp_component.tcp_epoll_threads];
+    }
+
+    opal_event_del(&btl_endpoint->endpoint_recv_event);
+    opal_event_del(&btl_endpoint->endpoint_send_event);
+
+    memset(&ev, 0, sizeof(ev));
+    ev.events = MCA_BTL_TCP_EPOLL_EVENTS;
+    ev.data.ptr = btl_endpoint;
+    if (0 != epoll_ctl(btl_endpoint->endpoint_io_thread->io_epfd, EPOLL_CTL_ADD,
+                       btl_endpoint->endpoint_sd, &ev)) {
+        BTL_ERROR(("epoll_ctl(ADD) failed: %s (%d)", strerror(errno), errno));
+        /* keep going with libevent for this endpoint */
+        opal_event_add(&btl_endpoint->endpoint_recv_event, 0);
+        return OPAL_ERROR;
+    }
+    btl_endpoint->endpoint_epoll_registered = true;
+
+    if (mca_btl_tcp_event_base == opal_sync_event_base) {
+        /* the socket is no longer progressed by the default event base */
+        opal_progress_event_users_decrement();
+    }
+    return OPAL_SUCCESS;
+}
+
+void mca_btl_tcp_epoll_del(mca_btl_base_endpoint_t *btl_endpoint)
+{
+    if (!btl_endpoint->endpoint_epoll_registered) {
+        return;
+    }
+    (void) epoll_ctl(btl_endpoint->endpoint_io_thread->io_epfd, EPOLL_CTL_DEL,
+                     btl_endpoint->endpoint_sd, NULL);
+    btl_endpoint->endpoint_epoll_registered = false;
+}
+
+void mca_btl_tcp_epoll_rearm(mca_btl_base_endpoint_t *btl_endpoint)
+{
+    struct epoll_event ev;
+
+    /* Modifying the registration forces the kernel to re-evaluate the
+     * readiness of the socket, so even in edge-triggered mode the I/O
+     * thread is notified if the socket is already writable. */
+    memset(&ev, 0, sizeof(ev));
+    ev.events = MCA_BTL_TCP_EPOLL_EVENTS;
+    ev.data.ptr = btl_endpoint;
+    (void) epoll_ctl(btl_endpoint->endpoint_io_thread->io_epfd, EPOLL_CTL_MOD,
+                     btl_endpoint->endpoint_sd, &ev);
+}
+
+bool mca_btl_tcp_epoll_post_close(mca_btl_base_endpoint_t *btl_endpoint)
+{
+    mca_btl_tcp_io_thread_t *io = btl_endpoint->endpoint_io_thread;
+
+    if (NULL == io || !btl_endpoint->endpoint_epoll_registered ||
+        !opal_thread_self_compare(&io->io_thread)) {
+        return false;
+    }
+    if (btl_endpoint->endpoint_close_posted) {
+        return true;
+    }
+
+    /* no more events for this socket. The endpoint stays registered,
+     * so that the close removes it from the epoll set and not from
+     * libevent. */
+    (void) epoll_ctl(io->io_epfd, EPOLL_CTL_DEL, btl_endpoint->endpoint_sd, NULL);
+    OBJ_RETAIN(btl_endpoint);
+    OPAL_THREAD_LOCK(&io->io_lock);
+    if (OPAL_SUCCESS != opal_value_array_append_item(&io->io_closed, &btl_endpoint)) {
+        OPAL_THREAD_UNLOCK(&io->io_lock);
+        OBJ_RELEASE(btl_endpoint);
+        BTL_ERROR(("BTL TCP I/O thread cannot post the close of an endpoint"));
+        return false;
+    }
+    btl_endpoint->endpoint_close_posted = true;
+    (void) opal_atomic_add_fetch_32(&io->io_num_deferred, 1);
+    OPAL_THREAD_UNLOCK(&io->io_lock);
+    return true;
+}
+
+void mca_btl_tcp_epoll_quiesce(mca_btl_base_endpoint_t *btl_endpoint)
+{
+    mca_btl_tcp_io_thread_t *io = btl_endpoint->endpoint_io_thread;
+    mca_btl_tcp_frag_t *frag, *next;
+    opal_list_item_t *item;
+    opal_list_t completed;
+
+    if (NULL == io) {
+        return;
+    }
+    if (io->io_running) {
+        /* the socket is already out of the epoll set, so once the current
+         * batch is done the I/O thread cannot see this endpoint anymore */
+        OPAL_THREAD_LOCK(&io->io_batch_lock);
+        OPAL_THREAD_UNLOCK(&io->io_batch_lock);
+    }
+
+    /* Fragments handed over before that still point to the endpoint.
+     * Received data is dropped, completed sends get their callback. The
+     * lock-free queues cannot be searched: they are emptied, and the
+     * fragments of the other endpoints are held for the progress
+     * function. */
+    OBJ_CONSTRUCT(&completed, opal_list_t);
+    OPAL_THREAD_LOCK(&io->io_lock);
+    OPAL_LIST_FOREACH_SAFE(frag, next, &io->io_held_recv, mca_btl_tcp_frag_t) {
+        if (frag->endpoint == btl_endpoint) {
+            opal_list_remove_item(&io->io_held_recv, (opal_list_item_t *) frag);
+            (void) opal_atomic_sub_fetch_32(&io->io_num_deferred, 1);
+            MCA_BTL_TCP_FRAG_RETURN(frag);
+        }
+    }
+    OPAL_LIST_FOREACH_SAFE(frag, next, &io->io_held_send, mca_btl_tcp_frag_t) {
+        if (frag->endpoint == btl_endpoint) {
+            opal_list_remove_item(&io->io_held_send, (opal_list_item_t *) frag);
+            (void) opal_atomic_sub_fetch_32(&io->io_num_deferred, 1);
+            opal_list_append(&completed, (opal_list_item_t *) frag);
+        }
+    }
+    while (NULL != (item = opal_fifo_pop_atomic(&io->io_recv_frags))) {
+        frag = (mca_btl_tcp_frag_t *) item;
+        if (frag->endpoint == btl_endpoint) {
+            MCA_BTL_TCP_FRAG_RETURN(frag);
+        } else {
+            opal_list_append(&io->io_held_recv, item);
+            (void) opal_atomic_add_fetch_32(&io->io_num_deferred, 1);
+        }
+    }
+    while (NULL != (item = opal_fifo_pop_atomic(&io->io_send_frags))) {
+        frag = (mca_btl_tcp_frag_t *) item;
+        if (frag->endpoint == btl_endpoint) {
+            opal_list_append(&completed, item);
+        } else {
+            opal_list_append(&io->io_held_send, item);
+            (void) opal_atomic_add_fetch_32(&io->io_num_deferred, 1);
+        }
+    }
+    OPAL_THREAD_UNLOCK(&io->io_lock);
+
+    while (NULL != (frag = (mca_btl_tcp_frag_t *) opal_list_remove_first(&completed))) {
+        MCA_BTL_TCP_COMPLETE_FRAG_SEND(frag);
+    }
+    OBJ_DESTRUCT(&completed);
+}
+
+/* close the endpoints posted by the I/O thread */
+static int mca_btl_tcp_epoll_close_posted(mca_btl_tcp_io_thread_t *io, bool reconnect)
+{
+    mca_btl_base_endpoint_t *btl_endpoint;
+    size_t size;
+    int count = 0;
+
+    while (1) {
+        OPAL_THREAD_LOCK(&io->io_lock);
+        size = opal_value_array_get_size(&io->io_closed);
+        if (0 == size) {
+            OPAL_THREAD_UNLOCK(&io->io_lock);
+            break;
+        }
+        btl_endpoint = OPAL_VALUE_ARRAY_GET_ITEM(&io->io_closed, mca_btl_base_endpoint_t *, size - 1);
+        (void) opal_value_array_set_size(&io->io_closed, size - 1);
+        (void) opal_atomic_sub_fetch_32(&io->io_num_deferred, 1);
+        OPAL_THREAD_UNLOCK(&io->io_lock);
+
+        mca_btl_tcp_endpoint_complete_close(btl_endpoint, reconnect);
+        OBJ_RELEASE(btl_endpoint);
+        count++;
+    }
+    return count;
+}
+
+void mca_btl_tcp_epoll_flush_closed(void)
+{
+    int i;
+
+    if (NULL == mca_btl_tcp_component.tcp_io_threads) {
+        return;
+    }
+    for (i = 0; i < mca_btl_tcp_component.tcp_epoll_threads; i++) {
+        (void) mca_btl_tcp_epoll_close_posted(&mca_btl_tcp_component.tcp_io_threads[i], false);
+    }
+}
+
+static inline void mca_btl_tcp_epoll_deliver(mca_btl_tcp_frag_t *frag)
+{
+    mca_btl_active_message_callback_t *reg =
+        mca_btl_base_active_message_trigger + frag->hdr.base.tag;
+    const mca_btl_base_receive_descriptor_t desc =
+        {.endpoint = frag->endpoint,
+         .des_segments = frag->base.des_segments,
+         .des_segment_count = frag->base.des_segment_count,
+         .tag = frag->hdr.base.tag,
+         .cbdata = reg->cbdata};
+    reg->cbfunc(&frag->btl->super, &desc);
+    MCA_BTL_TCP_FRAG_RETURN(frag);
+}
+
+/* the fragments held by mca_btl_tcp_epoll_quiesce, older than the ones
+ * still in the queues */
+static int mca_btl_tcp_epoll_progress_held(mca_btl_tcp_io_thread_t *io)
+{
+    opal_list_t recv_frags, send_frags;
+    mca_btl_tcp_frag_t *frag;
+    opal_list_item_t *item;
+    int count;
+
+    OBJ_CONSTRUCT(&recv_frags, opal_list_t);
+    OBJ_CONSTRUCT(&send_frags, opal_list_t);
+    OPAL_THREAD_LOCK(&io->io_lock);
+    opal_list_join(&send_frags, opal_list_get_end(&send_frags), &io->io_held_send);
+    opal_list_join(&recv_frags, opal_list_get_end(&recv_frags), &io->io_held_recv);
+    count = (int) (opal_list_get_size(&send_frags) + opal_list_get_size(&recv_frags));
+    (void) opal_atomic_sub_fetch_32(&io->io_num_deferred, count);
+    OPAL_THREAD_UNLOCK(&io->io_lock);
+
+    while (NULL != (item = opal_list_remove_first(&send_frags))) {
+        frag = (mca_btl_tcp_frag_t *) item;
+        MCA_BTL_TCP_COMPLETE_FRAG_SEND(frag);
+    }
+    while (NULL != (item = opal_list_remove_first(&recv_frags))) {
+        mca_btl_tcp_epoll_deliver((mca_btl_tcp_frag_t *) item);
+    }
+    OBJ_DESTRUCT(&recv_frags);
+    OBJ_DESTRUCT(&send_frags);
+    return count;
+}
+
+int mca_btl_tcp_epoll_progress(void)
+{
+    mca_btl_tcp_frag_t *frag;
+    opal_list_item_t *item;
+    int i, count = 0;
+
+    for (i = 0; i < mca_btl_tcp_component.tcp_epoll_threads; i++) {
+        mca_btl_tcp_io_thread_t *io = &mca_btl_tcp_component.tcp_io_threads[i];
+
+        if (OPAL_UNLIKELY(0 < io->io_num_deferred)) {
+            count += mca_btl_tcp_epoll_progress_held(io);
+        }
+        while (NULL != (item = opal_fifo_pop_atomic(&io->io_send_frags))) {
+            frag = (mca_btl_tcp_frag_t *) item;
+            MCA_BTL_TCP_COMPLETE_FRAG_SEND(frag);
+            count++;
+        }
+        while (NULL != (item = opal_fifo_pop_atomic(&io->io_recv_frags))) {
+            mca_btl_tcp_epoll_deliver((mca_btl_tcp_frag_t *) item);
+            count++;
+        }
+        /* after the fragments received before the connection went away */
+        if (OPAL_UNLIKELY(0 < io->io_num_deferred)) {
+            count += mca_btl_tcp_epoll_close_posted(io, true);
+        }
+    }
+    return count;
+}
+
+#endif  /* OPAL_BTL_TCP_HAVE_EPOLL */
@@ -0,0 +1,120 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+/**
+ * @file
+ *
+ * Linux-specific I/O engine for the TCP BTL. Once an endpoint reaches
+ * the CONNECTED state its socket is moved out of libevent and handed
+ * to one of btl_tcp_epoll_threads dedicated I/O threads, each running
+ * an edge-triggered epoll loop. Connection establishment still goes
+ * through libevent.
+ *
+ * The I/O threads never call into the PML. Received fragments and
+ * completed sends are queued per thread in lock-free FIFOs, and are
+ * delivered from the component progress function. So are the endpoints whose connection
+ * failed or was closed by the peer: the I/O thread only removes the
+ * socket from its epoll set, the close itself and the error reporting
+ * are left to the progress function.
+ */
+#ifndef MCA_BTL_TCP_EPOLL_H
+#define MCA_BTL_TCP_EPOLL_H
+
+#include "opal_config.h"
+
+#if OPAL_BTL_TCP_HAVE_EPOLL
+
+#include "opal/class/opal_fifo.h"
+#include "opal/class/opal_list.h"
+#include "opal/class/opal_value_array.h"
+#include "opal/mca/threads/mutex.h"
+#include "opal/mca/threads/threads.h"
+
+BEGIN_C_DECLS
+
+struct mca_btl_base_endpoint_t;
+
+struct mca_btl_tcp_io_thread_t {
+    opal_thread_t   io_thread;      /**< thread running the epoll loop */
+    int             io_epfd;        /**< epoll instance owned by this thread */
+    int             io_pipe[2];     /**< closing io_pipe[1] wakes up the thread for shutdown */
+    volatile bool   io_running;     /**< false once the thread has been asked to stop */
+    opal_mutex_t    io_batch_lock;  /**< held while a batch of epoll events is dispatched */
+    opal_fifo_t     io_recv_frags;  /**< received fragments waiting for the upper layer */
+    opal_fifo_t     io_send_frags;  /**< completed send fragments waiting for their callback */
+    opal_mutex_t    io_lock;        /**< protects the held fragments and io_closed */
+    opal_list_t     io_held_recv;   /**< received fragments taken out of io_recv_frags by a quiesce */
+    opal_list_t     io_held_send;   /**< send fragments taken out of io_send_frags by a quiesce */
+    opal_value_array_t io_closed;   /**< retained endpoints waiting to be closed */
+    opal_atomic_int32_t io_num_deferred; /**< held fragments and endpoints in io_closed */
+};
+typedef struct mca_btl_tcp_io_thread_t mca_btl_tcp_io_thread_t;
+
+/**
+ * Create the epoll instances and start the I/O threads. On failure
+ * everything is released and the caller should fall back on libevent.
+ */
+int mca_btl_tcp_epoll_init(void);
+
+/**
+ * Stop and join the I/O threads, and release any fragment still
+ * waiting in the handoff queues.
+ */
+void mca_btl_tcp_epoll_fini(void);
+
+/**
+ * Move a newly connected endpoint from libevent to an I/O thread.
+ * Must be called with the endpoint send lock held.
+ */
+int mca_btl_tcp_epoll_add(struct mca_btl_base_endpoint_t *btl_endpoint);
+
+/**
+ * Remove the endpoint socket from its I/O thread.
+ */
+void mca_btl_tcp_epoll_del(struct mca_btl_base_endpoint_t *btl_endpoint);
+
+/**
+ * Have the I/O thread owning the endpoint look at the socket again,
+ * e.g. because new fragments are pending for send.
+ */
+void mca_btl_tcp_epoll_rearm(struct mca_btl_base_endpoint_t *btl_endpoint);
+
+/**
+ * Called by mca_btl_tcp_endpoint_close. From the I/O thread owning the
+ * endpoint, remove the socket from the epoll set and hand the endpoint
+ * to the progress function, which closes it. Returns true in that case.
+ */
+bool mca_btl_tcp_epoll_post_close(struct mca_btl_base_endpoint_t *btl_endpoint);
+
+/**
+ * Close the endpoints posted by the I/O threads now, without trying to
+ * connect them again. Called by a module before it goes away.
+ */
+void mca_btl_tcp_epoll_flush_closed(void);
+
+/**
+ * Wait until the I/O thread owning the endpoint is done with the
+ * batch of events it is currently processing, and release the
+ * fragments of the endpoint still waiting in its queues, so that the
+ * endpoint can be safely released.
+ */
+void mca_btl_tcp_epoll_quiesce(struct mca_btl_base_endpoint_t *btl_endpoint);
+
+/**
+ * Deliver the fragments completed by the I/O threads to the upper layer.
+ */
+int mca_btl_tcp_epoll_progress(void);
+
+END_C_DECLS
+
+#endif  /* OPAL_BTL_TCP_HAVE_EPOLL */
+
+#endif  /* MCA_BTL_TCP_EPOLL_H */
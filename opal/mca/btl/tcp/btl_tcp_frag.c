@@ -218,6 +218,12 @@ bool mca_btl_tcp_frag_recv(mca_btl_tcp_frag_t* frag, int sd)
         cnt = readv(sd, frag->iov_ptr, num_vecs);
         if( 0 < cnt ) goto advance_iov_position;
         if( cnt == 0 ) {
+            if(MCA_BTL_TCP_CLOSING == btl_endpoint->endpoint_state) {
+                /* the peer went away while we were waiting for the answer
+                 * to our idle request: there is nothing left to read. */
+                mca_btl_tcp_endpoint_idle_ctl(btl_endpoint, MCA_BTL_TCP_HDR_TYPE_IDLE_ACK);
+                return false;
+            }
             OPAL_THREAD_LOCK(&btl_endpoint->endpoint_send_lock);
             if(MCA_BTL_TCP_CONNECTED == btl_endpoint->endpoint_state)
                 btl_endpoint->endpoint_state = MCA_BTL_TCP_FAILED;
@@ -283,6 +289,11 @@ bool mca_btl_tcp_frag_recv(mca_btl_tcp_frag_t* frag, int sd)
             frag->endpoint->endpoint_state = MCA_BTL_TCP_CLOSED;
             mca_btl_tcp_endpoint_close(frag->endpoint);
             break;
+        case MCA_BTL_TCP_HDR_TYPE_IDLE_REQ:
+        case MCA_BTL_TCP_HDR_TYPE_IDLE_ACK:
+        case MCA_BTL_TCP_HDR_TYPE_IDLE_NACK:
+            mca_btl_tcp_endpoint_idle_ctl(frag->endpoint, frag->hdr.type);
+            break;
         case MCA_BTL_TCP_HDR_TYPE_SEND:
             if(frag->iov_idx == 1 && frag->hdr.size) {
                 frag->segments[0].seg_addr.pval = frag+1;
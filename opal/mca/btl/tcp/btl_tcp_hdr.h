@@ -45,6 +45,19 @@ BEGIN_C_DECLS
  * of a FIN message can simply close the socket and mark the endpoint as closed
  * without error, and without answering a FIN message itself.
  */
+#define MCA_BTL_TCP_HDR_TYPE_IDLE_REQ   5
+#define MCA_BTL_TCP_HDR_TYPE_IDLE_ACK   6
+#define MCA_BTL_TCP_HDR_TYPE_IDLE_NACK  7
+/* The IDLE messages implement the 2-way handshake used to close a connection
+ * that has not been used for a while, or that has been selected for eviction
+ * because the process is over its connection cap. The initiator sends an
+ * IDLE_REQ and stops sending, but keeps receiving. If the peer has nothing
+ * to send it answers with an IDLE_ACK and closes its end, otherwise the
+ * IDLE_NACK is queued behind its pending fragments and the connection stays
+ * open. As the stream is ordered, once the initiator reads the IDLE_ACK no
+ * data can be lost by closing the socket. A closed connection is transparently
+ * reestablished by the next send.
+ */
 
 struct mca_btl_tcp_hdr_t {
     mca_btl_base_header_t base;
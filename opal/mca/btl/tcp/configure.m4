@@ -36,5 +36,13 @@ AC_DEFUN([MCA_opal_btl_tcp_CONFIG],[
 #include <netinet/in.h>
 #endif
 		   ])
+
+    # the epoll I/O engine is Linux specific
+    opal_btl_tcp_have_epoll=0
+    AC_CHECK_HEADERS([sys/epoll.h],
+                     [AC_CHECK_FUNCS([epoll_create1], [opal_btl_tcp_have_epoll=1])])
+    AC_DEFINE_UNQUOTED([OPAL_BTL_TCP_HAVE_EPOLL], [$opal_btl_tcp_have_epoll],
+                       [Whether the TCP BTL can use its epoll I/O threads])
+
     OPAL_SUMMARY_ADD([[Transports]],[[TCP]],[[btl_tcp]],[$opal_btl_tcp_happy])
 ])dnl
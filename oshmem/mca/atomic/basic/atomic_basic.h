@@ -15,6 +15,7 @@
 
 #include "oshmem/mca/mca.h"
 #include "oshmem/mca/atomic/atomic.h"
+#include "oshmem/mca/memheap/base/base.h"
 #include "oshmem/util/oshmem_util.h"
 
 BEGIN_C_DECLS
@@ -29,6 +30,25 @@ mca_atomic_basic_component;
 OSHMEM_DECLSPEC void atomic_basic_lock(shmem_ctx_t ctx, int pe);
 OSHMEM_DECLSPEC void atomic_basic_unlock(shmem_ctx_t ctx, int pe);
 
+extern int mca_atomic_basic_direct;
+
+/* Offset from a symmetric segment to its mapping for every PE. It is only
+ * set when all PEs run on this node and map the segment of every PE, so
+ * that CPU atomics on the mapped addresses are atomic for all PEs. */
+extern ptrdiff_t *atomic_basic_direct_offset[MCA_MEMHEAP_MAX_SEGMENTS];
+
+static inline void *atomic_basic_direct_ptr(void *target, int pe)
+{
+    int seg = memheap_find_segnum(target);
+
+    if (OPAL_UNLIKELY(MEMHEAP_SEG_INVALID == seg) ||
+        (NULL == atomic_basic_direct_offset[seg])) {
+        return NULL;
+    }
+
+    return (void *) ((intptr_t) target + atomic_basic_direct_offset[seg][pe]);
+}
+
 /* API functions */
 
 int mca_atomic_basic_startup(bool enable_progress_threads, bool enable_threads);
@@ -27,6 +27,7 @@ const char *mca_atomic_basic_component_version_string =
 /*
  * Global variable
  */
+int mca_atomic_basic_direct = 1;
 
 /*
  * Local function
@@ -78,6 +79,16 @@ static int _basic_register(void)
                                      MCA_BASE_VAR_SCOPE_ALL_EQ,
                                      &mca_atomic_basic_component.priority);
 
+    mca_atomic_basic_direct = 1;
+    mca_base_component_var_register (&mca_atomic_basic_component.atomic_version,
+                                     "direct", "Use CPU atomics when all PEs run on "
+                                     "the same node and map the symmetric memory of "
+                                     "each other (default: 1)", MCA_BASE_VAR_TYPE_INT,
+                                     NULL, 0, MCA_BASE_VAR_FLAG_SETTABLE,
+                                     OPAL_INFO_LVL_9,
+                                     MCA_BASE_VAR_SCOPE_ALL_EQ,
+                                     &mca_atomic_basic_direct);
+
     return OSHMEM_SUCCESS;
 }
 
@@ -12,12 +12,52 @@
 #include <stdio.h>
 #include <stdlib.h>
 
+#include "opal/sys/atomic.h"
+
 #include "oshmem/constants.h"
 #include "oshmem/mca/spml/spml.h"
 #include "oshmem/mca/atomic/atomic.h"
 #include "oshmem/mca/atomic/base/base.h"
 #include "atomic_basic.h"
 
+static inline
+bool mca_atomic_basic_direct_cswap(void *ptr,
+                                   uint64_t *prev,
+                                   uint64_t cond,
+                                   uint64_t value,
+                                   size_t nlong)
+{
+    if (sizeof(int32_t) == nlong) {
+        int32_t old = (int32_t) cond;
+
+        if (!cond) {
+            old = opal_atomic_swap_32((opal_atomic_int32_t *) ptr, (int32_t) value);
+        } else {
+            (void) opal_atomic_compare_exchange_strong_32((opal_atomic_int32_t *) ptr,
+                                                          &old, (int32_t) value);
+        }
+        memcpy(prev, &old, nlong);
+        return true;
+    }
+
+#if OPAL_HAVE_ATOMIC_COMPARE_EXCHANGE_64 && OPAL_HAVE_ATOMIC_SWAP_64
+    if (sizeof(int64_t) == nlong) {
+        int64_t old = (int64_t) cond;
+
+        if (!cond) {
+            old = opal_atomic_swap_64((opal_atomic_int64_t *) ptr, (int64_t) value);
+        } else {
+            (void) opal_atomic_compare_exchange_strong_64((opal_atomic_int64_t *) ptr,
+                                                          &old, (int64_t) value);
+        }
+        memcpy(prev, &old, nlong);
+        return true;
+    }
+#endif
+
+    return false;
+}
+
 int mca_atomic_basic_cswap(shmem_ctx_t ctx,
                            void *target,
                            uint64_t *prev,
@@ -27,12 +67,19 @@ int mca_atomic_basic_cswap(shmem_ctx_t ctx,
                            int pe)
 {
     int rc = OSHMEM_SUCCESS;
+    void *ptr;
 
     if (!prev) {
         rc = OSHMEM_ERROR;
     }
 
     if (rc == OSHMEM_SUCCESS) {
+        ptr = atomic_basic_direct_ptr(target, pe);
+        if ((NULL != ptr) &&
+            mca_atomic_basic_direct_cswap(ptr, prev, cond, value, nlong)) {
+            return OSHMEM_SUCCESS;
+        }
+
         atomic_basic_lock(ctx, pe);
 
         rc = MCA_SPML_CALL(get(ctx, target, nlong, prev, pe));
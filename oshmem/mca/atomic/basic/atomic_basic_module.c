@@ -11,12 +11,17 @@
 #include "oshmem_config.h"
 #include <stdio.h>
 
+#include "opal/sys/atomic.h"
+#include "opal/mca/hwloc/base/base.h"
+#include "ompi/communicator/communicator.h"
+
 #include "oshmem/constants.h"
 #include "oshmem/mca/atomic/atomic.h"
 #include "oshmem/mca/spml/spml.h"
 #include "oshmem/mca/memheap/memheap.h"
 #include "oshmem/proc/proc.h"
 #include "oshmem/op/op.h"
+#include "oshmem/runtime/runtime.h"
 #include "atomic_basic.h"
 
 static char *atomic_lock_sync;
@@ -30,6 +35,106 @@ enum {
     ATOMIC_LOCK_ACTIVE = 2
 };
 
+enum {
+    ATOMIC_BASIC_ADD,
+    ATOMIC_BASIC_AND,
+    ATOMIC_BASIC_OR,
+    ATOMIC_BASIC_XOR,
+    ATOMIC_BASIC_SWAP
+};
+
+ptrdiff_t *atomic_basic_direct_offset[MCA_MEMHEAP_MAX_SEGMENTS];
+
+/* Same as shmem_ptr() */
+static void *atomic_basic_map(int pe, void *va)
+{
+    sshmem_mkey_t *mkey;
+    void *rva;
+    int i;
+
+    if (pe == oshmem_my_proc_id()) {
+        return va;
+    }
+
+    for (i = 0; i < mca_memheap_base_num_transports(); i++) {
+        mkey = mca_memheap_base_get_cached_mkey(oshmem_ctx_default, pe, va, i, &rva);
+        if (!mkey) {
+            continue;
+        }
+
+        if (mca_memheap_base_mkey_is_shm(mkey)) {
+            return rva;
+        }
+
+        rva = MCA_SPML_CALL(rmkey_ptr(va, mkey, pe));
+        if (rva != NULL) {
+            return rva;
+        }
+    }
+
+    return NULL;
+}
+
+/*
+ * Map the symmetric segments of all PEs. A segment is only used directly
+ * if every PE could map it for all PEs: a PE falling back to the lock
+ * would not be atomic with respect to the CPU atomics of the others.
+ */
+static int atomic_basic_direct_init(void)
+{
+    int num_pe = oshmem_num_procs();
+    int me = oshmem_my_proc_id();
+    int n_segments = mca_memheap_base_map.n_segments;
+    int ok[MCA_MEMHEAP_MAX_SEGMENTS];
+    int local = mca_atomic_basic_direct;
+    ompi_proc_t *proc;
+    void *base, *rva;
+    int rc;
+    int i, seg;
+
+    for (i = 0; local && (i < num_pe); i++) {
+        proc = oshmem_proc_group_find(oshmem_group_all, i);
+        if ((i != me) && !OPAL_PROC_ON_LOCAL_NODE(proc->super.proc_flags)) {
+            local = 0;
+        }
+    }
+
+    for (seg = 0; seg < n_segments; seg++) {
+        ok[seg] = local;
+        if (!ok[seg]) {
+            continue;
+        }
+
+        atomic_basic_direct_offset[seg] = (ptrdiff_t *) malloc(num_pe * sizeof(ptrdiff_t));
+        if (NULL == atomic_basic_direct_offset[seg]) {
+            ok[seg] = 0;
+            continue;
+        }
+
+        base = mca_memheap_seg2base_va(seg);
+        for (i = 0; ok[seg] && (i < num_pe); i++) {
+            rva = atomic_basic_map(i, base);
+            if (NULL == rva) {
+                ok[seg] = 0;
+            } else {
+                atomic_basic_direct_offset[seg][i] = (intptr_t) rva - (intptr_t) base;
+            }
+        }
+    }
+
+    rc = oshmem_comm_world->c_coll->coll_allreduce(MPI_IN_PLACE, ok, n_segments,
+                                                   MPI_INT, MPI_MIN, oshmem_comm_world,
+                                                   oshmem_comm_world->c_coll->coll_allreduce_module);
+    for (seg = 0; seg < n_segments; seg++) {
+        if ((OMPI_SUCCESS != rc) || !ok[seg]) {
+            free(atomic_basic_direct_offset[seg]);
+            atomic_basic_direct_offset[seg] = NULL;
+        }
+    }
+
+    return rc;
+}
+
 /*
  * Initial query function that is invoked during initialization, allowing
  * this module to indicate what level of thread support it provides.
@@ -64,12 +169,22 @@ int mca_atomic_basic_startup(bool enable_progress_threads, bool enable_threads)
         }
     }
 
+    if (rc == OSHMEM_SUCCESS) {
+        rc = atomic_basic_direct_init();
+    }
+
     return rc;
 }
 
 int mca_atomic_basic_finalize(void)
 {
     void* ptr = NULL;
+    int seg;
+
+    for (seg = 0; seg < MCA_MEMHEAP_MAX_SEGMENTS; seg++) {
+        free(atomic_basic_direct_offset[seg]);
+        atomic_basic_direct_offset[seg] = NULL;
+    }
 
     ptr = (void*) atomic_lock_sync;
     MCA_MEMHEAP_CALL(private_free(ptr));
@@ -92,6 +207,66 @@ int mca_atomic_basic_finalize(void)
     return OSHMEM_SUCCESS;
 }
 
+static inline
+bool mca_atomic_basic_direct_fop(void *ptr,
+                                 void *prev,
+                                 uint64_t value,
+                                 size_t size,
+                                 int kind)
+{
+    if (sizeof(int32_t) == size) {
+        opal_atomic_int32_t *addr = (opal_atomic_int32_t *) ptr;
+        int32_t val = (int32_t) value;
+
+        switch (kind) {
+        case ATOMIC_BASIC_ADD:
+            *(int32_t *) prev = opal_atomic_fetch_add_32(addr, val);
+            break;
+        case ATOMIC_BASIC_AND:
+            *(int32_t *) prev = opal_atomic_fetch_and_32(addr, val);
+            break;
+        case ATOMIC_BASIC_OR:
+            *(int32_t *) prev = opal_atomic_fetch_or_32(addr, val);
+            break;
+        case ATOMIC_BASIC_XOR:
+            *(int32_t *) prev = opal_atomic_fetch_xor_32(addr, val);
+            break;
+        default:
+            *(int32_t *) prev = opal_atomic_swap_32(addr, val);
+            break;
+        }
+        return true;
+    }
+
+#if OPAL_HAVE_ATOMIC_MATH_64
+    if (sizeof(int64_t) == size) {
+        opal_atomic_int64_t *addr = (opal_atomic_int64_t *) ptr;
+        int64_t val = (int64_t) value;
+
+        switch (kind) {
+        case ATOMIC_BASIC_ADD:
+            *(int64_t *) prev = opal_atomic_fetch_add_64(addr, val);
+            break;
+        case ATOMIC_BASIC_AND:
+            *(int64_t *) prev = opal_atomic_fetch_and_64(addr, val);
+            break;
+        case ATOMIC_BASIC_OR:
+            *(int64_t *) prev = opal_atomic_fetch_or_64(addr, val);
+            break;
+        case ATOMIC_BASIC_XOR:
+            *(int64_t *) prev = opal_atomic_fetch_xor_64(addr, val);
+            break;
+        default:
+            *(int64_t *) prev = opal_atomic_swap_64(addr, val);
+            break;
+        }
+        return true;
+    }
+#endif
+
+    return false;
+}
+
 static inline
 int mca_atomic_basic_fop(shmem_ctx_t ctx,
                          void *target,
@@ -99,10 +274,18 @@ int mca_atomic_basic_fop(shmem_ctx_t ctx,
                          uint64_t value,
                          size_t size,
                          int pe,
+                         int kind,
                          struct oshmem_op_t *op)
 {
     int rc = OSHMEM_SUCCESS;
     long long temp_value = 0;
+    uint32_t value32 = (uint32_t) value;
+    void *ptr;
+
+    ptr = atomic_basic_direct_ptr(target, pe);
+    if ((NULL != ptr) && mca_atomic_basic_direct_fop(ptr, prev, value, size, kind)) {
+        return OSHMEM_SUCCESS;
+    }
 
     atomic_basic_lock(ctx, pe);
 
@@ -110,7 +293,7 @@ int mca_atomic_basic_fop(shmem_ctx_t ctx,
 
     memcpy(prev, (void*) &temp_value, size);
 
-    op->o_func.c_fn((void*) value,
+    op->o_func.c_fn((sizeof(value32) == size) ? (void*) &value32 : (void*) &value,
                     (void*) &temp_value,
                     size / op->dt_size);
 
@@ -130,17 +313,18 @@ int mca_atomic_basic_op(shmem_ctx_t ctx,
                         uint64_t value,
                         size_t size,
                         int pe,
+                        int kind,
                         struct oshmem_op_t *op)
 {
     long long prev;
 
-    return mca_atomic_basic_fop(ctx, target, &prev, value, size, pe, op);
+    return mca_atomic_basic_fop(ctx, target, &prev, value, size, pe, kind, op);
 }
 
 static int mca_atomic_basic_add(shmem_ctx_t ctx, void *target, uint64_t value,
                                 size_t size, int pe)
 {
-    return mca_atomic_basic_op(ctx, target, value, size, pe,
+    return mca_atomic_basic_op(ctx, target, value, size, pe, ATOMIC_BASIC_ADD,
                                MCA_BASIC_OP(size, oshmem_op_sum_int32, oshmem_op_sum_int64));
 }
 
@@ -148,29 +332,29 @@ static int mca_atomic_basic_and(shmem_ctx_t ctx,
                                 void *target, uint64_t value,
                                 size_t size, int pe)
 {
-    return mca_atomic_basic_op(ctx, target, value, size, pe,
-                               MCA_BASIC_OP(size, oshmem_op_sum_int32, oshmem_op_and_int64));
+    return mca_atomic_basic_op(ctx, target, value, size, pe, ATOMIC_BASIC_AND,
+                               MCA_BASIC_OP(size, oshmem_op_and_int32, oshmem_op_and_int64));
 }
 
 static int mca_atomic_basic_or(shmem_ctx_t ctx, void *target, uint64_t value,
                                size_t size, int pe)
 {
-    return mca_atomic_basic_op(ctx, target, value, size, pe,
-                               MCA_BASIC_OP(size, oshmem_op_sum_int32, oshmem_op_or_int64));
+    return mca_atomic_basic_op(ctx, target, value, size, pe, ATOMIC_BASIC_OR,
+                               MCA_BASIC_OP(size, oshmem_op_or_int32, oshmem_op_or_int64));
 }
 
 static int mca_atomic_basic_xor(shmem_ctx_t ctx,
                                 void *target, uint64_t value,
                                 size_t size, int pe)
 {
-    return mca_atomic_basic_op(ctx, target, value, size, pe,
-                               MCA_BASIC_OP(size, oshmem_op_sum_int32, oshmem_op_xor_int64));
+    return mca_atomic_basic_op(ctx, target, value, size, pe, ATOMIC_BASIC_XOR,
+                               MCA_BASIC_OP(size, oshmem_op_xor_int32, oshmem_op_xor_int64));
 }
 
 static int mca_atomic_basic_fadd(shmem_ctx_t ctx, void *target, void *prev, uint64_t value,
                                  size_t size, int pe)
 {
-    return mca_atomic_basic_fop(ctx, target, prev, value, size, pe,
+    return mca_atomic_basic_fop(ctx, target, prev, value, size, pe, ATOMIC_BASIC_ADD,
                                 MCA_BASIC_OP(size, oshmem_op_sum_int32, oshmem_op_sum_int64));
 }
 
@@ -178,28 +362,28 @@ static int mca_atomic_basic_fand(shmem_ctx_t ctx,
                                  void *target, void *prev, uint64_t value,
                                  size_t size, int pe)
 {
-    return mca_atomic_basic_fop(ctx, target, prev, value, size, pe,
-                                MCA_BASIC_OP(size, oshmem_op_sum_int32, oshmem_op_and_int64));
+    return mca_atomic_basic_fop(ctx, target, prev, value, size, pe, ATOMIC_BASIC_AND,
+                                MCA_BASIC_OP(size, oshmem_op_and_int32, oshmem_op_and_int64));
 }
 
 static int mca_atomic_basic_for(shmem_ctx_t ctx, void *target, void *prev, uint64_t value,
                                 size_t size, int pe)
 {
-    return mca_atomic_basic_fop(ctx, target, prev, value, size, pe,
-                                MCA_BASIC_OP(size, oshmem_op_sum_int32, oshmem_op_or_int64));
+    return mca_atomic_basic_fop(ctx, target, prev, value, size, pe, ATOMIC_BASIC_OR,
+                                MCA_BASIC_OP(size, oshmem_op_or_int32, oshmem_op_or_int64));
 }
 
 static int mca_atomic_basic_fxor(shmem_ctx_t ctx, void *target, void *prev, uint64_t value,
                                  size_t size, int pe)
 {
-    return mca_atomic_basic_fop(ctx, target, prev, value, size, pe,
-                                MCA_BASIC_OP(size, oshmem_op_sum_int32, oshmem_op_xor_int64));
+    return mca_atomic_basic_fop(ctx, target, prev, value, size, pe, ATOMIC_BASIC_XOR,
+                                MCA_BASIC_OP(size, oshmem_op_xor_int32, oshmem_op_xor_int64));
 }
 
 static int mca_atomic_basic_swap(shmem_ctx_t ctx, void *target, void *prev, uint64_t value,
                                  size_t size, int pe)
 {
-    return mca_atomic_basic_fop(ctx, target, prev, value, size, pe,
+    return mca_atomic_basic_fop(ctx, target, prev, value, size, pe, ATOMIC_BASIC_SWAP,
                                 MCA_BASIC_OP(size, oshmem_op_swap_int32, oshmem_op_swap_int64));
 }
 
@@ -0,0 +1,859 @@
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "oshmem_config.h"
+
+#include <string.h>
+
+#include "opal/align.h"
+#include "opal/util/output.h"
+#include "oshmem/proc/proc.h"
+#include "oshmem/mca/spml/spml.h"
+#include "oshmem/mca/memheap/memheap.h"
+#include "oshmem/mca/memheap/slab/memheap_slab.h"
+#include "oshmem/mca/memheap/slab/memheap_slab_component.h"
+#include "oshmem/mca/memheap/base/base.h"
+
+mca_memheap_slab_module_t memheap_slab = {
+    {
+        &mca_memheap_slab_component,
+        mca_memheap_slab_finalize,
+        mca_memheap_slab_alloc,
+        mca_memheap_slab_align,
+        mca_memheap_slab_realloc,
+        mca_memheap_slab_free,
+
+        mca_memheap_slab_private_alloc,
+        mca_memheap_slab_private_free,
+
+        mca_memheap_base_get_mkey,
+        mca_memheap_base_is_symmetric_addr,
+        mca_memheap_modex_recv_all,
+
+        0
+    },
+    5,          /* priority */
+    65536,      /* slab_size */
+    4096,       /* max_small_size */
+    0           /* print_stats */
+};
+
+static void slab_block_construct(mca_memheap_slab_block_t *block)
+{
+    block->offset = 0;
+    block->size = 0;
+    block->state = MEMHEAP_SLAB_BLOCK_FREE;
+    block->slab = NULL;
+}
+
+OBJ_CLASS_INSTANCE(mca_memheap_slab_block_t,
+                   opal_list_item_t,
+                   slab_block_construct,
+                   NULL);
+
+static void slab_slab_construct(mca_memheap_slab_slab_t *slab)
+{
+    slab->block = NULL;
+    slab->cls = 0;
+    slab->nobjs = 0;
+    slab->nfree = 0;
+    OBJ_CONSTRUCT(&slab->used, opal_bitmap_t);
+}
+
+static void slab_slab_destruct(mca_memheap_slab_slab_t *slab)
+{
+    OBJ_DESTRUCT(&slab->used);
+}
+
+OBJ_CLASS_INSTANCE(mca_memheap_slab_slab_t,
+                   opal_list_item_t,
+                   slab_slab_construct,
+                   slab_slab_destruct);
+
+/* key of a best fit search in the tree of the free blocks */
+typedef struct slab_search_t {
+    size_t size;
+    mca_memheap_slab_block_t *fit;
+} slab_search_t;
+
+static inline char *slab_block_addr(mca_memheap_slab_heap_t *heap,
+                                    mca_memheap_slab_block_t *block)
+{
+    return heap->base + block->offset;
+}
+
+/* free blocks are ordered by size, then by offset */
+static int slab_free_cmp(void *key1, void *key2)
+{
+    mca_memheap_slab_block_t *a = (mca_memheap_slab_block_t *) key1;
+    mca_memheap_slab_block_t *b = (mca_memheap_slab_block_t *) key2;
+
+    if (a->size != b->size) {
+        return (a->size < b->size) ? -1 : 1;
+    }
+    if (a->offset != b->offset) {
+        return (a->offset < b->offset) ? -1 : 1;
+    }
+    return 0;
+}
+
+/*
+ * Never matches, so the search ends below a leaf. Going left whenever
+ * the block is large enough leaves the smallest such block, with the
+ * lowest offset among blocks of the same size, in the key.
+ */
+static int slab_best_fit_cmp(void *key1, void *key2)
+{
+    slab_search_t *search = (slab_search_t *) key1;
+    mca_memheap_slab_block_t *block = (mca_memheap_slab_block_t *) key2;
+
+    if (block->size >= search->size) {
+        search->fit = block;
+        return -1;
+    }
+    return 1;
+}
+
+static int slab_largest_cmp(void *key1, void *key2)
+{
+    ((slab_search_t *) key1)->fit = (mca_memheap_slab_block_t *) key2;
+    return 1;
+}
+
+static size_t slab_largest_free(mca_memheap_slab_heap_t *heap)
+{
+    slab_search_t search = {0, NULL};
+
+    opal_rb_tree_find_with(&heap->free_tree, &search, slab_largest_cmp);
+    return search.fit ? search.fit->size : 0;
+}
+
+static void slab_heap_report(const char *name, mca_memheap_slab_heap_t *heap, int level)
+{
+    mca_memheap_slab_stats_t *stats = &heap->stats;
+    size_t largest = slab_largest_free(heap);
+
+    opal_output_verbose(level, oshmem_memheap_base_framework.framework_output,
+                        "memheap:slab: PE %d %s heap of %lu bytes: %lu used (peak %lu), "
+                        "%lu free in %lu blocks, largest free block %lu bytes "
+                        "(%lu%% fragmentation), %lu slabs holding %lu objects "
+                        "with %lu bytes left, %lu allocations, %lu frees, %lu failures",
+                        memheap_slab.my_pe, name, (unsigned long) heap->size,
+                        (unsigned long) stats->used, (unsigned long) stats->peak_used,
+                        (unsigned long) stats->free, (unsigned long) stats->free_blocks,
+                        (unsigned long) largest,
+                        (unsigned long) (stats->free ? (stats->free - largest) * 100 / stats->free : 0),
+                        (unsigned long) stats->slabs, (unsigned long) stats->slab_objects,
+                        (unsigned long) stats->slab_free, (unsigned long) stats->allocs,
+                        (unsigned long) stats->frees, (unsigned long) stats->failures);
+}
+
+static int slab_insert_free(mca_memheap_slab_heap_t *heap,
+                            mca_memheap_slab_block_t *block)
+{
+    block->state = MEMHEAP_SLAB_BLOCK_FREE;
+    heap->stats.free += block->size;
+    heap->stats.free_blocks++;
+    return opal_rb_tree_insert(&heap->free_tree, block, block);
+}
+
+/* must be called before the size or the offset of the block change */
+static void slab_remove_free(mca_memheap_slab_heap_t *heap,
+                             mca_memheap_slab_block_t *block)
+{
+    heap->stats.free -= block->size;
+    heap->stats.free_blocks--;
+    opal_rb_tree_delete(&heap->free_tree, block);
+}
+
+static inline mca_memheap_slab_block_t *slab_block_next(mca_memheap_slab_heap_t *heap,
+                                                        mca_memheap_slab_block_t *block)
+{
+    opal_list_item_t *item = opal_list_get_next(&block->super);
+
+    return (item == opal_list_get_end(&heap->blocks)) ? NULL : (mca_memheap_slab_block_t *) item;
+}
+
+static inline mca_memheap_slab_block_t *slab_block_prev(mca_memheap_slab_heap_t *heap,
+                                                        mca_memheap_slab_block_t *block)
+{
+    opal_list_item_t *item = opal_list_get_prev(&block->super);
+
+    return (item == opal_list_get_end(&heap->blocks)) ? NULL : (mca_memheap_slab_block_t *) item;
+}
+
+/*
+ * Carve a block of size bytes at an offset aligned to align from the
+ * smallest free block that is large enough. What is left on both sides
+ * stays free.
+ */
+static mca_memheap_slab_block_t *slab_block_alloc(mca_memheap_slab_heap_t *heap,
+                                                  size_t size, size_t align, int state)
+{
+    mca_memheap_slab_block_t *block;
+    mca_memheap_slab_block_t *rest;
+    slab_search_t search;
+    size_t pad;
+
+    if (size > heap->size || align > heap->size) {
+        return NULL;
+    }
+
+    if (align < MEMHEAP_SLAB_BLOCK_ALIGN) {
+        align = MEMHEAP_SLAB_BLOCK_ALIGN;
+    }
+    size = OPAL_ALIGN(size, MEMHEAP_SLAB_BLOCK_ALIGN, size_t);
+    search.size = size + align - MEMHEAP_SLAB_BLOCK_ALIGN;
+    search.fit = NULL;
+    opal_rb_tree_find_with(&heap->free_tree, &search, slab_best_fit_cmp);
+    block = search.fit;
+    if (NULL == block) {
+        return NULL;
+    }
+
+    slab_remove_free(heap, block);
+
+    pad = OPAL_ALIGN(block->offset, align, size_t) - block->offset;
+    if (0 != pad) {
+        rest = OBJ_NEW(mca_memheap_slab_block_t);
+        if (NULL == rest) {
+            slab_insert_free(heap, block);
+            return NULL;
+        }
+        rest->offset = block->offset;
+        rest->size = pad;
+        opal_list_insert_pos(&heap->blocks, &block->super, &rest->super);
+        slab_insert_free(heap, rest);
+        block->offset += pad;
+        block->size -= pad;
+    }
+
+    if (block->size > size) {
+        /* without memory for the tail, the whole block is handed out */
+        rest = OBJ_NEW(mca_memheap_slab_block_t);
+        if (NULL != rest) {
+            rest->offset = block->offset + size;
+            rest->size = block->size - size;
+            opal_list_insert_pos(&heap->blocks, opal_list_get_next(&block->super),
+                                 &rest->super);
+            slab_insert_free(heap, rest);
+            block->size = size;
+        }
+    }
+
+    if (OPAL_SUCCESS != opal_hash_table_set_value_uint64(&heap->blocks_by_addr,
+                                                         (uint64_t) (uintptr_t) slab_block_addr(heap, block),
+                                                         block)) {
+        MEMHEAP_VERBOSE(5, "Failed to insert block to hashtable");
+        slab_insert_free(heap, block);
+        return NULL;
+    }
+
+    block->state = state;
+    return block;
+}
+
+/* give a block back and merge it with its free neighbours */
+static void slab_block_free(mca_memheap_slab_heap_t *heap,
+                            mca_memheap_slab_block_t *block)
+{
+    mca_memheap_slab_block_t *prev = slab_block_prev(heap, block);
+    mca_memheap_slab_block_t *next = slab_block_next(heap, block);
+
+    opal_hash_table_remove_value_uint64(&heap->blocks_by_addr,
+                                        (uint64_t) (uintptr_t) slab_block_addr(heap, block));
+    block->slab = NULL;
+
+    if (prev && (MEMHEAP_SLAB_BLOCK_FREE == prev->state)) {
+        slab_remove_free(heap, prev);
+        block->offset = prev->offset;
+        block->size += prev->size;
+        opal_list_remove_item(&heap->blocks, &prev->super);
+        OBJ_RELEASE(prev);
+    }
+
+    if (next && (MEMHEAP_SLAB_BLOCK_FREE == next->state)) {
+        slab_remove_free(heap, next);
+        block->size += next->size;
+        opal_list_remove_item(&heap->blocks, &next->super);
+        OBJ_RELEASE(next);
+    }
+
+    slab_insert_free(heap, block);
+}
+
+/* grow or shrink a used block without moving it */
+static int slab_block_resize(mca_memheap_slab_heap_t *heap,
+                             mca_memheap_slab_block_t *block, size_t size)
+{
+    mca_memheap_slab_block_t *next = slab_block_next(heap, block);
+    mca_memheap_slab_block_t *rest;
+    size_t delta;
+
+    if (size > heap->size) {
+        return OSHMEM_ERR_OUT_OF_RESOURCE;
+    }
+
+    size = OPAL_ALIGN(size, MEMHEAP_SLAB_BLOCK_ALIGN, size_t);
+    if (size > block->size) {
+        delta = size - block->size;
+        if (!next || (MEMHEAP_SLAB_BLOCK_FREE != next->state) || (next->size < delta)) {
+            return OSHMEM_ERR_OUT_OF_RESOURCE;
+        }
+        slab_remove_free(heap, next);
+        if (next->size == delta) {
+            opal_list_remove_item(&heap->blocks, &next->super);
+            OBJ_RELEASE(next);
+        } else {
+            next->offset += delta;
+            next->size -= delta;
+            slab_insert_free(heap, next);
+        }
+        block->size = size;
+        heap->stats.used += delta;
+    } else if (size < block->size) {
+        delta = block->size - size;
+        if (next && (MEMHEAP_SLAB_BLOCK_FREE == next->state)) {
+            slab_remove_free(heap, next);
+            next->offset -= delta;
+            next->size += delta;
+            slab_insert_free(heap, next);
+        } else {
+            rest = OBJ_NEW(mca_memheap_slab_block_t);
+            if (NULL == rest) {
+                return OSHMEM_SUCCESS;
+            }
+            rest->offset = block->offset + size;
+            rest->size = delta;
+            opal_list_insert_pos(&heap->blocks, opal_list_get_next(&block->super),
+                                 &rest->super);
+            slab_insert_free(heap, rest);
+        }
+        block->size = size;
+        heap->stats.used -= delta;
+    }
+
+    return OSHMEM_SUCCESS;
+}
+
+static inline int slab_class(size_t size)
+{
+    return memheap_slab.class_index[(size + MEMHEAP_SLAB_MIN_ALIGN - 1) / MEMHEAP_SLAB_MIN_ALIGN];
+}
+
+static void *slab_object_alloc(mca_memheap_slab_heap_t *heap, int cls)
+{
+    mca_memheap_slab_block_t *block;
+    mca_memheap_slab_slab_t *slab;
+    size_t size = memheap_slab.class_size[cls];
+    int idx;
+
+    if (opal_list_is_empty(&heap->partial[cls])) {
+        block = slab_block_alloc(heap, memheap_slab.slab_size, memheap_slab.slab_size,
+                                 MEMHEAP_SLAB_BLOCK_SLAB);
+        if (NULL == block) {
+            return NULL;
+        }
+
+        slab = OBJ_NEW(mca_memheap_slab_slab_t);
+        if ((NULL == slab) ||
+            (OPAL_SUCCESS != opal_bitmap_init(&slab->used,
+                                              (int) (memheap_slab.slab_size / size)))) {
+            if (NULL != slab) {
+                OBJ_RELEASE(slab);
+            }
+            slab_block_free(heap, block);
+            return NULL;
+        }
+
+        slab->block = block;
+        slab->cls = cls;
+        slab->nobjs = slab->nfree = (int) (memheap_slab.slab_size / size);
+        block->slab = slab;
+        opal_list_append(&heap->partial[cls], &slab->super);
+
+        heap->stats.slabs++;
+        heap->stats.slab_free += block->size;
+        MCA_SPML_CALL(memuse_hook(slab_block_addr(heap, block), block->size));
+    }
+
+    slab = (mca_memheap_slab_slab_t *) opal_list_get_first(&heap->partial[cls]);
+    opal_bitmap_find_and_set_first_unset_bit(&slab->used, &idx);
+    if (0 == --slab->nfree) {
+        opal_list_remove_item(&heap->partial[cls], &slab->super);
+    }
+
+    heap->stats.used += size;
+    heap->stats.slab_objects++;
+    heap->stats.slab_free -= size;
+
+    return slab_block_addr(heap, slab->block) + (size_t) idx * size;
+}
+
+/* index of the object at ptr, -1 if no object was handed out there */
+static int slab_object_index(mca_memheap_slab_heap_t *heap,
+                             mca_memheap_slab_slab_t *slab, char *ptr)
+{
+    size_t size = memheap_slab.class_size[slab->cls];
+    size_t offset = ptr - slab_block_addr(heap, slab->block);
+    int idx = (int) (offset / size);
+
+    if ((0 != offset % size) || (idx >= slab->nobjs) ||
+        !opal_bitmap_is_set_bit(&slab->used, idx)) {
+        return -1;
+    }
+    return idx;
+}
+
+static int slab_object_free(mca_memheap_slab_heap_t *heap,
+                            mca_memheap_slab_slab_t *slab, char *ptr)
+{
+    size_t size = memheap_slab.class_size[slab->cls];
+    int idx = slab_object_index(heap, slab, ptr);
+
+    if (0 > idx) {
+        return OSHMEM_ERROR;
+    }
+
+    opal_bitmap_clear_bit(&slab->used, idx);
+    if (0 == slab->nfree++) {
+        opal_list_append(&heap->partial[slab->cls], &slab->super);
+    }
+
+    heap->stats.used -= size;
+    heap->stats.slab_objects--;
+    heap->stats.slab_free += size;
+
+    /* empty slabs go back to the heap, so that other sizes can use them */
+    if (slab->nfree == slab->nobjs) {
+        opal_list_remove_item(&heap->partial[slab->cls], &slab->super);
+        heap->stats.slabs--;
+        heap->stats.slab_free -= slab->block->size;
+        slab_block_free(heap, slab->block);
+        OBJ_RELEASE(slab);
+    }
+
+    return OSHMEM_SUCCESS;
+}
+
+/* block holding ptr, with the number of bytes usable from ptr */
+static mca_memheap_slab_block_t *slab_find(mca_memheap_slab_heap_t *heap,
+                                           void *ptr, size_t *size)
+{
+    uintptr_t addr = (uintptr_t) ptr;
+    void *value;
+    mca_memheap_slab_block_t *block;
+
+    if ((addr < (uintptr_t) heap->base) || (addr >= (uintptr_t) heap->base + heap->size)) {
+        return NULL;
+    }
+
+    if (OPAL_SUCCESS == opal_hash_table_get_value_uint64(&heap->blocks_by_addr,
+                                                         (uint64_t) addr, &value)) {
+        block = (mca_memheap_slab_block_t *) value;
+    } else {
+        /* an object that is not the first of its slab */
+        addr = (uintptr_t) heap->base +
+               ((addr - (uintptr_t) heap->base) & ~(memheap_slab.slab_size - 1));
+        if ((OPAL_SUCCESS != opal_hash_table_get_value_uint64(&heap->blocks_by_addr,
+                                                              (uint64_t) addr, &value)) ||
+            (MEMHEAP_SLAB_BLOCK_SLAB != ((mca_memheap_slab_block_t *) value)->state)) {
+            return NULL;
+        }
+        block = (mca_memheap_slab_block_t *) value;
+    }
+
+    *size = (MEMHEAP_SLAB_BLOCK_SLAB == block->state) ?
+            memheap_slab.class_size[block->slab->cls] : block->size;
+    return block;
+}
+
+static int slab_heap_alloc(mca_memheap_slab_heap_t *heap, const char *name,
+                           size_t size, size_t align, void **p_buff)
+{
+    mca_memheap_slab_block_t *block;
+    int cls;
+
+    *p_buff = NULL;
+    if (0 == size) {
+        size = 1;
+    }
+
+    cls = memheap_slab.nclasses;
+    if (size <= memheap_slab.max_small_size) {
+        /* objects are aligned to the largest power of two dividing the
+         * size of their class */
+        for (cls = slab_class(size); cls < memheap_slab.nclasses; cls++) {
+            if (0 == memheap_slab.class_size[cls] % align) {
+                break;
+            }
+        }
+        if (cls < memheap_slab.nclasses) {
+            *p_buff = slab_object_alloc(heap, cls);
+        }
+    }
+
+    /* large objects, and small ones when no slab can be set up */
+    if (NULL == *p_buff) {
+        block = slab_block_alloc(heap, size, align, MEMHEAP_SLAB_BLOCK_USED);
+        if (NULL != block) {
+            heap->stats.used += block->size;
+            *p_buff = slab_block_addr(heap, block);
+            MCA_SPML_CALL(memuse_hook(*p_buff, block->size));
+        }
+    }
+
+    if (NULL == *p_buff) {
+        heap->stats.failures++;
+        MEMHEAP_VERBOSE(5, "Failed to allocate %lu bytes aligned to %lu",
+                        (unsigned long) size, (unsigned long) align);
+        slab_heap_report(name, heap, memheap_slab.print_stats ? 0 : 5);
+        return OSHMEM_ERR_OUT_OF_RESOURCE;
+    }
+
+    heap->stats.allocs++;
+    if (heap->stats.used > heap->stats.peak_used) {
+        heap->stats.peak_used = heap->stats.used;
+    }
+
+    return OSHMEM_SUCCESS;
+}
+
+static int slab_heap_free(mca_memheap_slab_heap_t *heap, void *ptr)
+{
+    mca_memheap_slab_block_t *block;
+    size_t size;
+    int rc;
+
+    if (NULL == ptr) {
+        return OSHMEM_SUCCESS;
+    }
+
+    block = slab_find(heap, ptr, &size);
+    if (NULL == block) {
+        return OSHMEM_ERROR;
+    }
+
+    if (MEMHEAP_SLAB_BLOCK_SLAB == block->state) {
+        rc = slab_object_free(heap, block->slab, (char *) ptr);
+        if (OSHMEM_SUCCESS != rc) {
+            return rc;
+        }
+    } else {
+        heap->stats.used -= block->size;
+        slab_block_free(heap, block);
+    }
+
+    heap->stats.frees++;
+    return OSHMEM_SUCCESS;
+}
+
+static int slab_heap_init(mca_memheap_slab_heap_t *heap, void *base, size_t size)
+{
+    mca_memheap_slab_block_t *block;
+    int i;
+
+    heap->base = (char *) base;
+    heap->size = size & ~((size_t) MEMHEAP_SLAB_BLOCK_ALIGN - 1);
+    memset(&heap->stats, 0, sizeof(heap->stats));
+
+    OBJ_CONSTRUCT(&heap->blocks, opal_list_t);
+    OBJ_CONSTRUCT(&heap->free_tree, opal_rb_tree_t);
+    OBJ_CONSTRUCT(&heap->blocks_by_addr, opal_hash_table_t);
+    for (i = 0; i < MEMHEAP_SLAB_MAX_CLASSES; i++) {
+        OBJ_CONSTRUCT(&heap->partial[i], opal_list_t);
+    }
+
+    if ((OPAL_SUCCESS != opal_rb_tree_init(&heap->free_tree, slab_free_cmp)) ||
+        (OPAL_SUCCESS != opal_hash_table_init(&heap->blocks_by_addr,
+                                              MEMHEAP_SLAB_HASHTABLE_SIZE))) {
+        return OSHMEM_ERR_OUT_OF_RESOURCE;
+    }
+
+    block = OBJ_NEW(mca_memheap_slab_block_t);
+    if (NULL == block) {
+        return OSHMEM_ERR_OUT_OF_RESOURCE;
+    }
+    block->size = heap->size;
+    opal_list_append(&heap->blocks, &block->super);
+
+    return slab_insert_free(heap, block);
+}
+
+static void slab_heap_cleanup(mca_memheap_slab_heap_t *heap)
+{
+    mca_memheap_slab_block_t *block;
+    int i;
+
+    for (i = 0; i < MEMHEAP_SLAB_MAX_CLASSES; i++) {
+        while (NULL != opal_list_remove_first(&heap->partial[i])) {
+            continue;
+        }
+        OBJ_DESTRUCT(&heap->partial[i]);
+    }
+
+    OBJ_DESTRUCT(&heap->free_tree);
+    OBJ_DESTRUCT(&heap->blocks_by_addr);
+
+    while (NULL != (block = (mca_memheap_slab_block_t *) opal_list_remove_first(&heap->blocks))) {
+        if (NULL != block->slab) {
+            OBJ_RELEASE(block->slab);
+        }
+        OBJ_RELEASE(block);
+    }
+    OBJ_DESTRUCT(&heap->blocks);
+}
+
+/*
+ * Size classes are 16 bytes apart up to 128 bytes and then four per
+ * power of two, so that less than a quarter of an object is lost.
+ */
+static int slab_classes_init(void)
+{
+    size_t size;
+    size_t step;
+    size_t i;
+    int cls;
+
+    if ((memheap_slab.slab_size < 4096) ||
+        (memheap_slab.slab_size & (memheap_slab.slab_size - 1))) {
+        MEMHEAP_WARN("slab_size must be a power of two of at least 4096 bytes, "
+                     "using 65536 instead of %lu", (unsigned long) memheap_slab.slab_size);
+        memheap_slab.slab_size = 65536;
+    }
+    if (memheap_slab.max_small_size > memheap_slab.slab_size / 8) {
+        memheap_slab.max_small_size = memheap_slab.slab_size / 8;
+    }
+
+    memheap_slab.nclasses = 0;
+    for (size = MEMHEAP_SLAB_MIN_ALIGN;
+         (size <= memheap_slab.max_small_size) && (memheap_slab.nclasses < MEMHEAP_SLAB_MAX_CLASSES);
+         size += step) {
+        memheap_slab.class_size[memheap_slab.nclasses++] = size;
+        if (size < 128) {
+            step = MEMHEAP_SLAB_MIN_ALIGN;
+        } else {
+            /* a quarter of the largest power of two not above size */
+            step = ((size_t) 1 << (memheap_log2(size + 1) - 1)) / 4;
+        }
+    }
+
+    /* sizes above the last class go to the blocks */
+    memheap_slab.max_small_size = memheap_slab.nclasses ?
+        memheap_slab.class_size[memheap_slab.nclasses - 1] : 0;
+
+    memheap_slab.class_index = (unsigned char *) malloc(memheap_slab.max_small_size /
+                                                        MEMHEAP_SLAB_MIN_ALIGN + 1);
+    if (NULL == memheap_slab.class_index) {
+        return OSHMEM_ERR_OUT_OF_RESOURCE;
+    }
+
+    for (i = 0, cls = 0; i <= memheap_slab.max_small_size / MEMHEAP_SLAB_MIN_ALIGN; i++) {
+        while (memheap_slab.class_size[cls] < i * MEMHEAP_SLAB_MIN_ALIGN) {
+            cls++;
+        }
+        memheap_slab.class_index[i] = (unsigned char) cls;
+    }
+
+    MEMHEAP_VERBOSE(5, "%d size classes up to %lu bytes in slabs of %lu bytes",
+                    memheap_slab.nclasses, (unsigned long) memheap_slab.max_small_size,
+                    (unsigned long) memheap_slab.slab_size);
+
+    return OSHMEM_SUCCESS;
+}
+
+/**
+ * Initialize the Memory Heap
+ */
+int mca_memheap_slab_module_init(memheap_context_t *context)
+{
+    int rc;
+
+    if (!context || !context->user_size || !context->private_size) {
+        return OSHMEM_ERR_BAD_PARAM;
+    }
+
+    /* Construct a mutex object */
+    OBJ_CONSTRUCT(&memheap_slab.lock, opal_mutex_t);
+    memheap_slab.initialized = true;
+    memheap_slab.my_pe = oshmem_my_proc_id();
+
+    rc = slab_heap_init(&memheap_slab.heap, context->user_base_addr, context->user_size);
+    if (OSHMEM_SUCCESS == slab_heap_init(&memheap_slab.private_heap,
+                                         context->private_base_addr,
+                                         context->private_size) &&
+        OSHMEM_SUCCESS == rc) {
+        rc = slab_classes_init();
+    } else {
+        rc = OSHMEM_ERR_OUT_OF_RESOURCE;
+    }
+
+    if (OSHMEM_SUCCESS != rc) {
+        MEMHEAP_ERROR("Failed to setup MEMHEAP slab allocator");
+        mca_memheap_slab_finalize();
+        return OSHMEM_ERROR;
+    }
+
+    memheap_slab.super.memheap_size = memheap_slab.heap.size;
+
+    MEMHEAP_VERBOSE(1,
+                    "symmetric heap memory (user+private): %llu bytes",
+                    (unsigned long long)(context->user_size + context->private_size));
+
+    return OSHMEM_SUCCESS;
+}
+
+int mca_memheap_slab_alloc(size_t size, void** p_buff)
+{
+    int rc;
+
+    OPAL_THREAD_LOCK(&memheap_slab.lock);
+    rc = slab_heap_alloc(&memheap_slab.heap, "user", size, MEMHEAP_SLAB_MIN_ALIGN, p_buff);
+    OPAL_THREAD_UNLOCK(&memheap_slab.lock);
+
+    return rc;
+}
+
+int mca_memheap_slab_align(size_t align, size_t size, void **p_buff)
+{
+    int rc;
+
+    /* check that align is power of 2 */
+    if ((0 == align) || (align & (align - 1))) {
+        *p_buff = 0;
+        return OSHMEM_ERROR;
+    }
+
+    if (align < MEMHEAP_SLAB_MIN_ALIGN) {
+        align = MEMHEAP_SLAB_MIN_ALIGN;
+    }
+
+    OPAL_THREAD_LOCK(&memheap_slab.lock);
+    rc = slab_heap_alloc(&memheap_slab.heap, "user", size, align, p_buff);
+    OPAL_THREAD_UNLOCK(&memheap_slab.lock);
+
+    return rc;
+}
+
+int mca_memheap_slab_realloc(size_t new_size, void *p_buff, void **p_new_buff)
+{
+    mca_memheap_slab_heap_t *heap = &memheap_slab.heap;
+    mca_memheap_slab_block_t *block;
+    size_t old_size;
+    int rc;
+
+    /* equiv to alloc if old ptr is null */
+    if (NULL == p_buff) {
+        return mca_memheap_slab_alloc(new_size, p_new_buff);
+    }
+
+    /* equiv to free if new_size is 0 */
+    if (0 == new_size) {
+        *p_new_buff = NULL;
+        return mca_memheap_slab_free(p_buff);
+    }
+
+    OPAL_THREAD_LOCK(&memheap_slab.lock);
+
+    block = slab_find(heap, p_buff, &old_size);
+    if ((NULL == block) || ((MEMHEAP_SLAB_BLOCK_SLAB == block->state) &&
+                            (0 > slab_object_index(heap, block->slab, (char *) p_buff)))) {
+        OPAL_THREAD_UNLOCK(&memheap_slab.lock);
+        *p_new_buff = NULL;
+        return OSHMEM_ERROR;
+    }
+
+    /* blocks grow into the free space behind them and shrink in place,
+     * objects stay where they are while they fit */
+    if (((MEMHEAP_SLAB_BLOCK_USED == block->state) &&
+         (OSHMEM_SUCCESS == slab_block_resize(heap, block, new_size))) ||
+        ((MEMHEAP_SLAB_BLOCK_SLAB == block->state) && (new_size <= old_size))) {
+        if (heap->stats.used > heap->stats.peak_used) {
+            heap->stats.peak_used = heap->stats.used;
+        }
+        OPAL_THREAD_UNLOCK(&memheap_slab.lock);
+        *p_new_buff = p_buff;
+        return OSHMEM_SUCCESS;
+    }
+
+    /* alloc and copy data to new buffer, free old one */
+    rc = slab_heap_alloc(heap, "user", new_size, MEMHEAP_SLAB_MIN_ALIGN, p_new_buff);
+    if (OSHMEM_SUCCESS == rc) {
+        memcpy(*p_new_buff, p_buff, (old_size < new_size) ? old_size : new_size);
+        slab_heap_free(heap, p_buff);
+    }
+
+    OPAL_THREAD_UNLOCK(&memheap_slab.lock);
+    return rc;
+}
+
+/*
+ * Free a variable allocated on the
+ * symmetric heap.
+ */
+int mca_memheap_slab_free(void* ptr)
+{
+    int rc;
+
+    OPAL_THREAD_LOCK(&memheap_slab.lock);
+    rc = slab_heap_free(&memheap_slab.heap, ptr);
+    OPAL_THREAD_UNLOCK(&memheap_slab.lock);
+
+    return rc;
+}
+
+int mca_memheap_slab_private_alloc(size_t size, void** p_buff)
+{
+    int rc;
+
+    OPAL_THREAD_LOCK(&memheap_slab.lock);
+    rc = slab_heap_alloc(&memheap_slab.private_heap, "private", size,
+                         MEMHEAP_SLAB_MIN_ALIGN, p_buff);
+    OPAL_THREAD_UNLOCK(&memheap_slab.lock);
+
+    MEMHEAP_VERBOSE(20, "private alloc addr: %p", *p_buff);
+
+    return rc;
+}
+
+int mca_memheap_slab_private_free(void* ptr)
+{
+    int rc;
+
+    OPAL_THREAD_LOCK(&memheap_slab.lock);
+    rc = slab_heap_free(&memheap_slab.private_heap, ptr);
+    OPAL_THREAD_UNLOCK(&memheap_slab.lock);
+
+    return rc;
+}
+
+int mca_memheap_slab_finalize(void)
+{
+    MEMHEAP_VERBOSE(5, "deregistering symmetric heap");
+
+    /* was not initialized - do nothing */
+    if (!memheap_slab.initialized) {
+        return OSHMEM_SUCCESS;
+    }
+
+    slab_heap_report("user", &memheap_slab.heap, memheap_slab.print_stats ? 0 : 5);
+
+    slab_heap_cleanup(&memheap_slab.heap);
+    slab_heap_cleanup(&memheap_slab.private_heap);
+
+    free(memheap_slab.class_index);
+    memheap_slab.class_index = NULL;
+
+    OBJ_DESTRUCT(&memheap_slab.lock);
+    memheap_slab.initialized = false;
+
+    return OSHMEM_SUCCESS;
+}
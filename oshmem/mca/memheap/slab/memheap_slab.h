@@ -0,0 +1,140 @@
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+/**
+ * @file
+ *
+ * Symmetric heap allocator with size classes.
+ *
+ * Small objects are carved from slabs: blocks of slab_size bytes, aligned
+ * to their size, holding objects of a single size class. Everything else
+ * is a block of the heap placed with a best-fit policy. The free blocks
+ * are kept in a tree ordered by size and offset, all blocks in a list
+ * ordered by offset so that a freed block is merged with its neighbours
+ * in constant time.
+ *
+ * The heap itself only holds user data, all metadata is allocated with
+ * malloc. The placement only depends on the sequence of calls, so the
+ * PEs that allocate and free the same sizes in the same order get the
+ * same addresses without communicating.
+ */
+#ifndef MCA_MEMHEAP_SLAB_H
+#define MCA_MEMHEAP_SLAB_H
+
+#include "oshmem_config.h"
+#include "oshmem/mca/mca.h"
+#include "opal/class/opal_list.h"
+#include "opal/class/opal_bitmap.h"
+#include "opal/class/opal_rb_tree.h"
+#include "opal/class/opal_hash_table.h"
+#include "opal/mca/threads/mutex.h"
+#include "oshmem/mca/memheap/memheap.h"
+#include "oshmem/mca/memheap/base/base.h"
+
+BEGIN_C_DECLS
+
+#define MEMHEAP_SLAB_MIN_ALIGN           16  /* alignment of every object */
+#define MEMHEAP_SLAB_BLOCK_ALIGN         64  /* granularity of the blocks */
+#define MEMHEAP_SLAB_MAX_CLASSES         64
+#define MEMHEAP_SLAB_HASHTABLE_SIZE      1024
+
+enum {
+    MEMHEAP_SLAB_BLOCK_FREE = 0,
+    MEMHEAP_SLAB_BLOCK_USED,        /* handed out as a whole */
+    MEMHEAP_SLAB_BLOCK_SLAB         /* carved in objects of a size class */
+};
+
+struct mca_memheap_slab_slab_t;
+
+/* A range of the heap */
+struct mca_memheap_slab_block_t {
+    opal_list_item_t super;         /* on the list of all blocks, by offset */
+    size_t offset;
+    size_t size;
+    int state;
+    struct mca_memheap_slab_slab_t *slab;
+};
+typedef struct mca_memheap_slab_block_t mca_memheap_slab_block_t;
+OBJ_CLASS_DECLARATION(mca_memheap_slab_block_t);
+
+struct mca_memheap_slab_slab_t {
+    opal_list_item_t super;         /* on the list of its class while not full */
+    mca_memheap_slab_block_t *block;
+    int cls;
+    int nobjs;
+    int nfree;
+    opal_bitmap_t used;
+};
+typedef struct mca_memheap_slab_slab_t mca_memheap_slab_slab_t;
+OBJ_CLASS_DECLARATION(mca_memheap_slab_slab_t);
+
+/* All sizes in bytes */
+struct mca_memheap_slab_stats_t {
+    size_t used;                    /* handed out, rounded to class or block size */
+    size_t peak_used;
+    size_t free;                    /* in free blocks */
+    size_t free_blocks;
+    size_t slabs;
+    size_t slab_objects;            /* objects handed out from slabs */
+    size_t slab_free;               /* in free objects of the slabs */
+    size_t allocs;
+    size_t frees;
+    size_t failures;
+};
+typedef struct mca_memheap_slab_stats_t mca_memheap_slab_stats_t;
+
+struct mca_memheap_slab_heap_t {
+    char *base;
+    size_t size;
+    opal_list_t blocks;
+    opal_rb_tree_t free_tree;
+    opal_hash_table_t blocks_by_addr; /* used blocks and slabs */
+    opal_list_t partial[MEMHEAP_SLAB_MAX_CLASSES];
+    mca_memheap_slab_stats_t stats;
+};
+typedef struct mca_memheap_slab_heap_t mca_memheap_slab_heap_t;
+
+/* Structure for managing shmem symmetric heap */
+struct mca_memheap_slab_module_t {
+    mca_memheap_base_module_t super;
+
+    int priority;                   /** Module's Priority */
+    size_t slab_size;
+    size_t max_small_size;
+    int print_stats;
+
+    /* size classes of the small objects */
+    int nclasses;
+    size_t class_size[MEMHEAP_SLAB_MAX_CLASSES];
+    unsigned char *class_index;     /* class of the sizes, by 16 bytes */
+
+    mca_memheap_slab_heap_t heap;
+    mca_memheap_slab_heap_t private_heap;
+    bool initialized;
+    int my_pe;
+    opal_mutex_t lock;
+};
+typedef struct mca_memheap_slab_module_t mca_memheap_slab_module_t;
+OSHMEM_DECLSPEC extern mca_memheap_slab_module_t memheap_slab;
+
+OSHMEM_DECLSPEC extern int mca_memheap_slab_module_init(memheap_context_t *);
+OSHMEM_DECLSPEC extern int mca_memheap_slab_alloc(size_t, void**);
+OSHMEM_DECLSPEC extern int mca_memheap_slab_realloc(size_t, void*, void **);
+OSHMEM_DECLSPEC extern int mca_memheap_slab_align(size_t, size_t, void**);
+OSHMEM_DECLSPEC extern int mca_memheap_slab_free(void*);
+OSHMEM_DECLSPEC extern int mca_memheap_slab_finalize(void);
+
+/* private alloc/free functions */
+OSHMEM_DECLSPEC extern int mca_memheap_slab_private_alloc(size_t, void**);
+OSHMEM_DECLSPEC extern int mca_memheap_slab_private_free(void*);
+
+END_C_DECLS
+
+#endif /* MCA_MEMHEAP_SLAB_H */
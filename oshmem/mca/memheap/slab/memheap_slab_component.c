@@ -0,0 +1,110 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+#include "oshmem_config.h"
+#include "opal/util/output.h"
+#include "oshmem/mca/memheap/memheap.h"
+#include "oshmem/mca/memheap/base/base.h"
+#include "oshmem/mca/memheap/slab/memheap_slab.h"
+#include "memheap_slab_component.h"
+
+static int mca_memheap_slab_component_register(void);
+static int mca_memheap_slab_component_close(void);
+static int mca_memheap_slab_component_query(mca_base_module_t **module, int *priority);
+
+static int _basic_open(void);
+
+mca_memheap_base_component_t mca_memheap_slab_component = {
+    .memheap_version = {
+        MCA_MEMHEAP_BASE_VERSION_2_0_0,
+
+        .mca_component_name = "slab",
+        MCA_BASE_MAKE_VERSION(component, OSHMEM_MAJOR_VERSION, OSHMEM_MINOR_VERSION,
+                              OSHMEM_RELEASE_VERSION),
+
+        .mca_open_component = _basic_open,
+        .mca_close_component = mca_memheap_slab_component_close,
+        .mca_query_component = mca_memheap_slab_component_query,
+        .mca_register_component_params = mca_memheap_slab_component_register,
+    },
+    .memheap_data = {
+        /* The component is checkpoint ready */
+        MCA_BASE_METADATA_PARAM_CHECKPOINT
+    },
+    .memheap_init = mca_memheap_slab_module_init
+};
+
+static int mca_memheap_slab_component_register(void)
+{
+    mca_base_component_t *comp = &mca_memheap_slab_component.memheap_version;
+
+    (void) mca_base_component_var_register(comp,
+                                           "priority",
+                                           "Priority of the memheap:slab component",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, MCA_BASE_VAR_FLAG_SETTABLE,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &memheap_slab.priority);
+
+    (void) mca_base_component_var_register(comp,
+                                           "slab_size",
+                                           "Size in bytes of the slabs holding the small objects "
+                                           "(power of two)",
+                                           MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, MCA_BASE_VAR_FLAG_SETTABLE,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &memheap_slab.slab_size);
+
+    (void) mca_base_component_var_register(comp,
+                                           "max_small_size",
+                                           "Largest allocation in bytes served from a slab "
+                                           "(at most slab_size / 8)",
+                                           MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, MCA_BASE_VAR_FLAG_SETTABLE,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &memheap_slab.max_small_size);
+
+    (void) mca_base_component_var_register(comp,
+                                           "print_stats",
+                                           "[1|0] Print the usage and fragmentation of the symmetric heap "
+                                           "when an allocation fails and at finalize",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, MCA_BASE_VAR_FLAG_SETTABLE,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &memheap_slab.print_stats);
+
+    return OSHMEM_SUCCESS;
+}
+
+/* Open component */
+static int _basic_open(void)
+{
+    return OSHMEM_SUCCESS;
+}
+
+/* query component */
+static int
+mca_memheap_slab_component_query(mca_base_module_t **module, int *priority)
+{
+    *priority = memheap_slab.priority;
+    *module = (mca_base_module_t *)&memheap_slab.super;
+    return OSHMEM_SUCCESS;
+}
+
+/*
+ * This function is automaticaly called from mca_base_components_close.
+ * It releases the component's allocated memory.
+ */
+int mca_memheap_slab_component_close()
+{
+    mca_memheap_slab_finalize();
+    return OSHMEM_SUCCESS;
+}
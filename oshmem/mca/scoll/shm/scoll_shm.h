@@ -0,0 +1,246 @@
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#ifndef MCA_SCOLL_SHM_H
+#define MCA_SCOLL_SHM_H
+
+#include "oshmem_config.h"
+
+#include "shmem.h"
+#include "opal/align.h"
+#include "opal/sys/atomic.h"
+#include "opal/runtime/opal_progress.h"
+#include "oshmem/mca/mca.h"
+#include "oshmem/mca/scoll/scoll.h"
+#include "oshmem/mca/memheap/memheap.h"
+#include "oshmem/mca/memheap/base/base.h"
+#include "oshmem/proc/proc.h"
+#include "oshmem/util/oshmem_util.h"
+
+BEGIN_C_DECLS
+
+/*
+ * The shm component runs the collectives of the active sets that span
+ * all PEs through the symmetric heap of the PEs on the same node, which
+ * every local peer maps (see shmem_ptr()). Each PE owns a region in the
+ * private part of the symmetric heap holding a few flags and a staging
+ * buffer. Flags are only written by their owner and only grow: the n-th
+ * shm collective of a PE posts the value n, so waiting for a peer is
+ * waiting for its flag to reach the sequence number of the collective.
+ *
+ * When the PEs are on several nodes, the lowest PE of every node is the
+ * node leader and the inter-node part of a collective is run by the
+ * modules selected for the active set of the leaders. This requires
+ * the PEs to be mapped by node with the same number of PEs on every
+ * node. Everything the component can not run through shared memory is
+ * handed to the modules it has replaced.
+ */
+
+#define SCOLL_SHM_CACHE_LINE        64
+
+enum {
+    SCOLL_SHM_FLAG_ARRIVE = 0,      /* my source and size are published */
+    SCOLL_SHM_FLAG_READY,           /* my part of the result is published */
+    SCOLL_SHM_FLAG_RESULT,          /* the result of my node is published */
+    SCOLL_SHM_FLAG_DONE,            /* I do not read my peers any more */
+    SCOLL_SHM_FLAG_MAX
+};
+
+enum {
+    SCOLL_SHM_VOTE_OK = 0,          /* local peers are mapped and in block order */
+    SCOLL_SHM_VOTE_PPN,             /* number of PEs on my node */
+    SCOLL_SHM_VOTE_NEG_PPN,
+    SCOLL_SHM_VOTE_MAX
+};
+
+typedef struct mca_scoll_shm_flag_t {
+    volatile uint64_t value;
+    char pad[SCOLL_SHM_CACHE_LINE - sizeof(uint64_t)];
+} mca_scoll_shm_flag_t;
+
+typedef struct mca_scoll_shm_region_t {
+    mca_scoll_shm_flag_t flag[SCOLL_SHM_FLAG_MAX];
+    mca_scoll_shm_flag_t size;      /* bytes contributed to a collect */
+
+    /* used once, to agree on the topology */
+    long psync[_SHMEM_REDUCE_SYNC_SIZE];
+    int vote[SCOLL_SHM_VOTE_MAX];
+    int vote_result[SCOLL_SHM_VOTE_MAX];
+    int vote_wrk[SCOLL_SHM_VOTE_MAX + _SHMEM_REDUCE_MIN_WRKDATA_SIZE];
+} mca_scoll_shm_region_t;
+
+/* the staging buffer follows the region */
+#define SCOLL_SHM_REGION_SIZE \
+    OPAL_ALIGN(sizeof(mca_scoll_shm_region_t), SCOLL_SHM_CACHE_LINE, size_t)
+
+/* Globally exported structure */
+
+struct mca_scoll_shm_component_t {
+    mca_scoll_base_component_1_0_0_t super;
+
+    /* MCA parameters */
+    int priority;
+    int enable;
+    size_t buffer_size;
+
+    /* State shared by the modules of all active sets spanning all PEs */
+    bool initialized;
+    bool active;                    /* all PEs agreed to use shared memory */
+    uint64_t seq;                   /* number of shm collectives run */
+    mca_scoll_shm_region_t *region;
+    void *heap_base;
+    char **peer_heap;               /* heap of the local peers, mapped */
+    int local_size;
+    int local_rank;
+    int local_start;                /* first PE of my node */
+    int node_count;
+    int node_rank;
+    struct oshmem_group_t *leaders;
+};
+typedef struct mca_scoll_shm_component_t mca_scoll_shm_component_t;
+
+OSHMEM_MODULE_DECLSPEC extern mca_scoll_shm_component_t mca_scoll_shm_component;
+
+struct mca_scoll_shm_module_t {
+    mca_scoll_base_module_t super;
+
+    /* Saved handlers - for fallback */
+    mca_scoll_base_module_barrier_fn_t previous_barrier;
+    mca_scoll_base_module_t *previous_barrier_module;
+    mca_scoll_base_module_broadcast_fn_t previous_broadcast;
+    mca_scoll_base_module_t *previous_broadcast_module;
+    mca_scoll_base_module_collect_fn_t previous_collect;
+    mca_scoll_base_module_t *previous_collect_module;
+    mca_scoll_base_module_reduce_fn_t previous_reduce;
+    mca_scoll_base_module_t *previous_reduce_module;
+    mca_scoll_base_module_alltoall_fn_t previous_alltoall;
+    mca_scoll_base_module_t *previous_alltoall_module;
+};
+typedef struct mca_scoll_shm_module_t mca_scoll_shm_module_t;
+OBJ_CLASS_DECLARATION(mca_scoll_shm_module_t);
+
+/* API functions */
+
+int mca_scoll_shm_init(bool enable_progress_threads, bool enable_threads);
+mca_scoll_base_module_t*
+mca_scoll_shm_query(struct oshmem_group_t *group, int *priority);
+void mca_scoll_shm_release(void);
+
+int mca_scoll_shm_barrier(struct oshmem_group_t *group, long *pSync, int alg);
+int mca_scoll_shm_broadcast(struct oshmem_group_t *group,
+                            int PE_root,
+                            void *target,
+                            const void *source,
+                            size_t nlong,
+                            long *pSync,
+                            bool nlong_type,
+                            int alg);
+int mca_scoll_shm_collect(struct oshmem_group_t *group,
+                          void *target,
+                          const void *source,
+                          size_t nlong,
+                          long *pSync,
+                          bool nlong_type,
+                          int alg);
+int mca_scoll_shm_reduce(struct oshmem_group_t *group,
+                         struct oshmem_op_t *op,
+                         void *target,
+                         const void *source,
+                         size_t nlong,
+                         long *pSync,
+                         void *pWrk,
+                         int alg);
+int mca_scoll_shm_alltoall(struct oshmem_group_t *group,
+                           void *target,
+                           const void *source,
+                           ptrdiff_t dst, ptrdiff_t sst,
+                           size_t nelems,
+                           size_t element_size,
+                           long *pSync,
+                           int alg);
+
+/* barrier of the PEs of a node and of the leaders, without quiet */
+int mca_scoll_shm_node_barrier(uint64_t seq, long *pSync);
+
+/* address of va in the symmetric heap of the local peer lrank */
+static inline void *scoll_shm_peer_ptr(int lrank, const void *va)
+{
+    mca_scoll_shm_component_t *cm = &mca_scoll_shm_component;
+
+    return cm->peer_heap[lrank] + ((const char *) va - (const char *) cm->heap_base);
+}
+
+static inline mca_scoll_shm_region_t *scoll_shm_peer_region(int lrank)
+{
+    return (mca_scoll_shm_region_t *) scoll_shm_peer_ptr(lrank, mca_scoll_shm_component.region);
+}
+
+static inline char *scoll_shm_data(mca_scoll_shm_region_t *region)
+{
+    return (char *) region + SCOLL_SHM_REGION_SIZE;
+}
+
+/* Local peers can only access buffers located in the symmetric heap.
+ * Buffers are symmetric, so all PEs come to the same answer. */
+static inline bool scoll_shm_in_heap(const void *va)
+{
+    return memheap_is_va_in_segment((void *) va, HEAP_SEG_INDEX);
+}
+
+static inline bool scoll_shm_is_leader(void)
+{
+    return 0 == mca_scoll_shm_component.local_rank;
+}
+
+static inline uint64_t scoll_shm_next_seq(void)
+{
+    return ++mca_scoll_shm_component.seq;
+}
+
+static inline void scoll_shm_post(mca_scoll_shm_region_t *region, int flag, uint64_t seq)
+{
+    opal_atomic_wmb();
+    region->flag[flag].value = seq;
+}
+
+static inline void scoll_shm_wait(mca_scoll_shm_region_t *region, int flag, uint64_t seq)
+{
+    while (region->flag[flag].value < seq) {
+        opal_progress();
+    }
+    opal_atomic_rmb();
+}
+
+static inline void scoll_shm_wait_all(int flag, uint64_t seq)
+{
+    int i;
+
+    for (i = 0; i < mca_scoll_shm_component.local_size; i++) {
+        scoll_shm_wait(scoll_shm_peer_region(i), flag, seq);
+    }
+}
+
+/* The local peer lrank, or every local peer if lrank is negative, waits
+ * until no peer reads its buffers any more before they are handed back
+ * to the application */
+static inline void scoll_shm_wait_done(int lrank, uint64_t seq)
+{
+    mca_scoll_shm_region_t *region = mca_scoll_shm_component.region;
+
+    scoll_shm_post(region, SCOLL_SHM_FLAG_DONE, seq);
+    if (0 > lrank || lrank == mca_scoll_shm_component.local_rank) {
+        scoll_shm_wait_all(SCOLL_SHM_FLAG_DONE, seq);
+    }
+}
+
+END_C_DECLS
+
+#endif /* MCA_SCOLL_SHM_H */
@@ -0,0 +1,126 @@
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "oshmem_config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "oshmem/constants.h"
+#include "oshmem/runtime/runtime.h"
+#include "oshmem/mca/spml/spml.h"
+#include "oshmem/mca/scoll/scoll.h"
+#include "oshmem/mca/scoll/base/base.h"
+#include "scoll_shm.h"
+
+static inline void *
+get_stride_elem(const void *base, ptrdiff_t sst, size_t nelems, size_t elem_size,
+                int block_idx, int elem_idx)
+{
+    return (char *)base + elem_size * sst * (nelems * block_idx + elem_idx);
+}
+
+/*
+ * Blocks are stored into the target of the PEs of the node and put to
+ * the others, as in scoll:basic, followed by a barrier.
+ */
+int mca_scoll_shm_alltoall(struct oshmem_group_t *group,
+                           void *target,
+                           const void *source,
+                           ptrdiff_t dst, ptrdiff_t sst,
+                           size_t nelems,
+                           size_t element_size,
+                           long *pSync,
+                           int alg)
+{
+    mca_scoll_shm_component_t *cm = &mca_scoll_shm_component;
+    mca_scoll_shm_module_t *shm_module =
+        (mca_scoll_shm_module_t *) group->g_scoll.scoll_alltoall_module;
+    int nprocs = group->proc_count;
+    int me = group->my_pe;
+    int i, pe, lrank;
+    size_t elem_idx;
+    void *peer_target;
+    int rc;
+
+    if (!cm->active || !scoll_shm_in_heap(target)) {
+        PREVIOUS_SCOLL_FN(shm_module, alltoall, group, target, source, dst, sst,
+                          nelems, element_size, pSync, alg);
+        return rc;
+    }
+
+    /* Do nothing on zero-length request */
+    if (OPAL_UNLIKELY(!nelems)) {
+        return OSHMEM_SUCCESS;
+    }
+
+    SCOLL_VERBOSE(12, "[#%d] shared memory alltoall, %zu elements",
+                  group->my_pe, nelems);
+
+    /* start with the next PE for better distribution of traffic */
+    for (i = 1; i <= nprocs; i++) {
+        pe = (me + i) % nprocs;
+        lrank = pe - cm->local_start;
+
+        if ((0 <= lrank) && (lrank < cm->local_size)) {
+            peer_target = scoll_shm_peer_ptr(lrank, target);
+            if ((1 == sst) && (1 == dst)) {
+                memcpy(get_stride_elem(peer_target, 1, nelems, element_size, me, 0),
+                       get_stride_elem(source, 1, nelems, element_size, pe, 0),
+                       nelems * element_size);
+            } else {
+                for (elem_idx = 0; elem_idx < nelems; elem_idx++) {
+                    memcpy(get_stride_elem(peer_target, dst, nelems, element_size,
+                                           me, elem_idx),
+                           get_stride_elem(source, sst, nelems, element_size,
+                                           pe, elem_idx),
+                           element_size);
+                }
+            }
+            continue;
+        }
+
+        if ((1 == sst) && (1 == dst)) {
+            rc = MCA_SPML_CALL(put(oshmem_ctx_default,
+                        get_stride_elem(target, 1, nelems, element_size, me, 0),
+                        nelems * element_size,
+                        get_stride_elem(source, 1, nelems, element_size, pe, 0),
+                        pe));
+        } else {
+            for (elem_idx = 0, rc = OSHMEM_SUCCESS;
+                 (elem_idx < nelems) && (OSHMEM_SUCCESS == rc); elem_idx++) {
+                rc = MCA_SPML_CALL(put(oshmem_ctx_default,
+                            get_stride_elem(target, dst, nelems, element_size,
+                                            me, elem_idx),
+                            element_size,
+                            get_stride_elem(source, sst, nelems, element_size,
+                                            pe, elem_idx),
+                            pe));
+            }
+        }
+        if (OSHMEM_SUCCESS != rc) {
+            return rc;
+        }
+    }
+
+    /* quiet is needed because the barrier does not guarantee put
+     * completion */
+    MCA_SPML_CALL(quiet(oshmem_ctx_default));
+
+    rc = mca_scoll_shm_node_barrier(scoll_shm_next_seq(), pSync);
+
+    /* Restore initial values */
+    for (i = 0; pSync && (i < _SHMEM_ALLTOALL_SYNC_SIZE); i++) {
+        pSync[i] = _SHMEM_SYNC_VALUE;
+    }
+
+    return rc;
+}
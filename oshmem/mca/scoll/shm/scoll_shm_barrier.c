@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "oshmem_config.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "oshmem/constants.h"
+#include "oshmem/runtime/runtime.h"
+#include "oshmem/mca/spml/spml.h"
+#include "oshmem/mca/scoll/scoll.h"
+#include "oshmem/mca/scoll/base/base.h"
+#include "scoll_shm.h"
+
+/*
+ * The PEs of a node signal their arrival to the leader, the leaders run
+ * a barrier among themselves and release the PEs of their node.
+ */
+int mca_scoll_shm_node_barrier(uint64_t seq, long *pSync)
+{
+    mca_scoll_shm_component_t *cm = &mca_scoll_shm_component;
+    int rc = OSHMEM_SUCCESS;
+
+    scoll_shm_post(cm->region, SCOLL_SHM_FLAG_ARRIVE, seq);
+
+    if (scoll_shm_is_leader()) {
+        scoll_shm_wait_all(SCOLL_SHM_FLAG_ARRIVE, seq);
+        if (NULL != cm->leaders) {
+            rc = cm->leaders->g_scoll.scoll_barrier(cm->leaders, pSync, SCOLL_DEFAULT_ALG);
+        }
+        /* release the PEs of the node even on error, they would hang */
+        scoll_shm_post(cm->region, SCOLL_SHM_FLAG_READY, seq);
+    } else {
+        scoll_shm_wait(scoll_shm_peer_region(0), SCOLL_SHM_FLAG_READY, seq);
+    }
+
+    return rc;
+}
+
+int mca_scoll_shm_barrier(struct oshmem_group_t *group, long *pSync, int alg)
+{
+    mca_scoll_shm_module_t *shm_module =
+        (mca_scoll_shm_module_t *) group->g_scoll.scoll_barrier_module;
+    int rc;
+
+    if (!mca_scoll_shm_component.active) {
+        PREVIOUS_SCOLL_FN(shm_module, barrier, group, pSync, alg);
+        return rc;
+    }
+
+    SCOLL_VERBOSE(12, "[#%d] shared memory barrier", group->my_pe);
+
+    /* the leaders' barrier does not complete the puts of the other PEs */
+    MCA_SPML_CALL(quiet(oshmem_ctx_default));
+
+    return mca_scoll_shm_node_barrier(scoll_shm_next_seq(), pSync);
+}
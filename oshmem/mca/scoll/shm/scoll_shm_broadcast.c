@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "oshmem_config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "oshmem/constants.h"
+#include "oshmem/mca/scoll/scoll.h"
+#include "oshmem/mca/scoll/base/base.h"
+#include "scoll_shm.h"
+
+/*
+ * The PEs of the node of the root copy the source of the root. Its
+ * leader then broadcasts to the other leaders, from which the PEs of
+ * the other nodes copy. The target of the root is not updated.
+ */
+int mca_scoll_shm_broadcast(struct oshmem_group_t *group,
+                            int PE_root,
+                            void *target,
+                            const void *source,
+                            size_t nlong,
+                            long *pSync,
+                            bool nlong_type,
+                            int alg)
+{
+    mca_scoll_shm_component_t *cm = &mca_scoll_shm_component;
+    mca_scoll_shm_module_t *shm_module =
+        (mca_scoll_shm_module_t *) group->g_scoll.scoll_broadcast_module;
+    int root_node, root_rank;
+    uint64_t seq;
+    int rc = OSHMEM_SUCCESS;
+
+    /* the size is not known by all PEs or the buffers can not be mapped */
+    if (!cm->active || !nlong_type ||
+        !scoll_shm_in_heap(source) || !scoll_shm_in_heap(target)) {
+        PREVIOUS_SCOLL_FN(shm_module, broadcast, group, PE_root, target, source,
+                          nlong, pSync, nlong_type, alg);
+        return rc;
+    }
+
+    /* Do nothing on zero-length request */
+    if (OPAL_UNLIKELY(!nlong)) {
+        return OSHMEM_SUCCESS;
+    }
+
+    SCOLL_VERBOSE(12, "[#%d] shared memory broadcast from %d, %zu bytes",
+                  group->my_pe, PE_root, nlong);
+
+    seq = scoll_shm_next_seq();
+    root_node = PE_root / cm->local_size;
+    root_rank = PE_root % cm->local_size;
+
+    if (root_node == cm->node_rank) {
+        if (root_rank == cm->local_rank) {
+            scoll_shm_post(cm->region, SCOLL_SHM_FLAG_ARRIVE, seq);
+        } else {
+            scoll_shm_wait(scoll_shm_peer_region(root_rank), SCOLL_SHM_FLAG_ARRIVE, seq);
+            memcpy(target, scoll_shm_peer_ptr(root_rank, source), nlong);
+        }
+
+        if ((NULL != cm->leaders) && scoll_shm_is_leader()) {
+            rc = cm->leaders->g_scoll.scoll_broadcast(cm->leaders, group->my_pe, target,
+                                                      (0 == root_rank) ? source : target,
+                                                      nlong, pSync, true, alg);
+        }
+
+        scoll_shm_wait_done(root_rank, seq);
+    } else {
+        if (scoll_shm_is_leader()) {
+            rc = cm->leaders->g_scoll.scoll_broadcast(cm->leaders, root_node * cm->local_size,
+                                                      target, source, nlong, pSync, true, alg);
+            scoll_shm_post(cm->region, SCOLL_SHM_FLAG_ARRIVE, seq);
+        } else {
+            scoll_shm_wait(scoll_shm_peer_region(0), SCOLL_SHM_FLAG_ARRIVE, seq);
+            memcpy(target, scoll_shm_peer_ptr(0, target), nlong);
+        }
+
+        scoll_shm_wait_done(0, seq);
+    }
+
+    return rc;
+}
@@ -0,0 +1,129 @@
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "oshmem_config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "oshmem/constants.h"
+#include "oshmem/mca/scoll/scoll.h"
+#include "oshmem/mca/scoll/base/base.h"
+#include "scoll_shm.h"
+
+/* every PE copies the sources of all PEs */
+static int _algorithm_node(void *target,
+                           const void *source,
+                           size_t nlong,
+                           bool nlong_type,
+                           uint64_t seq)
+{
+    mca_scoll_shm_component_t *cm = &mca_scoll_shm_component;
+    mca_scoll_shm_region_t *peer;
+    size_t offset = 0;
+    size_t len;
+    int i;
+
+    cm->region->size.value = nlong;
+    scoll_shm_post(cm->region, SCOLL_SHM_FLAG_ARRIVE, seq);
+
+    for (i = 0; i < cm->local_size; i++) {
+        peer = scoll_shm_peer_region(i);
+        scoll_shm_wait(peer, SCOLL_SHM_FLAG_ARRIVE, seq);
+        len = nlong_type ? nlong : peer->size.value;
+        memcpy((char *) target + offset, scoll_shm_peer_ptr(i, source), len);
+        offset += len;
+    }
+
+    scoll_shm_wait_done(-1, seq);
+
+    return OSHMEM_SUCCESS;
+}
+
+/*
+ * The leader gathers the sources of its node in its staging buffer and
+ * collects the blocks of all nodes with the other leaders, the PEs of
+ * the node copy the target of the leader.
+ */
+static int _algorithm_leaders(void *target,
+                              const void *source,
+                              size_t nlong,
+                              long *pSync,
+                              int alg,
+                              uint64_t seq)
+{
+    mca_scoll_shm_component_t *cm = &mca_scoll_shm_component;
+    char *data = scoll_shm_data(cm->region);
+    int rc = OSHMEM_SUCCESS;
+    int i;
+
+    scoll_shm_post(cm->region, SCOLL_SHM_FLAG_ARRIVE, seq);
+
+    if (scoll_shm_is_leader()) {
+        for (i = 0; i < cm->local_size; i++) {
+            scoll_shm_wait(scoll_shm_peer_region(i), SCOLL_SHM_FLAG_ARRIVE, seq);
+            memcpy(data + i * nlong, scoll_shm_peer_ptr(i, source), nlong);
+        }
+
+        rc = cm->leaders->g_scoll.scoll_collect(cm->leaders, target, data,
+                                                cm->local_size * nlong, pSync,
+                                                true, alg);
+        scoll_shm_post(cm->region, SCOLL_SHM_FLAG_RESULT, seq);
+    } else {
+        scoll_shm_wait(scoll_shm_peer_region(0), SCOLL_SHM_FLAG_RESULT, seq);
+        memcpy(target, scoll_shm_peer_ptr(0, target), oshmem_num_procs() * nlong);
+    }
+
+    scoll_shm_wait_done(0, seq);
+
+    return rc;
+}
+
+int mca_scoll_shm_collect(struct oshmem_group_t *group,
+                          void *target,
+                          const void *source,
+                          size_t nlong,
+                          long *pSync,
+                          bool nlong_type,
+                          int alg)
+{
+    mca_scoll_shm_component_t *cm = &mca_scoll_shm_component;
+    mca_scoll_shm_module_t *shm_module =
+        (mca_scoll_shm_module_t *) group->g_scoll.scoll_collect_module;
+    int rc;
+
+    /* the blocks of the nodes have different sizes or do not fit in the
+     * staging buffer */
+    if (!cm->active || !scoll_shm_in_heap(source) ||
+        ((NULL != cm->leaders) &&
+         (!nlong_type || !scoll_shm_in_heap(target) ||
+          (cm->local_size * nlong > cm->buffer_size)))) {
+        PREVIOUS_SCOLL_FN(shm_module, collect, group, target, source,
+                          nlong, pSync, nlong_type, alg);
+        return rc;
+    }
+
+    /* Do nothing on zero-length request */
+    if (OPAL_UNLIKELY(nlong_type && !nlong)) {
+        return OSHMEM_SUCCESS;
+    }
+
+    SCOLL_VERBOSE(12, "[#%d] shared memory collect, %zu bytes",
+                  group->my_pe, nlong);
+
+    if (NULL == cm->leaders) {
+        rc = _algorithm_node(target, source, nlong, nlong_type, scoll_shm_next_seq());
+    } else {
+        rc = _algorithm_leaders(target, source, nlong, pSync, alg, scoll_shm_next_seq());
+    }
+
+    return rc;
+}
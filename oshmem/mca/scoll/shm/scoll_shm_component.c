@@ -0,0 +1,121 @@
+/* -*- Mode: C; c-basic-offset:4 ; indent-tabs-mode:nil -*- */
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "oshmem_config.h"
+
+#include "oshmem/constants.h"
+#include "oshmem/mca/scoll/scoll.h"
+#include "oshmem/mca/scoll/base/base.h"
+#include "scoll_shm.h"
+
+/*
+ * Public string showing the scoll shm component version number
+ */
+const char *mca_scoll_shm_component_version_string =
+"Open SHMEM shared memory collective MCA component version " OSHMEM_VERSION;
+
+/*
+ * Local function
+ */
+static int shm_register(void);
+static int shm_open(void);
+static int shm_close(void);
+
+/*
+ * Instantiate the public struct with all of our public information
+ * and pointers to our public functions in it
+ */
+
+mca_scoll_shm_component_t mca_scoll_shm_component = {
+    .super = {
+        /* First, the mca_component_t struct containing meta information
+           about the component itself */
+
+        .scoll_version = {
+            MCA_SCOLL_BASE_VERSION_2_0_0,
+
+            /* Component name and version */
+            .mca_component_name = "shm",
+            MCA_BASE_MAKE_VERSION(component, OSHMEM_MAJOR_VERSION, OSHMEM_MINOR_VERSION,
+                                  OSHMEM_RELEASE_VERSION),
+
+            /* Component open and close functions */
+            .mca_open_component = shm_open,
+            .mca_close_component = shm_close,
+            .mca_register_component_params = shm_register,
+        },
+        .scoll_data = {
+            /* The component is not checkpoint ready */
+            MCA_BASE_METADATA_PARAM_NONE
+        },
+
+        /* Initialization / querying functions */
+
+        .scoll_init = mca_scoll_shm_init,
+        .scoll_query = mca_scoll_shm_query,
+    },
+};
+
+static int shm_register(void)
+{
+    mca_base_component_t *comp = &mca_scoll_shm_component.super.scoll_version;
+
+    mca_scoll_shm_component.priority = 90;
+    (void) mca_base_component_var_register(comp,
+                                           "priority",
+                                           "Priority of the scoll:shm component",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, MCA_BASE_VAR_FLAG_SETTABLE,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_scoll_shm_component.priority);
+
+    mca_scoll_shm_component.enable = 1;
+    (void) mca_base_component_var_register(comp,
+                                           "enable",
+                                           "[1|0] Enable/Disable the shared memory collectives",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, MCA_BASE_VAR_FLAG_SETTABLE,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_scoll_shm_component.enable);
+
+    mca_scoll_shm_component.buffer_size = 65536;
+    (void) mca_base_component_var_register(comp,
+                                           "buffer_size",
+                                           "Size in bytes of the per PE buffer staging the data of a node "
+                                           "for the inter-node part of collect",
+                                           MCA_BASE_VAR_TYPE_SIZE_T, NULL, 0, MCA_BASE_VAR_FLAG_SETTABLE,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_scoll_shm_component.buffer_size);
+
+    return OSHMEM_SUCCESS;
+}
+
+static int shm_open(void)
+{
+    mca_scoll_shm_component.initialized = false;
+    mca_scoll_shm_component.active = false;
+    mca_scoll_shm_component.seq = 0;
+    mca_scoll_shm_component.region = NULL;
+    mca_scoll_shm_component.peer_heap = NULL;
+    mca_scoll_shm_component.leaders = NULL;
+
+    return OSHMEM_SUCCESS;
+}
+
+static int shm_close(void)
+{
+    /* This call is done before memheap close */
+    mca_scoll_shm_release();
+
+    return OSHMEM_SUCCESS;
+}
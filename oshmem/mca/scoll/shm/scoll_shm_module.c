@@ -0,0 +1,313 @@
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "oshmem_config.h"
+
+#include "opal/mca/hwloc/base/base.h"
+
+#include "oshmem/constants.h"
+#include "oshmem/op/op.h"
+#include "oshmem/runtime/runtime.h"
+#include "oshmem/mca/spml/spml.h"
+#include "oshmem/mca/scoll/scoll.h"
+#include "oshmem/mca/scoll/base/base.h"
+#include "scoll_shm.h"
+
+/*
+ * Initial query function that is invoked during initialization, allowing
+ * this module to indicate what level of thread support it provides.
+ */
+int mca_scoll_shm_init(bool enable_progress_threads, bool enable_threads)
+{
+    /* Nothing to do */
+    return OSHMEM_SUCCESS;
+}
+
+static void mca_scoll_shm_module_construct(mca_scoll_shm_module_t *shm_module)
+{
+    shm_module->previous_barrier = NULL;
+    shm_module->previous_barrier_module = NULL;
+    shm_module->previous_broadcast = NULL;
+    shm_module->previous_broadcast_module = NULL;
+    shm_module->previous_collect = NULL;
+    shm_module->previous_collect_module = NULL;
+    shm_module->previous_reduce = NULL;
+    shm_module->previous_reduce_module = NULL;
+    shm_module->previous_alltoall = NULL;
+    shm_module->previous_alltoall_module = NULL;
+}
+
+static void mca_scoll_shm_module_destruct(mca_scoll_shm_module_t *shm_module)
+{
+    if (NULL != shm_module->previous_barrier_module) {
+        OBJ_RELEASE(shm_module->previous_barrier_module);
+    }
+    if (NULL != shm_module->previous_broadcast_module) {
+        OBJ_RELEASE(shm_module->previous_broadcast_module);
+    }
+    if (NULL != shm_module->previous_collect_module) {
+        OBJ_RELEASE(shm_module->previous_collect_module);
+    }
+    if (NULL != shm_module->previous_reduce_module) {
+        OBJ_RELEASE(shm_module->previous_reduce_module);
+    }
+    if (NULL != shm_module->previous_alltoall_module) {
+        OBJ_RELEASE(shm_module->previous_alltoall_module);
+    }
+}
+
+OBJ_CLASS_INSTANCE(mca_scoll_shm_module_t,
+                   mca_scoll_base_module_t,
+                   mca_scoll_shm_module_construct,
+                   mca_scoll_shm_module_destruct);
+
+#define SHM_SAVE_PREV_SCOLL_API(__api) do {\
+    shm_module->previous_ ## __api            = group->g_scoll.scoll_ ## __api;\
+    shm_module->previous_ ## __api ## _module = group->g_scoll.scoll_ ## __api ## _module;\
+    if (!group->g_scoll.scoll_ ## __api || !group->g_scoll.scoll_ ## __api ## _module) {\
+        SCOLL_VERBOSE(1, "no underlying " # __api "; disqualifying myself");\
+        return OSHMEM_ERROR;\
+    }\
+    OBJ_RETAIN(shm_module->previous_ ## __api ## _module);\
+} while(0)
+
+static int mca_scoll_shm_save_coll_handlers(mca_scoll_shm_module_t *shm_module,
+                                            struct oshmem_group_t *group)
+{
+    SHM_SAVE_PREV_SCOLL_API(barrier);
+    SHM_SAVE_PREV_SCOLL_API(broadcast);
+    SHM_SAVE_PREV_SCOLL_API(collect);
+    SHM_SAVE_PREV_SCOLL_API(reduce);
+    SHM_SAVE_PREV_SCOLL_API(alltoall);
+    return OSHMEM_SUCCESS;
+}
+
+/* Same as shmem_ptr() */
+static void *scoll_shm_map(int pe, void *va)
+{
+    sshmem_mkey_t *mkey;
+    void *rva;
+    int i;
+
+    if (pe == oshmem_my_proc_id()) {
+        return va;
+    }
+
+    for (i = 0; i < mca_memheap_base_num_transports(); i++) {
+        mkey = mca_memheap_base_get_cached_mkey(oshmem_ctx_default, pe, va, i, &rva);
+        if (!mkey) {
+            continue;
+        }
+
+        if (mca_memheap_base_mkey_is_shm(mkey)) {
+            return rva;
+        }
+
+        rva = MCA_SPML_CALL(rmkey_ptr(va, mkey, pe));
+        if (rva != NULL) {
+            return rva;
+        }
+    }
+
+    return NULL;
+}
+
+/*
+ * Find the local peers and map their symmetric heap. All PEs then agree
+ * on whether the shared memory collectives can be used, by reducing
+ * their votes with the modules this one replaces: the local peers of
+ * every PE have to be mapped and have to be a block of consecutive PEs
+ * of the same size on all nodes.
+ */
+static int scoll_shm_setup(mca_scoll_shm_module_t *shm_module,
+                           struct oshmem_group_t *group)
+{
+    mca_scoll_shm_component_t *cm = &mca_scoll_shm_component;
+    mca_scoll_shm_region_t *region;
+    int me = oshmem_my_proc_id();
+    int nprocs = oshmem_num_procs();
+    ompi_proc_t *proc;
+    void *ptr = NULL;
+    int ok = 1;
+    int rc;
+    int i;
+
+    cm->initialized = true;
+
+    MCA_MEMHEAP_CALL(private_alloc(SCOLL_SHM_REGION_SIZE + cm->buffer_size, &ptr));
+    if (NULL == ptr) {
+        /* the heaps of all PEs have the same layout so all PEs fail */
+        SCOLL_VERBOSE(1, "cannot allocate the shared memory region; disqualifying myself");
+        return OSHMEM_SUCCESS;
+    }
+
+    region = cm->region = (mca_scoll_shm_region_t *) ptr;
+    memset(region, 0, sizeof(*region));
+    for (i = 0; i < _SHMEM_REDUCE_SYNC_SIZE; i++) {
+        region->psync[i] = _SHMEM_SYNC_VALUE;
+    }
+    cm->heap_base = mca_memheap_seg2base_va(HEAP_SEG_INDEX);
+
+    cm->local_size = 0;
+    cm->local_start = -1;
+    for (i = 0; i < nprocs; i++) {
+        proc = oshmem_proc_group_find(oshmem_group_all, i);
+        if ((i != me) && !OPAL_PROC_ON_LOCAL_NODE(proc->super.proc_flags)) {
+            continue;
+        }
+        if (0 > cm->local_start) {
+            cm->local_start = i;
+        } else if (i != cm->local_start + cm->local_size) {
+            ok = 0;
+        }
+        cm->local_size++;
+    }
+    cm->local_rank = me - cm->local_start;
+
+    if ((0 != nprocs % cm->local_size) || (0 != cm->local_start % cm->local_size)) {
+        ok = 0;
+    }
+
+    cm->peer_heap = (char **) calloc(cm->local_size, sizeof(*cm->peer_heap));
+    if (NULL == cm->peer_heap) {
+        ok = 0;
+    }
+    for (i = 0; ok && (i < cm->local_size); i++) {
+        cm->peer_heap[i] = scoll_shm_map(cm->local_start + i, cm->heap_base);
+        if (NULL == cm->peer_heap[i]) {
+            SCOLL_VERBOSE(1, "cannot map the symmetric heap of PE %d", cm->local_start + i);
+            ok = 0;
+        }
+    }
+
+    region->vote[SCOLL_SHM_VOTE_OK] = ok;
+    region->vote[SCOLL_SHM_VOTE_PPN] = cm->local_size;
+    region->vote[SCOLL_SHM_VOTE_NEG_PPN] = -cm->local_size;
+
+    /* pSync of all PEs is initialized before the reduction starts */
+    rc = shm_module->previous_barrier(group, mca_scoll_sync_array, SCOLL_DEFAULT_ALG);
+    if (OSHMEM_SUCCESS != rc) {
+        return rc;
+    }
+
+    rc = shm_module->previous_reduce(group, oshmem_op_min_int,
+                                     region->vote_result, region->vote,
+                                     sizeof(region->vote), region->psync,
+                                     region->vote_wrk, SCOLL_DEFAULT_ALG);
+    if (OSHMEM_SUCCESS != rc) {
+        return rc;
+    }
+
+    /* a single PE per node has nobody to share memory with */
+    if (!region->vote_result[SCOLL_SHM_VOTE_OK] ||
+        (region->vote_result[SCOLL_SHM_VOTE_PPN] != -region->vote_result[SCOLL_SHM_VOTE_NEG_PPN]) ||
+        (1 == cm->local_size)) {
+        SCOLL_VERBOSE(1, "shared memory collectives are not available; disqualifying myself");
+        return OSHMEM_SUCCESS;
+    }
+
+    cm->node_count = nprocs / cm->local_size;
+    cm->node_rank = me / cm->local_size;
+    if (1 < cm->node_count) {
+        cm->leaders = oshmem_proc_group_create(0, cm->local_size, cm->node_count);
+        if (NULL == cm->leaders) {
+            return OSHMEM_ERROR;
+        }
+    }
+
+    cm->active = true;
+
+    SCOLL_VERBOSE(5, "shared memory collectives: %d nodes with %d PEs",
+                  cm->node_count, cm->local_size);
+
+    return OSHMEM_SUCCESS;
+}
+
+void mca_scoll_shm_release(void)
+{
+    mca_scoll_shm_component_t *cm = &mca_scoll_shm_component;
+
+    if (NULL != cm->region) {
+        MCA_MEMHEAP_CALL(private_free(cm->region));
+        cm->region = NULL;
+    }
+
+    free(cm->peer_heap);
+    cm->peer_heap = NULL;
+
+    /* the group of the leaders is destroyed with all other groups */
+    cm->leaders = NULL;
+    cm->active = false;
+    cm->initialized = false;
+}
+
+static int mca_scoll_shm_enable(mca_scoll_base_module_t *module,
+                                struct oshmem_group_t *group)
+{
+    mca_scoll_shm_module_t *shm_module = (mca_scoll_shm_module_t *) module;
+    int rc;
+
+    rc = mca_scoll_shm_save_coll_handlers(shm_module, group);
+    if (OSHMEM_SUCCESS != rc) {
+        return rc;
+    }
+
+    /* the shared state is set up once, by all PEs, when the symmetric
+     * heap is ready */
+    if (!mca_scoll_shm_component.initialized && (group == oshmem_group_all)) {
+        rc = scoll_shm_setup(shm_module, group);
+    }
+
+    return rc;
+}
+
+/*
+ * Invoked when there's a new communicator that has been created.
+ * Look at the communicator and decide which set of functions and
+ * priority we want to return.
+ */
+mca_scoll_base_module_t *
+mca_scoll_shm_query(struct oshmem_group_t *group, int *priority)
+{
+    mca_scoll_shm_module_t *module;
+
+    if (!mca_scoll_shm_component.enable) {
+        return NULL;
+    }
+
+    /* the symmetric heap is not there yet during the first selection
+     * for all PEs */
+    if (NULL == mca_memheap.memheap_private_alloc) {
+        return NULL;
+    }
+
+    if ((group->proc_count < 2) || (group->proc_count != oshmem_num_procs())) {
+        return NULL;
+    }
+
+    *priority = mca_scoll_shm_component.priority;
+
+    module = OBJ_NEW(mca_scoll_shm_module_t);
+    if (module) {
+        module->super.scoll_barrier = mca_scoll_shm_barrier;
+        module->super.scoll_broadcast = mca_scoll_shm_broadcast;
+        module->super.scoll_collect = mca_scoll_shm_collect;
+        module->super.scoll_reduce = mca_scoll_shm_reduce;
+        module->super.scoll_alltoall = mca_scoll_shm_alltoall;
+        module->super.scoll_module_enable = mca_scoll_shm_enable;
+        return &(module->super);
+    }
+
+    return NULL;
+}
@@ -0,0 +1,120 @@
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "oshmem_config.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "oshmem/constants.h"
+#include "oshmem/op/op.h"
+#include "oshmem/mca/scoll/scoll.h"
+#include "oshmem/mca/scoll/base/base.h"
+#include "scoll_shm.h"
+
+/*
+ * Every PE of a node reduces a slice of the elements over the sources
+ * of its node into its target, then the slices are copied: by all PEs
+ * on a single node, by the leader otherwise, which reduces the result
+ * of its node with the other leaders before the PEs of the node copy
+ * it.
+ */
+int mca_scoll_shm_reduce(struct oshmem_group_t *group,
+                         struct oshmem_op_t *op,
+                         void *target,
+                         const void *source,
+                         size_t nlong,
+                         long *pSync,
+                         void *pWrk,
+                         int alg)
+{
+    mca_scoll_shm_component_t *cm = &mca_scoll_shm_component;
+    mca_scoll_shm_module_t *shm_module =
+        (mca_scoll_shm_module_t *) group->g_scoll.scoll_reduce_module;
+    size_t count, slice, lo, hi;
+    size_t dt_size;
+    uint64_t seq;
+    int rc = OSHMEM_SUCCESS;
+    int i;
+
+    if (!cm->active || !scoll_shm_in_heap(source) || !scoll_shm_in_heap(target)) {
+        PREVIOUS_SCOLL_FN(shm_module, reduce, group, op, target, source,
+                          nlong, pSync, pWrk, alg);
+        return rc;
+    }
+
+    /* Do nothing on zero-length request */
+    if (OPAL_UNLIKELY(!nlong)) {
+        return OSHMEM_SUCCESS;
+    }
+
+    SCOLL_VERBOSE(12, "[#%d] shared memory reduce, %zu bytes",
+                  group->my_pe, nlong);
+
+    seq = scoll_shm_next_seq();
+    dt_size = op->dt_size;
+    count = nlong / dt_size;
+    slice = (count + cm->local_size - 1) / cm->local_size;
+    lo = cm->local_rank * slice;
+    lo = (lo < count) ? lo : count;
+    hi = (lo + slice < count) ? lo + slice : count;
+
+    scoll_shm_post(cm->region, SCOLL_SHM_FLAG_ARRIVE, seq);
+    scoll_shm_wait_all(SCOLL_SHM_FLAG_ARRIVE, seq);
+
+    /* my slice, the source of a PE may be its target */
+    if (lo < hi) {
+        if (target != source) {
+            memcpy((char *) target + lo * dt_size, (char *) source + lo * dt_size,
+                   (hi - lo) * dt_size);
+        }
+        for (i = 0; i < cm->local_size; i++) {
+            if (i == cm->local_rank) {
+                continue;
+            }
+            op->o_func.c_fn((char *) scoll_shm_peer_ptr(i, source) + lo * dt_size,
+                            (char *) target + lo * dt_size, (int) (hi - lo));
+        }
+    }
+    scoll_shm_post(cm->region, SCOLL_SHM_FLAG_READY, seq);
+
+    if ((NULL != cm->leaders) && !scoll_shm_is_leader()) {
+        scoll_shm_wait(scoll_shm_peer_region(0), SCOLL_SHM_FLAG_RESULT, seq);
+        memcpy(target, scoll_shm_peer_ptr(0, target), nlong);
+        scoll_shm_wait_done(0, seq);
+        return OSHMEM_SUCCESS;
+    }
+
+    /* the slices of the other PEs */
+    for (i = 0; i < cm->local_size; i++) {
+        size_t peer_lo = (i * slice < count) ? i * slice : count;
+        size_t peer_hi = (peer_lo + slice < count) ? peer_lo + slice : count;
+
+        if ((i == cm->local_rank) || (peer_lo == peer_hi)) {
+            continue;
+        }
+        scoll_shm_wait(scoll_shm_peer_region(i), SCOLL_SHM_FLAG_READY, seq);
+        memcpy((char *) target + peer_lo * dt_size,
+               (char *) scoll_shm_peer_ptr(i, target) + peer_lo * dt_size,
+               (peer_hi - peer_lo) * dt_size);
+    }
+
+    if (NULL == cm->leaders) {
+        scoll_shm_wait_done(-1, seq);
+    } else {
+        rc = cm->leaders->g_scoll.scoll_reduce(cm->leaders, op, target, target,
+                                               nlong, pSync, pWrk, alg);
+        scoll_shm_post(cm->region, SCOLL_SHM_FLAG_RESULT, seq);
+        scoll_shm_wait_done(0, seq);
+    }
+
+    return rc;
+}
@@ -0,0 +1,32 @@
+# -*- shell-script -*-
+#
+# Copyright (c) 2026      The University of Tennessee and The University
+#                         of Tennessee Research Foundation.  All rights
+#                         reserved.
+# $COPYRIGHT$
+#
+# Additional copyrights may follow
+#
+# $HEADER$
+#
+
+# MCA_oshmem_spml_shm_CONFIG([action-if-can-compile],
+#                            [action-if-cant-compile])
+# ------------------------------------------------
+AC_DEFUN([MCA_oshmem_spml_shm_CONFIG],[
+    AC_CONFIG_FILES([oshmem/mca/spml/shm/Makefile])
+
+    OPAL_VAR_SCOPE_PUSH([spml_shm_cma_happy])
+
+    # Cross Memory Attach is used to reach the segments that are not
+    # mapped by the peers
+    OPAL_CHECK_CMA([spml_shm], [AC_CHECK_HEADERS([sys/prctl.h]) spml_shm_cma_happy=1], [spml_shm_cma_happy=0])
+
+    AC_DEFINE_UNQUOTED([OSHMEM_SPML_SHM_HAVE_CMA], [$spml_shm_cma_happy],
+        [If CMA support can be enabled within the shm spml])
+
+    OPAL_VAR_SCOPE_POP
+
+    # always happy
+    [$1]
+])dnl
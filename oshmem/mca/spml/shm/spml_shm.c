@@ -0,0 +1,344 @@
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#define _GNU_SOURCE
+#include <stdio.h>
+#include <string.h>
+#include <errno.h>
+
+#include <sys/types.h>
+#include <unistd.h>
+#include <stdint.h>
+
+#include "oshmem_config.h"
+
+#if OSHMEM_SPML_SHM_HAVE_CMA
+#include <sys/uio.h>
+
+#if OPAL_CMA_NEED_SYSCALL_DEFS
+#include "opal/sys/cma.h"
+#endif /* OPAL_CMA_NEED_SYSCALL_DEFS */
+#endif
+
+#include "opal/sys/atomic.h"
+#include "ompi/datatype/ompi_datatype.h"
+#include "ompi/mca/pml/pml.h"
+
+#include "oshmem/include/shmem.h"
+#include "oshmem/mca/spml/shm/spml_shm.h"
+#include "oshmem/mca/spml/base/base.h"
+
+mca_spml_shm_t mca_spml_shm = {
+    .super = {
+        /* Init mca_spml_base_module_t */
+        .spml_add_procs     = mca_spml_shm_add_procs,
+        .spml_del_procs     = mca_spml_shm_del_procs,
+        .spml_enable        = mca_spml_shm_enable,
+        .spml_register      = mca_spml_shm_register,
+        .spml_deregister    = mca_spml_shm_deregister,
+        .spml_oob_get_mkeys = mca_spml_base_oob_get_mkeys,
+        .spml_ctx_create    = mca_spml_shm_ctx_create,
+        .spml_ctx_destroy   = mca_spml_shm_ctx_destroy,
+        .spml_put           = mca_spml_shm_put,
+        .spml_put_nb        = mca_spml_shm_put_nb,
+        .spml_get           = mca_spml_shm_get,
+        .spml_get_nb        = mca_spml_shm_get_nb,
+        .spml_recv          = mca_spml_shm_recv,
+        .spml_send          = mca_spml_shm_send,
+        .spml_wait          = mca_spml_base_wait,
+        .spml_wait_nb       = mca_spml_base_wait_nb,
+        .spml_test          = mca_spml_base_test,
+        .spml_fence         = mca_spml_shm_fence,
+        .spml_quiet         = mca_spml_shm_quiet,
+        .spml_rmkey_unpack  = mca_spml_base_rmkey_unpack,
+        .spml_rmkey_free    = mca_spml_base_rmkey_free,
+        .spml_rmkey_ptr     = mca_spml_base_rmkey_ptr,
+        .spml_memuse_hook   = mca_spml_base_memuse_hook,
+        .spml_put_all_nb    = mca_spml_base_put_all_nb,
+        .self               = (void*)&mca_spml_shm
+    },
+
+    .enabled                = false,
+    .cma                    = false,
+    .pids                   = NULL
+};
+
+mca_spml_shm_ctx_t mca_spml_shm_ctx_default = {
+    .options = 0
+};
+
+static char spml_shm_transport_ids[1] = { 0 };
+
+int mca_spml_shm_enable(bool enable)
+{
+    SPML_VERBOSE(50, "*** shm ENABLED ****");
+    if (false == enable) {
+        return OSHMEM_SUCCESS;
+    }
+
+    oshmem_ctx_default = (shmem_ctx_t) &mca_spml_shm_ctx_default;
+    mca_spml_shm.enabled = true;
+
+    return OSHMEM_SUCCESS;
+}
+
+int mca_spml_shm_add_procs(ompi_proc_t** procs, size_t nprocs)
+{
+    pid_t pid;
+    size_t i;
+    int rc;
+
+    mca_spml_shm.pids = (pid_t *) calloc(nprocs, sizeof(*mca_spml_shm.pids));
+    if (NULL == mca_spml_shm.pids) {
+        return OSHMEM_ERR_OUT_OF_RESOURCE;
+    }
+
+    /* peers only use CMA on the PEs that allow it */
+    pid = mca_spml_shm.cma ? getpid() : 0;
+    rc = oshmem_shmem_allgather(&pid, mca_spml_shm.pids, sizeof(pid));
+    if (OSHMEM_SUCCESS != rc) {
+        SPML_ERROR("failed to exchange the pids");
+        return rc;
+    }
+
+    for (i = 0; i < nprocs; i++) {
+        OSHMEM_PROC_DATA(procs[i])->num_transports = 1;
+        OSHMEM_PROC_DATA(procs[i])->transport_ids = spml_shm_transport_ids;
+
+        if (0 == mca_spml_shm.pids[i]) {
+            SPML_VERBOSE(5, "PE %d can only be reached through its shared segments", (int) i);
+        }
+    }
+
+    SPML_VERBOSE(50, "*** ADDED PROCS ***");
+
+    return OSHMEM_SUCCESS;
+}
+
+int mca_spml_shm_del_procs(ompi_proc_t** procs, size_t nprocs)
+{
+    free(mca_spml_shm.pids);
+    mca_spml_shm.pids = NULL;
+
+    return OSHMEM_SUCCESS;
+}
+
+/*
+ * A segment created by a shared sshmem component is described by its
+ * segment id, that peers attach (see memheap_attach_segment()). Other
+ * segments are described by their base address, that is used for CMA.
+ */
+sshmem_mkey_t *mca_spml_shm_register(void* addr,
+                                     size_t size,
+                                     uint64_t shmid,
+                                     int *count)
+{
+    sshmem_mkey_t *mkeys;
+
+    *count = 0;
+    mkeys = (sshmem_mkey_t *) calloc(1, sizeof(*mkeys));
+    if (!mkeys) {
+        return NULL;
+    }
+
+    if (MAP_SEGMENT_SHM_INVALID != (int) shmid) {
+        mkeys[0].va_base = 0;
+        mkeys[0].u.key = shmid;
+    } else {
+        mkeys[0].va_base = addr;
+        mkeys[0].u.key = MAP_SEGMENT_SHM_INVALID;
+    }
+    mkeys[0].len = 0;
+    mkeys[0].spml_context = NULL;
+
+    *count = 1;
+    return mkeys;
+}
+
+int mca_spml_shm_deregister(sshmem_mkey_t *mkeys)
+{
+    MCA_SPML_CALL(quiet(oshmem_ctx_default));
+
+    free(mkeys);
+
+    return OSHMEM_SUCCESS;
+}
+
+int mca_spml_shm_ctx_create(long options, shmem_ctx_t *ctx)
+{
+    mca_spml_shm_ctx_t *shm_ctx;
+
+    shm_ctx = (mca_spml_shm_ctx_t *) malloc(sizeof(*shm_ctx));
+    if (NULL == shm_ctx) {
+        return OSHMEM_ERR_OUT_OF_RESOURCE;
+    }
+
+    shm_ctx->options = options;
+    *ctx = (shmem_ctx_t) shm_ctx;
+
+    return OSHMEM_SUCCESS;
+}
+
+void mca_spml_shm_ctx_destroy(shmem_ctx_t ctx)
+{
+    MCA_SPML_CALL(quiet(ctx));
+
+    if (ctx != oshmem_ctx_default) {
+        free(ctx);
+    }
+}
+
+/* copy size bytes between the local buffer buf and the address rva in
+ * the address space of pe */
+static int spml_shm_cma_copy(int pe, void *rva, void *buf, size_t size, bool put)
+{
+#if OSHMEM_SPML_SHM_HAVE_CMA
+    struct iovec local_iov = {.iov_base = buf, .iov_len = size};
+    struct iovec remote_iov = {.iov_base = rva, .iov_len = size};
+    ssize_t ret;
+
+    if (OPAL_UNLIKELY(0 == mca_spml_shm.pids[pe])) {
+        SPML_ERROR("PE %d does not allow cross memory attach and %p is not in a shared segment",
+                   pe, rva);
+        return OSHMEM_ERR_NOT_AVAILABLE;
+    }
+
+    /* the transfer can be partial, see mca_btl_sm_get_cma() */
+    do {
+        if (put) {
+            ret = process_vm_writev(mca_spml_shm.pids[pe], &local_iov, 1, &remote_iov, 1, 0);
+        } else {
+            ret = process_vm_readv(mca_spml_shm.pids[pe], &local_iov, 1, &remote_iov, 1, 0);
+        }
+        if (0 > ret) {
+            if (EINTR == errno) {
+                continue;
+            }
+            SPML_ERROR("cross memory attach to PE %d failed: %s", pe, strerror(errno));
+            return OSHMEM_ERROR;
+        }
+        local_iov.iov_base = (void *)((char *)local_iov.iov_base + ret);
+        local_iov.iov_len -= ret;
+        remote_iov.iov_base = (void *)((char *)remote_iov.iov_base + ret);
+        remote_iov.iov_len -= ret;
+    } while (0 < local_iov.iov_len);
+
+    return OSHMEM_SUCCESS;
+#else
+    SPML_ERROR("%p of PE %d is not in a shared segment and cross memory attach is not available",
+               rva, pe);
+    return OSHMEM_ERR_NOT_AVAILABLE;
+#endif
+}
+
+static inline int spml_shm_copy(shmem_ctx_t ctx, void *va, void *buf, size_t size,
+                                int pe, bool put)
+{
+    sshmem_mkey_t *mkey;
+    void *rva;
+
+    if (OPAL_UNLIKELY(0 == size)) {
+        return OSHMEM_SUCCESS;
+    }
+
+    if (pe == oshmem_my_proc_id()) {
+        rva = va;
+    } else {
+        mkey = mca_memheap_base_get_cached_mkey(ctx, pe, va, 0, &rva);
+        if (OPAL_UNLIKELY(NULL == mkey)) {
+            SPML_ERROR("pe=%d: %p is not address of symmetric variable", pe, va);
+            oshmem_shmem_abort(-1);
+            return OSHMEM_ERROR;
+        }
+
+        if (!mca_memheap_base_mkey_is_shm(mkey)) {
+            return spml_shm_cma_copy(pe, rva, buf, size, put);
+        }
+    }
+
+    if (put) {
+        memcpy(rva, buf, size);
+    } else {
+        memcpy(buf, rva, size);
+    }
+
+    return OSHMEM_SUCCESS;
+}
+
+int mca_spml_shm_get(shmem_ctx_t ctx, void *src_addr, size_t size, void *dst_addr, int src)
+{
+    return spml_shm_copy(ctx, src_addr, dst_addr, size, src, false);
+}
+
+int mca_spml_shm_get_nb(shmem_ctx_t ctx, void *src_addr, size_t size, void *dst_addr, int src, void **handle)
+{
+    return spml_shm_copy(ctx, src_addr, dst_addr, size, src, false);
+}
+
+int mca_spml_shm_put(shmem_ctx_t ctx, void* dst_addr, size_t size, void* src_addr, int dst)
+{
+    return spml_shm_copy(ctx, dst_addr, src_addr, size, dst, true);
+}
+
+int mca_spml_shm_put_nb(shmem_ctx_t ctx, void* dst_addr, size_t size, void* src_addr, int dst, void **handle)
+{
+    return spml_shm_copy(ctx, dst_addr, src_addr, size, dst, true);
+}
+
+/* Transfers are complete on return, only the order in which the stores
+ * become visible to the peers is left */
+int mca_spml_shm_fence(shmem_ctx_t ctx)
+{
+    opal_atomic_wmb();
+
+    return OSHMEM_SUCCESS;
+}
+
+int mca_spml_shm_quiet(shmem_ctx_t ctx)
+{
+    opal_atomic_mb();
+
+    return OSHMEM_SUCCESS;
+}
+
+int mca_spml_shm_recv(void* buf, size_t size, int src)
+{
+    int rc = OSHMEM_SUCCESS;
+
+    rc = MCA_PML_CALL(recv(buf,
+                size,
+                &(ompi_mpi_unsigned_char.dt),
+                src,
+                0,
+                &(ompi_mpi_comm_world.comm),
+                NULL));
+
+    return rc;
+}
+
+/* for now only do blocking copy send */
+int mca_spml_shm_send(void* buf,
+                      size_t size,
+                      int dst,
+                      mca_spml_base_put_mode_t mode)
+{
+    int rc = OSHMEM_SUCCESS;
+
+    rc = MCA_PML_CALL(send(buf,
+                size,
+                &(ompi_mpi_unsigned_char.dt),
+                dst,
+                0,
+                (mca_pml_base_send_mode_t)mode,
+                &(ompi_mpi_comm_world.comm)));
+
+    return rc;
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+/**
+ *  @file
+ */
+
+#ifndef MCA_SPML_SHM_H
+#define MCA_SPML_SHM_H
+
+#include "oshmem_config.h"
+
+#include <sys/types.h>
+
+#include "oshmem/mca/spml/base/base.h"
+#include "oshmem/mca/spml/spml.h"
+#include "oshmem/util/oshmem_util.h"
+#include "oshmem/proc/proc.h"
+#include "oshmem/runtime/runtime.h"
+
+#include "oshmem/mca/memheap/memheap.h"
+#include "oshmem/mca/memheap/base/base.h"
+
+BEGIN_C_DECLS
+
+/*
+ * The shm SPML serves jobs whose PEs all run on the same node. The
+ * segments a peer created through a shared sshmem component (e.g. sysv)
+ * are attached by memheap when the memory keys are exchanged, so puts
+ * and gets to them are plain copies. The other segments, like the data
+ * segment or a heap allocated by anonymous mmap, are reached through
+ * Cross Memory Attach when it is available. Every transfer is complete
+ * when the call returns, so fence and quiet only order memory accesses.
+ */
+
+struct mca_spml_shm_ctx {
+    long options;
+};
+typedef struct mca_spml_shm_ctx mca_spml_shm_ctx_t;
+
+extern mca_spml_shm_ctx_t mca_spml_shm_ctx_default;
+
+struct mca_spml_shm {
+    mca_spml_base_module_t super;
+    int priority;               /* component priority */
+    bool enabled;
+    bool cma;                   /* peers may use CMA on my memory */
+    pid_t *pids;                /* pid of each PE, 0 if CMA is not allowed */
+};
+typedef struct mca_spml_shm mca_spml_shm_t;
+
+extern mca_spml_shm_t mca_spml_shm;
+
+extern int mca_spml_shm_enable(bool enable);
+extern int mca_spml_shm_ctx_create(long options,
+                                   shmem_ctx_t *ctx);
+extern void mca_spml_shm_ctx_destroy(shmem_ctx_t ctx);
+extern int mca_spml_shm_get(shmem_ctx_t ctx,
+                            void* dst_addr,
+                            size_t size,
+                            void* src_addr,
+                            int src);
+extern int mca_spml_shm_get_nb(shmem_ctx_t ctx,
+                               void* dst_addr,
+                               size_t size,
+                               void* src_addr,
+                               int src,
+                               void **handle);
+extern int mca_spml_shm_put(shmem_ctx_t ctx,
+                            void* dst_addr,
+                            size_t size,
+                            void* src_addr,
+                            int dst);
+extern int mca_spml_shm_put_nb(shmem_ctx_t ctx,
+                               void* dst_addr,
+                               size_t size,
+                               void* src_addr,
+                               int dst,
+                               void **handle);
+
+extern int mca_spml_shm_recv(void* buf, size_t size, int src);
+extern int mca_spml_shm_send(void* buf,
+                             size_t size,
+                             int dst,
+                             mca_spml_base_put_mode_t mode);
+
+extern sshmem_mkey_t *mca_spml_shm_register(void* addr,
+                                            size_t size,
+                                            uint64_t shmid,
+                                            int *count);
+extern int mca_spml_shm_deregister(sshmem_mkey_t *mkeys);
+
+extern int mca_spml_shm_add_procs(ompi_proc_t** procs, size_t nprocs);
+extern int mca_spml_shm_del_procs(ompi_proc_t** procs, size_t nprocs);
+extern int mca_spml_shm_fence(shmem_ctx_t ctx);
+extern int mca_spml_shm_quiet(shmem_ctx_t ctx);
+
+END_C_DECLS
+
+#endif
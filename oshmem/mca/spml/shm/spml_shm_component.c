@@ -0,0 +1,156 @@
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "oshmem_config.h"
+
+#include <stdio.h>
+#include <fcntl.h>
+#include <unistd.h>
+#if OSHMEM_SPML_SHM_HAVE_CMA && defined(HAVE_SYS_PRCTL_H)
+#include <sys/prctl.h>
+#endif
+
+#include "opal/util/proc.h"
+#include "ompi/proc/proc.h"
+
+#include "shmem.h"
+#include "oshmem/mca/spml/spml.h"
+#include "oshmem/mca/spml/base/base.h"
+#include "spml_shm_component.h"
+#include "oshmem/mca/spml/shm/spml_shm.h"
+
+static int mca_spml_shm_component_register(void);
+static int mca_spml_shm_component_open(void);
+static int mca_spml_shm_component_close(void);
+static mca_spml_base_module_t*
+mca_spml_shm_component_init(int* priority,
+                            bool enable_progress_threads,
+                            bool enable_mpi_threads);
+static int mca_spml_shm_component_fini(void);
+mca_spml_base_component_2_0_0_t mca_spml_shm_component = {
+
+    /* First, the mca_base_component_t struct containing meta
+       information about the component itself */
+
+    .spmlm_version = {
+        MCA_SPML_BASE_VERSION_2_0_0,
+
+        .mca_component_name            = "shm",
+        .mca_component_major_version   = OSHMEM_MAJOR_VERSION,
+        .mca_component_minor_version   = OSHMEM_MINOR_VERSION,
+        .mca_component_release_version = OSHMEM_RELEASE_VERSION,
+        .mca_open_component            = mca_spml_shm_component_open,
+        .mca_close_component           = mca_spml_shm_component_close,
+        .mca_query_component           = NULL,
+        .mca_register_component_params = mca_spml_shm_component_register
+    },
+    .spmlm_data = {
+        /* The component is checkpoint ready */
+        .param_field                   = MCA_BASE_METADATA_PARAM_CHECKPOINT
+    },
+
+    .spmlm_init                        = mca_spml_shm_component_init,
+    .spmlm_finalize                    = mca_spml_shm_component_fini
+};
+
+static int mca_spml_shm_component_register(void)
+{
+    mca_spml_shm.priority = 10;
+    (void) mca_base_component_var_register(&mca_spml_shm_component.spmlm_version,
+                                           "priority",
+                                           "[integer] shm priority",
+                                           MCA_BASE_VAR_TYPE_INT, NULL, 0, 0,
+                                           OPAL_INFO_LVL_9,
+                                           MCA_BASE_VAR_SCOPE_READONLY,
+                                           &mca_spml_shm.priority);
+
+    return OSHMEM_SUCCESS;
+}
+
+static int mca_spml_shm_component_open(void)
+{
+    return OSHMEM_SUCCESS;
+}
+
+static int mca_spml_shm_component_close(void)
+{
+    return OSHMEM_SUCCESS;
+}
+
+/* Check if the peers are allowed to use CMA on the memory of this process */
+static bool spml_shm_cma_init(void)
+{
+#if OSHMEM_SPML_SHM_HAVE_CMA
+    char buffer = '0';
+    int fd;
+
+    /* check system setting for current ptrace scope */
+    fd = open("/proc/sys/kernel/yama/ptrace_scope", O_RDONLY);
+    if (0 <= fd) {
+        if (1 != read(fd, &buffer, 1)) {
+            buffer = '0';
+        }
+        close(fd);
+    }
+
+    /* ptrace scope 0 will allow an attach from any of the process owner's
+     * processes. ptrace scope 1 limits attachers to the process tree
+     * starting at the parent of this process. */
+    if ('0' == buffer) {
+        return true;
+    }
+#if defined(PR_SET_PTRACER)
+    /* try setting the ptrace scope to allow attach */
+    if (0 == prctl(PR_SET_PTRACER, PR_SET_PTRACER_ANY, 0, 0, 0)) {
+        return true;
+    }
+#endif
+#endif
+    return false;
+}
+
+static mca_spml_base_module_t*
+mca_spml_shm_component_init(int* priority,
+                            bool enable_progress_threads,
+                            bool enable_mpi_threads)
+{
+    SPML_VERBOSE(10, "in shm, my priority is %d\n", mca_spml_shm.priority);
+
+    if ((*priority) > mca_spml_shm.priority) {
+        *priority = mca_spml_shm.priority;
+        return NULL ;
+    }
+    *priority = mca_spml_shm.priority;
+
+    /* all PEs have to share the node */
+    if (opal_process_info.num_local_peers + 1 != ompi_proc_world_size()) {
+        SPML_VERBOSE(10, "shm needs all PEs on the same node; disqualifying myself");
+        return NULL ;
+    }
+
+    mca_spml_shm.cma = spml_shm_cma_init();
+    mca_spml_shm.pids = NULL;
+
+    SPML_VERBOSE(50, "*** shm initialized (cma %d) ****", mca_spml_shm.cma);
+    return &mca_spml_shm.super;
+}
+
+static int mca_spml_shm_component_fini(void)
+{
+    if (!mca_spml_shm.enabled)
+        return OSHMEM_SUCCESS; /* never selected.. return success.. */
+
+    free(mca_spml_shm.pids);
+    mca_spml_shm.pids = NULL;
+    mca_spml_shm.enabled = false;  /* not anymore */
+
+    return OSHMEM_SUCCESS;
+}
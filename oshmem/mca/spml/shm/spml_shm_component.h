@@ -0,0 +1,26 @@
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+/**
+ *  @file
+ */
+
+#ifndef MCA_SPML_SHM_COMPONENT_H
+#define MCA_SPML_SHM_COMPONENT_H
+
+BEGIN_C_DECLS
+
+/*
+ * SPML module functions.
+ */
+OSHMEM_MODULE_DECLSPEC extern mca_spml_base_component_2_0_0_t mca_spml_shm_component;
+END_C_DECLS
+
+#endif
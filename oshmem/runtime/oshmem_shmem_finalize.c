@@ -51,6 +51,7 @@
 #include "oshmem/op/op.h"
 #include "oshmem/request/request.h"
 #include "oshmem/shmem/shmem_lock.h"
+#include "oshmem/shmem/shmem_aggr.h"
 #include "oshmem/runtime/oshmem_shmem_preconnect.h"
 
 extern int oshmem_shmem_globalexit_status;
@@ -95,6 +96,8 @@ static int _shmem_finalize(void)
 
     shmem_lock_finalize();
 
+    shmem_aggr_finalize();
+
     /* Finalize preconnect framework */
     if (OSHMEM_SUCCESS != (ret = oshmem_shmem_preconnect_all_finalize())) {
         return ret;
@@ -20,6 +20,8 @@
 int oshmem_shmem_lock_recursive = 0;
 int oshmem_shmem_api_verbose = 0;
 int oshmem_preconnect_all = 0;
+size_t oshmem_shmem_aggregate_size = 4096;
+size_t oshmem_shmem_aggregate_max = 256;
 
 int oshmem_shmem_register_params(void)
 {
@@ -69,6 +71,35 @@ int oshmem_shmem_register_params(void)
                                  MCA_BASE_VAR_SCOPE_READONLY,
                                  &oshmem_preconnect_all);
 
+    (void) mca_base_var_register("oshmem",
+                                 "oshmem",
+                                 NULL,
+                                 "aggregate_size",
+                                 "Size in bytes of the buffer coalescing the small nonblocking "
+                                 "puts of a context to a PE, 0 disables the aggregation "
+                                 "(default = 4096)",
+                                 MCA_BASE_VAR_TYPE_SIZE_T,
+                                 NULL,
+                                 0,
+                                 MCA_BASE_VAR_FLAG_SETTABLE,
+                                 OPAL_INFO_LVL_9,
+                                 MCA_BASE_VAR_SCOPE_READONLY,
+                                 &oshmem_shmem_aggregate_size);
+
+    (void) mca_base_var_register("oshmem",
+                                 "oshmem",
+                                 NULL,
+                                 "aggregate_max",
+                                 "Largest nonblocking put in bytes that is coalesced with others "
+                                 "(default = 256)",
+                                 MCA_BASE_VAR_TYPE_SIZE_T,
+                                 NULL,
+                                 0,
+                                 MCA_BASE_VAR_FLAG_SETTABLE,
+                                 OPAL_INFO_LVL_9,
+                                 MCA_BASE_VAR_SCOPE_READONLY,
+                                 &oshmem_shmem_aggregate_max);
+
     value = mca_base_var_find ("opal", "opal", NULL, "abort_delay");
     if (0 <= value) {
         (void) mca_base_var_register_synonym(value, "oshmem", "oshmem", NULL, "abort_delay",
@@ -37,6 +37,17 @@ OSHMEM_DECLSPEC extern int oshmem_shmem_api_verbose;
  */
 OSHMEM_DECLSPEC extern int oshmem_preconnect_all;
 
+/**
+ * Size of the buffer coalescing the small nonblocking puts
+ * of a context to a PE (0 disables the aggregation)
+ */
+OSHMEM_DECLSPEC extern size_t oshmem_shmem_aggregate_size;
+
+/**
+ * Largest nonblocking put that is coalesced
+ */
+OSHMEM_DECLSPEC extern size_t oshmem_shmem_aggregate_max;
+
 END_C_DECLS
 
 #endif /* OSHMEM_RUNTIME_PARAMS_H */
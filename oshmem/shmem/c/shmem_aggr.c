@@ -0,0 +1,369 @@
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+#include "oshmem_config.h"
+
+#include "oshmem/constants.h"
+#include "oshmem/include/shmem.h"
+#include "oshmem/runtime/params.h"
+#include "oshmem/runtime/runtime.h"
+#include <stdlib.h>
+#include <string.h>
+
+#include "opal/class/opal_hash_table.h"
+#include "opal/mca/threads/mutex.h"
+
+#include "oshmem/shmem/shmem_api_logger.h"
+#include "oshmem/shmem/shmem_aggr.h"
+#include "oshmem/mca/spml/spml.h"
+#include "oshmem/mca/memheap/memheap.h"
+#include "oshmem/mca/memheap/base/base.h"
+
+/* data waiting to be put to a PE */
+typedef struct shmem_aggr_run_t {
+    char *target;               /* remote address of the first byte */
+    char *limit;                /* end of the segment holding target */
+    size_t size;
+    bool queued;                /* on the list of the PEs to flush */
+    char *buffer;
+} shmem_aggr_run_t;
+
+typedef struct shmem_aggr_ctx_t {
+    opal_mutex_t lock;
+    shmem_aggr_run_t *runs;     /* by PE, allocated with the first put */
+    int *queue;                 /* PEs with data */
+    int nqueued;
+
+    /* counters */
+    uint64_t puts;              /* nonblocking puts buffered */
+    uint64_t transfers;         /* puts handed to the SPML */
+} shmem_aggr_ctx_t;
+
+static bool aggr_enabled = false;
+static shmem_aggr_ctx_t aggr_default;
+static opal_hash_table_t aggr_contexts;
+static opal_mutex_t aggr_contexts_lock;
+
+/* handlers of the SPML that are replaced */
+static mca_spml_base_module_put_nb_fn_t spml_put_nb;
+static mca_spml_base_module_fence_fn_t spml_fence;
+static mca_spml_base_module_quiet_fn_t spml_quiet;
+
+static void aggr_ctx_construct(shmem_aggr_ctx_t *actx)
+{
+    OBJ_CONSTRUCT(&actx->lock, opal_mutex_t);
+    actx->runs = NULL;
+    actx->queue = NULL;
+    actx->nqueued = 0;
+    actx->puts = 0;
+    actx->transfers = 0;
+}
+
+static void aggr_ctx_destruct(shmem_aggr_ctx_t *actx)
+{
+    int i;
+
+    SHMEM_API_VERBOSE(5, "%llu nonblocking puts were coalesced in %llu transfers",
+                      (unsigned long long) actx->puts, (unsigned long long) actx->transfers);
+
+    if (NULL != actx->runs) {
+        for (i = 0; i < oshmem_num_procs(); i++) {
+            free(actx->runs[i].buffer);
+        }
+    }
+    free(actx->runs);
+    free(actx->queue);
+    OBJ_DESTRUCT(&actx->lock);
+}
+
+static shmem_aggr_ctx_t *aggr_ctx_lookup(shmem_ctx_t ctx)
+{
+    void *actx = NULL;
+
+    if (OPAL_LIKELY(ctx == oshmem_ctx_default)) {
+        return &aggr_default;
+    }
+
+    OPAL_THREAD_LOCK(&aggr_contexts_lock);
+    opal_hash_table_get_value_uint64(&aggr_contexts, (uint64_t) (uintptr_t) ctx, &actx);
+    OPAL_THREAD_UNLOCK(&aggr_contexts_lock);
+
+    return (shmem_aggr_ctx_t *) actx;
+}
+
+static shmem_aggr_run_t *aggr_run(shmem_aggr_ctx_t *actx, int pe)
+{
+    shmem_aggr_run_t *run;
+
+    if (OPAL_UNLIKELY(NULL == actx->runs)) {
+        actx->runs = (shmem_aggr_run_t *) calloc(oshmem_num_procs(), sizeof(*actx->runs));
+        actx->queue = (int *) malloc(oshmem_num_procs() * sizeof(*actx->queue));
+        if ((NULL == actx->runs) || (NULL == actx->queue)) {
+            free(actx->runs);
+            free(actx->queue);
+            actx->runs = NULL;
+            actx->queue = NULL;
+            return NULL;
+        }
+    }
+
+    run = &actx->runs[pe];
+    if (OPAL_UNLIKELY(NULL == run->buffer)) {
+        run->buffer = (char *) malloc(oshmem_shmem_aggregate_size);
+        if (NULL == run->buffer) {
+            return NULL;
+        }
+    }
+
+    return run;
+}
+
+/* the buffer can be reused as soon as the blocking put returns */
+static int aggr_flush_run(shmem_aggr_ctx_t *actx, shmem_ctx_t ctx,
+                          shmem_aggr_run_t *run, int pe)
+{
+    int rc;
+
+    rc = MCA_SPML_CALL(put(ctx, run->target, run->size, run->buffer, pe));
+    run->size = 0;
+    actx->transfers++;
+
+    return rc;
+}
+
+static int aggr_flush(shmem_aggr_ctx_t *actx, shmem_ctx_t ctx)
+{
+    shmem_aggr_run_t *run;
+    int rc = OSHMEM_SUCCESS;
+    int i;
+
+    for (i = 0; i < actx->nqueued; i++) {
+        run = &actx->runs[actx->queue[i]];
+        run->queued = false;
+        if (0 != run->size) {
+            int ret = aggr_flush_run(actx, ctx, run, actx->queue[i]);
+            if (OSHMEM_SUCCESS != ret) {
+                rc = ret;
+            }
+        }
+    }
+    actx->nqueued = 0;
+
+    return rc;
+}
+
+static int aggr_put_nb(shmem_ctx_t ctx, void *dst_addr, size_t size,
+                       void *src_addr, int dst, void **handle)
+{
+    shmem_aggr_ctx_t *actx;
+    shmem_aggr_run_t *run;
+    map_segment_t *s;
+    int rc = OSHMEM_SUCCESS;
+
+    if ((size > oshmem_shmem_aggregate_max) || (NULL != handle) ||
+        (dst == oshmem_my_proc_id()) || (NULL == (actx = aggr_ctx_lookup(ctx)))) {
+        return spml_put_nb(ctx, dst_addr, size, src_addr, dst, handle);
+    }
+
+    OPAL_THREAD_LOCK(&actx->lock);
+
+    run = aggr_run(actx, dst);
+    if (OPAL_UNLIKELY(NULL == run)) {
+        OPAL_THREAD_UNLOCK(&actx->lock);
+        return spml_put_nb(ctx, dst_addr, size, src_addr, dst, handle);
+    }
+
+    if ((0 != run->size) &&
+        ((run->target + run->size != (char *) dst_addr) ||
+         (run->size + size > oshmem_shmem_aggregate_size) ||
+         ((char *) dst_addr + size > run->limit))) {
+        rc = aggr_flush_run(actx, ctx, run, dst);
+    }
+
+    if (0 == run->size) {
+        s = memheap_find_va(dst_addr);
+        if (OPAL_UNLIKELY(NULL == s)) {
+            /* let the SPML report the error */
+            OPAL_THREAD_UNLOCK(&actx->lock);
+            return spml_put_nb(ctx, dst_addr, size, src_addr, dst, handle);
+        }
+        run->target = (char *) dst_addr;
+        run->limit = (char *) s->super.va_end;
+        if (!run->queued) {
+            run->queued = true;
+            actx->queue[actx->nqueued++] = dst;
+        }
+    }
+
+    memcpy(run->buffer + run->size, src_addr, size);
+    run->size += size;
+    actx->puts++;
+
+    OPAL_THREAD_UNLOCK(&actx->lock);
+
+    return rc;
+}
+
+static int aggr_fence(shmem_ctx_t ctx)
+{
+    shmem_aggr_ctx_t *actx = aggr_ctx_lookup(ctx);
+    int rc = OSHMEM_SUCCESS;
+
+    if (NULL != actx) {
+        OPAL_THREAD_LOCK(&actx->lock);
+        rc = aggr_flush(actx, ctx);
+        OPAL_THREAD_UNLOCK(&actx->lock);
+    }
+
+    if (OSHMEM_SUCCESS != rc) {
+        return rc;
+    }
+    return spml_fence(ctx);
+}
+
+static int aggr_quiet(shmem_ctx_t ctx)
+{
+    shmem_aggr_ctx_t *actx = aggr_ctx_lookup(ctx);
+    int rc = OSHMEM_SUCCESS;
+
+    if (NULL != actx) {
+        OPAL_THREAD_LOCK(&actx->lock);
+        rc = aggr_flush(actx, ctx);
+        OPAL_THREAD_UNLOCK(&actx->lock);
+    }
+
+    if (OSHMEM_SUCCESS != rc) {
+        return rc;
+    }
+    return spml_quiet(ctx);
+}
+
+int shmem_aggr_init(void)
+{
+#if MCA_oshmem_spml_DIRECT_CALL
+    /* the SPML is called directly, there is nothing to interpose */
+    return OSHMEM_SUCCESS;
+#else
+    if (0 == oshmem_shmem_aggregate_size) {
+        return OSHMEM_SUCCESS;
+    }
+
+    if (oshmem_shmem_aggregate_max > oshmem_shmem_aggregate_size) {
+        oshmem_shmem_aggregate_max = oshmem_shmem_aggregate_size;
+    }
+
+    OBJ_CONSTRUCT(&aggr_contexts, opal_hash_table_t);
+    OBJ_CONSTRUCT(&aggr_contexts_lock, opal_mutex_t);
+    if (OPAL_SUCCESS != opal_hash_table_init(&aggr_contexts, 16)) {
+        OBJ_DESTRUCT(&aggr_contexts_lock);
+        OBJ_DESTRUCT(&aggr_contexts);
+        return OSHMEM_ERR_OUT_OF_RESOURCE;
+    }
+    aggr_ctx_construct(&aggr_default);
+
+    spml_put_nb = mca_spml.spml_put_nb;
+    spml_fence = mca_spml.spml_fence;
+    spml_quiet = mca_spml.spml_quiet;
+    mca_spml.spml_put_nb = aggr_put_nb;
+    mca_spml.spml_fence = aggr_fence;
+    mca_spml.spml_quiet = aggr_quiet;
+
+    aggr_enabled = true;
+    return OSHMEM_SUCCESS;
+#endif
+}
+
+int shmem_aggr_finalize(void)
+{
+#if !MCA_oshmem_spml_DIRECT_CALL
+    uint64_t key;
+    void *value;
+    void *node;
+    int rc;
+
+    if (!aggr_enabled) {
+        return OSHMEM_SUCCESS;
+    }
+
+    /* the application should have destroyed its contexts */
+    rc = opal_hash_table_get_first_key_uint64(&aggr_contexts, &key, &value, &node);
+    while (OPAL_SUCCESS == rc) {
+        aggr_flush((shmem_aggr_ctx_t *) value, (shmem_ctx_t) (uintptr_t) key);
+        aggr_ctx_destruct((shmem_aggr_ctx_t *) value);
+        free(value);
+        rc = opal_hash_table_get_next_key_uint64(&aggr_contexts, &key, &value, node, &node);
+    }
+
+    aggr_flush(&aggr_default, oshmem_ctx_default);
+    spml_quiet(oshmem_ctx_default);
+    aggr_ctx_destruct(&aggr_default);
+
+    mca_spml.spml_put_nb = spml_put_nb;
+    mca_spml.spml_fence = spml_fence;
+    mca_spml.spml_quiet = spml_quiet;
+
+    OBJ_DESTRUCT(&aggr_contexts);
+    OBJ_DESTRUCT(&aggr_contexts_lock);
+    aggr_enabled = false;
+#endif
+    return OSHMEM_SUCCESS;
+}
+
+int shmem_aggr_ctx_create(shmem_ctx_t ctx)
+{
+    shmem_aggr_ctx_t *actx;
+    int rc;
+
+    if (!aggr_enabled) {
+        return OSHMEM_SUCCESS;
+    }
+
+    actx = (shmem_aggr_ctx_t *) malloc(sizeof(*actx));
+    if (NULL == actx) {
+        return OSHMEM_ERR_OUT_OF_RESOURCE;
+    }
+    aggr_ctx_construct(actx);
+
+    OPAL_THREAD_LOCK(&aggr_contexts_lock);
+    rc = opal_hash_table_set_value_uint64(&aggr_contexts, (uint64_t) (uintptr_t) ctx, actx);
+    OPAL_THREAD_UNLOCK(&aggr_contexts_lock);
+
+    if (OPAL_SUCCESS != rc) {
+        aggr_ctx_destruct(actx);
+        free(actx);
+        return OSHMEM_ERR_OUT_OF_RESOURCE;
+    }
+
+    return OSHMEM_SUCCESS;
+}
+
+void shmem_aggr_ctx_destroy(shmem_ctx_t ctx)
+{
+    shmem_aggr_ctx_t *actx;
+
+    if (!aggr_enabled || (ctx == oshmem_ctx_default)) {
+        return;
+    }
+
+    actx = aggr_ctx_lookup(ctx);
+    if (NULL == actx) {
+        return;
+    }
+
+    OPAL_THREAD_LOCK(&aggr_contexts_lock);
+    opal_hash_table_remove_value_uint64(&aggr_contexts, (uint64_t) (uintptr_t) ctx);
+    OPAL_THREAD_UNLOCK(&aggr_contexts_lock);
+
+    /* the SPML completes the puts when it destroys the context */
+    aggr_flush(actx, ctx);
+    aggr_ctx_destruct(actx);
+    free(actx);
+}
@@ -23,6 +23,7 @@
 #include "oshmem/runtime/params.h"
 #include "oshmem/runtime/runtime.h"
 #include "oshmem/shmem/shmem_api_logger.h"
+#include "oshmem/shmem/shmem_aggr.h"
 
 #if OSHMEM_PROFILING
 #include "oshmem/include/pshmem.h"
@@ -33,10 +34,24 @@
 
 int shmem_ctx_create(long options, shmem_ctx_t *ctx)
 {
-    return MCA_SPML_CALL(ctx_create(options, ctx));
+    int rc;
+
+    rc = MCA_SPML_CALL(ctx_create(options, ctx));
+    if (OSHMEM_SUCCESS != rc) {
+        return rc;
+    }
+
+    rc = shmem_aggr_ctx_create(*ctx);
+    if (OSHMEM_SUCCESS != rc) {
+        MCA_SPML_CALL(ctx_destroy(*ctx));
+        *ctx = NULL;
+    }
+
+    return rc;
 }
 
 void shmem_ctx_destroy(shmem_ctx_t ctx)
 {
+    shmem_aggr_ctx_destroy(ctx);
     MCA_SPML_CALL(ctx_destroy(ctx));
 }
@@ -0,0 +1,36 @@
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+/**
+ * @file
+ *
+ * Aggregation of the nonblocking puts.
+ *
+ * Small nonblocking puts of a context are copied in a buffer per
+ * destination PE as long as their targets are contiguous, and the
+ * buffer is handed to the SPML as a single put when it is full, when
+ * the next put does not extend it, and at fence and quiet. Every
+ * context keeps the list of the PEs it holds data for, so fence and
+ * quiet only visit those PEs.
+ */
+#ifndef SHMEM_AGGR_H
+#define SHMEM_AGGR_H
+
+#include "oshmem_config.h"
+#include "oshmem/include/shmem.h"
+
+int shmem_aggr_init(void);
+int shmem_aggr_finalize(void);
+
+/* called when an application context is created or destroyed */
+int shmem_aggr_ctx_create(shmem_ctx_t ctx);
+void shmem_aggr_ctx_destroy(shmem_ctx_t ctx);
+
+#endif /*SHMEM_AGGR_H*/
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/*
+pml monitoring histograms tester.
+
+To be run as:
+
+mpirun -np 4 --mca pml_monitoring_enable 1 --mca pml_monitoring_histograms 1 ./test_histograms
+
+Every process sends messages of increasing sizes to its right neighbor,
+then checks that the per-peer time histograms and the per-communicator
+size histogram account for all of them. The output should be:
+Histograms OK
+*/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <mpi.h>
+
+#define NB_SIZES 10
+
+static const char count_pvar_name[] = "pml_monitoring_messages_count";
+static const char time_pvar_name[] = "pml_monitoring_messages_time_histogram";
+static const char csize_pvar_name[] = "pml_monitoring_comm_size_histogram";
+
+static MPI_T_pvar_handle alloc_handle(MPI_T_pvar_session session, const char *name,
+                                     MPI_Comm *comm, int *count)
+{
+    MPI_T_pvar_handle handle;
+    int idx;
+
+    if (MPI_SUCCESS != MPI_T_pvar_get_index(name, MPI_T_PVAR_CLASS_SIZE, &idx)) {
+        printf("cannot find monitoring MPI_T \"%s\" pvar, check that you have monitoring pml\n", name);
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+    if (MPI_SUCCESS != MPI_T_pvar_handle_alloc(session, idx, comm, &handle, count)) {
+        printf("failed to allocate handle on \"%s\" pvar\n", name);
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+    if (MPI_SUCCESS != MPI_T_pvar_start(session, handle)) {
+        printf("failed to start handle on \"%s\" pvar\n", name);
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+    return handle;
+}
+
+int main(int argc, char* argv[])
+{
+    int rank, size, provided, i, j, to, from, errors = 0, total;
+    int count_count, time_count, csize_count;
+    size_t *msg_count, *time_hist, *csize_hist, sum;
+    MPI_T_pvar_session session;
+    MPI_T_pvar_handle count_handle, time_handle, csize_handle;
+    MPI_Request reqs[2];
+    MPI_Comm comm = MPI_COMM_WORLD;
+    char *sbuf, *rbuf;
+
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    to = (rank + 1) % size;
+    from = (rank + size - 1) % size;
+
+    if (MPI_SUCCESS != MPI_T_init_thread(MPI_THREAD_SINGLE, &provided))
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    MPI_T_pvar_session_create(&session);
+
+    count_handle = alloc_handle(session, count_pvar_name, &comm, &count_count);
+    time_handle = alloc_handle(session, time_pvar_name, &comm, &time_count);
+    csize_handle = alloc_handle(session, csize_pvar_name, &comm, &csize_count);
+    msg_count = calloc(count_count, sizeof(size_t));
+    time_hist = calloc(time_count, sizeof(size_t));
+    csize_hist = calloc(csize_count, sizeof(size_t));
+
+    sbuf = calloc(1, 1 << NB_SIZES);
+    rbuf = calloc(1, 1 << NB_SIZES);
+    for (i = 0; i < NB_SIZES; i++) {
+        /* nonblocking sends go through the completion callback */
+        MPI_Irecv(rbuf, 1 << i, MPI_BYTE, from, i, MPI_COMM_WORLD, &reqs[0]);
+        MPI_Isend(sbuf, 1 << i, MPI_BYTE, to, i, MPI_COMM_WORLD, &reqs[1]);
+        MPI_Waitall(2, reqs, MPI_STATUSES_IGNORE);
+        /* blocking sends are timed around the call */
+        MPI_Sendrecv(sbuf, 1 << i, MPI_BYTE, to, i, rbuf, 1 << i, MPI_BYTE, from, i,
+                     MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+    }
+
+    MPI_T_pvar_stop(session, count_handle);
+    MPI_T_pvar_stop(session, time_handle);
+    MPI_T_pvar_stop(session, csize_handle);
+    MPI_T_pvar_read(session, count_handle, msg_count);
+    MPI_T_pvar_read(session, time_handle, time_hist);
+    MPI_T_pvar_read(session, csize_handle, csize_hist);
+
+    /* The time histograms of each peer account for all the messages */
+    for (i = 0, total = 0; i < size; i++) {
+        for (j = 0, sum = 0; j < time_count / size; j++)
+            sum += time_hist[i * (time_count / size) + j];
+        if (sum != msg_count[i]) {
+            printf("[%d] peer %d: %zu messages in the time histogram, %zu sent\n",
+                   rank, i, sum, msg_count[i]);
+            errors++;
+        }
+        total += msg_count[i];
+    }
+    /* All of them were sent on MPI_COMM_WORLD, two of each size */
+    for (j = 0, sum = 0; j < csize_count; j++)
+        sum += csize_hist[j];
+    if (sum != (size_t) total) {
+        printf("[%d] %zu messages in the communicator size histogram, %d sent\n", rank, sum, total);
+        errors++;
+    }
+    for (i = 0; i < NB_SIZES; i++) {
+        if (csize_hist[i + 1] < 2) {
+            printf("[%d] only %zu messages of %d bytes\n", rank, csize_hist[i + 1], 1 << i);
+            errors++;
+        }
+    }
+
+    MPI_T_pvar_handle_free(session, &count_handle);
+    MPI_T_pvar_handle_free(session, &time_handle);
+    MPI_T_pvar_handle_free(session, &csize_handle);
+    MPI_T_pvar_session_free(&session);
+    MPI_T_finalize();
+
+    MPI_Allreduce(MPI_IN_PLACE, &errors, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+    if (0 == rank)
+        printf("Histograms %s\n", 0 == errors ? "OK" : "FAILED");
+
+    free(sbuf); free(rbuf);
+    free(msg_count); free(time_hist); free(csize_hist);
+    MPI_Finalize();
+    return 0 != errors;
+}
@@ -0,0 +1,103 @@
+/*
+ * Copyright (c) 2026      The University of Tennessee and The University
+ *                         of Tennessee Research Foundation.  All rights
+ *                         reserved.
+ * $COPYRIGHT$
+ *
+ * Additional copyrights may follow
+ *
+ * $HEADER$
+ */
+
+/*
+pml monitoring trace tester.
+
+To be run as:
+
+mpirun -np 4 --mca pml_monitoring_enable 1 --mca pml_monitoring_trace_filename trace ./test_trace
+
+Runs nonblocking collectives with a user-defined operation and a derived
+datatype while their completion is timed. The collective framework then
+chains its own completion callback on the requests, which the trace must
+leave alone. The output should be:
+Trace OK
+*/
+
+#include <stdlib.h>
+#include <stdio.h>
+#include <mpi.h>
+
+#define COUNT 1024
+#define NB_ITER 100
+
+static void user_sum(void *in, void *inout, int *len, MPI_Datatype *dtype)
+{
+    int i;
+
+    (void) dtype;
+    for (i = 0; i < *len; i++)
+        ((int *) inout)[i] += ((int *) in)[i];
+}
+
+int main(int argc, char* argv[])
+{
+    int rank, size, i, j, errors = 0;
+    int *sbuf, *rbuf;
+    MPI_Request req;
+    MPI_Datatype pair;
+    MPI_Op op;
+
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+
+    MPI_Op_create(user_sum, 1, &op);
+    MPI_Type_contiguous(2, MPI_INT, &pair);
+    MPI_Type_commit(&pair);
+    sbuf = malloc(COUNT * sizeof(int));
+    rbuf = malloc(COUNT * sizeof(int));
+    for (i = 0; i < COUNT; i++)
+        sbuf[i] = i;
+
+    for (j = 0; j < NB_ITER; j++) {
+        /* the user operation is retained until the request completes */
+        MPI_Iallreduce(sbuf, rbuf, COUNT, MPI_INT, op, MPI_COMM_WORLD, &req);
+        MPI_Wait(&req, MPI_STATUS_IGNORE);
+        for (i = 0; i < COUNT; i++) {
+            if (rbuf[i] != i * size) {
+                printf("[%d] iallreduce %d: rbuf[%d] = %d instead of %d\n",
+                       rank, j, i, rbuf[i], i * size);
+                errors++;
+                break;
+            }
+        }
+        /* and so is the derived datatype */
+        for (i = 0; i < COUNT; i++)
+            rbuf[i] = (0 == rank) ? i + j : -1;
+        MPI_Ibcast(rbuf, COUNT / 2, pair, 0, MPI_COMM_WORLD, &req);
+        while (1) {
+            int flag;
+            MPI_Test(&req, &flag, MPI_STATUS_IGNORE);
+            if (flag) break;
+        }
+        for (i = 0; i < COUNT; i++) {
+            if (rbuf[i] != i + j) {
+                printf("[%d] ibcast %d: rbuf[%d] = %d instead of %d\n",
+                       rank, j, i, rbuf[i], i + j);
+                errors++;
+                break;
+            }
+        }
+    }
+
+    MPI_Type_free(&pair);
+    MPI_Op_free(&op);
+    free(sbuf); free(rbuf);
+
+    MPI_Allreduce(MPI_IN_PLACE, &errors, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+    if (0 == rank)
+        printf("Trace %s\n", 0 == errors ? "OK" : "FAILED");
+
+    MPI_Finalize();
+    return 0 != errors;
+}
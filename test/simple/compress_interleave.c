@@ -0,0 +1,85 @@
+/*
+ * Two processes alternately write disjoint records into the same
+ * chunk of a file opened with the ompio_compression hint. Without
+ * synchronization between the writes, every record has to survive the
+ * read-modify-write of the chunk by the other process.
+ */
+
+#include "mpi.h"
+#include <stdio.h>
+#include <string.h>
+
+#define RECSIZE  100
+#define NRECS    32
+
+int main(int argc, char* argv[])
+{
+    char rec[RECSIZE], buf[RECSIZE * NRECS];
+    int i, j, rank, size, errs = 0, allerrs;
+    MPI_File fh;
+    MPI_Info info;
+    const char *filename = argc > 1 ? argv[1] : "compress_interleave.dat";
+
+    MPI_Init(&argc, &argv);
+    MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+    MPI_Comm_size(MPI_COMM_WORLD, &size);
+    if (size < 2) {
+        if (0 == rank) {
+            fprintf(stderr, "compress_interleave requires at least 2 processes\n");
+        }
+        MPI_Abort(MPI_COMM_WORLD, 1);
+    }
+
+    if (0 == rank) {
+        MPI_File_delete(filename, MPI_INFO_NULL);
+    }
+    MPI_Barrier(MPI_COMM_WORLD);
+
+    MPI_Info_create(&info);
+    MPI_Info_set(info, "ompio_compression", "lz");
+    MPI_File_open(MPI_COMM_WORLD, filename, MPI_MODE_CREATE | MPI_MODE_RDWR, info, &fh);
+    MPI_Info_free(&info);
+
+    /* record i is written by process i % 2, one record at a time in turn */
+    for (i = 0; i < NRECS; i++) {
+        if (i % 2 == rank) {
+            memset(rec, 'a' + i % 26, RECSIZE);
+            MPI_File_write_at(fh, (MPI_Offset) i * RECSIZE, rec, RECSIZE, MPI_BYTE,
+                              MPI_STATUS_IGNORE);
+        }
+        MPI_Barrier(MPI_COMM_WORLD);
+    }
+
+    MPI_File_sync(fh);
+    MPI_Barrier(MPI_COMM_WORLD);
+    MPI_File_sync(fh);
+
+    if (0 == rank) {
+        memset(buf, 0, sizeof(buf));
+        MPI_File_read_at(fh, 0, buf, sizeof(buf), MPI_BYTE, MPI_STATUS_IGNORE);
+        for (i = 0; i < NRECS; i++) {
+            for (j = 0; j < RECSIZE; j++) {
+                if (buf[i * RECSIZE + j] != 'a' + i % 26) {
+                    fprintf(stderr, "record %d corrupted at byte %d\n", i, j);
+                    errs++;
+                    break;
+                }
+            }
+        }
+    }
+    MPI_File_close(&fh);
+
+    MPI_Allreduce(&errs, &allerrs, 1, MPI_INT, MPI_SUM, MPI_COMM_WORLD);
+    if (0 == rank) {
+        if (0 == allerrs) {
+            printf("No errors\n");
+            MPI_File_delete(filename, MPI_INFO_NULL);
+        }
+        else {
+            printf("Found %d errors\n", allerrs);
+        }
+    }
+
+    MPI_Finalize();
+    return allerrs ? 1 : 0;
+}